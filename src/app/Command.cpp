@@ -196,6 +196,15 @@ exit:
 CHIP_ERROR Command::ConstructCommandPath(const CommandPathParams & aCommandPathParams,
                                          CommandDataElement::Builder aCommandDataElement)
 {
+    // A path to an endpoint is the usual case, and has a precomputed encoding.
+    if (aCommandPathParams.mFlags.Has(CommandPathFlags::kEndpointIdValid) &&
+        !aCommandPathParams.mFlags.Has(CommandPathFlags::kGroupIdValid))
+    {
+        return aCommandDataElement
+            .EncodeCommandPath(aCommandPathParams.mEndpointId, aCommandPathParams.mClusterId, aCommandPathParams.mCommandId)
+            .GetError();
+    }
+
     CommandPath::Builder commandPath = aCommandDataElement.CreateCommandPathBuilder();
     if (aCommandPathParams.mFlags.Has(CommandPathFlags::kEndpointIdValid))
     {
@@ -125,10 +125,8 @@ CHIP_ERROR CommandHandler::AddStatusCode(const CommandPathParams * apCommandPath
     err = PrepareCommand(apCommandPathParams, true /* isStatus */);
     SuccessOrExit(err);
 
-    statusElementBuilder =
-        mInvokeCommandBuilder.GetCommandListBuilder().GetCommandDataElementBuilder().CreateStatusElementBuilder();
-    statusElementBuilder.EncodeStatusElement(aGeneralCode, aProtocolId.ToFullyQualifiedSpecForm(), aProtocolCode)
-        .EndOfStatusElement();
+    statusElementBuilder = mInvokeCommandBuilder.GetCommandListBuilder().GetCommandDataElementBuilder().EncodeStatusElement(
+        aGeneralCode, aProtocolId.ToFullyQualifiedSpecForm(), aProtocolCode);
     err = statusElementBuilder.GetError();
     SuccessOrExit(err);
 
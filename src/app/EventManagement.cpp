@@ -125,6 +125,18 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, int a
         current->mProcessEvictedElement = AlwaysFail;
         current->mAppData               = nullptr;
         current->InitCounter(apLogStorageResources[bufferIndex].InitializeCounter());
+
+        // Pick up the events kept from before a restart.
+        current->SetPersistenceDelegate(apLogStorageResources[bufferIndex].mpPersistenceDelegate);
+        if (apLogStorageResources[bufferIndex].mpPersistenceDelegate != nullptr)
+        {
+            CHIP_ERROR err = apLogStorageResources[bufferIndex].mpPersistenceDelegate->Restore(*current);
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(EventLogging, "Failed to restore events with priority %d: %s", current->GetPriorityLevel(),
+                             ErrorStr(err));
+            }
+        }
     }
 
     mpEventBuffer = apCircularEventBuffer;
@@ -142,7 +154,9 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
-    CircularEventBuffer backup = *nextBuffer;
+    CircularEventBuffer backup                              = *nextBuffer;
+    const CircularEventBuffer::EventIndexEntry * indexEntry = apEventBuffer->GetHeadIndexEntry();
+    uint32_t position                                       = nextBuffer->GetTailPosition();
 
     // Set up the next buffer s.t. it fails if needs to evict an element
     nextBuffer->mProcessEvictedElement = AlwaysFail;
@@ -155,12 +169,29 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     err = reader.Next();
     SuccessOrExit(err);
 
+    {
+        TLVReader sizingReader;
+        sizingReader.Init(reader);
+        err = sizingReader.Skip();
+        SuccessOrExit(err);
+        err = nextBuffer->PrepareToWrite(sizingReader.GetLengthRead());
+        SuccessOrExit(err);
+    }
+
     err = writer.CopyElement(reader);
     SuccessOrExit(err);
 
     err = writer.Finalize();
     SuccessOrExit(err);
 
+    // The event keeps its index entry in the next buffer.
+    if (indexEntry != nullptr)
+    {
+        CircularEventBuffer::EventIndexEntry movedEntry = *indexEntry;
+        movedEntry.mPosition                            = position;
+        nextBuffer->AddIndexEntry(movedEntry);
+    }
+
     ChipLogProgress(EventLogging, "Copy Event to next buffer with priority %d", nextBuffer->GetPriorityLevel());
 exit:
     if (err != CHIP_NO_ERROR)
@@ -213,6 +244,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
                     err = CopyToNextBuffer(eventBuffer);
                     SuccessOrExit(err);
                     // success; evict head unconditionally
+                    eventBuffer->RemoveHeadIndexEntry();
                     eventBuffer->mProcessEvictedElement = nullptr;
                     err                                 = eventBuffer->EvictHead();
                     // if unconditional eviction failed, this
@@ -380,10 +412,16 @@ void EventManagement::DestroyEventManagement()
 
 EventNumber CircularEventBuffer::VendEventNumber()
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
+    CHIP_ERROR err     = CHIP_NO_ERROR;
+    EventNumber number = (mLastEventNumber & ~static_cast<EventNumber>(UINT32_MAX)) | mpEventNumberCounter->GetValue();
 
-    // Assign event Number to the buffer's counter's value.
-    mLastEventNumber = static_cast<EventNumber>(mpEventNumberCounter->GetValue());
+    // Assign event Number to the buffer's counter's value. The counter is 32 bits wide, event numbers keep increasing once it
+    // wraps around, so that they can still be compared and indexed.
+    if (number < mLastEventNumber)
+    {
+        number += static_cast<EventNumber>(UINT32_MAX) + 1;
+    }
+    mLastEventNumber = number;
 
     // Now advance the counter.
     err = mpEventNumberCounter->Advance();
@@ -479,12 +517,11 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, E
     aEventNumber                   = 0;
     CircularEventBuffer checkpoint = *mpEventBuffer;
     CircularEventBuffer * buffer   = nullptr;
+    CircularEventBuffer::EventIndexEntry indexEntry;
     EventLoadOutContext ctxt       = EventLoadOutContext(writer, aEventOptions.mpEventSchema->mPriority,
                                                    GetPriorityBuffer(aEventOptions.mpEventSchema->mPriority)->GetLastEventNumber());
     Timestamp timestamp(Timestamp::Type::kSystem, System::Timer::GetCurrentEpoch());
     EventOptions opts = EventOptions(timestamp);
-    // Start the event container (anonymous structure) in the circular buffer
-    writer.Init(*mpEventBuffer);
 
     // check whether the entry is to be logged or discarded silently
     VerifyOrExit(aEventOptions.mpEventSchema->mPriority >= CHIP_CONFIG_EVENT_GLOBAL_PRIORITY, /* no-op */);
@@ -514,6 +551,17 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, E
     err = EnsureSpaceInCircularBuffer(requestSize);
     SuccessOrExit(err);
 
+    // Start the event container (anonymous structure) in the circular buffer, once there is space for it: a writer
+    // started on a full buffer would have to evict an event itself, which only EnsureSpaceInCircularBuffer may do.
+    writer.Init(*mpEventBuffer);
+
+    indexEntry.mPrevSystemTimestamp = ctxt.mCurrentSystemTime.mValue;
+    indexEntry.mPosition            = mpEventBuffer->GetTailPosition();
+    indexEntry.mPriority            = opts.mpEventSchema->mPriority;
+
+    err = mpEventBuffer->PrepareToWrite(requestSize);
+    SuccessOrExit(err);
+
     err = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
@@ -549,6 +597,20 @@ exit:
         aEventNumber                        = currentBuffer->VendEventNumber();
         currentBuffer->UpdateFirstLastEventTime(opts.mTimestamp);
 
+        indexEntry.mNumber = aEventNumber;
+        mpEventBuffer->AddIndexEntry(indexEntry);
+
+        // Logging the event may have moved events along the whole chain of buffers.
+        for (buffer = mpEventBuffer; buffer != nullptr; buffer = buffer->GetNextCircularEventBuffer())
+        {
+            CHIP_ERROR commitErr = buffer->Commit();
+            if (commitErr != CHIP_NO_ERROR)
+            {
+                ChipLogError(EventLogging, "Failed to keep events with priority %d: %s", buffer->GetPriorityLevel(),
+                             ErrorStr(commitErr));
+            }
+        }
+
 #if CHIP_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
         ChipLogDetail(
             EventLogging,
@@ -675,7 +737,7 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, ClusterInfo *
 
     context.mCurrentSystemTime.mValue = buf->GetFirstEventSystemTimestamp();
     context.mCurrentEventNumber       = buf->GetFirstEventNumber();
-    err                               = GetEventReader(reader, aPriority, &bufWrapper);
+    err                               = SeekEventReader(reader, context, &bufWrapper);
     SuccessOrExit(err);
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
@@ -697,13 +759,52 @@ CHIP_ERROR EventManagement::GetEventReader(TLVReader & aReader, PriorityLevel aP
     CircularEventReader reader;
     CircularEventBuffer * buffer = GetPriorityBuffer(aPriority);
     VerifyOrExit(buffer != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
-    apBufWrapper->mpCurrent = buffer;
+    apBufWrapper->mpCurrent    = buffer;
+    apBufWrapper->mStartOffset = 0;
     reader.Init(apBufWrapper);
     aReader.Init(reader);
 exit:
     return err;
 }
 
+CHIP_ERROR EventManagement::SeekEventReader(TLVReader & aReader, EventLoadOutContext & aContext,
+                                            CircularEventBufferWrapper * apBufWrapper)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    CircularEventReader reader;
+    CircularEventBuffer * buffer                       = GetPriorityBuffer(aContext.mPriority);
+    CircularEventBuffer * foundBuffer                  = nullptr;
+    const CircularEventBuffer::EventIndexEntry * found = nullptr;
+    VerifyOrExit(buffer != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The events of a priority are read from its own buffer on to the buffers of lesser priority, in increasing number.
+    for (CircularEventBuffer * current = buffer; current != nullptr; current = current->GetPreviousCircularEventBuffer())
+    {
+        const CircularEventBuffer::EventIndexEntry * entry =
+            current->FindIndexEntry(aContext.mPriority, aContext.mStartingEventNumber);
+        if (entry != nullptr && (found == nullptr || entry->mNumber > found->mNumber))
+        {
+            found       = entry;
+            foundBuffer = current;
+        }
+    }
+
+    apBufWrapper->mpCurrent    = buffer;
+    apBufWrapper->mStartOffset = 0;
+    if (found != nullptr && found->mNumber >= aContext.mCurrentEventNumber)
+    {
+        apBufWrapper->mpCurrent            = foundBuffer;
+        apBufWrapper->mStartOffset         = foundBuffer->GetIndexedEventOffset(*found);
+        aContext.mCurrentEventNumber       = found->mNumber;
+        aContext.mCurrentSystemTime.mValue = found->mPrevSystemTimestamp;
+    }
+    reader.Init(apBufWrapper);
+    aReader.Init(reader);
+
+exit:
+    return err;
+}
+
 CHIP_ERROR EventManagement::FetchEventParameters(const TLVReader & aReader, size_t aDepth, void * apContext)
 {
     CHIP_ERROR err                  = CHIP_NO_ERROR;
@@ -764,9 +865,10 @@ CHIP_ERROR EventManagement::EvictEvent(CHIPCircularTLVBuffer & apBuffer, void *
 
     if (eventBuffer->IsFinalDestinationForPriority(imp))
     {
-        // event is getting dropped.  Increase the event number and first timestamp.
+        // event is getting dropped.  Increase the event number and first timestamp, and drop it from the index.
         EventNumber numEventsToDrop = 1;
         eventBuffer->RemoveEvent(numEventsToDrop);
+        eventBuffer->RemoveHeadIndexEntry();
         eventBuffer->SetFirstEventSystemTimestamp(eventBuffer->GetFirstEventSystemTimestamp() + context.mDeltaSystemTime.mValue);
         ChipLogProgress(EventLogging,
                         "Dropped events from buffer with priority %d due to overflow: { event priority_level: %d, count: %d };",
@@ -820,6 +922,9 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
     mFirstEventSystemTimestamp = Timestamp::System(0);
     mLastEventSystemTimestamp  = Timestamp::System(0);
     mpEventNumberCounter       = nullptr;
+    mIndexStart                = 0;
+    mIndexCount                = 0;
+    mpPersistenceDelegate      = nullptr;
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -842,6 +947,103 @@ void CircularEventBuffer::RemoveEvent(EventNumber aNumEvents)
     mFirstEventNumber = mFirstEventNumber + aNumEvents;
 }
 
+void CircularEventBuffer::AddIndexEntry(const EventIndexEntry & aEntry)
+{
+    if (mIndexCount == CHIP_CONFIG_EVENT_INDEX_SIZE)
+    {
+        mIndexStart = (mIndexStart + 1) % CHIP_CONFIG_EVENT_INDEX_SIZE;
+        mIndexCount--;
+    }
+    mIndex[(mIndexStart + mIndexCount) % CHIP_CONFIG_EVENT_INDEX_SIZE] = aEntry;
+    mIndexCount++;
+}
+
+const CircularEventBuffer::EventIndexEntry * CircularEventBuffer::GetHeadIndexEntry() const
+{
+    // Events are indexed in the order they are stored, so only the oldest entry may be that of the head event.
+    if (mIndexCount == 0 || GetIndexedEventOffset(mIndex[mIndexStart]) != 0)
+    {
+        return nullptr;
+    }
+    return &mIndex[mIndexStart];
+}
+
+void CircularEventBuffer::RemoveHeadIndexEntry()
+{
+    if (GetHeadIndexEntry() != nullptr)
+    {
+        mIndexStart = (mIndexStart + 1) % CHIP_CONFIG_EVENT_INDEX_SIZE;
+        mIndexCount--;
+    }
+}
+
+const CircularEventBuffer::EventIndexEntry * CircularEventBuffer::FindIndexEntry(PriorityLevel aPriority,
+                                                                                 EventNumber aEventNumber) const
+{
+    for (size_t i = mIndexCount; i > 0; i--)
+    {
+        const EventIndexEntry & entry = mIndex[(mIndexStart + i - 1) % CHIP_CONFIG_EVENT_INDEX_SIZE];
+        if (entry.mPriority == aPriority && entry.mNumber <= aEventNumber)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+CircularEventBuffer::State CircularEventBuffer::GetState() const
+{
+    State state;
+
+    state.mHeadOffset                = static_cast<uint32_t>(QueueHead() - GetQueue()) % GetTotalDataLength();
+    state.mDataLength                = DataLength();
+    state.mFirstEventNumber          = mFirstEventNumber;
+    state.mLastEventNumber           = mLastEventNumber;
+    state.mFirstEventSystemTimestamp = mFirstEventSystemTimestamp.mValue;
+    state.mLastEventSystemTimestamp  = mLastEventSystemTimestamp.mValue;
+
+    return state;
+}
+
+void CircularEventBuffer::RestoreState(const State & aState)
+{
+    ProcessEvictedElementFunct processEvictedElement = mProcessEvictedElement;
+    void * appData                                   = mAppData;
+
+    CHIPCircularTLVBuffer::Init(GetQueue(), GetTotalDataLength(), GetQueue() + aState.mHeadOffset, aState.mDataLength);
+    mProcessEvictedElement = processEvictedElement;
+    mAppData               = appData;
+
+    mFirstEventNumber                 = aState.mFirstEventNumber;
+    mLastEventNumber                  = aState.mLastEventNumber;
+    mFirstEventSystemTimestamp.mValue = aState.mFirstEventSystemTimestamp;
+    mLastEventSystemTimestamp.mValue  = aState.mLastEventSystemTimestamp;
+    mIndexStart                       = 0;
+    mIndexCount                       = 0;
+
+    // Without a counter of its own that survived the restart, go on vending numbers after the restored events.
+    if (mpEventNumberCounter == &mNonPersistedCounter && mNonPersistedCounter.GetValue() <= mLastEventNumber)
+    {
+        mNonPersistedCounter.Init(static_cast<uint32_t>(mLastEventNumber + 1));
+    }
+}
+
+CHIP_ERROR CircularEventBuffer::PrepareToWrite(uint32_t aLength)
+{
+    return (mpPersistenceDelegate != nullptr) ? mpPersistenceDelegate->PrepareToWrite(*this, aLength) : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CircularEventBuffer::Commit()
+{
+    return (mpPersistenceDelegate != nullptr) ? mpPersistenceDelegate->Commit(*this) : CHIP_NO_ERROR;
+}
+
+uint32_t CircularEventBuffer::GetIndexedEventOffset(const EventIndexEntry & aEntry) const
+{
+    uint32_t head = static_cast<uint32_t>(QueueHead() - GetQueue()) % GetTotalDataLength();
+    return (aEntry.mPosition + GetTotalDataLength() - head) % GetTotalDataLength();
+}
+
 void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 {
     CircularEventBuffer * prev;
@@ -850,7 +1052,7 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
         return;
 
     TLVReader::Init(*apBufWrapper, apBufWrapper->mpCurrent->DataLength());
-    mMaxLen = apBufWrapper->mpCurrent->DataLength();
+    mMaxLen = apBufWrapper->mpCurrent->DataLength() - apBufWrapper->mStartOffset;
     for (prev = apBufWrapper->mpCurrent->GetPreviousCircularEventBuffer(); prev != nullptr;
          prev = prev->GetPreviousCircularEventBuffer())
     {
@@ -860,6 +1062,27 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
     }
 }
 
+CHIP_ERROR CircularEventBufferWrapper::OnInit(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
+{
+    uint32_t offset = mStartOffset;
+
+    ReturnErrorOnFailure(GetNextBuffer(aReader, aBufStart, aBufLen));
+
+    // The data of the current buffer may wrap around the end of its storage, the start then lies in the second part of it.
+    if (offset > 0 && offset >= aBufLen)
+    {
+        offset -= aBufLen;
+        aBufStart += aBufLen;
+        ReturnErrorOnFailure(GetNextBuffer(aReader, aBufStart, aBufLen));
+    }
+
+    VerifyOrReturnError(offset <= aBufLen, CHIP_ERROR_INCORRECT_STATE);
+    aBufStart += offset;
+    aBufLen -= offset;
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -32,6 +32,7 @@
 #include <app/MessageDef/EventDataElement.h>
 #include <app/util/basic-types.h>
 #include <core/CHIPCircularTLVBuffer.h>
+#include <core/CHIPEventLoggingConfig.h>
 #include <messaging/ExchangeMgr.h>
 #include <support/PersistedCounter.h>
 
@@ -43,6 +44,36 @@ constexpr size_t kMaxEventSizeReserve = 512;
 constexpr uint16_t kRequiredEventField =
     (1 << EventDataElement::kCsTag_PriorityLevel) | (1 << EventDataElement::kCsTag_DeltaSystemTimestamp);
 
+class CircularEventBuffer;
+
+/**
+ * @brief
+ *   A delegate that keeps the events of a CircularEventBuffer across restarts, e.g. in a file backing the storage of the buffer.
+ */
+class EventPersistenceDelegate
+{
+public:
+    virtual ~EventPersistenceDelegate() = default;
+
+    /**
+     * @brief
+     *   Resume the buffer with the events kept from before the restart, if any. Called once the buffer is initialized.
+     */
+    virtual CHIP_ERROR Restore(CircularEventBuffer & aBuffer) = 0;
+
+    /**
+     * @brief
+     *   Called before aLength bytes are written at the tail of the buffer, where events evicted from it may still be kept.
+     */
+    virtual CHIP_ERROR PrepareToWrite(const CircularEventBuffer & aBuffer, uint32_t aLength) = 0;
+
+    /**
+     * @brief
+     *   Called once events were logged to, moved into or evicted from the buffer.
+     */
+    virtual CHIP_ERROR Commit(const CircularEventBuffer & aBuffer) = 0;
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::CHIPCircularTLVBuffer
@@ -51,6 +82,32 @@ constexpr uint16_t kRequiredEventField =
 class CircularEventBuffer : public TLV::CHIPCircularTLVBuffer
 {
 public:
+    /**
+     * @brief
+     *   What there is to the buffer beyond the contents of its storage.
+     */
+    struct State
+    {
+        uint32_t mHeadOffset                = 0; ///< The position of the first event in the storage
+        uint32_t mDataLength                = 0; ///< The number of bytes of events
+        EventNumber mFirstEventNumber       = 0;
+        EventNumber mLastEventNumber        = 0;
+        uint64_t mFirstEventSystemTimestamp = 0;
+        uint64_t mLastEventSystemTimestamp  = 0;
+    };
+
+    /**
+     * @brief
+     *   Where an event is stored in the buffer, and what reading the log up to it would have established.
+     */
+    struct EventIndexEntry
+    {
+        EventNumber mNumber           = 0; ///< The number of the event, among the events of its priority
+        uint64_t mPrevSystemTimestamp = 0; ///< The system timestamp the delta time of the event is relative to
+        uint32_t mPosition            = 0; ///< The position of the event in the storage of the buffer
+        PriorityLevel mPriority       = PriorityLevel::Invalid;
+    };
+
     /**
      * @brief
      *   A constructor for the CircularEventBuffer (internal API).
@@ -141,6 +198,70 @@ public:
 
     uint64_t GetLastEventSystemTimestamp() { return mLastEventSystemTimestamp.mValue; }
 
+    /**
+     * @brief
+     *   Index an event just stored at the tail of the buffer. When the index is full, the oldest entry gives way.
+     */
+    void AddIndexEntry(const EventIndexEntry & aEntry);
+
+    /**
+     * @brief
+     *   Drop the index entry of the event at the head of the buffer, if it has one, before that event is evicted.
+     */
+    void RemoveHeadIndexEntry();
+
+    /**
+     * @brief
+     *   The index entry of the event at the head of the buffer, or nullptr if it has none.
+     */
+    const EventIndexEntry * GetHeadIndexEntry() const;
+
+    /**
+     * @brief
+     *   The indexed event of the given priority with the greatest number not past aEventNumber.
+     *
+     * @return The index entry of the event, or nullptr if no event of that priority and number is indexed.
+     */
+    const EventIndexEntry * FindIndexEntry(PriorityLevel aPriority, EventNumber aEventNumber) const;
+
+    /**
+     * @brief
+     *   The number of bytes between the head of the buffer and an indexed event.
+     */
+    uint32_t GetIndexedEventOffset(const EventIndexEntry & aEntry) const;
+
+    /**
+     * @brief
+     *   The position in the storage of the buffer where the next event will be stored.
+     */
+    uint32_t GetTailPosition() const { return static_cast<uint32_t>(QueueTail() - GetQueue()); }
+
+    /**
+     * @brief
+     *   The state of the buffer, which together with the contents of its storage makes up the events in it.
+     */
+    State GetState() const;
+
+    /**
+     * @brief
+     *   Resume the buffer from an earlier state, over storage still holding the events of that state.
+     */
+    void RestoreState(const State & aState);
+
+    void SetPersistenceDelegate(EventPersistenceDelegate * apDelegate) { mpPersistenceDelegate = apDelegate; }
+
+    /**
+     * @brief
+     *   Let the persistence delegate, if any, know that aLength bytes are about to be written at the tail of the buffer.
+     */
+    CHIP_ERROR PrepareToWrite(uint32_t aLength);
+
+    /**
+     * @brief
+     *   Let the persistence delegate, if any, keep the current events of the buffer.
+     */
+    CHIP_ERROR Commit();
+
     virtual ~CircularEventBuffer() = default;
 
 private:
@@ -161,6 +282,13 @@ private:
     EventNumber mLastEventNumber    = 0;  ///< Last event Number vended for this priority
     Timestamp mFirstEventSystemTimestamp; ///< The timestamp of the first event in this buffer
     Timestamp mLastEventSystemTimestamp;  ///< The timestamp of the last event in this buffer
+
+    EventPersistenceDelegate * mpPersistenceDelegate = nullptr; ///< Keeps the events of this buffer across restarts, if set
+
+    // The most recent events stored in this buffer, oldest first, in a ring starting at mIndexStart.
+    EventIndexEntry mIndex[CHIP_CONFIG_EVENT_INDEX_SIZE];
+    size_t mIndexStart = 0;
+    size_t mIndexCount = 0;
 };
 
 class CircularEventReader;
@@ -174,10 +302,13 @@ class CircularEventReader;
 class CircularEventBufferWrapper : public TLV::CHIPCircularTLVBuffer
 {
 public:
-    CircularEventBufferWrapper() : CHIPCircularTLVBuffer(nullptr, 0), mpCurrent(nullptr){};
+    CircularEventBufferWrapper() : CHIPCircularTLVBuffer(nullptr, 0), mpCurrent(nullptr), mStartOffset(0){};
     CircularEventBuffer * mpCurrent;
+    uint32_t mStartOffset; ///< The number of bytes after the head of mpCurrent at which a reader starts
 
 private:
+    using CHIPCircularTLVBuffer::OnInit;
+    CHIP_ERROR OnInit(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
     CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
 };
 
@@ -214,6 +345,10 @@ struct LogStorageResources
     PersistedCounter * mpCounterStorage = nullptr; // application provided storage for persistent counter for this priority level.
     PriorityLevel mPriority =
         PriorityLevel::Invalid; // Log priority level associated with the resources provided in this structure.
+    EventPersistenceDelegate * mpPersistenceDelegate =
+        nullptr; // Keeps the events in `mpBuffer` across restarts, e.g. a PersistentEventStorage whose buffer `mpBuffer` is.
+                 // When NULL, the events are lost on restart, including the events of higher priority that have not
+                 // moved on to their own buffer yet.
     PersistedCounter * InitializeCounter() const
     {
         if (mpCounterStorage != nullptr && mCounterKey != nullptr && mCounterEpoch != 0)
@@ -359,6 +494,25 @@ public:
     CHIP_ERROR GetEventReader(chip::TLV::TLVReader & aReader, PriorityLevel aPriority,
                               app::CircularEventBufferWrapper * apBufWrapper);
 
+    /**
+     * @brief
+     *   A helper method to get tlv reader positioned at the latest indexed event of a particular priority that is not past
+     *   a given event number, so that the events before it need not be read.
+     *
+     * Where no such event is indexed, the reader starts at the oldest event, as from #GetEventReader.
+     *
+     * @param[in,out] aReader   A reference to the reader that will be initialized with the backing storage from the event log
+     * @param[in,out] aContext  The context of a fetch of the events of aContext.mPriority since
+     *                          aContext.mStartingEventNumber. On return, its current event number and system time are those
+     *                          the reader starts at.
+     * @param[in] apBufWrapper  CircularEventBufferWrapper
+     *
+     * @retval #CHIP_NO_ERROR              On success.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT There is no buffer for the priority.
+     */
+    CHIP_ERROR SeekEventReader(chip::TLV::TLVReader & aReader, EventLoadOutContext & aContext,
+                               app::CircularEventBufferWrapper * apBufWrapper);
+
     /**
      * @brief
      *   A function to retrieve events of specified priority since a specified event ID.
@@ -77,6 +77,14 @@ public:
      */
     virtual CHIP_ERROR ReportError(const ReadClient * apReadClient, CHIP_ERROR aError) { return CHIP_ERROR_NOT_IMPLEMENTED; }
 
+    /**
+     * Notification that the publisher has accepted the subscription of the given ReadClient. Further reports for the
+     * subscription are notified through ReportProcessed and ReportError.
+     * @param[in]  apReadClient   A current readClient which can identify the subscription to the consumer
+     * @retval # CHIP_ERROR_NOT_IMPLEMENTED if not implemented
+     */
+    virtual CHIP_ERROR SubscribeResponseProcessed(const ReadClient * apReadClient) { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
     /**
      * Notification that a Command Send has received an Invoke Command Response containing a status code.
      * @param[in]  apCommandSender A current command sender which can identify the command sender to the consumer, particularly
@@ -53,12 +53,12 @@ CHIP_ERROR InteractionModelEngine::Init(Messaging::ExchangeManager * apExchangeM
     mReportingEngine.Init();
     SuccessOrExit(err);
 
-    for (uint32_t index = 0; index < IM_SERVER_MAX_NUM_PATH_GROUPS - 1; index++)
+    for (uint32_t index = 0; index < CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS - 1; index++)
     {
         mClusterInfoPool[index].mpNext = &mClusterInfoPool[index + 1];
     }
-    mClusterInfoPool[IM_SERVER_MAX_NUM_PATH_GROUPS - 1].mpNext = nullptr;
-    mpNextAvailableClusterInfo                                 = mClusterInfoPool;
+    mClusterInfoPool[CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS - 1].mpNext = nullptr;
+    mpNextAvailableClusterInfo                                      = mClusterInfoPool;
 
 exit:
     return err;
@@ -76,17 +76,23 @@ void InteractionModelEngine::Shutdown()
         commandHandler.Shutdown();
     }
 
-    for (auto & readClient : mReadClients)
-    {
-        readClient.Shutdown();
-    }
+    // Shutdown returns each object to its pool, which ForEachActiveObject tolerates.
+    mReadClients.ForEachActiveObject([](ReadClient * readClient) {
+        readClient->Shutdown();
+        return true;
+    });
 
-    for (auto & readHandler : mReadHandlers)
-    {
-        readHandler.Shutdown();
-    }
+    mReadHandlers.ForEachActiveObject([](ReadHandler * readHandler) {
+        readHandler->Shutdown();
+        return true;
+    });
 
-    for (uint32_t index = 0; index < IM_SERVER_MAX_NUM_PATH_GROUPS; index++)
+    mWriteHandlers.ForEachActiveObject([](WriteHandler * writeHandler) {
+        writeHandler->Shutdown();
+        return true;
+    });
+
+    for (uint32_t index = 0; index < CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS; index++)
     {
         mClusterInfoPool[index].mpNext = nullptr;
         mClusterInfoPool[index].ClearDirty();
@@ -120,23 +126,21 @@ exit:
 
 CHIP_ERROR InteractionModelEngine::NewReadClient(ReadClient ** const apReadClient)
 {
-    CHIP_ERROR err = CHIP_ERROR_NO_MEMORY;
+    CHIP_ERROR err          = CHIP_NO_ERROR;
+    ReadClient * readClient = mReadClients.CreateObject();
+
+    *apReadClient = nullptr;
+    VerifyOrReturnError(readClient != nullptr, CHIP_ERROR_NO_MEMORY);
 
-    for (auto & readClient : mReadClients)
+    err = readClient->Init(mpExchangeMgr, mpDelegate);
+    if (CHIP_NO_ERROR != err)
     {
-        if (readClient.IsFree())
-        {
-            *apReadClient = &readClient;
-            err           = readClient.Init(mpExchangeMgr, mpDelegate);
-            if (CHIP_NO_ERROR != err)
-            {
-                *apReadClient = nullptr;
-            }
-            return err;
-        }
+        mReadClients.ReleaseObject(readClient);
+        return err;
     }
 
-    return err;
+    *apReadClient = readClient;
+    return CHIP_NO_ERROR;
 }
 
 void InteractionModelEngine::OnUnknownMsgType(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
@@ -190,24 +194,108 @@ exit:
 }
 
 void InteractionModelEngine::OnReadRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
-                                           const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload)
+                                           const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload,
+                                           ReadHandler::InteractionType aInteractionType)
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
+    CHIP_ERROR err            = CHIP_NO_ERROR;
+    ReadHandler * readHandler = nullptr;
+
+    ChipLogDetail(DataManagement, "Receive %s request",
+                  (aInteractionType == ReadHandler::InteractionType::Subscribe) ? "Subscribe" : "Read");
+
+    readHandler = mReadHandlers.CreateObject();
+    VerifyOrExit(readHandler != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    err = readHandler->Init(mpDelegate);
+    if (err != CHIP_NO_ERROR)
+    {
+        mReadHandlers.ReleaseObject(readHandler);
+        ExitNow();
+    }
+
+    // The handler owns the exchange from here on, and shuts itself down if the request can't be processed.
+    if (aInteractionType == ReadHandler::InteractionType::Subscribe)
+    {
+        err = readHandler->OnSubscribeRequest(apExchangeContext, std::move(aPayload));
+    }
+    else
+    {
+        err = readHandler->OnReadRequest(apExchangeContext, std::move(aPayload));
+    }
+    apExchangeContext = nullptr;
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+
+    if (nullptr != apExchangeContext)
+    {
+        apExchangeContext->Abort();
+    }
+}
+
+void InteractionModelEngine::OnWriteRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                            const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    WriteHandler * writeHandler = nullptr;
+
+    ChipLogDetail(DataManagement, "Receive Write request");
 
-    ChipLogDetail(DataManagement, "Receive Read request");
+    writeHandler = mWriteHandlers.CreateObject();
+    VerifyOrExit(writeHandler != nullptr, err = CHIP_ERROR_NO_MEMORY);
 
-    for (auto & readHandler : mReadHandlers)
+    err = writeHandler->Init(mpDelegate);
+    if (err != CHIP_NO_ERROR)
     {
-        if (readHandler.IsFree())
+        mWriteHandlers.ReleaseObject(writeHandler);
+        ExitNow();
+    }
+
+    // The handler owns the exchange from here on, and shuts itself down once the write response is sent.
+    err               = writeHandler->OnWriteRequest(apExchangeContext, std::move(aPayload));
+    apExchangeContext = nullptr;
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+
+    if (nullptr != apExchangeContext)
+    {
+        apExchangeContext->Abort();
+    }
+}
+
+void InteractionModelEngine::OnUnsolicitedReportData(Messaging::ExchangeContext * apExchangeContext,
+                                                     const PacketHeader & aPacketHeader, const PayloadHeader & aPayloadHeader,
+                                                     System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+    ReportData::Parser report;
+    uint64_t subscriptionId = 0;
+    ReadClient * readClient = nullptr;
+
+    reader.Init(aPayload.Retain());
+    err = reader.Next();
+    SuccessOrExit(err);
+    err = report.Init(reader);
+    SuccessOrExit(err);
+    err = report.GetSubscriptionId(&subscriptionId);
+    SuccessOrExit(err);
+
+    mReadClients.ForEachActiveObject([&](ReadClient * client) {
+        if (client->IsSubscriptionActive() && client->GetSubscriptionId() == subscriptionId)
         {
-            err = readHandler.Init(mpDelegate);
-            SuccessOrExit(err);
-            err = readHandler.OnReadRequest(apExchangeContext, std::move(aPayload));
-            SuccessOrExit(err);
-            apExchangeContext = nullptr;
-            break;
+            readClient = client;
+            return false;
         }
-    }
+        return true;
+    });
+    VerifyOrExit(readClient != nullptr, err = CHIP_ERROR_KEY_NOT_FOUND);
+
+    readClient->OnUnsolicitedReportData(apExchangeContext, std::move(aPayload));
+    apExchangeContext = nullptr;
 
 exit:
     ChipLogFunctError(err);
@@ -228,7 +316,20 @@ void InteractionModelEngine::OnMessageReceived(Messaging::ExchangeContext * apEx
     }
     else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::ReadRequest))
     {
-        OnReadRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
+        OnReadRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload), ReadHandler::InteractionType::Read);
+    }
+    else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::SubscribeRequest))
+    {
+        OnReadRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload),
+                      ReadHandler::InteractionType::Subscribe);
+    }
+    else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::WriteRequest))
+    {
+        OnWriteRequest(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
+    }
+    else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::ReportData))
+    {
+        OnUnsolicitedReportData(apExchangeContext, aPacketHeader, aPayloadHeader, std::move(aPayload));
     }
     else
     {
@@ -267,9 +368,81 @@ CHIP_ERROR __attribute__((weak)) WriteSingleClusterData(ClusterInfo & aClusterIn
     return CHIP_NO_ERROR;
 }
 
-uint16_t InteractionModelEngine::GetReadClientArrayIndex(const ReadClient * const apReadClient) const
+uint16_t InteractionModelEngine::GetReadClientArrayIndex(const ReadClient * const apReadClient)
 {
-    return static_cast<uint16_t>(apReadClient - mReadClients);
+    uint16_t index = 0;
+
+    mReadClients.ForEachActiveObject([&](ReadClient * readClient) {
+        if (readClient == apReadClient)
+        {
+            return false;
+        }
+        index++;
+        return true;
+    });
+
+    return index;
+}
+
+void InteractionModelEngine::ReleaseReadClient(ReadClient * apReadClient)
+{
+    mReadClients.ForEachActiveObject([&](ReadClient * readClient) {
+        if (readClient == apReadClient)
+        {
+            mReadClients.ReleaseObject(readClient);
+            return false;
+        }
+        return true;
+    });
+}
+
+void InteractionModelEngine::ReleaseReadHandler(ReadHandler * apReadHandler)
+{
+    mReadHandlers.ForEachActiveObject([&](ReadHandler * readHandler) {
+        if (readHandler == apReadHandler)
+        {
+            mReadHandlers.ReleaseObject(readHandler);
+            return false;
+        }
+        return true;
+    });
+}
+
+void InteractionModelEngine::ReleaseWriteHandler(WriteHandler * apWriteHandler)
+{
+    mWriteHandlers.ForEachActiveObject([&](WriteHandler * writeHandler) {
+        if (writeHandler == apWriteHandler)
+        {
+            mWriteHandlers.ReleaseObject(writeHandler);
+            return false;
+        }
+        return true;
+    });
+}
+
+ReadHandler * InteractionModelEngine::NextReportableHandler(const ReadHandler * apAfter)
+{
+    ReadHandler * first = nullptr;
+    ReadHandler * next  = nullptr;
+
+    mReadHandlers.ForEachActiveObject([&](ReadHandler * readHandler) {
+        if (!readHandler->IsReportable())
+        {
+            return true;
+        }
+        if (first == nullptr)
+        {
+            first = readHandler;
+        }
+        if (apAfter == nullptr || readHandler > apAfter)
+        {
+            next = readHandler;
+            return false;
+        }
+        return true;
+    });
+
+    return (next != nullptr) ? next : first;
 }
 
 void InteractionModelEngine::ReleaseClusterInfoList(ClusterInfo *& aClusterInfo)
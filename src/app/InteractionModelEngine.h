@@ -34,6 +34,7 @@
 #include <protocols/interaction_model/Constants.h>
 #include <support/CodeUtils.h>
 #include <support/DLLUtil.h>
+#include <support/Pool.h>
 #include <support/logging/CHIPLogging.h>
 #include <system/SystemPacketBuffer.h>
 
@@ -44,16 +45,13 @@
 #include <app/InteractionModelDelegate.h>
 #include <app/ReadClient.h>
 #include <app/ReadHandler.h>
+#include <app/WriteHandler.h>
 #include <app/reporting/Engine.h>
 #include <app/util/basic-types.h>
 
 // TODO: Make number of command handler and command sender configurable
 #define CHIP_MAX_NUM_COMMAND_HANDLER 4
 #define CHIP_MAX_NUM_COMMAND_SENDER 4
-#define CHIP_MAX_NUM_READ_CLIENT 1
-#define CHIP_MAX_NUM_READ_HANDLER 1
-#define CHIP_MAX_REPORTS_IN_FLIGHT 1
-#define IM_SERVER_MAX_NUM_PATH_GROUPS 8
 
 namespace chip {
 namespace app {
@@ -121,13 +119,32 @@ public:
     CHIP_ERROR NewReadClient(ReadClient ** const apReadClient);
 
     /**
-     *  Get read client index in mReadClients
+     *  Get read client index among the active read clients, for logging
      *
      *  @param[in]    apReadClient    A pointer to a read client object.
      *
-     *  @retval  the index in mReadClients array
+     *  @retval  the index of the read client in mReadClients, or the number of active read clients if it does not come from
+     *           mReadClients
      */
-    uint16_t GetReadClientArrayIndex(const ReadClient * const apReadClient) const;
+    uint16_t GetReadClientArrayIndex(const ReadClient * const apReadClient);
+
+    /**
+     *  Return a read client obtained from NewReadClient to the pool. Called by ReadClient::Shutdown; read clients that do not
+     *  come from the pool are ignored.
+     */
+    void ReleaseReadClient(ReadClient * apReadClient);
+
+    /**
+     *  Return a read handler to the pool. Called by ReadHandler::Shutdown; read handlers that do not come from the pool are
+     *  ignored.
+     */
+    void ReleaseReadHandler(ReadHandler * apReadHandler);
+
+    /**
+     *  Return a write handler to the pool. Called by WriteHandler::Shutdown; write handlers that do not come from the pool are
+     *  ignored.
+     */
+    void ReleaseWriteHandler(WriteHandler * apWriteHandler);
 
     reporting::Engine & GetReportingEngine() { return mReportingEngine; }
 
@@ -136,6 +153,8 @@ public:
 
 private:
     friend class reporting::Engine;
+    friend class TestReadInteraction;
+    friend class TestWriteInteraction;
     void OnUnknownMsgType(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
                           const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload);
     void OnInvokeCommandRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
@@ -145,20 +164,43 @@ private:
     void OnResponseTimeout(Messaging::ExchangeContext * ec);
 
     /**
-     * Called when Interaction Model receives a Read Request message.  Errors processing
-     * the Read Request are handled entirely within this function.
+     * Called when Interaction Model receives a Read Request or a Subscribe Request message.  Errors processing
+     * the request are handled entirely within this function.
      */
     void OnReadRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
-                       const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload);
+                       const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload,
+                       ReadHandler::InteractionType aInteractionType);
+
+    /**
+     * Called when Interaction Model receives a Write Request message.  Errors processing
+     * the request are handled entirely within this function.
+     */
+    void OnWriteRequest(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                        const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload);
+
+    /**
+     * Called when Interaction Model receives a Report Data message outside of a read, which is how a publisher reports on
+     * an established subscription. The report is handed to the read client holding that subscription.
+     */
+    void OnUnsolicitedReportData(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                 const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload);
+
+    /**
+     * Return the first reportable read handler that comes after apAfter in the pool, wrapping around to the start of the pool,
+     * or nullptr if no handler is reportable. Pool slots don't move, so this lets the reporting engine take turns between
+     * handlers even as they come and go.
+     */
+    ReadHandler * NextReportableHandler(const ReadHandler * apAfter);
 
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
     InteractionModelDelegate * mpDelegate      = nullptr;
     CommandHandler mCommandHandlerObjs[CHIP_MAX_NUM_COMMAND_HANDLER];
     CommandSender mCommandSenderObjs[CHIP_MAX_NUM_COMMAND_SENDER];
-    ReadClient mReadClients[CHIP_MAX_NUM_READ_CLIENT];
-    ReadHandler mReadHandlers[CHIP_MAX_NUM_READ_HANDLER];
+    BitMapObjectPool<ReadClient, CHIP_IM_MAX_NUM_READ_CLIENT> mReadClients;
+    BitMapObjectPool<ReadHandler, CHIP_IM_MAX_NUM_READ_HANDLER> mReadHandlers;
+    BitMapObjectPool<WriteHandler, CHIP_IM_MAX_NUM_WRITE_HANDLER> mWriteHandlers;
     reporting::Engine mReportingEngine;
-    ClusterInfo mClusterInfoPool[IM_SERVER_MAX_NUM_PATH_GROUPS];
+    ClusterInfo mClusterInfoPool[CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS];
     ClusterInfo * mpNextAvailableClusterInfo = nullptr;
 };
 
@@ -24,6 +24,8 @@
 #include "AttributePath.h"
 #include "MessageDefHelper.h"
 
+#include <core/CHIPTLVTemplate.h>
+
 #include <inttypes.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -33,6 +35,16 @@ using namespace chip::TLV;
 
 namespace chip {
 namespace app {
+namespace {
+// The AttributePath of an attribute field, the way most paths are written.
+constexpr TLVContainerTemplate<4> kAttributeFieldPathTemplate(
+    kTLVType_List,
+    { TLVTemplateSlot::Context<chip::NodeId>(AttributePath::kCsTag_NodeId),
+      TLVTemplateSlot::Context<chip::EndpointId>(AttributePath::kCsTag_EndpointId),
+      TLVTemplateSlot::Context<chip::ClusterId>(AttributePath::kCsTag_ClusterId),
+      TLVTemplateSlot::Context<chip::FieldId>(AttributePath::kCsTag_FieldId) });
+} // namespace
+
 CHIP_ERROR AttributePath::Parser::Init(const chip::TLV::TLVReader & aReader)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -284,5 +296,30 @@ AttributePath::Builder & AttributePath::Builder::EndOfAttributePath()
     EndOfContainer();
     return *this;
 }
+
+CHIP_ERROR AttributePath::Builder::Encode(chip::TLV::TLVWriter * const apWriter, const chip::NodeId aNodeId,
+                                          const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId,
+                                          const chip::FieldId aFieldId)
+{
+    return _Encode(apWriter, chip::TLV::AnonymousTag, aNodeId, aEndpointId, aClusterId, aFieldId);
+}
+
+CHIP_ERROR AttributePath::Builder::Encode(chip::TLV::TLVWriter * const apWriter, const uint8_t aContextTagToUse,
+                                          const chip::NodeId aNodeId, const chip::EndpointId aEndpointId,
+                                          const chip::ClusterId aClusterId, const chip::FieldId aFieldId)
+{
+    return _Encode(apWriter, chip::TLV::ContextTag(aContextTagToUse), aNodeId, aEndpointId, aClusterId, aFieldId);
+}
+
+CHIP_ERROR AttributePath::Builder::_Encode(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag, const chip::NodeId aNodeId,
+                                           const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId,
+                                           const chip::FieldId aFieldId)
+{
+    mpWriter = apWriter;
+    mError   = kAttributeFieldPathTemplate.Encode(*mpWriter, aTag, { aNodeId, aEndpointId, aClusterId, aFieldId });
+    ChipLogFunctError(mError);
+
+    return mError;
+}
 }; // namespace app
 }; // namespace chip
@@ -202,8 +202,40 @@ public:
      */
     AttributePath::Builder & EndOfAttributePath();
 
+    /**
+     *  @brief Encode a whole AttributePath with a NodeId, an EndpointId, a ClusterId and a FieldId in one go, in place of
+     *  Init, the setters and EndOfAttributePath. Its encoding is precomputed, only the ids are patched into it.
+     *
+     *  @param [in] apWriter    A pointer to TLVWriter
+     *  @param [in] aNodeId     The node id
+     *  @param [in] aEndpointId The endpoint id
+     *  @param [in] aClusterId  The cluster id
+     *  @param [in] aFieldId    The field id
+     *
+     *  @return #CHIP_NO_ERROR on success
+     */
+    CHIP_ERROR Encode(chip::TLV::TLVWriter * const apWriter, const chip::NodeId aNodeId, const chip::EndpointId aEndpointId,
+                      const chip::ClusterId aClusterId, const chip::FieldId aFieldId);
+
+    /**
+     *  @brief Encode a whole AttributePath in one go with a particular context tag.
+     *
+     *  @param [in] apWriter            A pointer to TLVWriter
+     *  @param [in] aContextTagToUse    A contextTag to use.
+     *  @param [in] aNodeId             The node id
+     *  @param [in] aEndpointId         The endpoint id
+     *  @param [in] aClusterId          The cluster id
+     *  @param [in] aFieldId            The field id
+     *
+     *  @return #CHIP_NO_ERROR on success
+     */
+    CHIP_ERROR Encode(chip::TLV::TLVWriter * const apWriter, const uint8_t aContextTagToUse, const chip::NodeId aNodeId,
+                      const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId, const chip::FieldId aFieldId);
+
 private:
     CHIP_ERROR _Init(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag);
+    CHIP_ERROR _Encode(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag, const chip::NodeId aNodeId,
+                       const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId, const chip::FieldId aFieldId);
 };
 
 }; // namespace AttributePath
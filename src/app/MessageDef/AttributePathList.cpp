@@ -94,6 +94,21 @@ exit:
     return mAttributePathBuilder;
 }
 
+AttributePath::Builder & AttributePathList::Builder::EncodeAttributePath(const chip::NodeId aNodeId,
+                                                                         const chip::EndpointId aEndpointId,
+                                                                         const chip::ClusterId aClusterId,
+                                                                         const chip::FieldId aFieldId)
+{
+    // skip if error has already been set
+    VerifyOrExit(CHIP_NO_ERROR == mError, mAttributePathBuilder.ResetError(mError));
+
+    mError = mAttributePathBuilder.Encode(mpWriter, aNodeId, aEndpointId, aClusterId, aFieldId);
+    ChipLogFunctError(mError);
+
+exit:
+    return mAttributePathBuilder;
+}
+
 // Mark the end of this array and recover the type for outer container
 AttributePathList::Builder & AttributePathList::Builder::EndOfAttributePathList()
 {
@@ -67,6 +67,14 @@ public:
      */
     AttributePath::Builder & CreateAttributePathBuilder();
 
+    /**
+     *  @brief Encode a whole AttributePath into the TLV stream in one go, from its precomputed encoding
+     *
+     *  @return A reference to AttributePath::Builder
+     */
+    AttributePath::Builder & EncodeAttributePath(const chip::NodeId aNodeId, const chip::EndpointId aEndpointId,
+                                                 const chip::ClusterId aClusterId, const chip::FieldId aFieldId);
+
     /**
      *  @brief Mark the end of this AttributePath
      *
@@ -51,6 +51,21 @@ exit:
     return mAttributePathBuilder;
 }
 
+AttributePath::Builder & AttributeStatusElement::Builder::EncodeAttributePath(const chip::NodeId aNodeId,
+                                                                              const chip::EndpointId aEndpointId,
+                                                                              const chip::ClusterId aClusterId,
+                                                                              const chip::FieldId aFieldId)
+{
+    // skip if error has already been set
+    VerifyOrExit(CHIP_NO_ERROR == mError, mAttributePathBuilder.ResetError(mError));
+
+    mError = mAttributePathBuilder.Encode(mpWriter, kCsTag_AttributePath, aNodeId, aEndpointId, aClusterId, aFieldId);
+    ChipLogFunctError(mError);
+
+exit:
+    return mAttributePathBuilder;
+}
+
 StatusElement::Builder & AttributeStatusElement::Builder::CreateStatusElementBuilder()
 {
     // skip if error has already been set
@@ -63,6 +78,20 @@ exit:
     return mStatusElementBuilder;
 }
 
+StatusElement::Builder &
+AttributeStatusElement::Builder::EncodeStatusElement(const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                                     const uint32_t aProtocolId, const uint16_t aProtocolCode)
+{
+    // skip if error has already been set
+    VerifyOrExit(CHIP_NO_ERROR == mError, mStatusElementBuilder.ResetError(mError));
+
+    mError = mStatusElementBuilder.Encode(mpWriter, kCsTag_StatusElement, aGeneralCode, aProtocolId, aProtocolCode);
+    ChipLogFunctError(mError);
+
+exit:
+    return mStatusElementBuilder;
+}
+
 AttributeStatusElement::Builder & AttributeStatusElement::Builder::EndOfAttributeStatusElement()
 {
     EndOfContainer();
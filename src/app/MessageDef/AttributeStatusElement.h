@@ -61,6 +61,14 @@ public:
      */
     AttributePath::Builder & CreateAttributePathBuilder();
 
+    /**
+     *  @brief Encode a whole AttributePath into the TLV stream in one go, from its precomputed encoding
+     *
+     *  @return A reference to AttributePath::Builder
+     */
+    AttributePath::Builder & EncodeAttributePath(const chip::NodeId aNodeId, const chip::EndpointId aEndpointId,
+                                                 const chip::ClusterId aClusterId, const chip::FieldId aFieldId);
+
     /**
      *  @brief Initialize a StatusElement::Builder for writing into the TLV stream
      *
@@ -68,6 +76,14 @@ public:
      */
     StatusElement::Builder & CreateStatusElementBuilder();
 
+    /**
+     *  @brief Encode a whole StatusElement into the TLV stream in one go, from its precomputed encoding
+     *
+     *  @return A reference to StatusElement::Builder
+     */
+    StatusElement::Builder & EncodeStatusElement(const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                                 const uint32_t aProtocolId, const uint16_t aProtocolCode);
+
     /**
      *  @brief Mark the end of this AttributeStatusElement
      *
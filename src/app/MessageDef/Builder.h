@@ -79,11 +79,15 @@ public:
     void Checkpoint(chip::TLV::TLVWriter & aPoint) { aPoint = *mpWriter; };
 
     /**
-     * Rollback the request state to the checkpointed TLVWriter
+     * Rollback the request state to the checkpointed TLVWriter, along with any error met since
      *
      * @param[in] aPoint A that captured the state via Checkpoint() at some point in the past
      */
-    void Rollback(const chip::TLV::TLVWriter & aPoint) { *mpWriter = aPoint; }
+    void Rollback(const chip::TLV::TLVWriter & aPoint)
+    {
+        *mpWriter = aPoint;
+        mError    = CHIP_NO_ERROR;
+    }
 
 protected:
     CHIP_ERROR mError;
@@ -129,6 +129,14 @@ public:
      */
     CommandPath::Builder & CreateCommandPathBuilder();
 
+    /**
+     *  @brief Encode a whole CommandPath with an EndpointId into the TLV stream in one go, from its precomputed encoding
+     *
+     *  @return A reference to CommandPath::Builder
+     */
+    CommandPath::Builder & EncodeCommandPath(const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId,
+                                             const chip::CommandId aCommandId);
+
     /**
      *  @brief Initialize a StatusElement::Builder for writing into the TLV stream
      *
@@ -136,6 +144,14 @@ public:
      */
     StatusElement::Builder & CreateStatusElementBuilder();
 
+    /**
+     *  @brief Encode a whole StatusElement into the TLV stream in one go, from its precomputed encoding
+     *
+     *  @return A reference to StatusElement::Builder
+     */
+    StatusElement::Builder & EncodeStatusElement(const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                                 const uint32_t aProtocolId, const uint16_t aProtocolCode);
+
     /**
      *  @brief Mark the end of this CommandDataElement
      *
@@ -25,6 +25,8 @@
 
 #include "MessageDefHelper.h"
 
+#include <core/CHIPTLVTemplate.h>
+
 #include <inttypes.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -34,6 +36,15 @@ using namespace chip::TLV;
 
 namespace chip {
 namespace app {
+namespace {
+// The CommandPath of a command sent to an endpoint, the way most paths are written.
+constexpr TLVContainerTemplate<3> kEndpointCommandPathTemplate(
+    kTLVType_List,
+    { TLVTemplateSlot::Context<chip::EndpointId>(CommandPath::kCsTag_EndpointId),
+      TLVTemplateSlot::Context<chip::ClusterId>(CommandPath::kCsTag_ClusterId),
+      TLVTemplateSlot::Context<chip::CommandId>(CommandPath::kCsTag_CommandId) });
+} // namespace
+
 CHIP_ERROR CommandPath::Parser::Init(const chip::TLV::TLVReader & aReader)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -249,5 +260,29 @@ CommandPath::Builder & CommandPath::Builder::EndOfCommandPath()
     return *this;
 }
 
+CHIP_ERROR CommandPath::Builder::Encode(chip::TLV::TLVWriter * const apWriter, const chip::EndpointId aEndpointId,
+                                        const chip::ClusterId aClusterId, const chip::CommandId aCommandId)
+{
+    return _Encode(apWriter, chip::TLV::AnonymousTag, aEndpointId, aClusterId, aCommandId);
+}
+
+CHIP_ERROR CommandPath::Builder::Encode(chip::TLV::TLVWriter * const apWriter, const uint8_t aContextTagToUse,
+                                        const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId,
+                                        const chip::CommandId aCommandId)
+{
+    return _Encode(apWriter, chip::TLV::ContextTag(aContextTagToUse), aEndpointId, aClusterId, aCommandId);
+}
+
+CHIP_ERROR CommandPath::Builder::_Encode(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag,
+                                         const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId,
+                                         const chip::CommandId aCommandId)
+{
+    mpWriter = apWriter;
+    mError   = kEndpointCommandPathTemplate.Encode(*mpWriter, aTag, { aEndpointId, aClusterId, aCommandId });
+    ChipLogFunctError(mError);
+
+    return mError;
+}
+
 }; // namespace app
 }; // namespace chip
@@ -182,8 +182,38 @@ public:
      */
     CommandPath::Builder & EndOfCommandPath();
 
+    /**
+     *  @brief Encode a whole CommandPath with an EndpointId, a ClusterId and a CommandId in one go, in place of Init, the
+     *  setters and EndOfCommandPath. Its encoding is precomputed, only the ids are patched into it.
+     *
+     *  @param [in] apWriter    A pointer to TLVWriter
+     *  @param [in] aEndpointId The endpoint id
+     *  @param [in] aClusterId  The cluster id
+     *  @param [in] aCommandId  The command id
+     *
+     *  @return #CHIP_NO_ERROR on success
+     */
+    CHIP_ERROR Encode(chip::TLV::TLVWriter * const apWriter, const chip::EndpointId aEndpointId, const chip::ClusterId aClusterId,
+                      const chip::CommandId aCommandId);
+
+    /**
+     *  @brief Encode a whole CommandPath in one go with a particular context tag.
+     *
+     *  @param [in] apWriter            A pointer to TLVWriter
+     *  @param [in] aContextTagToUse    A contextTag to use.
+     *  @param [in] aEndpointId         The endpoint id
+     *  @param [in] aClusterId          The cluster id
+     *  @param [in] aCommandId          The command id
+     *
+     *  @return #CHIP_NO_ERROR on success
+     */
+    CHIP_ERROR Encode(chip::TLV::TLVWriter * const apWriter, const uint8_t aContextTagToUse, const chip::EndpointId aEndpointId,
+                      const chip::ClusterId aClusterId, const chip::CommandId aCommandId);
+
 private:
     CHIP_ERROR _Init(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag);
+    CHIP_ERROR _Encode(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag, const chip::EndpointId aEndpointId,
+                       const chip::ClusterId aClusterId, const chip::CommandId aCommandId);
 };
 }; // namespace CommandPath
 
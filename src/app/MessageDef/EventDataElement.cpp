@@ -121,57 +121,45 @@ EventDataElement::Parser::ParseData(chip::TLV::TLVReader & aReader, int aDepth)
     }
 
     case chip::TLV::kTLVType_UTF8String: {
-        char value_s[256];
-
-        err = aReader.GetString(value_s, sizeof(value_s));
-        VerifyOrExit(err == CHIP_NO_ERROR || err == CHIP_ERROR_BUFFER_TOO_SMALL, );
-
-        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+        // The string is printed straight from the message, however many buffers it is spread over.
+        if (aReader.GetLength() >= 256)
         {
             PRETTY_PRINT_SAMELINE("... (byte string too long) ...");
-            err = CHIP_NO_ERROR;
-        }
-        else
-        {
-            PRETTY_PRINT_SAMELINE("\"%s\", ", value_s);
+            break;
         }
+
+        PRETTY_PRINT_SAMELINE("\"");
+        err = aReader.ForEachDataSpan([](const chip::ByteSpan & aSpan) {
+            IgnoreUnusedVariable(aSpan);
+            PRETTY_PRINT_SAMELINE("%.*s", static_cast<int>(aSpan.size()), reinterpret_cast<const char *>(aSpan.data()));
+            return true;
+        });
+        SuccessOrExit(err);
+        PRETTY_PRINT_SAMELINE("\", ");
         break;
     }
 
     case chip::TLV::kTLVType_ByteString: {
-        uint8_t value_b[256];
-        uint32_t len, readerLen;
-
-        readerLen = aReader.GetLength();
-
-        err = aReader.GetBytes(value_b, sizeof(value_b));
-        VerifyOrExit(err == CHIP_NO_ERROR || err == CHIP_ERROR_BUFFER_TOO_SMALL, );
-
         PRETTY_PRINT_SAMELINE("[");
         PRETTY_PRINT("\t\t");
 
-        if (readerLen < sizeof(value_b))
-        {
-            len = readerLen;
-        }
-        else
-        {
-            len = sizeof(value_b);
-        }
-
-        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+        if (aReader.GetLength() > 256)
         {
             PRETTY_PRINT_SAMELINE("... (byte string too long) ...");
         }
         else
         {
-            for (size_t i = 0; i < len; i++)
-            {
-                PRETTY_PRINT_SAMELINE("0x%" PRIx8 ", ", value_b[i]);
-            }
+            err = aReader.ForEachDataSpan([](const chip::ByteSpan & aSpan) {
+                IgnoreUnusedVariable(aSpan);
+                for (size_t i = 0; i < aSpan.size(); i++)
+                {
+                    PRETTY_PRINT_SAMELINE("0x%" PRIx8 ", ", aSpan.data()[i]);
+                }
+                return true;
+            });
+            SuccessOrExit(err);
         }
 
-        err = CHIP_NO_ERROR;
         PRETTY_PRINT("\t\t]");
         break;
     }
@@ -25,6 +25,8 @@
 
 #include "MessageDefHelper.h"
 
+#include <core/CHIPTLVTemplate.h>
+
 #include <inttypes.h>
 #include <stdarg.h>
 #include <stdio.h>
@@ -34,6 +36,14 @@ using namespace chip::TLV;
 
 namespace chip {
 namespace app {
+namespace {
+// The StatusElement written by EncodeStatusElement: the general code, the protocol id and the protocol code.
+constexpr TLVContainerTemplate<3> kStatusElementTemplate(kTLVType_Array,
+                                                         { TLVTemplateSlot::Anonymous<uint16_t>(),
+                                                           TLVTemplateSlot::Anonymous<uint32_t>(),
+                                                           TLVTemplateSlot::Anonymous<uint16_t>() });
+} // namespace
+
 CHIP_ERROR StatusElement::Parser::Init(const chip::TLV::TLVReader & aReader)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -215,5 +225,30 @@ StatusElement::Builder & StatusElement::Builder::EndOfStatusElement()
     return *this;
 }
 
+CHIP_ERROR StatusElement::Builder::Encode(chip::TLV::TLVWriter * const apWriter,
+                                          const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                          const uint32_t aProtocolId, const uint16_t aProtocolCode)
+{
+    return _Encode(apWriter, chip::TLV::AnonymousTag, aGeneralCode, aProtocolId, aProtocolCode);
+}
+
+CHIP_ERROR StatusElement::Builder::Encode(chip::TLV::TLVWriter * const apWriter, const uint8_t aContextTagToUse,
+                                          const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                          const uint32_t aProtocolId, const uint16_t aProtocolCode)
+{
+    return _Encode(apWriter, chip::TLV::ContextTag(aContextTagToUse), aGeneralCode, aProtocolId, aProtocolCode);
+}
+
+CHIP_ERROR StatusElement::Builder::_Encode(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag,
+                                           const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                           const uint32_t aProtocolId, const uint16_t aProtocolCode)
+{
+    mpWriter = apWriter;
+    mError   = kStatusElementTemplate.Encode(*mpWriter, aTag, { static_cast<uint16_t>(aGeneralCode), aProtocolId, aProtocolCode });
+    ChipLogFunctError(mError);
+
+    return mError;
+}
+
 }; // namespace app
 }; // namespace chip
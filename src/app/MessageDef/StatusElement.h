@@ -131,6 +131,40 @@ public:
      *  @return A reference to *this
      */
     StatusElement::Builder & EndOfStatusElement();
+
+    /**
+     * Encode a whole StatusElement in one go, in place of Init, EncodeStatusElement and EndOfStatusElement.
+     * Its encoding is precomputed, only the codes are patched into it.
+     *
+     * @param[in]   apWriter        Pointer to the TLVWriter that is encoding the message.
+     * @param[in]   aGeneralCode    General status code
+     * @param[in]   aProtocolId     A protocol ID (32-bit integer composed of a 16-bit vendor id and 16-bit Scoped id)
+     * @param[in]   aProtocolCode   16-bit protocol-specific error code
+     *
+     * @return       CHIP_ERROR codes returned by chip::TLV objects.
+     */
+    CHIP_ERROR Encode(chip::TLV::TLVWriter * const apWriter, const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                      const uint32_t aProtocolId, const uint16_t aProtocolCode);
+
+    /**
+     * Encode a whole StatusElement in one go with a particular context tag.
+     *
+     * @param[in]   apWriter            Pointer to the TLVWriter that is encoding the message.
+     * @param[in]   aContextTagToUse    A contextTag to use.
+     * @param[in]   aGeneralCode        General status code
+     * @param[in]   aProtocolId         A protocol ID (32-bit integer composed of a 16-bit vendor id and 16-bit Scoped id)
+     * @param[in]   aProtocolCode       16-bit protocol-specific error code
+     *
+     * @return       CHIP_ERROR codes returned by chip::TLV objects.
+     */
+    CHIP_ERROR Encode(chip::TLV::TLVWriter * const apWriter, const uint8_t aContextTagToUse,
+                      const Protocols::SecureChannel::GeneralStatusCode aGeneralCode, const uint32_t aProtocolId,
+                      const uint16_t aProtocolCode);
+
+private:
+    CHIP_ERROR _Encode(chip::TLV::TLVWriter * const apWriter, const uint64_t aTag,
+                       const Protocols::SecureChannel::GeneralStatusCode aGeneralCode, const uint32_t aProtocolId,
+                       const uint16_t aProtocolCode);
 };
 }; // namespace StatusElement
 
@@ -0,0 +1,331 @@
+/**
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ *    @file
+ *      This file defines SubscribeRequest parser and builder in CHIP interaction model
+ *
+ */
+
+#include "SubscribeRequest.h"
+#include "MessageDefHelper.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+using namespace chip;
+using namespace chip::TLV;
+
+namespace chip {
+namespace app {
+CHIP_ERROR SubscribeRequest::Parser::Init(const chip::TLV::TLVReader & aReader)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // make a copy of the reader here
+    mReader.Init(aReader);
+
+    VerifyOrExit(chip::TLV::kTLVType_Structure == mReader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    // This is just a dummy, as we're not going to exit this container ever
+    chip::TLV::TLVType OuterContainerType;
+    err = mReader.EnterContainer(OuterContainerType);
+
+exit:
+    ChipLogFunctError(err);
+
+    return err;
+}
+
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+CHIP_ERROR SubscribeRequest::Parser::CheckSchemaValidity() const
+{
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    uint16_t TagPresenceMask = 0;
+    chip::TLV::TLVReader reader;
+    AttributePathList::Parser attributePathList;
+    EventPathList::Parser eventPathList;
+    AttributeDataVersionList::Parser attributeDataVersionList;
+    PRETTY_PRINT("SubscribeRequest =");
+    PRETTY_PRINT("{");
+
+    // make a copy of the reader
+    reader.Init(mReader);
+
+    while (CHIP_NO_ERROR == (err = reader.Next()))
+    {
+        VerifyOrExit(chip::TLV::IsContextTag(reader.GetTag()), err = CHIP_ERROR_INVALID_TLV_TAG);
+
+        switch (chip::TLV::TagNumFromTag(reader.GetTag()))
+        {
+        case kCsTag_AttributePathList:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_AttributePathList)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_AttributePathList);
+            VerifyOrExit(chip::TLV::kTLVType_Array == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+            attributePathList.Init(reader);
+
+            PRETTY_PRINT_INCDEPTH();
+            err = attributePathList.CheckSchemaValidity();
+            SuccessOrExit(err);
+            PRETTY_PRINT_DECDEPTH();
+            break;
+        case kCsTag_EventPathList:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_EventPathList)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_EventPathList);
+            VerifyOrExit(chip::TLV::kTLVType_Array == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+            eventPathList.Init(reader);
+
+            PRETTY_PRINT_INCDEPTH();
+            err = eventPathList.CheckSchemaValidity();
+            SuccessOrExit(err);
+            PRETTY_PRINT_DECDEPTH();
+            break;
+        case kCsTag_AttributeDataVersionList:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_AttributeDataVersionList)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_AttributeDataVersionList);
+            VerifyOrExit(chip::TLV::kTLVType_Array == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+            attributeDataVersionList.Init(reader);
+
+            PRETTY_PRINT_INCDEPTH();
+            err = attributeDataVersionList.CheckSchemaValidity();
+            SuccessOrExit(err);
+            PRETTY_PRINT_DECDEPTH();
+            break;
+        case kCsTag_EventNumber:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_EventNumber)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_EventNumber);
+            VerifyOrExit(chip::TLV::kTLVType_UnsignedInteger == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+#if CHIP_DETAIL_LOGGING
+            {
+                uint64_t eventNumber;
+                err = reader.Get(eventNumber);
+                SuccessOrExit(err);
+                PRETTY_PRINT("\tEventNumber = 0x%" PRIx64 ",", eventNumber);
+            }
+#endif // CHIP_DETAIL_LOGGING
+            break;
+        case kCsTag_MinIntervalSeconds:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_MinIntervalSeconds)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_MinIntervalSeconds);
+            VerifyOrExit(chip::TLV::kTLVType_UnsignedInteger == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+#if CHIP_DETAIL_LOGGING
+            {
+                uint16_t minIntervalSeconds;
+                err = reader.Get(minIntervalSeconds);
+                SuccessOrExit(err);
+                PRETTY_PRINT("\tMinIntervalSeconds = 0x%" PRIx16 ",", minIntervalSeconds);
+            }
+#endif // CHIP_DETAIL_LOGGING
+            break;
+        case kCsTag_MaxIntervalSeconds:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_MaxIntervalSeconds)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_MaxIntervalSeconds);
+            VerifyOrExit(chip::TLV::kTLVType_UnsignedInteger == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+#if CHIP_DETAIL_LOGGING
+            {
+                uint16_t maxIntervalSeconds;
+                err = reader.Get(maxIntervalSeconds);
+                SuccessOrExit(err);
+                PRETTY_PRINT("\tMaxIntervalSeconds = 0x%" PRIx16 ",", maxIntervalSeconds);
+            }
+#endif // CHIP_DETAIL_LOGGING
+            break;
+        default:
+            ExitNow(err = CHIP_ERROR_INVALID_TLV_TAG);
+        }
+    }
+
+    PRETTY_PRINT("}");
+    PRETTY_PRINT("");
+
+    // if we have exhausted this container
+    if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    ChipLogFunctError(err);
+
+    return err;
+}
+#endif // CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+
+CHIP_ERROR SubscribeRequest::Parser::GetAttributePathList(AttributePathList::Parser * const apAttributePathList) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::TLV::TLVReader reader;
+
+    err = mReader.FindElementWithTag(chip::TLV::ContextTag(kCsTag_AttributePathList), reader);
+    SuccessOrExit(err);
+
+    VerifyOrExit(chip::TLV::kTLVType_Array == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    err = apAttributePathList->Init(reader);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogIfFalse((CHIP_NO_ERROR == err) || (CHIP_END_OF_TLV == err));
+
+    return err;
+}
+
+CHIP_ERROR SubscribeRequest::Parser::GetEventPathList(EventPathList::Parser * const apEventPathList) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::TLV::TLVReader reader;
+
+    err = mReader.FindElementWithTag(chip::TLV::ContextTag(kCsTag_EventPathList), reader);
+    SuccessOrExit(err);
+
+    VerifyOrExit(chip::TLV::kTLVType_Array == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    err = apEventPathList->Init(reader);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogIfFalse((CHIP_NO_ERROR == err) || (CHIP_END_OF_TLV == err));
+
+    return err;
+}
+
+CHIP_ERROR
+SubscribeRequest::Parser::GetAttributeDataVersionList(AttributeDataVersionList::Parser * const apAttributeDataVersionList) const
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::TLV::TLVReader reader;
+
+    err = mReader.FindElementWithTag(chip::TLV::ContextTag(kCsTag_AttributeDataVersionList), reader);
+    SuccessOrExit(err);
+
+    VerifyOrExit(chip::TLV::kTLVType_Array == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    err = apAttributeDataVersionList->Init(reader);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogIfFalse((CHIP_NO_ERROR == err) || (CHIP_END_OF_TLV == err));
+
+    return err;
+}
+
+CHIP_ERROR SubscribeRequest::Parser::GetEventNumber(uint64_t * const apEventNumber) const
+{
+    return GetUnsignedInteger(kCsTag_EventNumber, apEventNumber);
+}
+
+CHIP_ERROR SubscribeRequest::Parser::GetMinIntervalSeconds(uint16_t * const apMinIntervalSeconds) const
+{
+    return GetUnsignedInteger(kCsTag_MinIntervalSeconds, apMinIntervalSeconds);
+}
+
+CHIP_ERROR SubscribeRequest::Parser::GetMaxIntervalSeconds(uint16_t * const apMaxIntervalSeconds) const
+{
+    return GetUnsignedInteger(kCsTag_MaxIntervalSeconds, apMaxIntervalSeconds);
+}
+
+CHIP_ERROR SubscribeRequest::Builder::Init(chip::TLV::TLVWriter * const apWriter)
+{
+    return InitAnonymousStructure(apWriter);
+}
+
+AttributePathList::Builder & SubscribeRequest::Builder::CreateAttributePathListBuilder()
+{
+    // skip if error has already been set
+    VerifyOrExit(CHIP_NO_ERROR == mError, mAttributePathListBuilder.ResetError(mError));
+
+    mError = mAttributePathListBuilder.Init(mpWriter, kCsTag_AttributePathList);
+    ChipLogFunctError(mError);
+
+exit:
+    // on error, mAttributePathListBuilder would be un-/partial initialized and cannot be used to write anything
+    return mAttributePathListBuilder;
+}
+
+EventPathList::Builder & SubscribeRequest::Builder::CreateEventPathListBuilder()
+{
+    // skip if error has already been set
+    VerifyOrExit(CHIP_NO_ERROR == mError, mEventPathListBuilder.ResetError(mError));
+
+    mError = mEventPathListBuilder.Init(mpWriter, kCsTag_EventPathList);
+    ChipLogFunctError(mError);
+
+exit:
+    // on error, mEventPathListBuilder would be un-/partial initialized and cannot be used to write anything
+    return mEventPathListBuilder;
+}
+
+AttributeDataVersionList::Builder & SubscribeRequest::Builder::CreateAttributeDataVersionListBuilder()
+{
+    // skip if error has already been set
+    VerifyOrExit(CHIP_NO_ERROR == mError, mAttributeDataVersionListBuilder.ResetError(mError));
+
+    mError = mAttributeDataVersionListBuilder.Init(mpWriter, kCsTag_AttributeDataVersionList);
+    ChipLogFunctError(mError);
+
+exit:
+    // on error, mAttributeDataVersionListBuilder would be un-/partial initialized and cannot be used to write anything
+    return mAttributeDataVersionListBuilder;
+}
+
+SubscribeRequest::Builder & SubscribeRequest::Builder::EventNumber(const uint64_t aEventNumber)
+{
+    // skip if error has already been set
+    SuccessOrExit(mError);
+
+    mError = mpWriter->Put(chip::TLV::ContextTag(kCsTag_EventNumber), aEventNumber);
+    ChipLogFunctError(mError);
+
+exit:
+    return *this;
+}
+
+SubscribeRequest::Builder & SubscribeRequest::Builder::MinIntervalSeconds(const uint16_t aMinIntervalSeconds)
+{
+    // skip if error has already been set
+    SuccessOrExit(mError);
+
+    mError = mpWriter->Put(chip::TLV::ContextTag(kCsTag_MinIntervalSeconds), aMinIntervalSeconds);
+    ChipLogFunctError(mError);
+
+exit:
+    return *this;
+}
+
+SubscribeRequest::Builder & SubscribeRequest::Builder::MaxIntervalSeconds(const uint16_t aMaxIntervalSeconds)
+{
+    // skip if error has already been set
+    SuccessOrExit(mError);
+
+    mError = mpWriter->Put(chip::TLV::ContextTag(kCsTag_MaxIntervalSeconds), aMaxIntervalSeconds);
+    ChipLogFunctError(mError);
+
+exit:
+    return *this;
+}
+
+SubscribeRequest::Builder & SubscribeRequest::Builder::EndOfSubscribeRequest()
+{
+    EndOfContainer();
+    return *this;
+}
+}; // namespace app
+}; // namespace chip
@@ -0,0 +1,166 @@
+/**
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ *    @file
+ *      This file defines SubscribeResponse parser and builder in CHIP interaction model
+ *
+ */
+
+#include "SubscribeResponse.h"
+#include "MessageDefHelper.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+using namespace chip;
+using namespace chip::TLV;
+
+namespace chip {
+namespace app {
+CHIP_ERROR SubscribeResponse::Parser::Init(const chip::TLV::TLVReader & aReader)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    // make a copy of the reader here
+    mReader.Init(aReader);
+
+    VerifyOrExit(chip::TLV::kTLVType_Structure == mReader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+
+    // This is just a dummy, as we're not going to exit this container ever
+    chip::TLV::TLVType OuterContainerType;
+    err = mReader.EnterContainer(OuterContainerType);
+
+exit:
+    ChipLogFunctError(err);
+
+    return err;
+}
+
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+CHIP_ERROR SubscribeResponse::Parser::CheckSchemaValidity() const
+{
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    uint16_t TagPresenceMask = 0;
+    chip::TLV::TLVReader reader;
+
+    PRETTY_PRINT("SubscribeResponse =");
+    PRETTY_PRINT("{");
+
+    // make a copy of the reader
+    reader.Init(mReader);
+
+    while (CHIP_NO_ERROR == (err = reader.Next()))
+    {
+        VerifyOrExit(chip::TLV::IsContextTag(reader.GetTag()), err = CHIP_ERROR_INVALID_TLV_TAG);
+
+        switch (chip::TLV::TagNumFromTag(reader.GetTag()))
+        {
+        case kCsTag_SubscriptionId:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_SubscriptionId)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_SubscriptionId);
+            VerifyOrExit(chip::TLV::kTLVType_UnsignedInteger == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+#if CHIP_DETAIL_LOGGING
+            {
+                uint64_t subscriptionId;
+                err = reader.Get(subscriptionId);
+                SuccessOrExit(err);
+                PRETTY_PRINT("\tSubscriptionId = 0x%" PRIx64 ",", subscriptionId);
+            }
+#endif // CHIP_DETAIL_LOGGING
+            break;
+        case kCsTag_FinalSyncIntervalSeconds:
+            VerifyOrExit(!(TagPresenceMask & (1 << kCsTag_FinalSyncIntervalSeconds)), err = CHIP_ERROR_INVALID_TLV_TAG);
+            TagPresenceMask |= (1 << kCsTag_FinalSyncIntervalSeconds);
+            VerifyOrExit(chip::TLV::kTLVType_UnsignedInteger == reader.GetType(), err = CHIP_ERROR_WRONG_TLV_TYPE);
+#if CHIP_DETAIL_LOGGING
+            {
+                uint16_t finalSyncIntervalSeconds;
+                err = reader.Get(finalSyncIntervalSeconds);
+                SuccessOrExit(err);
+                PRETTY_PRINT("\tFinalSyncIntervalSeconds = 0x%" PRIx16 ",", finalSyncIntervalSeconds);
+            }
+#endif // CHIP_DETAIL_LOGGING
+            break;
+        default:
+            ExitNow(err = CHIP_ERROR_INVALID_TLV_TAG);
+        }
+    }
+
+    PRETTY_PRINT("}");
+    PRETTY_PRINT("");
+
+    // if we have exhausted this container
+    if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    ChipLogFunctError(err);
+
+    return err;
+}
+#endif // CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+
+CHIP_ERROR SubscribeResponse::Parser::GetSubscriptionId(uint64_t * const apSubscriptionId) const
+{
+    return GetUnsignedInteger(kCsTag_SubscriptionId, apSubscriptionId);
+}
+
+CHIP_ERROR SubscribeResponse::Parser::GetFinalSyncIntervalSeconds(uint16_t * const apFinalSyncIntervalSeconds) const
+{
+    return GetUnsignedInteger(kCsTag_FinalSyncIntervalSeconds, apFinalSyncIntervalSeconds);
+}
+
+CHIP_ERROR SubscribeResponse::Builder::Init(chip::TLV::TLVWriter * const apWriter)
+{
+    return InitAnonymousStructure(apWriter);
+}
+
+SubscribeResponse::Builder & SubscribeResponse::Builder::SubscriptionId(const uint64_t aSubscriptionId)
+{
+    // skip if error has already been set
+    SuccessOrExit(mError);
+
+    mError = mpWriter->Put(chip::TLV::ContextTag(kCsTag_SubscriptionId), aSubscriptionId);
+    ChipLogFunctError(mError);
+
+exit:
+    return *this;
+}
+
+SubscribeResponse::Builder & SubscribeResponse::Builder::FinalSyncIntervalSeconds(const uint16_t aFinalSyncIntervalSeconds)
+{
+    // skip if error has already been set
+    SuccessOrExit(mError);
+
+    mError = mpWriter->Put(chip::TLV::ContextTag(kCsTag_FinalSyncIntervalSeconds), aFinalSyncIntervalSeconds);
+    ChipLogFunctError(mError);
+
+exit:
+    return *this;
+}
+
+SubscribeResponse::Builder & SubscribeResponse::Builder::EndOfSubscribeResponse()
+{
+    EndOfContainer();
+    return *this;
+}
+}; // namespace app
+}; // namespace chip
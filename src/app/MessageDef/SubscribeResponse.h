@@ -0,0 +1,133 @@
+/**
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ *    @file
+ *      This file defines SubscribeResponse parser and builder in CHIP interaction model
+ *
+ */
+
+#pragma once
+
+#include "Builder.h"
+
+#include "Parser.h"
+#include <app/util/basic-types.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPTLV.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+namespace SubscribeResponse {
+enum
+{
+    kCsTag_SubscriptionId           = 0,
+    kCsTag_FinalSyncIntervalSeconds = 1,
+};
+
+class Parser : public chip::app::Parser
+{
+public:
+    /**
+     *  @brief Initialize the parser object with TLVReader
+     *
+     *  @param [in] aReader A pointer to a TLVReader, which should point to the beginning of this response
+     *
+     *  @return #CHIP_NO_ERROR on success
+     */
+    CHIP_ERROR Init(const chip::TLV::TLVReader & aReader);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    /**
+     *  @brief Roughly verify the message is correctly formed
+     *   1) all mandatory tags are present
+     *   2) all elements have expected data type
+     *   3) any tag can only appear once
+     *   4) At the top level of the structure, unknown tags are ignored for forward compatibility
+     *  @note The main use of this function is to print out what we're
+     *    receiving during protocol development and debugging.
+     *    The encoding rule has changed in IM encoding spec so this
+     *    check is only "roughly" conformant now.
+     *
+     *  @return #CHIP_NO_ERROR on success
+     */
+    CHIP_ERROR CheckSchemaValidity() const;
+#endif
+
+    /**
+     *  @brief Get the Subscription Id. Next() must be called before accessing them.
+     *
+     *  @param [in] apSubscriptionId    A pointer to apSubscriptionId
+     *
+     *  @return #CHIP_NO_ERROR on success
+     *          #CHIP_END_OF_TLV if there is no such element
+     */
+    CHIP_ERROR GetSubscriptionId(uint64_t * const apSubscriptionId) const;
+
+    /**
+     *  @brief Get the final sync interval in seconds. Next() must be called before accessing them.
+     *
+     *  @param [in] apFinalSyncIntervalSeconds    A pointer to apFinalSyncIntervalSeconds
+     *
+     *  @return #CHIP_NO_ERROR on success
+     *          #CHIP_END_OF_TLV if there is no such element
+     */
+    CHIP_ERROR GetFinalSyncIntervalSeconds(uint16_t * const apFinalSyncIntervalSeconds) const;
+};
+
+class Builder : public chip::app::Builder
+{
+public:
+    /**
+     *  @brief Initialize a SubscribeResponse::Builder for writing into a TLV stream
+     *
+     *  @param [in] apWriter    A pointer to TLVWriter
+     *
+     *  @return #CHIP_NO_ERROR on success
+     */
+    CHIP_ERROR Init(chip::TLV::TLVWriter * const apWriter);
+
+    /**
+     *  @brief Inject the Subscription Id the publisher assigned to this subscription. Subsequent ReportData messages for
+     *  the subscription carry the same id.
+     *
+     *  @param [in] aSubscriptionId  Subscription Id for this subscription
+     *
+     *  @return A reference to *this
+     */
+    SubscribeResponse::Builder & SubscriptionId(const uint64_t aSubscriptionId);
+
+    /**
+     *  @brief Inject the maximum number of seconds the publisher lets pass between two reports for this subscription.
+     *
+     *  @param [in] aFinalSyncIntervalSeconds  The final sync interval in seconds
+     *
+     *  @return A reference to *this
+     */
+    SubscribeResponse::Builder & FinalSyncIntervalSeconds(const uint16_t aFinalSyncIntervalSeconds);
+
+    /**
+     *  @brief Mark the end of this SubscribeResponse
+     *
+     *  @return A reference to *this
+     */
+    SubscribeResponse::Builder & EndOfSubscribeResponse();
+};
+}; // namespace SubscribeResponse
+}; // namespace app
+}; // namespace chip
@@ -0,0 +1,268 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/PersistentEventStorage.h>
+#include <core/CHIPEventLoggingConfig.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// CRC-32 (IEEE 802.3), table driven.
+class Crc32Table
+{
+public:
+    constexpr Crc32Table() : mTable{}
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? ((crc >> 1) ^ 0xEDB88320) : (crc >> 1);
+            }
+            mTable[i] = crc;
+        }
+    }
+
+    uint32_t Update(uint32_t aCrc, const uint8_t * apData, size_t aLength) const
+    {
+        aCrc = ~aCrc;
+        for (size_t i = 0; i < aLength; i++)
+        {
+            aCrc = mTable[(aCrc ^ apData[i]) & 0xFF] ^ (aCrc >> 8);
+        }
+        return ~aCrc;
+    }
+
+private:
+    uint32_t mTable[256];
+};
+
+constexpr Crc32Table sCrc32Table;
+
+} // namespace
+
+CHIP_ERROR PersistentEventStorage::Open(const char * apPath, uint32_t aBufferSize)
+{
+    CHIP_ERROR err         = CHIP_NO_ERROR;
+    long pageSize          = sysconf(_SC_PAGESIZE);
+    size_t headerLength    = 0;
+    void * mapping         = MAP_FAILED;
+    const StateSlot * best = nullptr;
+
+    VerifyOrExit(mFd < 0, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(apPath != nullptr && aBufferSize > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The state slots take the first page, so that the storage of the buffer is page aligned.
+    headerLength = (pageSize > 0) ? static_cast<size_t>(pageSize) : 4096;
+    static_assert(sizeof(StateSlot) * kNumStateSlots <= 4096, "State slots must fit into a page");
+
+    mFd = open(apPath, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    VerifyOrExit(mFd >= 0, err = System::MapErrorPOSIX(errno));
+
+    mMappingLength = headerLength + aBufferSize;
+    VerifyOrExit(ftruncate(mFd, static_cast<off_t>(mMappingLength)) == 0, err = System::MapErrorPOSIX(errno));
+
+    mapping = mmap(nullptr, mMappingLength, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+    VerifyOrExit(mapping != MAP_FAILED, err = System::MapErrorPOSIX(errno));
+
+    mpMapping   = static_cast<uint8_t *>(mapping);
+    mpBuffer    = mpMapping + headerLength;
+    mBufferSize = aBufferSize;
+
+    // Resume from the most recently kept state that is intact, which is all of the recovery: at most two slots, and the
+    // events each of them refers to, are checked.
+    for (size_t i = 0; i < kNumStateSlots; i++)
+    {
+        const StateSlot * slot = GetSlot(i);
+        if ((best == nullptr || slot->mSequence > best->mSequence) && IsValidSlot(*slot))
+        {
+            best = slot;
+        }
+    }
+
+    mKeptState         = CircularEventBuffer::State();
+    mSequence          = 0;
+    mNextSlot          = 0;
+    mNumCommits        = 0;
+    mHasRecoveredState = (best != nullptr);
+    if (best != nullptr)
+    {
+        mKeptState = best->mState;
+        mSequence  = best->mSequence;
+        mNextSlot  = (best == GetSlot(0)) ? 1 : 0;
+    }
+    mCommittedState = mKeptState;
+
+    ChipLogProgress(EventLogging, "Opened event storage %s, %s %" PRIu32 " bytes of events", apPath,
+                    mHasRecoveredState ? "recovered" : "starting over with", mKeptState.mDataLength);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(EventLogging, "Failed to open event storage %s: %s", (apPath != nullptr) ? apPath : "", ErrorStr(err));
+        if (err != CHIP_ERROR_INCORRECT_STATE)
+        {
+            Close();
+        }
+    }
+    return err;
+}
+
+void PersistentEventStorage::Close()
+{
+    if (mpMapping != nullptr)
+    {
+        CHIP_ERROR err = Sync();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(EventLogging, "Failed to keep events: %s", ErrorStr(err));
+        }
+        munmap(mpMapping, mMappingLength);
+    }
+
+    if (mFd >= 0)
+    {
+        close(mFd);
+    }
+
+    mFd                = -1;
+    mpMapping          = nullptr;
+    mMappingLength     = 0;
+    mpBuffer           = nullptr;
+    mBufferSize        = 0;
+    mHasRecoveredState = false;
+}
+
+CHIP_ERROR PersistentEventStorage::Sync()
+{
+    VerifyOrReturnError(mpMapping != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mNumCommits > 0, CHIP_NO_ERROR);
+
+    return KeepState(mCommittedState);
+}
+
+CHIP_ERROR PersistentEventStorage::Restore(CircularEventBuffer & aBuffer)
+{
+    VerifyOrReturnError(mpMapping != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aBuffer.GetQueue() == mpBuffer && aBuffer.GetTotalDataLength() == mBufferSize,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (mHasRecoveredState)
+    {
+        aBuffer.RestoreState(mKeptState);
+    }
+    mCommittedState = aBuffer.GetState();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PersistentEventStorage::PrepareToWrite(const CircularEventBuffer & aBuffer, uint32_t aLength)
+{
+    uint32_t tail   = 0;
+    uint32_t offset = 0;
+
+    VerifyOrReturnError(mpMapping != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mKeptState.mDataLength > 0, CHIP_NO_ERROR);
+
+    // Where the write starts and ends, relative to the head of the kept events.
+    tail   = aBuffer.GetTailPosition();
+    offset = static_cast<uint32_t>((tail + mBufferSize - mKeptState.mHeadOffset) % mBufferSize);
+    VerifyOrReturnError(offset < mKeptState.mDataLength || offset + aLength > mBufferSize, CHIP_NO_ERROR);
+
+    // The write overwrites kept events, which the buffer has evicted by now; keep the events of the buffer as they are,
+    // so that the kept state no longer refers to them.
+    return KeepState(aBuffer.GetState());
+}
+
+CHIP_ERROR PersistentEventStorage::Commit(const CircularEventBuffer & aBuffer)
+{
+    VerifyOrReturnError(mpMapping != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mCommittedState = aBuffer.GetState();
+    mNumCommits++;
+    VerifyOrReturnError(mNumCommits >= CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL, CHIP_NO_ERROR);
+
+    return KeepState(mCommittedState);
+}
+
+CHIP_ERROR PersistentEventStorage::KeepState(const CircularEventBuffer::State & aState)
+{
+    StateSlot * slot = GetSlot(mNextSlot);
+
+    // The events go to disk before the state that refers to them, and the state to the older slot, so that the newer
+    // slot stays intact until the older one is.
+    VerifyOrReturnError(msync(mpBuffer, mBufferSize, MS_SYNC) == 0, System::MapErrorPOSIX(errno));
+
+    *slot               = StateSlot();
+    slot->mMagic        = kStateSlotMagic;
+    slot->mBufferSize   = mBufferSize;
+    slot->mSequence     = mSequence + 1;
+    slot->mState        = aState;
+    slot->mDataChecksum = DataChecksum(aState);
+    slot->mChecksum     = sCrc32Table.Update(0, reinterpret_cast<const uint8_t *>(slot), offsetof(StateSlot, mChecksum));
+
+    VerifyOrReturnError(msync(mpMapping, static_cast<size_t>(mpBuffer - mpMapping), MS_SYNC) == 0, System::MapErrorPOSIX(errno));
+
+    mSequence   = slot->mSequence;
+    mNextSlot   = (mNextSlot + 1) % kNumStateSlots;
+    mKeptState  = aState;
+    mNumCommits = 0;
+
+    return CHIP_NO_ERROR;
+}
+
+bool PersistentEventStorage::IsValidSlot(const StateSlot & aSlot) const
+{
+    VerifyOrReturnError(aSlot.mMagic == kStateSlotMagic && aSlot.mBufferSize == mBufferSize, false);
+    VerifyOrReturnError(aSlot.mChecksum ==
+                            sCrc32Table.Update(0, reinterpret_cast<const uint8_t *>(&aSlot), offsetof(StateSlot, mChecksum)),
+                        false);
+    VerifyOrReturnError(aSlot.mState.mHeadOffset < mBufferSize && aSlot.mState.mDataLength <= mBufferSize, false);
+    VerifyOrReturnError(aSlot.mState.mFirstEventNumber <= aSlot.mState.mLastEventNumber + 1, false);
+
+    return aSlot.mDataChecksum == DataChecksum(aSlot.mState);
+}
+
+uint32_t PersistentEventStorage::DataChecksum(const CircularEventBuffer::State & aState) const
+{
+    // The events may wrap around the end of the storage.
+    uint32_t firstLength = std::min(aState.mDataLength, mBufferSize - aState.mHeadOffset);
+    uint32_t crc         = sCrc32Table.Update(0, mpBuffer + aState.mHeadOffset, firstLength);
+
+    return sCrc32Table.Update(crc, mpBuffer, aState.mDataLength - firstLength);
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,145 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   A file backed storage for an event buffer, which keeps its events across restarts.
+ *
+ */
+#pragma once
+
+#include <app/EventManagement.h>
+#include <core/CHIPError.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * @brief
+ *   Storage for a CircularEventBuffer mapped from a file, which keeps the events of the buffer across restarts.
+ *
+ * The file holds the storage of the buffer, preceded by two slots for the state of the buffer, see
+ * CircularEventBuffer::State. Each slot is checksummed, as are the events the state it holds makes up. Keeping the
+ * events of the buffer writes its state to the older slot, once both the storage and that state are on disk; so a
+ * crash at any point leaves at least one slot whose events are intact, and opening the file checks no more than the
+ * two slots and the events they refer to.
+ *
+ * The events are kept every CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL commits, when Sync() is called, and before
+ * events still kept would be overwritten. Events logged since they were last kept are lost on a crash.
+ *
+ * Only the events in this buffer are kept. Every event is logged to the first buffer of the chain, and only reaches the
+ * buffer of its priority once the buffers in front have evicted it. So a critical event still in a debug or info buffer
+ * in memory is not persisted, and is lost on a crash or a restart; its number is not handed out again. Give those
+ * buffers a storage of their own to keep their events too. Each storage is kept on its own, so a crash may still lose
+ * an event moving between two buffers.
+ *
+ * Usage:
+ *
+ * @code
+ *   PersistentEventStorage storage;
+ *   err = storage.Open("/var/lib/chip/critical-events", 4096);
+ *   LogStorageResources resources[] = {
+ *       { storage.GetBuffer(), storage.GetBufferSize(), nullptr, 0, nullptr, PriorityLevel::Critical, &storage },
+ *   };
+ * @endcode
+ */
+class PersistentEventStorage : public EventPersistenceDelegate
+{
+public:
+    PersistentEventStorage() {}
+    ~PersistentEventStorage() override { Close(); }
+
+    /**
+     * @brief
+     *   Open the file, creating it if need be, and recover the events kept in it.
+     *
+     * A file that was kept with a different buffer size, or whose state slots and events fail their checksums, starts
+     * out empty.
+     *
+     * @param[in] apPath       The path of the file.
+     * @param[in] aBufferSize  The size of the buffer in bytes.
+     *
+     * @retval #CHIP_ERROR_INCORRECT_STATE  The storage is already open.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT The buffer size is 0.
+     * @retval other                        The file could not be opened or mapped.
+     */
+    CHIP_ERROR Open(const char * apPath, uint32_t aBufferSize);
+
+    /**
+     * @brief
+     *   Keep the events committed last, and close the file.
+     */
+    void Close();
+
+    /**
+     * @brief
+     *   Keep the events committed last, if they are not kept yet.
+     */
+    CHIP_ERROR Sync();
+
+    /**
+     * @brief
+     *   The storage for the buffer, to be given as LogStorageResources::mpBuffer.
+     */
+    uint8_t * GetBuffer() const { return mpBuffer; }
+    uint32_t GetBufferSize() const { return mBufferSize; }
+
+    // EventPersistenceDelegate overrides:
+    CHIP_ERROR Restore(CircularEventBuffer & aBuffer) override;
+    CHIP_ERROR PrepareToWrite(const CircularEventBuffer & aBuffer, uint32_t aLength) override;
+    CHIP_ERROR Commit(const CircularEventBuffer & aBuffer) override;
+
+private:
+    struct StateSlot
+    {
+        uint32_t mMagic;
+        uint32_t mBufferSize;
+        uint64_t mSequence;
+        CircularEventBuffer::State mState;
+        uint32_t mDataChecksum;
+        uint32_t mChecksum;
+    };
+
+    static constexpr uint32_t kStateSlotMagic = 0x43455631; // 'CEV1'
+    static constexpr size_t kNumStateSlots    = 2;
+
+    CHIP_ERROR KeepState(const CircularEventBuffer::State & aState);
+    bool IsValidSlot(const StateSlot & aSlot) const;
+    uint32_t DataChecksum(const CircularEventBuffer::State & aState) const;
+    StateSlot * GetSlot(size_t aIndex) const { return reinterpret_cast<StateSlot *>(mpMapping) + aIndex; }
+
+    int mFd                 = -1;
+    uint8_t * mpMapping     = nullptr;
+    size_t mMappingLength   = 0;
+    uint8_t * mpBuffer      = nullptr;
+    uint32_t mBufferSize    = 0;
+    uint64_t mSequence      = 0;     ///< The sequence number of the slot holding the kept state
+    size_t mNextSlot        = 0;     ///< The slot the state is kept in next
+    uint32_t mNumCommits    = 0;     ///< The number of commits since the state was last kept
+    bool mHasRecoveredState = false; ///< Whether Open() found a kept state, which Restore() resumes the buffer from
+    CircularEventBuffer::State mKeptState;      ///< The state whose events are on disk
+    CircularEventBuffer::State mCommittedState; ///< The state committed last
+};
+
+} // namespace app
+} // namespace chip
@@ -23,6 +23,8 @@
  */
 
 #include <app/InteractionModelEngine.h>
+#include <app/MessageDef/StatusElement.h>
+#include <app/MessageDef/SubscribeResponse.h>
 #include <app/ReadClient.h>
 
 namespace chip {
@@ -49,9 +51,12 @@ exit:
 void ReadClient::Shutdown()
 {
     AbortExistingExchangeContext();
-    mpExchangeMgr = nullptr;
-    mpDelegate    = nullptr;
+    mpExchangeMgr   = nullptr;
+    mpDelegate      = nullptr;
+    mIsSubscription = false;
+    mSubscriptionId = 0;
     MoveToState(ClientState::Uninitialized);
+    InteractionModelEngine::GetInstance()->ReleaseReadClient(this);
 }
 
 const char * ReadClient::GetStateStr() const
@@ -65,6 +70,10 @@ const char * ReadClient::GetStateStr() const
         return "INIT";
     case ClientState::AwaitingResponse:
         return "AwaitingResponse";
+    case ClientState::AwaitingSubscribeResponse:
+        return "AwaitingSubscribeResponse";
+    case ClientState::SubscriptionActive:
+        return "SubscriptionActive";
     }
 #endif // CHIP_DETAIL_LOGGING
     return "N/A";
@@ -107,21 +116,8 @@ CHIP_ERROR ReadClient::SendReadRequest(NodeId aNodeId, Transport::AdminId aAdmin
 
         if (aEventPathParamsListSize != 0 && apEventPathParamsList != nullptr)
         {
-            EventPathList::Builder & eventPathListBuilder = request.CreateEventPathListBuilder();
-            EventPath::Builder eventPathBuilder           = eventPathListBuilder.CreateEventPathBuilder();
-            for (size_t eventIndex = 0; eventIndex < aEventPathParamsListSize; ++eventIndex)
-            {
-                EventPathParams eventPath = apEventPathParamsList[eventIndex];
-                eventPathBuilder.NodeId(eventPath.mNodeId)
-                    .EventId(eventPath.mEventId)
-                    .EndpointId(eventPath.mEndpointId)
-                    .ClusterId(eventPath.mClusterId)
-                    .EndOfEventPath();
-                SuccessOrExit(err = eventPathBuilder.GetError());
-            }
-
-            eventPathListBuilder.EndOfEventPathList();
-            SuccessOrExit(err = eventPathListBuilder.GetError());
+            err = GenerateEventPathList(request.CreateEventPathListBuilder(), apEventPathParamsList, aEventPathParamsListSize);
+            SuccessOrExit(err);
 
             if (aEventNumber != 0)
             {
@@ -132,32 +128,9 @@ CHIP_ERROR ReadClient::SendReadRequest(NodeId aNodeId, Transport::AdminId aAdmin
 
         if (aAttributePathParamsListSize != 0 && apAttributePathParamsList != nullptr)
         {
-            AttributePathList::Builder attributePathListBuilder = request.CreateAttributePathListBuilder();
-            SuccessOrExit(err = attributePathListBuilder.GetError());
-            for (size_t index = 0; index < aAttributePathParamsListSize; index++)
-            {
-                AttributePath::Builder attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
-                attributePathBuilder.NodeId(apAttributePathParamsList[index].mNodeId)
-                    .EndpointId(apAttributePathParamsList[index].mEndpointId)
-                    .ClusterId(apAttributePathParamsList[index].mClusterId);
-                if (apAttributePathParamsList[index].mFlags == AttributePathFlags::kFieldIdValid)
-                {
-                    attributePathBuilder.FieldId(apAttributePathParamsList[index].mFieldId);
-                }
-                else if (apAttributePathParamsList[index].mFlags == AttributePathFlags::kListIndexValid)
-                {
-                    attributePathBuilder.ListIndex(apAttributePathParamsList[index].mListIndex);
-                }
-                else
-                {
-                    err = CHIP_ERROR_INVALID_ARGUMENT;
-                    ExitNow();
-                }
-                attributePathBuilder.EndOfAttributePath();
-                SuccessOrExit(err = attributePathBuilder.GetError());
-            }
-            attributePathListBuilder.EndOfAttributePathList();
-            SuccessOrExit(err = attributePathListBuilder.GetError());
+            err = GenerateAttributePathList(request.CreateAttributePathListBuilder(), apAttributePathParamsList,
+                                            aAttributePathParamsListSize);
+            SuccessOrExit(err);
         }
 
         request.EndOfReadRequest();
@@ -167,13 +140,71 @@ CHIP_ERROR ReadClient::SendReadRequest(NodeId aNodeId, Transport::AdminId aAdmin
         SuccessOrExit(err);
     }
 
-    mpExchangeCtx = mpExchangeMgr->NewContext({ aNodeId, 0, aAdminId }, this);
-    VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_NO_MEMORY);
-    mpExchangeCtx->SetResponseTimeout(kImMessageTimeoutMsec);
+    err = SendRequest(aNodeId, aAdminId, Protocols::InteractionModel::MsgType::ReadRequest, std::move(msgBuf));
+    SuccessOrExit(err);
+    MoveToState(ClientState::AwaitingResponse);
+
+exit:
+    ChipLogFunctError(err);
+
+    if (err != CHIP_NO_ERROR)
+    {
+        AbortExistingExchangeContext();
+    }
+
+    return err;
+}
+
+CHIP_ERROR ReadClient::SendSubscribeRequest(NodeId aNodeId, Transport::AdminId aAdminId, EventPathParams * apEventPathParamsList,
+                                            size_t aEventPathParamsListSize, AttributePathParams * apAttributePathParamsList,
+                                            size_t aAttributePathParamsListSize, uint16_t aMinIntervalFloorSeconds,
+                                            uint16_t aMaxIntervalCeilingSeconds)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferHandle msgBuf;
+    ChipLogDetail(DataManagement, "%s: Client[%u] [%5.5s]", __func__,
+                  InteractionModelEngine::GetInstance()->GetReadClientArrayIndex(this), GetStateStr());
+    VerifyOrExit(ClientState::Initialized == mState, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mpDelegate != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(aMinIntervalFloorSeconds <= aMaxIntervalCeilingSeconds, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    AbortExistingExchangeContext();
+
+    {
+        System::PacketBufferTLVWriter writer;
+        SubscribeRequest::Builder request;
+
+        msgBuf = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+        VerifyOrExit(!msgBuf.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+
+        writer.Init(std::move(msgBuf));
+
+        err = request.Init(&writer);
+        SuccessOrExit(err);
+
+        if (aEventPathParamsListSize != 0 && apEventPathParamsList != nullptr)
+        {
+            err = GenerateEventPathList(request.CreateEventPathListBuilder(), apEventPathParamsList, aEventPathParamsListSize);
+            SuccessOrExit(err);
+        }
+
+        if (aAttributePathParamsListSize != 0 && apAttributePathParamsList != nullptr)
+        {
+            err = GenerateAttributePathList(request.CreateAttributePathListBuilder(), apAttributePathParamsList,
+                                            aAttributePathParamsListSize);
+            SuccessOrExit(err);
+        }
+
+        request.MinIntervalSeconds(aMinIntervalFloorSeconds).MaxIntervalSeconds(aMaxIntervalCeilingSeconds).EndOfSubscribeRequest();
+        SuccessOrExit(err = request.GetError());
 
-    err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::ReadRequest, std::move(msgBuf),
-                                     Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+        err = writer.Finalize(&msgBuf);
+        SuccessOrExit(err);
+    }
+
+    err = SendRequest(aNodeId, aAdminId, Protocols::InteractionModel::MsgType::SubscribeRequest, std::move(msgBuf));
     SuccessOrExit(err);
+    mIsSubscription = true;
     MoveToState(ClientState::AwaitingResponse);
 
 exit:
@@ -187,15 +218,125 @@ exit:
     return err;
 }
 
+CHIP_ERROR ReadClient::GenerateEventPathList(EventPathList::Builder & aEventPathListBuilder,
+                                             EventPathParams * apEventPathParamsList, size_t aEventPathParamsListSize)
+{
+    CHIP_ERROR err                      = CHIP_NO_ERROR;
+    EventPath::Builder eventPathBuilder = aEventPathListBuilder.CreateEventPathBuilder();
+
+    for (size_t eventIndex = 0; eventIndex < aEventPathParamsListSize; ++eventIndex)
+    {
+        EventPathParams eventPath = apEventPathParamsList[eventIndex];
+        eventPathBuilder.NodeId(eventPath.mNodeId)
+            .EventId(eventPath.mEventId)
+            .EndpointId(eventPath.mEndpointId)
+            .ClusterId(eventPath.mClusterId)
+            .EndOfEventPath();
+        SuccessOrExit(err = eventPathBuilder.GetError());
+    }
+
+    aEventPathListBuilder.EndOfEventPathList();
+    SuccessOrExit(err = aEventPathListBuilder.GetError());
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR ReadClient::GenerateAttributePathList(AttributePathList::Builder & aAttributePathListBuilder,
+                                                 AttributePathParams * apAttributePathParamsList,
+                                                 size_t aAttributePathParamsListSize)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SuccessOrExit(err = aAttributePathListBuilder.GetError());
+    for (size_t index = 0; index < aAttributePathParamsListSize; index++)
+    {
+        const AttributePathParams & params = apAttributePathParamsList[index];
+        AttributePath::Builder attributePathBuilder;
+        if (params.mFlags == AttributePathFlags::kFieldIdValid)
+        {
+            attributePathBuilder = aAttributePathListBuilder.EncodeAttributePath(params.mNodeId, params.mEndpointId,
+                                                                                 params.mClusterId, params.mFieldId);
+        }
+        else if (params.mFlags == AttributePathFlags::kListIndexValid)
+        {
+            attributePathBuilder = aAttributePathListBuilder.CreateAttributePathBuilder();
+            attributePathBuilder.NodeId(params.mNodeId)
+                .EndpointId(params.mEndpointId)
+                .ClusterId(params.mClusterId)
+                .ListIndex(params.mListIndex)
+                .EndOfAttributePath();
+        }
+        else
+        {
+            err = CHIP_ERROR_INVALID_ARGUMENT;
+            ExitNow();
+        }
+        SuccessOrExit(err = attributePathBuilder.GetError());
+    }
+    aAttributePathListBuilder.EndOfAttributePathList();
+    SuccessOrExit(err = aAttributePathListBuilder.GetError());
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR ReadClient::SendRequest(NodeId aNodeId, Transport::AdminId aAdminId, Protocols::InteractionModel::MsgType aMsgType,
+                                   System::PacketBufferHandle && aPayload)
+{
+    mpExchangeCtx = mpExchangeMgr->NewContext({ aNodeId, 0, aAdminId }, this);
+    VerifyOrReturnError(mpExchangeCtx != nullptr, CHIP_ERROR_NO_MEMORY);
+    mpExchangeCtx->SetResponseTimeout(kImMessageTimeoutMsec);
+
+    return mpExchangeCtx->SendMessage(aMsgType, std::move(aPayload),
+                                      Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+}
+
 void ReadClient::OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
                                    const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload)
 {
-    CHIP_ERROR err = CHIP_NO_ERROR;
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    bool moreChunkedMessages = false;
 
     VerifyOrExit(apExchangeContext == mpExchangeCtx, err = CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrExit(aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::ReportData),
-                 err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
-    err = ProcessReportData(std::move(aPayload));
+    if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::ReportData) && IsSubscriptionActive())
+    {
+        // A further chunk of a report the publisher started on an exchange of its own
+        OnUnsolicitedReportData(apExchangeContext, std::move(aPayload));
+        return;
+    }
+    else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::ReportData))
+    {
+        err = ProcessReportData(std::move(aPayload), moreChunkedMessages);
+        if (err == CHIP_NO_ERROR && moreChunkedMessages)
+        {
+            // Ask for the next chunk, which comes on the same exchange.
+            err = SendStatusResponse();
+            SuccessOrExit(err);
+            return;
+        }
+        if (err == CHIP_NO_ERROR && mIsSubscription)
+        {
+            // The publisher follows the reports answering a subscribe request with a subscribe response on the same exchange.
+            MoveToState(ClientState::AwaitingSubscribeResponse);
+            if (mpDelegate != nullptr)
+            {
+                mpDelegate->ReportProcessed(this);
+            }
+            return;
+        }
+    }
+    else if (aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::SubscribeResponse) &&
+             mState == ClientState::AwaitingSubscribeResponse)
+    {
+        err = ProcessSubscribeResponse(std::move(aPayload));
+    }
+    else
+    {
+        err = CHIP_ERROR_INVALID_MESSAGE_TYPE;
+    }
 
 exit:
     ChipLogFunctError(err);
@@ -203,6 +344,18 @@ exit:
     // Close the exchange cleanly so that the ExchangeManager will send an ack for the message we just received.
     mpExchangeCtx->Close();
     mpExchangeCtx = nullptr;
+
+    if (err == CHIP_NO_ERROR && mState == ClientState::AwaitingSubscribeResponse)
+    {
+        MoveToState(ClientState::SubscriptionActive);
+        if (mpDelegate != nullptr)
+        {
+            mpDelegate->SubscribeResponseProcessed(this);
+        }
+        return;
+    }
+
+    mIsSubscription = false;
     MoveToState(ClientState::Initialized);
 
     if (mpDelegate != nullptr)
@@ -220,6 +373,71 @@ exit:
     return;
 }
 
+void ReadClient::OnUnsolicitedReportData(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    bool moreChunkedMessages = false;
+
+    mpExchangeCtx = apExchangeContext;
+    err           = ProcessReportData(std::move(aPayload), moreChunkedMessages);
+    if (err == CHIP_NO_ERROR && moreChunkedMessages)
+    {
+        // Ask for the next chunk, which comes on the same exchange.
+        mpExchangeCtx->SetDelegate(this);
+        err = SendStatusResponse();
+        if (err == CHIP_NO_ERROR)
+        {
+            return;
+        }
+    }
+    ChipLogFunctError(err);
+
+    // Close the exchange cleanly so that the ExchangeManager will send an ack for the report we just received.
+    if (mpExchangeCtx != nullptr)
+    {
+        mpExchangeCtx->Close();
+        mpExchangeCtx = nullptr;
+    }
+
+    if (mpDelegate != nullptr)
+    {
+        if (err != CHIP_NO_ERROR)
+        {
+            mpDelegate->ReportError(this, err);
+        }
+        else
+        {
+            mpDelegate->ReportProcessed(this);
+        }
+    }
+}
+
+CHIP_ERROR ReadClient::ProcessSubscribeResponse(System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+    SubscribeResponse::Parser subscribeResponse;
+
+    reader.Init(std::move(aPayload));
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = subscribeResponse.Init(reader);
+    SuccessOrExit(err);
+
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = subscribeResponse.CheckSchemaValidity();
+    SuccessOrExit(err);
+#endif
+
+    err = subscribeResponse.GetSubscriptionId(&mSubscriptionId);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
 CHIP_ERROR ReadClient::AbortExistingExchangeContext()
 {
     if (mpExchangeCtx != nullptr)
@@ -231,7 +449,26 @@ CHIP_ERROR ReadClient::AbortExistingExchangeContext()
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
+CHIP_ERROR ReadClient::SendStatusResponse()
+{
+    System::PacketBufferTLVWriter writer;
+    StatusElement::Builder statusElementBuilder;
+    System::PacketBufferHandle msgBuf = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+
+    VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    writer.Init(std::move(msgBuf));
+    ReturnErrorOnFailure(statusElementBuilder.Encode(&writer, Protocols::SecureChannel::GeneralStatusCode::kSuccess,
+                                                     Protocols::InteractionModel::Id.ToFullyQualifiedSpecForm(),
+                                                     Protocols::SecureChannel::kProtocolCodeSuccess));
+    ReturnErrorOnFailure(writer.Finalize(&msgBuf));
+
+    mpExchangeCtx->SetResponseTimeout(kImMessageTimeoutMsec);
+    return mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::StatusResponse, std::move(msgBuf),
+                                      Messaging::SendFlags(Messaging::SendMessageFlags::kExpectResponse));
+}
+
+CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload, bool & aMoreChunkedMessages)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
     ReportData::Parser report;
@@ -239,7 +476,6 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
     bool isEventListPresent         = false;
     bool isAttributeDataListPresent = false;
     bool suppressResponse           = false;
-    bool moreChunkedMessages        = false;
     EventList::Parser eventList;
     AttributeDataList::Parser attributeDataList;
     System::PacketBufferTLVReader reader;
@@ -262,7 +498,8 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
     }
     SuccessOrExit(err);
 
-    err = report.GetMoreChunkedMessages(&moreChunkedMessages);
+    aMoreChunkedMessages = false;
+    err                  = report.GetMoreChunkedMessages(&aMoreChunkedMessages);
     if (CHIP_END_OF_TLV == err)
     {
         err = CHIP_NO_ERROR;
@@ -292,7 +529,7 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
         err = CHIP_NO_ERROR;
     }
     SuccessOrExit(err);
-    if (isAttributeDataListPresent && nullptr != mpDelegate && !moreChunkedMessages)
+    if (isAttributeDataListPresent && nullptr != mpDelegate)
     {
         chip::TLV::TLVReader attributeDataListReader;
         attributeDataList.GetReader(&attributeDataListReader);
@@ -300,12 +537,6 @@ CHIP_ERROR ReadClient::ProcessReportData(System::PacketBufferHandle && aPayload)
         SuccessOrExit(err);
     }
 
-    if (!suppressResponse)
-    {
-        // TODO: Add status report support and correspond handler in ReadHandler, particular for situation when there
-        // are multiple reports
-    }
-
 exit:
     ChipLogFunctError(err);
     return err;
@@ -316,7 +547,12 @@ void ReadClient::OnResponseTimeout(Messaging::ExchangeContext * apExchangeContex
     ChipLogProgress(DataManagement, "Time out! failed to receive report data from Exchange: %d",
                     apExchangeContext->GetExchangeId());
     AbortExistingExchangeContext();
-    MoveToState(ClientState::Initialized);
+    // A chunk of a report lost on its way does not end the subscription.
+    if (!IsSubscriptionActive())
+    {
+        mIsSubscription = false;
+        MoveToState(ClientState::Initialized);
+    }
     if (nullptr != mpDelegate)
     {
         mpDelegate->ReportError(this, CHIP_ERROR_TIMEOUT);
@@ -28,6 +28,7 @@
 #include <app/EventPathParams.h>
 #include <app/InteractionModelDelegate.h>
 #include <app/MessageDef/ReadRequest.h>
+#include <app/MessageDef/SubscribeRequest.h>
 #include <core/CHIPCore.h>
 #include <core/CHIPTLVDebug.hpp>
 #include <messaging/ExchangeContext.h>
@@ -47,13 +48,17 @@ namespace app {
  *  @brief The read client represents the initiator side of a Read Interaction, and is responsible
  *  for generating one Read Request for a particular set of attributes and/or events, and handling the Report Data response.
  *
+ *  It likewise represents the initiator side of a Subscribe Interaction, in which case it keeps handling the Report Data
+ *  the publisher sends for the subscription until it is shut down.
+ *
  */
 class ReadClient : public Messaging::ExchangeDelegate
 {
 public:
     /**
      *  Shut down the Client. This terminates this instance of the object and releases
-     *  all held resources.  The object must not be used after Shutdown() is called.
+     *  all held resources, returning the client to the InteractionModelEngine.  The object
+     *  must not be used after Shutdown() is called.
      *
      *  SDK consumer can choose when to shut down the ReadClient.
      *  The ReadClient will never shut itself down, unless the overall InteractionModelEngine is shut down.
@@ -73,15 +78,39 @@ public:
                                size_t aEventPathParamsListSize, AttributePathParams * apAttributePathParamsList,
                                size_t aAttributePathParamsListSize, EventNumber aEventNumber);
 
+    /**
+     *  Send a Subscribe Request.  The publisher answers with Report Data for the whole interest set, followed by a
+     *  Subscribe Response, each notified through the InteractionModelDelegate.  From then on, until the ReadClient is shut
+     *  down, every Report Data the publisher sends for the subscription is notified through
+     *  InteractionModelDelegate::ReportProcessed or InteractionModelDelegate::ReportError.
+     *
+     *  @param[in]    aMinIntervalFloorSeconds      The publisher sends no two reports less than this apart.
+     *  @param[in]    aMaxIntervalCeilingSeconds    The publisher sends a report at least this often, even if nothing changed.
+     *
+     *  @retval #others fail to send subscribe request
+     *  @retval #CHIP_NO_ERROR On success.
+     */
+    CHIP_ERROR SendSubscribeRequest(NodeId aNodeId, Transport::AdminId aAdminId, EventPathParams * apEventPathParamsList,
+                                    size_t aEventPathParamsListSize, AttributePathParams * apAttributePathParamsList,
+                                    size_t aAttributePathParamsListSize, uint16_t aMinIntervalFloorSeconds,
+                                    uint16_t aMaxIntervalCeilingSeconds);
+
+    bool IsSubscriptionActive() const { return mState == ClientState::SubscriptionActive; }
+    uint64_t GetSubscriptionId() const { return mSubscriptionId; }
+
+    virtual ~ReadClient() = default;
+
 private:
     friend class TestReadInteraction;
     friend class InteractionModelEngine;
 
     enum class ClientState
     {
-        Uninitialized = 0, ///< The client has not been initialized
-        Initialized,       ///< The client has been initialized and is ready for a SendReadRequest
-        AwaitingResponse,  ///< The client has sent out the read request message
+        Uninitialized = 0,         ///< The client has not been initialized
+        Initialized,               ///< The client has been initialized and is ready for a SendReadRequest
+        AwaitingResponse,          ///< The client has sent out the read request message
+        AwaitingSubscribeResponse, ///< The client has received the reports answering its subscribe request
+        SubscriptionActive,        ///< The client has received the subscribe response and waits for further reports
     };
 
     /**
@@ -99,8 +128,6 @@ private:
      */
     CHIP_ERROR Init(Messaging::ExchangeManager * apExchangeMgr, InteractionModelDelegate * apDelegate);
 
-    virtual ~ReadClient() = default;
-
     void OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
                            const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload) override;
     void OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext) override;
@@ -111,10 +138,24 @@ private:
      */
     bool IsFree() const { return mState == ClientState::Uninitialized; };
 
+    /**
+     *  Process Report Data the publisher sent on an exchange of its own for the active subscription of this client.
+     *
+     */
+    void OnUnsolicitedReportData(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
+
     CHIP_ERROR ProcessAttributeDataList(TLV::TLVReader & aAttributeDataListReader);
+    CHIP_ERROR GenerateEventPathList(EventPathList::Builder & aEventPathListBuilder, EventPathParams * apEventPathParamsList,
+                                     size_t aEventPathParamsListSize);
+    CHIP_ERROR GenerateAttributePathList(AttributePathList::Builder & aAttributePathListBuilder,
+                                         AttributePathParams * apAttributePathParamsList, size_t aAttributePathParamsListSize);
+    CHIP_ERROR SendRequest(NodeId aNodeId, Transport::AdminId aAdminId, Protocols::InteractionModel::MsgType aMsgType,
+                           System::PacketBufferHandle && aPayload);
 
     void MoveToState(const ClientState aTargetState);
-    CHIP_ERROR ProcessReportData(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR ProcessReportData(System::PacketBufferHandle && aPayload, bool & aMoreChunkedMessages);
+    CHIP_ERROR SendStatusResponse();
+    CHIP_ERROR ProcessSubscribeResponse(System::PacketBufferHandle && aPayload);
     CHIP_ERROR AbortExistingExchangeContext();
     const char * GetStateStr() const;
 
@@ -122,6 +163,8 @@ private:
     Messaging::ExchangeContext * mpExchangeCtx = nullptr;
     InteractionModelDelegate * mpDelegate      = nullptr;
     ClientState mState                         = ClientState::Uninitialized;
+    bool mIsSubscription                       = false;
+    uint64_t mSubscriptionId                   = 0;
 };
 
 }; // namespace app
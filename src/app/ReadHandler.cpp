@@ -24,11 +24,24 @@
 
 #include <app/InteractionModelEngine.h>
 #include <app/MessageDef/EventPath.h>
+#include <app/MessageDef/StatusElement.h>
+#include <app/MessageDef/SubscribeRequest.h>
+#include <app/MessageDef/SubscribeResponse.h>
 #include <app/ReadHandler.h>
 #include <app/reporting/Engine.h>
+#include <support/RandUtils.h>
+#include <support/TimeUtils.h>
 
 namespace chip {
 namespace app {
+namespace {
+System::Layer * GetSystemLayer()
+{
+    Messaging::ExchangeManager * exchangeManager = InteractionModelEngine::GetInstance()->GetExchangeManager();
+    return (exchangeManager != nullptr) ? exchangeManager->GetSessionMgr()->SystemLayer() : nullptr;
+}
+} // namespace
+
 CHIP_ERROR ReadHandler::Init(InteractionModelDelegate * apDelegate)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -40,7 +53,16 @@ CHIP_ERROR ReadHandler::Init(InteractionModelDelegate * apDelegate)
     mSuppressResponse          = true;
     mpAttributeClusterInfoList = nullptr;
     mpEventClusterInfoList     = nullptr;
+    mpDirtyClusterInfoList     = nullptr;
     mCurrentPriority           = PriorityLevel::Invalid;
+    mInteractionType           = InteractionType::Read;
+    mSessionHandle             = SecureSessionHandle();
+    mSubscriptionId            = 0;
+    mMinIntervalFloorSeconds   = 0;
+    mMaxIntervalCeilingSeconds = 0;
+    mIsPrimingReports          = false;
+    mHoldReport                = false;
+    mDirty                     = false;
     MoveToState(HandlerState::Initialized);
 
 exit:
@@ -50,14 +72,32 @@ exit:
 
 void ReadHandler::Shutdown()
 {
+    System::Layer * systemLayer = GetSystemLayer();
+    const bool chunkInFlight    = (mState == HandlerState::AwaitingReportResponse);
+    if (IsSubscriptionType() && systemLayer != nullptr)
+    {
+        systemLayer->CancelTimer(OnMinIntervalTimerExpired, this);
+        systemLayer->CancelTimer(OnMaxIntervalTimerExpired, this);
+    }
     InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpAttributeClusterInfoList);
     InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpEventClusterInfoList);
+    InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpDirtyClusterInfoList);
     AbortExistingExchangeContext();
     MoveToState(HandlerState::Uninitialized);
     mpDelegate                 = nullptr;
     mpAttributeClusterInfoList = nullptr;
     mpEventClusterInfoList     = nullptr;
+    mpDirtyClusterInfoList     = nullptr;
     mCurrentPriority           = PriorityLevel::Invalid;
+    mInteractionType           = InteractionType::Read;
+    InteractionModelEngine::GetInstance()->ReleaseReadHandler(this);
+
+    if (chunkInFlight)
+    {
+        // The unacknowledged chunk no longer holds the reporting engine back, let the other readers have it.
+        InteractionModelEngine::GetInstance()->GetReportingEngine().OnReportConfirm();
+        InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+    }
 }
 
 CHIP_ERROR ReadHandler::AbortExistingExchangeContext()
@@ -90,18 +130,272 @@ exit:
     return err;
 }
 
-CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload)
+CHIP_ERROR ReadHandler::OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+
+    mpExchangeCtx    = apExchangeContext;
+    mInteractionType = InteractionType::Subscribe;
+    if (mpExchangeCtx != nullptr)
+    {
+        mSessionHandle = mpExchangeCtx->GetSecureSession();
+    }
+
+    err = ProcessSubscribeRequest(std::move(aPayload));
+    SuccessOrExit(err);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogFunctError(err);
+        Shutdown();
+    }
+
+    return err;
+}
+
+CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, bool aMoreChunkedMessages)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    Messaging::SendFlags sendFlags(Messaging::SendMessageFlags::kNone);
+
+    if (IsSubscriptionType() && !mIsPrimingReports && mpExchangeCtx == nullptr)
+    {
+        // The subscribe request exchange is gone, every later report opens an exchange of its own.
+        Messaging::ExchangeManager * exchangeManager = InteractionModelEngine::GetInstance()->GetExchangeManager();
+        VerifyOrExit(exchangeManager != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+        mpExchangeCtx = exchangeManager->NewContext(mSessionHandle, nullptr);
+        VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_NO_MEMORY);
+    }
     VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
-    err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::ReportData, std::move(aPayload));
+    if (aMoreChunkedMessages)
+    {
+        // The status response acknowledging this chunk comes back to this handler.
+        mpExchangeCtx->SetDelegate(this);
+        mpExchangeCtx->SetResponseTimeout(kImMessageTimeoutMsec);
+        sendFlags.Set(Messaging::SendMessageFlags::kExpectResponse);
+    }
+
+    err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::ReportData, std::move(aPayload), sendFlags);
+    SuccessOrExit(err);
+
+    if (aMoreChunkedMessages)
+    {
+        MoveToState(HandlerState::AwaitingReportResponse);
+    }
+    else if (IsSubscriptionType())
+    {
+        if (mIsPrimingReports)
+        {
+            err = SendSubscribeResponse();
+            SuccessOrExit(err);
+            mIsPrimingReports = false;
+        }
+
+        mpExchangeCtx->Close();
+        mpExchangeCtx = nullptr;
+        mDirty        = false;
+
+        err = RefreshSubscribeSyncTimer();
+        SuccessOrExit(err);
+        MoveToState(HandlerState::Subscribed);
+    }
+
 exit:
     ChipLogFunctError(err);
-    Shutdown();
+    if (err != CHIP_NO_ERROR || (!IsSubscriptionType() && !aMoreChunkedMessages))
+    {
+        Shutdown();
+    }
     return err;
 }
 
+void ReadHandler::OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                                    const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(apExchangeContext == mpExchangeCtx && mState == HandlerState::AwaitingReportResponse,
+                 err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(aPayloadHeader.HasMessageType(Protocols::InteractionModel::MsgType::StatusResponse),
+                 err = CHIP_ERROR_INVALID_MESSAGE_TYPE);
+
+    err = ProcessStatusResponse(std::move(aPayload));
+    SuccessOrExit(err);
+
+    // The reader has taken the previous chunk, encode the next one.
+    InteractionModelEngine::GetInstance()->GetReportingEngine().OnReportConfirm();
+    MoveToState(HandlerState::Reportable);
+    err = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogFunctError(err);
+        Shutdown();
+    }
+}
+
+void ReadHandler::OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext)
+{
+    ChipLogProgress(DataManagement, "Time out! failed to receive status response from Exchange: %d",
+                    apExchangeContext->GetExchangeId());
+    Shutdown();
+}
+
+CHIP_ERROR ReadHandler::ProcessStatusResponse(System::PacketBufferHandle && aPayload)
+{
+    System::PacketBufferTLVReader reader;
+    StatusElement::Parser statusElementParser;
+    Protocols::SecureChannel::GeneralStatusCode generalCode = Protocols::SecureChannel::GeneralStatusCode::kSuccess;
+    uint32_t protocolId                                     = 0;
+    uint16_t protocolCode                                   = 0;
+
+    reader.Init(std::move(aPayload));
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(statusElementParser.Init(reader));
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    ReturnErrorOnFailure(statusElementParser.CheckSchemaValidity());
+#endif
+    ReturnErrorOnFailure(statusElementParser.DecodeStatusElement(&generalCode, &protocolId, &protocolCode));
+    VerifyOrReturnError(generalCode == Protocols::SecureChannel::GeneralStatusCode::kSuccess, CHIP_ERROR_STATUS_REPORT_RECEIVED);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadHandler::SendSubscribeResponse()
+{
+    System::PacketBufferTLVWriter writer;
+    SubscribeResponse::Builder response;
+    System::PacketBufferHandle msgBuf = System::PacketBufferHandle::New(kMaxSecureSduLengthBytes);
+
+    VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    writer.Init(std::move(msgBuf));
+    ReturnErrorOnFailure(response.Init(&writer));
+    response.SubscriptionId(mSubscriptionId).FinalSyncIntervalSeconds(mMaxIntervalCeilingSeconds).EndOfSubscribeResponse();
+    ReturnErrorOnFailure(response.GetError());
+    ReturnErrorOnFailure(writer.Finalize(&msgBuf));
+
+    return mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::SubscribeResponse, std::move(msgBuf));
+}
+
+CHIP_ERROR ReadHandler::RefreshSubscribeSyncTimer()
+{
+    System::Layer * systemLayer = GetSystemLayer();
+
+    VerifyOrReturnError(systemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    systemLayer->CancelTimer(OnMinIntervalTimerExpired, this);
+    systemLayer->CancelTimer(OnMaxIntervalTimerExpired, this);
+
+    mHoldReport = true;
+    ReturnErrorOnFailure(systemLayer->StartTimer(secondsToMilliseconds(mMinIntervalFloorSeconds), OnMinIntervalTimerExpired, this));
+    return systemLayer->StartTimer(secondsToMilliseconds(mMaxIntervalCeilingSeconds), OnMaxIntervalTimerExpired, this);
+}
+
+void ReadHandler::OnMinIntervalTimerExpired(System::Layer * apSystemLayer, void * apAppState, System::Error aError)
+{
+    ReadHandler * const readHandler = static_cast<ReadHandler *>(apAppState);
+
+    // Whatever changed while the report was held goes out in one report now.
+    readHandler->mHoldReport = false;
+    if (readHandler->mDirty)
+    {
+        readHandler->ScheduleReport();
+    }
+}
+
+void ReadHandler::OnMaxIntervalTimerExpired(System::Layer * apSystemLayer, void * apAppState, System::Error aError)
+{
+    ReadHandler * const readHandler = static_cast<ReadHandler *>(apAppState);
+
+    // Report even if nothing changed, so that the subscriber knows the subscription is still alive.
+    readHandler->mHoldReport = false;
+    readHandler->ScheduleReport();
+}
+
+void ReadHandler::ScheduleReport()
+{
+    VerifyOrReturn(mState == HandlerState::Subscribed);
+
+    MoveToState(HandlerState::Reportable);
+    CHIP_ERROR err = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+    ChipLogFunctError(err);
+}
+
+bool ReadHandler::SetDirty(const ClusterInfo & aChangedPath)
+{
+    bool intersected = false;
+    // A changed path without a field id stands for every field of its cluster, and so does kRootFieldId.
+    const bool wholeCluster =
+        (aChangedPath.mType != ClusterInfo::Type::kFieldIdValid) || (aChangedPath.mFieldId == kRootFieldId);
+
+    VerifyOrReturnError(IsSubscriptionType(), false);
+
+    for (ClusterInfo * path = mpAttributeClusterInfoList; path != nullptr; path = path->mpNext)
+    {
+        if (path->mEndpointId != aChangedPath.mEndpointId || path->mClusterId != aChangedPath.mClusterId)
+        {
+            continue;
+        }
+
+        if (path->mType == ClusterInfo::Type::kFieldIdValid && path->mFieldId != kRootFieldId)
+        {
+            if (!wholeCluster && aChangedPath.mFieldId != path->mFieldId)
+            {
+                continue;
+            }
+            path->SetDirty();
+        }
+        else if (!path->IsDirty() && (wholeCluster || !AddDirtyField(*path, aChangedPath.mFieldId)))
+        {
+            // The path covers the whole cluster: it is re-encoded as a whole only when no single field can stand for the change.
+            path->SetDirty();
+        }
+        intersected = true;
+    }
+
+    VerifyOrReturnError(intersected, false);
+
+    mDirty = true;
+    if (!mHoldReport)
+    {
+        ScheduleReport();
+    }
+    return true;
+}
+
+bool ReadHandler::AddDirtyField(const ClusterInfo & aPath, FieldId aFieldId)
+{
+    ClusterInfo dirtyField;
+
+    for (ClusterInfo * field = mpDirtyClusterInfoList; field != nullptr; field = field->mpNext)
+    {
+        if (field->mEndpointId == aPath.mEndpointId && field->mClusterId == aPath.mClusterId && field->mFieldId == aFieldId)
+        {
+            // It may have gone out already in an earlier chunk of the report being sent.
+            field->SetDirty();
+            return true;
+        }
+    }
+
+    dirtyField.mNodeId     = aPath.mNodeId;
+    dirtyField.mEndpointId = aPath.mEndpointId;
+    dirtyField.mClusterId  = aPath.mClusterId;
+    dirtyField.mFieldId    = aFieldId;
+    dirtyField.mType       = ClusterInfo::Type::kFieldIdValid;
+    VerifyOrReturnError(InteractionModelEngine::GetInstance()->PushFront(mpDirtyClusterInfoList, dirtyField) == CHIP_NO_ERROR,
+                        false);
+    mpDirtyClusterInfoList->SetDirty();
+    return true;
+}
+
+void ReadHandler::ReleaseDirtyClusterInfoList()
+{
+    InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpDirtyClusterInfoList);
+}
+
 CHIP_ERROR ReadHandler::ProcessReadRequest(System::PacketBufferHandle && aPayload)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -161,6 +455,72 @@ exit:
     return err;
 }
 
+CHIP_ERROR ReadHandler::ProcessSubscribeRequest(System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+
+    SubscribeRequest::Parser subscribeRequestParser;
+    EventPathList::Parser eventPathListParser;
+    AttributePathList::Parser attributePathListParser;
+
+    reader.Init(std::move(aPayload));
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = subscribeRequestParser.Init(reader);
+    SuccessOrExit(err);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = subscribeRequestParser.CheckSchemaValidity();
+    SuccessOrExit(err);
+#endif
+
+    err = subscribeRequestParser.GetAttributePathList(&attributePathListParser);
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    else
+    {
+        SuccessOrExit(err);
+        err = ProcessAttributePathList(attributePathListParser);
+    }
+    SuccessOrExit(err);
+    err = subscribeRequestParser.GetEventPathList(&eventPathListParser);
+    if (err == CHIP_END_OF_TLV)
+    {
+        err = CHIP_NO_ERROR;
+    }
+    else
+    {
+        SuccessOrExit(err);
+        err = ProcessEventPathList(eventPathListParser);
+    }
+    SuccessOrExit(err);
+
+    err = subscribeRequestParser.GetMinIntervalSeconds(&mMinIntervalFloorSeconds);
+    SuccessOrExit(err);
+    err = subscribeRequestParser.GetMaxIntervalSeconds(&mMaxIntervalCeilingSeconds);
+    SuccessOrExit(err);
+    // A zero max interval would re-arm the max interval timer immediately and report continuously.
+    VerifyOrExit(mMaxIntervalCeilingSeconds > 0, err = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(mMinIntervalFloorSeconds <= mMaxIntervalCeilingSeconds, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mSubscriptionId   = GetRandU64();
+    mIsPrimingReports = true;
+    mDirty            = true;
+
+    // The first report answers the request with the current value of every path in the interest set.
+    MoveToState(HandlerState::Reportable);
+
+    err = InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
 CHIP_ERROR ReadHandler::ProcessAttributePathList(AttributePathList::Parser & aAttributePathListParser)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -259,6 +619,12 @@ const char * ReadHandler::GetStateStr() const
 
     case HandlerState::Reportable:
         return "Reportable";
+
+    case HandlerState::Subscribed:
+        return "Subscribed";
+
+    case HandlerState::AwaitingReportResponse:
+        return "AwaitingReportResponse";
     }
 #endif // CHIP_DETAIL_LOGGING
     return "N/A";
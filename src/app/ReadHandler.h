@@ -37,6 +37,7 @@
 #include <support/DLLUtil.h>
 #include <support/logging/CHIPLogging.h>
 #include <system/SystemPacketBuffer.h>
+#include <transport/SecureSessionHandle.h>
 
 namespace chip {
 namespace app {
@@ -46,10 +47,23 @@ namespace app {
  *  @brief The read handler is responsible for processing a read request, asking the attribute/event store
  *         for the relevant data, and sending a reply.
  *
+ *         A read handler that serves a subscribe request outlives its first report: it keeps the path interest set of the
+ *         subscriber and sends a new report whenever a path in that set changes, no sooner than the min interval and no
+ *         later than the max interval after the previous one.
+ *
+ *         A report too big for one message is sent in chunks. Each chunk but the last asks the reader for a status
+ *         response, and the next chunk is only encoded once it has arrived.
+ *
  */
-class ReadHandler
+class ReadHandler : public Messaging::ExchangeDelegate
 {
 public:
+    enum class InteractionType
+    {
+        Read,
+        Subscribe,
+    };
+
     /**
      *  Initialize the ReadHandler. Within the lifetime
      *  of this instance, this method is invoked once after object
@@ -67,7 +81,9 @@ public:
 
     /**
      *  Shut down the ReadHandler. This terminates this instance
-     *  of the object and releases all held resources.
+     *  of the object and releases all held resources, including the
+     *  handler itself when it was allocated by the InteractionModelEngine.
+     *  The object must not be used after Shutdown() is called.
      *
      */
     void Shutdown();
@@ -85,24 +101,56 @@ public:
      */
     CHIP_ERROR OnReadRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
 
+    /**
+     *  Process a subscribe request. As with OnReadRequest, the ReadHandler shuts itself down if OnSubscribeRequest returns an
+     *  error, and otherwise once the subscription fails.
+     *
+     *  @param[in]    apExchangeContext    A pointer to the ExchangeContext.
+     *  @param[in]    aPayload             A payload that has subscribe request data
+     *
+     *  @retval #Others If fails to process subscribe request
+     *  @retval #CHIP_NO_ERROR On success.
+     *
+     */
+    CHIP_ERROR OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
+
+    /**
+     *  Mark the attribute paths of the interest set that intersect aChangedPath as dirty, and schedule a report for them once
+     *  the min interval has passed. Changes made before that report goes out are coalesced into it. A change to a single field
+     *  of a path that covers the whole cluster only dirties that field, so that the report re-encodes just what changed.
+     *
+     *  @param[in]    aChangedPath    The path of the attribute that changed. A path without a field id, or with
+     *                                kRootFieldId, stands for any field of the cluster.
+     *
+     *  @retval true if the change is of interest to this subscription.
+     *
+     */
+    bool SetDirty(const ClusterInfo & aChangedPath);
+
     /**
      *  Send ReportData to initiator
      *
-     *  @param[in]    aPayload             A payload that has read request data
+     *  @param[in]    aPayload               A payload that has read request data
+     *  @param[in]    aMoreChunkedMessages   Whether more chunks of the report follow this one
      *
      *  @retval #Others If fails to send report data
      *  @retval #CHIP_NO_ERROR On success.
      *
      */
-    CHIP_ERROR SendReportData(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR SendReportData(System::PacketBufferHandle && aPayload, bool aMoreChunkedMessages = false);
 
     bool IsFree() const { return mState == HandlerState::Uninitialized; }
     bool IsReportable() const { return mState == HandlerState::Reportable; }
+    bool IsSubscriptionType() const { return mInteractionType == InteractionType::Subscribe; }
+    uint64_t GetSubscriptionId() const { return mSubscriptionId; }
+    const SecureSessionHandle & GetSessionHandle() const { return mSessionHandle; }
 
     virtual ~ReadHandler() = default;
 
     ClusterInfo * GetAttributeClusterInfolist() { return mpAttributeClusterInfoList; }
     ClusterInfo * GetEventClusterInfolist() { return mpEventClusterInfoList; }
+    ClusterInfo * GetDirtyClusterInfoList() { return mpDirtyClusterInfoList; }
+    void ReleaseDirtyClusterInfoList();
     EventNumber * GetVendedEventNumberList() { return mSelfProcessedEvents; }
     PriorityLevel GetCurrentPriority() { return mCurrentPriority; }
 
@@ -115,14 +163,30 @@ public:
     void MoveToNextScheduledDirtyPriority();
 
 private:
+    friend class TestReadInteraction;
+
     enum class HandlerState
     {
-        Uninitialized = 0, ///< The handler has not been initialized
-        Initialized,       ///< The handler has been initialized and is ready
-        Reportable,        ///< The handler has received read request and is waiting for the data to send to be available
+        Uninitialized = 0,      ///< The handler has not been initialized
+        Initialized,            ///< The handler has been initialized and is ready
+        Reportable,             ///< The handler has received read request and is waiting for the data to send to be available
+        Subscribed,             ///< The handler has sent a report for its subscription and is waiting for changes to report
+        AwaitingReportResponse, ///< The handler has sent a chunk of a report and is waiting for the reader to acknowledge it
     };
 
+    void OnMessageReceived(Messaging::ExchangeContext * apExchangeContext, const PacketHeader & aPacketHeader,
+                           const PayloadHeader & aPayloadHeader, System::PacketBufferHandle && aPayload) override;
+    void OnResponseTimeout(Messaging::ExchangeContext * apExchangeContext) override;
+
     CHIP_ERROR ProcessReadRequest(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR ProcessSubscribeRequest(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR SendSubscribeResponse();
+    CHIP_ERROR ProcessStatusResponse(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR RefreshSubscribeSyncTimer();
+    void ScheduleReport();
+    bool AddDirtyField(const ClusterInfo & aPath, FieldId aFieldId);
+    static void OnMinIntervalTimerExpired(System::Layer * apSystemLayer, void * apAppState, System::Error aError);
+    static void OnMaxIntervalTimerExpired(System::Layer * apSystemLayer, void * apAppState, System::Error aError);
     CHIP_ERROR ProcessAttributePathList(AttributePathList::Parser & aAttributePathListParser);
     CHIP_ERROR ProcessEventPathList(EventPathList::Parser & aEventPathListParser);
     void MoveToState(const HandlerState aTargetState);
@@ -136,18 +200,38 @@ private:
     // Don't need the response for report data if true
     bool mSuppressResponse = false;
 
+    InteractionType mInteractionType = InteractionType::Read;
+
+    // The session subscription reports are sent on, once the exchange of the subscribe request is closed
+    SecureSessionHandle mSessionHandle;
+    uint64_t mSubscriptionId            = 0;
+    uint16_t mMinIntervalFloorSeconds   = 0;
+    uint16_t mMaxIntervalCeilingSeconds = 0;
+
+    // Set until the reports answering the subscribe request, and the SubscribeResponse after them, have been sent
+    bool mIsPrimingReports = false;
+
+    // Set while the min interval since the last report has not passed yet
+    bool mHoldReport = false;
+
+    // Set when paths in the interest set changed since the last report
+    bool mDirty = false;
+
     // Current Handler state
     HandlerState mState                      = HandlerState::Uninitialized;
     ClusterInfo * mpAttributeClusterInfoList = nullptr;
     ClusterInfo * mpEventClusterInfoList     = nullptr;
 
+    // The fields that changed under attribute paths covering a whole cluster, each listed once however often it changed
+    ClusterInfo * mpDirtyClusterInfoList = nullptr;
+
     PriorityLevel mCurrentPriority = PriorityLevel::Invalid;
 
     // The event number of the last processed event for each priority level
-    EventNumber mSelfProcessedEvents[kNumPriorityLevel];
+    EventNumber mSelfProcessedEvents[kNumPriorityLevel] = { 0 };
 
     // The last schedule event number snapshoted in the beginning when preparing to fill new events to reports
-    EventNumber mLastScheduledEventNumber[kNumPriorityLevel];
+    EventNumber mLastScheduledEventNumber[kNumPriorityLevel] = { 0 };
 };
 } // namespace app
 } // namespace chip
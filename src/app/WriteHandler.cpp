@@ -0,0 +1,373 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines write handler for a CHIP Interaction Data model
+ *
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/MessageDef/AttributeStatusElement.h>
+#include <app/MessageDef/StatusElement.h>
+#include <app/WriteHandler.h>
+
+using GeneralStatusCode = chip::Protocols::SecureChannel::GeneralStatusCode;
+
+namespace chip {
+namespace app {
+CHIP_ERROR WriteHandler::Init(InteractionModelDelegate * apDelegate)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferHandle packet;
+    AttributeStatusList::Builder attributeStatusListBuilder;
+
+    // Error if already initialized.
+    VerifyOrExit(apDelegate != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(mpExchangeCtx == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    mpDelegate = apDelegate;
+
+    packet = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+    VerifyOrExit(!packet.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+
+    // The response goes out in a single message. Whatever the buffer holds beyond kMaxSecureSduLengthBytes is left unused, along
+    // with the room needed to close the status list and the response once the statuses are in.
+    mMessageWriter.Init(std::move(packet));
+    err = mMessageWriter.ReserveBuffer(mMessageWriter.GetRemainingFreeLength() -
+                                       static_cast<uint32_t>(chip::app::kMaxSecureSduLengthBytes) + kReservedSizeForEndOfResponse);
+    SuccessOrExit(err);
+
+    err = mWriteResponseBuilder.Init(&mMessageWriter);
+    SuccessOrExit(err);
+
+    attributeStatusListBuilder = mWriteResponseBuilder.CreateAttributeStatusListBuilder();
+    err                        = attributeStatusListBuilder.GetError();
+    SuccessOrExit(err);
+
+    MoveToState(State::Initialized);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+void WriteHandler::Shutdown()
+{
+    VerifyOrReturn(mState != State::Uninitialized);
+    mMessageWriter.Reset();
+    AbortExistingExchangeContext();
+    MoveToState(State::Uninitialized);
+    mpDelegate = nullptr;
+    InteractionModelEngine::GetInstance()->ReleaseWriteHandler(this);
+}
+
+CHIP_ERROR WriteHandler::AbortExistingExchangeContext()
+{
+    if (mpExchangeCtx != nullptr)
+    {
+        mpExchangeCtx->Abort();
+        mpExchangeCtx = nullptr;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteHandler::OnWriteRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    mpExchangeCtx = apExchangeContext;
+    err           = ProcessWriteRequest(std::move(aPayload));
+    if (err == CHIP_ERROR_NO_MEMORY)
+    {
+        // The statuses would not fit into the response, nothing was written and the request is turned down as a whole.
+        ChipLogFunctError(err);
+        err = SendStatusResponse(GeneralStatusCode::kResourceExhausted);
+        ExitNow();
+    }
+    SuccessOrExit(err);
+
+    err = SendWriteResponse();
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+    Shutdown();
+    return err;
+}
+
+CHIP_ERROR WriteHandler::ProcessWriteRequest(System::PacketBufferHandle && aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+    TLV::TLVReader attributeDataListReader;
+    TLV::TLVWriter checkpoint;
+
+    WriteRequest::Parser writeRequestParser;
+    AttributeDataList::Parser attributeDataListParser;
+
+    reader.Init(std::move(aPayload), true /* useChainedBuffers */);
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = writeRequestParser.Init(reader);
+    SuccessOrExit(err);
+
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = writeRequestParser.CheckSchemaValidity();
+    SuccessOrExit(err);
+#endif
+
+    err = writeRequestParser.GetAttributeDataList(&attributeDataListParser);
+    SuccessOrExit(err);
+
+    // Nothing is written unless the status of every attribute fits into the response. The statuses are first encoded as
+    // failures, which take the most room, then rolled back before the writes are applied.
+    attributeDataListParser.GetReader(&attributeDataListReader);
+    mWriteResponseBuilder.GetAttributeStatusListBuilder().Checkpoint(checkpoint);
+    err = ProcessAttributeDataList(attributeDataListReader, false /* aApplyWrites */);
+    mWriteResponseBuilder.GetAttributeStatusListBuilder().Rollback(checkpoint);
+    VerifyOrExit(err != CHIP_ERROR_BUFFER_TOO_SMALL, err = CHIP_ERROR_NO_MEMORY);
+    SuccessOrExit(err);
+
+    attributeDataListParser.GetReader(&attributeDataListReader);
+    err = ProcessAttributeDataList(attributeDataListReader, true /* aApplyWrites */);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::ProcessAttributeDataList(TLV::TLVReader & aAttributeDataListReader, bool aApplyWrites)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    while (CHIP_NO_ERROR == (err = aAttributeDataListReader.Next()))
+    {
+        chip::TLV::TLVReader dataReader;
+        AttributeDataElement::Parser element;
+        AttributePath::Parser attributePathParser;
+        ClusterInfo clusterInfo;
+        TLV::TLVReader reader = aAttributeDataListReader;
+        err                   = element.Init(reader);
+        SuccessOrExit(err);
+
+        err = element.GetAttributePath(&attributePathParser);
+        SuccessOrExit(err);
+
+        err = attributePathParser.GetNodeId(&(clusterInfo.mNodeId));
+        SuccessOrExit(err);
+
+        err = attributePathParser.GetEndpointId(&(clusterInfo.mEndpointId));
+        SuccessOrExit(err);
+
+        err = attributePathParser.GetClusterId(&(clusterInfo.mClusterId));
+        SuccessOrExit(err);
+
+        err = attributePathParser.GetFieldId(&(clusterInfo.mFieldId));
+        if (CHIP_NO_ERROR == err)
+        {
+            clusterInfo.mType = ClusterInfo::Type::kFieldIdValid;
+        }
+        else if (CHIP_END_OF_TLV == err)
+        {
+            err = attributePathParser.GetListIndex(&(clusterInfo.mListIndex));
+            SuccessOrExit(err);
+            clusterInfo.mType = ClusterInfo::Type::kListIndexValid;
+        }
+        SuccessOrExit(err);
+
+        err = element.GetData(&dataReader);
+        SuccessOrExit(err);
+
+        // A failed write does not fail the request, it only shows in the status of its attribute.
+        if (aApplyWrites && WriteSingleClusterData(clusterInfo, dataReader) == CHIP_NO_ERROR)
+        {
+            err = AddAttributeStatusCode(clusterInfo, GeneralStatusCode::kSuccess, Protocols::SecureChannel::Id,
+                                         Protocols::SecureChannel::kProtocolCodeSuccess);
+        }
+        else
+        {
+            err = AddAttributeStatusCode(clusterInfo, GeneralStatusCode::kFailure, Protocols::SecureChannel::Id,
+                                         Protocols::SecureChannel::kProtocolCodeGeneralFailure);
+        }
+        SuccessOrExit(err);
+    }
+
+    if (CHIP_END_OF_TLV == err)
+    {
+        err = CHIP_NO_ERROR;
+    }
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::AddAttributeStatusCode(const ClusterInfo & aClusterInfo, const GeneralStatusCode aGeneralCode,
+                                                const Protocols::Id aProtocolId, const uint16_t aProtocolCode)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    StatusElement::Builder statusElementBuilder;
+    AttributePath::Builder attributePathBuilder;
+    AttributeStatusElement::Builder attributeStatusElement;
+
+    VerifyOrExit(mState == State::Initialized || mState == State::AddAttributeStatusCode, err = CHIP_ERROR_INCORRECT_STATE);
+
+    attributeStatusElement = mWriteResponseBuilder.GetAttributeStatusListBuilder().CreateAttributeStatusBuilder();
+    err                    = attributeStatusElement.GetError();
+    SuccessOrExit(err);
+
+    if (aClusterInfo.mType == ClusterInfo::Type::kFieldIdValid)
+    {
+        attributePathBuilder = attributeStatusElement.EncodeAttributePath(aClusterInfo.mNodeId, aClusterInfo.mEndpointId,
+                                                                          aClusterInfo.mClusterId, aClusterInfo.mFieldId);
+    }
+    else
+    {
+        attributePathBuilder = attributeStatusElement.CreateAttributePathBuilder();
+        attributePathBuilder.NodeId(aClusterInfo.mNodeId)
+            .EndpointId(aClusterInfo.mEndpointId)
+            .ClusterId(aClusterInfo.mClusterId)
+            .ListIndex(aClusterInfo.mListIndex)
+            .EndOfAttributePath();
+    }
+    err = attributePathBuilder.GetError();
+    SuccessOrExit(err);
+
+    statusElementBuilder =
+        attributeStatusElement.EncodeStatusElement(aGeneralCode, aProtocolId.ToFullyQualifiedSpecForm(), aProtocolCode);
+    err = statusElementBuilder.GetError();
+    SuccessOrExit(err);
+
+    attributeStatusElement.EndOfAttributeStatusElement();
+    err = attributeStatusElement.GetError();
+    SuccessOrExit(err);
+
+    MoveToState(State::AddAttributeStatusCode);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::FinalizeMessage(System::PacketBufferHandle & aPacket)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    AttributeStatusList::Builder attributeStatusListBuilder;
+
+    VerifyOrExit(mState == State::Initialized || mState == State::AddAttributeStatusCode, err = CHIP_ERROR_INCORRECT_STATE);
+
+    err = mMessageWriter.UnreserveBuffer(kReservedSizeForEndOfResponse);
+    SuccessOrExit(err);
+
+    attributeStatusListBuilder = mWriteResponseBuilder.GetAttributeStatusListBuilder().EndOfAttributeStatusList();
+    err                        = attributeStatusListBuilder.GetError();
+    SuccessOrExit(err);
+
+    mWriteResponseBuilder.EndOfWriteResponse();
+    err = mWriteResponseBuilder.GetError();
+    SuccessOrExit(err);
+
+    err = mMessageWriter.Finalize(&aPacket);
+    SuccessOrExit(err);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::SendWriteResponse()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferHandle packet;
+
+    err = FinalizeMessage(packet);
+    SuccessOrExit(err);
+
+    VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::WriteResponse, std::move(packet));
+    SuccessOrExit(err);
+
+    mpExchangeCtx->Close();
+    mpExchangeCtx = nullptr;
+    MoveToState(State::Sending);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+CHIP_ERROR WriteHandler::SendStatusResponse(const GeneralStatusCode aGeneralCode)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    StatusElement::Builder statusElementBuilder;
+    System::PacketBufferHandle packet = System::PacketBufferHandle::New(chip::app::kMaxSecureSduLengthBytes);
+
+    VerifyOrExit(!packet.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+    VerifyOrExit(mpExchangeCtx != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    writer.Init(std::move(packet));
+    err = statusElementBuilder.Encode(&writer, aGeneralCode, Protocols::SecureChannel::Id.ToFullyQualifiedSpecForm(),
+                                      Protocols::SecureChannel::kProtocolCodeGeneralFailure);
+    SuccessOrExit(err);
+    err = writer.Finalize(&packet);
+    SuccessOrExit(err);
+
+    err = mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::StatusResponse, std::move(packet));
+    SuccessOrExit(err);
+
+    mpExchangeCtx->Close();
+    mpExchangeCtx = nullptr;
+    MoveToState(State::Sending);
+
+exit:
+    ChipLogFunctError(err);
+    return err;
+}
+
+const char * WriteHandler::GetStateStr() const
+{
+#if CHIP_DETAIL_LOGGING
+    switch (mState)
+    {
+    case State::Uninitialized:
+        return "Uninitialized";
+
+    case State::Initialized:
+        return "Initialized";
+
+    case State::AddAttributeStatusCode:
+        return "AddAttributeStatusCode";
+
+    case State::Sending:
+        return "Sending";
+    }
+#endif // CHIP_DETAIL_LOGGING
+    return "N/A";
+}
+
+void WriteHandler::MoveToState(const State aTargetState)
+{
+    mState = aTargetState;
+    ChipLogDetail(DataManagement, "IM WH moving to [%s]", GetStateStr());
+}
+} // namespace app
+} // namespace chip
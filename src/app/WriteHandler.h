@@ -0,0 +1,148 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *     This file defines write handler for a CHIP Interaction Data model
+ *
+ */
+
+#pragma once
+
+#include <app/ClusterInfo.h>
+#include <app/InteractionModelDelegate.h>
+#include <app/MessageDef/WriteRequest.h>
+#include <app/MessageDef/WriteResponse.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPTLVDebug.hpp>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/Flags.h>
+#include <protocols/Protocols.h>
+#include <protocols/secure_channel/Constants.h>
+#include <support/CodeUtils.h>
+#include <support/DLLUtil.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+
+namespace chip {
+namespace app {
+/**
+ *  @class WriteHandler
+ *  @brief The write handler is responsible for processing a write request, handing each attribute data element to
+ *         WriteSingleClusterData, and sending back a single write response holding the status of every element.
+ *         Elements are applied in one pass, in the order of the request. A request too big for one buffer is carried
+ *         in a buffer chain, while the response is bounded by kMaxSecureSduLengthBytes: a request whose statuses would
+ *         not fit is turned down with a status response before any element is applied.
+ */
+class WriteHandler
+{
+public:
+    /**
+     *  Initialize the WriteHandler. Within the lifetime
+     *  of this instance, this method is invoked once after object
+     *  construction until a call to Shutdown is made to terminate the
+     *  instance.
+     *
+     *  @param[in]    apDelegate       InteractionModelDelegate set by application.
+     *
+     *  @retval #CHIP_ERROR_INCORRECT_STATE If the state is not equal to
+     *          kState_NotInitialized.
+     *  @retval #CHIP_NO_ERROR On success.
+     *
+     */
+    CHIP_ERROR Init(InteractionModelDelegate * apDelegate);
+
+    /**
+     *  Shut down the WriteHandler. This terminates this instance
+     *  of the object and releases all held resources, including the
+     *  handler itself when it was allocated by the InteractionModelEngine.
+     *  The object must not be used after Shutdown() is called.
+     *
+     */
+    void Shutdown();
+
+    /**
+     *  Process a write request and send the write response. The WriteHandler shuts itself down once this returns,
+     *  whether or not the request could be processed.
+     *
+     *  @param[in]    apExchangeContext    A pointer to the ExchangeContext.
+     *  @param[in]    aPayload             A payload that has write request data
+     *
+     *  @retval #Others If fails to process write request
+     *  @retval #CHIP_NO_ERROR On success.
+     *
+     */
+    CHIP_ERROR OnWriteRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
+
+    /**
+     *  Add the status of the write of one attribute to the write response.
+     *
+     *  @param[in]    aClusterInfo    The path of the attribute written.
+     *  @param[in]    aGeneralCode    The general status code.
+     *  @param[in]    aProtocolId     The protocol the protocol code belongs to.
+     *  @param[in]    aProtocolCode   The protocol specific status code.
+     *
+     *  @retval #CHIP_ERROR_NO_MEMORY If the status does not fit into the write response
+     *  @retval #Others If the status could not be encoded
+     *  @retval #CHIP_NO_ERROR On success.
+     *
+     */
+    CHIP_ERROR AddAttributeStatusCode(const ClusterInfo & aClusterInfo,
+                                      const Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                      const Protocols::Id aProtocolId, const uint16_t aProtocolCode);
+
+    bool IsFree() const { return mState == State::Uninitialized; }
+
+    virtual ~WriteHandler() = default;
+
+private:
+    friend class TestWriteInteraction;
+
+    enum class State
+    {
+        Uninitialized = 0,      ///< The handler has not been initialized
+        Initialized,            ///< The handler has been initialized and is ready
+        AddAttributeStatusCode, ///< The handler has added the status of at least one attribute to the write response
+        Sending,                ///< The handler has sent out the write response
+    };
+
+    CHIP_ERROR ProcessWriteRequest(System::PacketBufferHandle && aPayload);
+    CHIP_ERROR ProcessAttributeDataList(TLV::TLVReader & aAttributeDataListReader, bool aApplyWrites);
+    CHIP_ERROR FinalizeMessage(System::PacketBufferHandle & aPacket);
+    CHIP_ERROR SendWriteResponse();
+    CHIP_ERROR SendStatusResponse(const Protocols::SecureChannel::GeneralStatusCode aGeneralCode);
+    void MoveToState(const State aTargetState);
+    const char * GetStateStr() const;
+    CHIP_ERROR AbortExistingExchangeContext();
+
+    /**
+     * Room kept at the end of the response for closing the status list and the response itself.
+     *
+     */
+    static constexpr uint32_t kReservedSizeForEndOfResponse = 2;
+
+    Messaging::ExchangeContext * mpExchangeCtx = nullptr;
+    InteractionModelDelegate * mpDelegate      = nullptr;
+    WriteResponse::Builder mWriteResponseBuilder;
+    System::PacketBufferTLVWriter mMessageWriter;
+    State mState = State::Uninitialized;
+};
+} // namespace app
+} // namespace chip
@@ -33,7 +33,8 @@ CHIP_ERROR Engine::Init()
 {
     mMoreChunkedMessages = false;
     mNumReportsInFlight  = 0;
-    mCurReadHandlerIdx   = 0;
+    mRunScheduled        = false;
+    mpLastReadHandler    = nullptr;
     return CHIP_NO_ERROR;
 }
 
@@ -56,12 +57,8 @@ Engine::RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElemen
 {
     CHIP_ERROR err                              = CHIP_NO_ERROR;
     TLV::TLVType type                           = TLV::kTLVType_NotSpecified;
-    AttributePath::Builder attributePathBuilder = aAttributeDataElementBuilder.CreateAttributePathBuilder();
-    attributePathBuilder.NodeId(aClusterInfo.mNodeId)
-        .EndpointId(aClusterInfo.mEndpointId)
-        .ClusterId(aClusterInfo.mClusterId)
-        .FieldId(aClusterInfo.mFieldId)
-        .EndOfAttributePath();
+    AttributePath::Builder attributePathBuilder = aAttributeDataElementBuilder.EncodeAttributePath(
+        aClusterInfo.mNodeId, aClusterInfo.mEndpointId, aClusterInfo.mClusterId, aClusterInfo.mFieldId);
     err = attributePathBuilder.GetError();
     SuccessOrExit(err);
 
@@ -75,9 +72,11 @@ Engine::RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElemen
     // TODO: Add DataVersion support
 
 exit:
-    aClusterInfo.ClearDirty();
-
-    if (err != CHIP_NO_ERROR)
+    if (err == CHIP_NO_ERROR)
+    {
+        aClusterInfo.ClearDirty();
+    }
+    else if (err != CHIP_ERROR_BUFFER_TOO_SMALL && err != CHIP_ERROR_NO_MEMORY)
     {
         ChipLogError(DataManagement, "Error retrieving data from clusterId: %08x, err = %d", aClusterInfo.mClusterId, err);
     }
@@ -85,27 +84,90 @@ exit:
     return err;
 }
 
+CHIP_ERROR Engine::AppendAttributeDataElement(AttributeDataList::Builder & aAttributeDataList, ClusterInfo & aClusterInfo,
+                                              bool & aIsListEmpty)
+{
+    TLV::TLVWriter backup;
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    aAttributeDataList.Checkpoint(backup);
+    AttributeDataElement::Builder attributeDataElementBuilder = aAttributeDataList.CreateAttributeDataElementBuilder();
+    ChipLogDetail(DataManagement, "<RE:Run> Cluster %u, Field %u is dirty", aClusterInfo.mClusterId, aClusterInfo.mFieldId);
+    // Retrieve data for this cluster instance and clear its dirty flag.
+    err = RetrieveClusterData(attributeDataElementBuilder, aClusterInfo);
+    if (err == CHIP_NO_ERROR)
+    {
+        aIsListEmpty = false;
+        return CHIP_NO_ERROR;
+    }
+    VerifyOrReturnError(err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY, err);
+
+    // The element does not fit in this chunk: drop what was written of it, it stays dirty and goes in the next chunk.
+    aAttributeDataList.Rollback(backup);
+    if (aIsListEmpty)
+    {
+        // It would not fit in any chunk either, skip it rather than sending empty chunks forever.
+        ChipLogError(DataManagement, "<RE:Run> Cluster %u, Field %u is too big to fit in a report", aClusterInfo.mClusterId,
+                     aClusterInfo.mFieldId);
+        aClusterInfo.ClearDirty();
+        return CHIP_NO_ERROR;
+    }
+    mMoreChunkedMessages = true;
+    return CHIP_NO_ERROR;
+}
+
+bool Engine::IsClusterDirty(ClusterInfo * apAttributeClusterInfoList, const ClusterInfo & aField)
+{
+    for (ClusterInfo * path = apAttributeClusterInfoList; path != nullptr; path = path->mpNext)
+    {
+        const bool isWholeCluster = (path->mType != ClusterInfo::Type::kFieldIdValid) || (path->mFieldId == kRootFieldId);
+        if (isWholeCluster && path->IsDirty() && path->mEndpointId == aField.mEndpointId && path->mClusterId == aField.mClusterId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 CHIP_ERROR Engine::BuildSingleReportDataAttributeDataList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler)
 {
     CHIP_ERROR err                               = CHIP_NO_ERROR;
+    bool isListEmpty                             = true;
     ClusterInfo * clusterInfo                    = apReadHandler->GetAttributeClusterInfolist();
     AttributeDataList::Builder attributeDataList = reportDataBuilder.CreateAttributeDataListBuilder();
     SuccessOrExit(err = reportDataBuilder.GetError());
-    // TODO: Need to handle multiple chunk of message
-    while (clusterInfo != nullptr)
+
+    // Fields that changed under a path covering their whole cluster, unless that path is re-encoded as a whole anyway
+    for (ClusterInfo * dirtyField = apReadHandler->GetDirtyClusterInfoList(); dirtyField != nullptr && !mMoreChunkedMessages;
+         dirtyField = dirtyField->mpNext)
+    {
+        if (!dirtyField->IsDirty() || IsClusterDirty(apReadHandler->GetAttributeClusterInfolist(), *dirtyField))
+        {
+            continue;
+        }
+
+        err = AppendAttributeDataElement(attributeDataList, *dirtyField, isListEmpty);
+        VerifyOrExit(err == CHIP_NO_ERROR, ChipLogError(DataManagement, "<RE:Run> Error retrieving data from cluster, aborting"));
+    }
+
+    // Whatever did not fit stays dirty, and is encoded in the next chunk.
+    while (clusterInfo != nullptr && !mMoreChunkedMessages)
     {
         if (clusterInfo->IsDirty())
         {
-            AttributeDataElement::Builder attributeDataElementBuilder = attributeDataList.CreateAttributeDataElementBuilder();
-            ChipLogDetail(DataManagement, "<RE:Run> Cluster %u, Field %u is dirty", clusterInfo->mClusterId, clusterInfo->mFieldId);
-            // Retrieve data for this cluster instance and clear its dirty flag.
-            err = RetrieveClusterData(attributeDataElementBuilder, *clusterInfo);
+            err = AppendAttributeDataElement(attributeDataList, *clusterInfo, isListEmpty);
             VerifyOrExit(err == CHIP_NO_ERROR,
                          ChipLogError(DataManagement, "<RE:Run> Error retrieving data from cluster, aborting"));
         }
 
         clusterInfo = clusterInfo->mpNext;
     }
+
+    if (!mMoreChunkedMessages)
+    {
+        apReadHandler->ReleaseDirtyClusterInfoList();
+    }
+
     attributeDataList.EndOfAttributeDataList();
     err = attributeDataList.GetError();
 
@@ -171,7 +233,6 @@ CHIP_ERROR Engine::BuildSingleReportDataEventList(ReportData::Builder & aReportD
             // priority level.
             err = CHIP_NO_ERROR;
             apReadHandler->MoveToNextScheduledDirtyPriority();
-            mMoreChunkedMessages = false;
         }
         else if ((err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_ERROR_NO_MEMORY))
         {
@@ -194,10 +255,10 @@ CHIP_ERROR Engine::BuildSingleReportDataEventList(ReportData::Builder & aReportD
                 // (we will get another chance immediately afterwards,
                 // with a ew buffer) and do not advance the processing
                 // to the next priority level.
-                err = CHIP_NO_ERROR;
+                err                  = CHIP_NO_ERROR;
+                mMoreChunkedMessages = true;
                 break;
             }
-            mMoreChunkedMessages = true;
         }
         else
         {
@@ -232,20 +293,37 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 
     VerifyOrExit(!bufHandle.IsNull(), err = CHIP_ERROR_NO_MEMORY);
 
+    mMoreChunkedMessages = false;
     reportDataWriter.Init(std::move(bufHandle));
 
+    // Whether the report needs more chunks is only known once the lists are encoded, keep room to say so.
+    err = reportDataWriter.ReserveBuffer(kReservedSizeForMoreChunksFlag);
+    SuccessOrExit(err);
+
     // Create a report data.
     err = reportDataBuilder.Init(&reportDataWriter);
     SuccessOrExit(err);
 
+    if (apReadHandler->IsSubscriptionType())
+    {
+        reportDataBuilder.SubscriptionId(apReadHandler->GetSubscriptionId());
+        SuccessOrExit(err = reportDataBuilder.GetError());
+    }
+
     err = BuildSingleReportDataAttributeDataList(reportDataBuilder, apReadHandler);
     SuccessOrExit(err);
 
-    err = BuildSingleReportDataEventList(reportDataBuilder, apReadHandler);
+    // Events only go in once the attributes are done, they would find no room left otherwise.
+    if (!mMoreChunkedMessages)
+    {
+        err = BuildSingleReportDataEventList(reportDataBuilder, apReadHandler);
+        SuccessOrExit(err);
+    }
+
+    err = reportDataWriter.UnreserveBuffer(kReservedSizeForMoreChunksFlag);
     SuccessOrExit(err);
 
-    // TODO: Add mechanism to set mSuppressResponse to handle status reports for multiple reports
-    // TODO: Add more chunk message support, currently mMoreChunkedMessages is always false.
+    // Every chunk but the last is acknowledged by the reader before the next one is encoded.
     if (mMoreChunkedMessages)
     {
         reportDataBuilder.MoreChunkedMessages(mMoreChunkedMessages);
@@ -275,12 +353,16 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 #endif // CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
 
     ChipLogDetail(DataManagement, "<RE> Sending report...");
-    err = SendReport(apReadHandler, std::move(bufHandle));
+    // Once handed the report, the read handler shuts itself down, unless it waits for the reader to acknowledge a chunk or goes
+    // on serving a subscription.
+    err           = SendReport(apReadHandler, std::move(bufHandle), mMoreChunkedMessages);
+    apReadHandler = nullptr;
     VerifyOrExit(err == CHIP_NO_ERROR, ChipLogError(DataManagement, "<RE> Error sending out report data with %d!", err));
 
-    ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %u with readHandler %u, RE has %s", mNumReportsInFlight,
-                  mCurReadHandlerIdx, mMoreChunkedMessages ? "more messages" : "no more messages");
+    ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %u, RE has %s", mNumReportsInFlight,
+                  mMoreChunkedMessages ? "more messages" : "no more messages");
 
+    // A chunk stays in flight until the reader acknowledges it, or its read handler shuts down.
     if (!mMoreChunkedMessages)
     {
         OnReportConfirm();
@@ -288,7 +370,7 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 
 exit:
     ChipLogFunctError(err);
-    if (!mMoreChunkedMessages || err != CHIP_NO_ERROR)
+    if (apReadHandler != nullptr)
     {
         apReadHandler->Shutdown();
     }
@@ -298,50 +380,56 @@ exit:
 void Engine::Run(System::Layer * aSystemLayer, void * apAppState, System::Error)
 {
     Engine * const pEngine = reinterpret_cast<Engine *>(apAppState);
+    pEngine->mRunScheduled = false;
     pEngine->Run();
 }
 
 CHIP_ERROR Engine::ScheduleRun()
 {
-    if (InteractionModelEngine::GetInstance()->GetExchangeManager() != nullptr)
-    {
-        return InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionMgr()->SystemLayer()->ScheduleWork(Run, this);
-    }
-    else
-    {
-        return CHIP_ERROR_INCORRECT_STATE;
-    }
+    Messaging::ExchangeManager * exchangeManager = InteractionModelEngine::GetInstance()->GetExchangeManager();
+    CHIP_ERROR err                               = CHIP_NO_ERROR;
+
+    VerifyOrReturnError(exchangeManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // A pending run serves every reportable handler, so requests arriving together share it.
+    VerifyOrReturnError(!mRunScheduled, CHIP_NO_ERROR);
+
+    err           = exchangeManager->GetSessionMgr()->SystemLayer()->ScheduleWork(Run, this);
+    mRunScheduled = (err == CHIP_NO_ERROR);
+    return err;
 }
 
 void Engine::Run()
 {
-    uint32_t numReadHandled = 0;
-
     InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
-    ReadHandler * readHandler         = imEngine->mReadHandlers + mCurReadHandlerIdx;
+    size_t numReadHandled             = 0;
+    size_t numReadHandlers            = imEngine->mReadHandlers.Allocated();
 
-    while ((mNumReportsInFlight < CHIP_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < CHIP_MAX_NUM_READ_HANDLER))
+    // Take turns, starting after the handler served last, so that every reader gets a report before any gets a second one.
+    while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < numReadHandlers))
     {
-        if (readHandler->IsReportable())
+        ReadHandler * readHandler = imEngine->NextReportableHandler(mpLastReadHandler);
+        if (readHandler == nullptr)
         {
-            CHIP_ERROR err = BuildAndSendSingleReportData(readHandler);
-            ChipLogFunctError(err);
-            return;
+            break;
         }
+
+        mpLastReadHandler = readHandler;
         numReadHandled++;
-        mCurReadHandlerIdx = (mCurReadHandlerIdx + 1) % CHIP_MAX_NUM_READ_HANDLER;
-        readHandler        = imEngine->mReadHandlers + mCurReadHandlerIdx;
+
+        CHIP_ERROR err = BuildAndSendSingleReportData(readHandler);
+        ChipLogFunctError(err);
     }
 }
 
-CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload)
+CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aMoreChunkedMessages)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     // We can only have 1 report in flight for any given read - increment and break out.
     mNumReportsInFlight++;
 
-    err = apReadHandler->SendReportData(std::move(aPayload));
+    err = apReadHandler->SendReportData(std::move(aPayload), aMoreChunkedMessages);
 
     if (err != CHIP_NO_ERROR)
     {
@@ -350,6 +438,15 @@ CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferH
     return err;
 }
 
+void Engine::SetDirty(const ClusterInfo & aChangedPath)
+{
+    // Each subscription keeps its own dirty set, so a change is reported once to every subscriber whose interest set covers it.
+    InteractionModelEngine::GetInstance()->mReadHandlers.ForEachActiveObject([&](ReadHandler * readHandler) {
+        readHandler->SetDirty(aChangedPath);
+        return true;
+    });
+}
+
 void Engine::OnReportConfirm()
 {
     VerifyOrDie(mNumReportsInFlight > 0);
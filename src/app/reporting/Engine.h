@@ -38,6 +38,8 @@
 
 namespace chip {
 namespace app {
+class TestReadInteraction;
+
 namespace reporting {
 /*
  *  @class Engine
@@ -70,8 +72,25 @@ public:
      */
     CHIP_ERROR ScheduleRun();
 
+    /**
+     * Mark an attribute as changed for all the subscriptions whose interest set covers it. Each of them reports the change
+     * once its min interval has passed, together with whatever else changed in the meantime.
+     *
+     * @param[in] aChangedPath  The path of the attribute that changed. A path without a field id, or with
+     *                          kRootFieldId, stands for any field of the cluster.
+     */
+    void SetDirty(const ClusterInfo & aChangedPath);
+
+    /**
+     * Should be invoked when the device receives a Status report, or when the Report data request times out.
+     * This allows the engine to do some clean-up.
+     *
+     */
+    void OnReportConfirm();
+
 private:
     friend class TestReportingEngine;
+    friend class app::TestReadInteraction;
     /**
      * Build Single Report Data including attribute changes and event data stream, and send out
      *
@@ -80,33 +99,35 @@ private:
 
     CHIP_ERROR BuildSingleReportDataAttributeDataList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler);
     CHIP_ERROR BuildSingleReportDataEventList(ReportData::Builder & reportDataBuilder, ReadHandler * apReadHandler);
+    static bool IsClusterDirty(ClusterInfo * apAttributeClusterInfoList, const ClusterInfo & aField);
     CHIP_ERROR RetrieveClusterData(AttributeDataElement::Builder & aAttributeDataElementBuilder, ClusterInfo & aClusterInfo);
+    CHIP_ERROR AppendAttributeDataElement(AttributeDataList::Builder & aAttributeDataList, ClusterInfo & aClusterInfo,
+                                          bool & aIsListEmpty);
     EventNumber CountEvents(ReadHandler * apReadHandler, EventNumber * apInitialEvents);
 
     /**
      * Send Report via ReadHandler
      *
      */
-    CHIP_ERROR SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload);
+    CHIP_ERROR SendReport(ReadHandler * apReadHandler, System::PacketBufferHandle && aPayload, bool aMoreChunkedMessages);
 
     /**
-     * Should be invoked when the device receives a Status report, or when the Report data request times out.
-     * This allows the engine to do some clean-up.
+     * Generate and send the report data request when there exists subscription or read request
      *
      */
-    void OnReportConfirm();
+    static void Run(System::Layer * aSystemLayer, void * apAppState, System::Error);
 
     /**
-     * Generate and send the report data request when there exists subscription or read request
+     * Boolean to show if more chunk message on the way, for the report being built
      *
      */
-    static void Run(System::Layer * aSystemLayer, void * apAppState, System::Error);
+    bool mMoreChunkedMessages = false;
 
     /**
-     * Boolean to show if more chunk message on the way
+     * Room kept at the end of each report for the MoreChunkedMessages flag: one control byte and one context tag byte.
      *
      */
-    bool mMoreChunkedMessages = false;
+    static constexpr uint32_t kReservedSizeForMoreChunksFlag = 2;
 
     /**
      * The number of report date request in flight
@@ -115,10 +136,17 @@ private:
     uint32_t mNumReportsInFlight = 0;
 
     /**
-     *  Current read handler index
+     *  Whether a call to Run is already scheduled on the CHIP thread
+     *
+     */
+    bool mRunScheduled = false;
+
+    /**
+     *  The read handler served last. It may have been released since; it is only compared against the handlers in the pool to
+     *  find where to resume.
      *
      */
-    uint32_t mCurReadHandlerIdx = 0;
+    const ReadHandler * mpLastReadHandler = nullptr;
 };
 
 }; // namespace reporting
@@ -39,6 +39,7 @@
  *******************************************************************************
  ******************************************************************************/
 
+#include <app/InteractionModelEngine.h>
 #include <app/reporting/reporting.h>
 #include <app/util/af-event.h>
 #include <app/util/af.h>
@@ -699,6 +700,20 @@ void emberAfReportingAttributeChangeCallback(EndpointId endpoint, ClusterId clus
                                              uint16_t manufacturerCode, EmberAfAttributeType type, uint8_t * data)
 {
     uint8_t i;
+    app::ClusterInfo changedPath;
+
+    // Interaction Model subscriptions re-encode just this attribute. One whose id does not fit a field id is marked without
+    // one, and is reported along with the rest of its cluster. So is attribute 0: field id 0 is kRootFieldId, which names the
+    // whole cluster in an attribute path, so the attribute can't be reported on its own.
+    changedPath.mEndpointId = endpoint;
+    changedPath.mClusterId  = clusterId;
+    if (attributeId <= UINT8_MAX)
+    {
+        changedPath.mFieldId = static_cast<FieldId>(attributeId);
+        changedPath.mType    = app::ClusterInfo::Type::kFieldIdValid;
+    }
+    app::InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(changedPath);
+
     for (i = 0; i < REPORT_TABLE_SIZE; i++)
     {
         EmberAfPluginReportingEntry entry;
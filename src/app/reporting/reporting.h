@@ -117,7 +117,8 @@ EmberStatus emberAfClearReportTableCallback(void);
  * This function is called by the framework when an attribute managed by the
  * framework changes.  The application should call this function when an
  * externally-managed attribute changes.  The application should use the change
- * notification to inform its reporting decisions.
+ * notification to inform its reporting decisions.  The change is also marked dirty
+ * for the Interaction Model subscriptions that cover the attribute.
  *
  * @param endpoint   Ver.: always
  * @param clusterId   Ver.: always
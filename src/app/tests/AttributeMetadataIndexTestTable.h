@@ -0,0 +1,192 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the endpoint table shared by the
+ *      AttributeMetadataIndex tests and benchmark.
+ *
+ */
+
+#pragma once
+
+#include <app/util/AttributeMetadataIndex.h>
+#include <support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace TestAttributeMetadataIndex {
+
+// A bridge-like endpoint table laid out like the generated one: every endpoint points at the same endpoint type, which holds
+// a few clusters with a dozen attributes each, small enough for all the storage offsets to fit in 16 bits.
+constexpr ClusterId kClusterIds[]     = { 0x0003, 0x0004, 0x0005, 0x0006, 0x0008, 0x001D, 0x0028, 0x0039, 0x0300, 0x0402 };
+constexpr uint16_t kAttributeCount    = 12;
+constexpr uint8_t kClusterCount       = sizeof(kClusterIds) / sizeof(kClusterIds[0]);
+constexpr uint8_t kMaxEndpointCount   = 255;
+constexpr EndpointId kFirstEndpointId = 1;
+
+struct TestAttribute
+{
+    AttributeId attributeId;
+    uint16_t size;
+};
+
+struct TestCluster
+{
+    ClusterId clusterId;
+    const TestAttribute * attributes;
+    uint16_t attributeCount;
+    uint16_t clusterSize;
+};
+
+struct TestEndpointType
+{
+    const TestCluster * clusters;
+    uint8_t clusterCount;
+    uint16_t endpointSize;
+};
+
+struct TestEndpoint
+{
+    EndpointId endpoint;
+    const TestEndpointType * endpointType;
+};
+
+inline AttributeId AttributeIdAt(uint16_t attributeIndex)
+{
+    // Global attributes such as ClusterRevision come last
+    return (attributeIndex + 1 == kAttributeCount) ? 0xFFFD : attributeIndex;
+}
+
+/**
+ * The endpoint table, with the index built from it and the scan it replaces.
+ */
+class TestEndpointTable
+{
+public:
+    void Init()
+    {
+        mEndpointType = { mClusters, kClusterCount, 0 };
+
+        for (uint8_t clusterIndex = 0; clusterIndex < kClusterCount; clusterIndex++)
+        {
+            mClusters[clusterIndex] = { kClusterIds[clusterIndex], mAttributes[clusterIndex], kAttributeCount, 0 };
+            for (uint16_t attributeIndex = 0; attributeIndex < kAttributeCount; attributeIndex++)
+            {
+                mAttributes[clusterIndex][attributeIndex] = { AttributeIdAt(attributeIndex),
+                                                              static_cast<uint16_t>(1 + attributeIndex % 2) };
+                mClusters[clusterIndex].clusterSize =
+                    static_cast<uint16_t>(mClusters[clusterIndex].clusterSize + mAttributes[clusterIndex][attributeIndex].size);
+            }
+            mEndpointType.endpointSize = static_cast<uint16_t>(mEndpointType.endpointSize + mClusters[clusterIndex].clusterSize);
+        }
+
+        for (uint8_t ep = 0; ep < kMaxEndpointCount; ep++)
+        {
+            mEndpoints[ep] = { static_cast<EndpointId>(kFirstEndpointId + ep), &mEndpointType };
+        }
+    }
+
+    CHIP_ERROR BuildIndex(AttributeMetadataIndex & index, uint8_t endpointCount)
+    {
+        ReturnErrorOnFailure(index.Init(static_cast<size_t>(endpointCount) * kClusterCount * kAttributeCount, endpointCount));
+
+        // Add endpoints in reverse so that sorting has some work to do
+        for (uint8_t ep = endpointCount; ep > 0; ep--)
+        {
+            const uint8_t epIndex = static_cast<uint8_t>(ep - 1);
+            uint16_t offset       = static_cast<uint16_t>(epIndex * mEndpointType.endpointSize);
+
+            ReturnErrorOnFailure(index.AddEndpoint(mEndpoints[epIndex].endpoint, epIndex));
+
+            for (uint8_t clusterIndex = 0; clusterIndex < kClusterCount; clusterIndex++)
+            {
+                const TestCluster & cluster = mClusters[clusterIndex];
+                for (uint16_t attributeIndex = 0; attributeIndex < cluster.attributeCount; attributeIndex++)
+                {
+                    AttributeMetadataIndex::Attribute attribute;
+                    attribute.endpoint       = mEndpoints[epIndex].endpoint;
+                    attribute.clusterId      = cluster.clusterId;
+                    attribute.attributeId    = cluster.attributes[attributeIndex].attributeId;
+                    attribute.endpointIndex  = epIndex;
+                    attribute.clusterIndex   = clusterIndex;
+                    attribute.attributeIndex = attributeIndex;
+                    attribute.storageOffset  = offset;
+                    ReturnErrorOnFailure(index.AddAttribute(attribute));
+
+                    offset = static_cast<uint16_t>(offset + cluster.attributes[attributeIndex].size);
+                }
+            }
+        }
+
+        index.Finalize();
+        return CHIP_NO_ERROR;
+    }
+
+    // The nested scan attribute storage does without the index. Returns the storage offset, or -1 if not found.
+    int32_t ScanForAttribute(uint8_t endpointCount, EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+    {
+        uint16_t offset = 0;
+
+        for (uint8_t ep = 0; ep < endpointCount; ep++)
+        {
+            const TestEndpointType * endpointType = mEndpoints[ep].endpointType;
+            if (mEndpoints[ep].endpoint != endpoint)
+            {
+                offset = static_cast<uint16_t>(offset + endpointType->endpointSize);
+                continue;
+            }
+            for (uint8_t clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+            {
+                const TestCluster & cluster = endpointType->clusters[clusterIndex];
+                if (cluster.clusterId != clusterId)
+                {
+                    offset = static_cast<uint16_t>(offset + cluster.clusterSize);
+                    continue;
+                }
+                for (uint16_t attributeIndex = 0; attributeIndex < cluster.attributeCount; attributeIndex++)
+                {
+                    if (cluster.attributes[attributeIndex].attributeId == attributeId)
+                    {
+                        return offset;
+                    }
+                    offset = static_cast<uint16_t>(offset + cluster.attributes[attributeIndex].size);
+                }
+            }
+        }
+
+        return -1;
+    }
+
+private:
+    TestAttribute mAttributes[kClusterCount][kAttributeCount];
+    TestCluster mClusters[kClusterCount];
+    TestEndpointType mEndpointType;
+    TestEndpoint mEndpoints[kMaxEndpointCount];
+};
+
+inline int32_t LookUpAttribute(const AttributeMetadataIndex & index, EndpointId endpoint, ClusterId clusterId,
+                               AttributeId attributeId)
+{
+    Span<const AttributeMetadataIndex::Attribute> found = index.FindAttribute(endpoint, clusterId, attributeId);
+    return (found.size() > 0) ? found.data()[0].storageOffset : -1;
+}
+
+} // namespace TestAttributeMetadataIndex
+} // namespace app
+} // namespace chip
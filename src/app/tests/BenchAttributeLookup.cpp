@@ -0,0 +1,101 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of attribute metadata lookups through
+ *      AttributeMetadataIndex against the nested endpoint/cluster/attribute
+ *      scan, for 1, 32 and 255 endpoints.
+ */
+
+#include "AttributeMetadataIndexTestTable.h"
+
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::TestAttributeMetadataIndex;
+
+namespace {
+
+constexpr size_t kLookupCount = 20000;
+
+TestEndpointTable sTable;
+
+// Returns lookups per second, or 0 on failure.
+template <typename LookUp>
+uint64_t RunLookupBenchmark(uint8_t endpointCount, LookUp lookUp)
+{
+    int64_t checksum = 0;
+    uint64_t start   = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        const EndpointId endpoint     = static_cast<EndpointId>(kFirstEndpointId + (i * 7) % endpointCount);
+        const ClusterId clusterId     = kClusterIds[(i * 3) % kClusterCount];
+        const AttributeId attributeId = AttributeIdAt(static_cast<uint16_t>(i % kAttributeCount));
+        checksum += lookUp(endpoint, clusterId, attributeId);
+    }
+
+    uint64_t elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    // Every lookup hits, so the checksum can't be negative; this keeps the loop from being optimized away.
+    return (elapsed > 0 && checksum >= 0) ? kLookupCount * 1000000 / elapsed : 0;
+}
+
+} // namespace
+
+int main()
+{
+    static const uint8_t kEndpointCounts[] = { 1, 32, kMaxEndpointCount };
+    int result                             = EXIT_SUCCESS;
+
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+    sTable.Init();
+
+    for (uint8_t endpointCount : kEndpointCounts)
+    {
+        AttributeMetadataIndex index;
+        VerifyOrDie(sTable.BuildIndex(index, endpointCount) == CHIP_NO_ERROR);
+
+        uint64_t scan = RunLookupBenchmark(endpointCount, [endpointCount](EndpointId ep, ClusterId cluster, AttributeId attribute) {
+            return sTable.ScanForAttribute(endpointCount, ep, cluster, attribute);
+        });
+        uint64_t indexed = RunLookupBenchmark(endpointCount, [&index](EndpointId ep, ClusterId cluster, AttributeId attribute) {
+            return LookUpAttribute(index, ep, cluster, attribute);
+        });
+
+        if (scan == 0 || indexed == 0)
+        {
+            result = EXIT_FAILURE;
+        }
+
+        printf("Attribute lookup over %3u endpoints: scan %" PRIu64 " lookups/s, index %" PRIu64 " lookups/s\n",
+               static_cast<unsigned>(endpointCount), scan, indexed);
+    }
+
+    Platform::MemoryShutdown();
+
+    return result;
+}
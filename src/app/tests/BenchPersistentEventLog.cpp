@@ -0,0 +1,117 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of LogEvent with a critical event
+ *      buffer in memory against one kept in a file by PersistentEventStorage.
+ */
+
+#include <app/EventLoggingDelegate.h>
+#include <app/EventLoggingTypes.h>
+#include <app/EventManagement.h>
+#include <app/PersistentEventStorage.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPEventLoggingConfig.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr int32_t kNumEvents   = 10000;
+constexpr uint32_t kBufferSize = 4096;
+
+class StatusEventGenerator : public EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) { return aWriter.Put(TLV::ContextTag(1), mStatus); }
+
+    void SetStatus(int32_t aStatus) { mStatus = aStatus; }
+
+private:
+    int32_t mStatus = 0;
+};
+
+// Returns the time taken to log kNumEvents critical events, in microseconds, or 0 on failure.
+uint64_t TimeLogEvents(const char * apPath)
+{
+    static uint8_t sPlainBuffer[kBufferSize];
+    PersistentEventStorage storage;
+    CircularEventBuffer circularEventBuffer[1];
+    EventManagement logMgmt;
+    StatusEventGenerator generator;
+    EventSchema schema = { 0x18B4300000000001ULL, 2, 0x00000022, 1, PriorityLevel::Critical };
+    EventOptions options;
+    uint8_t * buffer = sPlainBuffer;
+
+    if (apPath != nullptr)
+    {
+        VerifyOrReturnError(storage.Open(apPath, kBufferSize) == CHIP_NO_ERROR, 0);
+        buffer = storage.GetBuffer();
+    }
+
+    LogStorageResources logStorageResources[] = {
+        { buffer, kBufferSize, nullptr, 0, nullptr, PriorityLevel::Critical, (apPath != nullptr) ? &storage : nullptr },
+    };
+    logMgmt.Init(nullptr, 1, circularEventBuffer, logStorageResources);
+    options.mpEventSchema = &schema;
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+    for (int32_t i = 0; i < kNumEvents; i++)
+    {
+        EventNumber eventNumber = 0;
+
+        generator.SetStatus(i);
+        VerifyOrReturnError(logMgmt.LogEvent(&generator, options, eventNumber) == CHIP_NO_ERROR, 0);
+    }
+    return System::Layer::GetClock_MonotonicHiRes() - start;
+}
+
+} // namespace
+
+int main()
+{
+    char path[] = "/tmp/chip-event-storage-XXXXXX";
+    int fd      = -1;
+
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    fd = mkstemp(path);
+    VerifyOrDie(fd >= 0);
+    close(fd);
+
+    uint64_t plainTime      = TimeLogEvents(nullptr);
+    uint64_t persistentTime = TimeLogEvents(path);
+
+    unlink(path);
+    Platform::MemoryShutdown();
+
+    printf("LogEvent of %" PRId32 " events: %" PRIu64 " us in memory, %" PRIu64 " us kept in a file (sync every %d)\n",
+           kNumEvents, plainTime, persistentTime, CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL);
+
+    return (plainTime > 0 && persistentTime > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
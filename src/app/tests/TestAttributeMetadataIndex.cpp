@@ -0,0 +1,154 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for AttributeMetadataIndex
+ *
+ */
+
+#include "AttributeMetadataIndexTestTable.h"
+
+#include <nlunit-test.h>
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+
+namespace chip {
+namespace app {
+namespace TestAttributeMetadataIndex {
+
+TestEndpointTable sTable;
+
+void TestLookup(nlTestSuite * apSuite, void * apContext)
+{
+    AttributeMetadataIndex index;
+
+    NL_TEST_ASSERT(apSuite, !index.IsReady());
+    NL_TEST_ASSERT(apSuite, index.FindAttribute(1, 0x0006, 0).size() == 0);
+
+    NL_TEST_ASSERT(apSuite, sTable.BuildIndex(index, 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.IsReady());
+
+    // Every attribute is found where the scan finds it
+    for (uint8_t ep = 0; ep < 4; ep++)
+    {
+        const EndpointId endpoint = static_cast<EndpointId>(kFirstEndpointId + ep);
+
+        Span<const AttributeMetadataIndex::Endpoint> endpoints = index.FindEndpoint(endpoint);
+        NL_TEST_ASSERT(apSuite, endpoints.size() == 1 && endpoints.data()[0].endpointIndex == ep);
+
+        for (ClusterId clusterId : kClusterIds)
+        {
+            for (uint16_t attributeIndex = 0; attributeIndex < kAttributeCount; attributeIndex++)
+            {
+                const AttributeId attributeId = AttributeIdAt(attributeIndex);
+                NL_TEST_ASSERT(apSuite,
+                               LookUpAttribute(index, endpoint, clusterId, attributeId) ==
+                                   sTable.ScanForAttribute(4, endpoint, clusterId, attributeId));
+            }
+        }
+    }
+
+    // Unknown endpoints, clusters and attributes
+    NL_TEST_ASSERT(apSuite, index.FindEndpoint(0).size() == 0);
+    NL_TEST_ASSERT(apSuite, index.FindEndpoint(5).size() == 0);
+    NL_TEST_ASSERT(apSuite, index.FindAttribute(5, 0x0006, 0).size() == 0);
+    NL_TEST_ASSERT(apSuite, index.FindAttribute(1, 0x0007, 0).size() == 0);
+    NL_TEST_ASSERT(apSuite, index.FindAttribute(1, 0x0006, kAttributeCount).size() == 0);
+
+    // Rebuilding replaces the previous contents
+    NL_TEST_ASSERT(apSuite, sTable.BuildIndex(index, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.FindEndpoint(3).size() == 0);
+    NL_TEST_ASSERT(apSuite, LookUpAttribute(index, 2, 0x0402, 0xFFFD) == sTable.ScanForAttribute(2, 2, 0x0402, 0xFFFD));
+
+    index.Clear();
+    NL_TEST_ASSERT(apSuite, !index.IsReady());
+    NL_TEST_ASSERT(apSuite, index.FindEndpoint(1).size() == 0);
+
+    // An empty endpoint table still gives a usable index
+    NL_TEST_ASSERT(apSuite, index.Init(0, 0) == CHIP_NO_ERROR);
+    index.Finalize();
+    NL_TEST_ASSERT(apSuite, index.IsReady());
+    NL_TEST_ASSERT(apSuite, index.FindAttribute(0, 0, 0).size() == 0);
+    NL_TEST_ASSERT(apSuite, index.FindEndpoint(0).size() == 0);
+}
+
+void TestDuplicateIds(nlTestSuite * apSuite, void * apContext)
+{
+    AttributeMetadataIndex index;
+    AttributeMetadataIndex::Attribute attribute = { 1, 0x0006, 0, 0, 0, 0, 0 };
+
+    NL_TEST_ASSERT(apSuite, index.Init(3, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.AddEndpoint(1, 0) == CHIP_NO_ERROR);
+
+    // Client and server instances of the same cluster stay in table order
+    attribute.clusterIndex  = 2;
+    attribute.storageOffset = 20;
+    NL_TEST_ASSERT(apSuite, index.AddAttribute(attribute) == CHIP_NO_ERROR);
+    attribute.clusterIndex  = 1;
+    attribute.storageOffset = 10;
+    NL_TEST_ASSERT(apSuite, index.AddAttribute(attribute) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, index.AddEndpoint(2, 1) == CHIP_ERROR_NO_MEMORY);
+
+    index.Finalize();
+    NL_TEST_ASSERT(apSuite, index.AddAttribute(attribute) == CHIP_ERROR_INCORRECT_STATE);
+
+    Span<const AttributeMetadataIndex::Attribute> found = index.FindAttribute(1, 0x0006, 0);
+    NL_TEST_ASSERT(apSuite, found.size() == 2);
+    NL_TEST_ASSERT(apSuite, found.data()[0].clusterIndex == 1 && found.data()[0].storageOffset == 10);
+    NL_TEST_ASSERT(apSuite, found.data()[1].clusterIndex == 2 && found.data()[1].storageOffset == 20);
+}
+
+int TestSetup(void * inContext)
+{
+    sTable.Init();
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace TestAttributeMetadataIndex
+} // namespace app
+} // namespace chip
+
+namespace {
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestLookup", chip::app::TestAttributeMetadataIndex::TestLookup),
+    NL_TEST_DEF("TestDuplicateIds", chip::app::TestAttributeMetadataIndex::TestDuplicateIds),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+} // namespace
+
+int TestAttributeMetadataIndex()
+{
+    nlTestSuite theSuite = { "AttributeMetadataIndex", &sTests[0], chip::app::TestAttributeMetadataIndex::TestSetup,
+                             chip::app::TestAttributeMetadataIndex::TestTeardown };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeMetadataIndex)
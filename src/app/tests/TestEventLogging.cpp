@@ -27,6 +27,7 @@
 #include <app/EventLoggingTypes.h>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
+#include <app/MessageDef/EventDataElement.h>
 #include <core/CHIPCore.h>
 #include <core/CHIPTLV.h>
 #include <core/CHIPTLVDebug.hpp>
@@ -37,6 +38,7 @@
 #include <platform/CHIPDeviceLayer.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
 #include <protocols/secure_channel/PASESession.h>
+#include <support/CHIPCounter.h>
 #include <support/ErrorStr.h>
 #include <support/UnitTestRegistration.h>
 #include <system/SystemPacketBuffer.h>
@@ -60,6 +62,8 @@ static chip::System::Layer gSystemLayer;
 static uint8_t gDebugEventBuffer[128];
 static uint8_t gInfoEventBuffer[128];
 static uint8_t gCritEventBuffer[128];
+// Room for more events than the index of a buffer holds
+static uint8_t gLargeEventBuffer[2048];
 static chip::app::CircularEventBuffer gCircularEventBuffer[3];
 
 chip::SecureSessionMgr gSessionManager;
@@ -90,11 +94,11 @@ void InitializeChip(nlTestSuite * apSuite)
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 }
 
-void InitializeEventLogging()
+void InitializeEventLogging(uint8_t * apDebugBuffer, uint32_t aDebugBufferSize, uint8_t * apInfoBuffer, uint32_t aInfoBufferSize)
 {
     chip::app::LogStorageResources logStorageResources[] = {
-        { &gDebugEventBuffer[0], sizeof(gDebugEventBuffer), nullptr, 0, nullptr, chip::app::PriorityLevel::Debug },
-        { &gInfoEventBuffer[0], sizeof(gInfoEventBuffer), nullptr, 0, nullptr, chip::app::PriorityLevel::Info },
+        { apDebugBuffer, aDebugBufferSize, nullptr, 0, nullptr, chip::app::PriorityLevel::Debug },
+        { apInfoBuffer, aInfoBufferSize, nullptr, 0, nullptr, chip::app::PriorityLevel::Info },
         { &gCritEventBuffer[0], sizeof(gCritEventBuffer), nullptr, 0, nullptr, chip::app::PriorityLevel::Critical },
     };
 
@@ -166,6 +170,45 @@ static void CheckLogReadOut(nlTestSuite * apSuite, chip::app::EventManagement &
     chip::TLV::Debug::Dump(reader, SimpleDumpWriter);
 }
 
+static void CheckSeekEventReader(nlTestSuite * apSuite, chip::app::EventManagement & aLogMgmt, chip::app::PriorityLevel aPriority,
+                                 chip::EventNumber aStartingEventNumber, chip::EventNumber aExpectedEventNumber,
+                                 int32_t aExpectedStatus)
+{
+    CHIP_ERROR err;
+    chip::TLV::TLVReader reader;
+    chip::TLV::TLVWriter writer;
+    chip::TLV::TLVType eventType;
+    chip::TLV::TLVType dataType;
+    chip::app::CircularEventBufferWrapper bufWrapper;
+    chip::app::EventLoadOutContext context(writer, aPriority, aStartingEventNumber);
+    int32_t status = -1;
+
+    context.mCurrentEventNumber = aLogMgmt.GetFirstEventNumber(aPriority);
+    err                         = aLogMgmt.SeekEventReader(reader, context, &bufWrapper);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, context.mCurrentEventNumber == aExpectedEventNumber);
+
+    // The reader starts at the very event the context says it does
+    err = reader.Next();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = reader.EnterContainer(eventType);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (reader.GetTag() == chip::TLV::ContextTag(chip::app::EventDataElement::kCsTag_Data))
+        {
+            break;
+        }
+    }
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = reader.EnterContainer(dataType);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = reader.Next(chip::TLV::kTLVType_SignedInteger, kLivenessDeviceStatus);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = reader.Get(status);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && status == aExpectedStatus);
+}
+
 class TestEventGenerator : public chip::app::EventLoggingDelegate
 {
 public:
@@ -276,13 +319,161 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     err = logMgmt.LogEvent(&testEventGenerator, options, eid6);
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
+
+    // The remaining events are read from their index entries, across the end of the buffer storage where they wrap around it;
+    // the dropped ones no longer have any, and reading then starts at the oldest event.
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eid1, 3);
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eid4, 3);
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eid5, 2);
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eid6, 1);
+}
+
+static void CheckIndexWithEviction(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    constexpr int32_t kNumEvents  = 40;
+    chip::EventNumber eids[kNumEvents];
+    chip::app::EventSchema schema = { kTestDeviceNodeId, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent,
+                                      chip::app::PriorityLevel::Debug };
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+
+    options.mpEventSchema = &schema;
+
+    chip::app::EventManagement::DestroyEventManagement();
+    InitializeEventLogging(&gLargeEventBuffer[0], sizeof(gLargeEventBuffer), &gInfoEventBuffer[0], sizeof(gInfoEventBuffer));
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // More events than the index holds, the buffer keeping them all
+    for (int32_t i = 0; i < kNumEvents; i++)
+    {
+        testEventGenerator.SetStatus(i);
+        err = logMgmt.LogEvent(&testEventGenerator, options, eids[i]);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    CheckLogState(apSuite, logMgmt, kNumEvents, chip::app::PriorityLevel::Debug);
+    static_assert(kNumEvents > CHIP_CONFIG_EVENT_INDEX_SIZE + 1, "Some events must be left out of the index");
+
+    // The latest events are indexed, the older ones are read from the oldest event on
+    CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[kNumEvents - 1], eids[kNumEvents - 1],
+                         kNumEvents - 1);
+    CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[kNumEvents - CHIP_CONFIG_EVENT_INDEX_SIZE],
+                         eids[kNumEvents - CHIP_CONFIG_EVENT_INDEX_SIZE], kNumEvents - CHIP_CONFIG_EVENT_INDEX_SIZE);
+    CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[kNumEvents - CHIP_CONFIG_EVENT_INDEX_SIZE - 1],
+                         eids[0], 0);
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[kNumEvents - CHIP_CONFIG_EVENT_INDEX_SIZE - 1],
+                    CHIP_CONFIG_EVENT_INDEX_SIZE + 1);
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[kNumEvents - 2], 2);
+
+    // Keep logging until the oldest events are dropped, and with them every index entry but those of the latest events
+    for (int32_t i = kNumEvents; logMgmt.GetFirstEventNumber(chip::app::PriorityLevel::Debug) <= eids[kNumEvents - 1]; i++)
+    {
+        chip::EventNumber eid;
+        testEventGenerator.SetStatus(i);
+        err = logMgmt.LogEvent(&testEventGenerator, options, eid);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, eid == eids[0] + static_cast<chip::EventNumber>(i));
+    }
+
+    chip::EventNumber firstEventNumber = logMgmt.GetFirstEventNumber(chip::app::PriorityLevel::Debug);
+    chip::EventNumber lastEventNumber  = logMgmt.GetLastEventNumber(chip::app::PriorityLevel::Debug);
+    int32_t firstStatus                = static_cast<int32_t>(firstEventNumber - eids[0]);
+    int32_t lastStatus                 = static_cast<int32_t>(lastEventNumber - eids[0]);
+
+    CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Debug, lastEventNumber, lastEventNumber, lastStatus);
+    CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Debug, lastEventNumber - 3, lastEventNumber - 3,
+                         lastStatus - 3);
+    CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[kNumEvents - 1], firstEventNumber, firstStatus);
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, lastEventNumber - 3, 4);
+    CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, lastEventNumber - CHIP_CONFIG_EVENT_INDEX_SIZE,
+                    CHIP_CONFIG_EVENT_INDEX_SIZE + 1);
+}
+
+static void CheckIndexWithEventNumberWraparound(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    constexpr int32_t kNumEvents = 6;
+    chip::EventNumber eids[kNumEvents];
+    chip::app::EventSchema schema = { kTestDeviceNodeId, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent,
+                                      chip::app::PriorityLevel::Debug };
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+    chip::MonotonicallyIncreasingCounter counter;
+
+    options.mpEventSchema = &schema;
+
+    chip::app::EventManagement::DestroyEventManagement();
+    InitializeEventLogging(&gLargeEventBuffer[0], sizeof(gLargeEventBuffer), &gInfoEventBuffer[0], sizeof(gInfoEventBuffer));
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // The 32-bit event counter wraps around halfway through
+    err = counter.Init(UINT32_MAX - kNumEvents / 2 + 1);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    gCircularEventBuffer[0].InitCounter(&counter);
+
+    for (int32_t i = 0; i < kNumEvents; i++)
+    {
+        testEventGenerator.SetStatus(i);
+        err = logMgmt.LogEvent(&testEventGenerator, options, eids[i]);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    CheckLogState(apSuite, logMgmt, kNumEvents, chip::app::PriorityLevel::Debug);
+
+    // Event numbers go on increasing past the wraparound
+    NL_TEST_ASSERT(apSuite, eids[0] == UINT32_MAX - kNumEvents / 2 + 1);
+    NL_TEST_ASSERT(apSuite, eids[kNumEvents / 2] == static_cast<chip::EventNumber>(UINT32_MAX) + 1);
+    for (int32_t i = 0; i < kNumEvents; i++)
+    {
+        NL_TEST_ASSERT(apSuite, eids[i] == eids[0] + static_cast<chip::EventNumber>(i));
+        CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[i], eids[i], i);
+        CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Debug, eids[i], static_cast<size_t>(kNumEvents - i));
+    }
+}
+
+static void CheckIndexWithPromotion(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    constexpr int32_t kNumEvents = 10;
+    chip::EventNumber eids[kNumEvents];
+    chip::app::EventSchema schema = { kTestDeviceNodeId, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent,
+                                      chip::app::PriorityLevel::Info };
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+
+    options.mpEventSchema = &schema;
+
+    chip::app::EventManagement::DestroyEventManagement();
+    InitializeEventLogging(&gDebugEventBuffer[0], sizeof(gDebugEventBuffer), &gLargeEventBuffer[0], sizeof(gLargeEventBuffer));
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+
+    // The debug buffer only has room for the latest few events, the older ones are promoted into the info buffer
+    for (int32_t i = 0; i < kNumEvents; i++)
+    {
+        testEventGenerator.SetStatus(i);
+        err = logMgmt.LogEvent(&testEventGenerator, options, eids[i]);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    }
+    CheckLogState(apSuite, logMgmt, kNumEvents, chip::app::PriorityLevel::Info);
+    CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
+
+    // Events keep their index entries in whichever buffer they are
+    for (int32_t i = 0; i < kNumEvents; i++)
+    {
+        CheckSeekEventReader(apSuite, logMgmt, chip::app::PriorityLevel::Info, eids[i], eids[i], i);
+        CheckLogReadOut(apSuite, logMgmt, chip::app::PriorityLevel::Info, eids[i], static_cast<size_t>(kNumEvents - i));
+    }
 }
+
 /**
  *   Test Suite. It lists all the test functions.
  */
 
 const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
-                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent), NL_TEST_SENTINEL() };
+                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+                          NL_TEST_DEF("CheckIndexWithEviction", CheckIndexWithEviction),
+                          NL_TEST_DEF("CheckIndexWithEventNumberWraparound", CheckIndexWithEventNumberWraparound),
+                          NL_TEST_DEF("CheckIndexWithPromotion", CheckIndexWithPromotion),
+                          NL_TEST_SENTINEL() };
 } // namespace
 
 int TestEventLogging()
@@ -298,7 +489,7 @@ int TestEventLogging()
     // clang-format on
 
     InitializeChip(&theSuite);
-    InitializeEventLogging();
+    InitializeEventLogging(&gDebugEventBuffer[0], sizeof(gDebugEventBuffer), &gInfoEventBuffer[0], sizeof(gInfoEventBuffer));
     nlTestRunner(&theSuite, nullptr);
 
     return (nlTestRunnerStats(&theSuite));
@@ -27,6 +27,8 @@
 #include <app/MessageDef/InvokeCommand.h>
 #include <app/MessageDef/ReadRequest.h>
 #include <app/MessageDef/ReportData.h>
+#include <app/MessageDef/SubscribeRequest.h>
+#include <app/MessageDef/SubscribeResponse.h>
 #include <app/MessageDef/WriteRequest.h>
 #include <app/MessageDef/WriteResponse.h>
 #include <core/CHIPTLVDebug.hpp>
@@ -881,6 +883,115 @@ void ParseWriteResponse(nlTestSuite * apSuite, chip::TLV::TLVReader & aReader)
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 }
 
+void BuildSubscribeRequest(nlTestSuite * apSuite, chip::TLV::TLVWriter & aWriter)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    SubscribeRequest::Builder subscribeRequestBuilder;
+
+    err = subscribeRequestBuilder.Init(&aWriter);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    AttributePathList::Builder attributePathList = subscribeRequestBuilder.CreateAttributePathListBuilder();
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+    BuildAttributePathList(apSuite, attributePathList);
+
+    EventPathList::Builder eventPathList = subscribeRequestBuilder.CreateEventPathListBuilder();
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+    BuildEventPathList(apSuite, eventPathList);
+
+    AttributeDataVersionList::Builder attributeDataVersionList = subscribeRequestBuilder.CreateAttributeDataVersionListBuilder();
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+    BuildAttributeDataVersionList(apSuite, attributeDataVersionList);
+
+    subscribeRequestBuilder.EventNumber(1);
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    subscribeRequestBuilder.MinIntervalSeconds(2);
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    subscribeRequestBuilder.MaxIntervalSeconds(3);
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    subscribeRequestBuilder.EndOfSubscribeRequest();
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+}
+
+void ParseSubscribeRequest(nlTestSuite * apSuite, chip::TLV::TLVReader & aReader)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SubscribeRequest::Parser subscribeRequestParser;
+    AttributePathList::Parser attributePathListParser;
+    EventPathList::Parser eventPathListParser;
+    AttributeDataVersionList::Parser attributeDataVersionListParser;
+    uint64_t eventNumber        = 0;
+    uint16_t minIntervalSeconds = 0;
+    uint16_t maxIntervalSeconds = 0;
+
+    err = subscribeRequestParser.Init(aReader);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = subscribeRequestParser.CheckSchemaValidity();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#endif
+    err = subscribeRequestParser.GetAttributePathList(&attributePathListParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = subscribeRequestParser.GetEventPathList(&eventPathListParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = subscribeRequestParser.GetAttributeDataVersionList(&attributeDataVersionListParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = subscribeRequestParser.GetEventNumber(&eventNumber);
+    NL_TEST_ASSERT(apSuite, eventNumber == 1 && err == CHIP_NO_ERROR);
+
+    err = subscribeRequestParser.GetMinIntervalSeconds(&minIntervalSeconds);
+    NL_TEST_ASSERT(apSuite, minIntervalSeconds == 2 && err == CHIP_NO_ERROR);
+
+    err = subscribeRequestParser.GetMaxIntervalSeconds(&maxIntervalSeconds);
+    NL_TEST_ASSERT(apSuite, maxIntervalSeconds == 3 && err == CHIP_NO_ERROR);
+}
+
+void BuildSubscribeResponse(nlTestSuite * apSuite, chip::TLV::TLVWriter & aWriter)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    SubscribeResponse::Builder subscribeResponseBuilder;
+
+    err = subscribeResponseBuilder.Init(&aWriter);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    subscribeResponseBuilder.SubscriptionId(1);
+    NL_TEST_ASSERT(apSuite, subscribeResponseBuilder.GetError() == CHIP_NO_ERROR);
+
+    subscribeResponseBuilder.FinalSyncIntervalSeconds(2);
+    NL_TEST_ASSERT(apSuite, subscribeResponseBuilder.GetError() == CHIP_NO_ERROR);
+
+    subscribeResponseBuilder.EndOfSubscribeResponse();
+    NL_TEST_ASSERT(apSuite, subscribeResponseBuilder.GetError() == CHIP_NO_ERROR);
+}
+
+void ParseSubscribeResponse(nlTestSuite * apSuite, chip::TLV::TLVReader & aReader)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SubscribeResponse::Parser subscribeResponseParser;
+    uint64_t subscriptionId           = 0;
+    uint16_t finalSyncIntervalSeconds = 0;
+
+    err = subscribeResponseParser.Init(aReader);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = subscribeResponseParser.CheckSchemaValidity();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#endif
+    err = subscribeResponseParser.GetSubscriptionId(&subscriptionId);
+    NL_TEST_ASSERT(apSuite, subscriptionId == 1 && err == CHIP_NO_ERROR);
+
+    err = subscribeResponseParser.GetFinalSyncIntervalSeconds(&finalSyncIntervalSeconds);
+    NL_TEST_ASSERT(apSuite, finalSyncIntervalSeconds == 2 && err == CHIP_NO_ERROR);
+}
+
 void AttributePathTest(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -1231,6 +1342,111 @@ void CommandDataElementWithStatusCodeTest(nlTestSuite * apSuite, void * apContex
     ParseCommandDataElementWithStatusCode(apSuite, commandDataElementParser);
 }
 
+void CommandDataElementEncodeTest(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    CommandDataElement::Builder commandDataElementBuilder;
+    CommandDataElement::Parser commandDataElementParser;
+    CommandPath::Parser commandPathParser;
+    StatusElement::Parser statusElementParser;
+    chip::System::PacketBufferTLVWriter writer;
+    chip::System::PacketBufferTLVReader reader;
+    chip::EndpointId endpointId = 0;
+    chip::ClusterId clusterId   = 0;
+    chip::CommandId commandId   = 0;
+    writer.Init(chip::System::PacketBufferHandle::New(chip::System::PacketBuffer::kMaxSize));
+    commandDataElementBuilder.Init(&writer);
+
+    // The path and the status are encoded from their precomputed encodings, and must read back like built ones.
+    commandDataElementBuilder.EncodeCommandPath(1, 3, 4);
+    NL_TEST_ASSERT(apSuite, commandDataElementBuilder.GetError() == CHIP_NO_ERROR);
+    commandDataElementBuilder.EncodeStatusElement(chip::Protocols::SecureChannel::GeneralStatusCode::kFailure, 2, 3);
+    NL_TEST_ASSERT(apSuite, commandDataElementBuilder.GetError() == CHIP_NO_ERROR);
+    commandDataElementBuilder.EndOfCommandDataElement();
+    NL_TEST_ASSERT(apSuite, commandDataElementBuilder.GetError() == CHIP_NO_ERROR);
+
+    chip::System::PacketBufferHandle buf;
+    err = writer.Finalize(&buf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    DebugPrettyPrint(buf);
+
+    reader.Init(std::move(buf));
+    err = reader.Next();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    commandDataElementParser.Init(reader);
+    ParseCommandDataElementWithStatusCode(apSuite, commandDataElementParser);
+
+    err = commandDataElementParser.GetCommandPath(&commandPathParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = commandPathParser.GetEndpointId(&endpointId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && endpointId == 1);
+    err = commandPathParser.GetClusterId(&clusterId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && clusterId == 3);
+    err = commandPathParser.GetCommandId(&commandId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && commandId == 4);
+
+    err = commandDataElementParser.GetStatusElement(&statusElementParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    ParseStatusElement(apSuite, statusElementParser);
+}
+
+void AttributeStatusElementEncodeTest(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    AttributeStatusElement::Builder attributeStatusElementBuilder;
+    AttributeStatusElement::Parser attributeStatusElementParser;
+    AttributePath::Parser attributePathParser;
+    StatusElement::Parser statusElementParser;
+    chip::System::PacketBufferTLVWriter writer;
+    chip::System::PacketBufferTLVReader reader;
+    chip::NodeId nodeId         = 0;
+    chip::EndpointId endpointId = 0;
+    chip::ClusterId clusterId   = 0;
+    chip::FieldId fieldId       = 0;
+    writer.Init(chip::System::PacketBufferHandle::New(chip::System::PacketBuffer::kMaxSize));
+    attributeStatusElementBuilder.Init(&writer);
+
+    attributeStatusElementBuilder.EncodeAttributePath(0x0102030405060708, 2, 0x0300, 4);
+    NL_TEST_ASSERT(apSuite, attributeStatusElementBuilder.GetError() == CHIP_NO_ERROR);
+    attributeStatusElementBuilder.EncodeStatusElement(chip::Protocols::SecureChannel::GeneralStatusCode::kFailure, 2, 3);
+    NL_TEST_ASSERT(apSuite, attributeStatusElementBuilder.GetError() == CHIP_NO_ERROR);
+    attributeStatusElementBuilder.EndOfAttributeStatusElement();
+    NL_TEST_ASSERT(apSuite, attributeStatusElementBuilder.GetError() == CHIP_NO_ERROR);
+
+    chip::System::PacketBufferHandle buf;
+    err = writer.Finalize(&buf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    DebugPrettyPrint(buf);
+
+    reader.Init(std::move(buf));
+    err = reader.Next();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    attributeStatusElementParser.Init(reader);
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = attributeStatusElementParser.CheckSchemaValidity();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#endif
+
+    err = attributeStatusElementParser.GetAttributePath(&attributePathParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = attributePathParser.GetNodeId(&nodeId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && nodeId == 0x0102030405060708);
+    err = attributePathParser.GetEndpointId(&endpointId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && endpointId == 2);
+    err = attributePathParser.GetClusterId(&clusterId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && clusterId == 0x0300);
+    err = attributePathParser.GetFieldId(&fieldId);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && fieldId == 4);
+
+    err = attributeStatusElementParser.GetStatusElement(&statusElementParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    ParseStatusElement(apSuite, statusElementParser);
+}
+
 void CommandListTest(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -1347,6 +1563,44 @@ void WriteResponseTest(nlTestSuite * apSuite, void * apContext)
     ParseWriteResponse(apSuite, reader);
 }
 
+void SubscribeRequestTest(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::System::PacketBufferTLVWriter writer;
+    chip::System::PacketBufferTLVReader reader;
+    writer.Init(chip::System::PacketBufferHandle::New(chip::System::PacketBuffer::kMaxSize));
+    BuildSubscribeRequest(apSuite, writer);
+    chip::System::PacketBufferHandle buf;
+    err = writer.Finalize(&buf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    DebugPrettyPrint(buf);
+
+    reader.Init(std::move(buf));
+    err = reader.Next();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    ParseSubscribeRequest(apSuite, reader);
+}
+
+void SubscribeResponseTest(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::System::PacketBufferTLVWriter writer;
+    chip::System::PacketBufferTLVReader reader;
+    writer.Init(chip::System::PacketBufferHandle::New(chip::System::PacketBuffer::kMaxSize));
+    BuildSubscribeResponse(apSuite, writer);
+    chip::System::PacketBufferHandle buf;
+    err = writer.Finalize(&buf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    DebugPrettyPrint(buf);
+
+    reader.Init(std::move(buf));
+    err = reader.Next();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    ParseSubscribeResponse(apSuite, reader);
+}
+
 void CheckPointRollbackTest(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err        = CHIP_NO_ERROR;
@@ -1422,12 +1676,16 @@ const nlTest sTests[] =
                 NL_TEST_DEF("AttributeDataVersionListTest", AttributeDataVersionListTest),
                 NL_TEST_DEF("CommandDataElementTest", CommandDataElementTest),
                 NL_TEST_DEF("CommandDataElementWithStatusCodeTest", CommandDataElementWithStatusCodeTest),
+                NL_TEST_DEF("CommandDataElementEncodeTest", CommandDataElementEncodeTest),
+                NL_TEST_DEF("AttributeStatusElementEncodeTest", AttributeStatusElementEncodeTest),
                 NL_TEST_DEF("CommandListTest", CommandListTest),
                 NL_TEST_DEF("ReportDataTest", ReportDataTest),
                 NL_TEST_DEF("InvokeCommandTest", InvokeCommandTest),
                 NL_TEST_DEF("ReadRequestTest", ReadRequestTest),
                 NL_TEST_DEF("WriteRequestTest", WriteRequestTest),
                 NL_TEST_DEF("WriteResponseTest", WriteResponseTest),
+                NL_TEST_DEF("SubscribeRequestTest", SubscribeRequestTest),
+                NL_TEST_DEF("SubscribeResponseTest", SubscribeResponseTest),
                 NL_TEST_DEF("CheckPointRollbackTest", CheckPointRollbackTest),
                 NL_TEST_SENTINEL()
         };
@@ -0,0 +1,436 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a test for the file backed event storage of CHIP Interaction Model Event logging
+ *
+ */
+
+#include <app/ClusterInfo.h>
+#include <app/EventLoggingDelegate.h>
+#include <app/EventLoggingTypes.h>
+#include <app/EventManagement.h>
+#include <app/PersistentEventStorage.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPEventLoggingConfig.h>
+#include <core/CHIPTLV.h>
+#include <core/CHIPTLVUtilities.hpp>
+#include <support/CHIPMem.h>
+#include <support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace {
+
+static const chip::NodeId kTestDeviceNodeId     = 0x18B4300000000001ULL;
+static const chip::ClusterId kLivenessClusterId = 0x00000022;
+static const uint32_t kLivenessChangeEvent      = 1;
+static const chip::EndpointId kTestEndpointId   = 2;
+static const uint64_t kLivenessDeviceStatus     = chip::TLV::ContextTag(1);
+
+class TestEventGenerator : public chip::app::EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(chip::TLV::TLVWriter & aWriter) { return aWriter.Put(kLivenessDeviceStatus, mStatus); }
+
+    void SetStatus(int32_t aStatus) { mStatus = aStatus; }
+
+private:
+    int32_t mStatus;
+};
+
+// A single buffer of critical events, kept in the file at the given path, if any.
+class TestEventLog
+{
+public:
+    TestEventLog(nlTestSuite * apSuite, const char * apPath, uint32_t aBufferSize)
+    {
+        uint8_t * buffer = mPlainBuffer;
+
+        if (apPath != nullptr)
+        {
+            NL_TEST_ASSERT(apSuite, mStorage.Open(apPath, aBufferSize) == CHIP_NO_ERROR);
+            buffer = mStorage.GetBuffer();
+        }
+
+        chip::app::LogStorageResources logStorageResources[] = {
+            { buffer, aBufferSize, nullptr, 0, nullptr, chip::app::PriorityLevel::Critical,
+              (apPath != nullptr) ? &mStorage : nullptr },
+        };
+        mLogMgmt.Init(nullptr, 1, mCircularEventBuffer, logStorageResources);
+    }
+
+    ~TestEventLog() { mStorage.Close(); }
+
+    chip::EventNumber LogEvent(nlTestSuite * apSuite, int32_t aStatus)
+    {
+        chip::app::EventSchema schema = { kTestDeviceNodeId, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent,
+                                          chip::app::PriorityLevel::Critical };
+        chip::app::EventOptions options;
+        chip::EventNumber eventNumber = 0;
+
+        options.mpEventSchema = &schema;
+        mGenerator.SetStatus(aStatus);
+        NL_TEST_ASSERT(apSuite, mLogMgmt.LogEvent(&mGenerator, options, eventNumber) == CHIP_NO_ERROR);
+        return eventNumber;
+    }
+
+    size_t CountEvents(nlTestSuite * apSuite)
+    {
+        chip::TLV::TLVReader reader;
+        chip::app::CircularEventBufferWrapper bufWrapper;
+        size_t elementCount = 0;
+
+        NL_TEST_ASSERT(apSuite, mLogMgmt.GetEventReader(reader, chip::app::PriorityLevel::Critical, &bufWrapper) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, chip::TLV::Utilities::Count(reader, elementCount, false) == CHIP_NO_ERROR);
+        return elementCount;
+    }
+
+    size_t CountEventsSince(nlTestSuite * apSuite, chip::EventNumber aEventNumber)
+    {
+        chip::TLV::TLVReader reader;
+        chip::TLV::TLVWriter writer;
+        chip::app::ClusterInfo clusterInfo;
+        size_t elementCount = 0;
+        CHIP_ERROR err;
+
+        writer.Init(mReadOut, sizeof(mReadOut));
+        clusterInfo.mEventId = kLivenessChangeEvent;
+        err = mLogMgmt.FetchEventsSince(writer, &clusterInfo, chip::app::PriorityLevel::Critical, aEventNumber);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV);
+
+        reader.Init(mReadOut, writer.GetLengthWritten());
+        NL_TEST_ASSERT(apSuite, chip::TLV::Utilities::Count(reader, elementCount, false) == CHIP_NO_ERROR);
+        return elementCount;
+    }
+
+    chip::app::EventManagement & GetLogMgmt() { return mLogMgmt; }
+    chip::app::PersistentEventStorage & GetStorage() { return mStorage; }
+
+private:
+    chip::app::PersistentEventStorage mStorage;
+    chip::app::CircularEventBuffer mCircularEventBuffer[1];
+    chip::app::EventManagement mLogMgmt;
+    TestEventGenerator mGenerator;
+    uint8_t mPlainBuffer[4096];
+    uint8_t mReadOut[4096];
+};
+
+// A buffer for each priority, each of them kept in the file at the given path, if any.
+class TestPriorityEventLog
+{
+public:
+    static constexpr size_t kNumBuffers = 3;
+
+    TestPriorityEventLog(nlTestSuite * apSuite, const char * const (&aPaths)[kNumBuffers], uint32_t aBufferSize)
+    {
+        static const chip::app::PriorityLevel kPriorities[kNumBuffers] = { chip::app::PriorityLevel::Debug,
+                                                                           chip::app::PriorityLevel::Info,
+                                                                           chip::app::PriorityLevel::Critical };
+        chip::app::LogStorageResources logStorageResources[kNumBuffers];
+
+        for (size_t i = 0; i < kNumBuffers; i++)
+        {
+            uint8_t * buffer = mPlainBuffers[i];
+
+            if (aPaths[i] != nullptr)
+            {
+                NL_TEST_ASSERT(apSuite, mStorage[i].Open(aPaths[i], aBufferSize) == CHIP_NO_ERROR);
+                buffer = mStorage[i].GetBuffer();
+            }
+            logStorageResources[i] = { buffer,         aBufferSize, nullptr, 0, nullptr, kPriorities[i],
+                                       (aPaths[i] != nullptr) ? &mStorage[i] : nullptr };
+        }
+        mLogMgmt.Init(nullptr, kNumBuffers, mCircularEventBuffer, logStorageResources);
+    }
+
+    ~TestPriorityEventLog()
+    {
+        for (auto & storage : mStorage)
+        {
+            storage.Close();
+        }
+    }
+
+    chip::EventNumber LogEvent(nlTestSuite * apSuite, chip::app::PriorityLevel aPriority, int32_t aStatus)
+    {
+        chip::app::EventSchema schema = { kTestDeviceNodeId, kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent, aPriority };
+        chip::app::EventOptions options;
+        chip::EventNumber eventNumber = 0;
+
+        options.mpEventSchema = &schema;
+        mGenerator.SetStatus(aStatus);
+        NL_TEST_ASSERT(apSuite, mLogMgmt.LogEvent(&mGenerator, options, eventNumber) == CHIP_NO_ERROR);
+        return eventNumber;
+    }
+
+    // The events in all of the buffers
+    size_t CountEvents(nlTestSuite * apSuite)
+    {
+        chip::TLV::TLVReader reader;
+        chip::app::CircularEventBufferWrapper bufWrapper;
+        size_t elementCount = 0;
+
+        NL_TEST_ASSERT(apSuite, mLogMgmt.GetEventReader(reader, chip::app::PriorityLevel::Critical, &bufWrapper) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, chip::TLV::Utilities::Count(reader, elementCount, false) == CHIP_NO_ERROR);
+        return elementCount;
+    }
+
+    chip::app::EventManagement & GetLogMgmt() { return mLogMgmt; }
+
+private:
+    chip::app::PersistentEventStorage mStorage[kNumBuffers];
+    chip::app::CircularEventBuffer mCircularEventBuffer[kNumBuffers];
+    chip::app::EventManagement mLogMgmt;
+    TestEventGenerator mGenerator;
+    uint8_t mPlainBuffers[kNumBuffers][512];
+};
+
+class TestEventFile
+{
+public:
+    TestEventFile()
+    {
+        snprintf(mPath, sizeof(mPath), "/tmp/chip-event-storage-XXXXXX");
+        int fd = mkstemp(mPath);
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    ~TestEventFile() { unlink(mPath); }
+
+    const char * GetPath() const { return mPath; }
+
+private:
+    char mPath[64];
+};
+
+void CheckRestoreAfterRestart(nlTestSuite * apSuite, void * apContext)
+{
+    TestEventFile file;
+    chip::EventNumber firstEventNumber = 0;
+    chip::EventNumber lastEventNumber  = 0;
+    size_t numEvents                   = 0;
+
+    {
+        // Log enough events to wrap around the buffer.
+        TestEventLog log(apSuite, file.GetPath(), 256);
+        for (int32_t i = 0; i < 50; i++)
+        {
+            lastEventNumber = log.LogEvent(apSuite, i);
+        }
+        firstEventNumber = log.GetLogMgmt().GetFirstEventNumber(chip::app::PriorityLevel::Critical);
+        numEvents        = log.CountEvents(apSuite);
+        NL_TEST_ASSERT(apSuite, numEvents > 0 && numEvents < 50);
+    }
+
+    TestEventLog log(apSuite, file.GetPath(), 256);
+    NL_TEST_ASSERT(apSuite, log.GetLogMgmt().GetFirstEventNumber(chip::app::PriorityLevel::Critical) == firstEventNumber);
+    NL_TEST_ASSERT(apSuite, log.GetLogMgmt().GetLastEventNumber(chip::app::PriorityLevel::Critical) == lastEventNumber);
+    NL_TEST_ASSERT(apSuite, log.CountEvents(apSuite) == numEvents);
+    NL_TEST_ASSERT(apSuite, log.CountEventsSince(apSuite, firstEventNumber) == numEvents);
+    NL_TEST_ASSERT(apSuite, log.CountEventsSince(apSuite, lastEventNumber) == 1);
+
+    // Numbering goes on after the restored events.
+    NL_TEST_ASSERT(apSuite, log.LogEvent(apSuite, 0) == lastEventNumber + 1);
+}
+
+void CheckCrashKeepsSyncedEvents(nlTestSuite * apSuite, void * apContext)
+{
+    TestEventFile file;
+    TestEventFile crashedFile;
+    chip::EventNumber firstEventNumber = 0;
+    uint8_t contents[8192];
+    ssize_t length = 0;
+    int fd         = -1;
+
+    {
+        TestEventLog log(apSuite, file.GetPath(), 4096);
+        for (int32_t i = 0; i < CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL + 4; i++)
+        {
+            chip::EventNumber eventNumber = log.LogEvent(apSuite, i);
+            if (i == 0)
+            {
+                firstEventNumber = eventNumber;
+            }
+        }
+
+        // What a crash leaves of the file: whatever made it there, without a last sync.
+        fd = open(file.GetPath(), O_RDONLY);
+        NL_TEST_ASSERT(apSuite, fd >= 0);
+        length = read(fd, contents, sizeof(contents));
+        close(fd);
+
+        fd = open(crashedFile.GetPath(), O_WRONLY);
+        NL_TEST_ASSERT(apSuite, fd >= 0);
+        NL_TEST_ASSERT(apSuite, length > 0 && write(fd, contents, static_cast<size_t>(length)) == length);
+        close(fd);
+    }
+
+    // Events logged since the last sync are lost, the others are intact.
+    TestEventLog log(apSuite, crashedFile.GetPath(), 4096);
+    NL_TEST_ASSERT(apSuite, log.CountEvents(apSuite) == CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL);
+    NL_TEST_ASSERT(apSuite,
+                   log.GetLogMgmt().GetLastEventNumber(chip::app::PriorityLevel::Critical) ==
+                       firstEventNumber + CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL - 1);
+}
+
+void CheckRestoreSeveralPriorities(nlTestSuite * apSuite, void * apContext)
+{
+    static const chip::app::PriorityLevel kPriorities[] = { chip::app::PriorityLevel::Debug, chip::app::PriorityLevel::Info,
+                                                            chip::app::PriorityLevel::Critical };
+    TestEventFile debugFile;
+    TestEventFile infoFile;
+    TestEventFile criticalFile;
+    const char * const paths[] = { debugFile.GetPath(), infoFile.GetPath(), criticalFile.GetPath() };
+    chip::EventNumber firstEventNumbers[3];
+    chip::EventNumber lastEventNumbers[3];
+    size_t numEvents = 0;
+
+    {
+        // Enough events of every priority for some to move on to the buffers of higher priority, and some to be dropped.
+        TestPriorityEventLog log(apSuite, paths, 256);
+        for (int32_t i = 0; i < 60; i++)
+        {
+            log.LogEvent(apSuite, kPriorities[i % 3], i);
+        }
+        for (size_t i = 0; i < 3; i++)
+        {
+            firstEventNumbers[i] = log.GetLogMgmt().GetFirstEventNumber(kPriorities[i]);
+            lastEventNumbers[i]  = log.GetLogMgmt().GetLastEventNumber(kPriorities[i]);
+        }
+        numEvents = log.CountEvents(apSuite);
+        NL_TEST_ASSERT(apSuite, numEvents > 0 && numEvents < 60);
+    }
+
+    // Every buffer comes back as it was, and numbering goes on for every priority.
+    TestPriorityEventLog log(apSuite, paths, 256);
+    NL_TEST_ASSERT(apSuite, log.CountEvents(apSuite) == numEvents);
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(apSuite, log.GetLogMgmt().GetFirstEventNumber(kPriorities[i]) == firstEventNumbers[i]);
+        NL_TEST_ASSERT(apSuite, log.GetLogMgmt().GetLastEventNumber(kPriorities[i]) == lastEventNumbers[i]);
+    }
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(apSuite, log.LogEvent(apSuite, kPriorities[i], 0) == lastEventNumbers[i] + 1);
+    }
+}
+
+void CheckEventsInMemoryAreLost(nlTestSuite * apSuite, void * apContext)
+{
+    TestEventFile criticalFile;
+    const char * const paths[] = { nullptr, nullptr, criticalFile.GetPath() };
+    chip::EventNumber lastEventNumber = 0;
+
+    {
+        // Too few events for any to leave the debug buffer, which is in memory
+        TestPriorityEventLog log(apSuite, paths, 256);
+        for (int32_t i = 0; i < 3; i++)
+        {
+            lastEventNumber = log.LogEvent(apSuite, chip::app::PriorityLevel::Critical, i);
+        }
+        NL_TEST_ASSERT(apSuite, log.CountEvents(apSuite) == 3);
+    }
+
+    // The critical events are gone with the debug buffer, but their numbers are not handed out again.
+    TestPriorityEventLog log(apSuite, paths, 256);
+    NL_TEST_ASSERT(apSuite, log.CountEvents(apSuite) == 0);
+    NL_TEST_ASSERT(apSuite, log.LogEvent(apSuite, chip::app::PriorityLevel::Critical, 0) == lastEventNumber + 1);
+}
+
+void CheckCorruptedEventsStartOver(nlTestSuite * apSuite, void * apContext)
+{
+    TestEventFile file;
+    uint8_t garbage[256];
+    int fd = -1;
+
+    {
+        TestEventLog log(apSuite, file.GetPath(), 256);
+        for (int32_t i = 0; i < 50; i++)
+        {
+            log.LogEvent(apSuite, i);
+        }
+    }
+
+    // Overwrite the events, which leaves no state slot whose events are intact.
+    memset(garbage, 0xA5, sizeof(garbage));
+    fd = open(file.GetPath(), O_WRONLY);
+    NL_TEST_ASSERT(apSuite, fd >= 0);
+    NL_TEST_ASSERT(apSuite, pwrite(fd, garbage, sizeof(garbage), sysconf(_SC_PAGESIZE)) == static_cast<ssize_t>(sizeof(garbage)));
+    close(fd);
+
+    TestEventLog log(apSuite, file.GetPath(), 256);
+    NL_TEST_ASSERT(apSuite, log.CountEvents(apSuite) == 0);
+    NL_TEST_ASSERT(apSuite, log.LogEvent(apSuite, 0) != 0);
+    NL_TEST_ASSERT(apSuite, log.CountEvents(apSuite) == 1);
+}
+
+int TestSetup(void * inContext)
+{
+    return (chip::Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("CheckRestoreAfterRestart", CheckRestoreAfterRestart),
+    NL_TEST_DEF("CheckCrashKeepsSyncedEvents", CheckCrashKeepsSyncedEvents),
+    NL_TEST_DEF("CheckRestoreSeveralPriorities", CheckRestoreSeveralPriorities),
+    NL_TEST_DEF("CheckEventsInMemoryAreLost", CheckEventsInMemoryAreLost),
+    NL_TEST_DEF("CheckCorruptedEventsStartOver", CheckCorruptedEventsStartOver),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+} // namespace
+
+int TestPersistentEventStorage()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "PersistentEventStorage",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPersistentEventStorage)
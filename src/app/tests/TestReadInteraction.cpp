@@ -42,6 +42,8 @@
 
 #include <nlunit-test.h>
 
+#include <algorithm>
+
 namespace chip {
 System::Layer gSystemLayer;
 SecureSessionMgr gSessionManager;
@@ -49,16 +51,55 @@ Messaging::ExchangeManager gExchangeManager;
 TransportMgr<Transport::UDP> gTransportManager;
 const Transport::AdminId gAdminId = 0;
 secure_channel::MessageCounterManager gMessageCounterManager;
+constexpr size_t kNumConcurrentReaders = 32;
+constexpr EndpointId kTestEndpointId   = 1;
 
 namespace app {
+// Number of reports each reader got, indexed by the cluster the reader asked for
+static size_t gReportsPerReader[kNumConcurrentReaders];
+// Field last encoded for each cluster
+static FieldId gLastFieldPerReader[kNumConcurrentReaders];
+// Size of the value encoded for each attribute
+static size_t gAttributeValueSize;
+
+CHIP_ERROR ReadSingleClusterData(ClusterInfo & aClusterInfo, TLV::TLVWriter & aWriter)
+{
+    static uint8_t value[2 * kMaxSecureSduLengthBytes];
+
+    VerifyOrReturnError(aClusterInfo.mClusterId < kNumConcurrentReaders, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(gAttributeValueSize <= sizeof(value), CHIP_ERROR_INVALID_ARGUMENT);
+    if (gAttributeValueSize > 0)
+    {
+        ReturnErrorOnFailure(aWriter.PutBytes(TLV::ContextTag(0), value, static_cast<uint32_t>(gAttributeValueSize)));
+    }
+    gReportsPerReader[aClusterInfo.mClusterId]++;
+    gLastFieldPerReader[aClusterInfo.mClusterId] = aClusterInfo.mFieldId;
+    return CHIP_NO_ERROR;
+}
+
 class TestReadInteraction
 {
 public:
     static void TestReadClient(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandler(nlTestSuite * apSuite, void * apContext);
+    static void TestReadClientPool(nlTestSuite * apSuite, void * apContext);
+    static void TestConcurrentReaders(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscribeDirtySet(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscribeInvalidInterval(nlTestSuite * apSuite, void * apContext);
+    static void TestChunkedReport(nlTestSuite * apSuite, void * apContext);
+    static void TestChunkAcknowledgement(nlTestSuite * apSuite, void * apContext);
 
 private:
     static void GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload);
+    static void GenerateReadRequest(nlTestSuite * apSuite, ClusterId aClusterId, System::PacketBufferHandle & aPayload);
+    static void GenerateSubscribeRequest(nlTestSuite * apSuite, uint16_t aMinIntervalSeconds, uint16_t aMaxIntervalSeconds,
+                                         System::PacketBufferHandle & aPayload);
+    static void BuildReport(nlTestSuite * apSuite, ReadHandler * apReadHandler);
+    static void SetDirty(ClusterId aClusterId, FieldId aFieldId);
+    static void GenerateReadRequestForFields(nlTestSuite * apSuite, FieldId aNumFields, System::PacketBufferHandle & aPayload);
+    static bool BuildChunk(nlTestSuite * apSuite, ReadHandler * apReadHandler);
+    static void GenerateStatusResponse(nlTestSuite * apSuite, Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                       System::PacketBufferHandle & aPayload);
 };
 
 void TestReadInteraction::GenerateReportData(nlTestSuite * apSuite, void * apContext, System::PacketBufferHandle & aPayload)
@@ -85,12 +126,198 @@ void TestReadInteraction::GenerateReportData(nlTestSuite * apSuite, void * apCon
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 }
 
+void TestReadInteraction::GenerateReadRequest(nlTestSuite * apSuite, ClusterId aClusterId, System::PacketBufferHandle & aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    ReadRequest::Builder readRequestBuilder;
+    AttributePathList::Builder attributePathListBuilder;
+    AttributePath::Builder attributePathBuilder;
+
+    writer.Init(std::move(aPayload));
+    err = readRequestBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    attributePathListBuilder = readRequestBuilder.CreateAttributePathListBuilder();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
+    NL_TEST_ASSERT(apSuite, attributePathListBuilder.GetError() == CHIP_NO_ERROR);
+    attributePathBuilder =
+        attributePathBuilder.NodeId(1).EndpointId(kTestEndpointId).ClusterId(aClusterId).FieldId(0).EndOfAttributePath();
+    NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+    attributePathListBuilder.EndOfAttributePathList();
+    NL_TEST_ASSERT(apSuite, attributePathListBuilder.GetError() == CHIP_NO_ERROR);
+
+    readRequestBuilder.EndOfReadRequest();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&aPayload);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+void TestReadInteraction::GenerateSubscribeRequest(nlTestSuite * apSuite, uint16_t aMinIntervalSeconds,
+                                                   uint16_t aMaxIntervalSeconds, System::PacketBufferHandle & aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    SubscribeRequest::Builder subscribeRequestBuilder;
+    AttributePathList::Builder attributePathListBuilder;
+    AttributePath::Builder attributePathBuilder;
+
+    writer.Init(std::move(aPayload));
+    err = subscribeRequestBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    attributePathListBuilder = subscribeRequestBuilder.CreateAttributePathListBuilder();
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    // The whole of cluster 0, and field 3 of cluster 1
+    attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
+    attributePathBuilder = attributePathBuilder.NodeId(1).EndpointId(kTestEndpointId).ClusterId(0).FieldId(0).EndOfAttributePath();
+    NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+    attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
+    attributePathBuilder = attributePathBuilder.NodeId(1).EndpointId(kTestEndpointId).ClusterId(1).FieldId(3).EndOfAttributePath();
+    NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+    attributePathListBuilder.EndOfAttributePathList();
+    NL_TEST_ASSERT(apSuite, attributePathListBuilder.GetError() == CHIP_NO_ERROR);
+
+    subscribeRequestBuilder.MinIntervalSeconds(aMinIntervalSeconds).MaxIntervalSeconds(aMaxIntervalSeconds).EndOfSubscribeRequest();
+    NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&aPayload);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+void TestReadInteraction::BuildReport(nlTestSuite * apSuite, ReadHandler * apReadHandler)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    ReportData::Builder reportDataBuilder;
+
+    writer.Init(System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize));
+    err = reportDataBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = InteractionModelEngine::GetInstance()->GetReportingEngine().BuildSingleReportDataAttributeDataList(reportDataBuilder,
+                                                                                                             apReadHandler);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // Pretend the report went out
+    apReadHandler->mIsPrimingReports = false;
+    apReadHandler->mDirty            = false;
+    apReadHandler->MoveToState(ReadHandler::HandlerState::Subscribed);
+    err = apReadHandler->RefreshSubscribeSyncTimer();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+void TestReadInteraction::SetDirty(ClusterId aClusterId, FieldId aFieldId)
+{
+    ClusterInfo changedPath;
+
+    changedPath.mEndpointId = kTestEndpointId;
+    changedPath.mClusterId  = aClusterId;
+    changedPath.mFieldId    = aFieldId;
+    changedPath.mType       = ClusterInfo::Type::kFieldIdValid;
+    InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(changedPath);
+}
+
+void TestReadInteraction::GenerateReadRequestForFields(nlTestSuite * apSuite, FieldId aNumFields,
+                                                       System::PacketBufferHandle & aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    ReadRequest::Builder readRequestBuilder;
+    AttributePathList::Builder attributePathListBuilder;
+    AttributePath::Builder attributePathBuilder;
+
+    writer.Init(std::move(aPayload));
+    err = readRequestBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    attributePathListBuilder = readRequestBuilder.CreateAttributePathListBuilder();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    // Fields 1 to aNumFields of cluster 0
+    for (FieldId fieldId = 1; fieldId <= aNumFields; fieldId++)
+    {
+        attributePathBuilder = attributePathListBuilder.CreateAttributePathBuilder();
+        attributePathBuilder =
+            attributePathBuilder.NodeId(1).EndpointId(kTestEndpointId).ClusterId(0).FieldId(fieldId).EndOfAttributePath();
+        NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+    }
+    attributePathListBuilder.EndOfAttributePathList();
+    NL_TEST_ASSERT(apSuite, attributePathListBuilder.GetError() == CHIP_NO_ERROR);
+
+    readRequestBuilder.EndOfReadRequest();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&aPayload);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+bool TestReadInteraction::BuildChunk(nlTestSuite * apSuite, ReadHandler * apReadHandler)
+{
+    CHIP_ERROR err             = CHIP_NO_ERROR;
+    reporting::Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    System::PacketBufferTLVWriter writer;
+    ReportData::Builder reportDataBuilder;
+    System::PacketBufferHandle buf;
+
+    // Same layout as Engine::BuildAndSendSingleReportData
+    engine.mMoreChunkedMessages = false;
+    writer.Init(System::PacketBufferHandle::New(kMaxSecureSduLengthBytes));
+    err = writer.ReserveBuffer(reporting::Engine::kReservedSizeForMoreChunksFlag);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = reportDataBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = engine.BuildSingleReportDataAttributeDataList(reportDataBuilder, apReadHandler);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = writer.UnreserveBuffer(reporting::Engine::kReservedSizeForMoreChunksFlag);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    if (engine.mMoreChunkedMessages)
+    {
+        reportDataBuilder.MoreChunkedMessages(true);
+    }
+    reportDataBuilder.EndOfReportData();
+    NL_TEST_ASSERT(apSuite, reportDataBuilder.GetError() == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&buf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, buf->DataLength() <= kMaxSecureSduLengthBytes);
+
+    return engine.mMoreChunkedMessages;
+}
+
+void TestReadInteraction::GenerateStatusResponse(nlTestSuite * apSuite, Protocols::SecureChannel::GeneralStatusCode aGeneralCode,
+                                                 System::PacketBufferHandle & aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    StatusElement::Builder statusElementBuilder;
+
+    writer.Init(std::move(aPayload));
+    err = statusElementBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    statusElementBuilder
+        .EncodeStatusElement(aGeneralCode, Protocols::InteractionModel::Id.ToFullyQualifiedSpecForm(),
+                             Protocols::SecureChannel::kProtocolCodeSuccess)
+        .EndOfStatusElement();
+    NL_TEST_ASSERT(apSuite, statusElementBuilder.GetError() == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&aPayload);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
 void TestReadInteraction::TestReadClient(nlTestSuite * apSuite, void * apContext)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     app::ReadClient readClient;
-    EventNumber eventNumber = 0;
+    EventNumber eventNumber  = 0;
+    bool moreChunkedMessages = true;
 
     System::PacketBufferHandle buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
     err                            = readClient.Init(&gExchangeManager, nullptr);
@@ -103,8 +330,8 @@ void TestReadInteraction::TestReadClient(nlTestSuite * apSuite, void * apContext
 
     GenerateReportData(apSuite, apContext, buf);
 
-    err = readClient.ProcessReportData(std::move(buf));
-    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    err = readClient.ProcessReportData(std::move(buf), moreChunkedMessages);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && !moreChunkedMessages);
 
     readClient.Shutdown();
 }
@@ -140,6 +367,306 @@ void TestReadInteraction::TestReadHandler(nlTestSuite * apSuite, void * apContex
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 }
 
+void TestReadInteraction::TestReadClientPool(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    ReadClient * readClients[CHIP_IM_MAX_NUM_READ_CLIENT];
+    ReadClient * readClient = nullptr;
+
+    err = engine->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    for (auto & client : readClients)
+    {
+        err = engine->NewReadClient(&client);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && client != nullptr);
+    }
+
+    err = engine->NewReadClient(&readClient);
+    NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_NO_MEMORY && readClient == nullptr);
+
+    // Shutting a client down gives its slot to the next one
+    readClients[0]->Shutdown();
+    err = engine->NewReadClient(&readClient);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR && readClient != nullptr);
+
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, engine->mReadClients.Allocated() == 0);
+}
+
+void TestReadInteraction::TestConcurrentReaders(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    PacketHeader packetHeader;
+    PayloadHeader payloadHeader;
+    size_t numRequested = 0;
+
+    err = engine->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    memset(gReportsPerReader, 0, sizeof(gReportsPerReader));
+
+    // Readers come in as fast as the pool takes them; each round, every reader with a handler gets its report before anyone
+    // new is let in. Without a connection the handlers can't actually send, so they are released as soon as they are served.
+    while (numRequested < kNumConcurrentReaders)
+    {
+        size_t numAccepted = 0;
+        size_t numExpected = std::min<size_t>(kNumConcurrentReaders - numRequested, CHIP_IM_MAX_NUM_READ_HANDLER);
+
+        while (numRequested < kNumConcurrentReaders)
+        {
+            System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+            GenerateReadRequest(apSuite, static_cast<ClusterId>(numRequested), readRequestbuf);
+
+            size_t allocated = engine->mReadHandlers.Allocated();
+            engine->OnReadRequest(nullptr, packetHeader, payloadHeader, std::move(readRequestbuf),
+                                  ReadHandler::InteractionType::Read);
+            if (engine->mReadHandlers.Allocated() == allocated)
+            {
+                // Rejected: the pool is full, this reader tries again next round
+                NL_TEST_ASSERT(apSuite, allocated == CHIP_IM_MAX_NUM_READ_HANDLER);
+                break;
+            }
+
+            numAccepted++;
+            numRequested++;
+        }
+
+        NL_TEST_ASSERT(apSuite, numAccepted == numExpected);
+        if (numAccepted == 0)
+        {
+            break;
+        }
+
+        engine->GetReportingEngine().Run();
+
+        NL_TEST_ASSERT(apSuite, engine->mReadHandlers.Allocated() == 0);
+        for (size_t reader = 0; reader < kNumConcurrentReaders; reader++)
+        {
+            NL_TEST_ASSERT(apSuite, gReportsPerReader[reader] == ((reader < numRequested) ? 1u : 0u));
+        }
+    }
+
+    engine->Shutdown();
+}
+
+void TestReadInteraction::TestSubscribeDirtySet(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    PacketHeader packetHeader;
+    PayloadHeader payloadHeader;
+    ClusterInfo changedPath;
+    ReadHandler * readHandler                      = nullptr;
+    size_t numDirtyFields                          = 0;
+    System::PacketBufferHandle subscribeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+
+    err = engine->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    memset(gReportsPerReader, 0, sizeof(gReportsPerReader));
+
+    GenerateSubscribeRequest(apSuite, 1, 60, subscribeRequestbuf);
+    engine->OnReadRequest(nullptr, packetHeader, payloadHeader, std::move(subscribeRequestbuf),
+                          ReadHandler::InteractionType::Subscribe);
+    readHandler = engine->NextReportableHandler(nullptr);
+    NL_TEST_ASSERT(apSuite, readHandler != nullptr && readHandler->IsSubscriptionType());
+    NL_TEST_ASSERT(apSuite, readHandler->mMinIntervalFloorSeconds == 1 && readHandler->mMaxIntervalCeilingSeconds == 60);
+
+    // The first report covers the whole interest set
+    BuildReport(apSuite, readHandler);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[0] == 1 && gLastFieldPerReader[0] == kRootFieldId);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[1] == 1 && gLastFieldPerReader[1] == 3);
+
+    // Changes within the min interval are held back, and repeated changes to a field are kept once
+    SetDirty(0, 5);
+    SetDirty(0, 5);
+    SetDirty(1, 3);
+    SetDirty(0, 5);
+    SetDirty(1, 4);
+    SetDirty(2, 1);
+    NL_TEST_ASSERT(apSuite, !readHandler->IsReportable());
+    for (ClusterInfo * field = readHandler->GetDirtyClusterInfoList(); field != nullptr; field = field->mpNext)
+    {
+        numDirtyFields++;
+    }
+    NL_TEST_ASSERT(apSuite, numDirtyFields == 1);
+
+    // Once the min interval has passed, one report re-encodes just the fields that changed
+    ReadHandler::OnMinIntervalTimerExpired(nullptr, readHandler, CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, readHandler->IsReportable());
+    BuildReport(apSuite, readHandler);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[0] == 2 && gLastFieldPerReader[0] == 5);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[1] == 2 && gLastFieldPerReader[1] == 3);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[2] == 0);
+    NL_TEST_ASSERT(apSuite, readHandler->GetDirtyClusterInfoList() == nullptr);
+
+    // A change to the whole cluster supersedes the changes to its fields
+    ReadHandler::OnMinIntervalTimerExpired(nullptr, readHandler, CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !readHandler->IsReportable());
+    SetDirty(0, 5);
+    NL_TEST_ASSERT(apSuite, readHandler->IsReportable());
+    SetDirty(0, kRootFieldId);
+    BuildReport(apSuite, readHandler);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[0] == 3 && gLastFieldPerReader[0] == kRootFieldId);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[1] == 2);
+
+    // The max interval brings a report even when nothing changed
+    ReadHandler::OnMaxIntervalTimerExpired(nullptr, readHandler, CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, readHandler->IsReportable());
+    BuildReport(apSuite, readHandler);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[0] == 3 && gReportsPerReader[1] == 2);
+
+    // A change without a field id, such as one to an attribute whose id does not fit, covers every field of its cluster
+    ReadHandler::OnMinIntervalTimerExpired(nullptr, readHandler, CHIP_SYSTEM_NO_ERROR);
+    changedPath.mEndpointId = kTestEndpointId;
+    changedPath.mClusterId  = 1;
+    changedPath.mFieldId    = 4;
+    engine->GetReportingEngine().SetDirty(changedPath);
+    NL_TEST_ASSERT(apSuite, readHandler->IsReportable());
+    BuildReport(apSuite, readHandler);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[0] == 3);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[1] == 3 && gLastFieldPerReader[1] == 3);
+
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, engine->mReadHandlers.Allocated() == 0);
+}
+
+void TestReadInteraction::TestSubscribeInvalidInterval(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    PacketHeader packetHeader;
+    PayloadHeader payloadHeader;
+
+    err = engine->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // A zero max interval is rejected, and so is a min interval above the max interval
+    static const uint16_t kInvalidIntervals[][2] = { { 0, 0 }, { 2, 1 } };
+    for (const auto & interval : kInvalidIntervals)
+    {
+        ReadHandler readHandler;
+        System::PacketBufferHandle subscribeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+
+        GenerateSubscribeRequest(apSuite, interval[0], interval[1], subscribeRequestbuf);
+        readHandler.Init(&delegate);
+        err = readHandler.OnSubscribeRequest(nullptr, std::move(subscribeRequestbuf));
+        NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+        NL_TEST_ASSERT(apSuite, readHandler.IsFree());
+
+        subscribeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+        GenerateSubscribeRequest(apSuite, interval[0], interval[1], subscribeRequestbuf);
+        engine->OnReadRequest(nullptr, packetHeader, payloadHeader, std::move(subscribeRequestbuf),
+                              ReadHandler::InteractionType::Subscribe);
+        NL_TEST_ASSERT(apSuite, engine->mReadHandlers.Allocated() == 0);
+    }
+
+    engine->Shutdown();
+}
+
+void TestReadInteraction::TestChunkedReport(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    PacketHeader packetHeader;
+    PayloadHeader payloadHeader;
+    ReadHandler * readHandler                 = nullptr;
+    size_t numChunks                          = 0;
+    constexpr FieldId kNumFields              = 16;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+
+    err = engine->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    memset(gReportsPerReader, 0, sizeof(gReportsPerReader));
+
+    GenerateReadRequestForFields(apSuite, kNumFields, readRequestbuf);
+    engine->OnReadRequest(nullptr, packetHeader, payloadHeader, std::move(readRequestbuf), ReadHandler::InteractionType::Read);
+    readHandler = engine->NextReportableHandler(nullptr);
+    NL_TEST_ASSERT(apSuite, readHandler != nullptr);
+
+    // Attributes of a quarter of a message each: the report takes several chunks, each attribute in exactly one of them
+    gAttributeValueSize = kMaxSecureSduLengthBytes / 4;
+    while (BuildChunk(apSuite, readHandler))
+    {
+        numChunks++;
+        NL_TEST_ASSERT(apSuite, numChunks < kNumFields);
+    }
+    numChunks++;
+    NL_TEST_ASSERT(apSuite, numChunks > 1);
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[0] == kNumFields);
+
+    // An attribute that fits in no message is left out rather than holding the report back forever
+    readHandler->GetAttributeClusterInfolist()->SetDirty();
+    gAttributeValueSize = 2 * kMaxSecureSduLengthBytes;
+    NL_TEST_ASSERT(apSuite, !BuildChunk(apSuite, readHandler));
+    NL_TEST_ASSERT(apSuite, !readHandler->GetAttributeClusterInfolist()->IsDirty());
+    NL_TEST_ASSERT(apSuite, gReportsPerReader[0] == kNumFields);
+
+    gAttributeValueSize = 0;
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, engine->mReadHandlers.Allocated() == 0);
+}
+
+void TestReadInteraction::TestChunkAcknowledgement(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    PacketHeader packetHeader;
+    PayloadHeader payloadHeader;
+    ReadHandler * readHandler                 = nullptr;
+    ReadHandler * otherReadHandler            = nullptr;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    System::PacketBufferHandle statusBuf;
+
+    err = engine->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    GenerateReadRequestForFields(apSuite, 1, readRequestbuf);
+    engine->OnReadRequest(nullptr, packetHeader, payloadHeader, std::move(readRequestbuf), ReadHandler::InteractionType::Read);
+    readHandler = engine->NextReportableHandler(nullptr);
+    NL_TEST_ASSERT(apSuite, readHandler != nullptr);
+
+    // A chunk has gone out, the next one waits for the reader to take it. Until then the chunk holds the in-flight slot, and
+    // the other readers wait for it.
+    readHandler->MoveToState(ReadHandler::HandlerState::AwaitingReportResponse);
+    engine->GetReportingEngine().mNumReportsInFlight = CHIP_IM_MAX_REPORTS_IN_FLIGHT;
+    NL_TEST_ASSERT(apSuite, engine->NextReportableHandler(nullptr) == nullptr);
+    readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateReadRequestForFields(apSuite, 1, readRequestbuf);
+    engine->OnReadRequest(nullptr, packetHeader, payloadHeader, std::move(readRequestbuf), ReadHandler::InteractionType::Read);
+    otherReadHandler = engine->NextReportableHandler(nullptr);
+    NL_TEST_ASSERT(apSuite, otherReadHandler != nullptr && otherReadHandler != readHandler);
+    engine->GetReportingEngine().Run();
+    NL_TEST_ASSERT(apSuite, otherReadHandler->IsReportable());
+    otherReadHandler->Shutdown();
+
+    // The acknowledgement releases the slot
+    payloadHeader.SetMessageType(Protocols::InteractionModel::MsgType::StatusResponse);
+    statusBuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateStatusResponse(apSuite, Protocols::SecureChannel::GeneralStatusCode::kSuccess, statusBuf);
+    readHandler->OnMessageReceived(nullptr, packetHeader, payloadHeader, std::move(statusBuf));
+    NL_TEST_ASSERT(apSuite, readHandler->IsReportable());
+    NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mNumReportsInFlight == CHIP_IM_MAX_REPORTS_IN_FLIGHT - 1);
+
+    // A reader that turns a chunk down ends the read, which releases the slot too
+    readHandler->MoveToState(ReadHandler::HandlerState::AwaitingReportResponse);
+    engine->GetReportingEngine().mNumReportsInFlight = CHIP_IM_MAX_REPORTS_IN_FLIGHT;
+    statusBuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateStatusResponse(apSuite, Protocols::SecureChannel::GeneralStatusCode::kFailure, statusBuf);
+    readHandler->OnMessageReceived(nullptr, packetHeader, payloadHeader, std::move(statusBuf));
+    NL_TEST_ASSERT(apSuite, engine->mReadHandlers.Allocated() == 0);
+    NL_TEST_ASSERT(apSuite, engine->GetReportingEngine().mNumReportsInFlight == CHIP_IM_MAX_REPORTS_IN_FLIGHT - 1);
+
+    engine->Shutdown();
+}
+
 } // namespace app
 } // namespace chip
 
@@ -179,6 +706,12 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("CheckReadClient", chip::app::TestReadInteraction::TestReadClient),
     NL_TEST_DEF("CheckReadHandler", chip::app::TestReadInteraction::TestReadHandler),
+    NL_TEST_DEF("CheckReadClientPool", chip::app::TestReadInteraction::TestReadClientPool),
+    NL_TEST_DEF("CheckConcurrentReaders", chip::app::TestReadInteraction::TestConcurrentReaders),
+    NL_TEST_DEF("CheckSubscribeDirtySet", chip::app::TestReadInteraction::TestSubscribeDirtySet),
+    NL_TEST_DEF("CheckSubscribeInvalidInterval", chip::app::TestReadInteraction::TestSubscribeInvalidInterval),
+    NL_TEST_DEF("CheckChunkedReport", chip::app::TestReadInteraction::TestChunkedReport),
+    NL_TEST_DEF("CheckChunkAcknowledgement", chip::app::TestReadInteraction::TestChunkAcknowledgement),
     NL_TEST_SENTINEL()
 };
 // clang-format on
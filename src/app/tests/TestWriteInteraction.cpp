@@ -0,0 +1,364 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for CHIP Interaction Model Write Interaction
+ *
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <core/CHIPCore.h>
+#include <core/CHIPTLV.h>
+#include <core/CHIPTLVDebug.hpp>
+#include <core/CHIPTLVUtilities.hpp>
+#include <messaging/ExchangeContext.h>
+#include <messaging/ExchangeMgr.h>
+#include <messaging/Flags.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <protocols/secure_channel/MessageCounterManager.h>
+#include <protocols/secure_channel/PASESession.h>
+#include <support/ErrorStr.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemPacketBuffer.h>
+#include <system/TLVPacketBufferBackingStore.h>
+#include <transport/SecureSessionMgr.h>
+#include <transport/raw/UDP.h>
+
+#include <nlunit-test.h>
+
+namespace chip {
+System::Layer gSystemLayer;
+SecureSessionMgr gSessionManager;
+Messaging::ExchangeManager gExchangeManager;
+TransportMgr<Transport::UDP> gTransportManager;
+const Transport::AdminId gAdminId = 0;
+secure_channel::MessageCounterManager gMessageCounterManager;
+constexpr EndpointId kTestEndpointId = 1;
+constexpr ClusterId kTestClusterId   = 6;
+
+namespace app {
+// Number of attributes written to the test cluster
+static size_t gNumWrites;
+// Field whose write fails, kRootFieldId if none does
+static FieldId gFailingFieldId;
+
+CHIP_ERROR WriteSingleClusterData(ClusterInfo & aClusterInfo, TLV::TLVReader & aReader)
+{
+    uint32_t value = 0;
+
+    VerifyOrReturnError(aClusterInfo.mEndpointId == kTestEndpointId && aClusterInfo.mClusterId == kTestClusterId,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aClusterInfo.mFieldId != gFailingFieldId, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(aReader.Get(value));
+    VerifyOrReturnError(value == aClusterInfo.mFieldId, CHIP_ERROR_INVALID_ARGUMENT);
+    gNumWrites++;
+    return CHIP_NO_ERROR;
+}
+
+class TestWriteInteraction
+{
+public:
+    static void TestWriteHandler(nlTestSuite * apSuite, void * apContext);
+    static void TestWriteResponseBounds(nlTestSuite * apSuite, void * apContext);
+
+private:
+    static void GenerateWriteRequest(nlTestSuite * apSuite, FieldId aNumFields, System::PacketBufferHandle & aPayload);
+    static size_t CountStatuses(nlTestSuite * apSuite, System::PacketBufferHandle && aPayload, FieldId aFailedFieldId);
+};
+
+void TestWriteInteraction::GenerateWriteRequest(nlTestSuite * apSuite, FieldId aNumFields, System::PacketBufferHandle & aPayload)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    WriteRequest::Builder writeRequestBuilder;
+
+    // A request this large spans a chain of buffers, as it would once reassembled from a stream transport
+    writer.Init(std::move(aPayload), true /* useChainedBuffers */);
+
+    err = writeRequestBuilder.Init(&writer);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    AttributeDataList::Builder attributeDataListBuilder = writeRequestBuilder.CreateAttributeDataListBuilder();
+    NL_TEST_ASSERT(apSuite, attributeDataListBuilder.GetError() == CHIP_NO_ERROR);
+
+    for (FieldId fieldId = 1; fieldId <= aNumFields; fieldId++)
+    {
+        AttributeDataElement::Builder attributeDataElementBuilder = attributeDataListBuilder.CreateAttributeDataElementBuilder();
+        NL_TEST_ASSERT(apSuite, attributeDataListBuilder.GetError() == CHIP_NO_ERROR);
+
+        AttributePath::Builder attributePathBuilder = attributeDataElementBuilder.CreateAttributePathBuilder();
+        NL_TEST_ASSERT(apSuite, attributeDataElementBuilder.GetError() == CHIP_NO_ERROR);
+        attributePathBuilder.NodeId(1).EndpointId(kTestEndpointId).ClusterId(kTestClusterId).FieldId(fieldId).EndOfAttributePath();
+        NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+
+        attributeDataElementBuilder.DataVersion(0);
+        NL_TEST_ASSERT(apSuite, attributeDataElementBuilder.GetError() == CHIP_NO_ERROR);
+
+        err = attributeDataElementBuilder.GetWriter()->Put(TLV::ContextTag(AttributeDataElement::kCsTag_Data),
+                                                           static_cast<uint32_t>(fieldId));
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        attributeDataElementBuilder.EndOfAttributeDataElement();
+        NL_TEST_ASSERT(apSuite, attributeDataElementBuilder.GetError() == CHIP_NO_ERROR);
+    }
+
+    attributeDataListBuilder.EndOfAttributeDataList();
+    NL_TEST_ASSERT(apSuite, attributeDataListBuilder.GetError() == CHIP_NO_ERROR);
+
+    writeRequestBuilder.EndOfWriteRequest();
+    NL_TEST_ASSERT(apSuite, writeRequestBuilder.GetError() == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&aPayload);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+size_t TestWriteInteraction::CountStatuses(nlTestSuite * apSuite, System::PacketBufferHandle && aPayload, FieldId aFailedFieldId)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVReader reader;
+    TLV::TLVReader attributeStatusListReader;
+    WriteResponse::Parser writeResponseParser;
+    AttributeStatusList::Parser attributeStatusListParser;
+    size_t numStatuses = 0;
+
+    reader.Init(std::move(aPayload), true /* useChainedBuffers */);
+    err = reader.Next();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = writeResponseParser.Init(reader);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+#if CHIP_CONFIG_IM_ENABLE_SCHEMA_CHECK
+    err = writeResponseParser.CheckSchemaValidity();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+#endif
+
+    err = writeResponseParser.GetAttributeStatusList(&attributeStatusListParser);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    attributeStatusListParser.GetReader(&attributeStatusListReader);
+    while (CHIP_NO_ERROR == (err = attributeStatusListReader.Next()))
+    {
+        AttributeStatusElement::Parser attributeStatusElementParser;
+        AttributePath::Parser attributePathParser;
+        StatusElement::Parser statusElementParser;
+        Protocols::SecureChannel::GeneralStatusCode generalCode  = Protocols::SecureChannel::GeneralStatusCode::kSuccess;
+        Protocols::SecureChannel::GeneralStatusCode expectedCode = Protocols::SecureChannel::GeneralStatusCode::kSuccess;
+        uint32_t protocolId                                      = 0;
+        uint16_t protocolCode                                    = 0;
+        FieldId fieldId                                          = 0;
+
+        err = attributeStatusElementParser.Init(attributeStatusListReader);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        err = attributeStatusElementParser.GetAttributePath(&attributePathParser);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = attributePathParser.GetFieldId(&fieldId);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        // Statuses come in the order of the request
+        numStatuses++;
+        NL_TEST_ASSERT(apSuite, fieldId == numStatuses);
+
+        err = attributeStatusElementParser.GetStatusElement(&statusElementParser);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        err = statusElementParser.DecodeStatusElement(&generalCode, &protocolId, &protocolCode);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+        if (fieldId == aFailedFieldId)
+        {
+            expectedCode = Protocols::SecureChannel::GeneralStatusCode::kFailure;
+        }
+        NL_TEST_ASSERT(apSuite, generalCode == expectedCode);
+    }
+    NL_TEST_ASSERT(apSuite, err == CHIP_END_OF_TLV);
+
+    return numStatuses;
+}
+
+void TestWriteInteraction::TestWriteHandler(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    WriteHandler writeHandler;
+    System::PacketBufferHandle writeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    System::PacketBufferHandle writeResponsebuf;
+    constexpr FieldId kNumFields = 4;
+
+    gNumWrites      = 0;
+    gFailingFieldId = 2;
+
+    err = writeHandler.Init(&delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    GenerateWriteRequest(apSuite, kNumFields, writeRequestbuf);
+    err = writeHandler.ProcessWriteRequest(std::move(writeRequestbuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // A failed write still lets the others through, and is reported in its own status
+    NL_TEST_ASSERT(apSuite, gNumWrites == kNumFields - 1);
+    err = writeHandler.FinalizeMessage(writeResponsebuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, CountStatuses(apSuite, std::move(writeResponsebuf), gFailingFieldId) == kNumFields);
+
+    writeHandler.Shutdown();
+    NL_TEST_ASSERT(apSuite, writeHandler.IsFree());
+}
+
+void TestWriteInteraction::TestWriteResponseBounds(nlTestSuite * apSuite, void * apContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    InteractionModelDelegate delegate;
+    InteractionModelEngine * engine = InteractionModelEngine::GetInstance();
+    PacketHeader packetHeader;
+    PayloadHeader payloadHeader;
+    WriteHandler * writeHandler = nullptr;
+    System::PacketBufferHandle writeRequestbuf;
+    System::PacketBufferHandle writeResponsebuf;
+    constexpr FieldId kNumFields         = 20;
+    constexpr FieldId kNumFieldsTooLarge = 100;
+    constexpr size_t kNumRequests        = 2 * CHIP_IM_MAX_NUM_WRITE_HANDLER;
+
+    gFailingFieldId = kRootFieldId;
+
+    err = engine->Init(&gExchangeManager, &delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    // Every request is handed to a pooled handler that writes all of its attributes in one pass and releases itself
+    for (size_t request = 0; request < kNumRequests; request++)
+    {
+        gNumWrites      = 0;
+        writeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+        GenerateWriteRequest(apSuite, kNumFields, writeRequestbuf);
+        engine->OnWriteRequest(nullptr, packetHeader, payloadHeader, std::move(writeRequestbuf));
+        NL_TEST_ASSERT(apSuite, gNumWrites == kNumFields);
+        NL_TEST_ASSERT(apSuite, engine->mWriteHandlers.Allocated() == 0);
+    }
+
+    // All of the statuses go into a single response
+    gNumWrites   = 0;
+    writeHandler = engine->mWriteHandlers.CreateObject();
+    NL_TEST_ASSERT(apSuite, writeHandler != nullptr);
+    err = writeHandler->Init(&delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    writeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateWriteRequest(apSuite, kNumFields, writeRequestbuf);
+    err = writeHandler->ProcessWriteRequest(std::move(writeRequestbuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, gNumWrites == kNumFields);
+
+    err = writeHandler->FinalizeMessage(writeResponsebuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writeResponsebuf->DataLength() <= kMaxSecureSduLengthBytes);
+    NL_TEST_ASSERT(apSuite, CountStatuses(apSuite, std::move(writeResponsebuf), kRootFieldId) == kNumFields);
+
+    writeHandler->Shutdown();
+    NL_TEST_ASSERT(apSuite, engine->mWriteHandlers.Allocated() == 0);
+
+    // A request whose statuses would not fit into one response is turned down before anything is written
+    gNumWrites   = 0;
+    writeHandler = engine->mWriteHandlers.CreateObject();
+    NL_TEST_ASSERT(apSuite, writeHandler != nullptr);
+    err = writeHandler->Init(&delegate);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    writeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateWriteRequest(apSuite, kNumFieldsTooLarge, writeRequestbuf);
+    NL_TEST_ASSERT(apSuite, writeRequestbuf->HasChainedBuffer());
+    err = writeHandler->ProcessWriteRequest(std::move(writeRequestbuf));
+    NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(apSuite, gNumWrites == 0);
+
+    writeHandler->Shutdown();
+    NL_TEST_ASSERT(apSuite, engine->mWriteHandlers.Allocated() == 0);
+
+    writeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    GenerateWriteRequest(apSuite, kNumFieldsTooLarge, writeRequestbuf);
+    engine->OnWriteRequest(nullptr, packetHeader, payloadHeader, std::move(writeRequestbuf));
+    NL_TEST_ASSERT(apSuite, gNumWrites == 0);
+    NL_TEST_ASSERT(apSuite, engine->mWriteHandlers.Allocated() == 0);
+
+    engine->Shutdown();
+}
+
+} // namespace app
+} // namespace chip
+
+namespace {
+
+void InitializeChip(nlTestSuite * apSuite)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    chip::Optional<chip::Transport::PeerAddress> peer(chip::Transport::Type::kUndefined);
+    chip::Transport::AdminPairingTable admins;
+    chip::Transport::AdminPairingInfo * adminInfo = admins.AssignAdminId(chip::gAdminId, chip::kTestDeviceNodeId);
+
+    NL_TEST_ASSERT(apSuite, adminInfo != nullptr);
+
+    err = chip::Platform::MemoryInit();
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    chip::gSystemLayer.Init(nullptr);
+
+    err = chip::gSessionManager.Init(chip::kTestDeviceNodeId, &chip::gSystemLayer, &chip::gTransportManager, &admins,
+                                     &chip::gMessageCounterManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = chip::gExchangeManager.Init(&chip::gSessionManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    err = chip::gMessageCounterManager.Init(&chip::gExchangeManager);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("CheckWriteHandler", chip::app::TestWriteInteraction::TestWriteHandler),
+    NL_TEST_DEF("CheckWriteResponseBounds", chip::app::TestWriteInteraction::TestWriteResponseBounds),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestWriteInteraction()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+	{
+        "TestWriteInteraction",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    InitializeChip(&theSuite);
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestWriteInteraction)
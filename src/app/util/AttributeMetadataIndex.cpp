@@ -0,0 +1,222 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the attribute index used by attribute storage.
+ *
+ */
+
+#include <app/util/AttributeMetadataIndex.h>
+
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+constexpr uint32_t kEmptySlot = UINT32_MAX;
+
+inline uint64_t AttributeKey(const AttributeMetadataIndex::Attribute & a)
+{
+    return (static_cast<uint64_t>(a.endpoint) << 32) | (static_cast<uint64_t>(a.clusterId) << 16) | a.attributeId;
+}
+
+bool AttributeLess(const AttributeMetadataIndex::Attribute & a, const AttributeMetadataIndex::Attribute & b)
+{
+    return AttributeKey(a) < AttributeKey(b);
+}
+
+// Ties are broken by position so that lookups see entries in endpoint table order.
+bool AttributeOrder(const AttributeMetadataIndex::Attribute & a, const AttributeMetadataIndex::Attribute & b)
+{
+    if (AttributeLess(a, b))
+    {
+        return true;
+    }
+    if (AttributeLess(b, a))
+    {
+        return false;
+    }
+    if (a.endpointIndex != b.endpointIndex)
+    {
+        return a.endpointIndex < b.endpointIndex;
+    }
+    if (a.clusterIndex != b.clusterIndex)
+    {
+        return a.clusterIndex < b.clusterIndex;
+    }
+    return a.attributeIndex < b.attributeIndex;
+}
+
+inline uint64_t AttributeKey(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    return (static_cast<uint64_t>(endpoint) << 32) | (static_cast<uint64_t>(clusterId) << 16) | attributeId;
+}
+
+// Fibonacci hashing: the top bits of the product are well mixed even for the small, clustered ids of the endpoint table.
+inline size_t HashSlot(uint64_t key, uint8_t shift)
+{
+    return static_cast<size_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> shift);
+}
+
+bool EndpointOrder(const AttributeMetadataIndex::Endpoint & a, const AttributeMetadataIndex::Endpoint & b)
+{
+    return (a.endpoint != b.endpoint) ? a.endpoint < b.endpoint : a.endpointIndex < b.endpointIndex;
+}
+
+} // namespace
+
+CHIP_ERROR AttributeMetadataIndex::Init(size_t attributeCount, size_t endpointCount)
+{
+    Clear();
+
+    VerifyOrReturnError(attributeCount < kEmptySlot / 2, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Keep the hash table at most half full so that probe sequences stay short.
+    size_t slotCount = 2;
+    mSlotShift       = 63;
+    while (slotCount < 2 * attributeCount)
+    {
+        slotCount <<= 1;
+        mSlotShift--;
+    }
+
+    mAttributes = static_cast<Attribute *>(Platform::MemoryCalloc(attributeCount + 1, sizeof(Attribute)));
+    mSlots      = static_cast<uint32_t *>(Platform::MemoryCalloc(slotCount, sizeof(uint32_t)));
+    mEndpoints  = static_cast<Endpoint *>(Platform::MemoryCalloc(endpointCount + 1, sizeof(Endpoint)));
+    if (mAttributes == nullptr || mSlots == nullptr || mEndpoints == nullptr)
+    {
+        Clear();
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    mAttributeSize = attributeCount;
+    mSlotMask      = slotCount - 1;
+    mEndpointSize  = endpointCount;
+
+    return CHIP_NO_ERROR;
+}
+
+void AttributeMetadataIndex::Clear()
+{
+    Platform::MemoryFree(mAttributes);
+    Platform::MemoryFree(mSlots);
+    Platform::MemoryFree(mEndpoints);
+
+    mAttributes     = nullptr;
+    mSlots          = nullptr;
+    mEndpoints      = nullptr;
+    mAttributeCount = 0;
+    mAttributeSize  = 0;
+    mSlotMask       = 0;
+    mSlotShift      = 0;
+    mEndpointCount  = 0;
+    mEndpointSize   = 0;
+    mReady          = false;
+}
+
+CHIP_ERROR AttributeMetadataIndex::AddEndpoint(EndpointId endpoint, uint8_t endpointIndex)
+{
+    VerifyOrReturnError(!mReady, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mEndpointCount < mEndpointSize, CHIP_ERROR_NO_MEMORY);
+
+    mEndpoints[mEndpointCount].endpoint      = endpoint;
+    mEndpoints[mEndpointCount].endpointIndex = endpointIndex;
+    mEndpointCount++;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AttributeMetadataIndex::AddAttribute(const Attribute & attribute)
+{
+    VerifyOrReturnError(!mReady, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mAttributeCount < mAttributeSize, CHIP_ERROR_NO_MEMORY);
+
+    mAttributes[mAttributeCount++] = attribute;
+
+    return CHIP_NO_ERROR;
+}
+
+void AttributeMetadataIndex::Finalize()
+{
+    VerifyOrReturn(!mReady);
+
+    std::sort(mAttributes, mAttributes + mAttributeCount, AttributeOrder);
+    std::sort(mEndpoints, mEndpoints + mEndpointCount, EndpointOrder);
+
+    // Entries with the same ids are adjacent once sorted; the hash table points at the first of each run.
+    std::fill(mSlots, mSlots + mSlotMask + 1, kEmptySlot);
+    for (size_t i = 0; i < mAttributeCount; i++)
+    {
+        const uint64_t key = AttributeKey(mAttributes[i]);
+        if (i > 0 && AttributeKey(mAttributes[i - 1]) == key)
+        {
+            continue;
+        }
+
+        size_t slot = HashSlot(key, mSlotShift);
+        while (mSlots[slot] != kEmptySlot)
+        {
+            slot = (slot + 1) & mSlotMask;
+        }
+        mSlots[slot] = static_cast<uint32_t>(i);
+    }
+
+    mReady = true;
+}
+
+Span<const AttributeMetadataIndex::Attribute> AttributeMetadataIndex::FindAttribute(EndpointId endpoint, ClusterId clusterId,
+                                                                                    AttributeId attributeId) const
+{
+    const uint64_t key = AttributeKey(endpoint, clusterId, attributeId);
+
+    VerifyOrReturnError(mReady, Span<const Attribute>());
+
+    for (size_t slot = HashSlot(key, mSlotShift); mSlots[slot] != kEmptySlot; slot = (slot + 1) & mSlotMask)
+    {
+        const size_t first = mSlots[slot];
+        if (AttributeKey(mAttributes[first]) == key)
+        {
+            size_t last = first + 1;
+            while (last < mAttributeCount && AttributeKey(mAttributes[last]) == key)
+            {
+                last++;
+            }
+            return Span<const Attribute>(&mAttributes[first], last - first);
+        }
+    }
+
+    return Span<const Attribute>();
+}
+
+Span<const AttributeMetadataIndex::Endpoint> AttributeMetadataIndex::FindEndpoint(EndpointId endpoint) const
+{
+    VerifyOrReturnError(mReady, Span<const Endpoint>());
+
+    auto less  = [](const Endpoint & a, const Endpoint & b) { return a.endpoint < b.endpoint; };
+    auto range = std::equal_range(mEndpoints, mEndpoints + mEndpointCount, Endpoint{ endpoint, 0 }, less);
+    return Span<const Endpoint>(range.first, static_cast<size_t>(range.second - range.first));
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,119 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an index of the attributes in the endpoint table,
+ *      used by attribute storage to find an attribute without scanning every
+ *      endpoint, cluster and attribute before it.
+ *
+ */
+
+#pragma once
+
+#include <app/util/basic-types.h>
+#include <core/CHIPError.h>
+#include <support/Span.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Maps (endpoint, cluster, attribute) to the position of the attribute in the endpoint table and to its offset in attribute
+ * storage, and endpoint ids to their index in the endpoint table.
+ *
+ * The index is filled in endpoint table order with AddEndpoint() and AddAttribute(), then sorted by Finalize(), which also
+ * builds an open addressing hash table over the attribute ids. Attribute lookups are a hash probe, endpoint lookups a binary
+ * search over at most 256 entries. The index only holds ids and positions: it has to be rebuilt whenever the endpoint table
+ * changes, and callers still check enabled state, cluster side and manufacturer codes against the table itself.
+ */
+class AttributeMetadataIndex
+{
+public:
+    struct Attribute
+    {
+        EndpointId endpoint;
+        ClusterId clusterId;
+        AttributeId attributeId;
+        uint8_t endpointIndex;   // Index in the endpoint table
+        uint8_t clusterIndex;    // Index in the cluster array of the endpoint type
+        uint16_t attributeIndex; // Index in the attribute array of the cluster
+        uint16_t storageOffset;  // Offset in attribute storage, for attributes that are not external or singletons
+    };
+
+    struct Endpoint
+    {
+        EndpointId endpoint;
+        uint8_t endpointIndex;
+    };
+
+    AttributeMetadataIndex() = default;
+    ~AttributeMetadataIndex() { Clear(); }
+
+    AttributeMetadataIndex(const AttributeMetadataIndex &) = delete;
+    AttributeMetadataIndex & operator=(const AttributeMetadataIndex &) = delete;
+
+    /**
+     * Drop the current contents and allocate room for the given number of attributes and endpoints.
+     */
+    CHIP_ERROR Init(size_t attributeCount, size_t endpointCount);
+
+    /**
+     * Release the index. Lookups fail until it is initialized and finalized again.
+     */
+    void Clear();
+
+    CHIP_ERROR AddEndpoint(EndpointId endpoint, uint8_t endpointIndex);
+    CHIP_ERROR AddAttribute(const Attribute & attribute);
+
+    /**
+     * Sort the index and build the hash table. Entries with the same ids keep the endpoint table order.
+     */
+    void Finalize();
+
+    bool IsReady() const { return mReady; }
+
+    /**
+     * All entries for the given attribute, in endpoint table order. The same ids may appear on both cluster sides and,
+     * for manufacturer specific clusters, several times on one side.
+     */
+    Span<const Attribute> FindAttribute(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId) const;
+
+    /**
+     * All endpoint table indices for the given endpoint id, in order.
+     */
+    Span<const Endpoint> FindEndpoint(EndpointId endpoint) const;
+
+private:
+    Attribute * mAttributes = nullptr; // Sorted by ids, then by position in the endpoint table
+    uint32_t * mSlots       = nullptr; // Hash table of indices into mAttributes, one per distinct set of ids
+    Endpoint * mEndpoints   = nullptr;
+    size_t mAttributeCount  = 0;
+    size_t mAttributeSize   = 0;
+    size_t mSlotMask        = 0;
+    size_t mEndpointCount   = 0;
+    size_t mEndpointSize    = 0;
+    uint8_t mSlotShift      = 0;
+    bool mReady             = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -471,6 +471,14 @@ uint8_t emberAfEndpointCount(void);
  */
 uint8_t emberAfFixedEndpointCount(void);
 
+/**
+ * @brief Sets the number of dynamic endpoints following the pre-compiled ones in emAfEndpoints.
+ *
+ * This also rebuilds the attribute lookup index, so it must be called again
+ * whenever a dynamic endpoint entry or its endpoint type is changed.
+ */
+void emberAfSetEndpointCount(uint8_t dynamicEndpointCount);
+
 /**
  * Data types are either analog or discrete. This makes a difference for
  * some of the ZCL global commands
@@ -40,6 +40,7 @@
  ******************************************************************************/
 
 #include "app/util/common.h"
+#include <app/util/AttributeMetadataIndex.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 
@@ -71,6 +72,10 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint8_t emberEndpointCount = 0;
 
+// Index of the attributes of all endpoints, rebuilt whenever the endpoint table changes.
+// Lookups fall back to scanning the endpoint table when the index could not be allocated.
+static chip::app::AttributeMetadataIndex sAttributeIndex;
+
 // If we have attributes that are more than 2 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -115,6 +120,9 @@ const uint16_t attributeManufacturerCodeCount                   = GENERATED_ATTR
 // Returns endpoint index within a given cluster
 static uint8_t findClusterEndpointIndex(EndpointId endpoint, ClusterId clusterId, uint8_t mask, uint16_t manufacturerCode);
 
+// Rebuilds sAttributeIndex from the endpoint table
+static void rebuildAttributeIndex(void);
+
 //------------------------------------------------------------------------------
 
 // Initial configuration
@@ -140,11 +148,80 @@ void emberAfEndpointConfigure(void)
         emAfEndpoints[ep].networkIndex  = endpointNetworkIndex(ep);
         emAfEndpoints[ep].bitmask       = EMBER_AF_ENDPOINT_ENABLED;
     }
+
+    rebuildAttributeIndex();
 }
 
 void emberAfSetEndpointCount(uint8_t dynamicEndpointCount)
 {
     emberEndpointCount = static_cast<uint8_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    rebuildAttributeIndex();
+}
+
+static CHIP_ERROR fillAttributeIndex(void)
+{
+    size_t attributeCount  = 0;
+    uint16_t endpointStart = 0;
+
+    for (uint8_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    {
+        EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+        for (uint8_t clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+        {
+            attributeCount += endpointType->cluster[clusterIndex].attributeCount;
+        }
+    }
+
+    ReturnErrorOnFailure(sAttributeIndex.Init(attributeCount, emberAfEndpointCount()));
+
+    // Storage offsets are laid out as emAfReadOrWriteAttribute walks the table: endpoint after endpoint, cluster after
+    // cluster, counting only attributes that are neither external nor singletons.
+    for (uint8_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    {
+        EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
+        uint16_t clusterStart              = endpointStart;
+
+        ReturnErrorOnFailure(sAttributeIndex.AddEndpoint(emAfEndpoints[ep].endpoint, ep));
+
+        for (uint8_t clusterIndex = 0; clusterIndex < endpointType->clusterCount; clusterIndex++)
+        {
+            EmberAfCluster * cluster = &(endpointType->cluster[clusterIndex]);
+            chip::app::AttributeMetadataIndex::Attribute entry;
+            entry.endpoint      = emAfEndpoints[ep].endpoint;
+            entry.clusterId     = cluster->clusterId;
+            entry.endpointIndex = ep;
+            entry.clusterIndex  = clusterIndex;
+            entry.storageOffset = clusterStart;
+
+            for (uint16_t attrIndex = 0; attrIndex < cluster->attributeCount; attrIndex++)
+            {
+                EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
+                entry.attributeId             = am->attributeId;
+                entry.attributeIndex          = attrIndex;
+                ReturnErrorOnFailure(sAttributeIndex.AddAttribute(entry));
+
+                if (!(am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE) && !(am->mask & ATTRIBUTE_MASK_SINGLETON))
+                {
+                    entry.storageOffset = static_cast<uint16_t>(entry.storageOffset + emberAfAttributeSize(am));
+                }
+            }
+
+            clusterStart = static_cast<uint16_t>(clusterStart + cluster->clusterSize);
+        }
+
+        endpointStart = static_cast<uint16_t>(endpointStart + endpointType->endpointSize);
+    }
+
+    sAttributeIndex.Finalize();
+    return CHIP_NO_ERROR;
+}
+
+static void rebuildAttributeIndex(void)
+{
+    if (fillAttributeIndex() != CHIP_NO_ERROR)
+    {
+        sAttributeIndex.Clear();
+    }
 }
 
 uint8_t emberAfFixedEndpointCount(void)
@@ -508,6 +585,56 @@ bool emAfMatchAttribute(EmberAfCluster * cluster, EmberAfAttributeMetadata * am,
              (emAfGetManufacturerCodeForAttribute(cluster, am) == attRecord->manufacturerCode)));
 }
 
+// Reads or writes an attribute found at the given offset in attribute storage.
+static EmberAfStatus readOrWriteFoundAttribute(EmberAfAttributeSearchRecord * attRecord, EmberAfCluster * cluster,
+                                               EmberAfAttributeMetadata * am, uint16_t attributeOffsetIndex,
+                                               EmberAfAttributeMetadata ** metadata, uint8_t * buffer, uint16_t readLength,
+                                               bool write, int32_t index)
+{
+    // If passed metadata location is not null, populate
+    if (metadata != NULL)
+    {
+        *metadata = am;
+    }
+
+    uint8_t * attributeLocation =
+        (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am) : attributeData + attributeOffsetIndex);
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = attributeLocation;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
+                                                 emAfGetManufacturerCodeForAttribute(cluster, am), am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
+        }
+    }
+    else
+    {
+        if (buffer == NULL)
+        {
+            return EMBER_ZCL_STATUS_SUCCESS;
+        }
+
+        src = attributeLocation;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
+                                                emAfGetManufacturerCodeForAttribute(cluster, am), am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
+        }
+    }
+
+    return (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE
+                ? (write) ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                  emAfGetManufacturerCodeForAttribute(cluster, am), buffer)
+                          : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                                 emAfGetManufacturerCodeForAttribute(cluster, am), buffer,
+                                                                 emberAfAttributeSize(am))
+                : typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength, index));
+}
+
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -527,6 +654,41 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
     uint8_t i;
     uint16_t attributeOffsetIndex = 0;
 
+    if (sAttributeIndex.IsReady())
+    {
+        // Candidates come in endpoint table order, so the first match is the one the scan below would find.
+        chip::Span<const chip::app::AttributeMetadataIndex::Attribute> candidates =
+            sAttributeIndex.FindAttribute(attRecord->endpoint, attRecord->clusterId, attRecord->attributeId);
+        for (size_t c = 0; c < candidates.size(); c++)
+        {
+            const chip::app::AttributeMetadataIndex::Attribute & entry = candidates.data()[c];
+            if (entry.endpointIndex >= emberAfEndpointCount() || !emberAfEndpointIndexIsEnabled(entry.endpointIndex))
+            {
+                continue;
+            }
+
+            EmberAfEndpointType * endpointType = emAfEndpoints[entry.endpointIndex].endpointType;
+            if (entry.clusterIndex >= endpointType->clusterCount)
+            {
+                continue;
+            }
+
+            EmberAfCluster * cluster = &(endpointType->cluster[entry.clusterIndex]);
+            if (entry.attributeIndex >= cluster->attributeCount)
+            {
+                continue;
+            }
+
+            EmberAfAttributeMetadata * am = &(cluster->attributes[entry.attributeIndex]);
+            if (emAfMatchCluster(cluster, attRecord) && emAfMatchAttribute(cluster, am, attRecord))
+            {
+                return readOrWriteFoundAttribute(attRecord, cluster, am, entry.storageOffset, metadata, buffer, readLength, write,
+                                                 index);
+            }
+        }
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE; // Sorry, attribute was not found.
+    }
+
     for (i = 0; i < emberAfEndpointCount(); i++)
     {
         if (emAfEndpoints[i].endpoint == attRecord->endpoint)
@@ -548,55 +710,8 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
                         EmberAfAttributeMetadata * am = &(cluster->attributes[attrIndex]);
                         if (emAfMatchAttribute(cluster, am, attRecord))
                         { // Got the attribute
-                            // If passed metadata location is not null, populate
-                            if (metadata != NULL)
-                            {
-                                *metadata = am;
-                            }
-
-                            {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             emAfGetManufacturerCodeForAttribute(cluster, am),
-                                                                             am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == NULL)
-                                    {
-                                        return EMBER_ZCL_STATUS_SUCCESS;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            emAfGetManufacturerCodeForAttribute(cluster, am),
-                                                                            am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-
-                                return (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE
-                                            ? (write) ? emberAfExternalAttributeWriteCallback(
-                                                            attRecord->endpoint, attRecord->clusterId, am,
-                                                            emAfGetManufacturerCodeForAttribute(cluster, am), buffer)
-                                                      : emberAfExternalAttributeReadCallback(
-                                                            attRecord->endpoint, attRecord->clusterId, am,
-                                                            emAfGetManufacturerCodeForAttribute(cluster, am), buffer,
-                                                            emberAfAttributeSize(am))
-                                            : typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength, index));
-                            }
+                            return readOrWriteFoundAttribute(attRecord, cluster, am, attributeOffsetIndex, metadata, buffer,
+                                                             readLength, write, index);
                         }
                         else
                         { // Not the attribute we are looking for
@@ -802,11 +917,11 @@ static uint8_t findClusterEndpointIndex(EndpointId endpoint, ClusterId clusterId
         {
             break;
         }
-        epi = static_cast<uint8_t>(epi +
-                                   ((emberAfFindClusterIncludingDisabledEndpointsWithMfgCode(emAfEndpoints[i].endpoint, clusterId,
-                                                                                             mask, manufacturerCode) != NULL)
-                                        ? 1
-                                        : 0));
+        // Search the endpoint type directly rather than looking the endpoint up again by id.
+        if (emberAfFindClusterInTypeWithMfgCode(emAfEndpoints[i].endpointType, clusterId, mask, manufacturerCode) != NULL)
+        {
+            epi++;
+        }
     }
 
     return epi;
@@ -815,6 +930,22 @@ static uint8_t findClusterEndpointIndex(EndpointId endpoint, ClusterId clusterId
 static uint8_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEndpoints)
 {
     uint8_t epi;
+
+    if (sAttributeIndex.IsReady())
+    {
+        chip::Span<const chip::app::AttributeMetadataIndex::Endpoint> candidates = sAttributeIndex.FindEndpoint(endpoint);
+        for (size_t c = 0; c < candidates.size(); c++)
+        {
+            epi = candidates.data()[c].endpointIndex;
+            if (epi < emberAfEndpointCount() && emAfEndpoints[epi].endpoint == endpoint &&
+                (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask & EMBER_AF_ENDPOINT_ENABLED))
+            {
+                return epi;
+            }
+        }
+        return 0xFF;
+    }
+
     for (epi = 0; epi < emberAfEndpointCount(); epi++)
     {
         if (emAfEndpoints[epi].endpoint == endpoint &&
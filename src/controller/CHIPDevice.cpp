@@ -408,6 +408,7 @@ CHIP_ERROR Device::EstablishCASESession()
 
     ReturnErrorOnFailure(mCASESession.MessageDispatch().Init(mSessionManager->GetTransportManager()));
     mCASESession.MessageDispatch().SetPeerAddress(mDeviceAddress);
+    mCASESession.SetResumptionCache(mCASEResumptionCache);
 
     ReturnErrorOnFailure(mCASESession.EstablishSession(mDeviceAddress, mCredentials, mDeviceId, 0, exchange, this));
 
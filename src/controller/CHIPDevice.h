@@ -79,6 +79,7 @@ struct ControllerDeviceInitParams
     Inet::InetLayer * inetLayer              = nullptr;
 
     Credentials::OperationalCredentialSet * credentials = nullptr;
+    CASEResumptionCache * caseResumptionCache           = nullptr;
 #if CONFIG_NETWORK_LAYER_BLE
     Ble::BleLayer * bleLayer = nullptr;
 #endif
@@ -173,13 +174,14 @@ public:
      */
     void Init(ControllerDeviceInitParams params, uint16_t listenPort, Transport::AdminId admin)
     {
-        mTransportMgr   = params.transportMgr;
-        mSessionManager = params.sessionMgr;
-        mExchangeMgr    = params.exchangeMgr;
-        mInetLayer      = params.inetLayer;
-        mListenPort     = listenPort;
-        mAdminId        = admin;
-        mCredentials    = params.credentials;
+        mTransportMgr        = params.transportMgr;
+        mSessionManager      = params.sessionMgr;
+        mExchangeMgr         = params.exchangeMgr;
+        mInetLayer           = params.inetLayer;
+        mListenPort          = listenPort;
+        mAdminId             = admin;
+        mCredentials         = params.credentials;
+        mCASEResumptionCache = params.caseResumptionCache;
 #if CONFIG_NETWORK_LAYER_BLE
         mBleLayer = params.bleLayer;
 #endif
@@ -440,6 +442,7 @@ private:
     uint16_t mCASESessionKeyId = 0;
 
     Credentials::OperationalCredentialSet * mCredentials = nullptr;
+    CASEResumptionCache * mCASEResumptionCache           = nullptr;
 };
 
 /**
@@ -188,6 +188,9 @@ CHIP_ERROR DeviceController::Init(NodeId localDeviceId, ControllerInitParams par
     err = mAdmins.Init(mStorageDelegate);
     SuccessOrExit(err);
 
+    err = mCASEResumptionCache.Init(mStorageDelegate);
+    SuccessOrExit(err);
+
     admin = mAdmins.AssignAdminId(mAdminId, localDeviceId);
     VerifyOrExit(admin != nullptr, err = CHIP_ERROR_NO_MEMORY);
 
@@ -776,11 +779,12 @@ void DeviceController::OnCommissionableNodeFound(const chip::Mdns::Commissionabl
 
 ControllerDeviceInitParams DeviceController::GetControllerDeviceInitParams()
 {
-    return ControllerDeviceInitParams{ .transportMgr = mTransportMgr,
-                                       .sessionMgr   = mSessionMgr,
-                                       .exchangeMgr  = mExchangeMgr,
-                                       .inetLayer    = mInetLayer,
-                                       .credentials  = &mCredentials };
+    return ControllerDeviceInitParams{ .transportMgr        = mTransportMgr,
+                                       .sessionMgr          = mSessionMgr,
+                                       .exchangeMgr         = mExchangeMgr,
+                                       .inetLayer           = mInetLayer,
+                                       .credentials         = &mCredentials,
+                                       .caseResumptionCache = &mCASEResumptionCache };
 }
 
 DeviceCommissioner::DeviceCommissioner() :
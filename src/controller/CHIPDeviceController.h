@@ -286,6 +286,9 @@ protected:
     Credentials::OperationalCredentialSet mCredentials;
     Credentials::CertificateKeyId mRootKeyId;
 
+    // Tickets for resuming the CASE sessions with the devices, so that reconnecting skips the full handshake
+    CASEResumptionCache mCASEResumptionCache;
+
     uint16_t mNextKeyId = 0;
 
 private:
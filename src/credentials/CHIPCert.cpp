@@ -244,6 +244,14 @@ exit:
     return err;
 }
 
+void ChipCertificateSet::ReleaseLastCert()
+{
+    VerifyOrReturn(mCertCount > 0);
+
+    mCertCount--;
+    mCerts[mCertCount].Clear();
+}
+
 CHIP_ERROR ChipCertificateSet::LoadCerts(const uint8_t * chipCerts, uint32_t chipCertsLen, BitFlags<CertDecodeFlags> decodeFlags)
 {
     CHIP_ERROR err;
@@ -465,6 +465,12 @@ public:
      **/
     CHIP_ERROR LoadCerts(chip::TLV::TLVReader & reader, BitFlags<CertDecodeFlags> decodeFlags);
 
+    /**
+     * @brief Remove the certificate loaded last from the set, such as a certificate loaded only to be validated,
+     *        whose buffer does not outlive the validation.
+     **/
+    void ReleaseLastCert();
+
     /**
      * @brief Find certificate in the set.
      *
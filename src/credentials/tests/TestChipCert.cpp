@@ -639,6 +639,41 @@ static void TestChipCert_CertType(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+static void TestChipCert_ReleaseLastCert(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    ChipCertificateSet certSet;
+    uint8_t certType;
+
+    err = certSet.Init(2, kTestCertBufSize);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = LoadTestCert(certSet, TestCert::kRoot01, sNullLoadFlag, sTrustAnchorFlag);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = LoadTestCert(certSet, TestCert::kNode01_01, sNullLoadFlag, sNullDecodeFlag);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, certSet.GetCertCount() == 2);
+
+    // Only the certificate loaded last is removed, making room for another one
+    certSet.ReleaseLastCert();
+    NL_TEST_ASSERT(inSuite, certSet.GetCertCount() == 1);
+
+    err = certSet.GetCertSet()[0].mSubjectDN.GetCertType(certType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, certType == kCertType_Root);
+
+    err = LoadTestCert(certSet, TestCert::kNode01_02, sNullLoadFlag, sNullDecodeFlag);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, certSet.GetCertCount() == 2);
+
+    certSet.ReleaseLastCert();
+    certSet.ReleaseLastCert();
+    certSet.ReleaseLastCert();
+    NL_TEST_ASSERT(inSuite, certSet.GetCertCount() == 0);
+
+    certSet.Release();
+}
+
 static void TestChipCert_GenerateRootCert(nlTestSuite * inSuite, void * inContext)
 {
     // Generate a new keypair for cert signing
@@ -931,6 +966,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test CHIP Certificate Validation time", TestChipCert_CertValidTime),
     NL_TEST_DEF("Test CHIP Certificate Usage", TestChipCert_CertUsage),
     NL_TEST_DEF("Test CHIP Certificate Type", TestChipCert_CertType),
+    NL_TEST_DEF("Test CHIP Certificate Set Release Last", TestChipCert_ReleaseLastCert),
     NL_TEST_DEF("Test CHIP Generate Root Certificate", TestChipCert_GenerateRootCert),
     NL_TEST_DEF("Test CHIP Generate Root Certificate with Fabric", TestChipCert_GenerateRootFabCert),
     NL_TEST_DEF("Test CHIP Generate ICA Certificate", TestChipCert_GenerateICACert),
@@ -33,6 +33,250 @@ using HKDF_sha_crypto = HKDF_shaHSM;
 using HKDF_sha_crypto = HKDF_sha;
 #endif
 
+AES_CCM_stream::AES_CCM_stream()
+{
+    memset(&mContext, 0, sizeof(mContext));
+}
+
+AES_CCM_stream::~AES_CCM_stream()
+{
+    Clear();
+}
+
+CHIP_ERROR AES_CCM_stream::SetKey(const uint8_t * key, size_t key_length)
+{
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    // 16 bytes key for AES-CCM-128, 32 for AES-CCM-256
+    VerifyOrReturnError(key_length == 16 || key_length == 32, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mState = State::kNoKey;
+    ReturnErrorOnFailure(InitCipher(key, key_length));
+    mState = State::kReady;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::BeginEncrypt(const uint8_t * iv, size_t iv_length, const uint8_t * aad, size_t aad_length,
+                                        size_t data_length, size_t tag_length)
+{
+    ReturnErrorOnFailure(Begin(iv, iv_length, aad, aad_length, data_length, tag_length));
+    mState = State::kEncrypting;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::BeginDecrypt(const uint8_t * iv, size_t iv_length, const uint8_t * aad, size_t aad_length,
+                                        size_t data_length, const uint8_t * tag, size_t tag_length)
+{
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReturnErrorOnFailure(Begin(iv, iv_length, aad, aad_length, data_length, tag_length));
+    memcpy(mTag, tag, tag_length);
+    mState = State::kDecrypting;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::Begin(const uint8_t * iv, size_t iv_length, const uint8_t * aad, size_t aad_length, size_t data_length,
+                                 size_t tag_length)
+{
+    uint8_t block[kBlockLength];
+
+    VerifyOrReturnError(mState != State::kNoKey, CHIP_ERROR_INCORRECT_STATE);
+    mState = State::kReady;
+
+    // CCM nonces are 7 to 13 bytes, the rest of each counter block holds the message length (RFC 3610).
+    VerifyOrReturnError(iv != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(iv_length >= 7 && iv_length <= 13, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag_length == 8 || tag_length == 12 || tag_length == 16, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad != nullptr || aad_length == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aad_length <= UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const size_t lengthSize = kBlockLength - 1 - iv_length;
+    if (lengthSize < sizeof(data_length))
+    {
+        VerifyOrReturnError((data_length >> (8 * lengthSize)) == 0, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Counter block 0 encrypts the tag, the payload keystream starts at counter 1.
+    block[0] = static_cast<uint8_t>(lengthSize - 1);
+    memcpy(&block[1], iv, iv_length);
+    memset(&block[1 + iv_length], 0, lengthSize);
+    ReturnErrorOnFailure(StartMessage(block, mS0));
+
+    // First authentication block: flags, nonce and message length.
+    block[0] = static_cast<uint8_t>(((aad_length > 0) ? 0x40 : 0) | (((tag_length - 2) / 2) << 3) | (lengthSize - 1));
+    for (size_t i = kBlockLength - 1, length = data_length; i > iv_length; i--, length >>= 8)
+    {
+        block[i] = static_cast<uint8_t>(length & 0xff);
+    }
+
+    mBlockLength = 0;
+    ReturnErrorOnFailure(AuthenticateBlocks(block, kBlockLength));
+
+    if (aad_length > 0)
+    {
+        uint8_t encodedLength[6];
+        size_t encodedLengthSize = 0;
+
+        if (aad_length < 0xff00)
+        {
+            encodedLength[encodedLengthSize++] = static_cast<uint8_t>(aad_length >> 8);
+        }
+        else
+        {
+            encodedLength[encodedLengthSize++] = 0xff;
+            encodedLength[encodedLengthSize++] = 0xfe;
+            encodedLength[encodedLengthSize++] = static_cast<uint8_t>(aad_length >> 24);
+            encodedLength[encodedLengthSize++] = static_cast<uint8_t>(aad_length >> 16);
+            encodedLength[encodedLengthSize++] = static_cast<uint8_t>(aad_length >> 8);
+        }
+        encodedLength[encodedLengthSize++] = static_cast<uint8_t>(aad_length);
+
+        ReturnErrorOnFailure(AuthenticateData(encodedLength, encodedLengthSize));
+        ReturnErrorOnFailure(AuthenticateData(aad, aad_length));
+        ReturnErrorOnFailure(AuthenticatePadding());
+    }
+
+    mRemaining = data_length;
+    mTagLength = tag_length;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::Update(const uint8_t * input, size_t length, uint8_t * output)
+{
+    VerifyOrReturnError(mState == State::kEncrypting || mState == State::kDecrypting, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(length <= mRemaining, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(length == 0 || (input != nullptr && output != nullptr), CHIP_ERROR_INVALID_ARGUMENT);
+
+    if (length == 0)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    // CCM authenticates the plaintext, so it has to be consumed before it is overwritten when encrypting in place.
+    if (mState == State::kEncrypting)
+    {
+        ReturnErrorOnFailure(AuthenticateData(input, length));
+        ReturnErrorOnFailure(ApplyKeystream(input, length, output));
+    }
+    else
+    {
+        ReturnErrorOnFailure(ApplyKeystream(input, length, output));
+        ReturnErrorOnFailure(AuthenticateData(output, length));
+    }
+
+    mRemaining -= length;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::FinishEncrypt(uint8_t * tag, size_t tag_length)
+{
+    VerifyOrReturnError(mState == State::kEncrypting, CHIP_ERROR_INCORRECT_STATE);
+    mState = State::kReady;
+
+    VerifyOrReturnError(mRemaining == 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(tag != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(tag_length == mTagLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    return ComputeTag(tag);
+}
+
+CHIP_ERROR AES_CCM_stream::FinishDecrypt()
+{
+    uint8_t tag[kBlockLength];
+    uint8_t diff = 0;
+
+    VerifyOrReturnError(mState == State::kDecrypting, CHIP_ERROR_INCORRECT_STATE);
+    mState = State::kReady;
+
+    VerifyOrReturnError(mRemaining == 0, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(ComputeTag(tag));
+
+    // Compare in constant time
+    for (size_t i = 0; i < mTagLength; i++)
+    {
+        diff = static_cast<uint8_t>(diff | (tag[i] ^ mTag[i]));
+    }
+    VerifyOrReturnError(diff == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+void AES_CCM_stream::Clear()
+{
+    FreeCipher();
+
+    memset(mBlock, 0, sizeof(mBlock));
+    memset(mS0, 0, sizeof(mS0));
+    memset(mTag, 0, sizeof(mTag));
+    mBlockLength = 0;
+    mRemaining   = 0;
+    mTagLength   = 0;
+    mState       = State::kNoKey;
+}
+
+CHIP_ERROR AES_CCM_stream::AuthenticateData(const uint8_t * data, size_t length)
+{
+    if (mBlockLength > 0)
+    {
+        const size_t count = (length < kBlockLength - mBlockLength) ? length : kBlockLength - mBlockLength;
+
+        memcpy(&mBlock[mBlockLength], data, count);
+        mBlockLength += count;
+        data += count;
+        length -= count;
+
+        if (mBlockLength < kBlockLength)
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        ReturnErrorOnFailure(AuthenticateBlocks(mBlock, kBlockLength));
+        mBlockLength = 0;
+    }
+
+    const size_t wholeBlocksLength = length - (length % kBlockLength);
+    if (wholeBlocksLength > 0)
+    {
+        ReturnErrorOnFailure(AuthenticateBlocks(data, wholeBlocksLength));
+    }
+
+    mBlockLength = length - wholeBlocksLength;
+    memcpy(mBlock, &data[wholeBlocksLength], mBlockLength);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::AuthenticatePadding()
+{
+    if (mBlockLength > 0)
+    {
+        memset(&mBlock[mBlockLength], 0, kBlockLength - mBlockLength);
+        ReturnErrorOnFailure(AuthenticateBlocks(mBlock, kBlockLength));
+        mBlockLength = 0;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::ComputeTag(uint8_t * tag)
+{
+    uint8_t mac[kBlockLength];
+
+    ReturnErrorOnFailure(AuthenticatePadding());
+    ReturnErrorOnFailure(GetMAC(mac));
+
+    for (size_t i = 0; i < mTagLength; i++)
+    {
+        tag[i] = static_cast<uint8_t>(mac[i] ^ mS0[i]);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR Spake2p::InternalHash(const uint8_t * in, size_t in_len)
 {
     CHIP_ERROR error = CHIP_ERROR_INTERNAL;
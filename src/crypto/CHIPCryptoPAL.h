@@ -60,6 +60,7 @@ const size_t kP256_PublicKey_Length  = 65;
 const size_t kMAX_Spake2p_Context_Size     = 1024;
 const size_t kMAX_Hash_SHA256_Context_Size = 296;
 const size_t kMAX_P256Keypair_Context_Size = 512;
+const size_t kMAX_AES_CCM_Context_Size     = 384;
 
 /**
  * Spake2+ parameters for P256
@@ -345,6 +346,135 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const uint8_t * key, size_t key_length, const uint8_t * iv,
                            size_t iv_length, uint8_t * plaintext);
 
+struct alignas(size_t) AESCCMOpaqueContext
+{
+    uint8_t mOpaque[kMAX_AES_CCM_Context_Size];
+};
+
+/**
+ * @brief A class that implements AES-CCM over data that is supplied in several pieces,
+ *        e.g. the buffers of a PacketBuffer chain.
+ *
+ *        The total length of the data must be known when the operation begins. Input and
+ *        output of Update() may be the same buffer, so data can be processed in place.
+ *        The key is kept across operations, so several messages can be processed with a
+ *        single SetKey().
+ *
+ *        When decrypting, plaintext is produced before the tag has been checked; the caller
+ *        must discard the output if FinishDecrypt() fails.
+ **/
+class AES_CCM_stream
+{
+public:
+    AES_CCM_stream();
+    ~AES_CCM_stream();
+
+    AES_CCM_stream(const AES_CCM_stream &) = delete;
+    AES_CCM_stream & operator=(const AES_CCM_stream &) = delete;
+
+    /**
+     * @brief Set the key for subsequent operations.
+     * @param key Encryption key
+     * @param key_length Length of encryption key (in bytes), 16 for AES-CCM-128 or 32 for AES-CCM-256
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR SetKey(const uint8_t * key, size_t key_length);
+
+    /**
+     * @brief Begin encrypting a message.
+     * @param iv Initial vector
+     * @param iv_length Length of initial vector
+     * @param aad Additional authentication data
+     * @param aad_length Length of additional authentication data
+     * @param data_length Total length of the plaintext that will be passed to Update()
+     * @param tag_length Length of the tag that FinishEncrypt() will produce
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR BeginEncrypt(const uint8_t * iv, size_t iv_length, const uint8_t * aad, size_t aad_length, size_t data_length,
+                            size_t tag_length);
+
+    /**
+     * @brief Begin decrypting a message.
+     * @param iv Initial vector
+     * @param iv_length Length of initial vector
+     * @param aad Additional authentication data
+     * @param aad_length Length of additional authentication data
+     * @param data_length Total length of the ciphertext that will be passed to Update()
+     * @param tag Tag that FinishDecrypt() will verify
+     * @param tag_length Length of tag
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR BeginDecrypt(const uint8_t * iv, size_t iv_length, const uint8_t * aad, size_t aad_length, size_t data_length,
+                            const uint8_t * tag, size_t tag_length);
+
+    /**
+     * @brief Encrypt or decrypt the next piece of the message.
+     * @param input Data to process
+     * @param length Length of input
+     * @param output Buffer of at least length bytes for the result; may be equal to input
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR Update(const uint8_t * input, size_t length, uint8_t * output);
+
+    /**
+     * @brief Finish encrypting the message and write its tag.
+     * @param tag Buffer to write tag into
+     * @param tag_length Length of tag, as passed to BeginEncrypt()
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR FinishEncrypt(uint8_t * tag, size_t tag_length);
+
+    /**
+     * @brief Finish decrypting the message and verify its tag.
+     * @return Returns CHIP_ERROR_INTERNAL if the tag does not match, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR FinishDecrypt();
+
+    /**
+     * @brief Forget the key and any operation in progress.
+     **/
+    void Clear();
+
+    /**
+     * @brief Whether a key has been set. The expanded key is kept across messages until Clear() is called.
+     **/
+    bool HasKey() const { return mState != State::kNoKey; }
+
+private:
+    static constexpr size_t kBlockLength = 16;
+
+    enum class State : uint8_t
+    {
+        kNoKey,
+        kReady,
+        kEncrypting,
+        kDecrypting,
+    };
+
+    CHIP_ERROR Begin(const uint8_t * iv, size_t iv_length, const uint8_t * aad, size_t aad_length, size_t data_length,
+                     size_t tag_length);
+    CHIP_ERROR AuthenticateData(const uint8_t * data, size_t length);
+    CHIP_ERROR AuthenticatePadding();
+    CHIP_ERROR ComputeTag(uint8_t * tag);
+
+    /* Implemented by the crypto backend */
+    CHIP_ERROR InitCipher(const uint8_t * key, size_t key_length);
+    CHIP_ERROR StartMessage(const uint8_t * counter0, uint8_t * s0);
+    CHIP_ERROR AuthenticateBlocks(const uint8_t * blocks, size_t length);
+    CHIP_ERROR GetMAC(uint8_t * mac);
+    CHIP_ERROR ApplyKeystream(const uint8_t * input, size_t length, uint8_t * output);
+    void FreeCipher();
+
+    AESCCMOpaqueContext mContext;
+    uint8_t mBlock[kBlockLength];
+    uint8_t mS0[kBlockLength];
+    uint8_t mTag[kBlockLength];
+    size_t mBlockLength = 0;
+    size_t mRemaining   = 0;
+    size_t mTagLength   = 0;
+    State mState        = State::kNoKey;
+};
+
 /**
  * @brief Verify the Certificate Signing Request (CSR). If successfully verified, it outputs the public key from the CSR.
  * @param csr CSR in DER format
@@ -361,6 +361,135 @@ void Hash_SHA256_stream::Clear()
     memset(this, 0, sizeof(*this));
 }
 
+typedef struct AES_CCM_Context
+{
+    EVP_CIPHER_CTX * mCounterContext;
+    EVP_CIPHER_CTX * mMACContext;
+    uint8_t mMAC[16];
+} AES_CCM_Context;
+
+static inline AES_CCM_Context * to_inner_aes_ccm_context(AESCCMOpaqueContext * context)
+{
+    return SafePointerCast<AES_CCM_Context *>(context);
+}
+
+// EVP's CCM mode only accepts the whole message in a single update, so AES_CCM_stream
+// combines a CTR context for the payload with a CBC context for the authentication tag.
+CHIP_ERROR AES_CCM_stream::InitCipher(const uint8_t * key, size_t key_length)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    int result                = 1;
+
+    if (context->mCounterContext == nullptr)
+    {
+        context->mCounterContext = EVP_CIPHER_CTX_new();
+        VerifyOrReturnError(context->mCounterContext != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+    if (context->mMACContext == nullptr)
+    {
+        context->mMACContext = EVP_CIPHER_CTX_new();
+        VerifyOrReturnError(context->mMACContext != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+
+    // 16 bytes key for AES-CCM-128
+    const EVP_CIPHER * counterType = (key_length == 16) ? EVP_aes_128_ctr() : EVP_aes_256_ctr();
+    const EVP_CIPHER * macType     = (key_length == 16) ? EVP_aes_128_cbc() : EVP_aes_256_cbc();
+
+    result = EVP_EncryptInit_ex(context->mCounterContext, counterType, nullptr, Uint8::to_const_uchar(key), nullptr);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    result = EVP_EncryptInit_ex(context->mMACContext, macType, nullptr, Uint8::to_const_uchar(key), nullptr);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    result = EVP_CIPHER_CTX_set_padding(context->mMACContext, 0);
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::StartMessage(const uint8_t * counter0, uint8_t * s0)
+{
+    static const uint8_t kZeroBlock[kBlockLength] = { 0 };
+
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    int bytesWritten          = 0;
+    int result                = 1;
+
+    // CBC-MAC chains from an all-zero IV.
+    result = EVP_EncryptInit_ex(context->mMACContext, nullptr, nullptr, nullptr, Uint8::to_const_uchar(kZeroBlock));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    // The first keystream block encrypts the tag; the counter is then left at 1 for the payload.
+    result = EVP_EncryptInit_ex(context->mCounterContext, nullptr, nullptr, nullptr, Uint8::to_const_uchar(counter0));
+    VerifyOrReturnError(result == 1, CHIP_ERROR_INTERNAL);
+
+    result = EVP_EncryptUpdate(context->mCounterContext, Uint8::to_uchar(s0), &bytesWritten, Uint8::to_const_uchar(kZeroBlock),
+                               static_cast<int>(kBlockLength));
+    VerifyOrReturnError(result == 1 && bytesWritten == static_cast<int>(kBlockLength), CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::AuthenticateBlocks(const uint8_t * blocks, size_t length)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    uint8_t scratch[8 * kBlockLength];
+    size_t chunkLength = 0;
+    int bytesWritten   = 0;
+    int result         = 1;
+
+    while (length > 0)
+    {
+        chunkLength = (length < sizeof(scratch)) ? length : sizeof(scratch);
+
+        result = EVP_EncryptUpdate(context->mMACContext, Uint8::to_uchar(scratch), &bytesWritten, Uint8::to_const_uchar(blocks),
+                                   static_cast<int>(chunkLength));
+        VerifyOrReturnError(result == 1 && bytesWritten == static_cast<int>(chunkLength), CHIP_ERROR_INTERNAL);
+
+        blocks += chunkLength;
+        length -= chunkLength;
+    }
+
+    // The MAC is the last block of the CBC output.
+    memcpy(context->mMAC, &scratch[chunkLength - kBlockLength], kBlockLength);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::GetMAC(uint8_t * mac)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+
+    memcpy(mac, context->mMAC, kBlockLength);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::ApplyKeystream(const uint8_t * input, size_t length, uint8_t * output)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    int bytesWritten          = 0;
+    int result                = 1;
+
+    VerifyOrReturnError(CanCastTo<int>(length), CHIP_ERROR_INVALID_ARGUMENT);
+
+    result = EVP_EncryptUpdate(context->mCounterContext, Uint8::to_uchar(output), &bytesWritten, Uint8::to_const_uchar(input),
+                               static_cast<int>(length));
+    VerifyOrReturnError(result == 1 && bytesWritten == static_cast<int>(length), CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+void AES_CCM_stream::FreeCipher()
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+
+    EVP_CIPHER_CTX_free(context->mCounterContext);
+    EVP_CIPHER_CTX_free(context->mMACContext);
+
+    memset(&mContext, 0, sizeof(mContext));
+}
+
 CHIP_ERROR HKDF_sha::HKDF_SHA256(const uint8_t * secret, const size_t secret_length, const uint8_t * salt, const size_t salt_length,
                                  const uint8_t * info, const size_t info_length, uint8_t * out_buffer, size_t out_length)
 {
@@ -24,6 +24,7 @@
 
 #include <type_traits>
 
+#include <mbedtls/aes.h>
 #include <mbedtls/bignum.h>
 #include <mbedtls/ccm.h>
 #include <mbedtls/ctr_drbg.h>
@@ -44,6 +45,11 @@
 #include <support/CodeUtils.h>
 #include <support/SafePointerCast.h>
 #include <support/logging/CHIPLogging.h>
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif
 
 #include <string.h>
 
@@ -264,6 +270,121 @@ void Hash_SHA256_stream::Clear(void)
     memset(this, 0, sizeof(*this));
 }
 
+typedef struct AES_CCM_Context
+{
+    mbedtls_aes_context mAES;
+    uint8_t mMAC[16];
+    uint8_t mCounter[16];
+    uint8_t mKeystream[16];
+    size_t mKeystreamOffset;
+} AES_CCM_Context;
+
+static inline AES_CCM_Context * to_inner_aes_ccm_context(AESCCMOpaqueContext * context)
+{
+    return SafePointerCast<AES_CCM_Context *>(context);
+}
+
+// mbedtls_ccm only processes whole messages, so AES_CCM_stream builds CCM from the AES block cipher
+// the same way mbedtls_ccm does internally.
+CHIP_ERROR AES_CCM_stream::InitCipher(const uint8_t * key, size_t key_length)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    int result                = 0;
+
+    mbedtls_aes_free(&context->mAES);
+    mbedtls_aes_init(&context->mAES);
+
+    // Size of key = key_length * number of bits in a byte (8)
+    // Cast is safe because SetKey() only accepts 16 or 32 byte keys.
+    result = mbedtls_aes_setkey_enc(&context->mAES, Uint8::to_const_uchar(key), static_cast<unsigned int>(key_length * 8));
+    _log_mbedTLS_error(result);
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::StartMessage(const uint8_t * counter0, uint8_t * s0)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    int result                = 0;
+
+    memset(context->mMAC, 0, sizeof(context->mMAC));
+    memcpy(context->mCounter, counter0, sizeof(context->mCounter));
+
+    // The first keystream block encrypts the tag; the payload keystream starts at the next counter.
+    result = mbedtls_aes_crypt_ecb(&context->mAES, MBEDTLS_AES_ENCRYPT, Uint8::to_const_uchar(counter0), Uint8::to_uchar(s0));
+    VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+    context->mKeystreamOffset = sizeof(context->mKeystream);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::AuthenticateBlocks(const uint8_t * blocks, size_t length)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    int result                = 0;
+
+    for (size_t offset = 0; offset < length; offset += kBlockLength)
+    {
+        for (size_t i = 0; i < kBlockLength; i++)
+        {
+            context->mMAC[i] = static_cast<uint8_t>(context->mMAC[i] ^ blocks[offset + i]);
+        }
+
+        result = mbedtls_aes_crypt_ecb(&context->mAES, MBEDTLS_AES_ENCRYPT, context->mMAC, context->mMAC);
+        VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::GetMAC(uint8_t * mac)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+
+    memcpy(mac, context->mMAC, kBlockLength);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AES_CCM_stream::ApplyKeystream(const uint8_t * input, size_t length, uint8_t * output)
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+    int result                = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (context->mKeystreamOffset == sizeof(context->mKeystream))
+        {
+            // Big-endian increment; the message length check in Begin() keeps it within the counter field.
+            for (size_t j = sizeof(context->mCounter); j > 0; j--)
+            {
+                if (++context->mCounter[j - 1] != 0)
+                {
+                    break;
+                }
+            }
+
+            result = mbedtls_aes_crypt_ecb(&context->mAES, MBEDTLS_AES_ENCRYPT, context->mCounter, context->mKeystream);
+            VerifyOrReturnError(result == 0, CHIP_ERROR_INTERNAL);
+            context->mKeystreamOffset = 0;
+        }
+
+        output[i] = static_cast<uint8_t>(input[i] ^ context->mKeystream[context->mKeystreamOffset++]);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void AES_CCM_stream::FreeCipher()
+{
+    AES_CCM_Context * context = to_inner_aes_ccm_context(&mContext);
+
+    mbedtls_aes_free(&context->mAES);
+
+    memset(&mContext, 0, sizeof(mContext));
+}
+
 CHIP_ERROR HKDF_sha::HKDF_SHA256(const uint8_t * secret, const size_t secret_length, const uint8_t * salt, const size_t salt_length,
                                  const uint8_t * info, const size_t info_length, uint8_t * out_buffer, size_t out_length)
 {
@@ -341,6 +462,27 @@ exit:
     return error;
 }
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+// The entropy and DRBG contexts are shared by every thread running crypto, e.g. the crypto worker pool.
+static pthread_mutex_t gsEntropyMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void lock_entropy_context()
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    int pthreadErr = pthread_mutex_lock(&gsEntropyMutex);
+    VerifyOrDie(pthreadErr == 0);
+#endif
+}
+
+static void unlock_entropy_context()
+{
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    int pthreadErr = pthread_mutex_unlock(&gsEntropyMutex);
+    VerifyOrDie(pthreadErr == 0);
+#endif
+}
+
 static EntropyContext * get_entropy_context()
 {
     if (!gsEntropyContext.mInitialized)
@@ -380,7 +522,9 @@ CHIP_ERROR add_entropy_source(entropy_source fn_source, void * p_source, size_t
     int result                    = 0;
     EntropyContext * entropy_ctxt = nullptr;
 
-    VerifyOrExit(fn_source != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(fn_source != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    lock_entropy_context();
 
     entropy_ctxt = get_entropy_context();
     VerifyOrExit(entropy_ctxt != nullptr, error = CHIP_ERROR_INTERNAL);
@@ -388,6 +532,7 @@ CHIP_ERROR add_entropy_source(entropy_source fn_source, void * p_source, size_t
     result = mbedtls_entropy_add_source(&entropy_ctxt->mEntropy, fn_source, p_source, threshold, MBEDTLS_ENTROPY_SOURCE_STRONG);
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 exit:
+    unlock_entropy_context();
     return error;
 }
 
@@ -398,8 +543,10 @@ CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length)
 
     mbedtls_ctr_drbg_context * drbg_ctxt = nullptr;
 
-    VerifyOrExit(out_buffer != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(out_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(out_buffer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(out_length > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    lock_entropy_context();
 
     drbg_ctxt = get_drbg_context();
     VerifyOrExit(drbg_ctxt != nullptr, error = CHIP_ERROR_INTERNAL);
@@ -408,6 +555,7 @@ CHIP_ERROR DRBG_get_bytes(uint8_t * out_buffer, const size_t out_length)
     VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
 
 exit:
+    unlock_entropy_context();
     return error;
 }
 
@@ -0,0 +1,101 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the interface for running expensive crypto
+ *      operations, such as ECDH and ECDSA, off the CHIP thread.
+ */
+
+#pragma once
+
+#include <core/CHIPError.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace Crypto {
+
+class CryptoWorkerPool;
+
+/**
+ * @brief
+ *   A unit of crypto work submitted to a CryptoOffload.
+ *
+ * Run() is called on a thread of the offload, and must only touch state that nothing else touches until the job
+ * completes. OnComplete() is then called on the CHIP thread with the result of Run(), unless the job was cancelled.
+ */
+class CryptoJob
+{
+public:
+    virtual ~CryptoJob() {}
+
+    virtual CHIP_ERROR Run()                   = 0;
+    virtual void OnComplete(CHIP_ERROR result) = 0;
+
+private:
+    friend class CryptoWorkerPool;
+
+    enum class State : uint8_t
+    {
+        kIdle,
+        kQueued,
+        kRunning,
+        kCompleted,
+    };
+
+    // Owned by the offload the job is submitted to.
+    CryptoJob * mNext  = nullptr;
+    CHIP_ERROR mResult = CHIP_NO_ERROR;
+    State mState       = State::kIdle;
+};
+
+/**
+ * @brief
+ *   Runs crypto jobs off the CHIP thread, and reports their completion back on the CHIP thread.
+ */
+class CryptoOffload
+{
+public:
+    virtual ~CryptoOffload() {}
+
+    /**
+     * @brief
+     *   Queue a job, whose OnComplete() is called on the CHIP thread once it has run.
+     *
+     * @retval #CHIP_ERROR_INCORRECT_STATE  The job is already submitted, or the offload is shut down.
+     */
+    virtual CHIP_ERROR Submit(CryptoJob & job) = 0;
+
+    /**
+     * @brief
+     *   Withdraw a job, waiting for it if it is running, so that neither its Run() nor its OnComplete() is called
+     *   afterwards. Withdrawing a job that is not submitted does nothing.
+     */
+    virtual void Cancel(CryptoJob & job) = 0;
+};
+
+/**
+ * @brief
+ *   The offload the platform provides, or nullptr if crypto runs on the CHIP thread.
+ */
+CryptoOffload * GetDefaultCryptoOffload();
+void SetDefaultCryptoOffload(CryptoOffload * offload);
+
+} // namespace Crypto
+} // namespace chip
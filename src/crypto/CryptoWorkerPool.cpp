@@ -0,0 +1,341 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a CryptoOffload that runs crypto jobs on a pool
+ *      of POSIX threads.
+ */
+
+#include <crypto/CryptoWorkerPool.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <support/CodeUtils.h>
+
+namespace chip {
+namespace Crypto {
+
+CryptoWorkerPool::CryptoWorkerPool()
+{
+    int pthreadErr;
+
+    pthreadErr = pthread_mutex_init(&mMutex, nullptr);
+    VerifyOrDie(pthreadErr == 0);
+
+    pthreadErr = pthread_cond_init(&mWorkCond, nullptr);
+    VerifyOrDie(pthreadErr == 0);
+
+    pthreadErr = pthread_cond_init(&mRunDoneCond, nullptr);
+    VerifyOrDie(pthreadErr == 0);
+}
+
+CryptoWorkerPool::~CryptoWorkerPool()
+{
+    Shutdown();
+
+    pthread_cond_destroy(&mRunDoneCond);
+    pthread_cond_destroy(&mWorkCond);
+    pthread_mutex_destroy(&mMutex);
+}
+
+CHIP_ERROR CryptoWorkerPool::Init(uint8_t threadCount, ScheduleWorkFunct scheduleWork)
+{
+    int pthreadErr;
+
+    VerifyOrReturnError(mThreadCount == 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(threadCount > 0 && threadCount <= CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(scheduleWork != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mScheduleWork      = scheduleWork;
+    mDispatchScheduled = false;
+    mShutdown          = false;
+
+    for (uint8_t i = 0; i < threadCount; i++)
+    {
+        pthreadErr = pthread_create(&mThreads[i], nullptr, &WorkerThreadRun, this);
+        VerifyOrDie(pthreadErr == 0);
+    }
+    mThreadCount = threadCount;
+
+    return CHIP_NO_ERROR;
+}
+
+void CryptoWorkerPool::Shutdown()
+{
+    int pthreadErr;
+
+    VerifyOrReturn(mThreadCount > 0);
+
+    pthreadErr = pthread_mutex_lock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    mShutdown = true;
+
+    pthreadErr = pthread_cond_broadcast(&mWorkCond);
+    VerifyOrDie(pthreadErr == 0);
+
+    pthreadErr = pthread_mutex_unlock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    for (uint8_t i = 0; i < mThreadCount; i++)
+    {
+        pthreadErr = pthread_join(mThreads[i], nullptr);
+        VerifyOrDie(pthreadErr == 0);
+    }
+    mThreadCount = 0;
+
+    // No thread runs a job anymore; drop the jobs that were not completed yet.
+    pthreadErr = pthread_mutex_lock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    while (mQueueHead != nullptr)
+    {
+        CryptoJob & job = *mQueueHead;
+        Unlink(mQueueHead, mQueueTail, job);
+    }
+    while (mCompletedHead != nullptr)
+    {
+        CryptoJob & job = *mCompletedHead;
+        Unlink(mCompletedHead, mCompletedTail, job);
+    }
+
+    pthreadErr = pthread_mutex_unlock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+}
+
+bool CryptoWorkerPool::IsShuttingDown()
+{
+    bool shutdown;
+    int pthreadErr;
+
+    pthreadErr = pthread_mutex_lock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    shutdown = mShutdown;
+
+    pthreadErr = pthread_mutex_unlock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    return shutdown;
+}
+
+CHIP_ERROR CryptoWorkerPool::Submit(CryptoJob & job)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    int pthreadErr;
+
+    pthreadErr = pthread_mutex_lock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    VerifyOrExit(mThreadCount > 0 && !mShutdown, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(job.mState == CryptoJob::State::kIdle, err = CHIP_ERROR_INCORRECT_STATE);
+
+    Append(mQueueHead, mQueueTail, job);
+    job.mState = CryptoJob::State::kQueued;
+
+    pthreadErr = pthread_cond_signal(&mWorkCond);
+    VerifyOrDie(pthreadErr == 0);
+
+exit:
+    pthreadErr = pthread_mutex_unlock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    return err;
+}
+
+void CryptoWorkerPool::Cancel(CryptoJob & job)
+{
+    int pthreadErr;
+
+    pthreadErr = pthread_mutex_lock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    while (job.mState == CryptoJob::State::kRunning)
+    {
+        pthreadErr = pthread_cond_wait(&mRunDoneCond, &mMutex);
+        VerifyOrDie(pthreadErr == 0);
+    }
+
+    if (job.mState == CryptoJob::State::kQueued)
+    {
+        Unlink(mQueueHead, mQueueTail, job);
+    }
+    else if (job.mState == CryptoJob::State::kCompleted)
+    {
+        Unlink(mCompletedHead, mCompletedTail, job);
+    }
+
+    pthreadErr = pthread_mutex_unlock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+}
+
+void * CryptoWorkerPool::WorkerThreadRun(void * arg)
+{
+    static_cast<CryptoWorkerPool *>(arg)->WorkerLoop();
+    return nullptr;
+}
+
+void CryptoWorkerPool::WorkerLoop()
+{
+    int pthreadErr;
+
+    pthreadErr = pthread_mutex_lock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+
+    while (true)
+    {
+        CryptoJob * job   = nullptr;
+        CHIP_ERROR result = CHIP_NO_ERROR;
+        bool scheduleWork = false;
+
+        while (mQueueHead == nullptr && !mShutdown)
+        {
+            pthreadErr = pthread_cond_wait(&mWorkCond, &mMutex);
+            VerifyOrDie(pthreadErr == 0);
+        }
+        if (mShutdown)
+        {
+            break;
+        }
+
+        job = mQueueHead;
+        Unlink(mQueueHead, mQueueTail, *job);
+        job->mState = CryptoJob::State::kRunning;
+
+        pthreadErr = pthread_mutex_unlock(&mMutex);
+        VerifyOrDie(pthreadErr == 0);
+
+        result = job->Run();
+
+        pthreadErr = pthread_mutex_lock(&mMutex);
+        VerifyOrDie(pthreadErr == 0);
+
+        job->mResult = result;
+        Append(mCompletedHead, mCompletedTail, *job);
+        job->mState = CryptoJob::State::kCompleted;
+
+        pthreadErr = pthread_cond_broadcast(&mRunDoneCond);
+        VerifyOrDie(pthreadErr == 0);
+
+        // Once the pool shuts down, the completions are dropped rather than handed back to the CHIP thread.
+        scheduleWork       = !mDispatchScheduled && !mShutdown;
+        mDispatchScheduled = true;
+
+        // The scheduler may wait for the CHIP stack lock, which must not be taken with the mutex held, as the CHIP
+        // thread takes the mutex in Cancel() with the CHIP stack locked.
+        if (scheduleWork)
+        {
+            pthreadErr = pthread_mutex_unlock(&mMutex);
+            VerifyOrDie(pthreadErr == 0);
+
+            mScheduleWork(DispatchCompletions, reinterpret_cast<intptr_t>(this));
+
+            pthreadErr = pthread_mutex_lock(&mMutex);
+            VerifyOrDie(pthreadErr == 0);
+        }
+    }
+
+    pthreadErr = pthread_mutex_unlock(&mMutex);
+    VerifyOrDie(pthreadErr == 0);
+}
+
+void CryptoWorkerPool::DispatchCompletions(intptr_t arg)
+{
+    CryptoWorkerPool * pool = reinterpret_cast<CryptoWorkerPool *>(arg);
+    int pthreadErr;
+
+    // Jobs are taken one at a time, so that OnComplete() can submit and cancel jobs, including the other completed ones.
+    while (true)
+    {
+        CryptoJob * job   = nullptr;
+        CHIP_ERROR result = CHIP_NO_ERROR;
+
+        pthreadErr = pthread_mutex_lock(&pool->mMutex);
+        VerifyOrDie(pthreadErr == 0);
+
+        job = pool->mCompletedHead;
+        if (job != nullptr)
+        {
+            result = job->mResult;
+            Unlink(pool->mCompletedHead, pool->mCompletedTail, *job);
+        }
+        else
+        {
+            pool->mDispatchScheduled = false;
+        }
+
+        pthreadErr = pthread_mutex_unlock(&pool->mMutex);
+        VerifyOrDie(pthreadErr == 0);
+
+        if (job == nullptr)
+        {
+            break;
+        }
+        job->OnComplete(result);
+    }
+}
+
+void CryptoWorkerPool::Append(CryptoJob *& head, CryptoJob *& tail, CryptoJob & job)
+{
+    job.mNext = nullptr;
+    if (tail != nullptr)
+    {
+        tail->mNext = &job;
+    }
+    else
+    {
+        head = &job;
+    }
+    tail = &job;
+}
+
+void CryptoWorkerPool::Unlink(CryptoJob *& head, CryptoJob *& tail, CryptoJob & job)
+{
+    CryptoJob * prev = nullptr;
+
+    for (CryptoJob * cur = head; cur != nullptr; prev = cur, cur = cur->mNext)
+    {
+        if (cur != &job)
+        {
+            continue;
+        }
+
+        if (prev != nullptr)
+        {
+            prev->mNext = job.mNext;
+        }
+        else
+        {
+            head = job.mNext;
+        }
+        if (tail == &job)
+        {
+            tail = prev;
+        }
+        break;
+    }
+
+    job.mNext  = nullptr;
+    job.mState = CryptoJob::State::kIdle;
+}
+
+} // namespace Crypto
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a CryptoOffload that runs crypto jobs on a pool
+ *      of POSIX threads.
+ */
+
+#pragma once
+
+#include <core/CHIPConfig.h>
+#include <crypto/CryptoOffload.h>
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <pthread.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Crypto {
+
+/**
+ * @brief
+ *   A CryptoOffload that runs jobs on a pool of POSIX threads, so that concurrent jobs, such as the handshakes of many
+ *   CASE sessions, scale across cores.
+ *
+ * Completed jobs are handed back to the CHIP thread through the scheduler given to Init(), such as a queue the CHIP
+ * thread drains once its event loop is woken up; the scheduler is called at most once per batch of completions, from a
+ * pool thread.
+ */
+class CryptoWorkerPool : public CryptoOffload
+{
+public:
+    using WorkFunct         = void (*)(intptr_t arg);
+    using ScheduleWorkFunct = void (*)(WorkFunct workFunct, intptr_t arg);
+
+    CryptoWorkerPool();
+    ~CryptoWorkerPool() override;
+
+    /**
+     * @brief
+     *   Start the threads of the pool.
+     *
+     * @param[in] threadCount   The number of threads, up to CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT.
+     * @param[in] scheduleWork  Schedules a function to be called on the CHIP thread; must be callable from any thread.
+     *
+     * @retval #CHIP_ERROR_INCORRECT_STATE   The pool is already started.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT  The thread count is out of range, or no scheduler is given.
+     */
+    CHIP_ERROR Init(uint8_t threadCount, ScheduleWorkFunct scheduleWork);
+
+    /**
+     * @brief
+     *   Stop and join the threads of the pool. Jobs still queued are dropped without completing.
+     */
+    void Shutdown();
+
+    /**
+     * @brief
+     *   Whether Shutdown() was called. A scheduler waiting for the CHIP thread stops waiting once the pool shuts down,
+     *   as the completions it would schedule are dropped anyway.
+     */
+    bool IsShuttingDown();
+
+    CHIP_ERROR Submit(CryptoJob & job) override;
+    void Cancel(CryptoJob & job) override;
+
+private:
+    static void * WorkerThreadRun(void * arg);
+    static void DispatchCompletions(intptr_t arg);
+
+    static void Append(CryptoJob *& head, CryptoJob *& tail, CryptoJob & job);
+    static void Unlink(CryptoJob *& head, CryptoJob *& tail, CryptoJob & job);
+
+    void WorkerLoop();
+
+    pthread_t mThreads[CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT];
+    pthread_mutex_t mMutex;      /* Mutex for accessing the queues and the states of the jobs. */
+    pthread_cond_t mWorkCond;    /* Signalled when a job is queued, or the pool shuts down. */
+    pthread_cond_t mRunDoneCond; /* Signalled when a job is done running. */
+
+    CryptoJob * mQueueHead     = nullptr; ///< Jobs waiting for a thread
+    CryptoJob * mQueueTail     = nullptr;
+    CryptoJob * mCompletedHead = nullptr; ///< Jobs waiting for OnComplete() on the CHIP thread
+    CryptoJob * mCompletedTail = nullptr;
+
+    ScheduleWorkFunct mScheduleWork = nullptr;
+    uint8_t mThreadCount            = 0;
+    bool mDispatchScheduled         = false; ///< Whether DispatchCompletions() is scheduled on the CHIP thread
+    bool mShutdown                  = false;
+};
+
+} // namespace Crypto
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
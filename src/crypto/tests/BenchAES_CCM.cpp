@@ -0,0 +1,115 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of AES-CCM-128 encryption with a key
+ *      set up for every message against a stream that expands its key
+ *      schedule once and reuses it.
+ */
+
+#include "AES_CCM_128_test_vectors.h"
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+constexpr size_t kMessageCount     = 10000;
+constexpr size_t kMessageLengths[] = { 64, 512, 1024 };
+
+// Encrypts kMessageCount messages of the given size, either with a fresh key setup per message (AES_CCM_encrypt)
+// or with a stream whose key schedule is expanded once and reused. Returns messages per second, or 0 on failure.
+uint64_t RunEncrypt(AES_CCM_stream * stream, const ccm_128_test_vector * vector, size_t length)
+{
+    uint8_t data[1024] = { 0 };
+    uint8_t tag[16];
+    uint8_t iv[13];
+
+    VerifyOrReturnError(length <= sizeof(data), 0);
+    VerifyOrReturnError(vector->iv_len <= sizeof(iv) && vector->tag_len <= sizeof(tag), 0);
+    memcpy(iv, vector->iv, vector->iv_len);
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        // A different nonce for every message, as a session would use
+        iv[0] = static_cast<uint8_t>(i);
+        iv[1] = static_cast<uint8_t>(i >> 8);
+
+        if (stream == nullptr)
+        {
+            VerifyOrReturnError(AES_CCM_encrypt(data, length, vector->aad, vector->aad_len, vector->key, vector->key_len, iv,
+                                                vector->iv_len, data, tag, vector->tag_len) == CHIP_NO_ERROR,
+                                0);
+        }
+        else
+        {
+            VerifyOrReturnError(stream->BeginEncrypt(iv, vector->iv_len, vector->aad, vector->aad_len, length, vector->tag_len) ==
+                                    CHIP_NO_ERROR,
+                                0);
+            VerifyOrReturnError(stream->Update(data, length, data) == CHIP_NO_ERROR, 0);
+            VerifyOrReturnError(stream->FinishEncrypt(tag, vector->tag_len) == CHIP_NO_ERROR, 0);
+        }
+    }
+
+    uint64_t elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+    return (elapsed > 0) ? kMessageCount * 1000000 / elapsed : 0;
+}
+
+} // namespace
+
+int main()
+{
+    const ccm_128_test_vector * vector = ccm_128_test_vectors[0];
+    AES_CCM_stream stream;
+    int result = EXIT_SUCCESS;
+
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+    VerifyOrDie(stream.SetKey(vector->key, vector->key_len) == CHIP_NO_ERROR);
+
+    for (size_t length : kMessageLengths)
+    {
+        uint64_t perMessageKey = RunEncrypt(nullptr, vector, length);
+        uint64_t cachedKey     = RunEncrypt(&stream, vector, length);
+
+        if (perMessageKey == 0 || cachedKey == 0)
+        {
+            result = EXIT_FAILURE;
+        }
+
+        printf("AES-CCM-128 encrypt %4u byte messages: key set up per message %" PRIu64 " msgs/s, key schedule reused %" PRIu64
+               " msgs/s\n",
+               static_cast<unsigned>(length), perMessageKey, cachedKey);
+    }
+
+    Platform::MemoryShutdown();
+
+    return result;
+}
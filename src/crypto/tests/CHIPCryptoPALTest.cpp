@@ -587,6 +587,169 @@ static void TestAES_CCM_128DecryptInvalidIVLen(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+// Run a test vector through AES_CCM_stream in place, splitting the data into 3 random pieces.
+template <typename Vector>
+static void CheckAES_CCM_StreamVector(nlTestSuite * inSuite, AES_CCM_stream & stream, const Vector * vector, bool encrypt,
+                                      CHIP_ERROR expected = CHIP_NO_ERROR)
+{
+    chip::Platform::ScopedMemoryBuffer<uint8_t> data;
+    uint8_t out_tag[16];
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    data.Alloc(vector->pt_len + 1);
+    NL_TEST_ASSERT(inSuite, data);
+    memcpy(data.Get(), encrypt ? vector->pt : vector->ct, vector->pt_len);
+
+    if (encrypt)
+    {
+        err = stream.BeginEncrypt(vector->iv, vector->iv_len, vector->aad, vector->aad_len, vector->pt_len, vector->tag_len);
+    }
+    else
+    {
+        err = stream.BeginDecrypt(vector->iv, vector->iv_len, vector->aad, vector->aad_len, vector->pt_len, vector->tag,
+                                  vector->tag_len);
+    }
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    uint8_t * piece  = data.Get();
+    size_t remaining = vector->pt_len;
+    for (int i = 0; i < 2; ++i)
+    {
+        size_t piece_length = static_cast<unsigned int>(rand()) % (remaining + 1);
+
+        err = stream.Update(piece, piece_length, piece);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        piece += piece_length;
+        remaining -= piece_length;
+    }
+
+    err = stream.Update(piece, remaining, piece);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    if (encrypt)
+    {
+        err = stream.FinishEncrypt(out_tag, vector->tag_len);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(data.Get(), vector->ct, vector->ct_len) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(out_tag, vector->tag, vector->tag_len) == 0);
+    }
+    else
+    {
+        err = stream.FinishDecrypt();
+        NL_TEST_ASSERT(inSuite, err == expected);
+        if (err == CHIP_NO_ERROR)
+        {
+            NL_TEST_ASSERT(inSuite, memcmp(data.Get(), vector->pt, vector->pt_len) == 0);
+        }
+    }
+}
+
+static void TestAES_CCM_StreamTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    AES_CCM_stream stream;
+    int numOfTestsRan = 0;
+
+    for (const ccm_128_test_vector * vector : ccm_128_test_vectors)
+    {
+        NL_TEST_ASSERT(inSuite, stream.SetKey(vector->key, vector->key_len) == CHIP_NO_ERROR);
+        if (vector->result == CHIP_NO_ERROR)
+        {
+            CheckAES_CCM_StreamVector(inSuite, stream, vector, true);
+        }
+        CheckAES_CCM_StreamVector(inSuite, stream, vector, false, vector->result);
+        numOfTestsRan++;
+    }
+
+    for (const ccm_test_vector * vector : ccm_test_vectors)
+    {
+        NL_TEST_ASSERT(inSuite, stream.SetKey(vector->key, vector->key_len) == CHIP_NO_ERROR);
+        CheckAES_CCM_StreamVector(inSuite, stream, vector, true);
+        CheckAES_CCM_StreamVector(inSuite, stream, vector, false);
+        numOfTestsRan++;
+    }
+
+    for (const ccm_test_vector * vector : ccm_invalid_test_vectors)
+    {
+        NL_TEST_ASSERT(inSuite, stream.SetKey(vector->key, vector->key_len) == CHIP_NO_ERROR);
+        CheckAES_CCM_StreamVector(inSuite, stream, vector, false, CHIP_ERROR_INTERNAL);
+        numOfTestsRan++;
+    }
+
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
+static void TestAES_CCM_StreamInvalidUse(nlTestSuite * inSuite, void * inContext)
+{
+    const ccm_128_test_vector * vector = ccm_128_test_vectors[0];
+    AES_CCM_stream stream;
+    uint8_t data[16];
+    uint8_t tag[16];
+
+    // No key
+    NL_TEST_ASSERT(inSuite,
+                   stream.BeginEncrypt(vector->iv, vector->iv_len, vector->aad, vector->aad_len, vector->pt_len,
+                                       vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, stream.SetKey(nullptr, 16) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, stream.SetKey(vector->key, 24) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, stream.SetKey(vector->key, vector->key_len) == CHIP_NO_ERROR);
+
+    // Not started
+    NL_TEST_ASSERT(inSuite, stream.Update(data, sizeof(data), data) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, stream.FinishEncrypt(tag, vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, stream.FinishDecrypt() == CHIP_ERROR_INCORRECT_STATE);
+
+    // Invalid parameters
+    NL_TEST_ASSERT(inSuite,
+                   stream.BeginEncrypt(vector->iv, 6, vector->aad, vector->aad_len, vector->pt_len, vector->tag_len) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite,
+                   stream.BeginEncrypt(vector->iv, vector->iv_len, vector->aad, vector->aad_len, vector->pt_len, 13) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite,
+                   stream.BeginDecrypt(vector->iv, vector->iv_len, vector->aad, vector->aad_len, vector->pt_len, nullptr,
+                                       vector->tag_len) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Data must match the length given up front
+    NL_TEST_ASSERT(inSuite,
+                   stream.BeginEncrypt(vector->iv, vector->iv_len, vector->aad, vector->aad_len, vector->pt_len,
+                                       vector->tag_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, stream.Update(data, vector->pt_len + 1, data) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, stream.FinishEncrypt(tag, vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+}
+
+static void TestAES_CCM_KeyScheduleReuse(nlTestSuite * inSuite, void * inContext)
+{
+    const ccm_128_test_vector * vector = ccm_128_test_vectors[0];
+    AES_CCM_stream stream;
+    uint8_t oneShot[37];
+    uint8_t oneShotTag[16];
+    uint8_t reused[sizeof(oneShot)];
+    uint8_t reusedTag[16];
+
+    NL_TEST_ASSERT(inSuite, stream.SetKey(vector->key, vector->key_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, stream.HasKey());
+
+    // A keyed stream gives the same results as the one-shot API message after message.
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        memset(oneShot, i, sizeof(oneShot));
+        memset(reused, i, sizeof(reused));
+
+        NL_TEST_ASSERT(inSuite,
+                       AES_CCM_encrypt(oneShot, sizeof(oneShot), vector->aad, vector->aad_len, vector->key, vector->key_len,
+                                       vector->iv, vector->iv_len, oneShot, oneShotTag, vector->tag_len) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite,
+                       stream.BeginEncrypt(vector->iv, vector->iv_len, vector->aad, vector->aad_len, sizeof(reused),
+                                           vector->tag_len) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, stream.Update(reused, sizeof(reused), reused) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, stream.FinishEncrypt(reusedTag, vector->tag_len) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, memcmp(oneShot, reused, sizeof(oneShot)) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(oneShotTag, reusedTag, vector->tag_len) == 0);
+    }
+}
+
 static void TestHash_SHA256(nlTestSuite * inSuite, void * inContext)
 {
     int numOfTestCases     = ArraySize(hash_sha256_test_vectors);
@@ -1453,6 +1616,9 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid key", TestAES_CCM_256DecryptInvalidKey),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid IV", TestAES_CCM_256DecryptInvalidIVLen),
     NL_TEST_DEF("Test decrypting AES-CCM-256 invalid vectors", TestAES_CCM_256DecryptInvalidTestVectors),
+    NL_TEST_DEF("Test AES-CCM stream test vectors", TestAES_CCM_StreamTestVectors),
+    NL_TEST_DEF("Test AES-CCM stream invalid use", TestAES_CCM_StreamInvalidUse),
+    NL_TEST_DEF("Test AES-CCM key schedule reuse", TestAES_CCM_KeyScheduleReuse),
     NL_TEST_DEF("Test ECDSA signing and validation message using SHA256", TestECDSA_Signing_SHA256_Msg),
     NL_TEST_DEF("Test ECDSA signing and validation SHA256 Hash", TestECDSA_Signing_SHA256_Hash),
     NL_TEST_DEF("Test ECDSA signature validation fail - Different msg", TestECDSA_ValidationFailsDifferentMessage),
@@ -0,0 +1,369 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the CryptoWorkerPool.
+ */
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CryptoWorkerPool.h>
+#include <nlunit-test.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <system/SystemLayer.h>
+
+#include <atomic>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::Crypto;
+
+namespace {
+
+constexpr uint64_t kCompletionTimeoutUs = 10 * 1000 * 1000;
+
+// Stands in for PlatformMgr().ScheduleWork(): the work the pool schedules is called by RunCompletions() on the test
+// thread, which plays the CHIP thread.
+std::atomic<bool> sWorkScheduled(false);
+CryptoWorkerPool::WorkFunct sScheduledWorkFunct = nullptr;
+intptr_t sScheduledWorkArg                      = 0;
+
+void ScheduleWork(CryptoWorkerPool::WorkFunct workFunct, intptr_t arg)
+{
+    sScheduledWorkFunct = workFunct;
+    sScheduledWorkArg   = arg;
+    sWorkScheduled.store(true);
+}
+
+pthread_t sTestThread;
+uint32_t sNumCompleted = 0;
+
+// Once the threads are joined nothing is scheduled anymore; forget what was, as it refers to the pool.
+void ShutdownPool(CryptoWorkerPool & pool)
+{
+    pool.Shutdown();
+    sWorkScheduled.store(false);
+}
+
+// Call the work the pool schedules until the given number of jobs completed, or the timeout expired.
+bool RunCompletions(uint32_t numCompleted)
+{
+    uint64_t deadline = System::Layer::GetClock_MonotonicHiRes() + kCompletionTimeoutUs;
+
+    while (sNumCompleted < numCompleted)
+    {
+        if (sWorkScheduled.exchange(false))
+        {
+            sScheduledWorkFunct(sScheduledWorkArg);
+            continue;
+        }
+        VerifyOrReturnError(System::Layer::GetClock_MonotonicHiRes() < deadline, false);
+        sched_yield();
+    }
+    return true;
+}
+
+class TestJob : public CryptoJob
+{
+public:
+    CHIP_ERROR Run() override
+    {
+        mStarted.store(true);
+        if (mRunTimeUs > 0)
+        {
+            usleep(mRunTimeUs);
+        }
+        mRanOffTestThread = !pthread_equal(pthread_self(), sTestThread);
+        mNumRuns.fetch_add(1);
+        return mRunResult;
+    }
+
+    void OnComplete(CHIP_ERROR result) override
+    {
+        mCompletedOnTestThread = pthread_equal(pthread_self(), sTestThread);
+        mCompletedResult       = result;
+        mNumCompletions++;
+        sNumCompleted++;
+    }
+
+    CHIP_ERROR mRunResult = CHIP_NO_ERROR;
+    useconds_t mRunTimeUs = 0;
+
+    std::atomic<bool> mStarted{ false };
+    std::atomic<uint32_t> mNumRuns{ 0 };
+    bool mRanOffTestThread = false;
+
+    bool mCompletedOnTestThread = false;
+    CHIP_ERROR mCompletedResult = CHIP_NO_ERROR;
+    uint32_t mNumCompletions    = 0;
+};
+
+// The work of one side of a CASE handshake: an ephemeral key, an ECDH key agreement, and an ECDSA signature, which
+// the peer verifies.
+class HandshakeJob : public CryptoJob
+{
+public:
+    CHIP_ERROR Run() override
+    {
+        P256Keypair ephemeralKey;
+        P256ECDHDerivedSecret secret;
+        P256ECDSASignature signature;
+
+        ReturnErrorOnFailure(ephemeralKey.Initialize());
+        ReturnErrorOnFailure(ephemeralKey.ECDH_derive_secret(mPeerKey->Pubkey(), secret));
+        ReturnErrorOnFailure(ephemeralKey.ECDSA_sign_msg(secret, secret.Length(), signature));
+        return ephemeralKey.Pubkey().ECDSA_validate_msg_signature(secret, secret.Length(), signature);
+    }
+
+    void OnComplete(CHIP_ERROR result) override
+    {
+        mResult = result;
+        sNumCompleted++;
+    }
+
+    const P256Keypair * mPeerKey = nullptr;
+    CHIP_ERROR mResult           = CHIP_ERROR_INCORRECT_STATE;
+};
+
+void TestInit(nlTestSuite * inSuite, void * inContext)
+{
+    CryptoWorkerPool pool;
+    TestJob job;
+
+    NL_TEST_ASSERT(inSuite, pool.Init(0, ScheduleWork) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, pool.Init(CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT + 1, ScheduleWork) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, pool.Init(1, nullptr) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, pool.Submit(job) == CHIP_ERROR_INCORRECT_STATE);
+
+    NL_TEST_ASSERT(inSuite, pool.Init(2, ScheduleWork) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pool.Init(2, ScheduleWork) == CHIP_ERROR_INCORRECT_STATE);
+
+    pool.Shutdown();
+    NL_TEST_ASSERT(inSuite, pool.Submit(job) == CHIP_ERROR_INCORRECT_STATE);
+
+    // The pool can be started again once shut down
+    NL_TEST_ASSERT(inSuite, pool.Init(1, ScheduleWork) == CHIP_NO_ERROR);
+}
+
+void TestSubmit(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint32_t kNumJobs = 32;
+
+    CryptoWorkerPool pool;
+    TestJob jobs[kNumJobs];
+
+    sNumCompleted = 0;
+    NL_TEST_ASSERT(inSuite, pool.Init(4, ScheduleWork) == CHIP_NO_ERROR);
+
+    for (uint32_t i = 0; i < kNumJobs; i++)
+    {
+        jobs[i].mRunResult = (i % 3 == 0) ? CHIP_ERROR_INVALID_SIGNATURE : CHIP_NO_ERROR;
+        NL_TEST_ASSERT(inSuite, pool.Submit(jobs[i]) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, RunCompletions(kNumJobs));
+
+    // Each job ran once off the CHIP thread, and completed once on it with the result of its run
+    for (uint32_t i = 0; i < kNumJobs; i++)
+    {
+        NL_TEST_ASSERT(inSuite, jobs[i].mNumRuns == 1);
+        NL_TEST_ASSERT(inSuite, jobs[i].mNumCompletions == 1);
+        NL_TEST_ASSERT(inSuite, jobs[i].mRanOffTestThread);
+        NL_TEST_ASSERT(inSuite, jobs[i].mCompletedOnTestThread);
+        NL_TEST_ASSERT(inSuite, jobs[i].mCompletedResult == jobs[i].mRunResult);
+    }
+
+    // A job can be submitted again once it completed, but not while it is submitted
+    NL_TEST_ASSERT(inSuite, pool.Submit(jobs[0]) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pool.Submit(jobs[0]) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, RunCompletions(kNumJobs + 1));
+    NL_TEST_ASSERT(inSuite, jobs[0].mNumCompletions == 2);
+
+    ShutdownPool(pool);
+}
+
+void TestCancel(nlTestSuite * inSuite, void * inContext)
+{
+    CryptoWorkerPool pool;
+    TestJob running;
+    TestJob queued;
+    TestJob completed;
+    TestJob next;
+    TestJob idle;
+
+    sNumCompleted = 0;
+    NL_TEST_ASSERT(inSuite, pool.Init(1, ScheduleWork) == CHIP_NO_ERROR);
+
+    // A job waiting for the only thread is withdrawn without running
+    running.mRunTimeUs = 50 * 1000;
+    NL_TEST_ASSERT(inSuite, pool.Submit(running) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pool.Submit(queued) == CHIP_NO_ERROR);
+    while (!running.mStarted.load())
+    {
+        sched_yield();
+    }
+    pool.Cancel(queued);
+
+    // A running job is waited for, and does not complete
+    pool.Cancel(running);
+    NL_TEST_ASSERT(inSuite, running.mNumRuns == 1);
+
+    // Neither does a job that ran, but whose completion was not dispatched yet
+    NL_TEST_ASSERT(inSuite, pool.Submit(completed) == CHIP_NO_ERROR);
+    while (completed.mNumRuns.load() == 0)
+    {
+        sched_yield();
+    }
+    pool.Cancel(completed);
+
+    // Withdrawing a job that is not submitted does nothing
+    pool.Cancel(idle);
+
+    NL_TEST_ASSERT(inSuite, pool.Submit(next) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, RunCompletions(1));
+    NL_TEST_ASSERT(inSuite, next.mNumCompletions == 1);
+
+    NL_TEST_ASSERT(inSuite, queued.mNumRuns == 0);
+    NL_TEST_ASSERT(inSuite, running.mNumCompletions == 0);
+    NL_TEST_ASSERT(inSuite, queued.mNumCompletions == 0);
+    NL_TEST_ASSERT(inSuite, completed.mNumCompletions == 0);
+    NL_TEST_ASSERT(inSuite, idle.mNumCompletions == 0);
+
+    ShutdownPool(pool);
+}
+
+// Run the crypto of concurrent handshakes, which share the DRBG, on several threads.
+void TestConcurrentHandshakes(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint32_t kNumJobs = 16;
+
+    CryptoWorkerPool pool;
+    P256Keypair peerKey;
+    auto * jobs = new HandshakeJob[kNumJobs];
+
+    sNumCompleted = 0;
+    NL_TEST_ASSERT(inSuite, peerKey.Initialize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pool.Init(4, ScheduleWork) == CHIP_NO_ERROR);
+
+    for (uint32_t i = 0; i < kNumJobs; i++)
+    {
+        jobs[i].mPeerKey = &peerKey;
+        NL_TEST_ASSERT(inSuite, pool.Submit(jobs[i]) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, RunCompletions(kNumJobs));
+
+    for (uint32_t i = 0; i < kNumJobs; i++)
+    {
+        NL_TEST_ASSERT(inSuite, jobs[i].mResult == CHIP_NO_ERROR);
+    }
+
+    ShutdownPool(pool);
+    delete[] jobs;
+}
+
+// Stands in for a scheduler that cannot get the CHIP stack lock, because the CHIP thread shuts the pool down with the
+// lock held: it gives up once the pool shuts down.
+CryptoWorkerPool * sBlockedPool = nullptr;
+
+void BlockedScheduleWork(CryptoWorkerPool::WorkFunct workFunct, intptr_t arg)
+{
+    while (!sBlockedPool->IsShuttingDown())
+    {
+        sched_yield();
+    }
+}
+
+void TestShutdown(nlTestSuite * inSuite, void * inContext)
+{
+    CryptoWorkerPool pool;
+    TestJob job;
+
+    sBlockedPool = &pool;
+    NL_TEST_ASSERT(inSuite, pool.Init(1, BlockedScheduleWork) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !pool.IsShuttingDown());
+
+    // The worker waits to schedule the completion of the job; shutting down joins it, and drops the completion
+    NL_TEST_ASSERT(inSuite, pool.Submit(job) == CHIP_NO_ERROR);
+    while (job.mNumRuns.load() == 0)
+    {
+        sched_yield();
+    }
+    pool.Shutdown();
+
+    NL_TEST_ASSERT(inSuite, pool.IsShuttingDown());
+    NL_TEST_ASSERT(inSuite, job.mNumCompletions == 0);
+
+    sBlockedPool = nullptr;
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("Init",       TestInit),
+    NL_TEST_DEF("Submit",     TestSubmit),
+    NL_TEST_DEF("Cancel",     TestCancel),
+    NL_TEST_DEF("Concurrent", TestConcurrentHandshakes),
+    NL_TEST_DEF("Shutdown",   TestShutdown),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestSetup(void * inContext)
+{
+    sTestThread = pthread_self();
+
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return FAILURE;
+    return SUCCESS;
+}
+
+int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestCryptoWorkerPool()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "CryptoWorkerPool",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestCryptoWorkerPool)
@@ -91,6 +91,19 @@
 #define CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE 100
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT
+ *
+ * The number of threads the ECDH and ECDSA operations of CASE handshakes are offloaded to, so that
+ * concurrent handshakes do not stall the chip task. 0 runs them on the chip task.
+ *
+ * Only platforms that provide a crypto worker pool honor this; at most
+ * CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT. Linux provides one and runs 4 threads by default.
+ */
+#ifndef CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT
+#define CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT 0
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_ENABLE_FACTORY_PROVISIONING
  *
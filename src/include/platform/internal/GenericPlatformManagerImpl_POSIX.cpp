@@ -211,6 +211,7 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysProcess()
     }
 #endif // !(CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK)
 
+    Impl()->_ProcessCrossThreadWork();
     ProcessDeviceEvents();
 #if CHIP_DEVICE_CONFIG_ENABLE_MDNS
     chip::Mdns::ProcessMdns(mReadSet, mWriteSet, mErrorSet);
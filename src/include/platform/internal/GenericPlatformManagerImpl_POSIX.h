@@ -90,6 +90,15 @@ protected:
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
 
+    // ===== Methods the implementation subclass may override.
+
+    /**
+     * Runs work other threads handed over to the chip task without taking the CHIP stack lock. It is called on the chip
+     * task, with the CHIP stack locked, every time the event loop wakes up; a thread hands work over by queuing it and
+     * calling SystemLayer.WakeSelect().
+     */
+    void _ProcessCrossThreadWork() {}
+
     // ===== Methods available to the implementation subclass.
 
 private:
@@ -27,6 +27,9 @@
 
 #include <inet/InetLayer.h>
 
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+
 namespace chip {
 namespace Inet {
 
@@ -42,8 +45,42 @@ void EndPointBasis::InitEndPointBasis(InetLayer & aInetLayer, void * aAppState)
     mSocket = INET_INVALID_SOCKET_FD;
     mPendingIO.Clear();
     mRequestIO.Clear();
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_Unknown;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+/**
+ *  Propagate a change of mRequestIO to the System Layer.
+ *
+ *  With the select() backend the requested events are collected on every event loop iteration and this is a no-op. With
+ *  the epoll backend the socket registration is persistent, so it must be updated whenever mRequestIO changes.
+ */
+void EndPointBasis::UpdateSocketWatch()
+{
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    if (mSocket != INET_INVALID_SOCKET_FD)
+    {
+        chip::System::Error err = SystemLayer().UpdateSocketWatch(mSocket, mRequestIO.ToEpollEvents(), this);
+        if (err != CHIP_SYSTEM_NO_ERROR)
+            ChipLogError(Inet, "Failed to watch socket %d: %s", mSocket, ErrorStr(err));
+    }
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+
+/**
+ *  Stop watching the socket for I/O. Must be called before the socket is closed.
+ */
+void EndPointBasis::StopSocketWatch()
+{
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    if (mSocket != INET_INVALID_SOCKET_FD)
+        SystemLayer().StopSocketWatch(mSocket, this);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
 } // namespace Inet
 } // namespace chip
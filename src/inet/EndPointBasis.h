@@ -61,6 +61,10 @@ namespace Inet {
  */
 class DLL_EXPORT EndPointBasis : public InetLayerBasis
 {
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    friend class InetLayer;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 public:
     /** Common state codes */
     enum
@@ -97,7 +101,23 @@ protected:
     IPAddressType mAddrType; /**< Protocol family, i.e. IPv4 or IPv6. */
     SocketEvents mPendingIO; /**< Socket event masks (read/write/error) currently available */
     SocketEvents mRequestIO; /**< Socket event masks (read/write) to wait for */
-#endif                       // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    enum
+    {
+        kSocketEndPointType_Unknown = 0,
+
+        kSocketEndPointType_Raw = 1,
+        kSocketEndPointType_UDP = 2,
+        kSocketEndPointType_TCP = 3
+    };
+
+    uint8_t mSocketEndPointType; /**< Concrete endpoint type, used to dispatch epoll events. */
+#endif                           // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+    void UpdateSocketWatch();
+    void StopSocketWatch();
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     /** Encapsulated LwIP protocol control block */
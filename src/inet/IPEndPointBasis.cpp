@@ -834,32 +834,48 @@ INET_ERROR IPEndPointBasis::BindInterface(IPAddressType aAddressType, InterfaceI
     return (lRetval);
 }
 
-INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBufferHandle && aBuffer, uint16_t aSendFlags)
+namespace {
+
+// Storage referenced by the message header describing one outbound datagram.
+struct SendMsgStorage
 {
-    INET_ERROR res = INET_NO_ERROR;
     PeerSockAddr peerSockAddr;
-    struct iovec msgIOV;
-    uint8_t controlData[256];
-    struct msghdr msgHeader;
-    InterfaceId intfId = aPktInfo->Interface;
+    struct iovec msgIOV[INET_CONFIG_MAX_SEND_SEGMENTS]; // One per non-empty buffer in the chain
+    uint8_t controlData[64];                            // Room for one IP_PKTINFO or IPV6_PKTINFO control message
+};
+
+INET_ERROR BuildSendMsgHeader(IPAddressType aAddrType, InterfaceId aBoundIntfId, const IPPacketInfo * aPktInfo,
+                              const chip::System::PacketBufferHandle & aBuffer, SendMsgStorage & aStorage,
+                              struct msghdr & msgHeader)
+{
+    INET_ERROR res             = INET_NO_ERROR;
+    PeerSockAddr & peerSockAddr = aStorage.peerSockAddr;
+    uint8_t * controlData       = aStorage.controlData;
+    InterfaceId intfId          = aPktInfo->Interface;
+    chip::ByteSpan segments[INET_CONFIG_MAX_SEND_SEGMENTS];
+    size_t segmentCount;
 
     // Ensure the destination address type is compatible with the endpoint address type.
-    VerifyOrExit(mAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
+    VerifyOrExit(aAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
 
-    // For now the entire message must fit within a single buffer.
-    VerifyOrExit(!aBuffer->HasChainedBuffer(), res = INET_ERROR_MESSAGE_TOO_LONG);
+    // Gather the buffers of the chain directly, rather than compacting them into one.
+    segmentCount = aBuffer.GetDataSegments(segments, INET_CONFIG_MAX_SEND_SEGMENTS);
+    VerifyOrExit(segmentCount <= INET_CONFIG_MAX_SEND_SEGMENTS, res = INET_ERROR_MESSAGE_TOO_LONG);
 
     memset(&msgHeader, 0, sizeof(msgHeader));
 
-    msgIOV.iov_base      = aBuffer->Start();
-    msgIOV.iov_len       = aBuffer->DataLength();
-    msgHeader.msg_iov    = &msgIOV;
-    msgHeader.msg_iovlen = 1;
+    for (size_t i = 0; i < segmentCount; i++)
+    {
+        aStorage.msgIOV[i].iov_base = const_cast<uint8_t *>(segments[i].data());
+        aStorage.msgIOV[i].iov_len  = segments[i].size();
+    }
+    msgHeader.msg_iov    = aStorage.msgIOV;
+    msgHeader.msg_iovlen = static_cast<decltype(msgHeader.msg_iovlen)>(segmentCount);
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
     msgHeader.msg_name = &peerSockAddr;
-    if (mAddrType == kIPAddressType_IPv6)
+    if (aAddrType == kIPAddressType_IPv6)
     {
         peerSockAddr.in6.sin6_family = AF_INET6;
         peerSockAddr.in6.sin6_port   = htons(aPktInfo->DestPort);
@@ -885,7 +901,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
     // don't seem to get sent out the correct interface, despite
     // the socket being bound.
     if (intfId == INET_NULL_INTERFACEID)
-        intfId = mBoundIntfId;
+        intfId = aBoundIntfId;
 
     // If the packet should be sent over a specific interface, or with a specific source
     // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
@@ -894,15 +910,15 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
     if (intfId != INET_NULL_INTERFACEID || aPktInfo->SrcAddress.Type() != kIPAddressType_Any)
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        memset(controlData, 0, sizeof(controlData));
+        memset(controlData, 0, sizeof(aStorage.controlData));
         msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_controllen = sizeof(aStorage.controlData);
 
         struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader);
 
 #if INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv4)
+        if (aAddrType == kIPAddressType_IPv4)
         {
 #if defined(IP_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IP;
@@ -926,7 +942,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
 
 #endif // INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv6)
+        if (aAddrType == kIPAddressType_IPv6)
         {
 #if defined(IPV6_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IPV6;
@@ -953,12 +969,27 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
 #endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
     }
 
+exit:
+    return (res);
+}
+
+} // namespace
+
+INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBufferHandle && aBuffer, uint16_t aSendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+    SendMsgStorage storage;
+    struct msghdr msgHeader;
+
+    res = BuildSendMsgHeader(mAddrType, mBoundIntfId, aPktInfo, aBuffer, storage, msgHeader);
+    SuccessOrExit(res);
+
     // Send IP packet.
     {
         const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
         if (lenSent == -1)
             res = chip::System::MapErrorPOSIX(errno);
-        else if (lenSent != aBuffer->DataLength())
+        else if (lenSent != aBuffer->TotalLength())
             res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
     }
 
@@ -966,6 +997,66 @@ exit:
     return (res);
 }
 
+INET_ERROR IPEndPointBasis::SendMsgs(const IPPacketInfo * aPktInfos, const chip::System::PacketBufferHandle * aBuffers,
+                                     size_t aCount, size_t & aSentCount)
+{
+    aSentCount = 0;
+
+#if HAVE_SENDMMSG
+    while (aSentCount < aCount)
+    {
+        SendMsgStorage storage[INET_CONFIG_UDP_BATCH_SIZE];
+        struct mmsghdr msgHeaders[INET_CONFIG_UDP_BATCH_SIZE];
+        unsigned int numMsgs = 0;
+        INET_ERROR buildRes  = INET_NO_ERROR;
+
+        // Describe as many of the remaining messages as fit in one batch, stopping short of any that cannot be sent.
+        while (numMsgs < INET_CONFIG_UDP_BATCH_SIZE && aSentCount + numMsgs < aCount)
+        {
+            const size_t index = aSentCount + numMsgs;
+
+            buildRes = BuildSendMsgHeader(mAddrType, mBoundIntfId, &aPktInfos[index], aBuffers[index], storage[numMsgs],
+                                          msgHeaders[numMsgs].msg_hdr);
+            if (buildRes != INET_NO_ERROR)
+                break;
+
+            msgHeaders[numMsgs].msg_len = 0;
+            numMsgs++;
+        }
+
+        if (numMsgs > 0)
+        {
+            const int numSent = sendmmsg(mSocket, msgHeaders, numMsgs, 0);
+            if (numSent < 0)
+                return chip::System::MapErrorPOSIX(errno);
+
+            SYSTEM_STATS_SET(chip::System::Stats::kInetLayer_NumUDPSendBatch, static_cast<chip::System::Stats::count_t>(numSent));
+
+            for (int i = 0; i < numSent; i++)
+            {
+                const bool truncated = msgHeaders[i].msg_len != aBuffers[aSentCount]->TotalLength();
+
+                aSentCount++;
+                VerifyOrReturnError(!truncated, INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED);
+            }
+
+            // The kernel stopped early; pick up again from the first message it did not take.
+            if (static_cast<unsigned int>(numSent) < numMsgs)
+                continue;
+        }
+
+        ReturnErrorOnFailure(buildRes);
+    }
+#else  // !HAVE_SENDMMSG
+    for (; aSentCount < aCount; aSentCount++)
+    {
+        ReturnErrorOnFailure(SendMsg(&aPktInfos[aSentCount], aBuffers[aSentCount].Retain(), 0));
+    }
+#endif // HAVE_SENDMMSG
+
+    return INET_NO_ERROR;
+}
+
 INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int aProtocol)
 {
     INET_ERROR res = INET_NO_ERROR;
@@ -1078,8 +1169,77 @@ INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int
     return INET_NO_ERROR;
 }
 
+namespace {
+
+// Fill in the source and destination information of a datagram received with recvmsg() or recvmmsg().
+INET_ERROR ParseRecvMsgHeader(const PeerSockAddr & aPeerSockAddr, struct msghdr & msgHeader, IPPacketInfo & aPacketInfo)
+{
+    if (aPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv6(aPeerSockAddr.in6.sin6_addr);
+        aPacketInfo.SrcPort    = ntohs(aPeerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (aPeerSockAddr.any.sa_family == AF_INET)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv4(aPeerSockAddr.in.sin_addr);
+        aPacketInfo.SrcPort    = ntohs(aPeerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return INET_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId>(inPktInfo->ipi_ifindex))
+            {
+                return INET_ERROR_INCORRECT_STATE;
+            }
+            aPacketInfo.Interface   = static_cast<InterfaceId>(inPktInfo->ipi_ifindex);
+            aPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            struct in6_pktinfo * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId>(in6PktInfo->ipi6_ifindex))
+            {
+                return INET_ERROR_INCORRECT_STATE;
+            }
+            aPacketInfo.Interface   = static_cast<InterfaceId>(in6PktInfo->ipi6_ifindex);
+            aPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return INET_NO_ERROR;
+}
+
+} // namespace
+
 void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 {
+#if HAVE_RECVMMSG
+    if (INET_CONFIG_UDP_BATCH_SIZE > 1)
+    {
+        HandlePendingIOBatch(aPort);
+        return;
+    }
+#endif // HAVE_RECVMMSG
+
     INET_ERROR lStatus = INET_NO_ERROR;
     IPPacketInfo lPacketInfo;
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
@@ -1128,61 +1288,7 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = INET_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == INET_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    struct in_pktinfo * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = INET_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = static_cast<InterfaceId>(inPktInfo->ipi_ifindex);
-                    lPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    struct in6_pktinfo * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = INET_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = static_cast<InterfaceId>(in6PktInfo->ipi6_ifindex);
-                    lPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = ParseRecvMsgHeader(lPeerSockAddr, msgHeader, lPacketInfo);
         }
     }
     else
@@ -1224,6 +1330,102 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
         }
     }
 }
+
+#if HAVE_RECVMMSG
+void IPEndPointBasis::HandlePendingIOBatch(uint16_t aPort)
+{
+    INET_ERROR lStatus = INET_NO_ERROR;
+    System::PacketBufferHandle lBuffers[INET_CONFIG_UDP_BATCH_SIZE];
+    struct mmsghdr lMsgHeaders[INET_CONFIG_UDP_BATCH_SIZE];
+    struct iovec lMsgIOVs[INET_CONFIG_UDP_BATCH_SIZE];
+    PeerSockAddr lPeerSockAddrs[INET_CONFIG_UDP_BATCH_SIZE];
+    uint8_t lControlData[INET_CONFIG_UDP_BATCH_SIZE][64];
+    unsigned int lNumBuffers = 0;
+
+    memset(lMsgHeaders, 0, sizeof(lMsgHeaders));
+    memset(lPeerSockAddrs, 0, sizeof(lPeerSockAddrs));
+
+    // Post as many receive buffers as are available, up to a full batch.
+    for (; lNumBuffers < INET_CONFIG_UDP_BATCH_SIZE; lNumBuffers++)
+    {
+        lBuffers[lNumBuffers] = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+        if (lBuffers[lNumBuffers].IsNull())
+            break;
+
+        struct msghdr & msgHeader = lMsgHeaders[lNumBuffers].msg_hdr;
+
+        lMsgIOVs[lNumBuffers].iov_base = lBuffers[lNumBuffers]->Start();
+        lMsgIOVs[lNumBuffers].iov_len  = lBuffers[lNumBuffers]->AvailableDataLength();
+
+        msgHeader.msg_name       = &lPeerSockAddrs[lNumBuffers];
+        msgHeader.msg_namelen    = sizeof(lPeerSockAddrs[lNumBuffers]);
+        msgHeader.msg_iov        = &lMsgIOVs[lNumBuffers];
+        msgHeader.msg_iovlen     = 1;
+        msgHeader.msg_control    = lControlData[lNumBuffers];
+        msgHeader.msg_controllen = sizeof(lControlData[lNumBuffers]);
+    }
+
+    if (lNumBuffers == 0)
+    {
+        lStatus = INET_ERROR_NO_MEMORY;
+    }
+    else
+    {
+        const int lNumReceived = recvmmsg(mSocket, lMsgHeaders, lNumBuffers, MSG_DONTWAIT, nullptr);
+
+        if (lNumReceived < 0)
+        {
+            lStatus = chip::System::MapErrorPOSIX(errno);
+        }
+        else
+        {
+            SYSTEM_STATS_SET(chip::System::Stats::kInetLayer_NumUDPRecvBatch,
+                             static_cast<chip::System::Stats::count_t>(lNumReceived));
+        }
+
+        for (int i = 0; i < lNumReceived; i++)
+        {
+            // The application may have closed the endpoint while handling an earlier datagram of the batch.
+            if (mState != kState_Listening || OnMessageReceived == nullptr)
+                break;
+
+            struct msghdr & msgHeader = lMsgHeaders[i].msg_hdr;
+            IPPacketInfo lPacketInfo;
+            INET_ERROR lMsgStatus = INET_NO_ERROR;
+
+            lPacketInfo.Clear();
+            lPacketInfo.DestPort = aPort;
+
+            if (msgHeader.msg_flags & MSG_TRUNC)
+            {
+                lMsgStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
+            }
+            else
+            {
+                lBuffers[i]->SetDataLength(static_cast<uint16_t>(lMsgHeaders[i].msg_len));
+
+                lMsgStatus = ParseRecvMsgHeader(lPeerSockAddrs[i], msgHeader, lPacketInfo);
+            }
+
+            if (lMsgStatus == INET_NO_ERROR)
+            {
+                lBuffers[i].RightSize();
+
+                OnMessageReceived(this, std::move(lBuffers[i]), &lPacketInfo);
+            }
+            else if (OnReceiveError != nullptr)
+            {
+                OnReceiveError(this, lMsgStatus, nullptr);
+            }
+        }
+    }
+
+    if (lStatus != INET_NO_ERROR && OnReceiveError != nullptr && lStatus != chip::System::MapErrorPOSIX(EAGAIN))
+    {
+        OnReceiveError(this, lStatus, nullptr);
+    }
+}
+#endif // HAVE_RECVMMSG
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
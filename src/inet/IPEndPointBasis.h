@@ -137,8 +137,13 @@ protected:
     INET_ERROR Bind(IPAddressType aAddressType, const IPAddress & aAddress, uint16_t aPort, InterfaceId aInterfaceId);
     INET_ERROR BindInterface(IPAddressType aAddressType, InterfaceId aInterfaceId);
     INET_ERROR SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBufferHandle && aBuffer, uint16_t aSendFlags);
+    INET_ERROR SendMsgs(const IPPacketInfo * aPktInfos, const chip::System::PacketBufferHandle * aBuffers, size_t aCount,
+                        size_t & aSentCount);
     INET_ERROR GetSocket(IPAddressType aAddressType, int aType, int aProtocol);
     void HandlePendingIO(uint16_t aPort);
+#if HAVE_RECVMMSG
+    void HandlePendingIOBatch(uint16_t aPort);
+#endif // HAVE_RECVMMSG
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -259,6 +259,42 @@
 #define INET_CONFIG_NUM_UDP_ENDPOINTS                       64
 #endif // INET_CONFIG_NUM_UDP_ENDPOINTS
 
+/**
+ *  @def INET_CONFIG_UDP_BATCH_SIZE
+ *
+ *  @brief
+ *    This is the maximum number of datagrams a UDP end point receives
+ *    per readiness event, or sends per system call, on platforms that
+ *    provide recvmmsg() and sendmmsg() (HAVE_RECVMMSG, HAVE_SENDMMSG).
+ *
+ *    A receive batch holds this many maximum-sized packet buffers.
+ *
+ */
+#ifndef INET_CONFIG_UDP_BATCH_SIZE
+#define INET_CONFIG_UDP_BATCH_SIZE                          8
+#endif // INET_CONFIG_UDP_BATCH_SIZE
+
+#if INET_CONFIG_UDP_BATCH_SIZE < 1 || INET_CONFIG_UDP_BATCH_SIZE > 64
+#error "INET_CONFIG_UDP_BATCH_SIZE must be between 1 and 64"
+#endif
+
+/**
+ *  @def INET_CONFIG_MAX_SEND_SEGMENTS
+ *
+ *  @brief
+ *    This is the maximum number of packet buffers in a chain that a
+ *    UDP or TCP end point hands to the system in a single scatter-gather
+ *    send on sockets platforms.
+ *
+ *    A UDP message whose chain has more non-empty buffers than this is
+ *    rejected with #INET_ERROR_MESSAGE_TOO_LONG. A TCP end point sends
+ *    longer chains in several calls.
+ *
+ */
+#ifndef INET_CONFIG_MAX_SEND_SEGMENTS
+#define INET_CONFIG_MAX_SEND_SEGMENTS                       8
+#endif // INET_CONFIG_MAX_SEND_SEGMENTS
+
 /**
  *  @def INET_CONFIG_NUM_DNS_RESOLVERS
  *
@@ -1119,6 +1119,15 @@ void InetLayer::PrepareSelect(int & nfds, fd_set * readfds, fd_set * writefds, f
     if (State != kState_Initialized)
         return;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    // Endpoint sockets are registered persistently with the System Layer's epoll instance, which the System Layer has already
+    // added to the descriptor sets.
+    (void) nfds;
+    (void) readfds;
+    (void) writefds;
+    (void) exceptfds;
+    (void) sleepTimeTV;
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
     for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
     {
@@ -1145,6 +1154,7 @@ void InetLayer::PrepareSelect(int & nfds, fd_set * readfds, fd_set * writefds, f
             lEndPoint->mRequestIO.SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
     }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 /**
@@ -1184,6 +1194,57 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
     if (selectRes < 0)
         return;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    (void) readfds;
+    (void) writefds;
+    (void) exceptfds;
+
+    // Only the sockets harvested from epoll by System::Layer::HandleSelectResult() are visited. As with select, the pending
+    // I/O field of every ready endpoint is set before any callback is made. Endpoints closed by an earlier callback have
+    // their entry cleared by EndPointBasis::StopSocketWatch(), so the context pointer is re-read for each dispatch.
+    const struct epoll_event * lEvents;
+    const size_t lEventCount = mSystemLayer->GetReadySocketEvents(lEvents);
+
+    for (size_t i = 0; i < lEventCount; i++)
+    {
+        EndPointBasis * lEndPoint = static_cast<EndPointBasis *>(lEvents[i].data.ptr);
+        if ((lEndPoint != nullptr) && lEndPoint->IsCreatedByInetLayer(*this))
+        {
+            lEndPoint->mPendingIO = SocketEvents::FromEpollEvents(lEvents[i].events);
+        }
+    }
+
+    for (size_t i = 0; i < lEventCount; i++)
+    {
+        EndPointBasis * lEndPoint = static_cast<EndPointBasis *>(lEvents[i].data.ptr);
+        if ((lEndPoint == nullptr) || !lEndPoint->IsCreatedByInetLayer(*this))
+            continue;
+
+        switch (lEndPoint->mSocketEndPointType)
+        {
+#if INET_CONFIG_ENABLE_RAW_ENDPOINT
+        case EndPointBasis::kSocketEndPointType_Raw:
+            static_cast<RawEndPoint *>(lEndPoint)->HandlePendingIO();
+            break;
+#endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+        case EndPointBasis::kSocketEndPointType_TCP:
+            static_cast<TCPEndPoint *>(lEndPoint)->HandlePendingIO();
+            break;
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+        case EndPointBasis::kSocketEndPointType_UDP:
+            static_cast<UDPEndPoint *>(lEndPoint)->HandlePendingIO();
+            break;
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+        default:
+            break;
+        }
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     if (selectRes > 0)
     {
         // Set the pending I/O field for each active endpoint based on the value returned by select.
@@ -1254,6 +1315,7 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
         }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -87,6 +87,49 @@ SocketEvents SocketEvents::FromFDs(int socket, fd_set * readfds, fd_set * writef
 
     return res;
 }
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Convert the requested read and write bit flags into an epoll event mask.
+ *
+ *  @return The epoll event mask. Errors and hang-ups are always reported by epoll and need not be requested.
+ *
+ */
+uint32_t SocketEvents::ToEpollEvents() const
+{
+    uint32_t events = 0;
+
+    if (IsReadable())
+        events |= EPOLLIN;
+    if (IsWriteable())
+        events |= EPOLLOUT;
+
+    return events;
+}
+
+/**
+ *  Set the read, write or exception bit flags based on an epoll event mask.
+ *
+ *  @param[in]    events    The epoll event mask returned for a socket.
+ *
+ *  @note
+ *    A hang-up is reported as readable, matching select(), so that the subsequent read observes the end of stream.
+ *
+ */
+SocketEvents SocketEvents::FromEpollEvents(uint32_t events)
+{
+    SocketEvents res;
+
+    if (events & (EPOLLIN | EPOLLHUP))
+        res.SetRead();
+    if (events & EPOLLOUT)
+        res.SetWrite();
+    if (events & EPOLLERR)
+        res.SetError();
+
+    return res;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
@@ -34,6 +34,9 @@
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #include <sys/select.h>
 #endif
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif
 
 namespace chip {
 namespace Inet {
@@ -207,6 +210,11 @@ public:
 
     void SetFDs(int socket, int & nfds, fd_set * readfds, fd_set * writefds, fd_set * exceptfds);
     static SocketEvents FromFDs(int socket, fd_set * readfds, fd_set * writefds, fd_set * exceptfds);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    uint32_t ToEpollEvents() const;
+    static SocketEvents FromEpollEvents(uint32_t events);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 };
 
 /**
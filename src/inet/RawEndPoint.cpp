@@ -413,6 +413,7 @@ INET_ERROR RawEndPoint::Listen(IPEndPointBasis::OnMessageReceivedFunct onMessage
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     // Wait for ability to read on this endpoint.
     mRequestIO.SetRead();
+    UpdateSocketWatch();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     return INET_NO_ERROR;
@@ -460,6 +461,7 @@ void RawEndPoint::Close()
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+            StopSocketWatch();
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -785,6 +787,10 @@ void RawEndPoint::Init(InetLayer * inetLayer, IPVersion ipVer, IPProtocol ipProt
 
     IPVer   = ipVer;
     IPProto = ipProto;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_Raw;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 /**
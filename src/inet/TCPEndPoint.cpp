@@ -60,6 +60,7 @@
 
 #include "arpa-inet-compatibility.h"
 
+#include <algorithm>
 #include <stdio.h>
 #include <string.h>
 #include <utility>
@@ -278,6 +279,7 @@ INET_ERROR TCPEndPoint::Listen(uint16_t backlog)
 
     // Wait for ability to read on this endpoint.
     mRequestIO.SetRead();
+    UpdateSocketWatch();
 
     // Wake the thread calling select so that it recognizes the new socket.
     SystemLayer().WakeSelect();
@@ -496,6 +498,7 @@ INET_ERROR TCPEndPoint::Connect(const IPAddress & addr, uint16_t port, Interface
         State = kState_Connected;
         // Wait for ability to read on this endpoint.
         mRequestIO.SetRead();
+        UpdateSocketWatch();
         if (OnConnectComplete != nullptr)
             OnConnectComplete(this, INET_NO_ERROR);
     }
@@ -504,6 +507,7 @@ INET_ERROR TCPEndPoint::Connect(const IPAddress & addr, uint16_t port, Interface
         State = kState_Connecting;
         // Wait for ability to write on this endpoint.
         mRequestIO.SetWrite();
+        UpdateSocketWatch();
     }
 
     // Wake the thread calling select so that it recognizes the new socket.
@@ -711,6 +715,7 @@ INET_ERROR TCPEndPoint::Send(System::PacketBufferHandle && data, bool push)
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
         // Wait for ability to write on this endpoint.
         mRequestIO.SetWrite();
+        UpdateSocketWatch();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
     }
     else
@@ -1154,6 +1159,10 @@ void TCPEndPoint::Init(InetLayer * inetLayer)
     InitEndPointBasis(*inetLayer);
     ReceiveEnabled = true;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_TCP;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     // Initialize to zero for using system defaults.
     mConnectTimeoutMsecs = 0;
 
@@ -1309,9 +1318,45 @@ INET_ERROR TCPEndPoint::DriveSending()
 
     while (!mSendQueue.IsNull())
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        // Hand as much of the queue to the kernel as one scatter-gather send can take, rather than one buffer at a time.
+        chip::ByteSpan segments[INET_CONFIG_MAX_SEND_SEGMENTS];
+        struct iovec sendIOV[INET_CONFIG_MAX_SEND_SEGMENTS];
+        struct msghdr msgHeader;
+        const size_t queuedSegmentCount = mSendQueue.GetDataSegments(segments, INET_CONFIG_MAX_SEND_SEGMENTS);
+        const size_t segmentCount       = std::min<size_t>(queuedSegmentCount, INET_CONFIG_MAX_SEND_SEGMENTS);
+        size_t iovCount                 = 0;
+        uint16_t bufLen                 = 0;
+        int flags                       = sendFlags;
+
+        for (; iovCount < segmentCount && segments[iovCount].size() <= static_cast<size_t>(UINT16_MAX - bufLen); iovCount++)
+        {
+            sendIOV[iovCount].iov_base = const_cast<uint8_t *>(segments[iovCount].data());
+            sendIOV[iovCount].iov_len  = segments[iovCount].size();
+            bufLen                     = static_cast<uint16_t>(bufLen + segments[iovCount].size());
+        }
+
+        // Only empty buffers are left.
+        if (iovCount == 0)
+        {
+            mSendQueue = nullptr;
+            mRequestIO.ClearWrite();
+            UpdateSocketWatch();
+            break;
+        }
+
+#ifdef MSG_MORE
+        // More of the queue follows in the next send; let the kernel coalesce the two rather than push a short segment.
+        if (iovCount < queuedSegmentCount)
+        {
+            flags |= MSG_MORE;
+        }
+#endif
+
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_iov    = sendIOV;
+        msgHeader.msg_iovlen = static_cast<decltype(msgHeader.msg_iovlen)>(iovCount);
 
-        ssize_t lenSentRaw = send(mSocket, mSendQueue->Start(), bufLen, sendFlags);
+        ssize_t lenSentRaw = sendmsg(mSocket, &msgHeader, flags);
 
         if (lenSentRaw == -1)
         {
@@ -1332,18 +1377,18 @@ INET_ERROR TCPEndPoint::DriveSending()
         // Mark the connection as being active.
         MarkActive();
 
-        if (lenSent < bufLen)
+        // Free the buffers that were sent in full, along with any empty buffers between them.
+        mSendQueue.Consume(lenSent);
+        if (!mSendQueue.IsNull() && mSendQueue->TotalLength() == 0)
         {
-            mSendQueue->ConsumeHead(lenSent);
+            mSendQueue = nullptr;
         }
-        else
+
+        if (mSendQueue.IsNull())
         {
-            mSendQueue.FreeHead();
-            if (mSendQueue.IsNull())
-            {
-                // Do not wait for ability to write on this endpoint.
-                mRequestIO.ClearWrite();
-            }
+            // Do not wait for ability to write on this endpoint.
+            mRequestIO.ClearWrite();
+            UpdateSocketWatch();
         }
 
         if (OnDataSent != nullptr)
@@ -1447,6 +1492,7 @@ void TCPEndPoint::HandleConnectComplete(INET_ERROR err)
         // Wait for ability to read or write on this endpoint.
         mRequestIO.SetRead();
         mRequestIO.SetWrite();
+        UpdateSocketWatch();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
         if (OnConnectComplete != nullptr)
@@ -1575,6 +1621,7 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
                     ChipLogError(Inet, "SO_LINGER: %d", errno);
             }
 
+            StopSocketWatch();
             if (close(mSocket) != 0 && err == INET_NO_ERROR)
                 err = chip::System::MapErrorPOSIX(errno);
             mSocket = INET_INVALID_SOCKET_FD;
@@ -2510,6 +2557,7 @@ void TCPEndPoint::ReceiveData()
                 State = kState_Closing;
             // Do not wait for ability to read on this endpoint.
             mRequestIO.ClearRead();
+            UpdateSocketWatch();
             // Call the app's OnPeerClose.
             if (OnPeerClose != nullptr)
                 OnPeerClose(this);
@@ -2608,6 +2656,7 @@ void TCPEndPoint::HandleIncomingConnection()
 
         // Wait for ability to read on this endpoint.
         conEP->mRequestIO.SetRead();
+        conEP->UpdateSocketWatch();
 
         // Call the app's callback function.
         OnConnectionReceived(this, conEP, peerAddr, peerPort);
@@ -345,6 +345,7 @@ INET_ERROR UDPEndPoint::Listen(OnMessageReceivedFunct onMessageReceived, OnRecei
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     // Wait for ability to read on this endpoint.
     mRequestIO.SetRead();
+    UpdateSocketWatch();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     return INET_NO_ERROR;
@@ -392,6 +393,7 @@ void UDPEndPoint::Close()
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+            StopSocketWatch();
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -656,6 +658,50 @@ exit:
     return res;
 }
 
+/**
+ * @brief   Send a batch of UDP messages.
+ *
+ * @param[in]   pktInfos    source and destination information for each message
+ * @param[in]   msgs        packet buffers containing the messages; they remain owned by the caller
+ * @param[in]   count       the number of entries in \c pktInfos and \c msgs
+ * @param[out]  sentCount   the number of messages, from the start of \c msgs, queued for transmit
+ *
+ * @retval  INET_NO_ERROR
+ *      success: every message is queued for transmit.
+ *
+ * @retval  other
+ *      the error that kept message \c sentCount from being sent, as for SendMsg().
+ *
+ * @details
+ *      Where the platform provides sendmmsg(), up to INET_CONFIG_UDP_BATCH_SIZE messages are
+ *      handed to the system per call. Elsewhere the messages are sent one at a time.
+ */
+INET_ERROR UDPEndPoint::SendMsgs(const IPPacketInfo * pktInfos, const System::PacketBufferHandle * msgs, size_t count,
+                                 size_t & sentCount)
+{
+    sentCount = 0;
+
+    VerifyOrReturnError(count > 0, INET_NO_ERROR);
+
+    INET_FAULT_INJECT(FaultInjection::kFault_Send, return INET_ERROR_UNKNOWN_INTERFACE;);
+    INET_FAULT_INJECT(FaultInjection::kFault_SendNonCritical, return INET_ERROR_NO_MEMORY;);
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    // Make sure we have the appropriate type of socket based on the
+    // destination address.
+    ReturnErrorOnFailure(GetSocket(pktInfos[0].DestAddress.Type()));
+
+    return IPEndPointBasis::SendMsgs(pktInfos, msgs, count, sentCount);
+#else  // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    for (; sentCount < count; sentCount++)
+    {
+        ReturnErrorOnFailure(SendMsg(&pktInfos[sentCount], msgs[sentCount].Retain()));
+    }
+
+    return INET_NO_ERROR;
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+}
+
 /**
  * @brief   Bind the endpoint to a network interface.
  *
@@ -724,6 +770,10 @@ INET_ERROR UDPEndPoint::BindInterface(IPAddressType addrType, InterfaceId intfId
 void UDPEndPoint::Init(InetLayer * inetLayer)
 {
     IPEndPointBasis::Init(inetLayer);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    mSocketEndPointType = kSocketEndPointType_UDP;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 /**
@@ -61,6 +61,8 @@ public:
     INET_ERROR SendTo(const IPAddress & addr, uint16_t port, InterfaceId intfId, chip::System::PacketBufferHandle && msg,
                       uint16_t sendFlags = 0);
     INET_ERROR SendMsg(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg, uint16_t sendFlags = 0);
+    INET_ERROR SendMsgs(const IPPacketInfo * pktInfos, const chip::System::PacketBufferHandle * msgs, size_t count,
+                        size_t & sentCount);
     void Close();
     void Free();
 
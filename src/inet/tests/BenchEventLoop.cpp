@@ -0,0 +1,134 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of one System::Layer event loop
+ *      iteration with 10, 100 and 1000 idle, listening UDP endpoints.
+ *
+ *      Build it once with and once without chip_system_config_use_epoll to
+ *      compare the two backends.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include <inet/InetLayer.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+
+#include "TestInetCommon.h"
+
+using namespace chip;
+using namespace chip::Inet;
+
+namespace {
+
+constexpr size_t kEndPointCounts[] = { 10, 100, 1000 };
+constexpr int kIterations          = 1000;
+
+UDPEndPoint * sEndPoints[INET_CONFIG_NUM_UDP_ENDPOINTS];
+
+void HandleIdleMessageReceived(IPEndPointBasis * endPoint, System::PacketBufferHandle && msg, const IPPacketInfo * pktInfo) {}
+
+// Each endpoint holds a socket, so the soft descriptor limit must leave room for all of them.
+void RaiseDescriptorLimit()
+{
+    struct rlimit limit;
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+size_t ListenOnIdleEndPoints(size_t requested)
+{
+    size_t count = 0;
+
+    while (count < requested && count < ArraySize(sEndPoints))
+    {
+        INET_ERROR err = gInet.NewUDPEndPoint(&sEndPoints[count]);
+        if (err != INET_NO_ERROR)
+            break;
+
+        err = sEndPoints[count]->Bind(kIPAddressType_IPv6, IPAddress::Any, 0);
+        if (err == INET_NO_ERROR)
+            err = sEndPoints[count]->Listen(HandleIdleMessageReceived, nullptr);
+        if (err != INET_NO_ERROR)
+        {
+            sEndPoints[count]->Free();
+            break;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+} // namespace
+
+int main(int argc, char * argv[])
+{
+    int result = EXIT_SUCCESS;
+
+    RaiseDescriptorLimit();
+
+    VerifyOrDie(chip::Platform::MemoryInit() == CHIP_NO_ERROR);
+    InitSystemLayer();
+    InitNetwork();
+
+    printf("event loop backend: %s\n", CHIP_SYSTEM_CONFIG_USE_EPOLL ? "epoll" : "select");
+
+    for (size_t requested : kEndPointCounts)
+    {
+        const size_t count = ListenOnIdleEndPoints(requested);
+
+        if (count < requested)
+        {
+            printf("only %zu of %zu endpoints listen (INET_CONFIG_NUM_UDP_ENDPOINTS is %d)\n", count, requested,
+                   INET_CONFIG_NUM_UDP_ENDPOINTS);
+            result = EXIT_FAILURE;
+        }
+        else
+        {
+            const uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+            for (int i = 0; i < kIterations; i++)
+            {
+                struct timeval sleepTime = { 0, 0 };
+                ServiceEvents(sleepTime);
+            }
+            const uint64_t elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+            printf("%4zu idle endpoints: %" PRIu64 " ns per loop iteration\n", count, (elapsed * 1000) / kIterations);
+        }
+
+        for (size_t i = 0; i < count; i++)
+            sEndPoints[i]->Free();
+    }
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+    chip::Platform::MemoryShutdown();
+
+    return result;
+}
@@ -109,6 +109,28 @@ void CHIPCircularTLVBuffer::Init(uint8_t * inBuffer, uint32_t inBufferLength)
     mImplicitProfileId = kCommonProfileId;
 }
 
+/**
+ * @brief
+ *   CHIPCircularTLVBuffer Init function for a backing store that already holds
+ *   TLV elements, e.g. as left there by an earlier instance of the buffer.
+ *
+ * @param[in] inBuffer       A pointer to the backing store for the queue
+ *
+ * @param[in] inBufferLength Length, in bytes, of the backing store
+ *
+ * @param[in] inHead         The first byte of the first element, which must
+ *                           fall within the backing store
+ *
+ * @param[in] inDataLength   Length, in bytes, of the elements, at most @a
+ *                           inBufferLength
+ */
+void CHIPCircularTLVBuffer::Init(uint8_t * inBuffer, uint32_t inBufferLength, uint8_t * inHead, uint32_t inDataLength)
+{
+    Init(inBuffer, inBufferLength);
+    mQueueHead   = inHead;
+    mQueueLength = inDataLength;
+}
+
 /**
  * @brief
  *   Evicts the oldest top-level TLV element in the CHIPCircularTLVBuffer
@@ -1044,6 +1044,23 @@
 #define CHIP_CONFIG_MAX_INCOMING_TCP_CONNECTIONS (CHIP_CONFIG_MAX_CONNECTIONS * 4 / 5)
 #endif // CHIP_CONFIG_MAX_INCOMING_TCP_CONNECTIONS
 
+/**
+ *  @def CHIP_CONFIG_TCP_COALESCE_BYTES
+ *
+ *  @brief
+ *    The number of bytes of messages to a TCP peer that are coalesced
+ *    before they are written to the connection.
+ *
+ *    On sockets platforms, messages sent on a connection are queued and
+ *    written out together once the event loop finds the connection
+ *    writable, unless this many bytes are queued already, which are
+ *    written out right away.  Setting this to 0 writes out each message
+ *    as it is sent.
+ */
+#ifndef CHIP_CONFIG_TCP_COALESCE_BYTES
+#define CHIP_CONFIG_TCP_COALESCE_BYTES 4096
+#endif // CHIP_CONFIG_TCP_COALESCE_BYTES
+
 /**
  *  @def CHIP_CONFIG_MAX_INCOMING_TCP_CON_FROM_SINGLE_IP
  *
@@ -1071,6 +1088,34 @@
 #define CHIP_CONFIG_MAX_SESSION_KEYS CHIP_CONFIG_MAX_CONNECTIONS
 #endif // CHIP_CONFIG_MAX_SESSION_KEYS
 
+/**
+ *  @def CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+ *
+ *  @brief
+ *    Maximum number of peers whose CASE sessions can be resumed.
+ *
+ *    Each successful CASE handshake leaves a resumption ticket for
+ *    the peer in a cache of this many entries, evicting the one least
+ *    recently established, so that the next handshake with the peer
+ *    can skip the certificate exchange and the ECDH key agreement.
+ *    Controllers talking to many nodes should raise this.
+ */
+#ifndef CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+#define CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE 8
+#endif // CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+
+/**
+ *  @def CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT
+ *
+ *  @brief
+ *    Maximum number of threads of a Crypto::CryptoWorkerPool, which
+ *    runs the ECDH and ECDSA operations of CASE handshakes off the
+ *    CHIP thread on platforms with POSIX threads.
+ */
+#ifndef CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT
+#define CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT 16
+#endif // CHIP_CONFIG_CRYPTO_WORKER_MAX_THREAD_COUNT
+
 /**
  *  @def CHIP_CONFIG_MAX_APPLICATION_EPOCH_KEYS
  *
@@ -1309,6 +1354,9 @@
  *  @brief
  *    Max number of messages behind message window can be accepted.
  *
+ *    Each peer session uses one bit per counter, rounded up to 64-bit words, plus one spare word. Larger windows tolerate
+ *    more reordering and do not make receiving slower.
+ *
  */
 #ifndef CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE
 #define CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE 32
@@ -2381,6 +2429,63 @@
 #define CHIP_CONFIG_MAX_DEVICE_ADMINS 16
 #endif // CHIP_CONFIG_MAX_DEVICE_ADMINS
 
+/**
+ *  @def CHIP_IM_MAX_NUM_READ_HANDLER
+ *
+ *  @brief
+ *    Maximum number of read requests the interaction model serves
+ *    at the same time. Further requests are rejected until a read
+ *    handler is released.
+ */
+#ifndef CHIP_IM_MAX_NUM_READ_HANDLER
+#define CHIP_IM_MAX_NUM_READ_HANDLER 4
+#endif // CHIP_IM_MAX_NUM_READ_HANDLER
+
+/**
+ *  @def CHIP_IM_MAX_NUM_READ_CLIENT
+ *
+ *  @brief
+ *    Maximum number of simultaneously active read clients.
+ */
+#ifndef CHIP_IM_MAX_NUM_READ_CLIENT
+#define CHIP_IM_MAX_NUM_READ_CLIENT 4
+#endif // CHIP_IM_MAX_NUM_READ_CLIENT
+
+/**
+ *  @def CHIP_IM_MAX_NUM_WRITE_HANDLER
+ *
+ *  @brief
+ *    Maximum number of write requests the interaction model serves
+ *    at the same time. Further requests are rejected until a write
+ *    handler is released.
+ */
+#ifndef CHIP_IM_MAX_NUM_WRITE_HANDLER
+#define CHIP_IM_MAX_NUM_WRITE_HANDLER 4
+#endif // CHIP_IM_MAX_NUM_WRITE_HANDLER
+
+/**
+ *  @def CHIP_IM_MAX_REPORTS_IN_FLIGHT
+ *
+ *  @brief
+ *    Maximum number of reports the reporting engine has sent and
+ *    not yet seen confirmed.
+ */
+#ifndef CHIP_IM_MAX_REPORTS_IN_FLIGHT
+#define CHIP_IM_MAX_REPORTS_IN_FLIGHT 1
+#endif // CHIP_IM_MAX_REPORTS_IN_FLIGHT
+
+/**
+ *  @def CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
+ *
+ *  @brief
+ *    Number of attribute and event paths the interaction model can
+ *    hold for all read handlers together. The paths are shared, so a
+ *    single request may use more than its share while others are idle.
+ */
+#ifndef CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
+#define CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS (8 * CHIP_IM_MAX_NUM_READ_HANDLER)
+#endif // CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
+
 /**
  * @def CHIP_NON_PRODUCTION_MARKER
  *
@@ -89,3 +89,29 @@
 #ifndef CHIP_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 #define CHIP_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT 0
 #endif
+
+/**
+ * @def CHIP_CONFIG_EVENT_INDEX_SIZE
+ *
+ * @brief
+ *   The number of the most recent events in each event buffer that are
+ *   indexed by event number, so that fetching events since a given one
+ *   starts reading at that event rather than at the oldest one in the
+ *   buffer.  Older events are still found, by reading through the buffer.
+ */
+#ifndef CHIP_CONFIG_EVENT_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_INDEX_SIZE 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL
+ *
+ * @brief
+ *   The number of commits to an event buffer kept in a file, e.g. by a
+ *   PersistentEventStorage, after which its events are written through to
+ *   the file.  Events logged since they were last written through are lost
+ *   on a crash.
+ */
+#ifndef CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL
+#define CHIP_CONFIG_EVENT_PERSIST_SYNC_INTERVAL 16
+#endif
@@ -31,6 +31,7 @@
 #include <core/CHIPTLVTags.h>
 #include <core/CHIPTLVTypes.h>
 
+#include <support/CodeUtils.h>
 #include <support/DLLUtil.h>
 #include <support/Span.h>
 
@@ -521,6 +522,64 @@ public:
      */
     CHIP_ERROR GetDataPtr(const uint8_t *& data);
 
+    /**
+     * Get the value of the current byte or UTF8 string element as a span of the underlying input buffer.
+     *
+     * No data is copied: the span remains valid for as long as the input buffer does. As with GetDataPtr(),
+     * the value must be held in a single buffer; use ForEachDataSpan() to read values that may continue
+     * from one buffer of a chain into the next.
+     *
+     * @param[out] v                        A span receiving the string data.
+     *
+     * @retval #CHIP_NO_ERROR              If the method succeeded.
+     * @retval #CHIP_ERROR_WRONG_TLV_TYPE  If the current element is not a TLV byte or UTF8 string, or the
+     *                                      reader is not positioned on an element.
+     * @retval #CHIP_ERROR_TLV_UNDERRUN    If the underlying TLV encoding ended prematurely or the value
+     *                                      of the current string element is not contained within a single
+     *                                      contiguous buffer.
+     * @retval other                        Other CHIP or platform error codes returned by the configured
+     *                                      TLVBackingStore.
+     *
+     */
+    CHIP_ERROR Get(ByteSpan & v);
+
+    /**
+     * Visit the value of the current byte or UTF8 string element in place, one span per input buffer it
+     * is held in.
+     *
+     * The function is called with a span of the underlying input buffer for each contiguous part of the
+     * value, in order, and returns false to stop the visit early. No data is copied, and the position of
+     * the reader is left unchanged.
+     *
+     * @param[in]  aFunction                A function taking a const ByteSpan & and returning bool.
+     *
+     * @retval #CHIP_NO_ERROR              If the method succeeded.
+     * @retval #CHIP_ERROR_WRONG_TLV_TYPE  If the current element is not a TLV byte or UTF8 string, or the
+     *                                      reader is not positioned on an element.
+     * @retval #CHIP_ERROR_TLV_UNDERRUN    If the underlying TLV encoding ended prematurely.
+     * @retval other                        Other CHIP or platform error codes returned by the configured
+     *                                      TLVBackingStore.
+     *
+     */
+    template <typename Function>
+    CHIP_ERROR ForEachDataSpan(Function && aFunction) const
+    {
+        VerifyOrReturnError(TLVTypeIsString(ElementType()), CHIP_ERROR_WRONG_TLV_TYPE);
+
+        TLVReader cursor   = *this;
+        uint32_t remaining = static_cast<uint32_t>(mElemLenOrVal);
+        while (remaining > 0)
+        {
+            ByteSpan span;
+            ReturnErrorOnFailure(cursor.ReadDataSpan(remaining, span));
+            if (!aFunction(span))
+            {
+                break;
+            }
+        }
+        return CHIP_NO_ERROR;
+    }
+
     /**
      * Prepares a TLVReader object for reading the members of TLV container element.
      *
@@ -800,10 +859,12 @@ protected:
     void ClearElementState();
     CHIP_ERROR SkipData();
     CHIP_ERROR SkipToEndOfContainer();
+    void SkipElementsInBuffer(uint32_t & nestLevel, TLVType outerContainerType);
     CHIP_ERROR VerifyElement();
     uint64_t ReadTag(TLVTagControl tagControl, const uint8_t *& p);
     CHIP_ERROR EnsureData(CHIP_ERROR noDataErr);
     CHIP_ERROR ReadData(uint8_t * buf, uint32_t len);
+    CHIP_ERROR ReadDataSpan(uint32_t & aRemainingLen, ByteSpan & aSpan);
     CHIP_ERROR GetElementHeadLength(uint8_t & elemHeadBytes) const;
     TLVElementType ElementType() const;
 };
@@ -1808,6 +1869,43 @@ public:
      * @return the total remaining number of bytes.
      */
     uint32_t GetRemainingFreeLength() const { return mRemainingLen; }
+
+    /**
+     * Set aside part of the remaining buffer, so that the elements written afterwards leave room for
+     * elements that can only be written once they are done. Writing into the bytes set aside fails
+     * with CHIP_ERROR_BUFFER_TOO_SMALL.
+     *
+     * @param[in] aBufferSize   The number of bytes to set aside.
+     *
+     * @retval #CHIP_NO_ERROR          If the bytes were set aside.
+     * @retval #CHIP_ERROR_NO_MEMORY   If fewer than aBufferSize bytes remain in the buffer.
+     */
+    CHIP_ERROR ReserveBuffer(uint32_t aBufferSize)
+    {
+        VerifyOrReturnError(mRemainingLen >= aBufferSize, CHIP_ERROR_NO_MEMORY);
+        mReservedSize += aBufferSize;
+        mRemainingLen -= aBufferSize;
+        mMaxLen -= aBufferSize;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Give back bytes set aside with ReserveBuffer(), so that they can be written.
+     *
+     * @param[in] aBufferSize   The number of bytes to give back.
+     *
+     * @retval #CHIP_NO_ERROR          If the bytes were given back.
+     * @retval #CHIP_ERROR_NO_MEMORY   If fewer than aBufferSize bytes are set aside.
+     */
+    CHIP_ERROR UnreserveBuffer(uint32_t aBufferSize)
+    {
+        VerifyOrReturnError(mReservedSize >= aBufferSize, CHIP_ERROR_NO_MEMORY);
+        mReservedSize -= aBufferSize;
+        mRemainingLen += aBufferSize;
+        mMaxLen += aBufferSize;
+        return CHIP_NO_ERROR;
+    }
+
     /**
      * The profile id of tags that should be encoded in implicit form.
      *
@@ -1838,6 +1936,7 @@ protected:
     uint32_t mRemainingLen;
     uint32_t mLenWritten;
     uint32_t mMaxLen;
+    uint32_t mReservedSize;
     TLVType mContainerType;
 
 private:
@@ -2183,6 +2282,7 @@ public:
     uint64_t GetTag() const { return mUpdaterReader.GetTag(); }
     uint32_t GetLength() const { return mUpdaterReader.GetLength(); }
     CHIP_ERROR GetDataPtr(const uint8_t *& data) { return mUpdaterReader.GetDataPtr(data); }
+    CHIP_ERROR Get(ByteSpan & v) { return mUpdaterReader.Get(v); }
     CHIP_ERROR VerifyEndOfContainer() { return mUpdaterReader.VerifyEndOfContainer(); }
     TLVType GetContainerType() const { return mUpdaterReader.GetContainerType(); }
     uint32_t GetLengthRead() const { return mUpdaterReader.GetLengthRead(); }
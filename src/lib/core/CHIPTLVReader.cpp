@@ -36,7 +36,74 @@ namespace TLV {
 
 using namespace chip::Encoding;
 
-static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+static constexpr uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
+
+namespace {
+
+enum : uint8_t
+{
+    kControlByteFlag_HasLength      = 0x01,
+    kControlByteFlag_IsContainer    = 0x02,
+    kControlByteFlag_EndOfContainer = 0x04,
+};
+
+/**
+ * What the control byte of an element tells of the element, looked up rather than decoded field by field
+ * for every element read or skipped.
+ */
+struct ControlByteInfo
+{
+    uint8_t mHeadLen; ///< Bytes in the element head (control byte, tag, length or value), 0 for an invalid element type
+    uint8_t mFlags;   ///< kControlByteFlag_* flags
+};
+
+class ControlByteTable
+{
+public:
+    constexpr ControlByteTable() : mInfo{}
+    {
+        for (uint16_t controlByte = 0; controlByte <= UINT8_MAX; controlByte++)
+        {
+            const uint8_t elemType = static_cast<uint8_t>(controlByte & kTLVTypeMask);
+            if (elemType > static_cast<uint8_t>(TLVElementType::EndOfContainer))
+            {
+                continue;
+            }
+
+            // Integers and floats have a value, and strings a length, of the size given by the low two bits of the type.
+            const bool hasValue = elemType <= static_cast<uint8_t>(TLVElementType::UInt64) ||
+                (elemType >= static_cast<uint8_t>(TLVElementType::FloatingPointNumber32) &&
+                 elemType <= static_cast<uint8_t>(TLVElementType::ByteString_8ByteLength));
+            const uint8_t valOrLenBytes = hasValue ? static_cast<uint8_t>(1 << (elemType & kTLVTypeSizeMask)) : 0;
+
+            ControlByteInfo & info = mInfo[controlByte];
+            info.mHeadLen          = static_cast<uint8_t>(1 + sTagSizes[controlByte >> kTLVTagControlShift] + valOrLenBytes);
+            if (elemType >= static_cast<uint8_t>(TLVElementType::UTF8String_1ByteLength) &&
+                elemType <= static_cast<uint8_t>(TLVElementType::ByteString_8ByteLength))
+            {
+                info.mFlags = kControlByteFlag_HasLength;
+            }
+            else if (elemType >= static_cast<uint8_t>(TLVElementType::Structure) &&
+                     elemType <= static_cast<uint8_t>(TLVElementType::List))
+            {
+                info.mFlags = kControlByteFlag_IsContainer;
+            }
+            else if (elemType == static_cast<uint8_t>(TLVElementType::EndOfContainer))
+            {
+                info.mFlags = kControlByteFlag_EndOfContainer;
+            }
+        }
+    }
+
+    const ControlByteInfo & operator[](uint8_t aControlByte) const { return mInfo[aControlByte]; }
+
+private:
+    ControlByteInfo mInfo[UINT8_MAX + 1];
+};
+
+constexpr ControlByteTable sControlByteTable;
+
+} // namespace
 
 void TLVReader::Init(const uint8_t * data, uint32_t dataLen)
 {
@@ -339,6 +406,29 @@ CHIP_ERROR TLVReader::GetDataPtr(const uint8_t *& data)
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TLVReader::Get(ByteSpan & v)
+{
+    const uint8_t * data = nullptr;
+
+    if (!TLVTypeIsString(ElementType()))
+        return CHIP_ERROR_WRONG_TLV_TYPE;
+
+    // An empty value needs no data, even when the input ends with it.
+    if (mElemLenOrVal == 0)
+    {
+        v = ByteSpan();
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR err = GetDataPtr(data);
+    if (err != CHIP_NO_ERROR)
+        return err;
+
+    v = ByteSpan(data, static_cast<size_t>(mElemLenOrVal));
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR TLVReader::OpenContainer(TLVReader & containerReader)
 {
     TLVElementType elemType = ElementType();
@@ -558,12 +648,110 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
         if (err != CHIP_NO_ERROR)
             return err;
 
+        // Step over whatever follows within the current buffer in bulk, and read the element after it as usual.
+        SkipElementsInBuffer(nestLevel, outerContainerType);
+
         err = ReadElement();
         if (err != CHIP_NO_ERROR)
             return err;
     }
 }
 
+/**
+ * Skip the elements that follow the current one for as long as they lie wholly within the current input buffer,
+ * entering and exiting containers along the way as SkipToEndOfContainer() does.
+ *
+ * Only the control byte, and the length of strings, of each element is looked at. The scan stops short of the end
+ * of the container being skipped, of an element crossing the end of the buffer, and of an element that would fail
+ * VerifyElement(): all of these are left for ReadElement() to read, or to report.
+ */
+void TLVReader::SkipElementsInBuffer(uint32_t & nestLevel, TLVType outerContainerType)
+{
+    const uint8_t * p     = mReadPoint;
+    const uint8_t * end   = mBufEnd;
+    TLVType containerType = mContainerType;
+
+    // Never read past the end of the encoding, even where the buffer holds more.
+    if (static_cast<size_t>(end - p) > mMaxLen - mLenRead)
+        end = p + (mMaxLen - mLenRead);
+
+    while (p < end)
+    {
+        const uint8_t controlByte      = *p;
+        const ControlByteInfo & info   = sControlByteTable[controlByte];
+        const TLVTagControl tagControl = static_cast<TLVTagControl>(controlByte & kTLVTagControlMask);
+        const size_t bufRemaining      = static_cast<size_t>(end - p);
+
+        if (info.mHeadLen == 0 || info.mHeadLen > bufRemaining)
+            break;
+
+        if (info.mFlags & kControlByteFlag_EndOfContainer)
+        {
+            if (nestLevel == 0 || tagControl != TLVTagControl::Anonymous)
+                break;
+
+            nestLevel--;
+            containerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+            p += info.mHeadLen;
+            continue;
+        }
+
+        // The tags VerifyElement() rejects.
+        if ((tagControl == TLVTagControl::ImplicitProfile_2Bytes || tagControl == TLVTagControl::ImplicitProfile_4Bytes) &&
+            ImplicitProfileId == kProfileIdNotSpecified)
+            break;
+        if (containerType == kTLVType_NotSpecified && tagControl == TLVTagControl::ContextSpecific)
+            break;
+        if (containerType == kTLVType_Structure && tagControl == TLVTagControl::Anonymous)
+            break;
+        if (containerType == kTLVType_Array && tagControl != TLVTagControl::Anonymous)
+            break;
+        if (containerType != kTLVType_NotSpecified && containerType != kTLVType_UnknownContainer &&
+            !TLVTypeIsContainer(containerType))
+            break;
+
+        size_t elemLen = info.mHeadLen;
+        if (info.mFlags & kControlByteFlag_HasLength)
+        {
+            // The length field ends the head.
+            const uint8_t * lenField = p + info.mHeadLen - (1 << (controlByte & kTLVTypeSizeMask));
+            uint64_t dataLen;
+
+            switch (static_cast<TLVFieldSize>(controlByte & kTLVTypeSizeMask))
+            {
+            case kTLVFieldSize_1Byte:
+                dataLen = Read8(lenField);
+                break;
+            case kTLVFieldSize_2Byte:
+                dataLen = LittleEndian::Read16(lenField);
+                break;
+            case kTLVFieldSize_4Byte:
+                dataLen = LittleEndian::Read32(lenField);
+                break;
+            default:
+                dataLen = LittleEndian::Read64(lenField);
+                break;
+            }
+
+            if (dataLen > bufRemaining - elemLen)
+                break;
+            elemLen += static_cast<size_t>(dataLen);
+        }
+
+        p += elemLen;
+
+        if (info.mFlags & kControlByteFlag_IsContainer)
+        {
+            nestLevel++;
+            containerType = static_cast<TLVType>(controlByte & kTLVTypeMask);
+        }
+    }
+
+    mLenRead += static_cast<uint32_t>(p - mReadPoint);
+    mReadPoint     = p;
+    mContainerType = containerType;
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
@@ -579,27 +767,20 @@ CHIP_ERROR TLVReader::ReadElement()
     // Get the element's control byte.
     mControlByte = *mReadPoint;
 
-    // Extract the element type from the control byte. Fail if it's invalid.
-    elemType = ElementType();
-    if (!IsValidTLVType(elemType))
+    // Look up the number of bytes in the element's 'head'. This includes: the control byte, the tag bytes (if present), the
+    // length bytes (if present), and for elements that don't have a length (e.g. integers), the value bytes. Fail if the
+    // element type is invalid.
+    uint8_t elemHeadBytes = sControlByteTable[*mReadPoint].mHeadLen;
+    if (elemHeadBytes == 0)
         return CHIP_ERROR_INVALID_TLV_ELEMENT;
 
-    // Extract the tag control from the control byte.
+    // Extract the element type and the tag control from the control byte.
+    elemType                 = ElementType();
     TLVTagControl tagControl = static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask);
 
-    // Determine the number of bytes in the element's tag, if any.
-    uint8_t tagBytes = sTagSizes[tagControl >> kTLVTagControlShift];
-
     // Extract the size of length/value field from the control byte.
     TLVFieldSize lenOrValFieldSize = GetTLVFieldSize(elemType);
 
-    // Determine the number of bytes in the length/value field.
-    uint8_t valOrLenBytes = TLVFieldSizeToBytes(lenOrValFieldSize);
-
-    // Determine the number of bytes in the element's 'head'. This includes: the control byte, the tag bytes (if present), the
-    // length bytes (if present), and for elements that don't have a length (e.g. integers), the value bytes.
-    uint8_t elemHeadBytes = static_cast<uint8_t>(1 + tagBytes + valOrLenBytes);
-
     // If the head of the element overlaps the end of the input buffer, read the bytes into the staging buffer
     // and arrange to parse them from there. Otherwise read them directly from the input buffer.
     if (elemHeadBytes > (mBufEnd - mReadPoint))
@@ -762,6 +943,24 @@ CHIP_ERROR TLVReader::ReadData(uint8_t * buf, uint32_t len)
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR TLVReader::ReadDataSpan(uint32_t & aRemainingLen, ByteSpan & aSpan)
+{
+    CHIP_ERROR err = EnsureData(CHIP_ERROR_TLV_UNDERRUN);
+    if (err != CHIP_NO_ERROR)
+        return err;
+
+    uint32_t readLen = static_cast<decltype(mMaxLen)>(mBufEnd - mReadPoint);
+    if (readLen > aRemainingLen)
+        readLen = aRemainingLen;
+
+    aSpan = ByteSpan(mReadPoint, readLen);
+    mReadPoint += readLen;
+    mLenRead += readLen;
+    aRemainingLen -= readLen;
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR TLVReader::EnsureData(CHIP_ERROR noDataErr)
 {
     CHIP_ERROR err;
@@ -798,33 +997,14 @@ CHIP_ERROR TLVReader::EnsureData(CHIP_ERROR noDataErr)
  */
 CHIP_ERROR TLVReader::GetElementHeadLength(uint8_t & elemHeadBytes) const
 {
-    uint8_t tagBytes;
-    uint8_t valOrLenBytes;
-    TLVTagControl tagControl;
-    TLVFieldSize lenOrValFieldSize;
-    TLVElementType elemType = ElementType();
-
     // Verify element is of valid TLVType.
-    VerifyOrReturnError(IsValidTLVType(elemType), CHIP_ERROR_INVALID_TLV_ELEMENT);
-
-    // Extract the tag control from the control byte.
-    tagControl = static_cast<TLVTagControl>(mControlByte & kTLVTagControlMask);
-
-    // Determine the number of bytes in the element's tag, if any.
-    tagBytes = sTagSizes[tagControl >> kTLVTagControlShift];
-
-    // Extract the size of length/value field from the control byte.
-    lenOrValFieldSize = GetTLVFieldSize(elemType);
-
-    // Determine the number of bytes in the length/value field.
-    valOrLenBytes = TLVFieldSizeToBytes(lenOrValFieldSize);
+    VerifyOrReturnError(IsValidTLVType(ElementType()), CHIP_ERROR_INVALID_TLV_ELEMENT);
 
-    // Determine the number of bytes in the element's 'head'. This includes: the
+    // Look up the number of bytes in the element's 'head'. This includes: the
     // control byte, the tag bytes (if present), the length bytes (if present),
     // and for elements that don't have a length (e.g. integers), the value
     // bytes.
-    VerifyOrReturnError(CanCastTo<uint8_t>(1 + tagBytes + valOrLenBytes), CHIP_ERROR_INTERNAL);
-    elemHeadBytes = static_cast<uint8_t>(1 + tagBytes + valOrLenBytes);
+    elemHeadBytes = sControlByteTable[static_cast<uint8_t>(mControlByte)].mHeadLen;
 
     return CHIP_NO_ERROR;
 }
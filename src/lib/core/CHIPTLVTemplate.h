@@ -0,0 +1,184 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines templates for encoding TLV containers of a fixed shape.
+ *
+ *      The members of such a container are unsigned integers of a fixed width, so the
+ *      control bytes and tags of its encoding are laid out once, at compile time. Each
+ *      encoding then only copies that layout and patches the values into their slots.
+ *
+ */
+
+#pragma once
+
+#include <core/CHIPEncoding.h>
+#include <core/CHIPError.h>
+#include <core/CHIPTLV.h>
+#include <core/CHIPTLVTags.h>
+#include <core/CHIPTLVTypes.h>
+#include <support/CodeUtils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+namespace chip {
+namespace TLV {
+
+/**
+ * The shape of one member of a fixed-shape container: its tag, anonymous or context-specific,
+ * and the width of the slot holding its unsigned integer value.
+ */
+struct TLVTemplateSlot
+{
+    /**
+     * A slot for a value of type T with a context-specific tag.
+     */
+    template <typename T>
+    static constexpr TLVTemplateSlot Context(uint8_t aTagNum)
+    {
+        static_assert(std::is_unsigned<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8),
+                      "Template slots hold unsigned integers");
+        return TLVTemplateSlot{ TLVTagControl::ContextSpecific, aTagNum, static_cast<uint8_t>(sizeof(T)) };
+    }
+
+    /**
+     * A slot for a value of type T with an anonymous tag.
+     */
+    template <typename T>
+    static constexpr TLVTemplateSlot Anonymous()
+    {
+        static_assert(std::is_unsigned<T>::value && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8),
+                      "Template slots hold unsigned integers");
+        return TLVTemplateSlot{ TLVTagControl::Anonymous, 0, static_cast<uint8_t>(sizeof(T)) };
+    }
+
+    TLVTagControl mTagControl;
+    uint8_t mTagNum;
+    uint8_t mWidth;
+};
+
+/**
+ * The precomputed encoding of a container of kNumSlots unsigned integer members, in the order of its slots.
+ *
+ * Templates are meant to be constexpr objects, e.g.:
+ *
+ * @code
+ *   constexpr TLVContainerTemplate<2> kPairTemplate(
+ *       kTLVType_List, { TLVTemplateSlot::Context<uint8_t>(0), TLVTemplateSlot::Context<uint16_t>(1) });
+ *   err = kPairTemplate.Encode(writer, AnonymousTag, { first, second });
+ * @endcode
+ *
+ * Values are always encoded at the width of their slot, which may not be the shortest encoding; TLVReader reads
+ * them back just the same.
+ */
+template <size_t kNumSlots>
+class TLVContainerTemplate
+{
+public:
+    /**
+     * The longest encoding of the members: a control byte, a tag byte and eight value bytes for each, and the end of
+     * the container.
+     */
+    static constexpr size_t kMaxEncodedLength = kNumSlots * 10 + 1;
+
+    constexpr TLVContainerTemplate(TLVType aContainerType, const TLVTemplateSlot (&aSlots)[kNumSlots]) :
+        mContainerType(aContainerType), mEncoding{}, mOffsets{}, mWidths{}, mLength(0)
+    {
+        for (size_t i = 0; i < kNumSlots; i++)
+        {
+            mEncoding[mLength++] =
+                static_cast<uint8_t>(static_cast<uint8_t>(aSlots[i].mTagControl) | ElementTypeFor(aSlots[i].mWidth));
+            if (aSlots[i].mTagControl == TLVTagControl::ContextSpecific)
+            {
+                mEncoding[mLength++] = aSlots[i].mTagNum;
+            }
+            mOffsets[i] = static_cast<uint8_t>(mLength);
+            mWidths[i]  = aSlots[i].mWidth;
+            mLength += aSlots[i].mWidth;
+        }
+        mEncoding[mLength++] = static_cast<uint8_t>(TLVElementType::EndOfContainer);
+    }
+
+    /**
+     * Encode the container with the given tag, patching the given values into its slots, in order.
+     *
+     * @param[in]  aWriter    The writer to encode the container with.
+     * @param[in]  aTag       The tag of the container.
+     * @param[in]  aValues    The value of each slot.
+     *
+     * @retval #CHIP_NO_ERROR                 If the container was encoded.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT   If a value does not fit into its slot.
+     * @retval other                          Errors returned by TLVWriter::PutPreEncodedContainer().
+     */
+    CHIP_ERROR Encode(TLVWriter & aWriter, uint64_t aTag, const uint64_t (&aValues)[kNumSlots]) const
+    {
+        uint8_t encoding[kMaxEncodedLength];
+
+        memcpy(encoding, mEncoding, mLength);
+        for (size_t i = 0; i < kNumSlots; i++)
+        {
+            uint8_t * slot = &encoding[mOffsets[i]];
+            switch (mWidths[i])
+            {
+            case 1:
+                VerifyOrReturnError(aValues[i] <= UINT8_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+                *slot = static_cast<uint8_t>(aValues[i]);
+                break;
+            case 2:
+                VerifyOrReturnError(aValues[i] <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+                Encoding::LittleEndian::Put16(slot, static_cast<uint16_t>(aValues[i]));
+                break;
+            case 4:
+                VerifyOrReturnError(aValues[i] <= UINT32_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+                Encoding::LittleEndian::Put32(slot, static_cast<uint32_t>(aValues[i]));
+                break;
+            default:
+                Encoding::LittleEndian::Put64(slot, aValues[i]);
+                break;
+            }
+        }
+
+        return aWriter.PutPreEncodedContainer(aTag, mContainerType, encoding, static_cast<uint32_t>(mLength));
+    }
+
+    /**
+     * The length of the encoding of the members, including the end of the container.
+     */
+    constexpr size_t GetEncodedLength() const { return mLength; }
+
+private:
+    static constexpr uint8_t ElementTypeFor(uint8_t aWidth)
+    {
+        return static_cast<uint8_t>(
+            static_cast<uint8_t>(TLVElementType::UInt8) +
+            ((aWidth == 1) ? kTLVFieldSize_1Byte
+                           : ((aWidth == 2) ? kTLVFieldSize_2Byte : ((aWidth == 4) ? kTLVFieldSize_4Byte : kTLVFieldSize_8Byte))));
+    }
+
+    TLVType mContainerType;
+    uint8_t mEncoding[kMaxEncodedLength];
+    uint8_t mOffsets[kNumSlots];
+    uint8_t mWidths[kNumSlots];
+    size_t mLength;
+};
+
+} // namespace TLV
+} // namespace chip
@@ -55,6 +55,7 @@ NO_INLINE void TLVWriter::Init(uint8_t * buf, uint32_t maxLen)
     mRemainingLen           = maxLen;
     mLenWritten             = 0;
     mMaxLen                 = maxLen;
+    mReservedSize           = 0;
     mContainerType          = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(true);
@@ -74,6 +75,7 @@ CHIP_ERROR TLVWriter::Init(TLVBackingStore & backingStore, uint32_t maxLen)
     mWritePoint    = mBufStart;
     mLenWritten    = 0;
     mMaxLen        = maxLen;
+    mReservedSize  = 0;
     mContainerType = kTLVType_NotSpecified;
     SetContainerOpen(false);
     SetCloseContainerReserved(true);
@@ -0,0 +1,144 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of TLVReader::Skip over a 64KB corpus
+ *      of nested containers, against visiting each of its elements.
+ */
+
+#include <core/CHIPTLV.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <support/ScopedBuffer.h>
+#include <system/SystemLayer.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace chip;
+using namespace chip::TLV;
+
+namespace {
+
+constexpr uint32_t kCorpusLength = 64 * 1024;
+constexpr int kIterations        = 200;
+
+/**
+ *  Write a structure of records, each holding integers, a string, an array and a boolean, until it is at least
+ *  aMinLength bytes long.
+ */
+CHIP_ERROR WriteNestedCorpus(TLVWriter & writer, uint32_t aMinLength)
+{
+    TLVType outerContainerType;
+    TLVType recordContainerType;
+    TLVType arrayContainerType;
+
+    ReturnErrorOnFailure(writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType));
+
+    for (uint32_t i = 0; writer.GetLengthWritten() < aMinLength; i++)
+    {
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(static_cast<uint8_t>(i)), kTLVType_Structure, recordContainerType));
+        ReturnErrorOnFailure(writer.Put(ContextTag(0), static_cast<uint8_t>(i)));
+        ReturnErrorOnFailure(writer.Put(ContextTag(1), i));
+        ReturnErrorOnFailure(writer.PutString(ContextTag(2), "record"));
+        ReturnErrorOnFailure(writer.StartContainer(ContextTag(3), kTLVType_Array, arrayContainerType));
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            ReturnErrorOnFailure(writer.Put(AnonymousTag, j));
+        }
+        ReturnErrorOnFailure(writer.EndContainer(arrayContainerType));
+        ReturnErrorOnFailure(writer.PutBoolean(ContextTag(4), (i & 1) != 0));
+        ReturnErrorOnFailure(writer.EndContainer(recordContainerType));
+    }
+
+    ReturnErrorOnFailure(writer.EndContainer(outerContainerType));
+    return writer.Finalize();
+}
+
+/**
+ *  Visit every element within the container the reader is in.
+ */
+CHIP_ERROR WalkContainer(TLVReader & reader, uint32_t & numElements)
+{
+    CHIP_ERROR err;
+    TLVType outerContainerType;
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        numElements++;
+        if (TLVTypeIsContainer(reader.GetType()))
+        {
+            ReturnErrorOnFailure(reader.EnterContainer(outerContainerType));
+            ReturnErrorOnFailure(WalkContainer(reader, numElements));
+            ReturnErrorOnFailure(reader.ExitContainer(outerContainerType));
+        }
+    }
+
+    return (err == CHIP_END_OF_TLV) ? CHIP_NO_ERROR : err;
+}
+
+} // namespace
+
+int main()
+{
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+    Platform::ScopedMemoryBuffer<uint8_t> corpus;
+    uint32_t corpusLen;
+    uint32_t numElements = 0;
+
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+    VerifyOrDie(corpus.Alloc(kCorpusLength + 256).Get() != nullptr);
+
+    writer.Init(corpus.Get(), kCorpusLength + 256);
+    VerifyOrDie(WriteNestedCorpus(writer, kCorpusLength) == CHIP_NO_ERROR);
+    corpusLen = writer.GetLengthWritten();
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kIterations; i++)
+    {
+        reader.Init(corpus.Get(), corpusLen);
+        VerifyOrDie(reader.Next() == CHIP_NO_ERROR);
+        VerifyOrDie(reader.Skip() == CHIP_NO_ERROR);
+    }
+    uint64_t skipElapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    start = System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kIterations; i++)
+    {
+        reader.Init(corpus.Get(), corpusLen);
+        VerifyOrDie(reader.Next() == CHIP_NO_ERROR);
+        VerifyOrDie(reader.EnterContainer(outerContainerType) == CHIP_NO_ERROR);
+        VerifyOrDie(WalkContainer(reader, numElements) == CHIP_NO_ERROR);
+        VerifyOrDie(reader.ExitContainer(outerContainerType) == CHIP_NO_ERROR);
+    }
+    uint64_t walkElapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    corpus.Free();
+    Platform::MemoryShutdown();
+
+    VerifyOrReturnError(skipElapsed > 0 && walkElapsed > 0, EXIT_FAILURE);
+    printf("Skipped %" PRIu32 " bytes of TLV at %" PRIu64 " MB/s, visited its %" PRIu32 " elements at %" PRIu64 " MB/s\n",
+           corpusLen, static_cast<uint64_t>(corpusLen) * kIterations / skipElapsed, numElements / kIterations,
+           static_cast<uint64_t>(corpusLen) * kIterations / walkElapsed);
+
+    return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@
 #include <core/CHIPTLV.h>
 #include <core/CHIPTLVData.hpp>
 #include <core/CHIPTLVDebug.hpp>
+#include <core/CHIPTLVTemplate.h>
 #include <core/CHIPTLVUtilities.hpp>
 
 #include <support/CHIPMem.h>
@@ -2477,6 +2478,329 @@ void CheckBufferOverflow(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+/**
+ *  Test that copies of a reader on a chain of PacketBuffers read across buffers independently
+ */
+void CheckBufferOverflowReaderCopies(nlTestSuite * inSuite, void * inContext)
+{
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferTLVReader reader;
+
+    System::PacketBufferHandle buf = System::PacketBufferHandle::New(sizeof(Encoding1), 0);
+    uint16_t maxDataLen            = buf->MaxDataLength();
+
+    // Leave room for half of the encoding in the first buffer, so that it continues in the next one.
+    buf->SetStart(buf->Start() + maxDataLen - sizeof(Encoding1) / 2);
+
+    writer.Init(buf.Retain(), /* useChainedBuffers = */ true);
+    writer.ImplicitProfileId = TestProfile_2;
+
+    WriteEncoding1(inSuite, writer);
+    NL_TEST_ASSERT(inSuite, buf->HasChainedBuffer());
+
+    reader.Init(buf.Retain(), /* useChainedBuffers = */ true);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    // The copy crosses into the second buffer first, which must not move the original along with it.
+    TLVReader readerCopy = reader;
+    ReadEncoding1(inSuite, readerCopy);
+    ReadEncoding1(inSuite, reader);
+}
+
+/**
+ *  Test reading byte strings in place, within a single PacketBuffer and across a chain of them
+ */
+void CheckBufferOverflowReadSpans(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferTLVReader reader;
+    uint8_t value[64];
+    uint8_t readBack[sizeof(value)];
+    size_t readBackLen = 0;
+    size_t numSpans    = 0;
+    ByteSpan span;
+    System::PacketBufferHandle second;
+
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value[i] = static_cast<uint8_t>(i);
+    }
+
+    System::PacketBufferHandle buf = System::PacketBufferHandle::New(sizeof(value), 0);
+    uint16_t maxDataLen            = buf->MaxDataLength();
+
+    // Leave room for the head of the first string and half of its value, so that the value continues in the next buffer.
+    buf->SetStart(buf->Start() + maxDataLen - 2 - sizeof(value) / 2);
+
+    writer.Init(buf.Retain(), /* useChainedBuffers = */ true);
+
+    err = writer.Put(AnonymousTag, ByteSpan(value, sizeof(value)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Put(AnonymousTag, ByteSpan(value, sizeof(value) / 2));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Put(AnonymousTag, ByteSpan());
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Finalize(&buf);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, buf->HasChainedBuffer());
+
+    reader.Init(buf.Retain(), /* useChainedBuffers = */ true);
+
+    // The first value straddles both buffers: it cannot be had as one span, but can be visited in two.
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = reader.Get(span);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_TLV_UNDERRUN);
+
+    err = reader.ForEachDataSpan([&](const ByteSpan & aSpan) {
+        memcpy(readBack + readBackLen, aSpan.data(), aSpan.size());
+        readBackLen += aSpan.size();
+        numSpans++;
+        return true;
+    });
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, numSpans == 2);
+    NL_TEST_ASSERT(inSuite, readBackLen == sizeof(value));
+    NL_TEST_ASSERT(inSuite, memcmp(readBack, value, sizeof(value)) == 0);
+
+    // The second value lies within the second buffer, and points right into it.
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = reader.Get(span);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, span.size() == sizeof(value) / 2);
+    NL_TEST_ASSERT(inSuite, memcmp(span.data(), value, span.size()) == 0);
+    second = buf->Next();
+    NL_TEST_ASSERT(inSuite, span.data() >= second->Start() && span.data() < second->Start() + second->DataLength());
+
+    // The last value is empty.
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = reader.Get(span);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, span.size() == 0);
+
+    numSpans = 0;
+    err      = reader.ForEachDataSpan([&](const ByteSpan & aSpan) {
+        IgnoreUnusedVariable(aSpan);
+        numSpans++;
+        return true;
+    });
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, numSpans == 0);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_END_OF_TLV);
+}
+
+/**
+ *  Test that a TLV container template encodes the same bytes as a TLVWriter preserving the size of each value
+ */
+void CheckTLVContainerTemplate(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr TLVContainerTemplate<4> kTemplate(kTLVType_List,
+                                                { TLVTemplateSlot::Context<uint64_t>(0), TLVTemplateSlot::Context<uint8_t>(1),
+                                                  TLVTemplateSlot::Anonymous<uint16_t>(), TLVTemplateSlot::Context<uint32_t>(3) });
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVWriter writer;
+    TLVType outerContainerType;
+    uint8_t expected[64];
+    uint8_t encoded[64];
+    uint32_t expectedLen;
+
+    writer.Init(expected, sizeof(expected));
+    err = writer.StartContainer(ProfileTag(TestProfile_1, 1), kTLVType_List, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ContextTag(0), static_cast<uint64_t>(1), true);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ContextTag(1), static_cast<uint8_t>(0xFE), true);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(AnonymousTag, static_cast<uint16_t>(0x1234), true);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ContextTag(3), static_cast<uint32_t>(0), true);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    expectedLen = writer.GetLengthWritten();
+
+    writer.Init(encoded, sizeof(encoded));
+    err = kTemplate.Encode(writer, ProfileTag(TestProfile_1, 1), { 1, 0xFE, 0x1234, 0 });
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == expectedLen);
+    NL_TEST_ASSERT(inSuite, memcmp(encoded, expected, expectedLen) == 0);
+
+    // A value too wide for its slot is rejected rather than truncated.
+    writer.Init(encoded, sizeof(encoded));
+    err = kTemplate.Encode(writer, AnonymousTag, { 1, 0x100, 0x1234, 0 });
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+/**
+ *  Write an anonymous structure of records, each a structure of small integers, a string and an array, followed by an
+ *  anonymous trailer integer, until at least aMinLength bytes have been written.
+ */
+static void WriteNestedCorpus(nlTestSuite * inSuite, TLVWriter & writer, uint32_t aMinLength)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVType outerContainerType;
+    TLVType recordContainerType;
+    TLVType arrayContainerType;
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (uint32_t i = 0; writer.GetLengthWritten() < aMinLength; i++)
+    {
+        err = writer.StartContainer(ContextTag(static_cast<uint8_t>(i)), kTLVType_Structure, recordContainerType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.Put(ContextTag(0), static_cast<uint8_t>(i));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.Put(ContextTag(1), i);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.PutString(ContextTag(2), "record");
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.StartContainer(ContextTag(3), kTLVType_Array, arrayContainerType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        for (uint8_t j = 0; j < 4; j++)
+        {
+            err = writer.Put(AnonymousTag, j);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        }
+        err = writer.EndContainer(arrayContainerType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.PutBoolean(ContextTag(4), (i & 1) != 0);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        err = writer.EndContainer(recordContainerType);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Put(AnonymousTag, static_cast<uint32_t>(0xDEADBEEF));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+}
+
+/**
+ *  Skip the structure at the start of a nested corpus, and check that the trailer after it is read back.
+ */
+static void SkipNestedCorpus(nlTestSuite * inSuite, TLVReader & reader)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    uint32_t trailer;
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetType() == kTLVType_Structure);
+
+    err = reader.Skip();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = reader.Get(trailer);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, trailer == 0xDEADBEEF);
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == CHIP_END_OF_TLV);
+}
+
+/**
+ *  Test skipping nested containers, within a single buffer and across a chain of PacketBuffers
+ */
+void CheckSkipNestedContainers(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint32_t kCorpusLength = 4096;
+
+    TLVWriter writer;
+    TLVReader reader;
+    System::PacketBufferTLVWriter packetWriter;
+    System::PacketBufferTLVReader packetReader;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> corpus;
+    uint32_t corpusLen;
+
+    NL_TEST_ASSERT(inSuite, corpus.Alloc(kCorpusLength + 256).Get() != nullptr);
+
+    writer.Init(corpus.Get(), kCorpusLength + 256);
+    WriteNestedCorpus(inSuite, writer, kCorpusLength);
+    corpusLen = writer.GetLengthWritten();
+
+    reader.Init(corpus.Get(), corpusLen);
+    SkipNestedCorpus(inSuite, reader);
+    NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == corpusLen);
+
+    // The same corpus, split over buffers at arbitrary points.
+    System::PacketBufferHandle buf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+    buf->SetStart(buf->Start() + buf->MaxDataLength() - 37);
+
+    packetWriter.Init(buf.Retain(), /* useChainedBuffers = */ true);
+    WriteNestedCorpus(inSuite, packetWriter, kCorpusLength);
+    NL_TEST_ASSERT(inSuite, packetWriter.GetLengthWritten() == corpusLen);
+    NL_TEST_ASSERT(inSuite, buf->HasChainedBuffer());
+
+    packetReader.Init(buf.Retain(), /* useChainedBuffers = */ true);
+    SkipNestedCorpus(inSuite, packetReader);
+    NL_TEST_ASSERT(inSuite, packetReader.GetLengthRead() == corpusLen);
+}
+
+/**
+ *  Test that skipping a container reports the same errors on malformed elements nested within it as reading them would
+ */
+void CheckSkipMalformedContainers(nlTestSuite * inSuite, void * inContext)
+{
+    // A context-tagged element within an array.
+    static const uint8_t kContextTagInArray[] = { 0x15, 0x36, 0x01, 0x24, 0x02, 0x05, 0x18, 0x18 };
+    // An implicitly tagged element while the reader knows of no implicit profile.
+    static const uint8_t kImplicitTag[] = { 0x15, 0x35, 0x01, 0x84, 0x01, 0x00, 0x05, 0x18, 0x18 };
+    // A string longer than the encoding.
+    static const uint8_t kStringPastEnd[] = { 0x15, 0x35, 0x01, 0x2C, 0x02, 0x10, 0x61, 0x18, 0x18 };
+    // A tagged end of container.
+    static const uint8_t kTaggedEndOfContainer[] = { 0x15, 0x35, 0x01, 0x24, 0x02, 0x05, 0x38, 0x01, 0x18 };
+
+    struct
+    {
+        const uint8_t * mEncoding;
+        uint32_t mLength;
+        CHIP_ERROR mExpectedError;
+    } const kCases[] = {
+        { kContextTagInArray, sizeof(kContextTagInArray), CHIP_ERROR_INVALID_TLV_TAG },
+        { kImplicitTag, sizeof(kImplicitTag), CHIP_ERROR_UNKNOWN_IMPLICIT_TLV_TAG },
+        { kStringPastEnd, sizeof(kStringPastEnd), CHIP_ERROR_TLV_UNDERRUN },
+        { kTaggedEndOfContainer, sizeof(kTaggedEndOfContainer), CHIP_ERROR_INVALID_TLV_TAG },
+    };
+
+    for (const auto & testCase : kCases)
+    {
+        CHIP_ERROR err = CHIP_NO_ERROR;
+        TLVReader reader;
+
+        reader.Init(testCase.mEncoding, testCase.mLength);
+
+        err = reader.Next();
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = reader.Skip();
+        NL_TEST_ASSERT(inSuite, err == testCase.mExpectedError);
+    }
+}
+
 /**
  * Test case to verify the correctness of TLVReader::GetTag()
  *
@@ -3523,6 +3847,40 @@ static void CheckCloseContainerReserve(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+static void CheckBufferReservation(nlTestSuite * inSuite, void * inContext)
+{
+    // An anonymous boolean takes 1 byte. With 1 of the 2 bytes of the buffer set aside, only one of them fits until the
+    // reserved byte is given back.
+    uint8_t buf[2];
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVWriter writer;
+
+    writer.Init(buf, sizeof(buf));
+
+    err = writer.ReserveBuffer(3);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+
+    err = writer.ReserveBuffer(1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetRemainingFreeLength() == 1);
+
+    err = writer.PutBoolean(AnonymousTag, true);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.PutBoolean(AnonymousTag, false);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    err = writer.UnreserveBuffer(2);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+
+    err = writer.UnreserveBuffer(1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = writer.PutBoolean(AnonymousTag, false);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == sizeof(buf));
+}
+
 static CHIP_ERROR ReadFuzzedEncoding1(nlTestSuite * inSuite, TLVReader & reader)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -3754,6 +4112,11 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Simple Write Read Test",              CheckSimpleWriteRead),
     NL_TEST_DEF("Inet Buffer Test",                    CheckPacketBuffer),
     NL_TEST_DEF("Buffer Overflow Test",                CheckBufferOverflow),
+    NL_TEST_DEF("Buffer Overflow Reader Copies Test",  CheckBufferOverflowReaderCopies),
+    NL_TEST_DEF("Buffer Overflow Read Spans Test",     CheckBufferOverflowReadSpans),
+    NL_TEST_DEF("Container Template Test",             CheckTLVContainerTemplate),
+    NL_TEST_DEF("Skip Nested Containers Test",         CheckSkipNestedContainers),
+    NL_TEST_DEF("Skip Malformed Containers Test",      CheckSkipMalformedContainers),
     NL_TEST_DEF("Pretty Print Test",                   CheckPrettyPrinter),
     NL_TEST_DEF("Data Macro Test",                     CheckDataMacro),
     NL_TEST_DEF("Strict Aliasing Test",                CheckStrictAliasing),
@@ -3771,6 +4134,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("CHIP TLV Printf, Circular TLV buf",   CheckCHIPTLVPutStringFCircular),
     NL_TEST_DEF("CHIP TLV Skip non-contiguous",        CheckCHIPTLVSkipCircular),
     NL_TEST_DEF("CHIP TLV Check reserve",              CheckCloseContainerReserve),
+    NL_TEST_DEF("CHIP TLV Check buffer reservation",   CheckBufferReservation),
     NL_TEST_DEF("CHIP TLV Reader Fuzz Test",           TLVReaderFuzzTest),
 
     NL_TEST_SENTINEL()
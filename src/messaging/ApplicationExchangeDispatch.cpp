@@ -56,6 +56,8 @@ bool ApplicationExchangeDispatch::MessagePermitted(uint16_t protocol, uint8_t ty
         case static_cast<uint8_t>(Protocols::SecureChannel::MsgType::CASE_SigmaR1):
         case static_cast<uint8_t>(Protocols::SecureChannel::MsgType::CASE_SigmaR2):
         case static_cast<uint8_t>(Protocols::SecureChannel::MsgType::CASE_SigmaR3):
+        case static_cast<uint8_t>(Protocols::SecureChannel::MsgType::CASE_SigmaR2Resume):
+        case static_cast<uint8_t>(Protocols::SecureChannel::MsgType::CASE_SigmaR3Resume):
         case static_cast<uint8_t>(Protocols::SecureChannel::MsgType::CASE_SigmaErr):
             return false;
 
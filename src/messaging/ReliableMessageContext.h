@@ -237,7 +237,8 @@ private:
     friend class ExchangeMessageDispatch;
 
     ReliableMessageProtocolConfig mConfig;
-    uint16_t mNextAckTimeTick; // Next time for triggering Solo Ack
+    uint16_t mNextAckTimeTick;  // Next time for triggering Solo Ack
+    uint16_t mRetransTableSlot; // ReliableMessageMgr retransmission table slot of the message awaiting an ack
     uint32_t mPendingPeerAckId;
 };
 
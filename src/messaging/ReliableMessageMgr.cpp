@@ -21,6 +21,7 @@
  *
  */
 
+#include <algorithm>
 #include <inttypes.h>
 
 #include <messaging/ReliableMessageMgr.h>
@@ -37,12 +38,20 @@
 namespace chip {
 namespace Messaging {
 
-ReliableMessageMgr::RetransTableEntry::RetransTableEntry() : rc(nullptr), nextRetransTimeTick(0), sendCount(0) {}
+ReliableMessageMgr::RetransTableEntry::RetransTableEntry() :
+    rc(nullptr), nextRetransTime(0), timerHeapIndex(kInvalidSlot), sendCount(0)
+{}
 
 ReliableMessageMgr::ReliableMessageMgr(BitMapObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
     mContextPool(contextPool), mSystemLayer(nullptr), mSessionMgr(nullptr), mCurrentTimerExpiry(0),
-    mTimerIntervalShift(CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT)
-{}
+    mTimerIntervalShift(CHIP_CONFIG_RMP_TIMER_DEFAULT_PERIOD_SHIFT), mRetransFreeCount(0), mRetransTimerHeapSize(0)
+{
+    // Hand out the lowest slots first
+    for (uint16_t slot = CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE; slot > 0; slot--)
+    {
+        mRetransFreeSlots[mRetransFreeCount++] = static_cast<uint16_t>(slot - 1);
+    }
+}
 
 ReliableMessageMgr::~ReliableMessageMgr() {}
 
@@ -88,8 +97,8 @@ void ReliableMessageMgr::TicklessDebugDumpRetransTable(const char * log)
     {
         if (entry.rc)
         {
-            ChipLogDetail(ExchangeManager, "EC:%04" PRIX16 " MsgId:%08" PRIX32 " NextRetransTimeCtr:%04" PRIX16, entry.rc,
-                          entry.msgId, entry.nextRetransTimeTick);
+            ChipLogDetail(ExchangeManager, "EC:%p MsgId:%08" PRIX32 " NextRetransTime:%" PRIu64, entry.rc,
+                          entry.retainedBuf.GetMsgId(), entry.nextRetransTime);
         }
     }
 }
@@ -124,14 +133,15 @@ void ReliableMessageMgr::ExecuteActions()
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries before processing");
 
     // Retransmit / cancel anything in the retrans table whose retrans timeout
-    // has expired
-    for (RetransTableEntry & entry : mRetransTable)
+    // has expired, soonest first
+    while (mRetransTimerHeapSize > 0)
     {
+        RetransTableEntry & entry   = mRetransTable[mRetransTimerHeap[0]];
         ReliableMessageContext * rc = entry.rc;
         CHIP_ERROR err              = CHIP_NO_ERROR;
 
-        if (!rc || entry.nextRetransTimeTick != 0)
-            continue;
+        if (entry.nextRetransTime > mTimeStampBase)
+            break;
 
         uint8_t sendCount = entry.sendCount;
         uint32_t msgId    = entry.retainedBuf.GetMsgId();
@@ -151,10 +161,17 @@ void ReliableMessageMgr::ExecuteActions()
         if (err == CHIP_NO_ERROR)
             err = SendFromRetransTable(&entry);
 
+        // A transport that delivers inline can process the ack before the send returns. The entry is then cleared, and may
+        // even hold the next message of the exchange already, which was scheduled when it was sent.
+        if (err == CHIP_NO_ERROR && (entry.rc != rc || entry.sendCount != sendCount + 1))
+            continue;
+
         if (err == CHIP_NO_ERROR)
         {
-            // If the retransmission was successful, update the passive timer
-            entry.nextRetransTimeTick = static_cast<uint16_t>(rc->GetActiveRetransmitTimeoutTick());
+            // If the retransmission was successful, update the passive timer. Always move the entry at least one
+            // tick into the future so that it is not sent again before the next timer expiry.
+            uint64_t retransTicks = std::max<uint64_t>(rc->GetActiveRetransmitTimeoutTick(), 1);
+            ScheduleRetransmit(entry, mTimeStampBase + (retransTicks << mTimerIntervalShift));
 #if !defined(NDEBUG)
             ChipLogDetail(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d", msgId, entry.sendCount);
 #endif
@@ -202,20 +219,6 @@ void ReliableMessageMgr::ExpireTicks()
         }
     });
 
-    for (RetransTableEntry & entry : mRetransTable)
-    {
-        ReliableMessageContext * rc = entry.rc;
-        if (rc)
-        {
-            // Decrement Retransmit timeout by elapsed timeticks
-            TickProceed(entry.nextRetransTimeTick, deltaTicks);
-#if defined(RMP_TICKLESS_DEBUG)
-            ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExpireTicks set nextRetransTimeTick to %u",
-                          entry.nextRetransTimeTick);
-#endif
-        } // rc entry is allocated
-    }
-
     // Re-Adjust the base time stamp to the most recent tick boundary
     mTimeStampBase += (deltaTicks << mTimerIntervalShift);
 
@@ -246,49 +249,41 @@ void ReliableMessageMgr::Timeout(System::Layer * aSystemLayer, void * aAppState,
 
 CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, RetransTableEntry ** rEntry)
 {
-    bool added     = false;
-    CHIP_ERROR err = CHIP_NO_ERROR;
-
     VerifyOrDie(rc != nullptr && !rc->IsOccupied());
 
-    for (RetransTableEntry & entry : mRetransTable)
+    if (mRetransFreeCount == 0)
     {
-        // Check the exchContext pointer for finding an empty slot in Table
-        if (!entry.rc)
-        {
-            // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
-            ExpireTicks();
+        ChipLogError(ExchangeManager, "mRetransTable Already Full");
+        return CHIP_ERROR_RETRANS_TABLE_FULL;
+    }
 
-            entry.rc          = rc;
-            entry.sendCount   = 0;
-            entry.retainedBuf = EncryptedPacketBufferHandle();
+    // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
+    ExpireTicks();
 
-            *rEntry = &entry;
+    uint16_t slot             = mRetransFreeSlots[--mRetransFreeCount];
+    RetransTableEntry & entry = mRetransTable[slot];
 
-            // Increment the reference count
-            rc->RetainContext();
-            rc->SetOccupied(true);
-            added = true;
+    entry.rc          = rc;
+    entry.sendCount   = 0;
+    entry.retainedBuf = EncryptedPacketBufferHandle();
 
-            break;
-        }
-    }
+    *rEntry = &entry;
 
-    if (!added)
-    {
-        ChipLogError(ExchangeManager, "mRetransTable Already Full");
-        err = CHIP_ERROR_RETRANS_TABLE_FULL;
-    }
+    // Increment the reference count
+    rc->RetainContext();
+    rc->SetOccupied(true);
+    rc->mRetransTableSlot = slot;
 
-    return err;
+    return CHIP_NO_ERROR;
 }
 
 void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
     VerifyOrDie(entry != nullptr && entry->rc != nullptr);
 
-    entry->nextRetransTimeTick = static_cast<uint16_t>(entry->rc->GetInitialRetransmitTimeoutTick() +
-                                                       GetTickCounterFromTimeDelta(System::Timer::GetCurrentEpoch()));
+    uint64_t retransTicks =
+        entry->rc->GetInitialRetransmitTimeoutTick() + GetTickCounterFromTimeDelta(System::Timer::GetCurrentEpoch());
+    ScheduleRetransmit(*entry, mTimeStampBase + (retransTicks << mTimerIntervalShift));
 
     // Check if the timer needs to be started and start it.
     StartTimer();
@@ -296,42 +291,39 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 
 void ReliableMessageMgr::PauseRetransmision(ReliableMessageContext * rc, uint32_t PauseTimeMillis)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry = FindRetransTableEntry(rc);
+
+    if (entry != nullptr && entry->timerHeapIndex != kInvalidSlot)
     {
-        if (entry.rc == rc)
-        {
-            entry.nextRetransTimeTick = static_cast<uint16_t>(entry.nextRetransTimeTick + (PauseTimeMillis >> mTimerIntervalShift));
-            break;
-        }
+        uint64_t pauseTicks = GetTickCounterFromTimePeriod(PauseTimeMillis);
+        ScheduleRetransmit(*entry, entry->nextRetransTime + (pauseTicks << mTimerIntervalShift));
     }
 }
 
 void ReliableMessageMgr::ResumeRetransmision(ReliableMessageContext * rc)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry = FindRetransTableEntry(rc);
+
+    if (entry != nullptr && entry->timerHeapIndex != kInvalidSlot)
     {
-        if (entry.rc == rc)
-        {
-            entry.nextRetransTimeTick = 0;
-            break;
-        }
+        ScheduleRetransmit(*entry, 0);
     }
 }
 
 bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, uint32_t ackMsgId)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    // An exchange has at most one message awaiting an ack, so the exchange leads straight to the entry
+    RetransTableEntry * entry = FindRetransTableEntry(rc);
+
+    if (entry != nullptr && entry->retainedBuf.GetMsgId() == ackMsgId)
     {
-        if ((entry.rc == rc) && entry.retainedBuf.GetMsgId() == ackMsgId)
-        {
-            // Clear the entry from the retransmision table.
-            ClearRetransTable(entry);
+        // Clear the entry from the retransmision table.
+        ClearRetransTable(*entry);
 
 #if !defined(NDEBUG)
-            ChipLogDetail(ExchangeManager, "Rxd Ack; Removing MsgId:%08" PRIX32 " from Retrans Table", ackMsgId);
+        ChipLogDetail(ExchangeManager, "Rxd Ack; Removing MsgId:%08" PRIX32 " from Retrans Table", ackMsgId);
 #endif
-            return true;
-        }
+        return true;
     }
 
     return false;
@@ -354,13 +346,13 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
     const ExchangeMessageDispatch * dispatcher = rc->GetExchangeContext()->GetMessageDispatch();
     VerifyOrExit(dispatcher != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
+    // Update the counters before sending: the ack may clear or reuse the entry before ResendMessage returns
+    entry->sendCount++;
+
     err =
         dispatcher->ResendMessage(rc->GetExchangeContext()->GetSecureSession(), std::move(entry->retainedBuf), &entry->retainedBuf);
     SuccessOrExit(err);
 
-    // Update the counters
-    entry->sendCount++;
-
 exit:
     if (err != CHIP_NO_ERROR)
     {
@@ -375,13 +367,12 @@ exit:
 
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry = FindRetransTableEntry(rc);
+
+    if (entry != nullptr)
     {
-        if (entry.rc == rc)
-        {
-            // Clear the retransmit table entry.
-            ClearRetransTable(entry);
-        }
+        // Clear the retransmit table entry.
+        ClearRetransTable(*entry);
     }
 }
 
@@ -394,6 +385,9 @@ void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & rEntry)
         // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
         ExpireTicks();
 
+        UnscheduleRetransmit(rEntry);
+
+        rEntry.rc->mRetransTableSlot = kInvalidSlot;
         rEntry.rc->ReleaseContext();
         rEntry.rc->SetOccupied(false);
         rEntry.rc = nullptr;
@@ -401,6 +395,8 @@ void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & rEntry)
         // Clear all other fields
         rEntry = RetransTableEntry();
 
+        mRetransFreeSlots[mRetransFreeCount++] = SlotOf(rEntry);
+
         // Schedule next physical wakeup, unless shutting down
         if (mSystemLayer)
             StartTimer();
@@ -409,14 +405,122 @@ void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & rEntry)
 
 void ReliableMessageMgr::FailRetransTableEntries(ReliableMessageContext * rc, CHIP_ERROR err)
 {
-    for (RetransTableEntry & entry : mRetransTable)
+    RetransTableEntry * entry = FindRetransTableEntry(rc);
+
+    if (entry != nullptr)
     {
-        if (entry.rc == rc)
+        // Remove the entry from the retransmission table.
+        ClearRetransTable(*entry);
+    }
+}
+
+ReliableMessageMgr::RetransTableEntry * ReliableMessageMgr::FindRetransTableEntry(const ReliableMessageContext * rc)
+{
+    uint16_t slot = rc->mRetransTableSlot;
+
+    if (slot < CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE && mRetransTable[slot].rc == rc)
+    {
+        return &mRetransTable[slot];
+    }
+
+    return nullptr;
+}
+
+void ReliableMessageMgr::ScheduleRetransmit(RetransTableEntry & entry, System::Timer::Epoch retransTime)
+{
+    bool later            = retransTime > entry.nextRetransTime;
+    entry.nextRetransTime = retransTime;
+
+    if (entry.timerHeapIndex == kInvalidSlot)
+    {
+        HeapSet(mRetransTimerHeapSize++, SlotOf(entry));
+        HeapSiftUp(entry.timerHeapIndex);
+    }
+    else if (later)
+    {
+        HeapSiftDown(entry.timerHeapIndex);
+    }
+    else
+    {
+        HeapSiftUp(entry.timerHeapIndex);
+    }
+}
+
+void ReliableMessageMgr::UnscheduleRetransmit(RetransTableEntry & entry)
+{
+    uint16_t index = entry.timerHeapIndex;
+
+    if (index == kInvalidSlot)
+        return;
+
+    entry.timerHeapIndex = kInvalidSlot;
+    mRetransTimerHeapSize--;
+
+    // Fill the hole with the last heap element and restore the heap order around it
+    if (index < mRetransTimerHeapSize)
+    {
+        uint16_t slot = mRetransTimerHeap[mRetransTimerHeapSize];
+
+        HeapSet(index, slot);
+        HeapSiftUp(index);
+        HeapSiftDown(mRetransTable[slot].timerHeapIndex);
+    }
+}
+
+void ReliableMessageMgr::HeapSet(uint16_t index, uint16_t slot)
+{
+    mRetransTimerHeap[index]           = slot;
+    mRetransTable[slot].timerHeapIndex = index;
+}
+
+void ReliableMessageMgr::HeapSiftUp(uint16_t index)
+{
+    uint16_t slot                    = mRetransTimerHeap[index];
+    System::Timer::Epoch retransTime = mRetransTable[slot].nextRetransTime;
+
+    while (index > 0)
+    {
+        uint16_t parent = static_cast<uint16_t>((index - 1) / 2);
+
+        if (mRetransTable[mRetransTimerHeap[parent]].nextRetransTime <= retransTime)
+            break;
+
+        HeapSet(index, mRetransTimerHeap[parent]);
+        index = parent;
+    }
+
+    HeapSet(index, slot);
+}
+
+void ReliableMessageMgr::HeapSiftDown(uint16_t index)
+{
+    if (index >= mRetransTimerHeapSize)
+        return;
+
+    uint16_t slot                    = mRetransTimerHeap[index];
+    System::Timer::Epoch retransTime = mRetransTable[slot].nextRetransTime;
+
+    while (true)
+    {
+        size_t child = 2 * static_cast<size_t>(index) + 1;
+
+        if (child >= mRetransTimerHeapSize)
+            break;
+
+        if (child + 1 < mRetransTimerHeapSize &&
+            mRetransTable[mRetransTimerHeap[child + 1]].nextRetransTime < mRetransTable[mRetransTimerHeap[child]].nextRetransTime)
         {
-            // Remove the entry from the retransmission table.
-            ClearRetransTable(entry);
+            child++;
         }
+
+        if (retransTime <= mRetransTable[mRetransTimerHeap[child]].nextRetransTime)
+            break;
+
+        HeapSet(index, mRetransTimerHeap[child]);
+        index = static_cast<uint16_t>(child);
     }
+
+    HeapSet(index, slot);
 }
 
 void ReliableMessageMgr::StartTimer()
@@ -438,31 +542,30 @@ void ReliableMessageMgr::StartTimer()
         }
     });
 
-    for (RetransTableEntry & entry : mRetransTable)
+    // Set timer for next tick boundary - subtract the elapsed time from the current tick
+    System::Timer::Epoch timerExpiryEpoch = foundWake ? (nextWakeTimeTick << mTimerIntervalShift) + mTimeStampBase : 0;
+
+    // When do we need to next wake up for ReliableMessageProtocol retransmit? Anything already due fires on the
+    // current tick boundary.
+    if (mRetransTimerHeapSize > 0)
     {
-        ReliableMessageContext * rc = entry.rc;
-        if (rc)
+        System::Timer::Epoch retransTime = std::max(mRetransTable[mRetransTimerHeap[0]].nextRetransTime, mTimeStampBase);
+
+        if (!foundWake || retransTime < timerExpiryEpoch)
         {
-            // When do we need to next wake up for ReliableMessageProtocol retransmit?
-            if (entry.nextRetransTimeTick < nextWakeTimeTick)
-            {
-                nextWakeTimeTick = entry.nextRetransTimeTick;
-                foundWake        = true;
+            timerExpiryEpoch = retransTime;
+            foundWake        = true;
 #if defined(RMP_TICKLESS_DEBUG)
-                ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer RetransTime %u", nextWakeTimeTick);
+            ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer RetransTime %" PRIu64, retransTime);
 #endif
-            }
         }
     }
 
     if (foundWake)
     {
-        // Set timer for next tick boundary - subtract the elapsed time from the current tick
-        System::Timer::Epoch timerExpiryEpoch = (nextWakeTimeTick << mTimerIntervalShift) + mTimeStampBase;
-
 #if defined(RMP_TICKLESS_DEBUG)
-        ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer wake at %" PRIu64 " ms (%" PRIu64 " %" PRIu64 ")",
-                      timerExpiryEpoch, nextWakeTimeTick, mTimeStampBase);
+        ChipLogDetail(ExchangeManager, "ReliableMessageMgr::StartTimer wake at %" PRIu64 " ms (%" PRIu64 ")", timerExpiryEpoch,
+                      mTimeStampBase);
 #endif
         if (timerExpiryEpoch != mCurrentTimerExpiry)
         {
@@ -505,16 +608,7 @@ void ReliableMessageMgr::StopTimer()
 
 int ReliableMessageMgr::TestGetCountRetransTable()
 {
-    int count = 0;
-
-    for (RetransTableEntry & entry : mRetransTable)
-    {
-        ReliableMessageContext * rc = entry.rc;
-        if (rc)
-            count++;
-    }
-
-    return count;
+    return CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE - mRetransFreeCount;
 }
 
 } // namespace Messaging
@@ -62,7 +62,8 @@ public:
 
         ReliableMessageContext * rc;             /**< The context for the stored CHIP message. */
         EncryptedPacketBufferHandle retainedBuf; /**< The packet buffer holding the CHIP message. */
-        uint16_t nextRetransTimeTick;            /**< A counter representing the next retransmission time for the message. */
+        System::Timer::Epoch nextRetransTime;    /**< The time, in milliseconds, at which the message is next retransmitted. */
+        uint16_t timerHeapIndex;                 /**< The position of the entry in the retransmission timer heap. */
         uint8_t sendCount;                       /**< A counter representing the number of times the message has been sent. */
     };
 
@@ -147,8 +148,7 @@ public:
     void ResumeRetransmision(ReliableMessageContext * rc);
 
     /**
-     *  Iterate through active exchange contexts and retrans table entries. Clear the entry matching
-     *  the specified ExchangeContext and the message ID from the retransmision table.
+     *  Clear the entry matching the specified ExchangeContext and the message ID from the retransmision table.
      *
      *  @param[in]    rc        A pointer to the ExchangeContext object.
      *
@@ -194,10 +194,10 @@ public:
     void FailRetransTableEntries(ReliableMessageContext * rc, CHIP_ERROR err);
 
     /**
-     * Iterate through active exchange contexts and retrans table entries.
-     * Determine how many ReliableMessageProtocol ticks we need to sleep before we
-     * need to physically wake the CPU to perform an action.  Set a timer to go off
-     * when we next need to wake the system.
+     * Iterate through active exchange contexts and look at the earliest pending
+     * retransmission. Determine how many ReliableMessageProtocol ticks we need to
+     * sleep before we need to physically wake the CPU to perform an action.  Set a
+     * timer to go off when we next need to wake the system.
      *
      */
     void StartTimer();
@@ -210,17 +210,18 @@ public:
 
     /**
      * Calculate number of virtual ReliableMessageProtocol ticks that have expired
-     * since we last called this function. Iterate through active exchange contexts
-     * and retrans table entries, subtracting expired virtual ticks to synchronize
-     * wakeup times with the current system time. Do not perform any actions beyond
-     * updating tick counts, actions will be performed by the physical
-     * ReliableMessageProtocol timer tick expiry.
+     * since we last called this function. Iterate through active exchange contexts,
+     * subtracting expired virtual ticks to synchronize ack wakeup times with the
+     * current system time. Retransmission times are absolute and need no adjustment.
+     * Do not perform any actions beyond updating tick counts, actions will be
+     * performed by the physical ReliableMessageProtocol timer tick expiry.
      *
      */
     void ExpireTicks();
 
     // Functions for testing
     int TestGetCountRetransTable();
+    int TestGetCountRetransTimers() { return mRetransTimerHeapSize; }
     void TestSetIntervalShift(uint16_t value) { mTimerIntervalShift = value; }
 
 private:
@@ -243,8 +244,26 @@ private:
 
     void TicklessDebugDumpRetransTable(const char * log);
 
+    static constexpr uint16_t kInvalidSlot = UINT16_MAX;
+
+    static_assert(CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE < kInvalidSlot, "Retransmission table slots must fit in a uint16_t");
+
+    uint16_t SlotOf(const RetransTableEntry & entry) const { return static_cast<uint16_t>(&entry - &mRetransTable[0]); }
+    RetransTableEntry * FindRetransTableEntry(const ReliableMessageContext * rc);
+
+    // Retransmission timer heap, ordered by RetransTableEntry::nextRetransTime
+    void ScheduleRetransmit(RetransTableEntry & entry, System::Timer::Epoch retransTime);
+    void UnscheduleRetransmit(RetransTableEntry & entry);
+    void HeapSet(uint16_t index, uint16_t slot);
+    void HeapSiftUp(uint16_t index);
+    void HeapSiftDown(uint16_t index);
+
     // ReliableMessageProtocol Global tables for timer context
     RetransTableEntry mRetransTable[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE];
+    uint16_t mRetransFreeSlots[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE]; // Stack of unused mRetransTable slots
+    uint16_t mRetransFreeCount;
+    uint16_t mRetransTimerHeap[CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE]; // Binary min-heap of scheduled mRetransTable slots
+    uint16_t mRetransTimerHeapSize;
 };
 
 } // namespace Messaging
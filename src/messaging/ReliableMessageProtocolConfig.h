@@ -88,6 +88,9 @@ namespace Messaging {
  *  @brief
  *    The default size of the ReliableMessageProtocol retransmission table.
  *
+ *    Scheduling and acknowledging entries does not scan the table, so it
+ *    may be sized for many concurrent exchanges (up to 65534 entries).
+ *
  */
 #ifndef CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE
 #ifdef PBUF_POOL_SIZE
@@ -221,6 +221,112 @@ void CheckResendMessage(nlTestSuite * inSuite, void * inContext)
     exchange->Close();
 }
 
+void CheckAckDuringRetransmit(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    MockAppDelegate mockSender;
+    ExchangeContext * exchange = ctx.NewExchangeToPeer(&mockSender);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    ReliableMessageMgr * rm     = ctx.GetExchangeManager().GetReliableMessageMgr();
+    ReliableMessageContext * rc = exchange->GetReliableMessageContext();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+    NL_TEST_ASSERT(inSuite, rc != nullptr);
+
+    rc->SetConfig({ 1, 1 });
+
+    gLoopback.mSendMessageCount    = 0;
+    gLoopback.mDroppedMessageCount = 0;
+    gLoopback.mNumMessagesToDrop   = 1;
+
+    err = exchange->SendMessage(Echo::MsgType::EchoRequest, chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mDroppedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTimers() == 1);
+
+    // The loopback delivers the retransmission inline, so its ack clears the entry before the send returns
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSendMessageCount >= 2);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTimers() == 0);
+
+    // The cleared entry must not be retransmitted again
+    uint32_t sendCount = gLoopback.mSendMessageCount;
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSendMessageCount == sendCount);
+
+    exchange->Close();
+}
+
+void CheckRetransmitOrder(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    ctx.GetInetLayer().SystemLayer()->Init(nullptr);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    MockAppDelegate mockSender;
+    ExchangeContext * slowExchange = ctx.NewExchangeToPeer(&mockSender);
+    ExchangeContext * fastExchange = ctx.NewExchangeToPeer(&mockSender);
+    NL_TEST_ASSERT(inSuite, slowExchange != nullptr);
+    NL_TEST_ASSERT(inSuite, fastExchange != nullptr);
+
+    ReliableMessageMgr * rm         = ctx.GetExchangeManager().GetReliableMessageMgr();
+    ReliableMessageContext * slowRc = slowExchange->GetReliableMessageContext();
+    ReliableMessageContext * fastRc = fastExchange->GetReliableMessageContext();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+
+    slowRc->SetConfig({ 4, 4 });
+    fastRc->SetConfig({ 1, 1 });
+
+    gLoopback.mSendMessageCount    = 0;
+    gLoopback.mDroppedMessageCount = 0;
+    gLoopback.mNumMessagesToDrop   = 10;
+
+    // The slow exchange sends first but must be retransmitted last
+    err = slowExchange->SendMessage(Echo::MsgType::EchoRequest, chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = fastExchange->SendMessage(Echo::MsgType::EchoRequest, chip::MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSendMessageCount == 2);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 2);
+
+    // An ack for a message that was never sent on the exchange leaves the table alone
+    NL_TEST_ASSERT(inSuite, !rm->CheckAndRemRetransTable(fastRc, 0xDEADBEEF));
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 2);
+
+    // 1 tick is 64 ms, only the fast exchange is due after 65 ms
+    test_os_sleep_ms(65);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSendMessageCount == 3);
+
+    // The slow exchange is due within 4 ticks; the fast one comes around again
+    test_os_sleep_ms(200);
+    ReliableMessageMgr::Timeout(&ctx.GetSystemLayer(), rm, CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSendMessageCount == 5);
+    NL_TEST_ASSERT(inSuite, gLoopback.mDroppedMessageCount == 5);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 2);
+
+    rm->ClearRetransTable(fastRc);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+    rm->ClearRetransTable(slowRc);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+
+    gLoopback.mNumMessagesToDrop = 0;
+
+    slowExchange->Close();
+    fastExchange->Close();
+}
+
 void CheckSendStandaloneAckMessage(nlTestSuite * inSuite, void * inContext)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
@@ -252,6 +358,8 @@ const nlTest sTests[] =
     NL_TEST_DEF("Test ReliableMessageMgr::CheckAddClearRetrans", CheckAddClearRetrans),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckFailRetrans", CheckFailRetrans),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckResendMessage", CheckResendMessage),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckAckDuringRetransmit", CheckAckDuringRetransmit),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckRetransmitOrder", CheckRetransmitOrder),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckSendStandaloneAckMessage", CheckSendStandaloneAckMessage),
 
     NL_TEST_SENTINEL()
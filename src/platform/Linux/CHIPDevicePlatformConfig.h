@@ -80,6 +80,10 @@
 #define CHIP_DEVICE_CONFIG_THREAD_TASK_STACK_SIZE 8192
 #endif // CHIP_DEVICE_CONFIG_THREAD_TASK_STACK_SIZE
 
+#ifndef CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT
+#define CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT 4
+#endif // CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT
+
 #define CHIP_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
@@ -40,3 +40,7 @@
 
 // On linux platform, we have sys/socket.h, so HAVE_SO_BINDTODEVICE should be set to 1
 #define HAVE_SO_BINDTODEVICE 1
+
+// Linux provides recvmmsg() and sendmmsg() for batched UDP I/O
+#define HAVE_RECVMMSG 1
+#define HAVE_SENDMMSG 1
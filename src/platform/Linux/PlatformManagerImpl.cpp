@@ -142,10 +142,64 @@ CHIP_ERROR PlatformManagerImpl::_InitChipStack()
     err = Internal::GenericPlatformManagerImpl_POSIX<PlatformManagerImpl>::_InitChipStack();
     SuccessOrExit(err);
 
+#if CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT > 0
+    err = mCryptoWorkerPool.Init(CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT, ScheduleCryptoCompletions);
+    SuccessOrExit(err);
+    Crypto::SetDefaultCryptoOffload(&mCryptoWorkerPool);
+#endif
+
 exit:
     return err;
 }
 
+CHIP_ERROR PlatformManagerImpl::_Shutdown()
+{
+    // The workers never wait for the CHIP stack lock, so they are joined whether or not the caller holds it. The
+    // completions they queued are dropped along with the jobs.
+    if (Crypto::GetDefaultCryptoOffload() == &mCryptoWorkerPool)
+    {
+        Crypto::SetDefaultCryptoOffload(nullptr);
+    }
+    mCryptoWorkerPool.Shutdown();
+
+    {
+        std::lock_guard<std::mutex> lock(mCryptoCompletionsLock);
+        mCryptoCompletions = std::queue<CryptoCompletion>();
+    }
+
+    return Internal::GenericPlatformManagerImpl_POSIX<PlatformManagerImpl>::_Shutdown();
+}
+
+void PlatformManagerImpl::ScheduleCryptoCompletions(Crypto::CryptoWorkerPool::WorkFunct workFunct, intptr_t arg)
+{
+    // Called on a worker thread. The write to the wake pipe is all it takes to get the chip task to run the
+    // completions, whether it is waiting in select() or about to.
+    {
+        std::lock_guard<std::mutex> lock(sInstance.mCryptoCompletionsLock);
+        sInstance.mCryptoCompletions.push({ workFunct, arg });
+    }
+    SystemLayer.WakeSelect();
+}
+
+void PlatformManagerImpl::_ProcessCrossThreadWork()
+{
+    // Completions are taken one at a time, so that none runs with the queue locked.
+    while (true)
+    {
+        CryptoCompletion completion;
+        {
+            std::lock_guard<std::mutex> lock(mCryptoCompletionsLock);
+            if (mCryptoCompletions.empty())
+            {
+                return;
+            }
+            completion = mCryptoCompletions.front();
+            mCryptoCompletions.pop();
+        }
+        completion.mWorkFunct(completion.mArg);
+    }
+}
+
 #if CHIP_WITH_GIO
 GDBusConnection * PlatformManagerImpl::GetGDBusConnection()
 {
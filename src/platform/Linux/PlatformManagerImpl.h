@@ -23,8 +23,11 @@
 
 #pragma once
 
+#include <crypto/CryptoWorkerPool.h>
 #include <memory>
+#include <mutex>
 #include <platform/internal/GenericPlatformManagerImpl_POSIX.h>
+#include <queue>
 
 #if CHIP_WITH_GIO
 #include <gio/gio.h>
@@ -58,6 +61,7 @@ private:
     // ===== Methods that implement the PlatformManager abstract interface.
 
     CHIP_ERROR _InitChipStack();
+    CHIP_ERROR _Shutdown();
 
     // ===== Members for internal use by the following friends.
 
@@ -71,6 +75,21 @@ private:
     // This should be removed or find a better place once we depercate the rendezvous session.
     static void WiFIIPChangeListener();
 
+    // Runs the ECDH and ECDSA operations of CASE handshakes off the chip task. The workers queue their completions
+    // under a lock of their own and wake the chip task up to run them, so they never wait for the CHIP stack lock.
+    struct CryptoCompletion
+    {
+        Crypto::CryptoWorkerPool::WorkFunct mWorkFunct;
+        intptr_t mArg;
+    };
+
+    static void ScheduleCryptoCompletions(Crypto::CryptoWorkerPool::WorkFunct workFunct, intptr_t arg);
+    void _ProcessCrossThreadWork();
+
+    Crypto::CryptoWorkerPool mCryptoWorkerPool;
+    std::mutex mCryptoCompletionsLock;
+    std::queue<CryptoCompletion> mCryptoCompletions;
+
 #if CHIP_WITH_GIO
     struct GDBusConnectionDeleter
     {
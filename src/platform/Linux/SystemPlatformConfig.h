@@ -47,3 +47,7 @@ struct ChipDeviceEvent;
 #ifndef CHIP_SYSTEM_CONFIG_NUM_TIMERS
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 16
 #endif // CHIP_SYSTEM_CONFIG_NUM_TIMERS
+
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES 1
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
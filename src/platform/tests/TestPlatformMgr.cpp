@@ -22,17 +22,20 @@
  *
  */
 
+#include <atomic>
 #include <inttypes.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include <nlunit-test.h>
 #include <support/CHIPMem.h>
 #include <support/CodeUtils.h>
 #include <support/UnitTestRegistration.h>
 
+#include <crypto/CryptoOffload.h>
 #include <platform/CHIPDeviceLayer.h>
 
 using namespace chip;
@@ -87,6 +90,48 @@ static void TestPlatformMgr_AddEventHandler(nlTestSuite * inSuite, void * inCont
 #endif
 }
 
+#if CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT > 0
+class TestCryptoJob : public Crypto::CryptoJob
+{
+public:
+    CHIP_ERROR Run() override
+    {
+        mRan = true;
+        return CHIP_NO_ERROR;
+    }
+
+    void OnComplete(CHIP_ERROR result) override { mCompleted = true; }
+
+    std::atomic<bool> mRan{ false };
+    std::atomic<bool> mCompleted{ false };
+};
+
+static void TestPlatformMgr_CryptoOffload(nlTestSuite * inSuite, void * inContext)
+{
+    Crypto::CryptoOffload * offload = Crypto::GetDefaultCryptoOffload();
+    TestCryptoJob job;
+
+    NL_TEST_ASSERT(inSuite, offload != nullptr);
+    VerifyOrReturn(offload != nullptr);
+
+    // The job runs while the CHIP stack is locked, and completes on the chip task once the lock is released.
+    PlatformMgr().LockChipStack();
+    NL_TEST_ASSERT(inSuite, offload->Submit(job) == CHIP_NO_ERROR);
+    for (int i = 0; i < 1000 && !job.mRan; i++)
+    {
+        usleep(1000);
+    }
+    NL_TEST_ASSERT(inSuite, job.mRan && !job.mCompleted);
+    PlatformMgr().UnlockChipStack();
+
+    for (int i = 0; i < 1000 && !job.mCompleted; i++)
+    {
+        usleep(1000);
+    }
+    NL_TEST_ASSERT(inSuite, job.mCompleted);
+}
+#endif // CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT > 0
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -96,6 +141,9 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test PlatformMgr::StartEventLoopTask", TestPlatformMgr_StartEventLoopTask),
     NL_TEST_DEF("Test PlatformMgr::TryLockChipStack", TestPlatformMgr_TryLockChipStack),
     NL_TEST_DEF("Test PlatformMgr::AddEventHandler", TestPlatformMgr_AddEventHandler),
+#if CHIP_DEVICE_CONFIG_CRYPTO_WORKER_THREAD_COUNT > 0
+    NL_TEST_DEF("Test PlatformMgr::CryptoOffload", TestPlatformMgr_CryptoOffload),
+#endif
 
     NL_TEST_SENTINEL()
 };
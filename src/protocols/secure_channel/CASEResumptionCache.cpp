@@ -0,0 +1,180 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the cache of CASE resumption tickets.
+ */
+
+#include <protocols/secure_channel/CASEResumptionCache.h>
+
+#include <core/CHIPEncoding.h>
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <stdio.h>
+#include <string.h>
+
+namespace chip {
+
+static_assert(CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE <= UINT16_MAX + 1, "Entry indexes must fit into the hex digits of the keys");
+
+CHIP_ERROR CASEResumptionCache::Init(PersistentStorageDelegate * storage)
+{
+    Clear();
+    mStorage = storage;
+    VerifyOrReturnError(mStorage != nullptr, CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < ArraySize(mEntries); i++)
+    {
+        char key[KeySize()];
+        StorableEntry info;
+        uint16_t size = sizeof(info);
+
+        ReturnErrorOnFailure(GenerateKey(i, key, sizeof(key)));
+        if (mStorage->SyncGetKeyValue(key, &info, size) != CHIP_NO_ERROR || size != sizeof(info))
+        {
+            continue;
+        }
+
+        Entry & entry      = mEntries[i];
+        entry.mPeerNodeId  = Encoding::LittleEndian::HostSwap64(info.mPeerNodeId);
+        entry.mLastUse     = Encoding::LittleEndian::HostSwap32(info.mLastUse);
+        memcpy(entry.mResumptionId, info.mResumptionId, sizeof(entry.mResumptionId));
+        memcpy(entry.mSecret, info.mSecret, sizeof(entry.mSecret));
+        if (entry.mLastUse > mUseCounter)
+        {
+            mUseCounter = entry.mLastUse;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+const CASEResumptionCache::Entry * CASEResumptionCache::FindByPeerNodeId(NodeId peerNodeId) const
+{
+    VerifyOrReturnError(peerNodeId != kUndefinedNodeId, nullptr);
+
+    for (const Entry & entry : mEntries)
+    {
+        if (entry.mLastUse != 0 && entry.mPeerNodeId == peerNodeId)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const CASEResumptionCache::Entry * CASEResumptionCache::FindByResumptionId(const uint8_t * resumptionId) const
+{
+    for (const Entry & entry : mEntries)
+    {
+        if (entry.mLastUse != 0 && memcmp(entry.mResumptionId, resumptionId, kCASEResumptionIdSize) == 0)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+CHIP_ERROR CASEResumptionCache::Save(NodeId peerNodeId, const uint8_t * resumptionId, const uint8_t * secret)
+{
+    size_t index = 0;
+
+    for (size_t i = 0; i < ArraySize(mEntries); i++)
+    {
+        if (peerNodeId != kUndefinedNodeId && mEntries[i].mLastUse != 0 && mEntries[i].mPeerNodeId == peerNodeId)
+        {
+            index = i;
+            break;
+        }
+        if (mEntries[i].mLastUse < mEntries[index].mLastUse)
+        {
+            index = i;
+        }
+    }
+
+    return SetEntry(index, peerNodeId, resumptionId, secret);
+}
+
+CHIP_ERROR CASEResumptionCache::Replace(const uint8_t * usedResumptionId, const uint8_t * resumptionId, const uint8_t * secret)
+{
+    const Entry * entry = FindByResumptionId(usedResumptionId);
+    VerifyOrReturnError(entry != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    return SetEntry(static_cast<size_t>(entry - mEntries), entry->mPeerNodeId, resumptionId, secret);
+}
+
+void CASEResumptionCache::Clear()
+{
+    memset(mEntries, 0, sizeof(mEntries));
+    mUseCounter = 0;
+}
+
+CHIP_ERROR CASEResumptionCache::SetEntry(size_t index, NodeId peerNodeId, const uint8_t * resumptionId, const uint8_t * secret)
+{
+    // Saving a ticket every handshake wraps the counter after billions of handshakes; the order of the entries is then
+    // lost, but not the entries.
+    if (++mUseCounter == 0)
+    {
+        mUseCounter = 1;
+    }
+
+    Entry & entry      = mEntries[index];
+    entry.mPeerNodeId  = peerNodeId;
+    entry.mLastUse     = mUseCounter;
+    memcpy(entry.mResumptionId, resumptionId, sizeof(entry.mResumptionId));
+    memcpy(entry.mSecret, secret, sizeof(entry.mSecret));
+
+    return StoreEntry(index);
+}
+
+CHIP_ERROR CASEResumptionCache::StoreEntry(size_t index)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_NO_ERROR);
+
+    char key[KeySize()];
+    StorableEntry info;
+    const Entry & entry = mEntries[index];
+
+    ReturnErrorOnFailure(GenerateKey(index, key, sizeof(key)));
+
+    info.mPeerNodeId = Encoding::LittleEndian::HostSwap64(entry.mPeerNodeId);
+    info.mLastUse    = Encoding::LittleEndian::HostSwap32(entry.mLastUse);
+    memcpy(info.mResumptionId, entry.mResumptionId, sizeof(info.mResumptionId));
+    memcpy(info.mSecret, entry.mSecret, sizeof(info.mSecret));
+
+    CHIP_ERROR err = mStorage->SyncSetKeyValue(key, &info, sizeof(info));
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(SecureChannel, "Error occurred storing CASE resumption ticket: %s", ErrorStr(err));
+    }
+    return err;
+}
+
+CHIP_ERROR CASEResumptionCache::GenerateKey(size_t index, char * key, size_t len)
+{
+    VerifyOrReturnError(len >= KeySize(), CHIP_ERROR_INVALID_ARGUMENT);
+    int keySize = snprintf(key, len, "%s%x", kCASEResumptionKeyPrefix, static_cast<unsigned int>(index));
+    VerifyOrReturnError(keySize > 0, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(len > static_cast<size_t>(keySize), CHIP_ERROR_INTERNAL);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace chip
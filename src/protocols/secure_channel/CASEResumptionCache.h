@@ -0,0 +1,132 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the cache of CASE resumption tickets, which lets
+ *      a CASE session with a peer be resumed without a full Sigma handshake.
+ */
+
+#pragma once
+
+#include <core/CHIPConfig.h>
+#include <core/CHIPError.h>
+#include <core/CHIPPersistentStorageDelegate.h>
+#include <core/PeerId.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+constexpr size_t kCASEResumptionIdSize     = 16;
+constexpr size_t kCASEResumptionSecretSize = 32;
+
+constexpr char kCASEResumptionKeyPrefix[] = "CHIPCASEResume";
+
+/**
+ * @brief
+ *   A bounded cache of CASE resumption tickets, one per peer, which evicts the ticket of the peer whose session was
+ *   established least recently.
+ *
+ * A ticket is the resumption ID the initiator presents in SigmaR1, and the secret both sides prove knowledge of and
+ * derive the resumed session from. The initiator looks tickets up by the node ID of the peer it connects to, the
+ * responder by the resumption ID it is presented. Each established session, resumed or not, replaces the ticket of the
+ * peer, so that a ticket is only used once.
+ *
+ * If given a PersistentStorageDelegate, each entry is stored under its own key, so that sessions are resumed across
+ * restarts as well.
+ */
+class DLL_EXPORT CASEResumptionCache
+{
+public:
+    struct Entry
+    {
+        NodeId mPeerNodeId;
+        uint8_t mResumptionId[kCASEResumptionIdSize];
+        uint8_t mSecret[kCASEResumptionSecretSize];
+        uint32_t mLastUse; ///< When the ticket was saved, for eviction; 0 for a free entry
+    };
+
+    CASEResumptionCache() { Clear(); }
+
+    /**
+     * @brief
+     *   Load the tickets kept in storage. Entries that are missing or cannot be read start out free.
+     *
+     * @param[in] storage  The storage to keep the tickets in, or nullptr to keep them in memory only.
+     */
+    CHIP_ERROR Init(PersistentStorageDelegate * storage);
+
+    /**
+     * @brief
+     *   Find the ticket for resuming a session with a peer, as the initiator.
+     */
+    const Entry * FindByPeerNodeId(NodeId peerNodeId) const;
+
+    /**
+     * @brief
+     *   Find the ticket a peer presents to resume a session, as the responder.
+     */
+    const Entry * FindByResumptionId(const uint8_t * resumptionId) const;
+
+    /**
+     * @brief
+     *   Save the ticket of a session established with a peer, replacing the one the peer had, or else taking a free
+     *   entry or the one least recently saved.
+     *
+     * A peer of undefined node ID does not replace the ticket of another such peer.
+     */
+    CHIP_ERROR Save(NodeId peerNodeId, const uint8_t * resumptionId, const uint8_t * secret);
+
+    /**
+     * @brief
+     *   Replace the ticket a session was resumed from by the ticket of the new session, so that the used ticket cannot
+     *   be presented again. The entry is overwritten in place, in a single write to storage.
+     *
+     * @retval #CHIP_ERROR_KEY_NOT_FOUND  The used ticket is no longer in the cache.
+     */
+    CHIP_ERROR Replace(const uint8_t * usedResumptionId, const uint8_t * resumptionId, const uint8_t * secret);
+
+    /**
+     * @brief
+     *   Forget all tickets, in memory only.
+     */
+    void Clear();
+
+private:
+    struct StorableEntry
+    {
+        uint64_t mPeerNodeId; /* This field is serialized in LittleEndian byte order */
+        uint8_t mResumptionId[kCASEResumptionIdSize];
+        uint8_t mSecret[kCASEResumptionSecretSize];
+        uint32_t mLastUse; /* This field is serialized in LittleEndian byte order */
+    };
+
+    static constexpr size_t KeySize() { return sizeof(kCASEResumptionKeyPrefix) + 2 * sizeof(uint16_t); }
+    static CHIP_ERROR GenerateKey(size_t index, char * key, size_t len);
+
+    CHIP_ERROR SetEntry(size_t index, NodeId peerNodeId, const uint8_t * resumptionId, const uint8_t * secret);
+    CHIP_ERROR StoreEntry(size_t index);
+
+    PersistentStorageDelegate * mStorage = nullptr;
+    uint32_t mUseCounter                 = 0;
+    Entry mEntries[CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE];
+};
+
+} // namespace chip
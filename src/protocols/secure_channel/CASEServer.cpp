@@ -30,7 +30,8 @@ using namespace ::chip::Credentials;
 namespace chip {
 
 CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, TransportMgrBase * transportMgr,
-                                                     SecureSessionMgr * sessionMgr, Transport::AdminPairingTable * admins)
+                                                     SecureSessionMgr * sessionMgr, Transport::AdminPairingTable * admins,
+                                                     PersistentStorageDelegate * storage)
 {
     VerifyOrReturnError(transportMgr != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(exchangeManager != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
@@ -43,6 +44,10 @@ CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager
 
     ReturnErrorOnFailure(mPairingSession.MessageDispatch().Init(transportMgr));
 
+    // Let peers resume their sessions with a ticket of their last one, rather than performing the full handshake again
+    ReturnErrorOnFailure(mResumptionCache.Init(storage));
+    mPairingSession.SetResumptionCache(&mResumptionCache);
+
     ExchangeDelegateBase * delegate = this;
     ReturnErrorOnFailure(
         mExchangeManager->RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_SigmaR1, delegate));
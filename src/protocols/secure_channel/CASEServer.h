@@ -37,8 +37,15 @@ public:
         mCredentials.Release();
     }
 
+    /**
+     * @brief
+     *   Handle SigmaR1 messages with a CASE session using the credentials of the admin.
+     *
+     * @param storage  The storage for the resumption tickets of the peers, or nullptr to keep them in memory only
+     */
     CHIP_ERROR ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, TransportMgrBase * transportMgr,
-                                             SecureSessionMgr * sessionMgr, Transport::AdminPairingTable * admins);
+                                             SecureSessionMgr * sessionMgr, Transport::AdminPairingTable * admins,
+                                             PersistentStorageDelegate * storage = nullptr);
 
     //////////// SessionEstablishmentDelegate Implementation ///////////////
     void OnSessionEstablishmentError(CHIP_ERROR error) override;
@@ -58,6 +65,7 @@ private:
     Messaging::ExchangeManager * mExchangeManager = nullptr;
 
     CASESession mPairingSession;
+    CASEResumptionCache mResumptionCache;
     uint16_t mNextKeyId            = 0;
     SecureSessionMgr * mSessionMgr = nullptr;
 
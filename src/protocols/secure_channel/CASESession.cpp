@@ -34,14 +34,26 @@
 #include <support/BufferWriter.h>
 #include <support/CHIPMem.h>
 #include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
 #include <support/SafeInt.h>
+#include <support/ScopedBuffer.h>
+#include <system/SystemConfig.h>
 #include <transport/SecureSessionMgr.h>
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif
+
 namespace chip {
 
 // TODO: Remove Later
 static P256ECDHDerivedSecret fabricSecret;
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+// The operational credential set, and the keypairs in it, are shared by the sessions signing on crypto worker threads.
+static pthread_mutex_t gsSignMsgMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 constexpr uint8_t kIPKInfo[] = { 0x49, 0x64, 0x65, 0x6e, 0x74, 0x69, 0x74, 0x79, 0x50, 0x72, 0x6f,
                                  0x74, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x4b, 0x65, 0x79 };
 
@@ -51,12 +63,24 @@ constexpr size_t kKDFInfoLength   = sizeof(kKDFSR2Info);
 constexpr uint8_t kKDFSEInfo[]    = { 0x53, 0x65, 0x73, 0x73, 0x69, 0x6f, 0x6e, 0x4b, 0x65, 0x79, 0x73 };
 constexpr size_t kKDFSEInfoLength = sizeof(kKDFSEInfo);
 
+constexpr uint8_t kKDFS1RKInfo[]             = { 0x53, 0x69, 0x67, 0x6d, 0x61, 0x31, 0x5f, 0x52, 0x65, 0x73, 0x75, 0x6d, 0x65 };
+constexpr uint8_t kKDFS2RKInfo[]             = { 0x53, 0x69, 0x67, 0x6d, 0x61, 0x32, 0x5f, 0x52, 0x65, 0x73, 0x75, 0x6d, 0x65 };
+constexpr uint8_t kKDFS3RKInfo[]             = { 0x53, 0x69, 0x67, 0x6d, 0x61, 0x33, 0x5f, 0x52, 0x65, 0x73, 0x75, 0x6d, 0x65 };
+constexpr uint8_t kKDFResumedSecretInfo[]    = { 0x43, 0x41, 0x53, 0x45, 0x5f, 0x52, 0x65, 0x73, 0x75, 0x6d, 0x65, 0x64 };
+constexpr uint8_t kKDFResumptionTicketInfo[] = { 0x43, 0x41, 0x53, 0x45, 0x5f, 0x52, 0x65, 0x73,
+                                                 0x75, 0x6d, 0x70, 0x74, 0x69, 0x6f, 0x6e };
+
 constexpr uint8_t kIVSR2[] = { 0x4e, 0x43, 0x41, 0x53, 0x45, 0x5f, 0x53, 0x69, 0x67, 0x6d, 0x61, 0x52, 0x32 };
 constexpr uint8_t kIVSR3[] = { 0x4e, 0x43, 0x41, 0x53, 0x45, 0x5f, 0x53, 0x69, 0x67, 0x6d, 0x61, 0x52, 0x33 };
 constexpr size_t kIVLength = sizeof(kIVSR2);
 
 constexpr size_t kTAGSize = 16;
 
+// SigmaR2 carries the random, the session ID and the trusted root ID of the responder, and its ephemeral public key,
+// ahead of the encrypted credentials.
+constexpr size_t kSigmaR2EncryptedOffset =
+    kSigmaParamRandomNumberSize + sizeof(uint16_t) + kTrustedRootIdSize + Crypto::kP256_PublicKey_Length;
+
 using namespace Crypto;
 using namespace Credentials;
 using namespace Messaging;
@@ -72,6 +96,17 @@ using HKDF_sha_crypto = HKDF_sha;
 // The session establishment fails if the response is not received within timeout window.
 static constexpr ExchangeContext::Timeout kSigma_Response_Timeout = 30000;
 
+// Compare two MICs in time independent of where they differ.
+static bool IsEqualMIC(const uint8_t * a, const uint8_t * b)
+{
+    uint8_t diff = 0;
+    for (size_t i = 0; i < kResumeMICSize; i++)
+    {
+        diff = static_cast<uint8_t>(diff | (a[i] ^ b[i]));
+    }
+    return diff == 0;
+}
+
 CASESession::CASESession()
 {
     mTrustedRootId.mId = nullptr;
@@ -93,10 +128,23 @@ void CASESession::Clear()
 {
     // This function zeroes out and resets the memory used by the object.
     // It's done so that no security related information will be leaked.
+
+    // A crypto step still running uses the state cleared here: wait for it, and drop its completion
+    if (mCryptoStepJob.mOffload != nullptr)
+    {
+        mCryptoStepJob.mOffload->Cancel(mCryptoStepJob);
+        mCryptoStepJob.mOffload = nullptr;
+    }
+
     mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
     mCommissioningHash.Clear();
     mPairingComplete = false;
+    mResuming        = false;
+    memset(mResumptionSecret, 0, sizeof(mResumptionSecret));
     mConnectionState.Reset();
+
+    mPendingMsg       = nullptr;
+    mRemoteSignedData = nullptr;
     if (mTrustedRootId.mId != nullptr)
     {
         chip::Platform::MemoryFree(const_cast<uint8_t *>(mTrustedRootId.mId));
@@ -303,6 +351,15 @@ CHIP_ERROR CASESession::SendSigmaR1()
     System::PacketBufferHandle msg_R1;
     uint8_t * msg = nullptr;
 
+    // Offer to resume the last session with the peer, if there is a ticket for it
+    const CASEResumptionCache::Entry * resumption =
+        (mResumptionCache != nullptr) ? mResumptionCache->FindByPeerNodeId(mConnectionState.GetPeerNodeId()) : nullptr;
+    mResuming = (resumption != nullptr);
+    if (mResuming)
+    {
+        data_len = static_cast<uint16_t>(data_len + kCASEResumptionIdSize + kResumeMICSize);
+    }
+
     msg_R1 = System::PacketBufferHandle::New(data_len);
     VerifyOrReturnError(!msg_R1.IsNull(), CHIP_SYSTEM_ERROR_NO_MEMORY);
 
@@ -311,6 +368,7 @@ CHIP_ERROR CASESession::SendSigmaR1()
     // Step 1
     // Fill in the random value
     ReturnErrorOnFailure(DRBG_get_bytes(msg, kSigmaParamRandomNumberSize));
+    memcpy(mInitiatorRandom, msg, kSigmaParamRandomNumberSize);
 
     // Step 4
     ReturnErrorOnFailure(mEphemeralKey.Initialize());
@@ -332,6 +390,18 @@ CHIP_ERROR CASESession::SendSigmaR1()
             }
         }
         bbuf.Put(mEphemeralKey.Pubkey(), mEphemeralKey.Pubkey().Length());
+        if (mResuming)
+        {
+            // Prove the initiator holds the secret of the ticket; the responder has not drawn its random yet
+            uint8_t mic[kResumeMICSize];
+            memcpy(mResumptionId, resumption->mResumptionId, sizeof(mResumptionId));
+            memcpy(mResumptionSecret, resumption->mSecret, sizeof(mResumptionSecret));
+            memset(mResponderRandom, 0, sizeof(mResponderRandom));
+            ReturnErrorOnFailure(ComputeResumeMIC(mResumptionSecret, sizeof(mResumptionSecret), kKDFS1RKInfo, sizeof(kKDFS1RKInfo),
+                                                  mConnectionState.GetLocalKeyID(), mic));
+            bbuf.Put(mResumptionId, sizeof(mResumptionId));
+            bbuf.Put(mic, sizeof(mic));
+        }
         VerifyOrReturnError(bbuf.Fit(), CHIP_ERROR_NO_MEMORY);
     }
 
@@ -347,17 +417,37 @@ CHIP_ERROR CASESession::SendSigmaR1()
     ReturnErrorOnFailure(mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR1, std::move(msg_R1),
                                                     SendFlags(SendMessageFlags::kExpectResponse)));
 
-    ChipLogDetail(Inet, "Sent SigmaR1 msg");
+    ChipLogDetail(Inet, "Sent SigmaR1 msg%s", mResuming ? " offering resumption" : "");
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR CASESession::HandleSigmaR1_and_SendSigmaR2(const System::PacketBufferHandle & msg)
 {
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
     ReturnErrorOnFailure(HandleSigmaR1(msg));
-    ReturnErrorOnFailure(SendSigmaR2());
+    if (mResuming)
+    {
+        ReturnErrorOnFailure(SendSigmaR2Resume());
+    }
+    else
+    {
+        // Nothing but SigmaErr is expected from the peer while SigmaR2 is computed
+        mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
 
-    return CHIP_NO_ERROR;
+        err = AllocPendingMsg(kSigmaR2EncryptedOffset + kTAGSize);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = RunCryptoStep(&CASESession::ComputeSigmaR2, &CASESession::SendSigmaR2);
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            SendErrorMsgFor(err);
+        }
+    }
+
+    return err;
 }
 
 CHIP_ERROR CASESession::HandleSigmaR1(const System::PacketBufferHandle & msg)
@@ -371,6 +461,7 @@ CHIP_ERROR CASESession::HandleSigmaR1(const System::PacketBufferHandle & msg)
     uint16_t fixed_buflen =
         kSigmaParamRandomNumberSize + sizeof(encryptionKeyId) + sizeof(uint16_t) + kTrustedRootIdSize + kP256_PublicKey_Length;
     uint32_t n_trusted_roots;
+    const CASEResumptionCache::Entry * resumption = nullptr;
 
     Encoding::LittleEndian::BufferWriter bbuf(mRemotePubKey, mRemotePubKey.Length());
 
@@ -383,20 +474,52 @@ CHIP_ERROR CASESession::HandleSigmaR1(const System::PacketBufferHandle & msg)
     SuccessOrExit(err);
 
     // Let's skip the random number portion of the message
+    memcpy(mInitiatorRandom, buf, kSigmaParamRandomNumberSize);
     buf += kSigmaParamRandomNumberSize;
 
     encryptionKeyId = chip::Encoding::LittleEndian::Read16(buf);
     n_trusted_roots = chip::Encoding::LittleEndian::Read16(buf);
     // Step 1/2
+    VerifyOrExit(buf + n_trusted_roots * kTrustedRootIdSize + kP256_PublicKey_Length <= msg->Start() + buflen,
+                 err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
     err = FindValidTrustedRoot(&buf, n_trusted_roots);
     SuccessOrExit(err);
     // write public key from message
     bbuf.Put(buf, kP256_PublicKey_Length);
     VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
+    buf += kP256_PublicKey_Length;
 
     ChipLogDetail(Inet, "Peer assigned session key ID %d", encryptionKeyId);
     mConnectionState.SetPeerKeyID(encryptionKeyId);
 
+    // The initiator offers to resume a session by appending the resumption ID of its ticket, and a MIC proving it holds
+    // the secret of the ticket. An unknown ticket, a ticket of another peer, or a wrong MIC fall back to the full handshake.
+    mResuming = false;
+    if (mResumptionCache != nullptr && buf + kCASEResumptionIdSize + kResumeMICSize == msg->Start() + buflen)
+    {
+        resumption = mResumptionCache->FindByResumptionId(buf);
+    }
+    if (resumption != nullptr &&
+        (mConnectionState.GetPeerNodeId() == kUndefinedNodeId || mConnectionState.GetPeerNodeId() == resumption->mPeerNodeId))
+    {
+        uint8_t mic[kResumeMICSize];
+
+        memcpy(mResumptionId, buf, sizeof(mResumptionId));
+        memcpy(mResumptionSecret, resumption->mSecret, sizeof(mResumptionSecret));
+        memset(mResponderRandom, 0, sizeof(mResponderRandom));
+
+        err = ComputeResumeMIC(mResumptionSecret, sizeof(mResumptionSecret), kKDFS1RKInfo, sizeof(kKDFS1RKInfo), encryptionKeyId,
+                               mic);
+        SuccessOrExit(err);
+        mResuming = IsEqualMIC(mic, buf + kCASEResumptionIdSize);
+    }
+    if (mResuming)
+    {
+        // SigmaR1 may be replayed: the session is established only once the peer confirms it in SigmaR3Resume
+        mConnectionState.SetPeerNodeId(resumption->mPeerNodeId);
+        ChipLogDetail(Inet, "Resuming CASE session");
+    }
+
 exit:
 
     if (err == CHIP_ERROR_CERT_NOT_TRUSTED)
@@ -410,23 +533,21 @@ exit:
     return err;
 }
 
-CHIP_ERROR CASESession::SendSigmaR2()
+CHIP_ERROR CASESession::ComputeSigmaR2()
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    System::PacketBufferHandle msg_R2;
     uint16_t data_len;
 
-    System::PacketBufferHandle msg_rand;
+    uint8_t msg_rand[kSigmaParamRandomNumberSize];
 
-    System::PacketBufferHandle msg_R2_Signed;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R2_Signed;
     uint16_t msg_r2_signed_len;
 
-    System::PacketBufferHandle msg_R2_Encrypted;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R2_Encrypted;
     size_t msg_r2_signed_enc_len;
 
-    System::PacketBufferHandle msg_salt;
-    uint16_t saltlen;
+    uint8_t msg_salt[kIPKSize + kSigmaParamRandomNumberSize + kP256_PublicKey_Length + kSHA256_Hash_Length];
 
     uint8_t sr2k[kAEADKeySize];
     P256ECDSASignature sigmaR2Signature;
@@ -435,22 +556,11 @@ CHIP_ERROR CASESession::SendSigmaR2()
 
     HKDF_sha_crypto mHKDF;
 
-    saltlen = kIPKSize + kSigmaParamRandomNumberSize + kP256_PublicKey_Length + kSHA256_Hash_Length;
-
-    msg_salt = System::PacketBufferHandle::New(saltlen);
-    VerifyOrExit(!msg_salt.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-    msg_salt->SetDataLength(saltlen);
-
-    msg_rand = System::PacketBufferHandle::New(kSigmaParamRandomNumberSize);
-    VerifyOrExit(!msg_rand.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-
     // Step 1
     // Fill in the random value
-    err = DRBG_get_bytes(msg_rand->Start(), kSigmaParamRandomNumberSize);
+    err = DRBG_get_bytes(msg_rand, sizeof(msg_rand));
     SuccessOrExit(err);
 
-    msg_rand->SetDataLength(kSigmaParamRandomNumberSize);
-
     // Step 3
     // hardcoded to use a p256keypair
     err = mEphemeralKey.Initialize();
@@ -464,10 +574,10 @@ CHIP_ERROR CASESession::SendSigmaR2()
     SuccessOrExit(err);
 
     // Step 5
-    err = ConstructSaltSigmaR2(msg_rand, mEphemeralKey.Pubkey(), mIPK, sizeof(mIPK), msg_salt);
+    err = ConstructSaltSigmaR2(msg_rand, mEphemeralKey.Pubkey(), mIPK, sizeof(mIPK), msg_salt, sizeof(msg_salt));
     SuccessOrExit(err);
 
-    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt->Start(), saltlen, kKDFSR2Info, kKDFInfoLength, sr2k,
+    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt, sizeof(msg_salt), kKDFSR2Info, kKDFInfoLength, sr2k,
                             kAEADKeySize);
     SuccessOrExit(err);
 
@@ -475,11 +585,10 @@ CHIP_ERROR CASESession::SendSigmaR2()
     msg_r2_signed_len =
         static_cast<uint16_t>(sizeof(uint16_t) + mOpCredSet->GetDevOpCredLen(mTrustedRootId) + kP256_PublicKey_Length * 2);
 
-    msg_R2_Signed = System::PacketBufferHandle::New(msg_r2_signed_len);
-    VerifyOrExit(!msg_R2_Signed.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
+    VerifyOrExit(msg_R2_Signed.Alloc(msg_r2_signed_len), err = CHIP_ERROR_NO_MEMORY);
 
     {
-        Encoding::LittleEndian::BufferWriter bbuf(msg_R2_Signed->Start(), msg_r2_signed_len);
+        Encoding::LittleEndian::BufferWriter bbuf(msg_R2_Signed.Get(), msg_r2_signed_len);
 
         bbuf.Put(mEphemeralKey.Pubkey(), mEphemeralKey.Pubkey().Length());
         bbuf.Put16(mOpCredSet->GetDevOpCredLen(mTrustedRootId));
@@ -489,20 +598,17 @@ CHIP_ERROR CASESession::SendSigmaR2()
         VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
     }
 
-    msg_R2_Signed->SetDataLength(msg_r2_signed_len);
-
     // Step 7
-    err = mOpCredSet->SignMsg(mTrustedRootId, msg_R2_Signed->Start(), msg_R2_Signed->DataLength(), sigmaR2Signature);
+    err = SignMsg(msg_R2_Signed.Get(), msg_r2_signed_len, sigmaR2Signature);
     SuccessOrExit(err);
 
     // Step 8
     msg_r2_signed_enc_len = sizeof(uint16_t) + mOpCredSet->GetDevOpCredLen(mTrustedRootId) + sigmaR2Signature.Length();
 
-    msg_R2_Encrypted = System::PacketBufferHandle::New(msg_r2_signed_enc_len);
-    VerifyOrExit(!msg_R2_Encrypted.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
+    VerifyOrExit(msg_R2_Encrypted.Alloc(msg_r2_signed_enc_len), err = CHIP_ERROR_NO_MEMORY);
 
     {
-        Encoding::LittleEndian::BufferWriter bbuf(msg_R2_Encrypted->Start(), msg_r2_signed_enc_len);
+        Encoding::LittleEndian::BufferWriter bbuf(msg_R2_Encrypted.Get(), msg_r2_signed_enc_len);
 
         bbuf.Put16(mOpCredSet->GetDevOpCredLen(mTrustedRootId));
         bbuf.Put(mOpCredSet->GetDevOpCred(mTrustedRootId), mOpCredSet->GetDevOpCredLen(mTrustedRootId));
@@ -511,102 +617,73 @@ CHIP_ERROR CASESession::SendSigmaR2()
         VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
     }
 
-    msg_R2_Encrypted->SetDataLength(static_cast<uint16_t>(msg_r2_signed_enc_len));
-
     // Step 9
-    err = AES_CCM_encrypt(msg_R2_Encrypted->Start(), msg_r2_signed_enc_len, nullptr, 0, sr2k, kAEADKeySize, kIVSR2, kIVLength,
-                          msg_R2_Encrypted->Start(), tag, sizeof(tag));
+    err = AES_CCM_encrypt(msg_R2_Encrypted.Get(), msg_r2_signed_enc_len, nullptr, 0, sr2k, kAEADKeySize, kIVSR2, kIVLength,
+                          msg_R2_Encrypted.Get(), tag, sizeof(tag));
     SuccessOrExit(err);
 
     data_len = static_cast<uint16_t>(kSigmaParamRandomNumberSize + sizeof(uint16_t) + kTrustedRootIdSize + kP256_PublicKey_Length +
                                      msg_r2_signed_enc_len + sizeof(tag));
 
-    msg_R2 = System::PacketBufferHandle::New(data_len);
-    VerifyOrExit(!msg_R2.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-
     // Step 10
-    // now construct sigmaR2
+    // now construct sigmaR2, in the buffer allocated on the CHIP thread
+    VerifyOrExit(mPendingMsg->AvailableDataLength() >= data_len, err = CHIP_ERROR_NO_MEMORY);
     {
-        Encoding::LittleEndian::BufferWriter bbuf(msg_R2->Start(), data_len);
+        Encoding::LittleEndian::BufferWriter bbuf(mPendingMsg->Start(), data_len);
 
-        bbuf.Put(msg_rand->Start(), kSigmaParamRandomNumberSize);
+        bbuf.Put(msg_rand, sizeof(msg_rand));
         // Responder's session ID
         bbuf.Put16(mConnectionState.GetLocalKeyID());
         // Step 2
         bbuf.Put(mTrustedRootId.mId, mTrustedRootId.mLen);
         bbuf.Put(mEphemeralKey.Pubkey(), mEphemeralKey.Pubkey().Length());
-        bbuf.Put(msg_R2_Encrypted->Start(), msg_r2_signed_enc_len);
+        bbuf.Put(msg_R2_Encrypted.Get(), msg_r2_signed_enc_len);
         bbuf.Put(tag, sizeof(tag));
 
         VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
     }
 
-    msg_R2->SetDataLength(data_len);
+    mPendingMsg->SetDataLength(data_len);
 
-    err = mCommissioningHash.AddData(msg_R2->Start(), msg_R2->DataLength());
-    SuccessOrExit(err);
+exit:
+    return err;
+}
+
+CHIP_ERROR CASESession::SendSigmaR2()
+{
+    // The response may arrive, and take the place of the message, before sending returns
+    System::PacketBufferHandle msg_R2 = std::move(mPendingMsg);
+
+    ReturnErrorOnFailure(mCommissioningHash.AddData(msg_R2->Start(), msg_R2->DataLength()));
 
     mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaR3;
 
     // Call delegate to send the msg to peer
-    err = mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR2, std::move(msg_R2),
-                                     SendFlags(SendMessageFlags::kExpectResponse));
-    SuccessOrExit(err);
+    ReturnErrorOnFailure(mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR2, std::move(msg_R2),
+                                                    SendFlags(SendMessageFlags::kExpectResponse)));
 
     ChipLogDetail(Inet, "Sent SigmaR2 msg");
 
-exit:
-
-    if (err != CHIP_NO_ERROR)
-    {
-        SendErrorMsg(SigmaErrorType::kUnexpected);
-    }
-    return err;
-}
-
-CHIP_ERROR CASESession::HandleSigmaR2_and_SendSigmaR3(const System::PacketBufferHandle & msg)
-{
-    ReturnErrorOnFailure(HandleSigmaR2(msg));
-    ReturnErrorOnFailure(SendSigmaR3());
-
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASESession::HandleSigmaR2(const System::PacketBufferHandle & msg)
+CHIP_ERROR CASESession::HandleSigmaR2(System::PacketBufferHandle && msg)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     const uint8_t * buf = msg->Start();
     size_t buflen       = msg->DataLength();
 
-    System::PacketBufferHandle msg_salt;
-    uint16_t saltlen;
-
-    System::PacketBufferHandle msg_R2_Signed;
-    uint16_t msg_r2_signed_len;
-
-    uint8_t sr2k[kAEADKeySize];
-
-    P256ECDSASignature sigmaR2SignedData;
-    size_t sigLen;
-
-    P256PublicKey remoteCredential;
-
-    const uint8_t * remoteDeviceOpCert;
-    uint16_t remoteDeviceOpCertLen;
-
-    uint8_t * msg_r2_encrypted;
-
-    const uint8_t * tag = buf + buflen - kTAGSize;
-
     uint16_t encryptionKeyId = 0;
 
-    HKDF_sha_crypto mHKDF;
-
     VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+    VerifyOrExit(buflen >= kSigmaR2EncryptedOffset + kTAGSize, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
     ChipLogDetail(Inet, "Received SigmaR2 msg");
 
+    // The peer did not resume the session, if it was offered to
+    mResuming = false;
+
     // Step 1
     // skip random part
     buf += kSigmaParamRandomNumberSize;
@@ -628,92 +705,94 @@ CHIP_ERROR CASESession::HandleSigmaR2(const System::PacketBufferHandle & msg)
         VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
     }
 
+    // Nothing but SigmaErr is expected from the peer while SigmaR2 is processed
+    mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
+    mPendingMsg      = std::move(msg);
+
+    // Steps 2 to 6 continue in DecryptSigmaR2(), ValidateSigmaR2() and VerifySigmaR2_and_ComputeSigmaR3()
+    err = RunCryptoStep(&CASESession::DecryptSigmaR2, &CASESession::ValidateSigmaR2);
+    SuccessOrExit(err);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        SendErrorMsgFor(err);
+    }
+    return err;
+}
+
+CHIP_ERROR CASESession::DecryptSigmaR2()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    uint8_t msg_salt[kIPKSize + kSigmaParamRandomNumberSize + kP256_PublicKey_Length + kSHA256_Hash_Length];
+
+    uint8_t sr2k[kAEADKeySize];
+
+    uint8_t * msg_r2_encrypted = mPendingMsg->Start() + kSigmaR2EncryptedOffset;
+    const uint8_t * tag        = mPendingMsg->Start() + mPendingMsg->DataLength() - kTAGSize;
+
+    HKDF_sha_crypto mHKDF;
+
     // Step 2
     err = mEphemeralKey.ECDH_derive_secret(mRemotePubKey, mSharedSecret);
     SuccessOrExit(err);
 
     // Step 3
-    saltlen = kIPKSize + kSigmaParamRandomNumberSize + kP256_PublicKey_Length + kSHA256_Hash_Length;
-
-    msg_salt = System::PacketBufferHandle::New(saltlen);
-    VerifyOrExit(!msg_salt.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-    msg_salt->SetDataLength(saltlen);
-
     err = ComputeIPK(mConnectionState.GetPeerKeyID(), mRemoteIPK, sizeof(mRemoteIPK));
     SuccessOrExit(err);
 
-    err = ConstructSaltSigmaR2(msg, mRemotePubKey, mRemoteIPK, sizeof(mRemoteIPK), msg_salt);
+    err = ConstructSaltSigmaR2(mPendingMsg->Start(), mRemotePubKey, mRemoteIPK, sizeof(mRemoteIPK), msg_salt, sizeof(msg_salt));
     SuccessOrExit(err);
 
-    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt->Start(), saltlen, kKDFSR2Info, kKDFInfoLength, sr2k,
+    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt, sizeof(msg_salt), kKDFSR2Info, kKDFInfoLength, sr2k,
                             kAEADKeySize);
     SuccessOrExit(err);
 
-    err = mCommissioningHash.AddData(msg->Start(), msg->DataLength());
+    err = mCommissioningHash.AddData(mPendingMsg->Start(), mPendingMsg->DataLength());
     SuccessOrExit(err);
 
     // Step 4
-    msg_r2_encrypted = const_cast<uint8_t *>(buf);
-
-    err = AES_CCM_decrypt(msg_r2_encrypted,
-                          buflen - kSigmaParamRandomNumberSize - sizeof(encryptionKeyId) - kTrustedRootIdSize -
-                              kP256_PublicKey_Length - kTAGSize,
-                          nullptr, 0, tag, kTAGSize, sr2k, kAEADKeySize, kIVSR2, kIVLength, msg_r2_encrypted);
+    err = AES_CCM_decrypt(msg_r2_encrypted, mPendingMsg->DataLength() - kSigmaR2EncryptedOffset - kTAGSize, nullptr, 0, tag,
+                          kTAGSize, sr2k, kAEADKeySize, kIVSR2, kIVLength, msg_r2_encrypted);
     SuccessOrExit(err);
 
-    // Step 5
-    // Validate responder identity located in msg_r2_encrypted
-    // Constructing responder identity
-    err = Validate_and_RetrieveResponderID(&buf, remoteCredential, &remoteDeviceOpCert, remoteDeviceOpCertLen);
-    SuccessOrExit(err);
+exit:
+    return err;
+}
 
-    // Step 6 - Construct msg_R2_Signed and validate the signature in msg_r2_encrypted
-    msg_r2_signed_len = static_cast<uint16_t>(sizeof(uint16_t) + remoteDeviceOpCertLen + kP256_PublicKey_Length * 2);
+CHIP_ERROR CASESession::ValidateSigmaR2()
+{
+    // Step 5
+    // Validate responder identity located in msg_r2_encrypted, and construct msg_R2_Signed
+    ReturnErrorOnFailure(RetrieveSignedCredentials(kSigmaR2EncryptedOffset));
 
-    msg_R2_Signed = System::PacketBufferHandle::New(msg_r2_signed_len);
-    VerifyOrExit(!msg_R2_Signed.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-    msg_R2_Signed->SetDataLength(msg_r2_signed_len);
+    ReturnErrorOnFailure(AllocPendingMsg(kTAGSize));
 
-    sigLen = buflen - kSigmaParamRandomNumberSize - sizeof(encryptionKeyId) - kTrustedRootIdSize - kP256_PublicKey_Length -
-        sizeof(uint16_t) - remoteDeviceOpCertLen - kTAGSize;
-    err = ConstructSignedCredentials(&buf, remoteDeviceOpCert, remoteDeviceOpCertLen, msg_R2_Signed, sigmaR2SignedData, sigLen);
-    SuccessOrExit(err);
+    return RunCryptoStep(&CASESession::VerifySigmaR2_and_ComputeSigmaR3, &CASESession::SendSigmaR3);
+}
 
-    err = remoteCredential.ECDSA_validate_msg_signature(msg_R2_Signed->Start(), msg_r2_signed_len, sigmaR2SignedData);
-    SuccessOrExit(err);
+CHIP_ERROR CASESession::VerifySigmaR2_and_ComputeSigmaR3()
+{
+    // Step 6
+    ReturnErrorOnFailure(VerifySignedCredentials());
 
-exit:
-    if (err == CHIP_ERROR_INVALID_SIGNATURE)
-    {
-        SendErrorMsg(SigmaErrorType::kInvalidSignature);
-    }
-    else if (err == CHIP_ERROR_CERT_NOT_TRUSTED)
-    {
-        SendErrorMsg(SigmaErrorType::kNoSharedTrustRoots);
-    }
-    else if (err != CHIP_NO_ERROR)
-    {
-        SendErrorMsg(SigmaErrorType::kUnexpected);
-    }
-    return err;
+    return ComputeSigmaR3();
 }
 
-CHIP_ERROR CASESession::SendSigmaR3()
+CHIP_ERROR CASESession::ComputeSigmaR3()
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    System::PacketBufferHandle msg_R3;
     uint16_t data_len;
 
-    System::PacketBufferHandle msg_R3_Encrypted;
     uint16_t msg_r3_encrypted_len;
 
-    System::PacketBufferHandle msg_salt;
-    uint16_t saltlen;
+    uint8_t msg_salt[kIPKSize + kSHA256_Hash_Length];
 
     uint8_t sr3k[kAEADKeySize];
 
-    System::PacketBufferHandle msg_R3_Signed;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R3_Signed;
     uint16_t msg_r3_signed_len;
 
     P256ECDSASignature sigmaR3Signature;
@@ -723,17 +802,12 @@ CHIP_ERROR CASESession::SendSigmaR3()
     HKDF_sha_crypto mHKDF;
 
     // Step 1
-    saltlen = kIPKSize + kSHA256_Hash_Length;
-
     ChipLogDetail(Inet, "Sending SigmaR3");
-    msg_salt = System::PacketBufferHandle::New(saltlen);
-    VerifyOrExit(!msg_salt.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-    msg_salt->SetDataLength(saltlen);
 
-    err = ConstructSaltSigmaR3(mIPK, sizeof(mIPK), msg_salt);
+    err = ConstructSaltSigmaR3(mIPK, sizeof(mIPK), msg_salt, sizeof(msg_salt));
     SuccessOrExit(err);
 
-    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt->Start(), saltlen, kKDFSR3Info, kKDFInfoLength, sr3k,
+    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt, sizeof(msg_salt), kKDFSR3Info, kKDFInfoLength, sr3k,
                             kAEADKeySize);
     SuccessOrExit(err);
 
@@ -741,11 +815,10 @@ CHIP_ERROR CASESession::SendSigmaR3()
     msg_r3_signed_len =
         static_cast<uint16_t>(sizeof(uint16_t) + mOpCredSet->GetDevOpCredLen(mTrustedRootId) + kP256_PublicKey_Length * 2);
 
-    msg_R3_Signed = System::PacketBufferHandle::New(msg_r3_signed_len);
-    VerifyOrExit(!msg_R3_Signed.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
+    VerifyOrExit(msg_R3_Signed.Alloc(msg_r3_signed_len), err = CHIP_ERROR_NO_MEMORY);
 
     {
-        Encoding::LittleEndian::BufferWriter bbuf(msg_R3_Signed->Start(), msg_r3_signed_len);
+        Encoding::LittleEndian::BufferWriter bbuf(msg_R3_Signed.Get(), msg_r3_signed_len);
 
         bbuf.Put(mEphemeralKey.Pubkey(), mEphemeralKey.Pubkey().Length());
         bbuf.Put16(mOpCredSet->GetDevOpCredLen(mTrustedRootId));
@@ -755,21 +828,20 @@ CHIP_ERROR CASESession::SendSigmaR3()
         VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
     }
 
-    msg_R3_Signed->SetDataLength(msg_r3_signed_len);
-
     // Step 3
-    err = mOpCredSet->SignMsg(mTrustedRootId, msg_R3_Signed->Start(), msg_R3_Signed->DataLength(), sigmaR3Signature);
+    err = SignMsg(msg_R3_Signed.Get(), msg_r3_signed_len, sigmaR3Signature);
     SuccessOrExit(err);
 
     // Step 4
     msg_r3_encrypted_len = static_cast<uint16_t>(sizeof(uint16_t) + mOpCredSet->GetDevOpCredLen(mTrustedRootId) +
                                                  static_cast<uint16_t>(sigmaR3Signature.Length()));
 
-    msg_R3_Encrypted = System::PacketBufferHandle::New(msg_r3_encrypted_len);
-    VerifyOrExit(!msg_R3_Encrypted.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
+    data_len = static_cast<uint16_t>(sizeof(tag) + msg_r3_encrypted_len);
 
+    // The message is encrypted in place, in the buffer allocated on the CHIP thread
+    VerifyOrExit(mPendingMsg->AvailableDataLength() >= data_len, err = CHIP_ERROR_NO_MEMORY);
     {
-        Encoding::LittleEndian::BufferWriter bbuf(msg_R3_Encrypted->Start(), msg_r3_encrypted_len);
+        Encoding::LittleEndian::BufferWriter bbuf(mPendingMsg->Start(), msg_r3_encrypted_len);
 
         bbuf.Put16(mOpCredSet->GetDevOpCredLen(mTrustedRootId));
         bbuf.Put(mOpCredSet->GetDevOpCred(mTrustedRootId), mOpCredSet->GetDevOpCredLen(mTrustedRootId));
@@ -778,143 +850,379 @@ CHIP_ERROR CASESession::SendSigmaR3()
         VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
     }
 
-    msg_R3_Encrypted->SetDataLength(msg_r3_encrypted_len);
-
     // Step 5
-    err = AES_CCM_encrypt(msg_R3_Encrypted->Start(), msg_r3_encrypted_len, nullptr, 0, sr3k, kAEADKeySize, kIVSR3, kIVLength,
-                          msg_R3_Encrypted->Start(), tag, sizeof(tag));
+    err = AES_CCM_encrypt(mPendingMsg->Start(), msg_r3_encrypted_len, nullptr, 0, sr3k, kAEADKeySize, kIVSR3, kIVLength,
+                          mPendingMsg->Start(), tag, sizeof(tag));
     SuccessOrExit(err);
 
     // Step 6
-    data_len = static_cast<uint16_t>(sizeof(tag) + msg_r3_encrypted_len);
+    memcpy(mPendingMsg->Start() + msg_r3_encrypted_len, tag, sizeof(tag));
+    mPendingMsg->SetDataLength(data_len);
 
-    msg_R3 = System::PacketBufferHandle::New(data_len);
-    VerifyOrExit(!msg_R3.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
+exit:
+    return err;
+}
 
-    {
-        Encoding::LittleEndian::BufferWriter bbuf(msg_R3->Start(), data_len);
+CHIP_ERROR CASESession::SendSigmaR3()
+{
+    System::PacketBufferHandle msg_R3 = std::move(mPendingMsg);
 
-        bbuf.Put(msg_R3_Encrypted->Start(), msg_R3_Encrypted->DataLength());
-        bbuf.Put(tag, sizeof(tag));
+    ReturnErrorOnFailure(mCommissioningHash.AddData(msg_R3->Start(), msg_R3->DataLength()));
 
-        VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
+    // Call delegate to send the Msg3 to peer
+    ReturnErrorOnFailure(mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR3, std::move(msg_R3)));
+
+    ChipLogDetail(Inet, "Sent SigmaR3 msg");
+
+    ReturnErrorOnFailure(mCommissioningHash.Finish(mMessageDigest));
+
+    mPairingComplete = true;
+    SaveResumptionTicket();
+
+    // Call delegate to indicate pairing completion
+    mDelegate->OnSessionEstablished();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASESession::HandleSigmaR3(System::PacketBufferHandle && msg)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    ChipLogDetail(Inet, "Received SigmaR3 msg");
+
+    mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
+
+    VerifyOrExit(msg->DataLength() >= kTAGSize, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    mPendingMsg = std::move(msg);
+
+    // Steps 1 to 4 continue in DecryptSigmaR3(), ValidateSigmaR3() and VerifySignedCredentials()
+    err = RunCryptoStep(&CASESession::DecryptSigmaR3, &CASESession::ValidateSigmaR3);
+    SuccessOrExit(err);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        SendErrorMsgFor(err);
     }
+    return err;
+}
 
-    msg_R3->SetDataLength(data_len);
+CHIP_ERROR CASESession::DecryptSigmaR3()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    uint8_t sr3k[kAEADKeySize];
+
+    uint8_t msg_salt[kIPKSize + kSHA256_Hash_Length];
+
+    uint8_t * tag = mPendingMsg->Start() + mPendingMsg->DataLength() - kTAGSize;
+
+    HKDF_sha_crypto mHKDF;
 
-    err = mCommissioningHash.AddData(msg_R3->Start(), msg_R3->DataLength());
+    // Step 1
+    err = ComputeIPK(mConnectionState.GetPeerKeyID(), mRemoteIPK, sizeof(mRemoteIPK));
     SuccessOrExit(err);
 
-    // Call delegate to send the Msg3 to peer
-    err = mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR3, std::move(msg_R3));
+    err = ConstructSaltSigmaR3(mRemoteIPK, sizeof(mRemoteIPK), msg_salt, sizeof(msg_salt));
     SuccessOrExit(err);
 
-    ChipLogDetail(Inet, "Sent SigmaR3 msg");
+    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt, sizeof(msg_salt), kKDFSR3Info, kKDFInfoLength, sr3k,
+                            kAEADKeySize);
+    SuccessOrExit(err);
 
-    err = mCommissioningHash.Finish(mMessageDigest);
+    err = mCommissioningHash.AddData(mPendingMsg->Start(), mPendingMsg->DataLength());
+    SuccessOrExit(err);
+
+    // Step 2
+    err = AES_CCM_decrypt(mPendingMsg->Start(), mPendingMsg->DataLength() - kTAGSize, nullptr, 0, tag, kTAGSize, sr3k,
+                          kAEADKeySize, kIVSR3, kIVLength, mPendingMsg->Start());
     SuccessOrExit(err);
 
+exit:
+    return err;
+}
+
+CHIP_ERROR CASESession::ValidateSigmaR3()
+{
+    // Step 3
+    // Validate initiator identity located in the decrypted message, and construct msg_R3_Signed
+    ReturnErrorOnFailure(RetrieveSignedCredentials(0));
+
+    // Step 4
+    return RunCryptoStep(&CASESession::VerifySignedCredentials, &CASESession::FinishSigmaR3);
+}
+
+CHIP_ERROR CASESession::FinishSigmaR3()
+{
+    ReturnErrorOnFailure(mCommissioningHash.Finish(mMessageDigest));
+
     mPairingComplete = true;
+    SaveResumptionTicket();
 
     // Call delegate to indicate pairing completion
     mDelegate->OnSessionEstablished();
 
-exit:
+    return CHIP_NO_ERROR;
+}
+
+// Allocate the Sigma message a step builds off the CHIP thread: the given overhead, followed by our operational certificate
+// and signature
+CHIP_ERROR CASESession::AllocPendingMsg(size_t overhead)
+{
+    size_t len = overhead + sizeof(uint16_t) + mOpCredSet->GetDevOpCredLen(mTrustedRootId) + kMax_ECDSA_Signature_Length;
+
+    VerifyOrReturnError(CanCastTo<uint16_t>(len), CHIP_ERROR_NO_MEMORY);
+
+    mPendingMsg = System::PacketBufferHandle::New(len);
+    VerifyOrReturnError(!mPendingMsg.IsNull(), CHIP_SYSTEM_ERROR_NO_MEMORY);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASESession::SignMsg(const uint8_t * msg, size_t msgLen, P256ECDSASignature & signature)
+{
+    CHIP_ERROR err;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    int pthreadErr = pthread_mutex_lock(&gsSignMsgMutex);
+    VerifyOrDie(pthreadErr == 0);
+#endif
+
+    err = mOpCredSet->SignMsg(mTrustedRootId, msg, msgLen, signature);
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    pthreadErr = pthread_mutex_unlock(&gsSignMsgMutex);
+    VerifyOrDie(pthreadErr == 0);
+#endif
+
+    return err;
+}
+
+CHIP_ERROR CASESession::RunCryptoStep(HandshakeStep step, HandshakeStep continuation)
+{
+    CryptoOffload * offload = (mCryptoOffload != nullptr) ? mCryptoOffload : GetDefaultCryptoOffload();
+
+    if (offload == nullptr)
+    {
+        ReturnErrorOnFailure((this->*step)());
+        return (this->*continuation)();
+    }
 
+    mCryptoStepJob.mSession      = this;
+    mCryptoStepJob.mStep         = step;
+    mCryptoStepJob.mContinuation = continuation;
+    ReturnErrorOnFailure(offload->Submit(mCryptoStepJob));
+    mCryptoStepJob.mOffload = offload;
+
+    return CHIP_NO_ERROR;
+}
+
+void CASESession::OnCryptoStepComplete(CHIP_ERROR result)
+{
+    CHIP_ERROR err = result;
+
+    mCryptoStepJob.mOffload = nullptr;
+    SuccessOrExit(err);
+
+    err = (this->*mCryptoStepJob.mContinuation)();
+    SuccessOrExit(err);
+
+exit:
+    // Call delegate to indicate session establishment failure, as OnMessageReceived() does for the steps run inline.
     if (err != CHIP_NO_ERROR)
     {
-        SendErrorMsg(SigmaErrorType::kUnexpected);
+        SendErrorMsgFor(err);
+        mDelegate->OnSessionEstablishmentError(err);
     }
-    return err;
 }
 
-CHIP_ERROR CASESession::HandleSigmaR3(const System::PacketBufferHandle & msg)
+CHIP_ERROR CASESession::SendSigmaR2Resume()
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    const uint8_t * buf = msg->Start();
+    System::PacketBufferHandle msg_R2_Resume;
+    uint16_t data_len =
+        static_cast<uint16_t>(kSigmaParamRandomNumberSize + sizeof(uint16_t) + kP256_PublicKey_Length + kResumeMICSize);
 
-    System::PacketBufferHandle msg_R3_Signed;
-    uint16_t msg_r3_signed_len;
+    uint8_t mic[kResumeMICSize];
 
-    uint8_t sr3k[kAEADKeySize];
+    msg_R2_Resume = System::PacketBufferHandle::New(data_len);
+    VerifyOrExit(!msg_R2_Resume.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
 
-    P256ECDSASignature sigmaR3SignedData;
-    size_t sigLen;
+    // Step 1
+    // Key the resumed session on a fresh random and ephemeral key of the responder as well
+    err = DRBG_get_bytes(mResponderRandom, sizeof(mResponderRandom));
+    SuccessOrExit(err);
 
-    P256PublicKey remoteCredential;
+    err = mEphemeralKey.Initialize();
+    SuccessOrExit(err);
 
-    const uint8_t * remoteDeviceOpCert;
-    uint16_t remoteDeviceOpCertLen;
+    // Step 2
+    err = DeriveResumedSecret();
+    SuccessOrExit(err);
 
-    System::PacketBufferHandle msg_salt;
-    uint16_t saltlen;
+    // Step 3
+    // Prove the responder holds the secret of the ticket and its ephemeral key, over the session ID it assigns
+    err = ComputeResumeMIC(mSharedSecret, mSharedSecret.Length(), kKDFS2RKInfo, sizeof(kKDFS2RKInfo),
+                           mConnectionState.GetLocalKeyID(), mic);
+    SuccessOrExit(err);
+
+    {
+        Encoding::LittleEndian::BufferWriter bbuf(msg_R2_Resume->Start(), data_len);
+        bbuf.Put(mResponderRandom, sizeof(mResponderRandom));
+        // Responder's session ID
+        bbuf.Put16(mConnectionState.GetLocalKeyID());
+        bbuf.Put(mEphemeralKey.Pubkey(), mEphemeralKey.Pubkey().Length());
+        bbuf.Put(mic, sizeof(mic));
+        VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
+    }
 
-    uint8_t * tag = msg->Start() + msg->DataLength() - kTAGSize;
+    msg_R2_Resume->SetDataLength(data_len);
 
-    HKDF_sha_crypto mHKDF;
+    err = mCommissioningHash.AddData(msg_R2_Resume->Start(), msg_R2_Resume->DataLength());
+    SuccessOrExit(err);
 
-    ChipLogDetail(Inet, "Received SigmaR3 msg");
+    mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaR3Resume;
+
+    // Call delegate to send the msg to peer
+    err = mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR2Resume, std::move(msg_R2_Resume),
+                                     SendFlags(SendMessageFlags::kExpectResponse));
+    SuccessOrExit(err);
+
+    ChipLogDetail(Inet, "Sent SigmaR2Resume msg");
+
+exit:
+
+    if (err != CHIP_NO_ERROR)
+    {
+        SendErrorMsg(SigmaErrorType::kUnexpected);
+    }
+    return err;
+}
+
+CHIP_ERROR CASESession::HandleSigmaR2Resume_and_SendSigmaR3Resume(const System::PacketBufferHandle & msg)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    const uint8_t * buf      = msg->Start();
+    uint16_t encryptionKeyId = 0;
+
+    System::PacketBufferHandle msg_R3_Resume;
+    uint8_t mic[kResumeMICSize];
+
+    Encoding::LittleEndian::BufferWriter bbuf(mRemotePubKey, mRemotePubKey.Length());
+
+    ChipLogDetail(Inet, "Received SigmaR2Resume msg");
 
     mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
 
+    VerifyOrExit(buf != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+    VerifyOrExit(msg->DataLength() ==
+                     kSigmaParamRandomNumberSize + sizeof(encryptionKeyId) + kP256_PublicKey_Length + kResumeMICSize,
+                 err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
     // Step 1
-    saltlen = kIPKSize + kSHA256_Hash_Length;
+    memcpy(mResponderRandom, buf, sizeof(mResponderRandom));
+    buf += kSigmaParamRandomNumberSize;
 
-    msg_salt = System::PacketBufferHandle::New(saltlen);
-    VerifyOrExit(!msg_salt.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-    msg_salt->SetDataLength(saltlen);
+    encryptionKeyId = chip::Encoding::LittleEndian::Read16(buf);
 
-    err = ComputeIPK(mConnectionState.GetPeerKeyID(), mRemoteIPK, sizeof(mRemoteIPK));
-    SuccessOrExit(err);
+    bbuf.Put(buf, kP256_PublicKey_Length);
+    VerifyOrExit(bbuf.Fit(), err = CHIP_ERROR_NO_MEMORY);
+    buf += kP256_PublicKey_Length;
 
-    err = ConstructSaltSigmaR3(mRemoteIPK, sizeof(mRemoteIPK), msg_salt);
+    // Step 2
+    err = DeriveResumedSecret();
     SuccessOrExit(err);
 
-    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), msg_salt->Start(), saltlen, kKDFSR3Info, kKDFInfoLength, sr3k,
-                            kAEADKeySize);
+    // Step 3
+    err = ComputeResumeMIC(mSharedSecret, mSharedSecret.Length(), kKDFS2RKInfo, sizeof(kKDFS2RKInfo), encryptionKeyId, mic);
     SuccessOrExit(err);
+    VerifyOrExit(IsEqualMIC(mic, buf), err = CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    ChipLogDetail(Inet, "Peer assigned session key ID %d", encryptionKeyId);
+    mConnectionState.SetPeerKeyID(encryptionKeyId);
 
     err = mCommissioningHash.AddData(msg->Start(), msg->DataLength());
     SuccessOrExit(err);
 
-    // Step 2
-    err = AES_CCM_decrypt(msg->Start(), msg->DataLength() - kTAGSize, nullptr, 0, tag, kTAGSize, sr3k, kAEADKeySize, kIVSR3,
-                          kIVLength, msg->Start());
+    // Step 4
+    // Confirm the resumed session to the responder, which establishes it only then
+    msg_R3_Resume = System::PacketBufferHandle::New(kResumeMICSize);
+    VerifyOrExit(!msg_R3_Resume.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
+
+    err = ComputeResumeMIC(mSharedSecret, mSharedSecret.Length(), kKDFS3RKInfo, sizeof(kKDFS3RKInfo),
+                           mConnectionState.GetLocalKeyID(), msg_R3_Resume->Start());
     SuccessOrExit(err);
 
-    // Step 3
-    // Validate initiator identity located in msg->Start()
-    // Constructing responder identity
-    err = Validate_and_RetrieveResponderID(&buf, remoteCredential, &remoteDeviceOpCert, remoteDeviceOpCertLen);
+    msg_R3_Resume->SetDataLength(kResumeMICSize);
+
+    err = mCommissioningHash.AddData(msg_R3_Resume->Start(), msg_R3_Resume->DataLength());
     SuccessOrExit(err);
 
-    // Step 4
-    msg_r3_signed_len = static_cast<uint16_t>(sizeof(uint16_t) + remoteDeviceOpCertLen + kP256_PublicKey_Length * 2);
+    err = mCommissioningHash.Finish(mMessageDigest);
+    SuccessOrExit(err);
+
+    // Call delegate to send the msg to peer
+    err = mExchangeCtxt->SendMessage(Protocols::SecureChannel::MsgType::CASE_SigmaR3Resume, std::move(msg_R3_Resume));
+    SuccessOrExit(err);
+
+    ChipLogDetail(Inet, "Sent SigmaR3Resume msg");
+
+    mPairingComplete = true;
+    SaveResumptionTicket();
+
+    // Call delegate to indicate pairing completion
+    mDelegate->OnSessionEstablished();
+
+exit:
+    if (err == CHIP_ERROR_INTEGRITY_CHECK_FAILED)
+    {
+        SendErrorMsg(SigmaErrorType::kInvalidResumptionTag);
+    }
+    else if (err != CHIP_NO_ERROR)
+    {
+        SendErrorMsg(SigmaErrorType::kUnexpected);
+    }
+    return err;
+}
 
-    msg_R3_Signed = System::PacketBufferHandle::New(msg_r3_signed_len);
-    VerifyOrExit(!msg_R3_Signed.IsNull(), err = CHIP_SYSTEM_ERROR_NO_MEMORY);
-    msg_R3_Signed->SetDataLength(msg_r3_signed_len);
+CHIP_ERROR CASESession::HandleSigmaR3Resume(const System::PacketBufferHandle & msg)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
 
-    sigLen = msg->DataLength() - sizeof(uint16_t) - remoteDeviceOpCertLen - kTAGSize;
-    err    = ConstructSignedCredentials(&buf, remoteDeviceOpCert, remoteDeviceOpCertLen, msg_R3_Signed, sigmaR3SignedData, sigLen);
+    uint8_t mic[kResumeMICSize];
+
+    ChipLogDetail(Inet, "Received SigmaR3Resume msg");
+
+    mNextExpectedMsg = Protocols::SecureChannel::MsgType::CASE_SigmaErr;
+
+    VerifyOrExit(msg->Start() != nullptr, err = CHIP_ERROR_MESSAGE_INCOMPLETE);
+    VerifyOrExit(msg->DataLength() == kResumeMICSize, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    // Only the initiator that drew the random and holds the ephemeral key of SigmaR1 can confirm the session
+    err = ComputeResumeMIC(mSharedSecret, mSharedSecret.Length(), kKDFS3RKInfo, sizeof(kKDFS3RKInfo),
+                           mConnectionState.GetPeerKeyID(), mic);
     SuccessOrExit(err);
+    VerifyOrExit(IsEqualMIC(mic, msg->Start()), err = CHIP_ERROR_INTEGRITY_CHECK_FAILED);
 
-    err = remoteCredential.ECDSA_validate_msg_signature(msg_R3_Signed->Start(), msg_r3_signed_len, sigmaR3SignedData);
+    err = mCommissioningHash.AddData(msg->Start(), msg->DataLength());
     SuccessOrExit(err);
 
     err = mCommissioningHash.Finish(mMessageDigest);
     SuccessOrExit(err);
 
     mPairingComplete = true;
+    SaveResumptionTicket();
 
     // Call delegate to indicate pairing completion
     mDelegate->OnSessionEstablished();
 
 exit:
-    if (err == CHIP_ERROR_INVALID_SIGNATURE)
+    if (err == CHIP_ERROR_INTEGRITY_CHECK_FAILED)
     {
-        SendErrorMsg(SigmaErrorType::kInvalidSignature);
+        SendErrorMsg(SigmaErrorType::kInvalidResumptionTag);
     }
     else if (err != CHIP_NO_ERROR)
     {
@@ -946,6 +1254,22 @@ exit:
     Clear();
 }
 
+void CASESession::SendErrorMsgFor(CHIP_ERROR err)
+{
+    if (err == CHIP_ERROR_INVALID_SIGNATURE)
+    {
+        SendErrorMsg(SigmaErrorType::kInvalidSignature);
+    }
+    else if (err == CHIP_ERROR_CERT_NOT_TRUSTED)
+    {
+        SendErrorMsg(SigmaErrorType::kNoSharedTrustRoots);
+    }
+    else
+    {
+        SendErrorMsg(SigmaErrorType::kUnexpected);
+    }
+}
+
 CHIP_ERROR CASESession::FindValidTrustedRoot(const uint8_t ** msgIterator, uint32_t nTrustedRoots)
 {
     CertificateKeyId trustedRoot[kMaxTrustedRootIds];
@@ -972,15 +1296,15 @@ CHIP_ERROR CASESession::FindValidTrustedRoot(const uint8_t ** msgIterator, uint3
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASESession::ConstructSaltSigmaR2(const System::PacketBufferHandle & rand, const P256PublicKey & pubkey,
-                                             const uint8_t * ipk, size_t ipkLen, System::PacketBufferHandle & salt)
+CHIP_ERROR CASESession::ConstructSaltSigmaR2(const uint8_t * rand, const P256PublicKey & pubkey, const uint8_t * ipk,
+                                             size_t ipkLen, uint8_t * salt, size_t saltLen)
 {
     uint8_t md[kSHA256_Hash_Length];
-    memset(salt->Start(), 0, salt->DataLength());
-    Encoding::LittleEndian::BufferWriter bbuf(salt->Start(), salt->DataLength());
+    memset(salt, 0, saltLen);
+    Encoding::LittleEndian::BufferWriter bbuf(salt, saltLen);
 
     bbuf.Put(ipk, ipkLen);
-    bbuf.Put(rand->Start(), kSigmaParamRandomNumberSize);
+    bbuf.Put(rand, kSigmaParamRandomNumberSize);
     bbuf.Put(pubkey, pubkey.Length());
     ReturnErrorOnFailure(mCommissioningHash.Finish(md));
     bbuf.Put(md, kSHA256_Hash_Length);
@@ -991,11 +1315,11 @@ CHIP_ERROR CASESession::ConstructSaltSigmaR2(const System::PacketBufferHandle &
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR CASESession::ConstructSaltSigmaR3(const uint8_t * ipk, size_t ipkLen, System::PacketBufferHandle & salt)
+CHIP_ERROR CASESession::ConstructSaltSigmaR3(const uint8_t * ipk, size_t ipkLen, uint8_t * salt, size_t saltLen)
 {
     uint8_t md[kSHA256_Hash_Length];
-    memset(salt->Start(), 0, salt->DataLength());
-    Encoding::LittleEndian::BufferWriter bbuf(salt->Start(), salt->DataLength());
+    memset(salt, 0, saltLen);
+    Encoding::LittleEndian::BufferWriter bbuf(salt, saltLen);
 
     bbuf.Put(ipk, ipkLen);
     ReturnErrorOnFailure(mCommissioningHash.Finish(md));
@@ -1010,8 +1334,12 @@ CHIP_ERROR CASESession::ConstructSaltSigmaR3(const uint8_t * ipk, size_t ipkLen,
 CHIP_ERROR CASESession::Validate_and_RetrieveResponderID(const uint8_t ** msgIterator, P256PublicKey & responderID,
                                                          const uint8_t ** responderOpCert, uint16_t & responderOpCertLen)
 {
+    CHIP_ERROR err = CHIP_NO_ERROR;
     ChipCertificateData chipCertData;
     ChipCertificateData * resultCert = nullptr;
+    ChipCertificateSet * certSet     = mOpCredSet->FindCertSet(mTrustedRootId);
+
+    VerifyOrReturnError(certSet != nullptr, CHIP_ERROR_CERT_NOT_TRUSTED);
 
     responderOpCertLen = chip::Encoding::LittleEndian::Read16(*msgIterator);
     *responderOpCert   = *msgIterator;
@@ -1025,20 +1353,23 @@ CHIP_ERROR CASESession::Validate_and_RetrieveResponderID(const uint8_t ** msgIte
     VerifyOrReturnError(bbuf.Fit(), CHIP_ERROR_NO_MEMORY);
 
     // Validate responder identity located in msg_r2_encrypted
-    ReturnErrorOnFailure(
-        mOpCredSet->FindCertSet(mTrustedRootId)
-            ->LoadCert(*responderOpCert, responderOpCertLen, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
+    ReturnErrorOnFailure(certSet->LoadCert(*responderOpCert, responderOpCertLen,
+                                           BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
 
-    ReturnErrorOnFailure(SetEffectiveTime());
+    err = SetEffectiveTime();
     // Locate the subject DN and key id that will be used as input the FindValidCert() method.
+    if (err == CHIP_NO_ERROR)
     {
         const ChipDN & subjectDN              = chipCertData.mSubjectDN;
         const CertificateKeyId & subjectKeyId = chipCertData.mSubjectKeyId;
 
-        ReturnErrorOnFailure(mOpCredSet->FindValidCert(mTrustedRootId, subjectDN, subjectKeyId, mValidContext, resultCert));
+        err = mOpCredSet->FindValidCert(mTrustedRootId, subjectDN, subjectKeyId, mValidContext, resultCert);
     }
 
-    return CHIP_NO_ERROR;
+    // The certificate refers to the message, which is released once the handshake moves on
+    certSet->ReleaseLastCert();
+
+    return err;
 }
 
 CHIP_ERROR CASESession::ConstructSignedCredentials(const uint8_t ** msgIterator, const uint8_t * responderOpCert,
@@ -1065,6 +1396,41 @@ CHIP_ERROR CASESession::ConstructSignedCredentials(const uint8_t ** msgIterator,
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CASESession::RetrieveSignedCredentials(size_t credentialsOffset)
+{
+    const uint8_t * buf = mPendingMsg->Start() + credentialsOffset;
+    size_t buflen       = mPendingMsg->DataLength();
+
+    const uint8_t * remoteDeviceOpCert;
+    uint16_t remoteDeviceOpCertLen;
+
+    uint16_t signedLen;
+    size_t sigLen;
+
+    ReturnErrorOnFailure(Validate_and_RetrieveResponderID(&buf, mRemoteCredential, &remoteDeviceOpCert, remoteDeviceOpCertLen));
+
+    signedLen = static_cast<uint16_t>(sizeof(uint16_t) + remoteDeviceOpCertLen + kP256_PublicKey_Length * 2);
+
+    mRemoteSignedData = System::PacketBufferHandle::New(signedLen);
+    VerifyOrReturnError(!mRemoteSignedData.IsNull(), CHIP_SYSTEM_ERROR_NO_MEMORY);
+    mRemoteSignedData->SetDataLength(signedLen);
+
+    sigLen = buflen - credentialsOffset - sizeof(uint16_t) - remoteDeviceOpCertLen - kTAGSize;
+    ReturnErrorOnFailure(
+        ConstructSignedCredentials(&buf, remoteDeviceOpCert, remoteDeviceOpCertLen, mRemoteSignedData, mRemoteSignature, sigLen));
+
+    // The signature is verified from the credentials alone
+    mPendingMsg = nullptr;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASESession::VerifySignedCredentials()
+{
+    return mRemoteCredential.ECDSA_validate_msg_signature(mRemoteSignedData->Start(), mRemoteSignedData->DataLength(),
+                                                          mRemoteSignature);
+}
+
 CHIP_ERROR CASESession::ComputeIPK(const uint16_t sessionID, uint8_t * ipk, size_t ipkLen)
 {
     HKDF_sha_crypto mHKDF;
@@ -1074,6 +1440,76 @@ CHIP_ERROR CASESession::ComputeIPK(const uint16_t sessionID, uint8_t * ipk, size
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CASESession::ComputeResumeMIC(const uint8_t * key, size_t keyLen, const uint8_t * info, size_t infoLen,
+                                         uint16_t sessionID, uint8_t * mic)
+{
+    HKDF_sha_crypto mHKDF;
+    uint8_t salt[2 * kSigmaParamRandomNumberSize + kCASEResumptionIdSize + sizeof(sessionID)];
+
+    // The MIC covers the fresh randoms of both sides, so that it cannot be replayed
+    Encoding::LittleEndian::BufferWriter bbuf(salt, sizeof(salt));
+    bbuf.Put(mInitiatorRandom, sizeof(mInitiatorRandom));
+    bbuf.Put(mResponderRandom, sizeof(mResponderRandom));
+    bbuf.Put(mResumptionId, sizeof(mResumptionId));
+    bbuf.Put16(sessionID);
+    VerifyOrReturnError(bbuf.Fit(), CHIP_ERROR_NO_MEMORY);
+
+    return mHKDF.HKDF_SHA256(key, keyLen, salt, sizeof(salt), info, infoLen, mic, kResumeMICSize);
+}
+
+CHIP_ERROR CASESession::DeriveResumedSecret()
+{
+    HKDF_sha_crypto mHKDF;
+    P256ECDHDerivedSecret ecdhSecret;
+    uint8_t salt[kCASEResumptionSecretSize + 2 * kSigmaParamRandomNumberSize];
+
+    // The ECDH of the ephemeral keys gives the resumed session forward secrecy, the secret of the ticket authenticates
+    // the peer, and the randoms of both sides tie the secret to this handshake.
+    ReturnErrorOnFailure(mEphemeralKey.ECDH_derive_secret(mRemotePubKey, ecdhSecret));
+
+    Encoding::LittleEndian::BufferWriter bbuf(salt, sizeof(salt));
+    bbuf.Put(mResumptionSecret, sizeof(mResumptionSecret));
+    bbuf.Put(mInitiatorRandom, sizeof(mInitiatorRandom));
+    bbuf.Put(mResponderRandom, sizeof(mResponderRandom));
+    VerifyOrReturnError(bbuf.Fit(), CHIP_ERROR_NO_MEMORY);
+
+    ReturnErrorOnFailure(mSharedSecret.SetLength(mSharedSecret.Capacity()));
+    return mHKDF.HKDF_SHA256(ecdhSecret, ecdhSecret.Length(), salt, sizeof(salt), kKDFResumedSecretInfo,
+                             sizeof(kKDFResumedSecretInfo), mSharedSecret, mSharedSecret.Length());
+}
+
+void CASESession::SaveResumptionTicket()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    HKDF_sha_crypto mHKDF;
+    uint8_t ticket[kCASEResumptionIdSize + kCASEResumptionSecretSize];
+
+    VerifyOrReturn(mResumptionCache != nullptr);
+
+    // The ticket for the next session is derived from this one, as its keys are, but with its own info
+    err = mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), mMessageDigest, sizeof(mMessageDigest),
+                            kKDFResumptionTicketInfo, sizeof(kKDFResumptionTicketInfo), ticket, sizeof(ticket));
+    SuccessOrExit(err);
+
+    // The ticket a session was resumed from is used up: the new one overwrites it, unless it was evicted meanwhile
+    err = CHIP_ERROR_KEY_NOT_FOUND;
+    if (mResuming)
+    {
+        err = mResumptionCache->Replace(mResumptionId, ticket, ticket + kCASEResumptionIdSize);
+    }
+    if (err == CHIP_ERROR_KEY_NOT_FOUND)
+    {
+        err = mResumptionCache->Save(mConnectionState.GetPeerNodeId(), ticket, ticket + kCASEResumptionIdSize);
+    }
+    SuccessOrExit(err);
+
+exit:
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to save CASE resumption ticket: %s", ErrorStr(err));
+    }
+}
+
 // TODO: Remove this and replace with system method to retrieve current time
 CHIP_ERROR CASESession::SetEffectiveTime(void)
 {
@@ -1134,7 +1570,9 @@ CHIP_ERROR CASESession::ValidateReceivedMessage(ExchangeContext * ec, const Pack
 
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(payloadHeader.HasMessageType(mNextExpectedMsg) ||
-                            payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::CASE_SigmaErr),
+                            payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::CASE_SigmaErr) ||
+                            (mResuming && mNextExpectedMsg == Protocols::SecureChannel::MsgType::CASE_SigmaR2 &&
+                             payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::CASE_SigmaR2Resume)),
                         CHIP_ERROR_INVALID_MESSAGE_TYPE);
 
     if (packetHeader.GetSourceNodeId().HasValue())
@@ -1173,11 +1611,19 @@ void CASESession::OnMessageReceived(ExchangeContext * ec, const PacketHeader & p
         break;
 
     case Protocols::SecureChannel::MsgType::CASE_SigmaR2:
-        err = HandleSigmaR2_and_SendSigmaR3(msg);
+        err = HandleSigmaR2(std::move(msg));
+        break;
+
+    case Protocols::SecureChannel::MsgType::CASE_SigmaR2Resume:
+        err = HandleSigmaR2Resume_and_SendSigmaR3Resume(msg);
+        break;
+
+    case Protocols::SecureChannel::MsgType::CASE_SigmaR3Resume:
+        err = HandleSigmaR3Resume(msg);
         break;
 
     case Protocols::SecureChannel::MsgType::CASE_SigmaR3:
-        err = HandleSigmaR3(msg);
+        err = HandleSigmaR3(std::move(msg));
         break;
 
     case Protocols::SecureChannel::MsgType::CASE_SigmaErr:
@@ -28,11 +28,13 @@
 #include <credentials/CHIPCert.h>
 #include <credentials/CHIPOperationalCredentials.h>
 #include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CryptoOffload.h>
 #if CHIP_CRYPTO_HSM
 #include <crypto/hsm/CHIPCryptoPALHsm.h>
 #endif
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeDelegate.h>
+#include <protocols/secure_channel/CASEResumptionCache.h>
 #include <protocols/secure_channel/Constants.h>
 #include <protocols/secure_channel/SessionEstablishmentExchangeDispatch.h>
 #include <support/Base64.h>
@@ -54,6 +56,8 @@ constexpr uint16_t kMaxTrustedRootIds          = 5;
 
 constexpr uint16_t kIPKSize = 32;
 
+constexpr uint16_t kResumeMICSize = 16;
+
 using namespace Crypto;
 using namespace Credentials;
 
@@ -75,10 +79,11 @@ class DLL_EXPORT CASESession : public Messaging::ExchangeDelegateBase, public Pa
 {
 public:
     CASESession();
-    CASESession(CASESession &&)      = default;
-    CASESession(const CASESession &) = default;
-    CASESession & operator=(const CASESession &) = default;
-    CASESession & operator=(CASESession &&) = default;
+    // A crypto step in flight refers to the session, which therefore stays in place
+    CASESession(CASESession &&)      = delete;
+    CASESession(const CASESession &) = delete;
+    CASESession & operator=(const CASESession &) = delete;
+    CASESession & operator=(CASESession &&) = delete;
 
     virtual ~CASESession();
 
@@ -114,6 +119,34 @@ public:
                                 NodeId peerNodeId, uint16_t myKeyId, Messaging::ExchangeContext * exchangeCtxt,
                                 SessionEstablishmentDelegate * delegate);
 
+    /**
+     * @brief
+     *   Use a cache of resumption tickets: as the initiator, to offer resuming the session with the peer in SigmaR1; as
+     *   the responder, to accept that offer with SigmaR2Resume instead of SigmaR2, which the initiator confirms with
+     *   SigmaR3Resume. Either way, once the session is established, the ticket for the next session with the peer
+     *   replaces the previous one in the cache.
+     *
+     * @param cache  The cache, which must outlive the session, or nullptr to always perform the full handshake
+     */
+    void SetResumptionCache(CASEResumptionCache * cache) { mResumptionCache = cache; }
+
+    /**
+     * @brief
+     *  Return whether the session was established by resuming an earlier one
+     */
+    bool IsResumed() const { return mPairingComplete && mResuming; }
+
+    /**
+     * @brief
+     *   Run the ECDH and ECDSA operations of the handshake on an offload, such as a pool of worker threads, instead of on
+     *   the CHIP thread, which carries on with the handshake as each of them completes. Certificate chains are still
+     *   validated on the CHIP thread, as the certificate set is shared by the sessions using it.
+     *
+     * @param offload  The offload, which must outlive the session, or nullptr to use the default offload of the
+     *                 platform, if any
+     */
+    void SetCryptoOffload(CryptoOffload * offload) { mCryptoOffload = offload; }
+
     /**
      * @brief
      *   Derive a secure session from the established session. The API will return error
@@ -200,30 +233,66 @@ private:
 
     CHIP_ERROR Init(OperationalCredentialSet * operationalCredentialSet, uint16_t myKeyId, SessionEstablishmentDelegate * delegate);
 
+    // A step of the handshake. The steps doing ECDH and ECDSA run on the crypto offload, if any, and touch only the state
+    // of the session; the others run on the CHIP thread. Neither sends SigmaErr, see SendErrorMsgFor().
+    typedef CHIP_ERROR (CASESession::*HandshakeStep)();
+
+    class CryptoStepJob : public CryptoJob
+    {
+    public:
+        CHIP_ERROR Run() override { return (mSession->*mStep)(); }
+        void OnComplete(CHIP_ERROR result) override { mSession->OnCryptoStepComplete(result); }
+
+        CASESession * mSession      = nullptr;
+        CryptoOffload * mOffload    = nullptr; ///< The offload running the step, while it has not completed
+        HandshakeStep mStep         = nullptr;
+        HandshakeStep mContinuation = nullptr;
+    };
+
     CHIP_ERROR SendSigmaR1();
     CHIP_ERROR HandleSigmaR1_and_SendSigmaR2(const System::PacketBufferHandle & msg);
     CHIP_ERROR HandleSigmaR1(const System::PacketBufferHandle & msg);
+    CHIP_ERROR ComputeSigmaR2();
     CHIP_ERROR SendSigmaR2();
-    CHIP_ERROR HandleSigmaR2_and_SendSigmaR3(const System::PacketBufferHandle & msg);
-    CHIP_ERROR HandleSigmaR2(const System::PacketBufferHandle & msg);
+    CHIP_ERROR HandleSigmaR2(System::PacketBufferHandle && msg);
+    CHIP_ERROR DecryptSigmaR2();
+    CHIP_ERROR ValidateSigmaR2();
+    CHIP_ERROR VerifySigmaR2_and_ComputeSigmaR3();
+    CHIP_ERROR ComputeSigmaR3();
     CHIP_ERROR SendSigmaR3();
-    CHIP_ERROR HandleSigmaR3(const System::PacketBufferHandle & msg);
+    CHIP_ERROR HandleSigmaR3(System::PacketBufferHandle && msg);
+    CHIP_ERROR DecryptSigmaR3();
+    CHIP_ERROR ValidateSigmaR3();
+    CHIP_ERROR FinishSigmaR3();
 
-    CHIP_ERROR SendSigmaR1Resume();
-    CHIP_ERROR HandleSigmaR1Resume_and_SendSigmaR2Resume(const PacketHeader & header, const System::PacketBufferHandle & msg);
+    CHIP_ERROR AllocPendingMsg(size_t overhead);
+    CHIP_ERROR SignMsg(const uint8_t * msg, size_t msgLen, P256ECDSASignature & signature);
+    CHIP_ERROR RunCryptoStep(HandshakeStep step, HandshakeStep continuation);
+    void OnCryptoStepComplete(CHIP_ERROR result);
+
+    CHIP_ERROR SendSigmaR2Resume();
+    CHIP_ERROR HandleSigmaR2Resume_and_SendSigmaR3Resume(const System::PacketBufferHandle & msg);
+    CHIP_ERROR HandleSigmaR3Resume(const System::PacketBufferHandle & msg);
 
     CHIP_ERROR FindValidTrustedRoot(const uint8_t ** msgIterator, uint32_t nTrustedRoots);
-    CHIP_ERROR ConstructSaltSigmaR2(const System::PacketBufferHandle & rand, const P256PublicKey & pubkey, const uint8_t * ipk,
-                                    size_t ipkLen, System::PacketBufferHandle & salt);
+    CHIP_ERROR ConstructSaltSigmaR2(const uint8_t * rand, const P256PublicKey & pubkey, const uint8_t * ipk, size_t ipkLen,
+                                    uint8_t * salt, size_t saltLen);
     CHIP_ERROR Validate_and_RetrieveResponderID(const uint8_t ** msgIterator, P256PublicKey & responderID,
                                                 const uint8_t ** responderOpCert, uint16_t & responderOpCertLen);
-    CHIP_ERROR ConstructSaltSigmaR3(const uint8_t * ipk, size_t ipkLen, System::PacketBufferHandle & salt);
+    CHIP_ERROR ConstructSaltSigmaR3(const uint8_t * ipk, size_t ipkLen, uint8_t * salt, size_t saltLen);
     CHIP_ERROR ConstructSignedCredentials(const uint8_t ** msgIterator, const uint8_t * responderOpCert,
                                           uint16_t responderOpCertLen, System::PacketBufferHandle & signedCredentials,
                                           P256ECDSASignature & signature, size_t sigLen);
+    CHIP_ERROR RetrieveSignedCredentials(size_t credentialsOffset);
+    CHIP_ERROR VerifySignedCredentials();
     CHIP_ERROR ComputeIPK(const uint16_t sessionID, uint8_t * ipk, size_t ipkLen);
+    CHIP_ERROR ComputeResumeMIC(const uint8_t * key, size_t keyLen, const uint8_t * info, size_t infoLen, uint16_t sessionID,
+                                uint8_t * mic);
+    CHIP_ERROR DeriveResumedSecret();
+    void SaveResumptionTicket();
 
     void SendErrorMsg(SigmaErrorType errorCode);
+    void SendErrorMsgFor(CHIP_ERROR err);
     void HandleErrorMsg(const System::PacketBufferHandle & msg);
 
     // TODO: Remove this and replace with system method to retrieve current time
@@ -250,6 +319,24 @@ private:
     uint8_t mIPK[kIPKSize];
     uint8_t mRemoteIPK[kIPKSize];
 
+    CASEResumptionCache * mResumptionCache = nullptr;
+    uint8_t mInitiatorRandom[kSigmaParamRandomNumberSize];
+    uint8_t mResponderRandom[kSigmaParamRandomNumberSize];
+    uint8_t mResumptionId[kCASEResumptionIdSize];
+    uint8_t mResumptionSecret[kCASEResumptionSecretSize];
+    // Whether the initiator offers to resume a session, or the responder accepted the offer
+    bool mResuming = false;
+
+    CryptoOffload * mCryptoOffload = nullptr;
+    CryptoStepJob mCryptoStepJob;
+    // The Sigma message being processed or built across the steps of the handshake; its buffer is allocated on the
+    // CHIP thread, as packet buffers are not allocated by the steps run off it
+    System::PacketBufferHandle mPendingMsg;
+    // The credentials of the peer, whose signature is verified by a step of their own
+    P256PublicKey mRemoteCredential;
+    System::PacketBufferHandle mRemoteSignedData;
+    P256ECDSASignature mRemoteSignature;
+
     Messaging::ExchangeContext * mExchangeCtxt = nullptr;
     SessionEstablishmentExchangeDispatch mMessageDispatch;
 
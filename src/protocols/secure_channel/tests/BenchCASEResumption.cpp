@@ -0,0 +1,236 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of CASE session establishment with
+ *      the full Sigma handshake against resumption from a cached ticket.
+ */
+
+#include <core/CHIPCore.h>
+#include <credentials/CHIPCert.h>
+#include <credentials/CHIPOperationalCredentials.h>
+#include <messaging/tests/MessagingContext.h>
+#include <protocols/secure_channel/CASESession.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+
+#include "credentials/tests/CHIPCert_test_vectors.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Credentials;
+using namespace chip::TestCerts;
+using namespace chip::Messaging;
+
+namespace {
+
+constexpr size_t kNumHandshakes     = 20;
+constexpr uint8_t kCertsCount       = 4;
+constexpr uint16_t kTestCertBufSize = 1024;
+
+// Delivers every message sent straight back to the sender, so both sides of a handshake run in one call.
+class LoopbackTransport : public Transport::Base
+{
+public:
+    CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override
+    {
+        mSentMessageCount++;
+        HandleMessageReceived(address, std::move(msgBuf));
+        return CHIP_NO_ERROR;
+    }
+
+    bool CanSendToPeer(const Transport::PeerAddress & address) override { return true; }
+
+    uint32_t mSentMessageCount = 0;
+};
+
+class CountingPairingDelegate : public SessionEstablishmentDelegate
+{
+public:
+    void OnSessionEstablishmentError(CHIP_ERROR error) override { mNumPairingErrors++; }
+
+    void OnSessionEstablished() override { mNumPairingComplete++; }
+
+    uint32_t mNumPairingErrors   = 0;
+    uint32_t mNumPairingComplete = 0;
+};
+
+// Both sides use the Node01_01 operational certificate, chained to Root01 through ICA01.
+class NodeCredentials
+{
+public:
+    CHIP_ERROR Init()
+    {
+        CertificateKeyId trustedRootId = { .mId = sTestCert_Root01_SubjectKeyId, .mLen = sTestCert_Root01_SubjectKeyId_Len };
+        P256SerializedKeypair serializedKeys;
+
+        ReturnErrorOnFailure(serializedKeys.SetLength(sTestCert_Node01_01_PublicKey_Len + sTestCert_Node01_01_PrivateKey_Len));
+        memcpy(static_cast<uint8_t *>(serializedKeys), sTestCert_Node01_01_PublicKey, sTestCert_Node01_01_PublicKey_Len);
+        memcpy(static_cast<uint8_t *>(serializedKeys) + sTestCert_Node01_01_PublicKey_Len, sTestCert_Node01_01_PrivateKey,
+               sTestCert_Node01_01_PrivateKey_Len);
+        ReturnErrorOnFailure(mOpKeys.Deserialize(serializedKeys));
+
+        ReturnErrorOnFailure(mCertificateSet.Init(kCertsCount, kTestCertBufSize));
+        ReturnErrorOnFailure(mCertificateSet.LoadCert(sTestCert_Root01_Chip, sTestCert_Root01_Chip_Len,
+                                                      BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor)));
+        ReturnErrorOnFailure(mCertificateSet.LoadCert(sTestCert_ICA01_Chip, sTestCert_ICA01_Chip_Len,
+                                                      BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor)));
+
+        ReturnErrorOnFailure(mOpCred.Init(&mCertificateSet, 1));
+        ReturnErrorOnFailure(
+            mOpCred.SetDevOpCred(trustedRootId, sTestCert_Node01_01_Chip, static_cast<uint16_t>(sTestCert_Node01_01_Chip_Len)));
+        return mOpCred.SetDevOpCredKeypair(trustedRootId, &mOpKeys);
+    }
+
+    void Release()
+    {
+        mOpCred.Release();
+        mCertificateSet.Release();
+    }
+
+    OperationalCredentialSet mOpCred;
+
+private:
+    ChipCertificateSet mCertificateSet;
+    P256Keypair mOpKeys;
+};
+
+TransportMgrBase gTransportMgr;
+LoopbackTransport gLoopback;
+NodeCredentials gCommissionerCredentials;
+NodeCredentials gAccessoryCredentials;
+
+// Establishes one session between two fresh CASE sessions using the given resumption caches, and checks that it was
+// resumed or not as expected.
+CHIP_ERROR EstablishSession(Test::MessagingContext & ctx, CASEResumptionCache * commissionerCache,
+                            CASEResumptionCache * accessoryCache, bool expectResumed)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    CountingPairingDelegate delegateCommissioner;
+    CountingPairingDelegate delegateAccessory;
+    ExchangeContext * contextCommissioner;
+
+    auto * pairingCommissioner = Platform::New<CASESession>();
+    auto * pairingAccessory    = Platform::New<CASESession>();
+    VerifyOrExit(pairingCommissioner != nullptr && pairingAccessory != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    gLoopback.mSentMessageCount = 0;
+    SuccessOrExit(err = pairingCommissioner->MessageDispatch().Init(&gTransportMgr));
+    SuccessOrExit(err = pairingAccessory->MessageDispatch().Init(&gTransportMgr));
+    pairingCommissioner->SetResumptionCache(commissionerCache);
+    pairingAccessory->SetResumptionCache(accessoryCache);
+
+    SuccessOrExit(err = ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                      Protocols::SecureChannel::MsgType::CASE_SigmaR1, pairingAccessory));
+
+    contextCommissioner = ctx.NewExchangeToLocal(pairingCommissioner);
+    VerifyOrExit(contextCommissioner != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    SuccessOrExit(err = pairingAccessory->ListenForSessionEstablishment(&gAccessoryCredentials.mOpCred, 0, &delegateAccessory));
+    SuccessOrExit(err = pairingCommissioner->EstablishSession(Transport::PeerAddress(Transport::Type::kBle),
+                                                              &gCommissionerCredentials.mOpCred, 1, 0, contextCommissioner,
+                                                              &delegateCommissioner));
+
+    VerifyOrExit(gLoopback.mSentMessageCount == 3, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(delegateCommissioner.mNumPairingComplete == 1 && delegateAccessory.mNumPairingComplete == 1,
+                 err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(pairingCommissioner->IsResumed() == expectResumed && pairingAccessory->IsResumed() == expectResumed,
+                 err = CHIP_ERROR_INCORRECT_STATE);
+
+exit:
+    ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_SigmaR1);
+    Platform::Delete(pairingCommissioner);
+    Platform::Delete(pairingAccessory);
+    return err;
+}
+
+// Returns the time kNumHandshakes session establishments take, in microseconds, or 0 on failure.
+uint64_t RunHandshakes(Test::MessagingContext & ctx, CASEResumptionCache * commissionerCache,
+                       CASEResumptionCache * accessoryCache, bool resume)
+{
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t i = 0; i < kNumHandshakes; i++)
+    {
+        VerifyOrReturnError(EstablishSession(ctx, commissionerCache, accessoryCache, resume) == CHIP_NO_ERROR, 0);
+    }
+
+    return System::Layer::GetClock_MonotonicHiRes() - start;
+}
+
+CHIP_ERROR InitContext(Test::MessagingContext & ctx)
+{
+    gTransportMgr.Init(&gLoopback);
+    ReturnErrorOnFailure(ctx.Init(nullptr, &gTransportMgr));
+
+    ctx.SetSourceNodeId(kAnyNodeId);
+    ctx.SetDestinationNodeId(kAnyNodeId);
+    ctx.SetLocalKeyId(0);
+    ctx.SetPeerKeyId(0);
+    ctx.SetAdminId(Transport::kUndefinedAdminId);
+    gTransportMgr.SetSecureSessionMgr(&ctx.GetSecureSessionManager());
+
+    ReturnErrorOnFailure(gCommissionerCredentials.Init());
+    return gAccessoryCredentials.Init();
+}
+
+} // namespace
+
+int main()
+{
+    Test::MessagingContext ctx;
+    CASEResumptionCache commissionerCache;
+    CASEResumptionCache accessoryCache;
+    uint64_t fullTime    = 0;
+    uint64_t resumedTime = 0;
+
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+    VerifyOrDie(InitContext(ctx) == CHIP_NO_ERROR);
+    VerifyOrDie(commissionerCache.Init(nullptr) == CHIP_NO_ERROR);
+    VerifyOrDie(accessoryCache.Init(nullptr) == CHIP_NO_ERROR);
+
+    // Without caches every session takes the full handshake. One full handshake then leaves the tickets that the timed
+    // sessions resume from, each replacing the ticket it used.
+    fullTime = RunHandshakes(ctx, nullptr, nullptr, false);
+    if (EstablishSession(ctx, &commissionerCache, &accessoryCache, false) == CHIP_NO_ERROR)
+    {
+        resumedTime = RunHandshakes(ctx, &commissionerCache, &accessoryCache, true);
+    }
+
+    ctx.Shutdown();
+    gCommissionerCredentials.Release();
+    gAccessoryCredentials.Release();
+    Platform::MemoryShutdown();
+
+    if (fullTime == 0 || resumedTime == 0)
+    {
+        printf("CASE session establishment failed\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("CASE session establishment, %u sessions: full handshake %" PRIu64 " us/session, resumed %" PRIu64 " us/session\n",
+           static_cast<unsigned>(kNumHandshakes), fullTime / kNumHandshakes, resumedTime / kNumHandshakes);
+
+    return EXIT_SUCCESS;
+}
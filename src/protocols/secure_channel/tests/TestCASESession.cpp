@@ -21,6 +21,7 @@
  *      This file implements unit tests for the CASESession implementation.
  */
 
+#include <atomic>
 #include <errno.h>
 #include <nlunit-test.h>
 
@@ -28,12 +29,15 @@
 #include <core/CHIPSafeCasts.h>
 #include <credentials/CHIPCert.h>
 #include <credentials/CHIPOperationalCredentials.h>
+#include <crypto/CryptoWorkerPool.h>
 #include <messaging/tests/MessagingContext.h>
 #include <protocols/secure_channel/CASESession.h>
+#include <sched.h>
 #include <stdarg.h>
 #include <support/CHIPMem.h>
 #include <support/CodeUtils.h>
 #include <support/UnitTestRegistration.h>
+#include <system/SystemLayer.h>
 
 #include "credentials/tests/CHIPCert_test_vectors.h"
 
@@ -56,15 +60,19 @@ public:
     {
         ReturnErrorOnFailure(mMessageSendError);
         mSentMessageCount++;
-        HandleMessageReceived(address, std::move(msgBuf));
+        if (mSentMessageCount <= mDeliveredMessageLimit)
+        {
+            HandleMessageReceived(address, std::move(msgBuf));
+        }
 
         return CHIP_NO_ERROR;
     }
 
     bool CanSendToPeer(const PeerAddress & address) override { return true; }
 
-    uint32_t mSentMessageCount   = 0;
-    CHIP_ERROR mMessageSendError = CHIP_NO_ERROR;
+    uint32_t mSentMessageCount      = 0;
+    uint32_t mDeliveredMessageLimit = UINT32_MAX; ///< The messages sent beyond the limit are lost
+    CHIP_ERROR mMessageSendError    = CHIP_NO_ERROR;
 };
 
 namespace {
@@ -247,6 +255,351 @@ void CASE_SecurePairingSerializeTest(nlTestSuite * inSuite, void * inContext)
     chip::Platform::Delete(testPairingSession2);
 }
 
+class TestResumptionStorage : public PersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        Value * value = Find(key);
+        VerifyOrReturnError(value != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(size >= value->mSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+        memcpy(buffer, value->mData, value->mSize);
+        size = value->mSize;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * buffer, uint16_t size) override
+    {
+        Value * value = Find(key);
+        if (value == nullptr)
+        {
+            VerifyOrReturnError(mNumValues < ArraySize(mValues), CHIP_ERROR_NO_MEMORY);
+            value = &mValues[mNumValues++];
+            strncpy(value->mKey, key, sizeof(value->mKey) - 1);
+        }
+        VerifyOrReturnError(size <= sizeof(value->mData), CHIP_ERROR_BUFFER_TOO_SMALL);
+        memcpy(value->mData, buffer, size);
+        value->mSize = size;
+        mNumWrites++;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SyncDeleteKeyValue(const char * key) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+
+    struct Value
+    {
+        char mKey[32];
+        uint8_t mData[128];
+        uint16_t mSize;
+    };
+
+    Value * Find(const char * key)
+    {
+        for (size_t i = 0; i < mNumValues; i++)
+        {
+            if (strcmp(mValues[i].mKey, key) == 0)
+            {
+                return &mValues[i];
+            }
+        }
+        return nullptr;
+    }
+
+    Value mValues[CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE] = {};
+    size_t mNumValues                                     = 0;
+    uint32_t mNumWrites                                   = 0;
+};
+
+// Establish a session between two fresh CASE sessions using the given resumption caches, and check that both sides
+// resumed the session, or both performed the full handshake, and derive the same keys.
+void CASE_SecurePairingResumptionTestCommon(nlTestSuite * inSuite, void * inContext, CASEResumptionCache * commissionerCache,
+                                            CASEResumptionCache * accessoryCache, bool expectResumed)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    TestCASESecurePairingDelegate delegateCommissioner;
+    TestCASESecurePairingDelegate delegateAccessory;
+
+    // Allocate on the heap to avoid stack overflow in some restricted test scenarios (e.g. QEMU)
+    auto * pairingCommissioner = chip::Platform::New<CASESession>();
+    auto * pairingAccessory    = chip::Platform::New<CASESession>();
+
+    const uint8_t plain_text[] = { 0x86, 0x74, 0x64, 0xe5, 0x0b, 0xd4, 0x0d, 0x90, 0xe1, 0x17, 0xa3, 0x2d, 0x4b, 0xd4, 0xe1, 0xe6 };
+    uint8_t encrypted[64];
+    uint8_t decrypted[64];
+    PacketHeader header;
+    MessageAuthenticationCode mac;
+    SecureSession sessionCommissioner;
+    SecureSession sessionAccessory;
+
+    gLoopback.mSentMessageCount = 0;
+    NL_TEST_ASSERT(inSuite, pairingCommissioner->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    pairingCommissioner->SetResumptionCache(commissionerCache);
+    pairingAccessory->SetResumptionCache(accessoryCache);
+
+    NL_TEST_ASSERT(inSuite,
+                   ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                       Protocols::SecureChannel::MsgType::CASE_SigmaR1, pairingAccessory) == CHIP_NO_ERROR);
+
+    ExchangeContext * contextCommissioner = ctx.NewExchangeToLocal(pairingCommissioner);
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory->ListenForSessionEstablishment(&accessoryDevOpCred, 0, &delegateAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner->EstablishSession(Transport::PeerAddress(Transport::Type::kBle), &commissionerDevOpCred, 1,
+                                                         0, contextCommissioner, &delegateCommissioner) == CHIP_NO_ERROR);
+
+    // A resumed session takes SigmaR1, SigmaR2Resume and SigmaR3Resume, the full handshake SigmaR1, SigmaR2 and SigmaR3
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 3);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, pairingCommissioner->IsResumed() == expectResumed);
+    NL_TEST_ASSERT(inSuite, pairingAccessory->IsResumed() == expectResumed);
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner->DeriveSecureSession(sessionCommissioner, SecureSession::SessionRole::kInitiator) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory->DeriveSecureSession(sessionAccessory, SecureSession::SessionRole::kResponder) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionCommissioner.Encrypt(plain_text, sizeof(plain_text), encrypted, header, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionAccessory.Decrypt(encrypted, sizeof(plain_text), decrypted, header, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, decrypted, sizeof(plain_text)) == 0);
+
+    ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_SigmaR1);
+
+    chip::Platform::Delete(pairingCommissioner);
+    chip::Platform::Delete(pairingAccessory);
+}
+
+void CASE_SecurePairingResumptionTest(nlTestSuite * inSuite, void * inContext)
+{
+    CASEResumptionCache commissionerCache;
+    CASEResumptionCache accessoryCache;
+    CASEResumptionCache usedCommissionerCache;
+
+    NL_TEST_ASSERT(inSuite, commissionerCache.Init(nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessoryCache.Init(nullptr) == CHIP_NO_ERROR);
+
+    // Without a ticket, the full handshake saves one on both sides
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &commissionerCache, &accessoryCache, false);
+    NL_TEST_ASSERT(inSuite, commissionerCache.FindByPeerNodeId(1) != nullptr);
+    NL_TEST_ASSERT(inSuite,
+                   accessoryCache.FindByResumptionId(commissionerCache.FindByPeerNodeId(1)->mResumptionId) != nullptr);
+
+    // The ticket resumes the session, and is replaced by a new one, which resumes the next session
+    usedCommissionerCache = commissionerCache;
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &commissionerCache, &accessoryCache, true);
+    NL_TEST_ASSERT(inSuite,
+                   memcmp(usedCommissionerCache.FindByPeerNodeId(1)->mResumptionId,
+                          commissionerCache.FindByPeerNodeId(1)->mResumptionId, kCASEResumptionIdSize) != 0);
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &commissionerCache, &accessoryCache, true);
+
+    // A used ticket, or one the responder does not know, falls back to the full handshake
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &usedCommissionerCache, &accessoryCache, false);
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &commissionerCache, nullptr, false);
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &commissionerCache, &accessoryCache, false);
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &commissionerCache, &accessoryCache, true);
+}
+
+void CASE_ResumptionCacheTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestResumptionStorage storage;
+    CASEResumptionCache cache;
+    CASEResumptionCache restored;
+    uint8_t resumptionId[kCASEResumptionIdSize] = {};
+    uint8_t secret[kCASEResumptionSecretSize]   = {};
+
+    NL_TEST_ASSERT(inSuite, cache.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.FindByPeerNodeId(1) == nullptr);
+    NL_TEST_ASSERT(inSuite, cache.FindByResumptionId(resumptionId) == nullptr);
+
+    // Fill the cache with a ticket per peer, and one more, which evicts the ticket saved first
+    for (NodeId peer = 1; peer <= CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE + 1; peer++)
+    {
+        resumptionId[0] = static_cast<uint8_t>(peer);
+        secret[0]       = static_cast<uint8_t>(peer);
+        NL_TEST_ASSERT(inSuite, cache.Save(peer, resumptionId, secret) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, cache.FindByPeerNodeId(1) == nullptr);
+    NL_TEST_ASSERT(inSuite, storage.mNumValues == CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE);
+    NL_TEST_ASSERT(inSuite, storage.mNumWrites == CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE + 1);
+
+    // A new ticket of a peer replaces its old one
+    resumptionId[0] = 0xff;
+    NL_TEST_ASSERT(inSuite, cache.Save(2, resumptionId, secret) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.FindByPeerNodeId(2) != nullptr);
+    NL_TEST_ASSERT(inSuite, cache.FindByPeerNodeId(2)->mResumptionId[0] == 0xff);
+    NL_TEST_ASSERT(inSuite, cache.FindByPeerNodeId(3) != nullptr);
+    resumptionId[0] = 2;
+    NL_TEST_ASSERT(inSuite, cache.FindByResumptionId(resumptionId) == nullptr);
+
+    // The tickets, and the order they were saved in, survive a restart
+    NL_TEST_ASSERT(inSuite, restored.Init(&storage) == CHIP_NO_ERROR);
+    for (NodeId peer = 2; peer <= CHIP_CONFIG_CASE_RESUMPTION_CACHE_SIZE + 1; peer++)
+    {
+        const CASEResumptionCache::Entry * entry = restored.FindByPeerNodeId(peer);
+        NL_TEST_ASSERT(inSuite, entry != nullptr);
+        NL_TEST_ASSERT(inSuite, entry != nullptr && memcmp(entry, cache.FindByPeerNodeId(peer), sizeof(*entry)) == 0);
+    }
+    NL_TEST_ASSERT(inSuite, restored.Save(100, resumptionId, secret) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, restored.FindByPeerNodeId(3) == nullptr);
+    NL_TEST_ASSERT(inSuite, restored.FindByPeerNodeId(2) != nullptr);
+
+    // A used ticket is overwritten by the new one of the peer, in storage as well, in a single write
+    uint8_t newResumptionId[kCASEResumptionIdSize] = { 0xee };
+    uint32_t numWrites                             = storage.mNumWrites;
+    memcpy(resumptionId, restored.FindByPeerNodeId(2)->mResumptionId, sizeof(resumptionId));
+    NL_TEST_ASSERT(inSuite, restored.Replace(resumptionId, newResumptionId, secret) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.mNumWrites == numWrites + 1);
+    NL_TEST_ASSERT(inSuite, restored.FindByResumptionId(resumptionId) == nullptr);
+    NL_TEST_ASSERT(inSuite, restored.Replace(resumptionId, newResumptionId, secret) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, cache.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.FindByResumptionId(resumptionId) == nullptr);
+    NL_TEST_ASSERT(inSuite, cache.FindByResumptionId(newResumptionId) == cache.FindByPeerNodeId(2));
+    NL_TEST_ASSERT(inSuite, cache.FindByPeerNodeId(100) != nullptr);
+}
+
+void CASE_SecurePairingResumptionUnconfirmedTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CASEResumptionCache commissionerCache;
+    CASEResumptionCache accessoryCache;
+    CASEResumptionCache::Entry ticket;
+    TestCASESecurePairingDelegate delegateCommissioner;
+    TestCASESecurePairingDelegate delegateAccessory;
+
+    auto * pairingCommissioner = chip::Platform::New<CASESession>();
+    auto * pairingAccessory    = chip::Platform::New<CASESession>();
+
+    NL_TEST_ASSERT(inSuite, commissionerCache.Init(nullptr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessoryCache.Init(nullptr) == CHIP_NO_ERROR);
+    CASE_SecurePairingResumptionTestCommon(inSuite, inContext, &commissionerCache, &accessoryCache, false);
+    ticket = *commissionerCache.FindByPeerNodeId(1);
+
+    NL_TEST_ASSERT(inSuite, pairingCommissioner->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    pairingCommissioner->SetResumptionCache(&commissionerCache);
+    pairingAccessory->SetResumptionCache(&accessoryCache);
+
+    NL_TEST_ASSERT(inSuite,
+                   ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                       Protocols::SecureChannel::MsgType::CASE_SigmaR1, pairingAccessory) == CHIP_NO_ERROR);
+
+    ExchangeContext * contextCommissioner = ctx.NewExchangeToLocal(pairingCommissioner);
+
+    // SigmaR3Resume is lost, as it would be if SigmaR1 was replayed by a peer that cannot confirm the session
+    gLoopback.mSentMessageCount      = 0;
+    gLoopback.mDeliveredMessageLimit = 2;
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory->ListenForSessionEstablishment(&accessoryDevOpCred, 0, &delegateAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner->EstablishSession(Transport::PeerAddress(Transport::Type::kBle), &commissionerDevOpCred, 1,
+                                                         0, contextCommissioner, &delegateCommissioner) == CHIP_NO_ERROR);
+    gLoopback.mDeliveredMessageLimit = UINT32_MAX;
+
+    // The responder neither establishes the session, nor uses up the ticket
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 3);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 0);
+    NL_TEST_ASSERT(inSuite, accessoryCache.FindByResumptionId(ticket.mResumptionId) != nullptr);
+
+    ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_SigmaR1);
+
+    chip::Platform::Delete(pairingCommissioner);
+    chip::Platform::Delete(pairingAccessory);
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+namespace {
+// Stands in for PlatformMgr().ScheduleWork(): the work the crypto worker pool schedules is called on the test thread.
+std::atomic<bool> gCryptoWorkScheduled(false);
+Crypto::CryptoWorkerPool::WorkFunct gCryptoWorkFunct = nullptr;
+intptr_t gCryptoWorkArg                              = 0;
+
+void ScheduleCryptoWork(Crypto::CryptoWorkerPool::WorkFunct workFunct, intptr_t arg)
+{
+    gCryptoWorkFunct = workFunct;
+    gCryptoWorkArg   = arg;
+    gCryptoWorkScheduled.store(true);
+}
+} // namespace
+
+void CASE_SecurePairingOffloadTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    Crypto::CryptoWorkerPool pool;
+    TestCASESecurePairingDelegate delegateCommissioner;
+    TestCASESecurePairingDelegate delegateAccessory;
+    CASESessionSerializable serializableCommissioner;
+    CASESessionSerializable serializableAccessory;
+    uint64_t deadline;
+
+    // Allocate on the heap to avoid stack overflow in some restricted test scenarios (e.g. QEMU)
+    auto * pairingCommissioner = chip::Platform::New<CASESession>();
+    auto * pairingAccessory    = chip::Platform::New<CASESession>();
+
+    NL_TEST_ASSERT(inSuite, pool.Init(2, ScheduleCryptoWork) == CHIP_NO_ERROR);
+
+    gLoopback.mSentMessageCount = 0;
+    NL_TEST_ASSERT(inSuite, pairingCommissioner->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory->MessageDispatch().Init(&gTransportMgr) == CHIP_NO_ERROR);
+    pairingCommissioner->SetCryptoOffload(&pool);
+    pairingAccessory->SetCryptoOffload(&pool);
+
+    NL_TEST_ASSERT(inSuite,
+                   ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(
+                       Protocols::SecureChannel::MsgType::CASE_SigmaR1, pairingAccessory) == CHIP_NO_ERROR);
+
+    ExchangeContext * contextCommissioner = ctx.NewExchangeToLocal(pairingCommissioner);
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory->ListenForSessionEstablishment(&accessoryDevOpCred, 0, &delegateAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner->EstablishSession(Transport::PeerAddress(Transport::Type::kBle), &commissionerDevOpCred, 1,
+                                                         0, contextCommissioner, &delegateCommissioner) == CHIP_NO_ERROR);
+
+    // The accessory computes SigmaR2 off the test thread, so only SigmaR1 is sent so far
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 1);
+
+    deadline = System::Layer::GetClock_MonotonicHiRes() + 10 * 1000 * 1000;
+    while ((delegateCommissioner.mNumPairingComplete == 0 || delegateAccessory.mNumPairingComplete == 0) &&
+           delegateCommissioner.mNumPairingErrors == 0 && delegateAccessory.mNumPairingErrors == 0 &&
+           System::Layer::GetClock_MonotonicHiRes() < deadline)
+    {
+        if (gCryptoWorkScheduled.exchange(false))
+        {
+            gCryptoWorkFunct(gCryptoWorkArg);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 3);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+
+    NL_TEST_ASSERT(inSuite, pairingCommissioner->ToSerializable(serializableCommissioner) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory->ToSerializable(serializableAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   memcmp(serializableCommissioner.mSharedSecret, serializableAccessory.mSharedSecret,
+                          serializableCommissioner.mSharedSecretLen) == 0);
+
+    ctx.GetExchangeManager().UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_SigmaR1);
+
+    chip::Platform::Delete(pairingCommissioner);
+    chip::Platform::Delete(pairingAccessory);
+
+    pool.Shutdown();
+    gCryptoWorkScheduled.store(false);
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 // Test Suite
 
 /**
@@ -259,6 +612,12 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Start",       CASE_SecurePairingStartTest),
     NL_TEST_DEF("Handshake",   CASE_SecurePairingHandshakeTest),
     NL_TEST_DEF("Serialize",   CASE_SecurePairingSerializeTest),
+    NL_TEST_DEF("Resumption",  CASE_SecurePairingResumptionTest),
+    NL_TEST_DEF("ResumptionCache", CASE_ResumptionCacheTest),
+    NL_TEST_DEF("ResumptionUnconfirmed", CASE_SecurePairingResumptionUnconfirmedTest),
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("Offload",     CASE_SecurePairingOffloadTest),
+#endif
 
     NL_TEST_SENTINEL()
 };
@@ -335,6 +335,66 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+ *
+ *  @brief
+ *      Enable (1) or disable (0) size-classed caching of packet buffers obtained from the heap.
+ *
+ *      When enabled, and packet buffers come from the heap (\c CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is 0 on a
+ *      sockets platform), each allocation is rounded up to one of three size classes: \c
+ *      CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL, \c CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM, or the full
+ *      \c CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX. Freed buffers are kept on a per-thread free list for their class,
+ *      backed by a lock-free list shared between threads, instead of being returned to the heap.
+ *
+ *      The option has no effect in other configurations.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL
+ *
+ *  @brief
+ *      The allocation size, including the reserved space, of the smallest packet buffer size class.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL 128
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM
+ *
+ *  @brief
+ *      The allocation size, including the reserved space, of the intermediate packet buffer size class.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM 512
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+ *
+ *  @brief
+ *      The number of free packet buffers of each size class a thread keeps for itself. Beyond this, half of the thread's
+ *      free buffers of that class are moved to the shared list.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE 32
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE
+ *
+ *  @brief
+ *      The approximate number of free packet buffers of each size class kept on the list shared between threads. Buffers
+ *      freed beyond this are returned to the heap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE 256
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
  *
@@ -498,6 +558,24 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS
+ *
+ *  @brief
+ *      The base two logarithm of the number of slots in each level of the timer wheel that holds pending timers.
+ *
+ *      Each level of the wheel covers this many more bits of timer delay than the one below it, and enough levels are used to
+ *      cover a 32 bit delay in milliseconds. Smaller values reduce the memory used by the wheel (one pointer per slot) at the
+ *      cost of more frequent cascading of long running timers. Must be between 1 and 6.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS
+#define CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS 6
+#endif /* CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS */
+
+#if CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS < 1 || CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS > 6
+#error "CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS must be between 1 and 6"
+#endif
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -697,3 +775,35 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS 0
 #endif
 #endif // CHIP_SYSTEM_CONFIG_USE_BSD_IFADDRS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_EPOLL
+ *
+ *  @brief
+ *      Use Linux epoll() to track socket readiness.
+ *
+ *  When enabled, the System Layer keeps a persistent epoll registration for its wake event and for every Inet
+ *  endpoint socket, and only exposes the epoll descriptor itself to the platform select() loop.  A wakeup then
+ *  touches only the sockets that are actually ready, and endpoint sockets are no longer limited by FD_SETSIZE.
+ *
+ *  Defaults to disabled.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_EPOLL
+#define CHIP_SYSTEM_CONFIG_USE_EPOLL 0
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL && !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#error "REQUIRED: CHIP_SYSTEM_CONFIG_USE_SOCKETS when CHIP_SYSTEM_CONFIG_USE_EPOLL"
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL && !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      The maximum number of ready sockets harvested from epoll_wait() per event loop iteration.
+ *
+ *  Sockets that remain ready beyond this limit are reported again on the next iteration.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif // CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
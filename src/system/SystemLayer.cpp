@@ -48,6 +48,10 @@
 #include <unistd.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #if !CHIP_SYSTEM_CONFIG_PLATFORM_PROVIDES_EVENT_FUNCTIONS
 #include <lwip/err.h>
@@ -95,7 +99,6 @@ Layer::Layer() : mLayerState(kLayerState_NotInitialized), mContext(nullptr), mPl
         sSystemEventHandlerDelegate.Init(HandleSystemLayerEvent);
 
     this->mEventDelegateList = NULL;
-    this->mTimerList         = NULL;
     this->mTimerComplete     = false;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
@@ -104,6 +107,11 @@ Layer::Layer() : mLayerState(kLayerState_NotInitialized), mContext(nullptr), mPl
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    this->mEpollFD         = -1;
+    this->mReadyEventCount = 0;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 Error Layer::Init(void * aContext)
@@ -134,6 +142,28 @@ Error Layer::Init(void * aContext)
     SuccessOrExit(lReturn);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    // The wake event stays registered with the epoll instance for the lifetime of the layer.
+    this->mEpollFD = epoll_create1(EPOLL_CLOEXEC);
+    lReturn        = (this->mEpollFD >= 0) ? CHIP_SYSTEM_NO_ERROR : MapErrorPOSIX(errno);
+    if (lReturn == CHIP_SYSTEM_NO_ERROR)
+    {
+        lReturn = this->UpdateSocketWatch(this->mWakeEvent.GetNotifFD(), EPOLLIN, &this->mWakeEvent);
+    }
+    if (lReturn != CHIP_SYSTEM_NO_ERROR)
+    {
+        if (this->mEpollFD >= 0)
+        {
+            close(this->mEpollFD);
+            this->mEpollFD = -1;
+        }
+        this->mWakeEvent.Close();
+        ExitNow();
+    }
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+    this->mTimerWheel.Init(Timer::GetCurrentEpoch());
+
     this->mLayerState = kLayerState_Initialized;
     this->mContext    = aContext;
 
@@ -159,6 +189,12 @@ Error Layer::Shutdown()
     SuccessOrExit(lReturn);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    close(this->mEpollFD);
+    this->mEpollFD         = -1;
+    this->mReadyEventCount = 0;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
     {
         Timer * lTimer = Timer::sPool.Get(*this, i);
@@ -610,7 +646,12 @@ void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet,
     if (this->State() != kLayerState_Initialized)
         return;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    // The wake event and all watched sockets are behind the epoll descriptor, which becomes readable when any of them is ready.
+    const int wakeEventFd = this->mEpollFD;
+#else
     const int wakeEventFd = this->mWakeEvent.GetNotifFD();
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
     FD_SET(wakeEventFd, aReadSet);
 
     if (wakeEventFd + 1 > aSetSize)
@@ -620,21 +661,14 @@ void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet,
     Timer::Epoch lAwakenEpoch =
         kCurrentEpoch + static_cast<Timer::Epoch>(aSleepTime.tv_sec) * 1000 + static_cast<uint32_t>(aSleepTime.tv_usec) / 1000;
 
-    for (size_t i = 0; i < Timer::sPool.Size(); i++)
+    // The timer wheel may ask to be woken before its earliest timer expires, in order to cascade long running timers.
+    Timer::Epoch lWheelEpoch;
+    if (this->mTimerWheel.GetNextWakeup(lWheelEpoch))
     {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
-
-        if (lTimer != nullptr)
-        {
-            if (!Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch))
-            {
-                lAwakenEpoch = kCurrentEpoch;
-                break;
-            }
-
-            if (Timer::IsEarlierEpoch(lTimer->mAwakenEpoch, lAwakenEpoch))
-                lAwakenEpoch = lTimer->mAwakenEpoch;
-        }
+        if (!Timer::IsEarlierEpoch(kCurrentEpoch, lWheelEpoch))
+            lAwakenEpoch = kCurrentEpoch;
+        else if (Timer::IsEarlierEpoch(lWheelEpoch, lAwakenEpoch))
+            lAwakenEpoch = lWheelEpoch;
     }
 
     // check for an earlier callback timer, too
@@ -687,6 +721,42 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
     lThreadSelf = pthread_self();
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    this->mReadyEventCount = 0;
+
+    if (aSetSize > 0 && FD_ISSET(this->mEpollFD, aReadSet))
+    {
+        const int lCount = epoll_wait(this->mEpollFD, this->mReadyEvents, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, 0);
+
+        if (lCount < 0)
+        {
+            ChipLogError(chipSystemLayer, "epoll_wait failed: %s", ErrorStr(MapErrorPOSIX(errno)));
+        }
+
+        for (int i = 0; i < lCount; i++)
+        {
+            struct epoll_event & lEvent = this->mReadyEvents[i];
+
+            // If we woke because of someone writing to the wake event, clear the event before returning. The entry is
+            // left in place with a null context so that socket consumers skip it.
+            if (lEvent.data.ptr == &this->mWakeEvent)
+            {
+                lEvent.data.ptr = nullptr;
+
+                lReturn = this->mWakeEvent.Confirm();
+                if (lReturn != CHIP_SYSTEM_NO_ERROR)
+                {
+                    ChipLogError(chipSystemLayer, "System wake event confirm failed: %s", ErrorStr(lReturn));
+                }
+            }
+        }
+
+        if (lCount > 0)
+        {
+            this->mReadyEventCount = static_cast<size_t>(lCount);
+        }
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
     if (aSetSize > 0)
     {
         // If we woke because of someone writing to the wake event, clear the event before returning.
@@ -699,6 +769,7 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
             }
         }
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
 
@@ -706,23 +777,22 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
     this->mHandleSelectThread = lThreadSelf;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
-    for (size_t i = 0; i < Timer::sPool.Size(); i++)
-    {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
+    // Timers started by the callbacks below are not handled until the next call, even if they have already expired.
+    this->mTimerWheel.Advance(kCurrentEpoch);
 
-        if (lTimer != nullptr && !Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch))
-        {
+    Timer * lTimer;
+    while ((lTimer = this->mTimerWheel.PopExpired()) != nullptr)
+    {
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
-            if (mDispatchQueue != nullptr)
-            {
-                dispatch_sync(mDispatchQueue, ^{
-                    lTimer->HandleComplete();
-                });
-            }
-            else
-#endif // CHIP_SYSTEM_CONFIG_USE_DISPATCH
+        if (mDispatchQueue != nullptr)
+        {
+            dispatch_sync(mDispatchQueue, ^{
                 lTimer->HandleComplete();
+            });
         }
+        else
+#endif // CHIP_SYSTEM_CONFIG_USE_DISPATCH
+            lTimer->HandleComplete();
     }
 
     DispatchTimerCallbacks(kCurrentEpoch);
@@ -766,6 +836,97 @@ void Layer::WakeSelect()
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+/**
+ * Register a socket with the layer's epoll instance, or update the set of events it is watched for.
+ *
+ * The registration persists across event loop iterations until the socket is passed to @p StopSocketWatch() or closed.
+ * Callers may include EPOLLET in @a aEvents for sockets whose handlers drain them completely on every wakeup.
+ *
+ * Because epoll always reports EPOLLERR and EPOLLHUP for registered sockets, an empty @a aEvents removes the registration
+ * instead, so that an idle socket with a pending hang-up does not wake the loop continuously.
+ *
+ *  @param[in]  aSocket     The socket descriptor to watch.
+ *  @param[in]  aEvents     The epoll event mask to wait for.
+ *  @param[in]  aContext    An opaque pointer returned in the ready events for this socket. Must not be null.
+ *
+ *  @retval CHIP_SYSTEM_NO_ERROR                On success.
+ *  @retval CHIP_SYSTEM_ERROR_UNEXPECTED_STATE  If the epoll instance has not been created.
+ *  @retval other                               A mapped POSIX error from epoll_ctl().
+ */
+Error Layer::UpdateSocketWatch(int aSocket, uint32_t aEvents, void * aContext)
+{
+    struct epoll_event lEvent;
+
+    if (this->mEpollFD < 0)
+        return CHIP_SYSTEM_ERROR_UNEXPECTED_STATE;
+
+    if (aEvents == 0)
+    {
+        if (epoll_ctl(this->mEpollFD, EPOLL_CTL_DEL, aSocket, nullptr) == 0 || errno == ENOENT)
+            return CHIP_SYSTEM_NO_ERROR;
+
+        return MapErrorPOSIX(errno);
+    }
+
+    lEvent.events   = aEvents;
+    lEvent.data.ptr = aContext;
+
+    // Most calls modify an existing registration; fall back to adding the socket the first time it is seen.
+    if (epoll_ctl(this->mEpollFD, EPOLL_CTL_MOD, aSocket, &lEvent) == 0)
+        return CHIP_SYSTEM_NO_ERROR;
+
+    if (errno == ENOENT && epoll_ctl(this->mEpollFD, EPOLL_CTL_ADD, aSocket, &lEvent) == 0)
+        return CHIP_SYSTEM_NO_ERROR;
+
+    return MapErrorPOSIX(errno);
+}
+
+/**
+ * Remove a socket from the layer's epoll instance. This must be called before the socket is closed.
+ *
+ * Any event for @a aContext that was harvested during the current event loop iteration and not yet consumed is discarded, so
+ * that a socket closed from within another endpoint's (or a timer's) callback is not dispatched.
+ *
+ *  @param[in]  aSocket     The socket descriptor to stop watching.
+ *  @param[in]  aContext    The context pointer that was passed to @p UpdateSocketWatch().
+ */
+void Layer::StopSocketWatch(int aSocket, void * aContext)
+{
+    if (this->mEpollFD < 0)
+        return;
+
+    if (epoll_ctl(this->mEpollFD, EPOLL_CTL_DEL, aSocket, nullptr) != 0 && errno != ENOENT)
+    {
+        ChipLogError(chipSystemLayer, "epoll_ctl DEL failed: %s", ErrorStr(MapErrorPOSIX(errno)));
+    }
+
+    for (size_t i = 0; i < this->mReadyEventCount; i++)
+    {
+        if (this->mReadyEvents[i].data.ptr == aContext)
+            this->mReadyEvents[i].data.ptr = nullptr;
+    }
+}
+
+/**
+ * Return the socket events harvested by the most recent call to @p HandleSelectResult().
+ *
+ * Entries whose context is null belong to the layer itself or to sockets that have since stopped being watched, and must be
+ * skipped.
+ *
+ *  @param[out] aEvents     Set to the first harvested event.
+ *
+ *  @return The number of harvested events.
+ */
+size_t Layer::GetReadySocketEvents(const struct epoll_event *& aEvents) const
+{
+    aEvents = this->mReadyEvents;
+    return this->mReadyEventCount;
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 LwIPEventHandlerDelegate Layer::sSystemEventHandlerDelegate;
 
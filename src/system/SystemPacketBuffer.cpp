@@ -55,10 +55,15 @@
 #include <lwip/pbuf.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
-#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP ||                                                  \
+    CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
 #include <support/CHIPMem.h>
 #endif
 
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+#include <atomic>
+#endif
+
 namespace chip {
 namespace System {
 
@@ -162,6 +167,232 @@ void PacketBufferHandle::InternalRightSize()
     mBuffer = newBuffer;
 }
 
+#elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+//
+// Size-classed heap allocation for PacketBuffer objects.
+//
+// Each allocation is rounded up to a size class. Free buffers go to an unsynchronized per-thread list for their class, and
+// when that list overflows, half of it moves to a list shared by all threads. The shared list is only ever pushed onto or
+// taken whole, so it needs no lock and is not exposed to ABA.
+//
+
+namespace {
+
+constexpr size_t kSizeClassCount = 3;
+
+constexpr uint16_t kSizeClassAllocSize[kSizeClassCount] = { CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL,
+                                                            CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM,
+                                                            PacketBuffer::kMaxSizeWithoutReserve };
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+constexpr int kSizeClassStat[kSizeClassCount] = { chip::System::Stats::kSystemLayer_NumPacketBufsSmall,
+                                                  chip::System::Stats::kSystemLayer_NumPacketBufsMedium,
+                                                  chip::System::Stats::kSystemLayer_NumPacketBufsLarge };
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL < CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM &&
+                  CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM < CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX,
+              "PacketBuffer size classes must be strictly increasing");
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE >= 2, "PacketBuffer thread cache too small");
+
+// Returns the smallest size class holding \c aAllocSize bytes, which must not exceed kMaxSizeWithoutReserve.
+size_t SizeClassIndex(size_t aAllocSize)
+{
+    size_t lIndex = 0;
+
+    while (kSizeClassAllocSize[lIndex] < aAllocSize)
+    {
+        lIndex++;
+    }
+
+    return lIndex;
+}
+
+struct SharedFreeList
+{
+    std::atomic<pbuf *> mHead;
+    std::atomic<size_t> mCount;
+};
+
+SharedFreeList sSharedFreeLists[kSizeClassCount];
+
+// Gives the chain \c aFirst .. \c aLast of \c aCount buffers to the shared list, or back to the heap if the list is full.
+void ReleaseToSharedList(size_t aClass, pbuf * aFirst, pbuf * aLast, size_t aCount)
+{
+    SharedFreeList & lList = sSharedFreeLists[aClass];
+
+    if (lList.mCount.load(std::memory_order_relaxed) >= CHIP_SYSTEM_CONFIG_PACKETBUFFER_SHARED_CACHE_SIZE)
+    {
+        aLast->next = nullptr;
+
+        while (aFirst != nullptr)
+        {
+            pbuf * lNext = aFirst->next;
+            chip::Platform::MemoryFree(aFirst);
+            aFirst = lNext;
+        }
+
+        return;
+    }
+
+    lList.mCount.fetch_add(aCount, std::memory_order_relaxed);
+
+    pbuf * lHead = lList.mHead.load(std::memory_order_relaxed);
+    do
+    {
+        aLast->next = lHead;
+    } while (!lList.mHead.compare_exchange_weak(lHead, aFirst, std::memory_order_release, std::memory_order_relaxed));
+}
+
+class ThreadCache
+{
+public:
+    ~ThreadCache()
+    {
+        for (size_t lClass = 0; lClass < kSizeClassCount; lClass++)
+        {
+            if (mCount[lClass] > 0)
+            {
+                Spill(lClass, mCount[lClass]);
+            }
+        }
+    }
+
+    pbuf * Take(size_t aClass)
+    {
+        if (mHead[aClass] == nullptr)
+        {
+            Refill(aClass);
+            VerifyOrReturnError(mHead[aClass] != nullptr, nullptr);
+        }
+
+        pbuf * lBuffer = mHead[aClass];
+        mHead[aClass]  = lBuffer->next;
+        mCount[aClass]--;
+
+        return lBuffer;
+    }
+
+    void Put(size_t aClass, pbuf * aBuffer)
+    {
+        aBuffer->next = mHead[aClass];
+        mHead[aClass] = aBuffer;
+        mCount[aClass]++;
+
+        if (mCount[aClass] > CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE)
+        {
+            Spill(aClass, CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE / 2);
+        }
+    }
+
+private:
+    // Moves the first \c aCount buffers of the list to the shared list.
+    void Spill(size_t aClass, size_t aCount)
+    {
+        pbuf * lFirst = mHead[aClass];
+        pbuf * lLast  = lFirst;
+
+        for (size_t i = 1; i < aCount; i++)
+        {
+            lLast = lLast->next;
+        }
+
+        mHead[aClass] = lLast->next;
+        mCount[aClass] -= aCount;
+
+        ReleaseToSharedList(aClass, lFirst, lLast, aCount);
+    }
+
+    // Takes the whole shared list.
+    void Refill(size_t aClass)
+    {
+        SharedFreeList & lList = sSharedFreeLists[aClass];
+        pbuf * lChain          = lList.mHead.exchange(nullptr, std::memory_order_acquire);
+        size_t lCount          = 0;
+
+        for (pbuf * lCursor = lChain; lCursor != nullptr; lCursor = lCursor->next)
+        {
+            lCount++;
+        }
+
+        lList.mCount.fetch_sub(lCount, std::memory_order_relaxed);
+
+        mHead[aClass]  = lChain;
+        mCount[aClass] = lCount;
+    }
+
+    pbuf * mHead[kSizeClassCount]  = {};
+    size_t mCount[kSizeClassCount] = {};
+};
+
+thread_local ThreadCache sThreadCache;
+
+} // namespace
+
+PacketBuffer * PacketBuffer::SizeClassAlloc(size_t aAllocSize)
+{
+    const size_t lClass = SizeClassIndex(aAllocSize);
+    pbuf * lBuffer      = sThreadCache.Take(lClass);
+
+    if (lBuffer == nullptr)
+    {
+        lBuffer = static_cast<pbuf *>(chip::Platform::MemoryAlloc(kStructureSize + kSizeClassAllocSize[lClass]));
+        VerifyOrReturnError(lBuffer != nullptr, nullptr);
+    }
+
+    lBuffer->alloc_size = kSizeClassAllocSize[lClass];
+
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+    SYSTEM_STATS_INCREMENT(kSizeClassStat[lClass]);
+
+    return static_cast<PacketBuffer *>(lBuffer);
+}
+
+void PacketBuffer::SizeClassFree(PacketBuffer * aPacket)
+{
+    const size_t lClass = SizeClassIndex(aPacket->alloc_size);
+
+    SYSTEM_STATS_DECREMENT(kSizeClassStat[lClass]);
+
+    sThreadCache.Put(lClass, aPacket);
+}
+
+void PacketBufferHandle::InternalRightSize()
+{
+    // Require a single buffer with no other references.
+    if ((mBuffer == nullptr) || mBuffer->HasChainedBuffer() || (mBuffer->ref != 1))
+    {
+        return;
+    }
+
+    // Reallocate only if the contents fit a smaller size class.
+    uint8_t * const start   = reinterpret_cast<uint8_t *>(mBuffer) + PacketBuffer::kStructureSize;
+    uint8_t * const payload = reinterpret_cast<uint8_t *>(mBuffer->payload);
+    const uint16_t usedSize = static_cast<uint16_t>(payload - start + mBuffer->len);
+    if (SizeClassIndex(usedSize) >= SizeClassIndex(mBuffer->alloc_size))
+    {
+        return;
+    }
+
+    PacketBuffer * newBuffer = PacketBuffer::SizeClassAlloc(usedSize);
+    if (newBuffer == nullptr)
+    {
+        ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
+        return;
+    }
+
+    uint8_t * const newStart = reinterpret_cast<uint8_t *>(newBuffer) + PacketBuffer::kStructureSize;
+    newBuffer->next          = nullptr;
+    newBuffer->payload       = newStart + (payload - start);
+    newBuffer->tot_len       = mBuffer->tot_len;
+    newBuffer->len           = mBuffer->len;
+    newBuffer->ref           = 1;
+    memcpy(newStart, start, usedSize);
+
+    PacketBuffer::Free(mBuffer);
+    mBuffer = newBuffer;
+}
+
 #elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_LWIP_CUSTOM
 
 void PacketBufferHandle::InternalRightSize()
@@ -488,6 +719,12 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
+#elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+
+    static_cast<void>(lBlockSize);
+
+    lPacket = PacketBuffer::SizeClassAlloc(lAllocSize);
+
 #else
 #error "Unimplemented CHIP_SYSTEM_PACKETBUFFER_STORE case"
 #endif // CHIP_SYSTEM_PACKETBUFFER_STORE
@@ -550,7 +787,8 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
     }
 
 #elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL ||                                                \
-    CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+    CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP ||                                                  \
+    CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
 
     LOCK_BUF_POOL();
 
@@ -573,6 +811,8 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             sFreeList     = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
             chip::Platform::MemoryFree(aPacket);
+#elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+            SizeClassFree(aPacket);
 #endif // CHIP_SYSTEM_PACKETBUFFER_STORE
             aPacket       = lNextPacket;
         }
@@ -665,6 +905,28 @@ PacketBufferHandle PacketBufferHandle::CloneData() const
     return cloneHead;
 }
 
+size_t PacketBufferHandle::GetDataSegments(ByteSpan * aSegments, size_t aMaxSegments) const
+{
+    size_t lCount = 0;
+
+    for (const PacketBuffer * lBuffer = mBuffer; lBuffer != nullptr; lBuffer = lBuffer->ChainedBuffer())
+    {
+        if (lBuffer->DataLength() == 0)
+        {
+            continue;
+        }
+
+        if (lCount < aMaxSegments)
+        {
+            aSegments[lCount] = ByteSpan(lBuffer->Start(), lBuffer->DataLength());
+        }
+
+        lCount++;
+    }
+
+    return lCount;
+}
+
 } // namespace System
 
 namespace Encoding {
@@ -32,6 +32,7 @@
 #include <support/BufferWriter.h>
 #include <support/CodeUtils.h>
 #include <support/DLLUtil.h>
+#include <support/Span.h>
 #include <system/SystemAlignSize.h>
 #include <system/SystemError.h>
 
@@ -58,6 +59,7 @@ class PacketBufferTest;
 #define CHIP_SYSTEM_PACKETBUFFER_STORE_LWIP_CUSTOM 2 //   Custom lwIP allocation
 #define CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL 3   //   Internal fixed pool
 #define CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP 4   //   Platform::MemoryAlloc
+#define CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED 5  //   Platform::MemoryAlloc, cached by size class
 
 #undef CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHT_SIZE // True if RightSize() has a nontrivial implementation
 #undef CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK      // True if Check() has a nontrivial implementation
@@ -76,6 +78,10 @@ class PacketBufferTest;
 #define CHIP_SYSTEM_PACKETBUFFER_STORE CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL
 #define CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHT_SIZE 0
 #define CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK 0
+#elif CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define CHIP_SYSTEM_PACKETBUFFER_STORE CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHT_SIZE 1
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK 0
 #else
 #define CHIP_SYSTEM_PACKETBUFFER_STORE CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
 #define CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHT_SIZE 1
@@ -96,7 +102,8 @@ struct pbuf
     uint16_t tot_len;
     uint16_t len;
     uint16_t ref;
-#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP ||                                                  \
+    CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
     uint16_t alloc_size;
 #endif
 };
@@ -110,7 +117,8 @@ struct pbuf
  *
  *      In LwIP-based environments, this class is built on top of the pbuf structure defined in that library. In the absence of
  *      LwIP, chip provides either a malloc-based implementation, or a pool-based implementation that closely approximates the
- *      memory challenges of deeply embedded devices.
+ *      memory challenges of deeply embedded devices. The malloc-based implementation can cache freed buffers by size class
+ *      (see #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES).
  *
  *      The PacketBuffer class, like many similar structures used in layered network stacks, provide a mechanism to reserve space
  *      for protocol headers at each layer of a configurable communication stack.  For details, see `PacketBufferHandle::New()`
@@ -175,7 +183,8 @@ public:
 #if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_LWIP_POOL ||                                                  \
     CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL
         return kMaxSizeWithoutReserve;
-#elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+#elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP ||                                                \
+    CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
         return this->alloc_size;
 #elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_LWIP_CUSTOM
         // Temporary workaround for custom pbufs by assuming size to be PBUF_POOL_BUFSIZE
@@ -392,6 +401,11 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED || defined(DOXYGEN)
+    static PacketBuffer * SizeClassAlloc(size_t aAllocSize);
+    static void SizeClassFree(PacketBuffer * aPacket);
+#endif // CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED || defined(DOXYGEN)
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -559,6 +573,20 @@ public:
      */
     void Consume(uint16_t aConsumeLength) { mBuffer = mBuffer->Consume(aConsumeLength); }
 
+    /**
+     * Describe the data in a chain of buffers as a sequence of contiguous segments, e.g. for scatter-gather output.
+     *
+     *  Buffers holding no data are skipped. At most \c aMaxSegments segments are written to \c aSegments; a return value
+     *  larger than \c aMaxSegments means the description is incomplete. The segments remain valid only as long as the
+     *  chain is neither modified nor freed.
+     *
+     *  @param[out] aSegments       array of at least \c aMaxSegments spans to fill.
+     *  @param[in]  aMaxSegments    capacity of \c aSegments.
+     *
+     *  @return the number of segments needed to describe the whole chain.
+     */
+    size_t GetDataSegments(ByteSpan * aSegments, size_t aMaxSegments) const;
+
     /**
      * Copy the given buffer to a right-sized buffer if applicable.
      *
@@ -46,6 +46,11 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "SystemLayer_NumPacketBufs",
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    "SystemLayer_NumPacketBufsSmall",
+    "SystemLayer_NumPacketBufsMedium",
+    "SystemLayer_NumPacketBufsLarge",
+#endif
 #endif
     "SystemLayer_NumTimersInUse",
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -57,6 +62,8 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #if INET_CONFIG_NUM_UDP_ENDPOINTS
     "InetLayer_NumUDPEpsInUse",
 #endif
+    "InetLayer_NumUDPRecvBatch",
+    "InetLayer_NumUDPSendBatch",
 #if INET_CONFIG_NUM_DNS_RESOLVERS
     "InetLayer_NumDNSResolversInUse",
 #endif
@@ -56,6 +56,11 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    kSystemLayer_NumPacketBufsSmall,  // Packet buffers in use from the CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL class
+    kSystemLayer_NumPacketBufsMedium, // Packet buffers in use from the CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM class
+    kSystemLayer_NumPacketBufsLarge,  // Packet buffers in use from the full-size class
+#endif
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_RAW_ENDPOINTS
@@ -67,6 +72,8 @@ enum
 #if INET_CONFIG_NUM_UDP_ENDPOINTS
     kInetLayer_NumUDPEps,
 #endif
+    kInetLayer_NumUDPRecvBatch, // Datagrams taken by the last batched receive; the watermark is the largest batch
+    kInetLayer_NumUDPSendBatch, // Datagrams handed over by the last batched send; the watermark is the largest batch
 #if INET_CONFIG_NUM_DNS_RESOLVERS
     kInetLayer_NumDNSResolvers,
 #endif
@@ -165,6 +172,8 @@ const Label * GetStrings();
 
 #define SYSTEM_STATS_DECREMENT_BY_N(entry, count)
 
+#define SYSTEM_STATS_SET(entry, count)
+
 #define SYSTEM_STATS_RESET(entry)
 
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
@@ -136,37 +136,20 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
     }
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
-    // add to the sorted list of timers. Earliest timer appears first.
-    if (lLayer.mTimerList == NULL || this->IsEarlierEpoch(this->mAwakenEpoch, lLayer.mTimerList->mAwakenEpoch))
-    {
-        this->mNextTimer  = lLayer.mTimerList;
-        lLayer.mTimerList = this;
-
-        // this is the new earliest timer and so the timer needs (re-)starting provided that
-        // the system is not currently processing expired timers, in which case it is left to
-        // HandleExpiredTimers() to re-start the timer.
-        if (!lLayer.mTimerComplete)
-        {
-            lLayer.StartPlatformTimer(aDelayMilliseconds);
-        }
-    }
-    else
-    {
-        Timer * lTimer = lLayer.mTimerList;
-
-        while (lTimer->mNextTimer)
-        {
-            if (this->IsEarlierEpoch(this->mAwakenEpoch, lTimer->mNextTimer->mAwakenEpoch))
-            {
-                // found the insert location.
-                break;
-            }
+    Epoch lPrevWakeup;
+    const bool lHadWakeup = lLayer.mTimerWheel.GetNextWakeup(lPrevWakeup);
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
-            lTimer = lTimer->mNextTimer;
-        }
+    lLayer.mTimerWheel.Insert(*this);
 
-        this->mNextTimer   = lTimer->mNextTimer;
-        lTimer->mNextTimer = this;
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    // if this timer brought the next wakeup of the wheel forward, the platform timer needs (re-)starting provided that the
+    // system is not currently processing expired timers, in which case it is left to HandleExpiredTimers() to re-start the timer.
+    Epoch lWakeup;
+    if (!lLayer.mTimerComplete && lLayer.mTimerWheel.GetNextWakeup(lWakeup) && (!lHadWakeup || lWakeup < lPrevWakeup))
+    {
+        const Epoch lCurrentEpoch = Timer::GetCurrentEpoch();
+        lLayer.StartPlatformTimer(lWakeup > lCurrentEpoch ? static_cast<uint32_t>(lWakeup - lCurrentEpoch) : 0);
     }
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -192,6 +175,7 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
     err = lLayer.PostEvent(*this, chip::System::kEvent_ScheduleWork, 0);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+    lLayer.mTimerWheel.Insert(*this);
     lLayer.WakeSelect();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
@@ -205,9 +189,6 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
  */
 Error Timer::Cancel()
 {
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    Layer & lLayer = this->SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
     OnCompleteFunct lOnComplete = this->OnComplete;
 
     // Check if the timer is armed
@@ -218,32 +199,7 @@ Error Timer::Cancel()
     // Since this thread changed the state of OnComplete, release the timer.
     this->AppState = nullptr;
 
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-    if (lLayer.mTimerList)
-    {
-        if (this == lLayer.mTimerList)
-        {
-            lLayer.mTimerList = this->mNextTimer;
-        }
-        else
-        {
-            Timer * lTimer = lLayer.mTimerList;
-
-            while (lTimer->mNextTimer)
-            {
-                if (this == lTimer->mNextTimer)
-                {
-                    lTimer->mNextTimer = this->mNextTimer;
-                    break;
-                }
-
-                lTimer = lTimer->mNextTimer;
-            }
-        }
-
-        this->mNextTimer = NULL;
-    }
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+    this->SystemLayer().mTimerWheel.Remove(*this);
 
     this->Release();
 exit:
@@ -295,53 +251,44 @@ exit:
 Error Timer::HandleExpiredTimers(Layer & aLayer)
 {
     size_t timersHandled = 0;
+    Timer * lTimer;
+    Epoch lWakeup;
 
-    // Expire each timer in turn until an unexpired timer is reached or the timerlist is emptied.  We set the current expiration
-    // time outside the loop; that way timers set after the current tick will not be executed within this expiration window
-    // regardless how long the processing of the currently expired timers took
-    Epoch currentEpoch = Timer::GetCurrentEpoch();
+    // Collect the expired timers before completing any of them; that way timers set after the current tick will not be
+    // executed within this expiration window regardless how long the processing of the currently expired timers took.
+    aLayer.mTimerWheel.Advance(Timer::GetCurrentEpoch());
 
-    while (aLayer.mTimerList)
+    // limit the number of timers handled before the control is returned to the event queue.  The bound is similar to
+    // (though not exactly same) as that on the sockets-based systems.
+    while ((timersHandled < Timer::sPool.Size()) && (lTimer = aLayer.mTimerWheel.PopExpired()) != NULL)
     {
-        // limit the number of timers handled before the control is returned to the event queue.  The bound is similar to
-        // (though not exactly same) as that on the sockets-based systems.
+        aLayer.mTimerComplete = true;
+        lTimer->HandleComplete();
+        aLayer.mTimerComplete = false;
 
-        // The platform timer API has MSEC resolution so expire any timer with less than 1 msec remaining.
-        if ((timersHandled < Timer::sPool.Size()) && Timer::IsEarlierEpoch(aLayer.mTimerList->mAwakenEpoch, currentEpoch + 1))
-        {
-            Timer & lTimer    = *aLayer.mTimerList;
-            aLayer.mTimerList = lTimer.mNextTimer;
-            lTimer.mNextTimer = NULL;
+        timersHandled++;
+    }
 
-            aLayer.mTimerComplete = true;
-            lTimer.HandleComplete();
-            aLayer.mTimerComplete = false;
+    if (aLayer.mTimerWheel.GetNextWakeup(lWakeup))
+    {
+        // timers still exist so restart the platform timer.
+        uint64_t delayMilliseconds = 0ULL;
+        Epoch currentEpoch         = Timer::GetCurrentEpoch();
 
-            timersHandled++;
-        }
-        else
+        // the next wakeup is in the future, so set the delayMilliseconds to a non-zero value
+        if (currentEpoch < lWakeup)
         {
-            // timers still exist so restart the platform timer.
-            uint64_t delayMilliseconds = 0ULL;
-
-            currentEpoch = Timer::GetCurrentEpoch();
-
-            // the next timer expires in the future, so set the delayMilliseconds to a non-zero value
-            if (currentEpoch < aLayer.mTimerList->mAwakenEpoch)
-            {
-                delayMilliseconds = aLayer.mTimerList->mAwakenEpoch - currentEpoch;
-            }
-            /*
-             * StartPlatformTimer() accepts a 32bit value in milliseconds.  Epochs are 64bit numbers.  The only way in which this
-             * could overflow is if time went backwards (e.g. as a result of a time adjustment from time synchronization).  Verify
-             * that the timer can still be executed (even if it is very late) and exit if that is the case.  Note: if the time sync
-             * ever ends up adjusting the clock, we should implement a method that deals with all the timers in the system.
-             */
-            VerifyOrDie(delayMilliseconds <= UINT32_MAX);
-
-            aLayer.StartPlatformTimer(static_cast<uint32_t>(delayMilliseconds));
-            break; // all remaining timers are still ticking.
+            delayMilliseconds = lWakeup - currentEpoch;
         }
+        /*
+         * StartPlatformTimer() accepts a 32bit value in milliseconds.  Epochs are 64bit numbers.  The only way in which this
+         * could overflow is if time went backwards (e.g. as a result of a time adjustment from time synchronization).  Verify
+         * that the timer can still be executed (even if it is very late) and exit if that is the case.  Note: if the time sync
+         * ever ends up adjusting the clock, we should implement a method that deals with all the timers in the system.
+         */
+        VerifyOrDie(delayMilliseconds <= UINT32_MAX);
+
+        aLayer.StartPlatformTimer(static_cast<uint32_t>(delayMilliseconds));
     }
 
     return CHIP_SYSTEM_NO_ERROR;
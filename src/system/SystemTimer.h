@@ -35,6 +35,7 @@
 #include <system/SystemError.h>
 #include <system/SystemObject.h>
 #include <system/SystemStats.h>
+#include <system/SystemTimerWheel.h>
 
 namespace chip {
 namespace System {
@@ -53,6 +54,7 @@ class Layer;
 class DLL_EXPORT Timer : public Object
 {
     friend class Layer;
+    friend class TimerWheel<Timer>;
 
 public:
     /**
@@ -78,13 +80,16 @@ private:
 
     Epoch mAwakenEpoch;
 
+    // Links in the owning layer's timer wheel.
+    Timer * mWheelNext;
+    Timer ** mWheelPrevLink;
+    uint16_t mWheelBucket;
+
     void HandleComplete();
 
     Error ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState);
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
-    Timer * mNextTimer;
-
     static Error HandleExpiredTimers(Layer & aLayer);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
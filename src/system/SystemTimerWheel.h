@@ -0,0 +1,428 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the chip::System::TimerWheel class template, a
+ *      hierarchical timing wheel used by the CHIP System Layer to keep
+ *      track of pending one-shot timers.
+ */
+
+#pragma once
+
+// Include configuration headers
+#include <system/SystemConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace System {
+
+/**
+ * @class TimerWheel
+ *
+ * @brief
+ *  An intrusive hierarchical timing wheel with millisecond ticks.
+ *
+ *  Entries are objects of type @a T that provide the following members, which are owned by the wheel while the entry is linked:
+ *
+ *      uint64_t mAwakenEpoch;    // the epoch at which the entry expires, in the same timescale as passed to Advance()
+ *      T * mWheelNext;
+ *      T ** mWheelPrevLink;
+ *      uint16_t mWheelBucket;    // zero when the entry is not linked
+ *
+ *  Level @em n of the wheel has 2^CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS slots, each covering 2^(n * SLOT_BITS) milliseconds.
+ *  An entry is placed on the lowest level whose current revolution still contains its expiry, and is cascaded to a lower level
+ *  when the wheel reaches the start of its slot. Inserting and removing an entry are O(1); advancing the wheel only visits slots
+ *  that are occupied, so idle periods cost nothing.
+ *
+ *  Entries that expire are moved, in order of expiry, to an expired list from which the owner pops and completes them one at a
+ *  time. Entries inserted while the wheel is being drained never become due before the next call to Advance(). Entries with the
+ *  same expiry are completed in an unspecified order.
+ *
+ *  Epochs are assumed not to wrap. The wheel is not thread safe; callers must serialize access to it.
+ */
+template <class T>
+class TimerWheel
+{
+public:
+    typedef uint64_t Epoch;
+
+    static constexpr unsigned kSlotBits  = CHIP_SYSTEM_CONFIG_TIMER_WHEEL_SLOT_BITS;
+    static constexpr unsigned kSlotCount = 1u << kSlotBits;
+    static constexpr unsigned kLevels    = (32 + kSlotBits - 1) / kSlotBits;
+
+    TimerWheel();
+
+    void Init(Epoch aNow);
+    bool IsEmpty() const;
+
+    void Insert(T & aEntry);
+    void Remove(T & aEntry);
+
+    void Advance(Epoch aNow);
+    T * PopExpired();
+
+    bool GetNextWakeup(Epoch & aEpoch) const;
+
+private:
+    enum : uint16_t
+    {
+        kBucket_None      = 0,
+        kBucket_Due       = 1,
+        kBucket_Expired   = 2,
+        kBucket_FirstSlot = 3,
+    };
+
+    static constexpr Epoch kSlotMask         = kSlotCount - 1;
+    static constexpr uint64_t kOccupiedMask = (kSlotCount == 64) ? ~static_cast<uint64_t>(0)
+                                                                 : ((static_cast<uint64_t>(1) << (kSlotCount % 64)) - 1);
+
+    struct List
+    {
+        T * mHead;
+        T ** mTail;
+    };
+
+    Epoch mCurrent;                  /**< Entries expiring at or before this epoch have been moved out of the slots. */
+    T * mSlots[kLevels][kSlotCount]; /**< Heads of the per-slot lists. */
+    uint64_t mOccupied[kLevels];     /**< Bitmap of the non-empty slots in each level. */
+    List mDue;                       /**< Entries inserted with an expiry that had already been reached. */
+    List mExpired;                   /**< Entries waiting to be popped by the owner. */
+
+    void Place(T & aEntry);
+    void Append(List & aList, T & aEntry, uint16_t aBucket);
+    void Unlink(T & aEntry);
+    void Cascade(unsigned aLevel, unsigned aSlot);
+    bool GetNextTick(Epoch & aTick) const;
+
+    static unsigned DistanceToNextSlot(uint64_t aOccupied, unsigned aCurrentSlot);
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel & operator=(const TimerWheel &) = delete;
+};
+
+template <class T>
+inline TimerWheel<T>::TimerWheel() : mCurrent(0)
+{
+    for (unsigned lLevel = 0; lLevel < kLevels; lLevel++)
+    {
+        for (unsigned lSlot = 0; lSlot < kSlotCount; lSlot++)
+        {
+            mSlots[lLevel][lSlot] = nullptr;
+        }
+        mOccupied[lLevel] = 0;
+    }
+
+    mDue.mHead     = nullptr;
+    mDue.mTail     = &mDue.mHead;
+    mExpired.mHead = nullptr;
+    mExpired.mTail = &mExpired.mHead;
+}
+
+/**
+ *  Sets the current epoch of an empty wheel. Has no effect if the wheel holds any entries.
+ */
+template <class T>
+inline void TimerWheel<T>::Init(Epoch aNow)
+{
+    if (IsEmpty())
+    {
+        mCurrent = aNow;
+    }
+}
+
+template <class T>
+inline bool TimerWheel<T>::IsEmpty() const
+{
+    for (unsigned lLevel = 0; lLevel < kLevels; lLevel++)
+    {
+        if (mOccupied[lLevel] != 0)
+        {
+            return false;
+        }
+    }
+
+    return mDue.mHead == nullptr && mExpired.mHead == nullptr;
+}
+
+/**
+ *  Adds an unlinked entry to the wheel, to expire at its mAwakenEpoch.
+ */
+template <class T>
+inline void TimerWheel<T>::Insert(T & aEntry)
+{
+    if (aEntry.mAwakenEpoch <= mCurrent)
+    {
+        Append(mDue, aEntry, kBucket_Due);
+    }
+    else
+    {
+        Place(aEntry);
+    }
+}
+
+/**
+ *  Removes an entry from the wheel, whether pending or expired. Has no effect if the entry is not linked.
+ */
+template <class T>
+inline void TimerWheel<T>::Remove(T & aEntry)
+{
+    if (aEntry.mWheelBucket != kBucket_None)
+    {
+        Unlink(aEntry);
+    }
+}
+
+/**
+ *  Moves the wheel forward to @a aNow, moving every entry that expires at or before @a aNow to the expired list.
+ */
+template <class T>
+void TimerWheel<T>::Advance(Epoch aNow)
+{
+    Epoch lTick;
+    T * lEntry;
+
+    while ((lEntry = mDue.mHead) != nullptr)
+    {
+        Unlink(*lEntry);
+        Append(mExpired, *lEntry, kBucket_Expired);
+    }
+
+    while (GetNextTick(lTick) && lTick <= aNow)
+    {
+        mCurrent = lTick;
+
+        // Cascade from the top down, so that entries moved out of a higher level land in lower level slots that are about to be
+        // visited in this same tick.
+        for (unsigned lLevel = kLevels - 1; lLevel > 0; lLevel--)
+        {
+            const unsigned lShift = lLevel * kSlotBits;
+
+            if ((mCurrent & ((static_cast<Epoch>(1) << lShift) - 1)) == 0)
+            {
+                Cascade(lLevel, static_cast<unsigned>((mCurrent >> lShift) & kSlotMask));
+            }
+        }
+
+        const unsigned lSlot = static_cast<unsigned>(mCurrent & kSlotMask);
+
+        while ((lEntry = mSlots[0][lSlot]) != nullptr)
+        {
+            Unlink(*lEntry);
+            Append(mExpired, *lEntry, kBucket_Expired);
+        }
+    }
+
+    if (aNow > mCurrent)
+    {
+        mCurrent = aNow;
+    }
+}
+
+/**
+ *  Unlinks and returns the earliest expired entry, or nullptr if there is none.
+ */
+template <class T>
+inline T * TimerWheel<T>::PopExpired()
+{
+    T * lEntry = mExpired.mHead;
+
+    if (lEntry != nullptr)
+    {
+        Unlink(*lEntry);
+    }
+
+    return lEntry;
+}
+
+/**
+ *  Computes the epoch at which Advance() next has work to do.
+ *
+ *  @note
+ *      The returned epoch never lies after the earliest expiry in the wheel, but may lie before it when a long running entry
+ *      needs to be cascaded to a lower level first. It may also lie in the past.
+ *
+ *  @return false if the wheel is empty, true otherwise.
+ */
+template <class T>
+inline bool TimerWheel<T>::GetNextWakeup(Epoch & aEpoch) const
+{
+    if (mDue.mHead != nullptr || mExpired.mHead != nullptr)
+    {
+        aEpoch = mCurrent;
+        return true;
+    }
+
+    return GetNextTick(aEpoch);
+}
+
+template <class T>
+void TimerWheel<T>::Place(T & aEntry)
+{
+    unsigned lLevel   = 0;
+    Epoch lBlock      = aEntry.mAwakenEpoch;
+    Epoch lCurrentBlk = mCurrent;
+
+    // Find the lowest level on which the entry's slot is less than one revolution ahead of the current slot. Entries beyond the
+    // reach of the top level are parked in its furthest slot and placed again when that slot is cascaded.
+    while (lBlock - lCurrentBlk >= kSlotCount)
+    {
+        if (lLevel == kLevels - 1)
+        {
+            lBlock = lCurrentBlk + kSlotCount - 1;
+            break;
+        }
+
+        lLevel++;
+        lBlock      = aEntry.mAwakenEpoch >> (lLevel * kSlotBits);
+        lCurrentBlk = mCurrent >> (lLevel * kSlotBits);
+    }
+
+    const unsigned lSlot = static_cast<unsigned>(lBlock & kSlotMask);
+    T *& lHead           = mSlots[lLevel][lSlot];
+
+    aEntry.mWheelNext     = lHead;
+    aEntry.mWheelPrevLink = &lHead;
+    aEntry.mWheelBucket   = static_cast<uint16_t>(kBucket_FirstSlot + lLevel * kSlotCount + lSlot);
+
+    if (lHead != nullptr)
+    {
+        lHead->mWheelPrevLink = &aEntry.mWheelNext;
+    }
+
+    lHead = &aEntry;
+    mOccupied[lLevel] |= static_cast<uint64_t>(1) << lSlot;
+}
+
+template <class T>
+inline void TimerWheel<T>::Append(List & aList, T & aEntry, uint16_t aBucket)
+{
+    aEntry.mWheelNext     = nullptr;
+    aEntry.mWheelPrevLink = aList.mTail;
+    aEntry.mWheelBucket   = aBucket;
+
+    *aList.mTail = &aEntry;
+    aList.mTail  = &aEntry.mWheelNext;
+}
+
+template <class T>
+void TimerWheel<T>::Unlink(T & aEntry)
+{
+    const uint16_t lBucket = aEntry.mWheelBucket;
+
+    *aEntry.mWheelPrevLink = aEntry.mWheelNext;
+
+    if (aEntry.mWheelNext != nullptr)
+    {
+        aEntry.mWheelNext->mWheelPrevLink = aEntry.mWheelPrevLink;
+    }
+    else if (lBucket == kBucket_Due)
+    {
+        mDue.mTail = aEntry.mWheelPrevLink;
+    }
+    else if (lBucket == kBucket_Expired)
+    {
+        mExpired.mTail = aEntry.mWheelPrevLink;
+    }
+
+    if (lBucket >= kBucket_FirstSlot)
+    {
+        const unsigned lLevel = (lBucket - kBucket_FirstSlot) / kSlotCount;
+        const unsigned lSlot  = (lBucket - kBucket_FirstSlot) % kSlotCount;
+
+        if (mSlots[lLevel][lSlot] == nullptr)
+        {
+            mOccupied[lLevel] &= ~(static_cast<uint64_t>(1) << lSlot);
+        }
+    }
+
+    aEntry.mWheelNext     = nullptr;
+    aEntry.mWheelPrevLink = nullptr;
+    aEntry.mWheelBucket   = kBucket_None;
+}
+
+template <class T>
+void TimerWheel<T>::Cascade(unsigned aLevel, unsigned aSlot)
+{
+    T * lEntry;
+
+    while ((lEntry = mSlots[aLevel][aSlot]) != nullptr)
+    {
+        Unlink(*lEntry);
+
+        if (lEntry->mAwakenEpoch <= mCurrent)
+        {
+            Append(mExpired, *lEntry, kBucket_Expired);
+        }
+        else
+        {
+            Place(*lEntry);
+        }
+    }
+}
+
+/**
+ *  Computes the earliest epoch after the current one at which a level 0 slot expires or a higher level slot must be cascaded.
+ */
+template <class T>
+bool TimerWheel<T>::GetNextTick(Epoch & aTick) const
+{
+    bool lFound = false;
+
+    for (unsigned lLevel = 0; lLevel < kLevels; lLevel++)
+    {
+        if (mOccupied[lLevel] == 0)
+        {
+            continue;
+        }
+
+        const unsigned lShift = lLevel * kSlotBits;
+        const Epoch lBlock    = mCurrent >> lShift;
+        const unsigned lSlot  = static_cast<unsigned>(lBlock & kSlotMask);
+        const Epoch lTick     = (lBlock + DistanceToNextSlot(mOccupied[lLevel], lSlot)) << lShift;
+
+        if (!lFound || lTick < aTick)
+        {
+            aTick  = lTick;
+            lFound = true;
+        }
+    }
+
+    return lFound;
+}
+
+/**
+ *  Returns the number of slots, between 1 and kSlotCount, from @a aCurrentSlot to the next occupied slot after it.
+ */
+template <class T>
+inline unsigned TimerWheel<T>::DistanceToNextSlot(uint64_t aOccupied, unsigned aCurrentSlot)
+{
+    const unsigned lStart = (aCurrentSlot + 1) & static_cast<unsigned>(kSlotMask);
+    uint64_t lRotated     = aOccupied >> lStart;
+
+    if (lStart != 0)
+    {
+        lRotated = (lRotated | (aOccupied << (kSlotCount - lStart))) & kOccupiedMask;
+    }
+
+    return static_cast<unsigned>(__builtin_ctzll(lRotated)) + 1;
+}
+
+} // namespace System
+} // namespace chip
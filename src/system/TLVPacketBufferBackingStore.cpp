@@ -37,24 +37,32 @@ CHIP_ERROR TLVPacketBufferBackingStore::OnInit(chip::TLV::TLVReader & reader, co
 
 CHIP_ERROR TLVPacketBufferBackingStore::GetNextBuffer(chip::TLV::TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen)
 {
+    PacketBufferHandle nextBuffer;
+
     if (mUseChainedBuffers)
     {
-        mCurrentBuffer.Advance();
-    }
-    else
-    {
-        mCurrentBuffer = nullptr;
+        // Readers are freely copied, and the copies share this store, so the buffer a reader has just finished is found from
+        // its read point rather than kept here.
+        nextBuffer = mHeadBuffer.Retain();
+        while (!nextBuffer.IsNull() && nextBuffer->Start() + nextBuffer->DataLength() != reader.GetReadPoint())
+        {
+            nextBuffer.Advance();
+        }
+        if (!nextBuffer.IsNull())
+        {
+            nextBuffer.Advance();
+        }
     }
 
-    if (mCurrentBuffer.IsNull())
+    if (nextBuffer.IsNull())
     {
         bufStart = nullptr;
         bufLen   = 0;
     }
     else
     {
-        bufStart = mCurrentBuffer->Start();
-        bufLen   = mCurrentBuffer->DataLength();
+        bufStart = nextBuffer->Start();
+        bufLen   = nextBuffer->DataLength();
     }
 
     return CHIP_NO_ERROR;
@@ -76,7 +84,8 @@ CHIP_ERROR TLVPacketBufferBackingStore::FinalizeBuffer(chip::TLV::TLVWriter & wr
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
-    mCurrentBuffer->SetDataLength(static_cast<uint16_t>(length));
+    // Keep the total length of the chain in the head buffer up to date as well.
+    mCurrentBuffer->SetDataLength(static_cast<uint16_t>(length), mHeadBuffer);
 
     return CHIP_NO_ERROR;
 }
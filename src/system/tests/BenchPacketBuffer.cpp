@@ -0,0 +1,104 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the allocation throughput of the
+ *      configured packet buffer store, for ack-sized and full-sized buffers.
+ *
+ *      Build it once with and once without
+ *      CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES to compare the
+ *      size-classed cache with plain heap allocation.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+using namespace chip::System;
+
+namespace {
+
+constexpr size_t kIterations = 100000;
+constexpr size_t kBurst      = 8;
+const uint8_t kAck[40]       = { 0 };
+
+const char * StoreName()
+{
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+    return "size classes";
+#elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+    return "heap";
+#elif CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL
+    return "pool";
+#else
+    return "lwip";
+#endif
+}
+
+} // namespace
+
+int main()
+{
+    struct
+    {
+        const char * name;
+        size_t dataSize;
+    } const kWorkloads[] = {
+        { "ack", sizeof(kAck) },
+        { "full", PacketBuffer::kMaxSize },
+    };
+
+    VerifyOrDie(chip::Platform::MemoryInit() == CHIP_NO_ERROR);
+
+    printf("PacketBuffer store: %s\n", StoreName());
+
+    for (const auto & workload : kWorkloads)
+    {
+        const uint16_t additionalSize = static_cast<uint16_t>(workload.dataSize - sizeof(kAck));
+        PacketBufferHandle burst[kBurst];
+
+        const uint64_t start = Platform::Layer::GetClock_MonotonicHiRes();
+        for (size_t i = 0; i < kIterations / kBurst; ++i)
+        {
+            for (auto & buffer : burst)
+            {
+                buffer = PacketBufferHandle::NewWithData(kAck, sizeof(kAck), additionalSize);
+                VerifyOrDie(!buffer.IsNull());
+            }
+            for (auto & buffer : burst)
+            {
+                buffer = nullptr;
+            }
+        }
+        const uint64_t elapsed = Platform::Layer::GetClock_MonotonicHiRes() - start;
+
+        printf("PacketBuffer %-4s: %u alloc/free pairs in %" PRIu64 " us (%" PRIu64 " ns each)\n", workload.name,
+               static_cast<unsigned>(kIterations), elapsed, elapsed * 1000 / kIterations);
+    }
+
+    chip::Platform::MemoryShutdown();
+
+    return EXIT_SUCCESS;
+}
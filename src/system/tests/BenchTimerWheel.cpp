@@ -0,0 +1,123 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of insert, cancel and expiry of
+ *      10000 timers in <tt>chip::System::TimerWheel</tt>.
+ *
+ */
+
+#include <system/SystemConfig.h>
+
+#include <system/SystemTimerWheel.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+using namespace chip::System;
+
+namespace {
+
+struct BenchWheelTimer
+{
+    uint64_t mAwakenEpoch;
+    BenchWheelTimer * mWheelNext;
+    BenchWheelTimer ** mWheelPrevLink;
+    uint16_t mWheelBucket;
+};
+
+typedef TimerWheel<BenchWheelTimer> BenchWheel;
+
+constexpr size_t kNumWheelTimers = 10000;
+constexpr uint32_t kMaxDelay     = 60000;
+constexpr uint64_t kStartEpoch   = 1000000;
+
+BenchWheelTimer sWheelTimers[kNumWheelTimers];
+
+uint64_t NowNS()
+{
+    struct timespec lTime;
+    clock_gettime(CLOCK_MONOTONIC, &lTime);
+    return static_cast<uint64_t>(lTime.tv_sec) * 1000000000ULL + static_cast<uint64_t>(lTime.tv_nsec);
+}
+
+size_t DrainWheel(BenchWheel & aWheel, uint64_t aNow)
+{
+    size_t lCount = 0;
+
+    aWheel.Advance(aNow);
+    while (aWheel.PopExpired() != nullptr)
+    {
+        lCount++;
+    }
+    return lCount;
+}
+
+} // namespace
+
+int main()
+{
+    BenchWheel lWheel;
+    uint64_t lStart, lInsertNS, lCancelNS, lExpireNS;
+    size_t lFired = 0;
+
+    srand(2);
+    lWheel.Init(kStartEpoch);
+    for (size_t i = 0; i < kNumWheelTimers; i++)
+    {
+        memset(&sWheelTimers[i], 0, sizeof(sWheelTimers[i]));
+        sWheelTimers[i].mAwakenEpoch = kStartEpoch + static_cast<uint64_t>(rand()) % (static_cast<uint64_t>(kMaxDelay) + 1);
+    }
+
+    lStart = NowNS();
+    for (size_t i = 0; i < kNumWheelTimers; i++)
+    {
+        lWheel.Insert(sWheelTimers[i]);
+    }
+    lInsertNS = NowNS() - lStart;
+
+    lStart = NowNS();
+    for (size_t i = 0; i < kNumWheelTimers; i += 2)
+    {
+        lWheel.Remove(sWheelTimers[i]);
+    }
+    lCancelNS = NowNS() - lStart;
+
+    lStart = NowNS();
+    for (uint64_t lNow = kStartEpoch; lNow <= kStartEpoch + kMaxDelay; lNow += 10)
+    {
+        lFired += DrainWheel(lWheel, lNow);
+    }
+    lExpireNS = NowNS() - lStart;
+
+    if (lFired != kNumWheelTimers / 2 || !lWheel.IsEmpty())
+    {
+        printf("timer wheel fired %u of %u timers\n", static_cast<unsigned>(lFired), static_cast<unsigned>(kNumWheelTimers / 2));
+        return EXIT_FAILURE;
+    }
+
+    printf("timer wheel, %u timers: insert %.1f ns/timer, cancel %.1f ns/timer, expire %.1f ns/timer\n",
+           static_cast<unsigned>(kNumWheelTimers), static_cast<double>(lInsertNS) / kNumWheelTimers,
+           static_cast<double>(lCancelNS) / (kNumWheelTimers / 2), static_cast<double>(lExpireNS) / (kNumWheelTimers / 2));
+
+    return EXIT_SUCCESS;
+}
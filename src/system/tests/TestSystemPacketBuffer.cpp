@@ -27,6 +27,7 @@
 #define __STDC_LIMIT_MACROS
 #endif
 
+#include <algorithm>
 #include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -39,6 +40,10 @@
 #include <support/UnitTestRegistration.h>
 #include <system/SystemPacketBuffer.h>
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
 #include <lwip/tcpip.h>
@@ -131,7 +136,9 @@ public:
     static void CheckHandleRightSize(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
+    static void CheckHandleGetDataSegments(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
+    static void CheckSizeClasses(nlTestSuite * inSuite, void * inContext);
 
     static void PrintHandle(const char * tag, const PacketBuffer * buffer)
     {
@@ -1904,6 +1911,103 @@ void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, memcmp(yayBuffer->Start(), kPayload, sizeof kPayload) == 0);
 }
 
+void PacketBufferTest::CheckHandleGetDataSegments(nlTestSuite * inSuite, void * inContext)
+{
+    struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
+    PacketBufferTest * const test         = theContext->test;
+    NL_TEST_ASSERT(inSuite, test->mContext == theContext);
+
+    const uint8_t kFirst[]  = { 1, 2, 3 };
+    const uint8_t kSecond[] = { 4, 5, 6, 7 };
+    chip::ByteSpan segments[3];
+
+    // An empty handle has no segments.
+    PacketBufferHandle chain;
+    NL_TEST_ASSERT(inSuite, chain.GetDataSegments(segments, 3) == 0);
+
+    // Empty buffers in the chain are skipped.
+    chain = PacketBufferHandle::NewWithData(kFirst, sizeof(kFirst));
+    chain->AddToEnd(PacketBufferHandle::New(10));
+    chain->AddToEnd(PacketBufferHandle::NewWithData(kSecond, sizeof(kSecond)));
+    NL_TEST_ASSERT(inSuite, chain.GetDataSegments(segments, 3) == 2);
+    NL_TEST_ASSERT(inSuite, segments[0].data() == chain->Start() && segments[0].size() == sizeof(kFirst));
+    NL_TEST_ASSERT(inSuite, segments[1].size() == sizeof(kSecond));
+    NL_TEST_ASSERT(inSuite, memcmp(segments[1].data(), kSecond, sizeof(kSecond)) == 0);
+
+    // A short array is filled and the full count returned.
+    segments[1] = chip::ByteSpan();
+    NL_TEST_ASSERT(inSuite, chain.GetDataSegments(segments, 1) == 2);
+    NL_TEST_ASSERT(inSuite, segments[0].size() == sizeof(kFirst));
+    NL_TEST_ASSERT(inSuite, segments[1].data() == nullptr);
+}
+
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+static void * FreeBuffersOnThread(void * aBuffers)
+{
+    std::vector<PacketBufferHandle> * const buffers = static_cast<std::vector<PacketBufferHandle> *>(aBuffers);
+    buffers->clear();
+    return nullptr;
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+void PacketBufferTest::CheckSizeClasses(nlTestSuite * inSuite, void * inContext)
+{
+    struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
+    PacketBufferTest * const test         = theContext->test;
+    NL_TEST_ASSERT(inSuite, test->mContext == theContext);
+
+    constexpr uint16_t kSmall  = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_SMALL;
+    constexpr uint16_t kMedium = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASS_MEDIUM;
+
+    // Allocations are rounded up to their size class.
+    PacketBufferHandle small  = PacketBufferHandle::New(10, 0);
+    PacketBufferHandle medium = PacketBufferHandle::New(kSmall + 1, 0);
+    PacketBufferHandle large  = PacketBufferHandle::New(kMedium - 10, 11);
+    NL_TEST_ASSERT(inSuite, !small.IsNull() && !medium.IsNull() && !large.IsNull());
+    NL_TEST_ASSERT(inSuite, small->AllocSize() == kSmall);
+    NL_TEST_ASSERT(inSuite, medium->AllocSize() == kMedium);
+    NL_TEST_ASSERT(inSuite, large->AllocSize() == PacketBuffer::kMaxSizeWithoutReserve);
+
+    // A freed buffer is reused by the next allocation of its own class only.
+    const PacketBuffer * const smallBuffer = small.Get();
+    small                                  = nullptr;
+    medium                                 = PacketBufferHandle::New(kSmall + 1, 0);
+    NL_TEST_ASSERT(inSuite, medium.Get() != smallBuffer);
+    small = PacketBufferHandle::New(1, 0);
+    NL_TEST_ASSERT(inSuite, small.Get() == smallBuffer);
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    // Buffers freed on another thread are reused here through the shared list.
+    constexpr size_t kCount = 2 * CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE;
+    std::vector<PacketBufferHandle> buffers;
+    std::vector<const PacketBuffer *> freed;
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        buffers.push_back(PacketBufferHandle::New(1, 0));
+        NL_TEST_ASSERT(inSuite, !buffers.back().IsNull());
+        freed.push_back(buffers.back().Get());
+    }
+
+    pthread_t thread;
+    NL_TEST_ASSERT(inSuite, pthread_create(&thread, nullptr, FreeBuffersOnThread, &buffers) == 0);
+    NL_TEST_ASSERT(inSuite, pthread_join(thread, nullptr) == 0);
+    NL_TEST_ASSERT(inSuite, buffers.empty());
+
+    size_t reused = 0;
+    for (size_t i = 0; i < kCount; ++i)
+    {
+        buffers.push_back(PacketBufferHandle::New(1, 0));
+        NL_TEST_ASSERT(inSuite, !buffers.back().IsNull());
+        reused += (std::find(freed.begin(), freed.end(), buffers.back().Get()) != freed.end()) ? 1 : 0;
+    }
+    NL_TEST_ASSERT(inSuite, reused > 0);
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -1944,6 +2048,10 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
+    NL_TEST_DEF("PacketBuffer::HandleGetDataSegments",  PacketBufferTest::CheckHandleGetDataSegments),
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_SIZED
+    NL_TEST_DEF("PacketBuffer::SizeClasses",            PacketBufferTest::CheckSizeClasses),
+#endif
 
     NL_TEST_SENTINEL()
 };
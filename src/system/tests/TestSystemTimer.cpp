@@ -36,6 +36,7 @@
 #include <system/SystemError.h>
 #include <system/SystemLayer.h>
 #include <system/SystemTimer.h>
+#include <system/SystemTimerWheel.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -49,6 +50,7 @@
 
 #include <errno.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 using chip::ErrorStr;
@@ -206,6 +208,129 @@ static void CheckStarvation(nlTestSuite * inSuite, void * aContext)
     ServiceEvents(lSys, sleepTime);
 }
 
+// Timer wheel tests.
+
+struct TestWheelTimer
+{
+    uint64_t mAwakenEpoch;
+    TestWheelTimer * mWheelNext;
+    TestWheelTimer ** mWheelPrevLink;
+    uint16_t mWheelBucket;
+    uint64_t mFiredEpoch;
+    bool mCancelled;
+};
+
+typedef TimerWheel<TestWheelTimer> TestWheel;
+
+static const size_t kNumWheelTimers = 10000;
+static TestWheelTimer sWheelTimers[kNumWheelTimers];
+
+static void ResetWheelTimers(uint64_t aStartEpoch, uint32_t aMaxDelay)
+{
+    for (size_t i = 0; i < kNumWheelTimers; i++)
+    {
+        memset(&sWheelTimers[i], 0, sizeof(sWheelTimers[i]));
+        sWheelTimers[i].mAwakenEpoch = aStartEpoch + static_cast<uint64_t>(rand()) % (static_cast<uint64_t>(aMaxDelay) + 1);
+    }
+}
+
+static size_t DrainWheel(TestWheel & aWheel, uint64_t aNow)
+{
+    size_t lCount = 0;
+    TestWheelTimer * lTimer;
+
+    aWheel.Advance(aNow);
+    while ((lTimer = aWheel.PopExpired()) != nullptr)
+    {
+        lTimer->mFiredEpoch = aNow;
+        lCount++;
+    }
+    return lCount;
+}
+
+static void CheckTimerWheel(nlTestSuite * inSuite, void * aContext)
+{
+    // Start just below a level boundary, so that cascading is exercised right away.
+    const uint64_t kStartEpoch = (1ULL << 30) - 5;
+    TestWheel lWheel;
+    size_t lFired = 0;
+    uint64_t lNow;
+
+    srand(1);
+    lWheel.Init(kStartEpoch);
+    ResetWheelTimers(kStartEpoch, 100000);
+    for (size_t i = 0; i < kNumWheelTimers; i++)
+    {
+        lWheel.Insert(sWheelTimers[i]);
+    }
+
+    // Cancel every third timer.
+    for (size_t i = 0; i < kNumWheelTimers; i += 3)
+    {
+        lWheel.Remove(sWheelTimers[i]);
+        sWheelTimers[i].mCancelled = true;
+    }
+
+    // Step one millisecond at a time for a while, then in uneven jumps.
+    for (lNow = kStartEpoch; lNow < kStartEpoch + 5000; lNow++)
+    {
+        lFired += DrainWheel(lWheel, lNow);
+    }
+    for (; !lWheel.IsEmpty(); lNow += 777)
+    {
+        lFired += DrainWheel(lWheel, lNow);
+    }
+
+    NL_TEST_ASSERT(inSuite, lFired == kNumWheelTimers - (kNumWheelTimers + 2) / 3);
+
+    for (size_t i = 0; i < kNumWheelTimers; i++)
+    {
+        const TestWheelTimer & lTimer = sWheelTimers[i];
+
+        if (lTimer.mCancelled)
+        {
+            NL_TEST_ASSERT(inSuite, lTimer.mFiredEpoch == 0);
+        }
+        else if (lTimer.mAwakenEpoch < kStartEpoch + 5000)
+        {
+            // Exactly on time while stepping by one millisecond
+            NL_TEST_ASSERT(inSuite, lTimer.mFiredEpoch == lTimer.mAwakenEpoch);
+        }
+        else
+        {
+            NL_TEST_ASSERT(inSuite, lTimer.mFiredEpoch >= lTimer.mAwakenEpoch);
+            NL_TEST_ASSERT(inSuite, lTimer.mFiredEpoch < lTimer.mAwakenEpoch + 777);
+        }
+    }
+
+    // Timers beyond the reach of the wheel, and timers that are already due.
+    NL_TEST_ASSERT(inSuite, DrainWheel(lWheel, lNow) == 0);
+
+    TestWheelTimer & lFar  = sWheelTimers[0];
+    TestWheelTimer & lPast = sWheelTimers[1];
+    memset(&lFar, 0, sizeof(lFar));
+    memset(&lPast, 0, sizeof(lPast));
+    lFar.mAwakenEpoch  = lNow + (1ULL << 40);
+    lPast.mAwakenEpoch = lNow - 10;
+    lWheel.Insert(lFar);
+    lWheel.Insert(lPast);
+
+    uint64_t lWakeup;
+    NL_TEST_ASSERT(inSuite, lWheel.GetNextWakeup(lWakeup) && lWakeup == lNow);
+    NL_TEST_ASSERT(inSuite, DrainWheel(lWheel, lNow) == 1 && lPast.mFiredEpoch == lNow);
+
+    while (lWheel.GetNextWakeup(lWakeup))
+    {
+        NL_TEST_ASSERT(inSuite, lWakeup <= lFar.mAwakenEpoch);
+        if (DrainWheel(lWheel, lWakeup) != 0)
+        {
+            break;
+        }
+    }
+    NL_TEST_ASSERT(inSuite, lFar.mFiredEpoch == lFar.mAwakenEpoch);
+    NL_TEST_ASSERT(inSuite, lWheel.IsEmpty());
+}
+
 // Test Suite
 
 /**
@@ -216,6 +341,7 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("Timer::TestOverflow",             CheckOverflow),
     NL_TEST_DEF("Timer::TestTimerStarvation",      CheckStarvation),
+    NL_TEST_DEF("Timer::TestTimerWheel",           CheckTimerWheel),
     NL_TEST_SENTINEL()
 };
 // clang-format on
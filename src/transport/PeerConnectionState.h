@@ -33,6 +33,25 @@ namespace Transport {
 
 static constexpr uint32_t kUndefinedMessageIndex = UINT32_MAX;
 
+class PeerConnectionState;
+
+/**
+ * Receives notifications about changes to the fields of a PeerConnectionState
+ * that its owner uses to look the state up (peer address, peer node id and
+ * key ids). Used by PeerConnections to keep its lookup indexes current when a
+ * pooled state is modified in place.
+ */
+class DLL_EXPORT PeerConnectionStateDelegate
+{
+public:
+    virtual ~PeerConnectionStateDelegate() {}
+
+    /**
+     * Gets called after a lookup field of the given state has been modified.
+     **/
+    virtual void OnLookupKeyChanged(PeerConnectionState & state) = 0;
+};
+
 /**
  * Defines state of a peer connection at a transport layer.
  *
@@ -59,20 +78,35 @@ public:
     PeerConnectionState & operator=(PeerConnectionState &&) = default;
 
     const PeerAddress & GetPeerAddress() const { return mPeerAddress; }
-    PeerAddress & GetPeerAddress() { return mPeerAddress; }
-    void SetPeerAddress(const PeerAddress & address) { mPeerAddress = address; }
+    void SetPeerAddress(const PeerAddress & address)
+    {
+        mPeerAddress = address;
+        NotifyLookupKeyChanged();
+    }
 
     void SetTransport(Transport::Base * transport) { mTransport = transport; }
     Transport::Base * GetTransport() { return mTransport; }
 
     NodeId GetPeerNodeId() const { return mPeerNodeId; }
-    void SetPeerNodeId(NodeId peerNodeId) { mPeerNodeId = peerNodeId; }
+    void SetPeerNodeId(NodeId peerNodeId)
+    {
+        mPeerNodeId = peerNodeId;
+        NotifyLookupKeyChanged();
+    }
 
     uint16_t GetPeerKeyID() const { return mPeerKeyID; }
-    void SetPeerKeyID(uint16_t id) { mPeerKeyID = id; }
+    void SetPeerKeyID(uint16_t id)
+    {
+        mPeerKeyID = id;
+        NotifyLookupKeyChanged();
+    }
 
     uint16_t GetLocalKeyID() const { return mLocalKeyID; }
-    void SetLocalKeyID(uint16_t id) { mLocalKeyID = id; }
+    void SetLocalKeyID(uint16_t id)
+    {
+        mLocalKeyID = id;
+        NotifyLookupKeyChanged();
+    }
 
     uint64_t GetLastActivityTimeMs() const { return mLastActivityTimeMs; }
     void SetLastActivityTimeMs(uint64_t value) { mLastActivityTimeMs = value; }
@@ -82,7 +116,9 @@ public:
     Transport::AdminId GetAdminId() const { return mAdmin; }
     void SetAdminId(Transport::AdminId admin) { mAdmin = admin; }
 
-    bool IsInitialized()
+    void SetDelegate(PeerConnectionStateDelegate * delegate) { mDelegate = delegate; }
+
+    bool IsInitialized() const
     {
         return (mPeerAddress.IsInitialized() || mPeerNodeId != kUndefinedNodeId || mPeerKeyID != UINT16_MAX ||
                 mLocalKeyID != UINT16_MAX);
@@ -98,6 +134,7 @@ public:
         mLastActivityTimeMs = 0;
         mSecureSession.Reset();
         mSessionMessageCounter.Reset();
+        NotifyLookupKeyChanged();
     }
 
     CHIP_ERROR EncryptBeforeSend(const uint8_t * input, size_t input_length, uint8_t * output, PacketHeader & header,
@@ -112,9 +149,28 @@ public:
         return mSecureSession.Decrypt(input, input_length, output, header, mac);
     }
 
+    CHIP_ERROR EncryptBeforeSend(System::PacketBufferHandle & msg, PacketHeader & header, MessageAuthenticationCode & mac) const
+    {
+        return mSecureSession.Encrypt(msg, header, mac);
+    }
+
+    CHIP_ERROR DecryptOnReceive(System::PacketBufferHandle & msg, const PacketHeader & header,
+                                const MessageAuthenticationCode & mac) const
+    {
+        return mSecureSession.Decrypt(msg, header, mac);
+    }
+
     SessionMessageCounter & GetSessionMessageCounter() { return mSessionMessageCounter; }
 
 private:
+    void NotifyLookupKeyChanged()
+    {
+        if (mDelegate != nullptr)
+        {
+            mDelegate->OnLookupKeyChanged(*this);
+        }
+    }
+
     PeerAddress mPeerAddress;
     NodeId mPeerNodeId           = kUndefinedNodeId;
     uint16_t mPeerKeyID          = UINT16_MAX;
@@ -123,7 +179,8 @@ private:
     Transport::Base * mTransport = nullptr;
     SecureSession mSecureSession;
     SessionMessageCounter mSessionMessageCounter;
-    Transport::AdminId mAdmin = kUndefinedAdminId;
+    Transport::AdminId mAdmin               = kUndefinedAdminId;
+    PeerConnectionStateDelegate * mDelegate = nullptr;
 };
 
 } // namespace Transport
@@ -30,17 +30,123 @@ namespace Transport {
 // InteractionModel is migrated to messaging layer
 constexpr const uint16_t kAnyKeyId = 0xffff;
 
+/**
+ * Fixed size hash index over the slots of a PeerConnections pool.
+ *
+ * Every indexed slot is linked into exactly one bucket chain. Chains are kept sorted by slot
+ * number, so that candidates are visited in pool order, which is the order the pool lookups
+ * have always returned matches in.
+ *
+ * The index only narrows down candidates: callers must still compare the actual fields of a
+ * returned slot, since distinct keys may share a hash value.
+ */
+template <size_t kSlotCount>
+class PeerConnectionIndex
+{
+public:
+    static_assert(kSlotCount > 0 && kSlotCount < UINT16_MAX, "Slot count must fit in the 16 bit slot links");
+
+    static constexpr uint16_t kInvalidSlot = UINT16_MAX;
+
+    PeerConnectionIndex()
+    {
+        for (size_t i = 0; i < kSlotCount; i++)
+        {
+            mBuckets[i] = kInvalidSlot;
+            mNext[i]    = kInvalidSlot;
+            mHash[i]    = 0;
+            mIndexed[i] = false;
+        }
+    }
+
+    void Insert(uint16_t slot, uint32_t hash)
+    {
+        uint16_t * link = &mBuckets[hash % kSlotCount];
+
+        while (*link != kInvalidSlot && *link < slot)
+        {
+            link = &mNext[*link];
+        }
+
+        mNext[slot]    = *link;
+        *link          = slot;
+        mHash[slot]    = hash;
+        mIndexed[slot] = true;
+    }
+
+    void Remove(uint16_t slot)
+    {
+        if (!mIndexed[slot])
+        {
+            return;
+        }
+
+        uint16_t * link = &mBuckets[mHash[slot] % kSlotCount];
+
+        while (*link != slot)
+        {
+            link = &mNext[*link];
+        }
+
+        *link          = mNext[slot];
+        mNext[slot]    = kInvalidSlot;
+        mIndexed[slot] = false;
+    }
+
+    /// Returns the lowest indexed slot, not below start, that was inserted with the given hash
+    uint16_t Find(uint32_t hash, size_t start) const { return Match(mBuckets[hash % kSlotCount], hash, start); }
+
+    /// Returns the next indexed slot after the given one that was inserted with the given hash
+    uint16_t Next(uint32_t hash, uint16_t slot) const { return Match(mNext[slot], hash, 0); }
+
+private:
+    uint16_t Match(uint16_t slot, uint32_t hash, size_t start) const
+    {
+        while (slot != kInvalidSlot && (slot < start || mHash[slot] != hash))
+        {
+            slot = mNext[slot];
+        }
+        return slot;
+    }
+
+    uint16_t mBuckets[kSlotCount];
+    uint16_t mNext[kSlotCount];
+    uint32_t mHash[kSlotCount];
+    bool mIndexed[kSlotCount];
+};
+
 /**
  * Handles a set of peer connection states.
  *
  * Intended for:
  *   - handle connection active time and expiration
  *   - allocate and free space for connection states.
+ *
+ * Lookups by peer address, peer node id, peer key id and local key id go through hash
+ * indexes rather than scanning the whole pool. The indexes follow changes made directly
+ * on a pooled PeerConnectionState through its setters.
+ *
+ * Allocated states are also kept in least recently active order, so that expiring inactive
+ * connections only visits the connections that are actually expired.
  */
 template <size_t kMaxConnectionCount, Time::Source kTimeSource = Time::Source::kSystem>
-class PeerConnections
+class PeerConnections : public PeerConnectionStateDelegate
 {
 public:
+    PeerConnections()
+    {
+        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        {
+            mInUse[i]   = false;
+            mLruPrev[i] = kInvalidSlot;
+            mLruNext[i] = (i + 1 < kMaxConnectionCount) ? static_cast<uint16_t>(i + 1) : kInvalidSlot;
+        }
+        mFreeHead = 0;
+    }
+
+    PeerConnections(const PeerConnections &) = delete;
+    PeerConnections & operator=(const PeerConnections &) = delete;
+
     /**
      * Allocates a new peer connection state state object out of the internal resource pool.
      *
@@ -55,31 +161,24 @@ public:
     CHECK_RETURN_VALUE
     CHIP_ERROR CreateNewPeerConnectionState(const PeerAddress & address, PeerConnectionState ** state)
     {
-        CHIP_ERROR err = CHIP_ERROR_NO_MEMORY;
+        uint16_t slot = AllocateSlot();
 
         if (state)
         {
             *state = nullptr;
         }
 
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
-        {
-            if (!mStates[i].IsInitialized())
-            {
-                mStates[i] = PeerConnectionState(address);
-                mStates[i].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+        VerifyOrReturnError(slot != kInvalidSlot, CHIP_ERROR_NO_MEMORY);
 
-                if (state)
-                {
-                    *state = &mStates[i];
-                }
+        mStates[slot] = PeerConnectionState(address);
+        ActivateSlot(slot);
 
-                err = CHIP_NO_ERROR;
-                break;
-            }
+        if (state)
+        {
+            *state = &mStates[slot];
         }
 
-        return err;
+        return CHIP_NO_ERROR;
     }
 
     /**
@@ -99,38 +198,32 @@ public:
     CHIP_ERROR CreateNewPeerConnectionState(const Optional<NodeId> & peerNode, uint16_t peerKeyId, uint16_t localKeyId,
                                             PeerConnectionState ** state)
     {
-        CHIP_ERROR err = CHIP_ERROR_NO_MEMORY;
+        uint16_t slot = AllocateSlot();
 
         if (state)
         {
             *state = nullptr;
         }
 
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
-        {
-            if (!mStates[i].IsInitialized())
-            {
-                mStates[i] = PeerConnectionState();
-                mStates[i].SetPeerKeyID(peerKeyId);
-                mStates[i].SetLocalKeyID(localKeyId);
-                mStates[i].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+        VerifyOrReturnError(slot != kInvalidSlot, CHIP_ERROR_NO_MEMORY);
 
-                if (peerNode.ValueOr(kUndefinedNodeId) != kUndefinedNodeId)
-                {
-                    mStates[i].SetPeerNodeId(peerNode.Value());
-                }
+        mStates[slot] = PeerConnectionState();
+        mStates[slot].SetPeerKeyID(peerKeyId);
+        mStates[slot].SetLocalKeyID(localKeyId);
 
-                if (state)
-                {
-                    *state = &mStates[i];
-                }
+        if (peerNode.ValueOr(kUndefinedNodeId) != kUndefinedNodeId)
+        {
+            mStates[slot].SetPeerNodeId(peerNode.Value());
+        }
 
-                err = CHIP_NO_ERROR;
-                break;
-            }
+        ActivateSlot(slot);
+
+        if (state)
+        {
+            *state = &mStates[slot];
         }
 
-        return err;
+        return CHIP_NO_ERROR;
     }
 
     /**
@@ -144,23 +237,17 @@ public:
     CHECK_RETURN_VALUE
     PeerConnectionState * FindPeerConnectionState(const PeerAddress & address, PeerConnectionState * begin)
     {
-        PeerConnectionState * state = nullptr;
-        PeerConnectionState * iter  = &mStates[0];
+        const uint32_t hash = HashPeerAddress(address);
 
-        if (begin >= iter && begin < &mStates[kMaxConnectionCount])
+        for (uint16_t slot = mAddressIndex.Find(hash, SearchStart(begin)); slot != kInvalidSlot;
+             slot          = mAddressIndex.Next(hash, slot))
         {
-            iter = begin + 1;
-        }
-
-        for (; iter < &mStates[kMaxConnectionCount]; iter++)
-        {
-            if (iter->GetPeerAddress() == address)
+            if (mStates[slot].GetPeerAddress() == address)
             {
-                state = iter;
-                break;
+                return &mStates[slot];
             }
         }
-        return state;
+        return nullptr;
     }
 
     /**
@@ -175,27 +262,17 @@ public:
     CHECK_RETURN_VALUE
     PeerConnectionState * FindPeerConnectionState(NodeId nodeId, PeerConnectionState * begin)
     {
-        PeerConnectionState * state = nullptr;
-        PeerConnectionState * iter  = &mStates[0];
-
-        if (begin >= iter && begin < &mStates[kMaxConnectionCount])
-        {
-            iter = begin + 1;
-        }
+        const uint32_t hash = HashNodeId(nodeId);
 
-        for (; iter < &mStates[kMaxConnectionCount]; iter++)
+        for (uint16_t slot = mNodeIdIndex.Find(hash, SearchStart(begin)); slot != kInvalidSlot;
+             slot          = mNodeIdIndex.Next(hash, slot))
         {
-            if (!iter->IsInitialized())
-            {
-                continue;
-            }
-            if (iter->GetPeerNodeId() == nodeId)
+            if (mStates[slot].IsInitialized() && mStates[slot].GetPeerNodeId() == nodeId)
             {
-                state = iter;
-                break;
+                return &mStates[slot];
             }
         }
-        return state;
+        return nullptr;
     }
 
     /**
@@ -211,31 +288,29 @@ public:
     CHECK_RETURN_VALUE
     PeerConnectionState * FindPeerConnectionState(Optional<NodeId> nodeId, uint16_t peerKeyId, PeerConnectionState * begin)
     {
-        PeerConnectionState * state = nullptr;
-        PeerConnectionState * iter  = &mStates[0];
+        const size_t start = SearchStart(begin);
 
-        if (begin >= iter && begin < &mStates[kMaxConnectionCount])
+        if (peerKeyId == kAnyKeyId)
         {
-            iter = begin + 1;
+            // Wildcard lookups cannot use the key index; fall back to walking the pool.
+            for (size_t i = start; i < kMaxConnectionCount; i++)
+            {
+                if (mStates[i].IsInitialized() && MatchesNodeId(mStates[i], nodeId))
+                {
+                    return &mStates[i];
+                }
+            }
+            return nullptr;
         }
 
-        for (; iter < &mStates[kMaxConnectionCount]; iter++)
+        for (uint16_t slot = mPeerKeyIndex.Find(peerKeyId, start); slot != kInvalidSlot; slot = mPeerKeyIndex.Next(peerKeyId, slot))
         {
-            if (!iter->IsInitialized())
+            if (mStates[slot].IsInitialized() && mStates[slot].GetPeerKeyID() == peerKeyId && MatchesNodeId(mStates[slot], nodeId))
             {
-                continue;
-            }
-            if (peerKeyId == kAnyKeyId || iter->GetPeerKeyID() == peerKeyId)
-            {
-                if (nodeId.ValueOr(kUndefinedNodeId) == kUndefinedNodeId || iter->GetPeerNodeId() == kUndefinedNodeId ||
-                    iter->GetPeerNodeId() == nodeId.Value())
-                {
-                    state = iter;
-                    break;
-                }
+                return &mStates[slot];
             }
         }
-        return state;
+        return nullptr;
     }
 
     /**
@@ -249,30 +324,17 @@ public:
     CHECK_RETURN_VALUE
     PeerConnectionState * FindPeerConnectionState(uint16_t keyId, PeerConnectionState * begin)
     {
-        PeerConnectionState * state = nullptr;
-        PeerConnectionState * iter  = &mStates[0];
+        assert(begin == nullptr || (begin >= &mStates[0] && begin < &mStates[kMaxConnectionCount]));
 
-        assert(begin == nullptr || (begin >= iter && begin < &mStates[kMaxConnectionCount]));
-
-        if (begin != nullptr)
+        for (uint16_t slot = mLocalKeyIndex.Find(keyId, SearchStart(begin)); slot != kInvalidSlot;
+             slot          = mLocalKeyIndex.Next(keyId, slot))
         {
-            iter = begin + 1;
-        }
-
-        for (; iter < &mStates[kMaxConnectionCount]; iter++)
-        {
-            if (!iter->IsInitialized())
+            if (mStates[slot].IsInitialized() && mStates[slot].GetLocalKeyID() == keyId)
             {
-                continue;
-            }
-
-            if (iter->GetLocalKeyID() == keyId)
-            {
-                state = iter;
-                break;
+                return &mStates[slot];
             }
         }
-        return state;
+        return nullptr;
     }
 
     /**
@@ -289,43 +351,43 @@ public:
     PeerConnectionState * FindPeerConnectionStateByLocalKey(Optional<NodeId> nodeId, uint16_t localKeyId,
                                                             PeerConnectionState * begin)
     {
-        PeerConnectionState * state = nullptr;
-        PeerConnectionState * iter  = &mStates[0];
-
-        if (begin >= iter && begin < &mStates[kMaxConnectionCount])
+        for (uint16_t slot = mLocalKeyIndex.Find(localKeyId, SearchStart(begin)); slot != kInvalidSlot;
+             slot          = mLocalKeyIndex.Next(localKeyId, slot))
         {
-            iter = begin + 1;
-        }
-
-        for (; iter < &mStates[kMaxConnectionCount]; iter++)
-        {
-            if (!iter->IsInitialized())
+            if (mStates[slot].IsInitialized() && mStates[slot].GetLocalKeyID() == localKeyId &&
+                MatchesNodeId(mStates[slot], nodeId))
             {
-                continue;
-            }
-            if (iter->GetLocalKeyID() == localKeyId)
-            {
-                if (nodeId.ValueOr(kUndefinedNodeId) == kUndefinedNodeId || iter->GetPeerNodeId() == kUndefinedNodeId ||
-                    iter->GetPeerNodeId() == nodeId.Value())
-                {
-                    state = iter;
-                    break;
-                }
+                return &mStates[slot];
             }
         }
-        return state;
+        return nullptr;
     }
 
     /// Convenience method to mark a peer connection state as active
     void MarkConnectionActive(PeerConnectionState * state)
     {
         state->SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+
+        const uint16_t slot = SlotOf(state);
+        if (slot != kInvalidSlot && slot != mLruTail)
+        {
+            LruUnlink(slot);
+            LruAppend(slot);
+        }
     }
 
     /// Convenience method to expired a peer connection state and fired the related callback
     template <typename Callback>
     void MarkConnectionExpired(PeerConnectionState * state, Callback callback)
     {
+        const uint16_t slot = SlotOf(state);
+
+        if (slot != kInvalidSlot)
+        {
+            ExpireSlot(slot, callback);
+            return;
+        }
+
         callback(*state);
         *state = PeerConnectionState(PeerAddress::Uninitialized());
     }
@@ -335,35 +397,207 @@ public:
      * larger than the given amount.
      *
      * Expiring a connection involves callback execution and then clearing the internal state.
+     *
+     * Connections are visited from the least recently active one and the walk stops at the
+     * first connection that has not expired yet.
      */
     template <typename Callback>
     void ExpireInactiveConnections(uint64_t maxIdleTimeMs, Callback callback)
     {
         const uint64_t currentTime = mTimeSource.GetCurrentMonotonicTimeMs();
+        uint16_t slot              = mLruHead;
 
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        while (slot != kInvalidSlot)
         {
-            if (!mStates[i].GetPeerAddress().IsInitialized())
+            uint64_t connectionActiveTime = mStates[slot].GetLastActivityTimeMs();
+            if (connectionActiveTime + maxIdleTimeMs >= currentTime)
             {
-                continue; // not an active connection
+                break; // not expired, and neither is anything more recently active
             }
 
-            uint64_t connectionActiveTime = mStates[i].GetLastActivityTimeMs();
-            if (connectionActiveTime + maxIdleTimeMs >= currentTime)
+            if (!mStates[slot].GetPeerAddress().IsInitialized())
             {
-                continue; // not expired
+                slot = mLruNext[slot];
+                continue; // not an active connection
             }
 
-            MarkConnectionExpired(&mStates[i], callback);
+            slot = ExpireSlot(slot, callback);
         }
     }
 
     /// Allows access to the underlying time source used for keeping track of connection active time
     Time::TimeSource<kTimeSource> & GetTimeSource() { return mTimeSource; }
 
+    // PeerConnectionStateDelegate
+    void OnLookupKeyChanged(PeerConnectionState & state) override
+    {
+        const uint16_t slot = SlotOf(&state);
+
+        if (slot != kInvalidSlot)
+        {
+            Unindex(slot);
+            Index(slot);
+        }
+    }
+
 private:
+    static constexpr uint16_t kInvalidSlot = PeerConnectionIndex<kMaxConnectionCount>::kInvalidSlot;
+
+    static uint32_t HashNodeId(NodeId nodeId) { return static_cast<uint32_t>(nodeId ^ (nodeId >> 32)); }
+
+    static uint32_t HashPeerAddress(const PeerAddress & address)
+    {
+        const Inet::IPAddress & ip = address.GetIPAddress();
+        uint32_t hash              = static_cast<uint32_t>(address.GetTransportType());
+
+        for (uint32_t word : ip.Addr)
+        {
+            hash = (hash * 31) ^ word;
+        }
+        return (hash * 31) ^ address.GetPort();
+    }
+
+    static bool MatchesNodeId(const PeerConnectionState & state, const Optional<NodeId> & nodeId)
+    {
+        return nodeId.ValueOr(kUndefinedNodeId) == kUndefinedNodeId || state.GetPeerNodeId() == kUndefinedNodeId ||
+            state.GetPeerNodeId() == nodeId.Value();
+    }
+
+    /// Returns the pool slot of an allocated state, or kInvalidSlot if state is not an allocated member of the pool
+    uint16_t SlotOf(const PeerConnectionState * state) const
+    {
+        if (state < &mStates[0] || state >= &mStates[kMaxConnectionCount])
+        {
+            return kInvalidSlot;
+        }
+
+        const uint16_t slot = static_cast<uint16_t>(state - &mStates[0]);
+        return mInUse[slot] ? slot : kInvalidSlot;
+    }
+
+    size_t SearchStart(const PeerConnectionState * begin) const
+    {
+        if (begin >= &mStates[0] && begin < &mStates[kMaxConnectionCount])
+        {
+            return static_cast<size_t>(begin - &mStates[0]) + 1;
+        }
+        return 0;
+    }
+
+    uint16_t AllocateSlot()
+    {
+        const uint16_t slot = mFreeHead;
+
+        if (slot != kInvalidSlot)
+        {
+            mFreeHead = mLruNext[slot];
+        }
+        return slot;
+    }
+
+    void ActivateSlot(uint16_t slot)
+    {
+        mInUse[slot] = true;
+        mStates[slot].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+        mStates[slot].SetDelegate(this);
+        Index(slot);
+        LruAppend(slot);
+    }
+
+    /// Runs the expiry callback on an allocated slot and returns the slot to the free list.
+    /// Returns the slot that followed the expired one in activity order.
+    template <typename Callback>
+    uint16_t ExpireSlot(uint16_t slot, Callback callback)
+    {
+        callback(mStates[slot]);
+
+        const uint16_t next = mLruNext[slot];
+
+        Unindex(slot);
+        LruUnlink(slot);
+        mInUse[slot]  = false;
+        mStates[slot] = PeerConnectionState(PeerAddress::Uninitialized());
+
+        mLruNext[slot] = mFreeHead;
+        mFreeHead      = slot;
+
+        return next;
+    }
+
+    void Index(uint16_t slot)
+    {
+        const PeerConnectionState & state = mStates[slot];
+
+        mAddressIndex.Insert(slot, HashPeerAddress(state.GetPeerAddress()));
+        mNodeIdIndex.Insert(slot, HashNodeId(state.GetPeerNodeId()));
+        mPeerKeyIndex.Insert(slot, state.GetPeerKeyID());
+        mLocalKeyIndex.Insert(slot, state.GetLocalKeyID());
+    }
+
+    void Unindex(uint16_t slot)
+    {
+        mAddressIndex.Remove(slot);
+        mNodeIdIndex.Remove(slot);
+        mPeerKeyIndex.Remove(slot);
+        mLocalKeyIndex.Remove(slot);
+    }
+
+    void LruAppend(uint16_t slot)
+    {
+        mLruPrev[slot] = mLruTail;
+        mLruNext[slot] = kInvalidSlot;
+
+        if (mLruTail != kInvalidSlot)
+        {
+            mLruNext[mLruTail] = slot;
+        }
+        else
+        {
+            mLruHead = slot;
+        }
+        mLruTail = slot;
+    }
+
+    void LruUnlink(uint16_t slot)
+    {
+        if (mLruPrev[slot] != kInvalidSlot)
+        {
+            mLruNext[mLruPrev[slot]] = mLruNext[slot];
+        }
+        else
+        {
+            mLruHead = mLruNext[slot];
+        }
+
+        if (mLruNext[slot] != kInvalidSlot)
+        {
+            mLruPrev[mLruNext[slot]] = mLruPrev[slot];
+        }
+        else
+        {
+            mLruTail = mLruPrev[slot];
+        }
+
+        mLruPrev[slot] = kInvalidSlot;
+        mLruNext[slot] = kInvalidSlot;
+    }
+
     Time::TimeSource<kTimeSource> mTimeSource;
     PeerConnectionState mStates[kMaxConnectionCount];
+
+    PeerConnectionIndex<kMaxConnectionCount> mAddressIndex;
+    PeerConnectionIndex<kMaxConnectionCount> mNodeIdIndex;
+    PeerConnectionIndex<kMaxConnectionCount> mPeerKeyIndex;
+    PeerConnectionIndex<kMaxConnectionCount> mLocalKeyIndex;
+
+    // Allocated slots form a doubly linked list ordered by last activity time (head is the least
+    // recently active). Free slots are chained through mLruNext starting at mFreeHead.
+    bool mInUse[kMaxConnectionCount];
+    uint16_t mLruPrev[kMaxConnectionCount];
+    uint16_t mLruNext[kMaxConnectionCount];
+    uint16_t mLruHead  = kInvalidSlot;
+    uint16_t mLruTail  = kInvalidSlot;
+    uint16_t mFreeHead = kInvalidSlot;
 };
 
 } // namespace Transport
@@ -22,13 +22,97 @@
 #pragma once
 
 #include <array>
-#include <bitset>
+#include <new>
+#include <stdint.h>
+#include <string.h>
 
 #include <support/Span.h>
 
 namespace chip {
 namespace Transport {
 
+/**
+ * @brief
+ *   Replay window of the last kWindowSize message counters received from a peer.
+ *
+ *   Counters are tracked in a ring of 64-bit words indexed by counter value, so the window does not shift when the max
+ *   counter advances: only the words entered since the previous max counter are cleared. Advancing costs at most one word per
+ *   64 counters skipped and is capped at the ring size, checking a counter costs a single bit test. One spare word keeps the
+ *   whole window valid while the word of the max counter is only partially used.
+ */
+template <size_t kWindowSize>
+class MessageCounterWindow
+{
+public:
+    static_assert(kWindowSize > 0, "The message counter window can not be empty");
+
+    /**
+     * Forget all received counters and accept any counter in the window behind maxCounter, including maxCounter itself.
+     */
+    void Reset(uint32_t maxCounter)
+    {
+        mMaxCounter = maxCounter;
+        memset(mWords, 0, sizeof(mWords));
+    }
+
+    uint32_t GetMaxCounter() const { return mMaxCounter; }
+
+    /**
+     * Whether counter may be accepted: it is either ahead of the max counter, or inside the window and not received yet.
+     */
+    bool IsValid(uint32_t counter) const
+    {
+        if (counter > mMaxCounter)
+        {
+            return true;
+        }
+        if (mMaxCounter - counter >= kWindowSize)
+        {
+            return false; // outside valid range
+        }
+        return (mWords[WordIndex(counter)] & BitMask(counter)) == 0;
+    }
+
+    /**
+     * Mark counter as received, advancing the window if counter is ahead of the max counter. Counters that are too old are
+     * ignored.
+     *
+     * @pre IsValid(counter)
+     */
+    void Mark(uint32_t counter)
+    {
+        if (counter <= mMaxCounter && mMaxCounter - counter >= kWindowSize)
+        {
+            return;
+        }
+
+        if (counter > mMaxCounter)
+        {
+            // Words wrapping around from the past must be cleared before they are reused for future counters.
+            const uint32_t maxWord      = mMaxCounter / kBitsPerWord;
+            const uint32_t wordsAhead   = counter / kBitsPerWord - maxWord;
+            const uint32_t wordsToClear = (wordsAhead < kWordCount) ? wordsAhead : static_cast<uint32_t>(kWordCount);
+            for (uint32_t i = 1; i <= wordsToClear; i++)
+            {
+                mWords[(maxWord + i) % kWordCount] = 0;
+            }
+            mMaxCounter = counter;
+        }
+
+        mWords[WordIndex(counter)] |= BitMask(counter);
+    }
+
+private:
+    static constexpr uint32_t kBitsPerWord = 64;
+    static constexpr size_t kWordCount     = (kWindowSize + kBitsPerWord - 1) / kBitsPerWord + 1;
+
+    static size_t WordIndex(uint32_t counter) { return (counter / kBitsPerWord) % kWordCount; }
+    static uint64_t BitMask(uint32_t counter) { return static_cast<uint64_t>(1) << (counter % kBitsPerWord); }
+
+    uint32_t mMaxCounter = 0; // The most recent counter we have seen
+    uint64_t mWords[kWordCount];
+};
+
 class PeerMessageCounter
 {
 public:
@@ -80,8 +164,7 @@ public:
         mSyncInProcess.~SyncInProcess();
         mStatus = Status::Synced;
         new (&mSynced) Synced();
-        mSynced.mMaxCounter = counter;
-        mSynced.mWindow.reset(); // reset all bits, accept all packets in the window
+        mSynced.mWindow.Reset(counter); // accept all packets in the window
         return CHIP_NO_ERROR;
     }
 
@@ -92,20 +175,8 @@ public:
             return CHIP_ERROR_INCORRECT_STATE;
         }
 
-        if (counter <= mSynced.mMaxCounter)
-        {
-            uint32_t offset = mSynced.mMaxCounter - counter;
-            if (offset >= CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE)
-            {
-                return CHIP_ERROR_INVALID_ARGUMENT; // outside valid range
-            }
-            if (mSynced.mWindow.test(offset))
-            {
-                return CHIP_ERROR_INVALID_ARGUMENT; // duplicated, in window
-            }
-        }
-
-        return CHIP_NO_ERROR;
+        // Either too old, or duplicated in the window
+        return mSynced.mWindow.IsValid(counter) ? CHIP_NO_ERROR : CHIP_ERROR_INVALID_ARGUMENT;
     }
 
     /**
@@ -115,41 +186,18 @@ public:
      *
      * @pre Verify(counter) == CHIP_NO_ERROR
      */
-    void Commit(uint32_t counter)
-    {
-        if (counter <= mSynced.mMaxCounter)
-        {
-            uint32_t offset = mSynced.mMaxCounter - counter;
-            mSynced.mWindow.set(offset);
-        }
-        else
-        {
-            uint32_t offset = counter - mSynced.mMaxCounter;
-            // advance max counter by `offset`
-            mSynced.mMaxCounter = counter;
-            if (offset < CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE)
-            {
-                mSynced.mWindow <<= offset;
-            }
-            else
-            {
-                mSynced.mWindow.reset();
-            }
-            mSynced.mWindow.set(0);
-        }
-    }
+    void Commit(uint32_t counter) { mSynced.mWindow.Mark(counter); }
 
     void SetCounter(uint32_t value)
     {
         Reset();
         mStatus = Status::Synced;
         new (&mSynced) Synced();
-        mSynced.mMaxCounter = value;
-        mSynced.mWindow.reset();
+        mSynced.mWindow.Reset(value);
     }
 
     /* Test-only */
-    uint32_t GetCounter() { return mSynced.mMaxCounter; }
+    uint32_t GetCounter() { return mSynced.mWindow.GetMaxCounter(); }
 
 private:
     enum class Status
@@ -174,8 +222,7 @@ private:
          *  | <-- mWindow -->|
          *  |[n]|  ...   |[0]|
          */
-        uint32_t mMaxCounter; // The most recent counter we have seen
-        std::bitset<CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE> mWindow;
+        MessageCounterWindow<CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE> mWindow;
     };
 
     // We should use std::variant here when migrated to C++17
@@ -29,6 +29,8 @@
 #include <support/SafeInt.h>
 #include <transport/SecureMessageCodec.h>
 
+#include <string.h>
+
 namespace chip {
 
 using System::PacketBuffer;
@@ -36,11 +38,34 @@ using System::PacketBufferHandle;
 
 namespace SecureMessageCodec {
 
+namespace {
+
+/**
+ * Move the last footerLen bytes of a buffer chain into footer, which may span buffers.
+ */
+void RemoveFooter(PacketBufferHandle & msg, uint8_t * footer, uint16_t footerLen)
+{
+    uint16_t remaining = static_cast<uint16_t>(msg->TotalLength() - footerLen);
+
+    for (PacketBufferHandle buf = msg.Retain(); !buf.IsNull(); buf = buf->Next())
+    {
+        uint16_t dataLen = buf->DataLength();
+        uint16_t keepLen = (dataLen < remaining) ? dataLen : remaining;
+
+        memcpy(footer, buf->Start() + keepLen, static_cast<size_t>(dataLen - keepLen));
+        footer += dataLen - keepLen;
+
+        buf->SetDataLength(keepLen, msg);
+        remaining = static_cast<uint16_t>(remaining - keepLen);
+    }
+}
+
+} // namespace
+
 CHIP_ERROR Encode(NodeId localNodeId, Transport::PeerConnectionState * state, PayloadHeader & payloadHeader,
                   PacketHeader & packetHeader, System::PacketBufferHandle & msgBuf, MessageCounter & counter)
 {
     VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrReturnError(!msgBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
     VerifyOrReturnError(msgBuf->TotalLength() <= kMaxAppMessageLen, CHIP_ERROR_MESSAGE_TOO_LONG);
 
     uint32_t msgId = counter.Value();
@@ -62,17 +87,27 @@ CHIP_ERROR Encode(NodeId localNodeId, Transport::PeerConnectionState * state, Pa
 
     ReturnErrorOnFailure(payloadHeader.EncodeBeforeData(msgBuf));
 
-    uint8_t * data    = msgBuf->Start();
     uint16_t totalLen = msgBuf->TotalLength();
 
+    // The message is encrypted in place, one buffer of the chain at a time.
     MessageAuthenticationCode mac;
-    ReturnErrorOnFailure(state->EncryptBeforeSend(data, totalLen, data, packetHeader, mac));
+    ReturnErrorOnFailure(state->EncryptBeforeSend(msgBuf, packetHeader, mac));
 
-    uint16_t taglen = 0;
-    ReturnErrorOnFailure(mac.Encode(packetHeader, &data[totalLen], msgBuf->AvailableDataLength(), &taglen));
+    // The tag goes after the payload, in a buffer of its own if the last one is full.
+    uint16_t taglen         = MessageAuthenticationCode::TagLenForEncryptionType(packetHeader.GetEncryptionType());
+    PacketBufferHandle tail = msgBuf->Last();
+    if (tail->AvailableDataLength() < taglen)
+    {
+        PacketBufferHandle tagBuf = PacketBufferHandle::New(taglen, 0);
+        VerifyOrReturnError(!tagBuf.IsNull(), CHIP_ERROR_NO_MEMORY);
+        tail = tagBuf.Retain();
+        msgBuf->AddToEnd(std::move(tagBuf));
+    }
+
+    ReturnErrorOnFailure(mac.Encode(packetHeader, tail->Start() + tail->DataLength(), tail->AvailableDataLength(), &taglen));
 
     VerifyOrReturnError(CanCastTo<uint16_t>(totalLen + taglen), CHIP_ERROR_INTERNAL);
-    msgBuf->SetDataLength(static_cast<uint16_t>(totalLen + taglen));
+    tail->SetDataLength(static_cast<uint16_t>(tail->DataLength() + taglen), msgBuf);
 
     ChipLogDetail(Inet, "Secure message was encrypted: Msg ID %u", msgId);
 
@@ -85,32 +120,31 @@ CHIP_ERROR Decode(Transport::PeerConnectionState * state, PayloadHeader & payloa
 {
     ReturnErrorCodeIf(msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
 
-    uint8_t * data = msg->Start();
-    uint16_t len   = msg->DataLength();
+    uint16_t len = msg->TotalLength();
 
-    PacketBufferHandle origMsg;
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     /* This is a workaround for the case where PacketBuffer payload is not
         allocated as an inline buffer to PacketBuffer structure */
-    origMsg = std::move(msg);
-    msg     = PacketBufferHandle::New(len);
+    PacketBufferHandle origMsg = std::move(msg);
+    msg                        = PacketBufferHandle::New(len);
     VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_NO_MEMORY);
+    ReturnErrorOnFailure(origMsg->Read(msg->Start(), len));
     msg->SetDataLength(len);
 #endif
 
     uint16_t footerLen = MessageAuthenticationCode::TagLenForEncryptionType(packetHeader.GetEncryptionType());
-    VerifyOrReturnError(footerLen <= len, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    VerifyOrReturnError(footerLen <= len && footerLen <= kMaxTagLen, CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    uint8_t footer[kMaxTagLen];
+    RemoveFooter(msg, footer, footerLen);
 
     uint16_t taglen = 0;
     MessageAuthenticationCode mac;
-    ReturnErrorOnFailure(mac.Decode(packetHeader, &data[len - footerLen], footerLen, &taglen));
+    ReturnErrorOnFailure(mac.Decode(packetHeader, footer, footerLen, &taglen));
     VerifyOrReturnError(taglen == footerLen, CHIP_ERROR_INTERNAL);
 
-    len = static_cast<uint16_t>(len - taglen);
-    msg->SetDataLength(len);
-
-    uint8_t * plainText = msg->Start();
-    ReturnErrorOnFailure(state->DecryptOnReceive(data, len, plainText, packetHeader, mac));
+    // The message is decrypted in place, one buffer of the chain at a time.
+    ReturnErrorOnFailure(state->DecryptOnReceive(msg, packetHeader, mac));
 
     ReturnErrorOnFailure(payloadHeader.DecodeAndConsume(msg));
     return CHIP_NO_ERROR;
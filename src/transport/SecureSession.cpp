@@ -56,6 +56,29 @@ using HKDF_sha_crypto = HKDF_sha;
 
 SecureSession::SecureSession() : mKeyAvailable(false) {}
 
+SecureSession::SecureSession(const SecureSession & other) : mKeyAvailable(false)
+{
+    *this = other;
+}
+
+SecureSession & SecureSession::operator=(const SecureSession & other)
+{
+    if (this != &other)
+    {
+        mSessionRole  = other.mSessionRole;
+        mKeyAvailable = other.mKeyAvailable;
+        memcpy(mKeys, other.mKeys, sizeof(mKeys));
+
+        // The ciphers own their expanded keys, they are set up again from mKeys when next used.
+        for (AES_CCM_stream & cipher : mCiphers)
+        {
+            cipher.Clear();
+        }
+    }
+
+    return *this;
+}
+
 CHIP_ERROR SecureSession::InitFromSecret(const ByteSpan & secret, const ByteSpan & salt, SessionInfoType infoType, SessionRole role)
 {
     HKDF_sha_crypto mHKDF;
@@ -98,6 +121,24 @@ void SecureSession::Reset()
 {
     mKeyAvailable = false;
     memset(mKeys, 0, sizeof(mKeys));
+
+    for (AES_CCM_stream & cipher : mCiphers)
+    {
+        cipher.Clear();
+    }
+}
+
+CHIP_ERROR SecureSession::GetCipher(KeyUsage usage, AES_CCM_stream *& cipher) const
+{
+    VerifyOrReturnError(usage < KeyUsage::kAttestationChallengeKey, CHIP_ERROR_INVALID_ARGUMENT);
+
+    cipher = &mCiphers[usage];
+    if (!cipher->HasKey())
+    {
+        ReturnErrorOnFailure(cipher->SetKey(mKeys[usage], kAES_CCM128_Key_Length));
+    }
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR SecureSession::GetIV(const PacketHeader & header, uint8_t * iv, size_t len)
@@ -161,8 +202,11 @@ CHIP_ERROR SecureSession::Encrypt(const uint8_t * input, size_t input_length, ui
         usage = kI2RKey;
     }
 
-    ReturnErrorOnFailure(AES_CCM_encrypt(input, input_length, AAD, aadLen, mKeys[usage], kAES_CCM128_Key_Length, IV, sizeof(IV),
-                                         output, tag, taglen));
+    AES_CCM_stream * cipher;
+    ReturnErrorOnFailure(GetCipher(usage, cipher));
+    ReturnErrorOnFailure(cipher->BeginEncrypt(IV, sizeof(IV), AAD, aadLen, input_length, taglen));
+    ReturnErrorOnFailure(cipher->Update(input, input_length, output));
+    ReturnErrorOnFailure(cipher->FinishEncrypt(tag, taglen));
 
     mac.SetTag(&header, encType, tag, taglen);
 
@@ -196,8 +240,91 @@ CHIP_ERROR SecureSession::Decrypt(const uint8_t * input, size_t input_length, ui
         usage = kR2IKey;
     }
 
-    return AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mKeys[usage], kAES_CCM128_Key_Length, IV, sizeof(IV),
-                           output);
+    AES_CCM_stream * cipher;
+    ReturnErrorOnFailure(GetCipher(usage, cipher));
+    ReturnErrorOnFailure(cipher->BeginDecrypt(IV, sizeof(IV), AAD, aadLen, input_length, tag, taglen));
+    ReturnErrorOnFailure(cipher->Update(input, input_length, output));
+
+    return cipher->FinishDecrypt();
+}
+
+CHIP_ERROR SecureSession::Encrypt(System::PacketBufferHandle & msg, PacketHeader & header, MessageAuthenticationCode & mac) const
+{
+    constexpr Header::EncryptionType encType = Header::EncryptionType::kAESCCMTagLen16;
+
+    const size_t taglen = MessageAuthenticationCode::TagLenForEncryptionType(encType);
+    assert(taglen <= kMaxTagLen);
+
+    VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(msg->TotalLength() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t AAD[kMaxAADLen];
+    uint8_t IV[kAESCCMIVLen];
+    uint16_t aadLen = sizeof(AAD);
+    uint8_t tag[kMaxTagLen];
+
+    ReturnErrorOnFailure(GetIV(header, IV, sizeof(IV)));
+    ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+
+    KeyUsage usage = kR2IKey;
+
+    // See the comment in the contiguous overload of Encrypt() for the choice of key.
+    if (mSessionRole == SessionRole::kInitiator)
+    {
+        usage = kI2RKey;
+    }
+
+    AES_CCM_stream * cipher;
+    ReturnErrorOnFailure(GetCipher(usage, cipher));
+    ReturnErrorOnFailure(cipher->BeginEncrypt(IV, sizeof(IV), AAD, aadLen, msg->TotalLength(), taglen));
+
+    for (System::PacketBufferHandle buf = msg.Retain(); !buf.IsNull(); buf = buf->Next())
+    {
+        ReturnErrorOnFailure(cipher->Update(buf->Start(), buf->DataLength(), buf->Start()));
+    }
+
+    ReturnErrorOnFailure(cipher->FinishEncrypt(tag, taglen));
+
+    mac.SetTag(&header, encType, tag, taglen);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SecureSession::Decrypt(System::PacketBufferHandle & msg, const PacketHeader & header,
+                                  const MessageAuthenticationCode & mac) const
+{
+    const size_t taglen = MessageAuthenticationCode::TagLenForEncryptionType(header.GetEncryptionType());
+    const uint8_t * tag = mac.GetTag();
+    uint8_t IV[kAESCCMIVLen];
+    uint8_t AAD[kMaxAADLen];
+    uint16_t aadLen = sizeof(AAD);
+
+    VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    VerifyOrReturnError(!msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(msg->TotalLength() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    ReturnErrorOnFailure(GetIV(header, IV, sizeof(IV)));
+    ReturnErrorOnFailure(GetAdditionalAuthData(header, AAD, aadLen));
+
+    KeyUsage usage = kI2RKey;
+
+    // See the comment in the contiguous overload of Decrypt() for the choice of key.
+    if (mSessionRole == SessionRole::kInitiator)
+    {
+        usage = kR2IKey;
+    }
+
+    AES_CCM_stream * cipher;
+    ReturnErrorOnFailure(GetCipher(usage, cipher));
+    ReturnErrorOnFailure(cipher->BeginDecrypt(IV, sizeof(IV), AAD, aadLen, msg->TotalLength(), tag, taglen));
+
+    for (System::PacketBufferHandle buf = msg.Retain(); !buf.IsNull(); buf = buf->Next())
+    {
+        ReturnErrorOnFailure(cipher->Update(buf->Start(), buf->DataLength(), buf->Start()));
+    }
+
+    return cipher->FinishDecrypt();
 }
 
 } // namespace chip
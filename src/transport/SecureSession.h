@@ -28,6 +28,7 @@
 #include <core/CHIPCore.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <support/Span.h>
+#include <system/SystemPacketBuffer.h>
 #include <transport/raw/MessageHeader.h>
 
 namespace chip {
@@ -36,10 +37,8 @@ class DLL_EXPORT SecureSession
 {
 public:
     SecureSession();
-    SecureSession(SecureSession &&)      = default;
-    SecureSession(const SecureSession &) = default;
-    SecureSession & operator=(const SecureSession &) = default;
-    SecureSession & operator=(SecureSession &&) = default;
+    SecureSession(const SecureSession & other);
+    SecureSession & operator=(const SecureSession & other);
 
     /**
      *    Whether the current node initiated the session, or it is responded to a session request.
@@ -113,6 +112,31 @@ public:
     CHIP_ERROR Decrypt(const uint8_t * input, size_t input_length, uint8_t * output, const PacketHeader & header,
                        const MessageAuthenticationCode & mac) const;
 
+    /**
+     * @brief
+     *   Encrypt a message in place using keys established in the secure channel.
+     *   The message may be a chain of buffers, it is neither copied nor compacted.
+     *
+     * @param msg Unencrypted message, replaced by the encrypted message
+     * @param header message header structure. Encryption type will be set on the header.
+     * @param mac - output the resulting mac
+     *
+     * @return CHIP_ERROR The result of encryption
+     */
+    CHIP_ERROR Encrypt(System::PacketBufferHandle & msg, PacketHeader & header, MessageAuthenticationCode & mac) const;
+
+    /**
+     * @brief
+     *   Decrypt a message in place using keys established in the secure channel.
+     *   The message may be a chain of buffers. Its contents must be discarded if decryption fails.
+     *
+     * @param msg Encrypted message, without the mac, replaced by the decrypted message
+     * @param header message header structure
+     * @param mac Input mac
+     * @return CHIP_ERROR The result of decryption
+     */
+    CHIP_ERROR Decrypt(System::PacketBufferHandle & msg, const PacketHeader & header, const MessageAuthenticationCode & mac) const;
+
     /**
      * @brief
      *   Memory overhead of encrypting data. The overhead is independent of size of
@@ -145,6 +169,12 @@ private:
     bool mKeyAvailable;
     CryptoKey mKeys[KeyUsage::kNumCryptoKeys];
 
+    // Ciphers for the I2R and R2I keys. The key schedule is expanded on first use and then reused for
+    // every message of the session. Copies of the session start without it and expand their own.
+    mutable Crypto::AES_CCM_stream mCiphers[KeyUsage::kAttestationChallengeKey];
+
+    CHIP_ERROR GetCipher(KeyUsage usage, Crypto::AES_CCM_stream *& cipher) const;
+
     static CHIP_ERROR GetIV(const PacketHeader & header, uint8_t * iv, size_t len);
 
     // Use unencrypted header as additional authenticated data (AAD) during encryption and decryption.
@@ -30,7 +30,10 @@
 #include <support/logging/CHIPLogging.h>
 #include <transport/raw/MessageHeader.h>
 
+#include <algorithm>
 #include <inttypes.h>
+#include <limits>
+#include <string.h>
 
 namespace chip {
 namespace Transport {
@@ -46,6 +49,17 @@ constexpr uint16_t kMaxMessageSize = static_cast<uint16_t>(System::PacketBuffer:
 
 constexpr int kListenBacklogSize = 2;
 
+// Finalizer of MurmurHash3, so that every bit of the key affects the low bits the connection indexes are addressed by.
+uint32_t MixHash(uint32_t hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
 } // namespace
 
 TCPBase::~TCPBase()
@@ -71,8 +85,7 @@ void TCPBase::CloseActiveConnections()
     {
         if (mActiveConnections[i].InUse())
         {
-            mActiveConnections[i].Free();
-            mUsedEndPointCount--;
+            ReleaseConnection(&mActiveConnections[i]);
         }
     }
 }
@@ -130,6 +143,22 @@ void TCPBase::Close()
     mState = State::kNotReady;
 }
 
+uint32_t TCPBase::PeerHash(const PeerAddress & address)
+{
+    uint32_t hash = address.GetPort();
+    for (uint32_t word : address.GetIPAddress().Addr)
+    {
+        hash = MixHash(hash ^ word);
+    }
+    return hash;
+}
+
+uint32_t TCPBase::EndPointHash(const Inet::TCPEndPoint * endPoint)
+{
+    uint64_t value = reinterpret_cast<uintptr_t>(endPoint);
+    return MixHash(static_cast<uint32_t>(value ^ (value >> 32)));
+}
+
 TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress & address)
 {
     if (address.GetTransportType() != Type::kTcp)
@@ -137,37 +166,153 @@ TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress
         return nullptr;
     }
 
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    const uint32_t hash = PeerHash(address);
+    for (size_t i = hash & (mIndexSize - 1); mPeerIndex[i].mConnection != nullptr; i = (i + 1) & (mIndexSize - 1))
     {
-        if (!mActiveConnections[i].InUse())
+        ActiveConnectionState * connection = mPeerIndex[i].mConnection;
+        if ((mPeerIndex[i].mHash == hash) && (connection->mPeerAddress.GetIPAddress() == address.GetIPAddress()) &&
+            (connection->mPeerAddress.GetPort() == address.GetPort()))
         {
-            continue;
+            return connection;
         }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
+    }
+
+    return nullptr;
+}
+
+TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const Inet::TCPEndPoint * endPoint)
+{
+    if (endPoint == nullptr)
+    {
+        return nullptr;
+    }
 
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
+    const uint32_t hash = EndPointHash(endPoint);
+    for (size_t i = hash & (mIndexSize - 1); mEndPointIndex[i].mConnection != nullptr; i = (i + 1) & (mIndexSize - 1))
+    {
+        if (mEndPointIndex[i].mConnection->mEndPoint == endPoint)
         {
-            return &mActiveConnections[i];
+            return mEndPointIndex[i].mConnection;
         }
     }
 
     return nullptr;
 }
 
-TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const Inet::TCPEndPoint * endPoint)
+TCPBase::ActiveConnectionState * TCPBase::AddConnection(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
+                                                        bool connecting)
 {
+    if (mUsedEndPointCount >= mActiveConnectionsSize)
+    {
+        return nullptr;
+    }
+
     for (size_t i = 0; i < mActiveConnectionsSize; i++)
     {
-        if (mActiveConnections[i].mEndPoint == endPoint)
+        ActiveConnectionState * connection = &mActiveConnections[i];
+        if (!connection->InUse())
         {
-            return &mActiveConnections[i];
+            connection->Init(endPoint, PeerAddress::TCP(peerAddress.GetIPAddress(), peerAddress.GetPort()), connecting);
+            AddToIndex(mPeerIndex, PeerHash(connection->mPeerAddress), connection);
+            AddToIndex(mEndPointIndex, EndPointHash(endPoint), connection);
+            mUsedEndPointCount++;
+            return connection;
         }
     }
+
     return nullptr;
 }
 
+void TCPBase::ReleaseConnection(ActiveConnectionState * connection)
+{
+    while (connection->mPendingHead != nullptr)
+    {
+        DequeuePendingPacket(connection);
+    }
+
+    RemoveFromIndex(mPeerIndex, PeerHash(connection->mPeerAddress), connection);
+    RemoveFromIndex(mEndPointIndex, EndPointHash(connection->mEndPoint), connection);
+    connection->Free();
+    mUsedEndPointCount--;
+}
+
+void TCPBase::AddToIndex(ConnectionIndexEntry * index, uint32_t hash, ActiveConnectionState * connection)
+{
+    // The index has more entries than there are connections, so there always is a free one.
+    size_t i = hash & (mIndexSize - 1);
+    while (index[i].mConnection != nullptr)
+    {
+        i = (i + 1) & (mIndexSize - 1);
+    }
+
+    index[i].mHash       = hash;
+    index[i].mConnection = connection;
+}
+
+void TCPBase::RemoveFromIndex(ConnectionIndexEntry * index, uint32_t hash, ActiveConnectionState * connection)
+{
+    const size_t mask = mIndexSize - 1;
+    size_t i          = hash & mask;
+
+    while (index[i].mConnection != connection)
+    {
+        VerifyOrReturn(index[i].mConnection != nullptr);
+        i = (i + 1) & mask;
+    }
+
+    // Move back the entries probed past the freed one, rather than leaving a tombstone, so that lookups stop at the first
+    // free entry. An entry may only move to a position that is on its probe sequence, from its hash on.
+    for (size_t next = (i + 1) & mask; index[next].mConnection != nullptr; next = (next + 1) & mask)
+    {
+        if (((next - index[next].mHash) & mask) >= ((next - i) & mask))
+        {
+            index[i] = index[next];
+            i        = next;
+        }
+    }
+
+    index[i].mConnection = nullptr;
+}
+
+CHIP_ERROR TCPBase::EnqueuePendingPacket(ActiveConnectionState * connection, System::PacketBufferHandle && msg)
+{
+    PendingPacket * packet = mFreePendingPackets;
+    VerifyOrReturnError(packet != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    mFreePendingPackets  = packet->next;
+    packet->next         = nullptr;
+    packet->packetBuffer = std::move(msg);
+
+    if (connection->mPendingTail != nullptr)
+    {
+        connection->mPendingTail->next = packet;
+    }
+    else
+    {
+        connection->mPendingHead = packet;
+    }
+    connection->mPendingTail = packet;
+
+    return CHIP_NO_ERROR;
+}
+
+System::PacketBufferHandle TCPBase::DequeuePendingPacket(ActiveConnectionState * connection)
+{
+    PendingPacket * packet            = connection->mPendingHead;
+    System::PacketBufferHandle buffer = std::move(packet->packetBuffer);
+
+    connection->mPendingHead = packet->next;
+    if (connection->mPendingHead == nullptr)
+    {
+        connection->mPendingTail = nullptr;
+    }
+
+    packet->next        = mFreePendingPackets;
+    mFreePendingPackets = packet;
+
+    return buffer;
+}
+
 CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf)
 {
     // Sent buffer data format is:
@@ -176,24 +321,32 @@ CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::
 
     VerifyOrReturnError(address.GetTransportType() == Type::kTcp, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(mState == State::kInitialized, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(kPacketSizeBytes + msgBuf->DataLength() <= std::numeric_limits<uint16_t>::max(),
+    VerifyOrReturnError(kPacketSizeBytes + msgBuf->TotalLength() <= std::numeric_limits<uint16_t>::max(),
                         CHIP_ERROR_INVALID_ARGUMENT);
 
-    // The check above about kPacketSizeBytes + msgBuf->DataLength() means it definitely fits in uint16_t.
+    // The check above about kPacketSizeBytes + msgBuf->TotalLength() means it definitely fits in uint16_t.
     VerifyOrReturnError(msgBuf->EnsureReservedSize(static_cast<uint16_t>(kPacketSizeBytes)), CHIP_ERROR_NO_MEMORY);
 
     msgBuf->SetStart(msgBuf->Start() - kPacketSizeBytes);
 
     uint8_t * output = msgBuf->Start();
-    LittleEndian::Write16(output, static_cast<uint16_t>(msgBuf->DataLength() - kPacketSizeBytes));
+    LittleEndian::Write16(output, static_cast<uint16_t>(msgBuf->TotalLength() - kPacketSizeBytes));
 
     // Reuse existing connection if one exists, otherwise a new one
     // will be established
     ActiveConnectionState * connection = FindActiveConnection(address);
 
-    if (connection != nullptr)
+    if ((connection != nullptr) && !connection->mConnecting)
     {
-        return connection->mEndPoint->Send(std::move(msgBuf));
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+        // Coalesce the frames of a burst in the send queue of the connection, which the endpoint writes out in one
+        // scatter-gather send once the event loop finds the socket writable; only a full budget is written out right away.
+        bool push = (connection->mEndPoint->PendingSendLength() + msgBuf->TotalLength() >= CHIP_CONFIG_TCP_COALESCE_BYTES);
+#else
+        // Other endpoints only send from their queue when pushed, or once earlier data is acknowledged.
+        bool push = true;
+#endif
+        return connection->mEndPoint->Send(std::move(msgBuf), push);
     }
     else
     {
@@ -204,43 +357,17 @@ CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::
 CHIP_ERROR TCPBase::SendAfterConnect(const PeerAddress & addr, System::PacketBufferHandle && msg)
 {
     // This will initiate a connection to the specified peer
-    CHIP_ERROR err               = CHIP_NO_ERROR;
-    PendingPacket * packet       = nullptr;
-    bool alreadyConnecting       = false;
-    Inet::TCPEndPoint * endPoint = nullptr;
-
-    // Iterate through the ENTIRE array. If a pending packet for
-    // the address already exists, this means a connection is pending and
-    // does NOT need to be re-established.
-    for (size_t i = 0; i < mPendingPacketsSize; i++)
-    {
-        if (mPendingPackets[i].packetBuffer.IsNull())
-        {
-            if (packet == nullptr)
-            {
-                // found a slot to store the packet into
-                packet = mPendingPackets + i;
-            }
-        }
-        else if (mPendingPackets[i].peerAddress == addr)
-        {
-            // same destination exists.
-            alreadyConnecting = true;
+    CHIP_ERROR err                     = CHIP_NO_ERROR;
+    ActiveConnectionState * connection = FindActiveConnection(addr);
+    Inet::TCPEndPoint * endPoint       = nullptr;
 
-            // ensure packets are ORDERED
-            if (packet != nullptr)
-            {
-                packet->peerAddress  = addr;
-                packet->packetBuffer = std::move(mPendingPackets[i].packetBuffer);
-                packet               = mPendingPackets + i;
-            }
-        }
+    // If already connecting, the packet is queued behind the ones sent before, and does NOT need a new connection.
+    if (connection != nullptr)
+    {
+        return EnqueuePendingPacket(connection, std::move(msg));
     }
 
-    VerifyOrExit(packet != nullptr, err = CHIP_ERROR_NO_MEMORY);
-
-    // If already connecting, buffer was just enqueued for more sending
-    VerifyOrExit(!alreadyConnecting, err = CHIP_NO_ERROR);
+    VerifyOrExit(mFreePendingPackets != nullptr, err = CHIP_ERROR_NO_MEMORY);
 
     // Ensures sufficient active connections size exist
     VerifyOrExit(mUsedEndPointCount < mActiveConnectionsSize, err = CHIP_ERROR_NO_MEMORY);
@@ -260,18 +387,24 @@ CHIP_ERROR TCPBase::SendAfterConnect(const PeerAddress & addr, System::PacketBuf
     endPoint->OnAcceptError        = OnAcceptError;
     endPoint->OnPeerClose          = OnPeerClosed;
 
-    err = endPoint->Connect(addr.GetIPAddress(), addr.GetPort(), addr.GetInterface());
+    // Store the connection and enqueue the packet before connecting, since the connection may complete right away.
+    connection = AddConnection(endPoint, addr, true /* connecting */);
+    VerifyOrExit(connection != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
+    err = EnqueuePendingPacket(connection, std::move(msg));
     SuccessOrExit(err);
 
-    // enqueue the packet once the connection succeeds
-    packet->peerAddress  = addr;
-    packet->packetBuffer = std::move(msg);
-    mUsedEndPointCount++;
+    err = endPoint->Connect(addr.GetIPAddress(), addr.GetPort(), addr.GetInterface());
+    SuccessOrExit(err);
 
 exit:
     if (err != CHIP_NO_ERROR)
     {
-        if (endPoint != nullptr)
+        if (connection != nullptr)
+        {
+            ReleaseConnection(connection);
+        }
+        else if (endPoint != nullptr)
         {
             endPoint->Free();
         }
@@ -284,84 +417,86 @@ CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const Pe
 {
     ActiveConnectionState * state = FindActiveConnection(endPoint);
     VerifyOrReturnError(state != nullptr, CHIP_ERROR_INTERNAL);
-    state->mReceived.AddToEnd(std::move(buffer));
 
-    while (!state->mReceived.IsNull())
+    // Take the buffers of the chain one at a time, so that each is done with as soon as its data is.
+    while (!buffer.IsNull())
     {
-        uint8_t messageSizeBuf[kPacketSizeBytes];
-        CHIP_ERROR err = state->mReceived->Read(messageSizeBuf);
-        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
-        {
-            // We don't have enough data to read the message size. Wait until there's more.
-            return CHIP_NO_ERROR;
-        }
-        else if (err != CHIP_NO_ERROR)
-        {
-            return err;
-        }
-        uint16_t messageSize = LittleEndian::Get16(messageSizeBuf);
-        if (messageSize >= kMaxMessageSize)
-        {
-            // This message is too long for upper layers.
-            return CHIP_ERROR_MESSAGE_TOO_LONG;
-        }
-        // The subtraction will not underflow because we successfully read kPacketSizeBytes.
-        if (messageSize > (state->mReceived->TotalLength() - kPacketSizeBytes))
-        {
-            // We have not yet received the complete message.
-            return CHIP_NO_ERROR;
-        }
-        state->mReceived.Consume(kPacketSizeBytes);
-        ReturnErrorOnFailure(ProcessSingleMessage(peerAddress, state, messageSize));
+        ReturnErrorOnFailure(ProcessReceivedSegment(peerAddress, state, buffer.PopHead()));
     }
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, ActiveConnectionState * state, uint16_t messageSize)
+CHIP_ERROR TCPBase::ProcessReceivedSegment(const PeerAddress & peerAddress, ActiveConnectionState * state,
+                                           System::PacketBufferHandle && buffer)
 {
-    // We enter with `state->mReceived` containing at least one full message, perhaps in a chain.
-    // `state->mReceived->Start()` currently points to the message data.
-    // On exit, `state->mReceived` will have had `messageSize` bytes consumed, no matter what.
-    System::PacketBufferHandle message;
-    if (state->mReceived->DataLength() == messageSize)
-    {
-        // In this case, the head packet buffer contains exactly the message.
-        // This is common because typical messages fit in a network packet, and are delivered as such.
-        // Peel off the head to pass upstream, which effectively consumes it from `state->mReceived`.
-        message = state->mReceived.PopHead();
-    }
-    else
+    static_assert(sizeof(state->mMessageSizeBuf) == kPacketSizeBytes, "The message size must fit its staging buffer");
+
+    while (buffer->DataLength() > 0)
     {
-        // The message is either longer or shorter than the head buffer.
-        // In either case, copy the message to a fresh linear buffer to pass upstream. We always copy, rather than provide
-        // a shared reference to the current buffer, in case upper layers manipulate the buffer in ways that would affect
-        // our use, e.g. chaining it elsewhere or reusing space beyond the current message.
-        message = System::PacketBufferHandle::New(messageSize, 0);
-        if (message.IsNull())
+        if (state->mReceived.IsNull())
+        {
+            // Stage the size of the next message, which may be split across buffers.
+            uint16_t length = std::min(static_cast<uint16_t>(kPacketSizeBytes - state->mMessageSizeLength), buffer->DataLength());
+            memcpy(state->mMessageSizeBuf + state->mMessageSizeLength, buffer->Start(), length);
+            state->mMessageSizeLength = static_cast<uint8_t>(state->mMessageSizeLength + length);
+            buffer->ConsumeHead(length);
+            if (state->mMessageSizeLength < kPacketSizeBytes)
+            {
+                // We don't have enough data to read the message size. Wait until there's more.
+                return CHIP_NO_ERROR;
+            }
+
+            state->mMessageSizeLength = 0;
+            state->mMessageSize       = LittleEndian::Get16(state->mMessageSizeBuf);
+            if (state->mMessageSize >= kMaxMessageSize)
+            {
+                // This message is too long for upper layers.
+                return CHIP_ERROR_MESSAGE_TOO_LONG;
+            }
+
+            if (buffer->DataLength() == state->mMessageSize)
+            {
+                // In this case, the buffer contains exactly the message.
+                // This is common because typical messages fit in a network packet, and are delivered as such.
+                HandleMessageReceived(peerAddress, std::move(buffer));
+                return CHIP_NO_ERROR;
+            }
+
+            // The message is either longer or shorter than the rest of the buffer. In either case, it is gathered into a
+            // fresh linear buffer to pass upstream. We always copy, rather than provide a shared reference to the current
+            // buffer, in case upper layers manipulate the buffer in ways that would affect our use, e.g. chaining it
+            // elsewhere or reusing space beyond the current message.
+            state->mReceived = System::PacketBufferHandle::New(state->mMessageSize, 0);
+            VerifyOrReturnError(!state->mReceived.IsNull(), CHIP_ERROR_NO_MEMORY);
+        }
+
+        uint16_t received = state->mReceived->DataLength();
+        uint16_t length   = std::min(static_cast<uint16_t>(state->mMessageSize - received), buffer->DataLength());
+        memcpy(state->mReceived->Start() + received, buffer->Start(), length);
+        state->mReceived->SetDataLength(static_cast<uint16_t>(received + length));
+        buffer->ConsumeHead(length);
+
+        if (state->mReceived->DataLength() == state->mMessageSize)
         {
-            return CHIP_ERROR_NO_MEMORY;
+            // Take the message out of the connection state first, the next one starts there.
+            System::PacketBufferHandle message = std::move(state->mReceived);
+            HandleMessageReceived(peerAddress, std::move(message));
         }
-        CHIP_ERROR err = state->mReceived->Read(message->Start(), messageSize);
-        state->mReceived.Consume(messageSize);
-        ReturnErrorOnFailure(err);
-        message->SetDataLength(messageSize);
     }
 
-    HandleMessageReceived(peerAddress, std::move(message));
     return CHIP_NO_ERROR;
 }
 
 INET_ERROR TCPBase::OnTcpReceive(Inet::TCPEndPoint * endPoint, System::PacketBufferHandle && buffer)
 {
-    Inet::IPAddress ipAddress;
-    uint16_t port;
-
-    endPoint->GetPeerInfo(&ipAddress, &port);
-    PeerAddress peerAddress = PeerAddress::TCP(ipAddress, port);
+    TCPBase * tcp                      = reinterpret_cast<TCPBase *>(endPoint->AppState);
+    ActiveConnectionState * connection = tcp->FindActiveConnection(endPoint);
+    VerifyOrReturnError(connection != nullptr, INET_ERROR_UNEXPECTED_EVENT);
 
-    TCPBase * tcp  = reinterpret_cast<TCPBase *>(endPoint->AppState);
-    CHIP_ERROR err = tcp->ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
+    // The peer address is copied, since the connection may be released by the time a message is handled.
+    PeerAddress peerAddress = connection->mPeerAddress;
+    CHIP_ERROR err          = tcp->ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
 
     if (err != CHIP_NO_ERROR)
     {
@@ -374,39 +509,20 @@ INET_ERROR TCPBase::OnTcpReceive(Inet::TCPEndPoint * endPoint, System::PacketBuf
 
 void TCPBase::OnConnectionComplete(Inet::TCPEndPoint * endPoint, INET_ERROR inetErr)
 {
-    CHIP_ERROR err          = CHIP_NO_ERROR;
-    bool foundPendingPacket = false;
-    TCPBase * tcp           = reinterpret_cast<TCPBase *>(endPoint->AppState);
-    Inet::IPAddress ipAddress;
-    uint16_t port;
-
-    endPoint->GetPeerInfo(&ipAddress, &port);
-    PeerAddress addr = PeerAddress::TCP(ipAddress, port);
+    CHIP_ERROR err                     = inetErr;
+    TCPBase * tcp                      = reinterpret_cast<TCPBase *>(endPoint->AppState);
+    ActiveConnectionState * connection = tcp->FindActiveConnection(endPoint);
 
-    // Send any pending packets
-    for (size_t i = 0; i < tcp->mPendingPacketsSize; i++)
+    if (connection == nullptr)
     {
-        if ((tcp->mPendingPackets[i].peerAddress != addr) || (tcp->mPendingPackets[i].packetBuffer.IsNull()))
-        {
-            continue;
-        }
-        foundPendingPacket = true;
-
-        System::PacketBufferHandle buffer   = std::move(tcp->mPendingPackets[i].packetBuffer);
-        tcp->mPendingPackets[i].peerAddress = PeerAddress::Uninitialized();
-
-        if ((inetErr == CHIP_NO_ERROR) && (err == CHIP_NO_ERROR))
-        {
-            err = endPoint->Send(std::move(buffer));
-        }
-    }
-
-    if (err == CHIP_NO_ERROR)
-    {
-        err = inetErr;
+        // since connections are stored before connecting, we always expect
+        // to find the connection.
+        ChipLogError(Inet, "Internal logic error: completed connection is not stored");
+        endPoint->Free();
+        return;
     }
 
-    if (!foundPendingPacket && (err == CHIP_NO_ERROR))
+    if (connection->mPendingHead == nullptr && (err == CHIP_NO_ERROR))
     {
         // Force a close: new connections are only expected when a
         // new buffer is being sent.
@@ -414,50 +530,33 @@ void TCPBase::OnConnectionComplete(Inet::TCPEndPoint * endPoint, INET_ERROR inet
         err = CHIP_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY;
     }
 
-    // cleanup packets or mark as free
-    if (err != CHIP_NO_ERROR)
+    // Send the pending packets in order, pushing them out with the last one.
+    connection->mConnecting = false;
+    while ((err == CHIP_NO_ERROR) && (connection->mPendingHead != nullptr))
     {
-        ChipLogError(Inet, "Connection complete encountered an error: %s", ErrorStr(err));
-        endPoint->Free();
-        tcp->mUsedEndPointCount--;
+        System::PacketBufferHandle buffer = tcp->DequeuePendingPacket(connection);
+        err                               = endPoint->Send(std::move(buffer), connection->mPendingHead == nullptr);
     }
-    else
-    {
-        bool connectionStored = false;
-        for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
-        {
-            if (!tcp->mActiveConnections[i].InUse())
-            {
-                tcp->mActiveConnections[i].Init(endPoint);
-                connectionStored = true;
-                break;
-            }
-        }
 
-        // since we track end points counts, we always expect to store the
-        // connection.
-        if (!connectionStored)
-        {
-            endPoint->Free();
-            ChipLogError(Inet, "Internal logic error: insufficient space to store active connection");
-        }
+    // cleanup packets and the connection
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Connection complete encountered an error: %s", ErrorStr(err));
+        tcp->ReleaseConnection(connection);
     }
 }
 
 void TCPBase::OnConnectionClosed(Inet::TCPEndPoint * endPoint, INET_ERROR err)
 {
-    TCPBase * tcp = reinterpret_cast<TCPBase *>(endPoint->AppState);
+    TCPBase * tcp                      = reinterpret_cast<TCPBase *>(endPoint->AppState);
+    ActiveConnectionState * connection = tcp->FindActiveConnection(endPoint);
 
     ChipLogProgress(Inet, "Connection closed.");
 
-    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    if (connection != nullptr)
     {
-        if (tcp->mActiveConnections[i].mEndPoint == endPoint)
-        {
-            ChipLogProgress(Inet, "Freeing closed connection.");
-            tcp->mActiveConnections[i].Free();
-            tcp->mUsedEndPointCount--;
-        }
+        ChipLogProgress(Inet, "Freeing closed connection.");
+        tcp->ReleaseConnection(connection);
     }
 }
 
@@ -466,18 +565,9 @@ void TCPBase::OnConnectionReceived(Inet::TCPEndPoint * listenEndPoint, Inet::TCP
 {
     TCPBase * tcp = reinterpret_cast<TCPBase *>(listenEndPoint->AppState);
 
-    if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize)
+    // have space to use one more (even if considering pending connections)
+    if (tcp->AddConnection(endPoint, PeerAddress::TCP(peerAddress, peerPort), false /* connecting */) != nullptr)
     {
-        // have space to use one more (even if considering pending connections)
-        for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
-        {
-            if (!tcp->mActiveConnections[i].InUse())
-            {
-                tcp->mActiveConnections[i].Init(endPoint);
-                break;
-            }
-        }
-
         endPoint->AppState             = listenEndPoint->AppState;
         endPoint->OnDataReceived       = OnTcpReceive;
         endPoint->OnConnectComplete    = OnConnectionComplete;
@@ -500,53 +590,33 @@ void TCPBase::OnAcceptError(Inet::TCPEndPoint * endPoint, INET_ERROR err)
 
 void TCPBase::Disconnect(const PeerAddress & address)
 {
-    // Closes an existing connection
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
-    {
-        if (mActiveConnections[i].InUse())
-        {
-            Inet::IPAddress ipAddress;
-            uint16_t port;
+    ActiveConnectionState * connection = nullptr;
 
-            mActiveConnections[i].mEndPoint->GetPeerInfo(&ipAddress, &port);
-            if (address == PeerAddress::TCP(ipAddress, port))
-            {
-                // NOTE: this leaves the socket in TIME_WAIT.
-                // Calling Abort() would clean it since SO_LINGER would be set to 0,
-                // however this seems not to be useful.
-                mActiveConnections[i].Free();
-                mUsedEndPointCount--;
-            }
-        }
+    // Closes the existing connections to the peer, including one still being established
+    while ((connection = FindActiveConnection(address)) != nullptr)
+    {
+        // NOTE: this leaves the socket in TIME_WAIT.
+        // Calling Abort() would clean it since SO_LINGER would be set to 0,
+        // however this seems not to be useful.
+        ReleaseConnection(connection);
     }
 }
 
 void TCPBase::OnPeerClosed(Inet::TCPEndPoint * endPoint)
 {
-    TCPBase * tcp = reinterpret_cast<TCPBase *>(endPoint->AppState);
+    TCPBase * tcp                      = reinterpret_cast<TCPBase *>(endPoint->AppState);
+    ActiveConnectionState * connection = tcp->FindActiveConnection(endPoint);
 
-    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    if (connection != nullptr)
     {
-        if (tcp->mActiveConnections[i].mEndPoint == endPoint)
-        {
-            ChipLogProgress(Inet, "Freeing connection: connection closed by peer");
-            tcp->mActiveConnections[i].Free();
-            tcp->mUsedEndPointCount--;
-        }
+        ChipLogProgress(Inet, "Freeing connection: connection closed by peer");
+        tcp->ReleaseConnection(connection);
     }
 }
 
 bool TCPBase::HasActiveConnections() const
 {
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
-    {
-        if (mActiveConnections[i].InUse())
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return mUsedEndPointCount > 0;
 }
 
 } // namespace Transport
@@ -82,10 +82,12 @@ private:
 
 /**
  * Packets scheduled for sending once a connection has been established.
+ *
+ * Pending packets are drawn from a pool shared by all connections, and queued per connection in the order they are sent.
  */
 struct PendingPacket
 {
-    PeerAddress peerAddress;                 // where the packet is being sent to
+    PendingPacket * next;                    // the packet queued after this one, or the next free packet
     System::PacketBufferHandle packetBuffer; // what data needs to be sent
 };
 
@@ -107,42 +109,94 @@ protected:
      */
     struct ActiveConnectionState
     {
-        void Init(Inet::TCPEndPoint * endPoint)
+        void Init(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress, bool connecting)
         {
-            mEndPoint = endPoint;
-            mReceived = nullptr;
+            mEndPoint          = endPoint;
+            mPeerAddress       = peerAddress;
+            mConnecting        = connecting;
+            mPendingHead       = nullptr;
+            mPendingTail       = nullptr;
+            mReceived          = nullptr;
+            mMessageSizeLength = 0;
         }
 
         void Free()
         {
             mEndPoint->Free();
-            mEndPoint = nullptr;
-            mReceived = nullptr;
+            mEndPoint          = nullptr;
+            mReceived          = nullptr;
+            mMessageSizeLength = 0;
         }
         bool InUse() const { return mEndPoint != nullptr; }
 
         // Associated endpoint.
         Inet::TCPEndPoint * mEndPoint;
 
-        // Buffers received but not yet consumed.
+        // The address and port of the peer, as messages from it are reported; the connection is looked up by these.
+        PeerAddress mPeerAddress;
+
+        // Whether the connection is still being established, in which case packets sent to the peer are queued.
+        bool mConnecting;
+
+        // The packets to send once the connection has been established, first to last.
+        PendingPacket * mPendingHead;
+        PendingPacket * mPendingTail;
+
+        // The part of the message being received that has arrived so far, once its size is known; null otherwise.
         System::PacketBufferHandle mReceived;
+
+        // The size of the message being received, and while mReceived is null, the bytes of it that have arrived so far.
+        uint8_t mMessageSizeBuf[sizeof(uint16_t)];
+        uint8_t mMessageSizeLength;
+        uint16_t mMessageSize;
+    };
+
+    /**
+     *  Entry of an index of the active connections, which is an open addressing hash table probed linearly.
+     */
+    struct ConnectionIndexEntry
+    {
+        uint32_t mHash;                      // hash of the key the connection is indexed on
+        ActiveConnectionState * mConnection; // the connection, or nullptr for a free entry
     };
 
+    /**
+     * The number of entries of the connection indexes for a number of connections: a power of two, at least twice the
+     * number of connections, which keeps probe sequences short.
+     */
+    static constexpr size_t ConnectionIndexSize(size_t connections)
+    {
+        size_t size = 1;
+        while (size < 2 * connections)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
 public:
-    TCPBase(ActiveConnectionState * activeConnectionsBuffer, size_t bufferSize, PendingPacket * packetBuffers,
-            size_t packetsBuffersSize) :
+    TCPBase(ActiveConnectionState * activeConnectionsBuffer, size_t bufferSize, ConnectionIndexEntry * peerIndex,
+            ConnectionIndexEntry * endPointIndex, size_t indexSize, PendingPacket * packetBuffers, size_t packetsBuffersSize) :
         mActiveConnections(activeConnectionsBuffer),
-        mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers), mPendingPacketsSize(packetsBuffersSize)
+        mActiveConnectionsSize(bufferSize), mPeerIndex(peerIndex), mEndPointIndex(endPointIndex), mIndexSize(indexSize),
+        mPendingPackets(packetBuffers), mPendingPacketsSize(packetsBuffersSize)
     {
         // activeConnectionsBuffer must be initialized by the caller.
+        for (size_t i = 0; i < mIndexSize; ++i)
+        {
+            mPeerIndex[i].mConnection     = nullptr;
+            mEndPointIndex[i].mConnection = nullptr;
+        }
+
         for (size_t i = 0; i < mPendingPacketsSize; ++i)
         {
-            mPendingPackets[i].peerAddress = PeerAddress::Uninitialized();
+            mPendingPackets[i].next = (i + 1 < mPendingPacketsSize) ? &mPendingPackets[i + 1] : nullptr;
             // In the typical case, the TCPBase constructor is invoked from the TCP constructor on its mPendingPackets,
             // which has not yet been initialized. That means we can't do a normal move assignment or construction of
             // the PacketBufferHandle, since that would call PacketBuffer::Free on the uninitialized data.
             new (&mPendingPackets[i].packetBuffer) System::PacketBufferHandle();
         }
+        mFreePendingPackets = (mPendingPacketsSize > 0) ? mPendingPackets : nullptr;
     }
     ~TCPBase() override;
 
@@ -176,7 +230,8 @@ public:
     /**
      * Helper method to determine if IO processing is still required for a TCP transport
      * before everything is cleaned up (socket closing is async, so after calling 'Close' on
-     * the transport, some time may be needed to actually be able to close.)
+     * the transport, some time may be needed to actually be able to close.) Connections still
+     * being established count as active.
      */
     bool HasActiveConnections() const;
 
@@ -191,10 +246,45 @@ private:
     /**
      * Find an active connection to the given peer or return nullptr if
      * no active connection exists.
+     *
+     * Connections are looked up in constant time, through indexes on the address and port of the peer and on the
+     * endpoint. A connection that is still being established is found as well.
      */
     ActiveConnectionState * FindActiveConnection(const PeerAddress & addr);
     ActiveConnectionState * FindActiveConnection(const Inet::TCPEndPoint * endPoint);
 
+    /**
+     * Store a connection in a free connection slot and index it.
+     *
+     * @return the connection state, or nullptr if all connection slots are in use.
+     */
+    ActiveConnectionState * AddConnection(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress, bool connecting);
+
+    /**
+     * Free the endpoint of a connection, drop the packets pending on it, and release its connection slot.
+     */
+    void ReleaseConnection(ActiveConnectionState * connection);
+
+    // Hashes of the keys of the connection indexes. Connections are keyed on the address and port of the peer only, like
+    // messages from them are reported.
+    static uint32_t PeerHash(const PeerAddress & address);
+    static uint32_t EndPointHash(const Inet::TCPEndPoint * endPoint);
+
+    void AddToIndex(ConnectionIndexEntry * index, uint32_t hash, ActiveConnectionState * connection);
+    void RemoveFromIndex(ConnectionIndexEntry * index, uint32_t hash, ActiveConnectionState * connection);
+
+    /**
+     * Queue a packet on a connection that is being established, drawing a pending packet from the pool.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY  All pending packets of the pool are in use.
+     */
+    CHIP_ERROR EnqueuePendingPacket(ActiveConnectionState * connection, System::PacketBufferHandle && msg);
+
+    /**
+     * Take the first packet queued on a connection, returning its pending packet to the pool.
+     */
+    System::PacketBufferHandle DequeuePendingPacket(ActiveConnectionState * connection);
+
     /**
      * Sends the specified message once a connection has been established.
      *
@@ -213,22 +303,25 @@ private:
      * @param peerAddress the peer the data is coming from
      * @param buffer the actual data
      *
-     * Ownership of buffer is taken over and will be freed (or re-enqueued to the endPoint receive queue)
-     * as needed during processing.
+     * Ownership of buffer is taken over; each packet buffer of it is freed, or passed upstream as a message, as soon as
+     * its data is processed.
      */
     CHIP_ERROR ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
                                      System::PacketBufferHandle && buffer);
 
     /**
-     * Process a single message of the specified size from a buffer.
+     * Process the data of a single packet buffer, which may hold any part of any number of messages.
+     *
+     * Messages are reassembled in the connection state: only the size preceding a message is staged byte by byte, the
+     * message itself is copied once, into a buffer of its size. A packet buffer holding exactly one message is passed
+     * upstream as is.
      *
      * @param[in]     peerAddress   The peer the data is coming from.
-     * @param[in,out] state         The connection state, which contains the message. On entry, the payload points to the message
-     *                              body (after the length). On exit, it points after the message (or the queue is null, if there
-     *                              is no other data).
-     * @param[in]     messageSize   Size of the single message.
+     * @param[in,out] state         The connection state, holding the message being received.
+     * @param[in]     buffer        A single packet buffer of received data.
      */
-    CHIP_ERROR ProcessSingleMessage(const PeerAddress & peerAddress, ActiveConnectionState * state, uint16_t messageSize);
+    CHIP_ERROR ProcessReceivedSegment(const PeerAddress & peerAddress, ActiveConnectionState * state,
+                                      System::PacketBufferHandle && buffer);
 
     // Callback handler for TCPEndPoint. TCP message receive handler.
     // @see TCPEndpoint::OnDataReceivedFunct
@@ -266,26 +359,38 @@ private:
     ActiveConnectionState * mActiveConnections;
     const size_t mActiveConnectionsSize;
 
+    // Indexes of the active connections, on the address and port of the peer and on the endpoint
+    ConnectionIndexEntry * mPeerIndex;
+    ConnectionIndexEntry * mEndPointIndex;
+    const size_t mIndexSize;
+
     // Data to be sent when connections succeed
     PendingPacket * mPendingPackets;
     const size_t mPendingPacketsSize;
+    PendingPacket * mFreePendingPackets;
 };
 
 template <size_t kActiveConnectionsSize, size_t kPendingPacketSize>
 class TCP : public TCPBase
 {
 public:
-    TCP() : TCPBase(mConnectionsBuffer, kActiveConnectionsSize, mPendingPackets, kPendingPacketSize)
+    TCP() :
+        TCPBase(mConnectionsBuffer, kActiveConnectionsSize, mPeerIndex, mEndPointIndex, kIndexSize, mPendingPackets,
+                kPendingPacketSize)
     {
         for (size_t i = 0; i < kActiveConnectionsSize; ++i)
         {
-            mConnectionsBuffer[i].Init(nullptr);
+            mConnectionsBuffer[i].Init(nullptr, PeerAddress::Uninitialized(), false);
         }
     }
 
 private:
     friend class TCPTest;
+    static constexpr size_t kIndexSize = ConnectionIndexSize(kActiveConnectionsSize);
+
     TCPBase::ActiveConnectionState mConnectionsBuffer[kActiveConnectionsSize];
+    TCPBase::ConnectionIndexEntry mPeerIndex[kIndexSize];
+    TCPBase::ConnectionIndexEntry mEndPointIndex[kIndexSize];
     PendingPacket mPendingPackets[kPendingPacketSize];
 };
 
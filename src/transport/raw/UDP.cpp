@@ -56,6 +56,8 @@ CHIP_ERROR UDP::Init(UdpListenParameters & params)
     SuccessOrExit(err);
 
     mUDPEndpointType = params.GetAddressType();
+    mSystemLayer     = params.GetInetLayer()->SystemLayer();
+    mBatchSends      = params.GetBatchSends() && (INET_CONFIG_UDP_BATCH_SIZE > 1);
 
     mState = State::kInitialized;
 
@@ -75,6 +77,8 @@ exit:
 
 void UDP::Close()
 {
+    ClearSendQueue();
+
     if (mUDPEndPoint)
     {
         // Udp endpoint is only non null if udp endpoint is initialized and listening
@@ -98,7 +102,71 @@ CHIP_ERROR UDP::SendMessage(const Transport::PeerAddress & address, System::Pack
     addrInfo.DestPort    = address.GetPort();
     addrInfo.Interface   = address.GetInterface();
 
-    return mUDPEndPoint->SendMsg(&addrInfo, std::move(msgBuf));
+    if (!mBatchSends)
+    {
+        return mUDPEndPoint->SendMsg(&addrInfo, std::move(msgBuf));
+    }
+
+    if (mSendQueueLength == 0)
+    {
+        ReturnErrorOnFailure(mSystemLayer->ScheduleWork(HandleFlushSendQueue, this));
+    }
+
+    mSendQueueInfo[mSendQueueLength] = addrInfo;
+    mSendQueue[mSendQueueLength]     = std::move(msgBuf);
+    mSendQueueLength++;
+
+    if (mSendQueueLength == INET_CONFIG_UDP_BATCH_SIZE)
+    {
+        return FlushSendQueue();
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR UDP::FlushSendQueue()
+{
+    CHIP_ERROR err   = CHIP_NO_ERROR;
+    size_t sentCount = 0;
+
+    VerifyOrReturnError(mSendQueueLength > 0, CHIP_NO_ERROR);
+
+    if (mUDPEndPoint != nullptr)
+    {
+        err = mUDPEndPoint->SendMsgs(mSendQueueInfo, mSendQueue, mSendQueueLength, sentCount);
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to send %u of %u queued UDP messages: %s", static_cast<unsigned>(mSendQueueLength - sentCount),
+                     static_cast<unsigned>(mSendQueueLength), ErrorStr(err));
+    }
+
+    ClearSendQueue();
+
+    return err;
+}
+
+void UDP::ClearSendQueue()
+{
+    if (mSendQueueLength > 0 && mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(HandleFlushSendQueue, this);
+    }
+
+    for (size_t i = 0; i < mSendQueueLength; i++)
+    {
+        mSendQueue[i] = nullptr;
+    }
+
+    mSendQueueLength = 0;
+}
+
+void UDP::HandleFlushSendQueue(System::Layer * systemLayer, void * appState, System::Error error)
+{
+    UDP * udp = reinterpret_cast<UDP *>(appState);
+
+    udp->FlushSendQueue();
 }
 
 void UDP::OnUdpReceive(Inet::IPEndPointBasis * endPoint, System::PacketBufferHandle && buffer, const Inet::IPPacketInfo * pktInfo)
@@ -70,11 +70,20 @@ public:
         return *this;
     }
 
+    bool GetBatchSends() const { return mBatchSends; }
+    UdpListenParameters & SetBatchSends(bool batchSends)
+    {
+        mBatchSends = batchSends;
+
+        return *this;
+    }
+
 private:
     Inet::InetLayer * mLayer         = nullptr;                   ///< Associated inet layer
     Inet::IPAddressType mAddressType = Inet::kIPAddressType_IPv6; ///< type of listening socket
     uint16_t mListenPort             = CHIP_PORT;                 ///< UDP listen port
     Inet::InterfaceId mInterfaceId   = INET_NULL_INTERFACEID;     ///< Interface to listen on
+    bool mBatchSends                 = false;                     ///< Queue sends and flush them in batches
 };
 
 /** Implements a transport using UDP. */
@@ -110,8 +119,23 @@ public:
      */
     void Close() override;
 
+    /**
+     * Send a message to the given peer.
+     *
+     * @details
+     *   When send batching is enabled, the message is queued and the queue is
+     *   handed to the endpoint in a single call once it holds
+     *   INET_CONFIG_UDP_BATCH_SIZE messages, or from the next pass of the
+     *   event loop, whichever comes first. Errors from a deferred flush are
+     *   logged rather than returned.
+     */
     CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override;
 
+    /**
+     * Hand any queued outbound messages to the endpoint now.
+     */
+    CHIP_ERROR FlushSendQueue();
+
     bool CanSendToPeer(const Transport::PeerAddress & address) override
     {
         return (mState == State::kInitialized) && (address.GetTransportType() == Type::kUdp) &&
@@ -123,9 +147,20 @@ private:
     static void OnUdpReceive(Inet::IPEndPointBasis * endPoint, System::PacketBufferHandle && buffer,
                              const Inet::IPPacketInfo * pktInfo);
 
+    // Deferred send queue flush, scheduled on the first queued message.
+    static void HandleFlushSendQueue(System::Layer * systemLayer, void * appState, System::Error error);
+
+    void ClearSendQueue();
+
     Inet::UDPEndPoint * mUDPEndPoint     = nullptr;                                     ///< UDP socket used by the transport
     Inet::IPAddressType mUDPEndpointType = Inet::IPAddressType::kIPAddressType_Unknown; ///< Socket listening type
     State mState                         = State::kNotReady;                            ///< State of the UDP transport
+
+    System::Layer * mSystemLayer = nullptr; ///< Layer used to schedule deferred send queue flushes
+    bool mBatchSends             = false;   ///< Whether sends are queued and flushed in batches
+    size_t mSendQueueLength      = 0;       ///< Number of messages in the send queue
+    Inet::IPPacketInfo mSendQueueInfo[INET_CONFIG_UDP_BATCH_SIZE];
+    System::PacketBufferHandle mSendQueue[INET_CONFIG_UDP_BATCH_SIZE];
 };
 
 } // namespace Transport
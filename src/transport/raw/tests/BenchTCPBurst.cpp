@@ -0,0 +1,147 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of TCP loopback throughput for bursts
+ *      of small messages sent back to back on an established connection.
+ *
+ *      Build it once more with CHIP_CONFIG_TCP_COALESCE_BYTES set to 0 to
+ *      compare coalesced sends with one write per message.
+ */
+
+#include "NetworkTestHelpers.h"
+
+#include <core/CHIPCore.h>
+#include <support/CodeUtils.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/TCP.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace chip;
+using namespace chip::Inet;
+
+namespace {
+
+constexpr NodeId kSourceNodeId      = 123654;
+constexpr NodeId kDestinationNodeId = 111222333;
+constexpr uint32_t kMessageId       = 18;
+
+constexpr size_t kBurstSize     = 32;
+constexpr size_t kBurstCount    = 100;
+constexpr size_t kMessageCount  = kBurstSize * kBurstCount;
+constexpr uint16_t kPayloadSize = 64;
+
+using TCPImpl = Transport::TCP<4, 4>;
+
+size_t sReceiveCount = 0;
+
+class CountingTransportMgrDelegate : public TransportMgrDelegate
+{
+public:
+    void OnMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msgBuf) override
+    {
+        PacketHeader header;
+
+        if (header.DecodeAndConsume(msgBuf) == CHIP_NO_ERROR && msgBuf->DataLength() == kPayloadSize)
+        {
+            sReceiveCount++;
+        }
+    }
+};
+
+CHIP_ERROR SendMessage(TCPImpl & tcp, const IPAddress & addr, const uint8_t * payload)
+{
+    PacketHeader header;
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::NewWithData(payload, kPayloadSize);
+    VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+    ReturnErrorOnFailure(header.EncodeBeforeData(buffer));
+    return tcp.SendMessage(Transport::PeerAddress::TCP(addr), std::move(buffer));
+}
+
+// Returns the time taken to send and receive kMessageCount messages in bursts of kBurstSize, in microseconds, or 0 on
+// failure. The connection is set up by a first message outside the timed loop.
+uint64_t RunBursts(Test::IOContext & ctx, TCPImpl & tcp, const IPAddress & addr)
+{
+    uint8_t payload[kPayloadSize];
+    memset(payload, 0x5A, sizeof(payload));
+
+    sReceiveCount = 0;
+    VerifyOrReturnError(SendMessage(tcp, addr, payload) == CHIP_NO_ERROR, 0);
+    ctx.DriveIOUntil(5000 /* ms */, []() { return sReceiveCount == 1; });
+    VerifyOrReturnError(sReceiveCount == 1, 0);
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t burst = 0; burst < kBurstCount; burst++)
+    {
+        sReceiveCount = 0;
+
+        for (size_t i = 0; i < kBurstSize; i++)
+        {
+            VerifyOrReturnError(SendMessage(tcp, addr, payload) == CHIP_NO_ERROR, 0);
+        }
+
+        ctx.DriveIOUntil(5000 /* ms */, []() { return sReceiveCount == kBurstSize; });
+        VerifyOrReturnError(sReceiveCount == kBurstSize, 0);
+    }
+
+    return System::Layer::GetClock_MonotonicHiRes() - start;
+}
+
+} // namespace
+
+int main()
+{
+    Test::IOContext ctx;
+    TCPImpl tcp;
+    CountingTransportMgrDelegate delegate;
+    TransportMgrBase transportMgr;
+    IPAddress addr;
+
+    VerifyOrDie(ctx.Init(nullptr) == CHIP_NO_ERROR);
+    IPAddress::FromString("127.0.0.1", addr);
+
+    VerifyOrDie(tcp.Init(Transport::TcpListenParameters(&ctx.GetInetLayer()).SetAddressType(addr.Type())) == CHIP_NO_ERROR);
+    transportMgr.SetSecureSessionMgr(&delegate);
+    transportMgr.Init(&tcp);
+
+    uint64_t elapsed = RunBursts(ctx, tcp, addr);
+
+    tcp.Disconnect(Transport::PeerAddress::TCP(addr));
+    ctx.DriveIOUntil(5000 /* ms */, [&tcp]() { return !tcp.HasActiveConnections(); });
+    ctx.Shutdown();
+
+    if (elapsed == 0)
+    {
+        printf("TCP loopback lost messages\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("TCP loopback, %u messages of %u bytes in bursts of %u: %" PRIu64 " us, %" PRIu64 " msgs/s (coalesce bytes %u)\n",
+           static_cast<unsigned>(kMessageCount), static_cast<unsigned>(kPayloadSize), static_cast<unsigned>(kBurstSize), elapsed,
+           kMessageCount * 1000000 / elapsed, static_cast<unsigned>(CHIP_CONFIG_TCP_COALESCE_BYTES));
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the lookups of TCP connections by
+ *      peer address and by endpoint, with every connection slot in use.
+ */
+
+#include <core/CHIPCore.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+#include <transport/raw/TCP.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr size_t kNumConnections = 256;
+constexpr size_t kNumRounds      = 1000;
+
+} // namespace
+
+namespace chip {
+namespace Transport {
+class TCPTest
+{
+public:
+    // The endpoints are only hashed and compared by the transport, never used, so any distinct pointers will do. The
+    // connections are taken out of the indexes by hand rather than released, which would free the endpoints.
+    static CHIP_ERROR AddConnection(TCPBase & tcp, Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress)
+    {
+        return (tcp.AddConnection(endPoint, peerAddress, false) != nullptr) ? CHIP_NO_ERROR : CHIP_ERROR_NO_MEMORY;
+    }
+
+    static void ForgetConnection(TCPBase & tcp, Inet::TCPEndPoint * endPoint)
+    {
+        TCPBase::ActiveConnectionState * connection = tcp.FindActiveConnection(endPoint);
+        tcp.RemoveFromIndex(tcp.mPeerIndex, TCPBase::PeerHash(connection->mPeerAddress), connection);
+        tcp.RemoveFromIndex(tcp.mEndPointIndex, TCPBase::EndPointHash(connection->mEndPoint), connection);
+        connection->Init(nullptr, PeerAddress::Uninitialized(), false);
+        tcp.mUsedEndPointCount--;
+    }
+
+    // Looks every connection up by peer address and by endpoint kNumRounds times. Returns lookups per second, or 0 if a
+    // lookup fails.
+    static uint64_t RunLookups(TCPBase & tcp, Inet::TCPEndPoint * const * endPoints, const PeerAddress * peerAddresses)
+    {
+        size_t found   = 0;
+        uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+        for (size_t round = 0; round < kNumRounds; round++)
+        {
+            for (size_t i = 0; i < kNumConnections; i++)
+            {
+                found += (tcp.FindActiveConnection(peerAddresses[i]) != nullptr) ? 1 : 0;
+                found += (tcp.FindActiveConnection(endPoints[i]) != nullptr) ? 1 : 0;
+            }
+        }
+
+        uint64_t elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+        VerifyOrReturnError(found == 2 * kNumRounds * kNumConnections, 0);
+        return (elapsed > 0) ? found * 1000000 / elapsed : 0;
+    }
+};
+} // namespace Transport
+} // namespace chip
+
+int main()
+{
+    static Transport::TCP<kNumConnections, 1> tcp;
+    static uint8_t endPointStorage[kNumConnections];
+    static Inet::TCPEndPoint * endPoints[kNumConnections];
+    static Transport::PeerAddress peerAddresses[kNumConnections];
+
+    // Peers alternate between IPv6 and IPv4, and share addresses across ports, as the connections of a controller might.
+    for (size_t i = 0; i < kNumConnections; i++)
+    {
+        Inet::IPAddress addr;
+        Inet::IPAddress::FromString((i % 2 == 0) ? "fd00::1" : "10.0.0.1", addr);
+        addr.Addr[3] ^= static_cast<uint32_t>(i / 4);
+        endPoints[i]     = reinterpret_cast<Inet::TCPEndPoint *>(&endPointStorage[i]);
+        peerAddresses[i] = Transport::PeerAddress::TCP(addr, static_cast<uint16_t>(CHIP_PORT + i % 4));
+        VerifyOrDie(Transport::TCPTest::AddConnection(tcp, endPoints[i], peerAddresses[i]) == CHIP_NO_ERROR);
+    }
+
+    uint64_t rate = Transport::TCPTest::RunLookups(tcp, endPoints, peerAddresses);
+
+    for (size_t i = 0; i < kNumConnections; i++)
+    {
+        Transport::TCPTest::ForgetConnection(tcp, endPoints[i]);
+    }
+
+    if (rate == 0)
+    {
+        printf("TCP connection lookup failed\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("TCP connection lookup by peer and by endpoint, %u connections: %" PRIu64 " lookups/s\n",
+           static_cast<unsigned>(kNumConnections), rate);
+
+    return EXIT_SUCCESS;
+}
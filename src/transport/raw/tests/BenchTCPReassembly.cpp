@@ -0,0 +1,176 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the reassembly of TCP messages
+ *      that arrive split in segments of various sizes.
+ */
+
+#include <core/CHIPCore.h>
+#include <core/CHIPEncoding.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/TCP.h>
+
+#include <algorithm>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace chip;
+
+namespace chip {
+namespace Transport {
+class TCPTest
+{
+public:
+    // The endpoint is only hashed and compared by the transport, never used, so any distinct pointer will do. The
+    // connection is taken out of the indexes by hand rather than released, which would free the endpoint.
+    static CHIP_ERROR AddConnection(TCPBase & tcp, Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress)
+    {
+        return (tcp.AddConnection(endPoint, peerAddress, false) != nullptr) ? CHIP_NO_ERROR : CHIP_ERROR_NO_MEMORY;
+    }
+
+    static void ForgetConnection(TCPBase & tcp, Inet::TCPEndPoint * endPoint)
+    {
+        TCPBase::ActiveConnectionState * connection = tcp.FindActiveConnection(endPoint);
+        tcp.RemoveFromIndex(tcp.mPeerIndex, TCPBase::PeerHash(connection->mPeerAddress), connection);
+        tcp.RemoveFromIndex(tcp.mEndPointIndex, TCPBase::EndPointHash(connection->mEndPoint), connection);
+        connection->Init(nullptr, PeerAddress::Uninitialized(), false);
+        tcp.mUsedEndPointCount--;
+    }
+
+    static CHIP_ERROR ProcessReceivedBuffer(TCPBase & tcp, Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
+                                            System::PacketBufferHandle && buffer)
+    {
+        return tcp.ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
+    }
+};
+} // namespace Transport
+} // namespace chip
+
+namespace {
+
+constexpr NodeId kSourceNodeId      = 123654;
+constexpr NodeId kDestinationNodeId = 111222333;
+constexpr uint32_t kMessageId       = 18;
+
+constexpr size_t kMessageCount      = 10000;
+constexpr uint16_t kMessageLength   = 1200;
+constexpr size_t kSegmentSizes[]    = { 64, 256, kMessageLength };
+constexpr uint16_t kPacketSizeBytes = static_cast<uint16_t>(sizeof(uint16_t));
+
+size_t sReceiveCount = 0;
+
+class CountingTransportMgrDelegate : public TransportMgrDelegate
+{
+public:
+    void OnMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msgBuf) override
+    {
+        sReceiveCount++;
+    }
+};
+
+// Frames one message of kMessageLength bytes, size prefix included, as it arrives on a connection.
+CHIP_ERROR BuildFrame(uint8_t * frame)
+{
+    PacketHeader header;
+    uint16_t headerSize;
+
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+    Encoding::LittleEndian::Put16(frame, kMessageLength - kPacketSizeBytes);
+    ReturnErrorOnFailure(header.Encode(frame + kPacketSizeBytes, kMessageLength - kPacketSizeBytes, &headerSize));
+    for (size_t i = kPacketSizeBytes + headerSize; i < kMessageLength; i++)
+    {
+        frame[i] = static_cast<uint8_t>(i);
+    }
+    return CHIP_NO_ERROR;
+}
+
+// Feeds kMessageCount frames to the transport in segments of the given size. Returns messages reassembled per second,
+// or 0 on failure.
+uint64_t RunReassembly(Transport::TCPBase & tcp, Inet::TCPEndPoint * endPoint, const Transport::PeerAddress & peerAddress,
+                       const uint8_t * frame, size_t segmentSize)
+{
+    sReceiveCount = 0;
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        for (size_t offset = 0; offset < kMessageLength; offset += segmentSize)
+        {
+            size_t length = std::min(segmentSize, kMessageLength - offset);
+            System::PacketBufferHandle buffer =
+                System::PacketBufferHandle::NewWithData(frame + offset, length, 0 /* additional size */, 0 /* reserved size */);
+            VerifyOrReturnError(!buffer.IsNull(), 0);
+            VerifyOrReturnError(Transport::TCPTest::ProcessReceivedBuffer(tcp, endPoint, peerAddress, std::move(buffer)) ==
+                                    CHIP_NO_ERROR,
+                                0);
+        }
+    }
+
+    uint64_t elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+    VerifyOrReturnError(sReceiveCount == kMessageCount, 0);
+    return (elapsed > 0) ? kMessageCount * 1000000 / elapsed : 0;
+}
+
+} // namespace
+
+int main()
+{
+    Transport::TCP<1, 1> tcp;
+    CountingTransportMgrDelegate delegate;
+    TransportMgrBase transportMgr;
+    Inet::IPAddress addr;
+    uint8_t endPointStorage;
+    uint8_t frame[kMessageLength];
+    int result = EXIT_SUCCESS;
+
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+    VerifyOrDie(BuildFrame(frame) == CHIP_NO_ERROR);
+
+    transportMgr.SetSecureSessionMgr(&delegate);
+    transportMgr.Init(&tcp);
+
+    Inet::IPAddress::FromString("::1", addr);
+    Inet::TCPEndPoint * endPoint             = reinterpret_cast<Inet::TCPEndPoint *>(&endPointStorage);
+    const Transport::PeerAddress peerAddress = Transport::PeerAddress::TCP(addr);
+    VerifyOrDie(Transport::TCPTest::AddConnection(tcp, endPoint, peerAddress) == CHIP_NO_ERROR);
+
+    for (size_t segmentSize : kSegmentSizes)
+    {
+        uint64_t rate = RunReassembly(tcp, endPoint, peerAddress, frame, segmentSize);
+
+        if (rate == 0)
+        {
+            result = EXIT_FAILURE;
+        }
+
+        printf("TCP reassembly of %u byte messages from %4u byte segments: %" PRIu64 " msgs/s\n",
+               static_cast<unsigned>(kMessageLength), static_cast<unsigned>(segmentSize), rate);
+    }
+
+    Transport::TCPTest::ForgetConnection(tcp, endPoint);
+    Platform::MemoryShutdown();
+
+    return result;
+}
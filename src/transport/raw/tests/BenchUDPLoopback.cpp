@@ -0,0 +1,125 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of UDP loopback throughput with and
+ *      without batched sends.
+ */
+
+#include "NetworkTestHelpers.h"
+
+#include <core/CHIPCore.h>
+#include <support/CodeUtils.h>
+#include <transport/TransportMgr.h>
+#include <transport/raw/UDP.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace chip;
+using namespace chip::Inet;
+
+namespace {
+
+constexpr NodeId kSourceNodeId      = 123654;
+constexpr NodeId kDestinationNodeId = 111222333;
+constexpr uint32_t kMessageId       = 18;
+
+constexpr size_t kBurstSize    = 64;
+constexpr size_t kBurstCount   = 100;
+constexpr size_t kMessageCount = kBurstSize * kBurstCount;
+
+const char PAYLOAD[] = "Hello!";
+size_t sReceiveCount = 0;
+
+class CountingTransportMgrDelegate : public TransportMgrDelegate
+{
+public:
+    void OnMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msgBuf) override
+    {
+        sReceiveCount++;
+    }
+};
+
+// Returns the time taken to send and receive kMessageCount messages, in microseconds, or 0 on failure.
+uint64_t RunLoopback(Test::IOContext & ctx, const IPAddress & addr, bool batchSends)
+{
+    Transport::UDP udp;
+    CountingTransportMgrDelegate delegate;
+    TransportMgrBase transportMgr;
+    PacketHeader header;
+
+    CHIP_ERROR err =
+        udp.Init(Transport::UdpListenParameters(&ctx.GetInetLayer()).SetAddressType(addr.Type()).SetBatchSends(batchSends));
+    VerifyOrReturnError(err == CHIP_NO_ERROR, 0);
+
+    transportMgr.SetSecureSessionMgr(&delegate);
+    transportMgr.Init(&udp);
+
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t burst = 0; burst < kBurstCount; burst++)
+    {
+        sReceiveCount = 0;
+
+        for (size_t i = 0; i < kBurstSize; i++)
+        {
+            System::PacketBufferHandle buffer = System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+            VerifyOrReturnError(!buffer.IsNull(), 0);
+            VerifyOrReturnError(header.EncodeBeforeData(buffer) == CHIP_NO_ERROR, 0);
+            VerifyOrReturnError(udp.SendMessage(Transport::PeerAddress::UDP(addr), std::move(buffer)) == CHIP_NO_ERROR, 0);
+        }
+
+        ctx.DriveIOUntil(1000 /* ms */, []() { return sReceiveCount == kBurstSize; });
+        VerifyOrReturnError(sReceiveCount == kBurstSize, 0);
+    }
+
+    return System::Layer::GetClock_MonotonicHiRes() - start;
+}
+
+} // namespace
+
+int main()
+{
+    Test::IOContext ctx;
+    IPAddress addr;
+
+    VerifyOrDie(ctx.Init(nullptr) == CHIP_NO_ERROR);
+    IPAddress::FromString("127.0.0.1", addr);
+
+    uint64_t unbatchedTime = RunLoopback(ctx, addr, false);
+    uint64_t batchedTime   = RunLoopback(ctx, addr, true);
+
+    ctx.Shutdown();
+
+    if (unbatchedTime == 0 || batchedTime == 0)
+    {
+        printf("UDP loopback lost messages\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("UDP loopback, %u messages: unbatched %" PRIu64 " msgs/s, batched %" PRIu64 " msgs/s (batch size %u)\n",
+           static_cast<unsigned>(kMessageCount), kMessageCount * 1000000 / unbatchedTime, kMessageCount * 1000000 / batchedTime,
+           static_cast<unsigned>(INET_CONFIG_UDP_BATCH_SIZE));
+
+    return EXIT_SUCCESS;
+}
@@ -53,6 +53,15 @@ class TCPTest
 {
 public:
     static void CheckProcessReceivedBuffer(nlTestSuite * inSuite, void * inContext);
+    static void CheckSplitFrames(nlTestSuite * inSuite, void * inContext);
+    static void CheckConnectionIndex(nlTestSuite * inSuite, void * inContext);
+    static void CheckPendingPacketQueues(nlTestSuite * inSuite, void * inContext);
+
+    static CHIP_ERROR ProcessReceivedBuffer(TCPBase & tcp, Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
+                                            System::PacketBufferHandle && buffer)
+    {
+        return tcp.ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
+    }
 };
 } // namespace Transport
 } // namespace chip
@@ -116,9 +125,22 @@ public:
         mReceiveHandlerCallCount = 0;
     }
 
-    void SingleMessageTest(TCPImpl & tcp, const IPAddress & addr)
+    void SingleMessageTest(TCPImpl & tcp, const IPAddress & addr, bool chained = false)
     {
-        chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        chip::System::PacketBufferHandle buffer;
+        if (chained)
+        {
+            // Split the payload over two buffers; the endpoint sends them without compacting.
+            constexpr uint16_t kSplit = 3;
+            buffer                    = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, kSplit);
+            NL_TEST_ASSERT(mSuite, !buffer.IsNull());
+            buffer->AddToEnd(chip::System::PacketBufferHandle::NewWithData(PAYLOAD + kSplit, sizeof(PAYLOAD) - kSplit));
+            NL_TEST_ASSERT(mSuite, buffer->HasChainedBuffer());
+        }
+        else
+        {
+            buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        }
         NL_TEST_ASSERT(mSuite, !buffer.IsNull());
 
         PacketHeader header;
@@ -192,14 +214,14 @@ void CheckSimpleInitTest6(nlTestSuite * inSuite, void * inContext)
 
 /////////////////////////// Messaging test
 
-void CheckMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+void CheckMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr, bool chained = false)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
     TCPImpl tcp;
 
     MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
     gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
-    gMockTransportMgrDelegate.SingleMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.SingleMessageTest(tcp, addr, chained);
     gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
 }
 
@@ -217,6 +239,74 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+void CheckChainedMessageTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckMessageTest(inSuite, inContext, addr, true);
+}
+
+void CheckChainedMessageTest6(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckMessageTest(inSuite, inContext, addr, true);
+}
+
+/////////////////////////// Burst test
+
+#if INET_CONFIG_ENABLE_IPV4
+void CheckBurstMessageTest4(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kNumBursts        = 100;
+    constexpr int kBurstSize        = 32;
+    constexpr uint16_t kPayloadSize = 64;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+    IPAddress addr;
+    uint8_t payload[kPayloadSize];
+
+    IPAddress::FromString("127.0.0.1", addr);
+    memset(payload, 0x5A, sizeof(payload));
+
+    // Bursts of small messages go out on an established connection, where they are coalesced.
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.SingleMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    gMockTransportMgrDelegate.SetCallback(
+        [](const uint8_t * message, size_t length, int count, void * data) {
+            return (length == kPayloadSize) ? memcmp(message, data, length) : -1;
+        },
+        payload);
+
+    for (int burst = 0; burst < kNumBursts; burst++)
+    {
+        for (int i = 0; i < kBurstSize; i++)
+        {
+            PacketHeader header;
+            System::PacketBufferHandle buffer = System::PacketBufferHandle::NewWithData(payload, sizeof(payload));
+            NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+            header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+            NL_TEST_ASSERT(inSuite, header.EncodeBeforeData(buffer) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, tcp.SendMessage(Transport::PeerAddress::TCP(addr), std::move(buffer)) == CHIP_NO_ERROR);
+        }
+
+        int expected = (burst + 1) * kBurstSize;
+        ctx.DriveIOUntil(5000 /* ms */, [&gMockTransportMgrDelegate, expected]() {
+            return gMockTransportMgrDelegate.mReceiveHandlerCallCount >= expected;
+        });
+    }
+
+    NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == kNumBursts * kBurstSize);
+
+    gMockTransportMgrDelegate.SetCallback(nullptr);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+}
+#endif // INET_CONFIG_ENABLE_IPV4
+
 // Generates a packet buffer or a chain of packet buffers for a single message.
 struct TestData
 {
@@ -438,6 +528,219 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
 }
 
+namespace {
+
+// Feeds `stream` to the transport in buffers of the given sizes, cycling through them, and returns the number of messages
+// passed upstream.
+int ProcessStream(nlTestSuite * inSuite, Transport::TCPBase & tcp, MockTransportMgrDelegate & delegate,
+                  Inet::TCPEndPoint * endPoint, const Transport::PeerAddress & peerAddress, const uint8_t * stream,
+                  size_t streamLength, const size_t * segmentSizes, size_t numSegmentSizes);
+
+} // namespace
+
+void chip::Transport::TCPTest::CheckSplitFrames(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kNumMessages = 3;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    TCPImpl tcp;
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite, ctx);
+    gMockTransportMgrDelegate.InitializeMessageTest(tcp, addr);
+    gMockTransportMgrDelegate.SingleMessageTest(tcp, addr);
+
+    Transport::PeerAddress lPeerAddress    = Transport::PeerAddress::TCP(addr);
+    TCPBase::ActiveConnectionState * state = tcp.FindActiveConnection(lPeerAddress);
+    NL_TEST_ASSERT(inSuite, state != nullptr);
+    Inet::TCPEndPoint * lEndPoint = state->mEndPoint;
+    NL_TEST_ASSERT(inSuite, lEndPoint != nullptr);
+
+    // A stream of a short, a medium and a long message, back to back.
+    TestData testData[kNumMessages];
+    NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 30, 0 }));
+    NL_TEST_ASSERT(inSuite, testData[1].Init((const uint16_t[]){ 300, 0 }));
+    NL_TEST_ASSERT(inSuite, testData[2].Init((const uint16_t[]){ 1200, 0 }));
+    gMockTransportMgrDelegate.SetCallback(TestDataCallbackCheck, testData);
+
+    uint8_t stream[30 + 300 + 1200];
+    size_t streamLength = 0;
+    for (const TestData & data : testData)
+    {
+        memcpy(stream + streamLength, data.mPayload, data.mTotalLength);
+        streamLength += data.mTotalLength;
+    }
+
+    // Split the stream in two at every byte offset.
+    for (size_t offset = 1; offset < streamLength; offset++)
+    {
+        const size_t segmentSizes[] = { offset, streamLength - offset };
+        int count = ProcessStream(inSuite, tcp, gMockTransportMgrDelegate, lEndPoint, lPeerAddress, stream, streamLength,
+                                  segmentSizes, 2);
+        NL_TEST_ASSERT(inSuite, count == kNumMessages);
+    }
+
+    // Cut the stream into buffers of every size up to that of the long message, and of random sizes.
+    for (size_t size = 1; size <= testData[2].mTotalLength; size++)
+    {
+        int count = ProcessStream(inSuite, tcp, gMockTransportMgrDelegate, lEndPoint, lPeerAddress, stream, streamLength, &size, 1);
+        NL_TEST_ASSERT(inSuite, count == kNumMessages);
+    }
+    unsigned int seed = 1;
+    for (int round = 0; round < 1000; round++)
+    {
+        size_t segmentSizes[16];
+        for (size_t & size : segmentSizes)
+        {
+            seed = seed * 1103515245 + 12345;
+            size = 1 + (seed >> 16) % 200;
+        }
+        int count = ProcessStream(inSuite, tcp, gMockTransportMgrDelegate, lEndPoint, lPeerAddress, stream, streamLength,
+                                  segmentSizes, ArraySize(segmentSizes));
+        NL_TEST_ASSERT(inSuite, count == kNumMessages);
+    }
+
+    gMockTransportMgrDelegate.SetCallback(nullptr);
+    gMockTransportMgrDelegate.FinalizeMessageTest(tcp, addr);
+}
+
+void chip::Transport::TCPTest::CheckConnectionIndex(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kNumConnections = 256;
+
+    // The endpoints are only hashed and compared, never used, so the connections are taken out of the indexes by hand
+    // rather than released.
+    static TCP<kNumConnections, 1> tcp;
+    static uint8_t endPointStorage[kNumConnections];
+    auto endPoint    = [](size_t i) { return reinterpret_cast<Inet::TCPEndPoint *>(&endPointStorage[i]); };
+    auto peerAddress = [](size_t i) {
+        IPAddress addr;
+        IPAddress::FromString((i % 2 == 0) ? "fd00::1" : "10.0.0.1", addr);
+        addr.Addr[3] ^= static_cast<uint32_t>(i / 4);
+        return PeerAddress::TCP(addr, static_cast<uint16_t>(CHIP_PORT + i % 4));
+    };
+    auto forget = [](TCPBase::ActiveConnectionState * connection) {
+        tcp.RemoveFromIndex(tcp.mPeerIndex, TCPBase::PeerHash(connection->mPeerAddress), connection);
+        tcp.RemoveFromIndex(tcp.mEndPointIndex, TCPBase::EndPointHash(connection->mEndPoint), connection);
+        connection->Init(nullptr, PeerAddress::Uninitialized(), false);
+        tcp.mUsedEndPointCount--;
+    };
+
+    for (size_t i = 0; i < kNumConnections; i++)
+    {
+        NL_TEST_ASSERT(inSuite, tcp.AddConnection(endPoint(i), peerAddress(i), false) != nullptr);
+    }
+    NL_TEST_ASSERT(inSuite, tcp.AddConnection(endPoint(0), peerAddress(kNumConnections), false) == nullptr);
+
+    for (size_t i = 0; i < kNumConnections; i++)
+    {
+        TCPBase::ActiveConnectionState * connection = tcp.FindActiveConnection(peerAddress(i));
+        NL_TEST_ASSERT(inSuite, connection != nullptr && connection->mEndPoint == endPoint(i));
+        NL_TEST_ASSERT(inSuite, tcp.FindActiveConnection(endPoint(i)) == connection);
+    }
+    NL_TEST_ASSERT(inSuite, tcp.FindActiveConnection(peerAddress(kNumConnections)) == nullptr);
+
+    // Entries probed past the ones taken out must still be found.
+    for (size_t i = 0; i < kNumConnections; i += 3)
+    {
+        forget(tcp.FindActiveConnection(endPoint(i)));
+    }
+    for (size_t i = 0; i < kNumConnections; i++)
+    {
+        bool removed = (i % 3 == 0);
+        NL_TEST_ASSERT(inSuite, (tcp.FindActiveConnection(peerAddress(i)) == nullptr) == removed);
+        NL_TEST_ASSERT(inSuite, (tcp.FindActiveConnection(endPoint(i)) == nullptr) == removed);
+    }
+
+    // Connections added again reuse the freed slots and are found alongside the ones that stayed.
+    for (size_t i = 0; i < kNumConnections; i += 3)
+    {
+        NL_TEST_ASSERT(inSuite, tcp.AddConnection(endPoint(i), peerAddress(i), false) != nullptr);
+    }
+    for (size_t i = 0; i < kNumConnections; i++)
+    {
+        TCPBase::ActiveConnectionState * connection = tcp.FindActiveConnection(peerAddress(i));
+        NL_TEST_ASSERT(inSuite, connection != nullptr && connection->mEndPoint == endPoint(i));
+        NL_TEST_ASSERT(inSuite, tcp.FindActiveConnection(endPoint(i)) == connection);
+    }
+
+    for (size_t i = 0; i < kNumConnections; i++)
+    {
+        forget(tcp.FindActiveConnection(endPoint(i)));
+    }
+    NL_TEST_ASSERT(inSuite, !tcp.HasActiveConnections());
+}
+
+void chip::Transport::TCPTest::CheckPendingPacketQueues(nlTestSuite * inSuite, void * inContext)
+{
+    TCP<2, 5> tcp;
+    TCPBase::ActiveConnectionState & first  = tcp.mConnectionsBuffer[0];
+    TCPBase::ActiveConnectionState & second = tcp.mConnectionsBuffer[1];
+
+    // Packets are told apart by their length.
+    auto enqueue = [&tcp](TCPBase::ActiveConnectionState & connection, uint16_t length) {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(length, 0);
+        VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+        buffer->SetDataLength(length);
+        return tcp.EnqueuePendingPacket(&connection, std::move(buffer));
+    };
+    auto dequeue = [&tcp](TCPBase::ActiveConnectionState & connection) {
+        return tcp.DequeuePendingPacket(&connection)->DataLength();
+    };
+
+    // The queues draw from the shared pool in any proportion, and keep their own order.
+    NL_TEST_ASSERT(inSuite, enqueue(first, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, enqueue(second, 11) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, enqueue(first, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, enqueue(first, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, enqueue(second, 12) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, enqueue(first, 4) == CHIP_ERROR_NO_MEMORY);
+
+    NL_TEST_ASSERT(inSuite, dequeue(first) == 1);
+    NL_TEST_ASSERT(inSuite, dequeue(first) == 2);
+    NL_TEST_ASSERT(inSuite, enqueue(first, 4) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dequeue(first) == 3);
+    NL_TEST_ASSERT(inSuite, dequeue(second) == 11);
+    NL_TEST_ASSERT(inSuite, dequeue(second) == 12);
+    NL_TEST_ASSERT(inSuite, second.mPendingHead == nullptr && second.mPendingTail == nullptr);
+    NL_TEST_ASSERT(inSuite, dequeue(first) == 4);
+    NL_TEST_ASSERT(inSuite, first.mPendingHead == nullptr && first.mPendingTail == nullptr);
+
+    // All packets are back in the pool.
+    for (uint16_t length = 1; length <= 5; length++)
+    {
+        NL_TEST_ASSERT(inSuite, enqueue(second, length) == CHIP_NO_ERROR);
+    }
+    for (uint16_t length = 1; length <= 5; length++)
+    {
+        NL_TEST_ASSERT(inSuite, dequeue(second) == length);
+    }
+}
+
+namespace {
+
+int ProcessStream(nlTestSuite * inSuite, Transport::TCPBase & tcp, MockTransportMgrDelegate & delegate,
+                  Inet::TCPEndPoint * endPoint, const Transport::PeerAddress & peerAddress, const uint8_t * stream,
+                  size_t streamLength, const size_t * segmentSizes, size_t numSegmentSizes)
+{
+    delegate.mReceiveHandlerCallCount = 0;
+    for (size_t offset = 0, i = 0; offset < streamLength; i = (i + 1) % numSegmentSizes)
+    {
+        size_t length = std::min(segmentSizes[i], streamLength - offset);
+        System::PacketBufferHandle buffer =
+            System::PacketBufferHandle::NewWithData(stream + offset, length, 0 /* additional size */, 0 /* reserved size */);
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+        CHIP_ERROR err = Transport::TCPTest::ProcessReceivedBuffer(tcp, endPoint, peerAddress, std::move(buffer));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        offset += length;
+    }
+    return delegate.mReceiveHandlerCallCount;
+}
+
+} // namespace
+
 // Test Suite
 /**
  *  Test Suite that lists all the test functions.
@@ -448,11 +751,17 @@ static const nlTest sTests[] =
 #if INET_CONFIG_ENABLE_IPV4
     NL_TEST_DEF("Simple Init Test IPV4",        CheckSimpleInitTest4),
     NL_TEST_DEF("Message Self Test IPV4",       CheckMessageTest4),
+    NL_TEST_DEF("Chained Message Test IPV4",    CheckChainedMessageTest4),
+    NL_TEST_DEF("Burst Message Test IPV4",      CheckBurstMessageTest4),
 #endif
 
     NL_TEST_DEF("Simple Init Test IPV6",        CheckSimpleInitTest6),
     NL_TEST_DEF("Message Self Test IPV6",       CheckMessageTest6),
+    NL_TEST_DEF("Chained Message Test IPV6",    CheckChainedMessageTest6),
     NL_TEST_DEF("ProcessReceivedBuffer Test",   chip::Transport::TCPTest::CheckProcessReceivedBuffer),
+    NL_TEST_DEF("Split Frames Test",            chip::Transport::TCPTest::CheckSplitFrames),
+    NL_TEST_DEF("Connection Index Test",        chip::Transport::TCPTest::CheckConnectionIndex),
+    NL_TEST_DEF("Pending Packet Queues Test",   chip::Transport::TCPTest::CheckPendingPacketQueues),
 
     NL_TEST_SENTINEL()
 };
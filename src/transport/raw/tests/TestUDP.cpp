@@ -109,13 +109,26 @@ void CheckSimpleInitTest6(nlTestSuite * inSuite, void * inContext)
 
 /////////////////////////// Messaging test
 
-void CheckMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+void CheckMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr, bool chained = false)
 {
     TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
 
     uint16_t payload_len = sizeof(PAYLOAD);
 
-    chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, payload_len);
+    chip::System::PacketBufferHandle buffer;
+    if (chained)
+    {
+        // Split the payload over two buffers; the transport sends them as one datagram.
+        constexpr uint16_t kSplit = 3;
+        buffer                    = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, kSplit);
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+        buffer->AddToEnd(chip::System::PacketBufferHandle::NewWithData(PAYLOAD + kSplit, payload_len - kSplit));
+        NL_TEST_ASSERT(inSuite, buffer->HasChainedBuffer());
+    }
+    else
+    {
+        buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, payload_len);
+    }
     NL_TEST_ASSERT(inSuite, !buffer.IsNull());
 
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -169,6 +182,85 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+void CheckChainedMessageTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckMessageTest(inSuite, inContext, addr, true);
+}
+
+void CheckChainedMessageTest6(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckMessageTest(inSuite, inContext, addr, true);
+}
+
+/////////////////////////// Batched messaging test
+
+constexpr size_t kBatchedMessageCount = 3 * INET_CONFIG_UDP_BATCH_SIZE + 1;
+
+void CheckBatchedMessageTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Transport::UDP udp;
+
+    err = udp.Init(Transport::UdpListenParameters(&ctx.GetInetLayer()).SetAddressType(addr.Type()).SetBatchSends(true));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite);
+    TransportMgrBase gTransportMgrBase;
+    gTransportMgrBase.SetSecureSessionMgr(&gMockTransportMgrDelegate);
+    gTransportMgrBase.Init(&udp);
+
+    ReceiveHandlerCallCount = 0;
+
+    PacketHeader header;
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageId(kMessageId);
+
+    for (size_t i = 0; i < kBatchedMessageCount; i++)
+    {
+        chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+        err = header.EncodeBeforeData(buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+        err = udp.SendMessage(Transport::PeerAddress::UDP(addr), std::move(buffer));
+        if (err == System::MapErrorPOSIX(EADDRNOTAVAIL))
+        {
+            // TODO(#2698): the underlying system does not support IPV6. This early return
+            // should be removed and error should be made fatal.
+            printf("%s:%u: System does NOT support IPV6.\n", __FILE__, __LINE__);
+            return;
+        }
+
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    // The last message is left in the queue until the event loop flushes it.
+    ctx.DriveIOUntil(1000 /* ms */, []() { return ReceiveHandlerCallCount == static_cast<int>(kBatchedMessageCount); });
+
+    NL_TEST_ASSERT(inSuite, ReceiveHandlerCallCount == static_cast<int>(kBatchedMessageCount));
+}
+
+void CheckBatchedMessageTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckBatchedMessageTest(inSuite, inContext, addr);
+}
+
+void CheckBatchedMessageTest6(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckBatchedMessageTest(inSuite, inContext, addr);
+}
+
 // Test Suite
 
 /**
@@ -180,10 +272,14 @@ static const nlTest sTests[] =
 #if INET_CONFIG_ENABLE_IPV4
     NL_TEST_DEF("Simple Init Test IPV4",   CheckSimpleInitTest4),
     NL_TEST_DEF("Message Self Test IPV4",  CheckMessageTest4),
+    NL_TEST_DEF("Chained Message Test IPV4", CheckChainedMessageTest4),
+    NL_TEST_DEF("Batched Message Test IPV4", CheckBatchedMessageTest4),
 #endif
 
     NL_TEST_DEF("Simple Init Test IPV6",   CheckSimpleInitTest6),
     NL_TEST_DEF("Message Self Test IPV6",  CheckMessageTest6),
+    NL_TEST_DEF("Chained Message Test IPV6", CheckChainedMessageTest6),
+    NL_TEST_DEF("Batched Message Test IPV6", CheckBatchedMessageTest6),
 
     NL_TEST_SENTINEL()
 };
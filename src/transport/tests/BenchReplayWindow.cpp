@@ -0,0 +1,96 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of the replay window throughput of
+ *      MessageCounterWindow against a window shifting a std::bitset, for
+ *      windows of 32 to 4096 counters.
+ */
+
+#include "ReplayWindowReference.h"
+
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+#include <transport/PeerMessageCounter.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace chip;
+using namespace chip::Transport;
+using chip::Test::BitsetWindow;
+using chip::Test::CounterSource;
+
+namespace {
+
+constexpr size_t kIterations = 200000;
+
+// Checks kIterations counters spread over the window size. Returns counters per second, or 0 on failure.
+template <typename Window>
+uint64_t RunWindowBenchmark(uint32_t spread)
+{
+    Window window;
+    CounterSource source(0, spread);
+    size_t accepted = 0;
+
+    window.Reset(0);
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        uint32_t counter = source.Next();
+        if (window.IsValid(counter))
+        {
+            window.Mark(counter);
+            accepted++;
+        }
+    }
+
+    uint64_t elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+
+    // Keep the loop from being optimized away
+    VerifyOrReturnError(accepted > 0, 0);
+    return (elapsed > 0) ? kIterations * 1000000 / elapsed : 0;
+}
+
+template <size_t kWindowSize>
+bool PrintWindowBenchmark()
+{
+    uint64_t bitset = RunWindowBenchmark<BitsetWindow<kWindowSize>>(kWindowSize);
+    uint64_t ring   = RunWindowBenchmark<MessageCounterWindow<kWindowSize>>(kWindowSize);
+
+    printf("Replay window of %5u counters: bitset %" PRIu64 " counters/s, ring %" PRIu64 " counters/s\n",
+           static_cast<unsigned>(kWindowSize), bitset, ring);
+
+    return bitset != 0 && ring != 0;
+}
+
+} // namespace
+
+int main()
+{
+    bool ok = PrintWindowBenchmark<32>();
+    ok      = PrintWindowBenchmark<256>() && ok;
+    ok      = PrintWindowBenchmark<1024>() && ok;
+    ok      = PrintWindowBenchmark<4096>() && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,137 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark of SecureSession encrypt+decrypt
+ *      throughput for separate buffers, one packet buffer encrypted in place
+ *      and a chain of two packet buffers encrypted in place.
+ */
+
+#include <core/CHIPCore.h>
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+#include <system/SystemLayer.h>
+#include <transport/SecureSession.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace chip;
+using namespace Crypto;
+using System::PacketBufferHandle;
+
+namespace {
+
+enum class BenchmarkMode
+{
+    kContiguous, // separate input and output buffers
+    kInPlace,    // one packet buffer, encrypted in place
+    kChained,    // a chain of two packet buffers, encrypted in place
+};
+
+constexpr size_t kMessageCount   = 10000;
+constexpr size_t kPayloadSizes[] = { 64, 512, 1024 };
+
+CHIP_ERROR InitChannelPair(SecureSession & initiator, SecureSession & responder)
+{
+    const char * salt = "Test Salt";
+    P256Keypair keypair;
+    P256Keypair keypair2;
+
+    ReturnErrorOnFailure(keypair.Initialize());
+    ReturnErrorOnFailure(keypair2.Initialize());
+    ReturnErrorOnFailure(initiator.Init(keypair, keypair2.Pubkey(), ByteSpan((const uint8_t *) salt, sizeof(salt)),
+                                        SecureSession::SessionInfoType::kSessionEstablishment,
+                                        SecureSession::SessionRole::kInitiator));
+    return responder.Init(keypair2, keypair.Pubkey(), ByteSpan((const uint8_t *) salt, sizeof(salt)),
+                          SecureSession::SessionInfoType::kSessionEstablishment, SecureSession::SessionRole::kResponder);
+}
+
+// Returns the number of messages encrypted and decrypted per second, or 0 on failure.
+uint64_t RunEncryptDecrypt(SecureSession & channel, SecureSession & channel2, size_t payloadSize, BenchmarkMode mode)
+{
+    uint8_t plain_text[1024] = { 0 };
+    uint8_t encrypted[sizeof(plain_text)];
+    PacketHeader packetHeader;
+    MessageAuthenticationCode mac;
+
+    VerifyOrReturnError(payloadSize <= sizeof(plain_text), 0);
+
+    uint64_t start = System::Layer::GetClock_MonotonicHiRes();
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        const size_t headLength = (mode == BenchmarkMode::kChained) ? payloadSize / 2 : payloadSize;
+
+        PacketBufferHandle msg = PacketBufferHandle::NewWithData(plain_text, headLength);
+        VerifyOrReturnError(!msg.IsNull(), 0);
+        if (headLength < payloadSize)
+        {
+            msg->AddToEnd(PacketBufferHandle::NewWithData(&plain_text[headLength], payloadSize - headLength));
+        }
+        packetHeader.SetMessageId(static_cast<uint32_t>(i));
+
+        if (mode == BenchmarkMode::kContiguous)
+        {
+            VerifyOrReturnError(channel.Encrypt(msg->Start(), payloadSize, encrypted, packetHeader, mac) == CHIP_NO_ERROR, 0);
+            VerifyOrReturnError(channel2.Decrypt(encrypted, payloadSize, msg->Start(), packetHeader, mac) == CHIP_NO_ERROR, 0);
+        }
+        else
+        {
+            VerifyOrReturnError(channel.Encrypt(msg, packetHeader, mac) == CHIP_NO_ERROR, 0);
+            VerifyOrReturnError(channel2.Decrypt(msg, packetHeader, mac) == CHIP_NO_ERROR, 0);
+        }
+    }
+
+    uint64_t elapsed = System::Layer::GetClock_MonotonicHiRes() - start;
+    return (elapsed > 0) ? kMessageCount * 1000000 / elapsed : 0;
+}
+
+} // namespace
+
+int main()
+{
+    SecureSession channel;
+    SecureSession channel2;
+    int result = EXIT_SUCCESS;
+
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
+    VerifyOrDie(InitChannelPair(channel, channel2) == CHIP_NO_ERROR);
+
+    for (size_t payloadSize : kPayloadSizes)
+    {
+        uint64_t contiguous = RunEncryptDecrypt(channel, channel2, payloadSize, BenchmarkMode::kContiguous);
+        uint64_t inPlace    = RunEncryptDecrypt(channel, channel2, payloadSize, BenchmarkMode::kInPlace);
+        uint64_t chained    = RunEncryptDecrypt(channel, channel2, payloadSize, BenchmarkMode::kChained);
+
+        if (contiguous == 0 || inPlace == 0 || chained == 0)
+        {
+            result = EXIT_FAILURE;
+        }
+
+        printf("Encrypt+decrypt %4u byte messages: contiguous %" PRIu64 " msgs/s, in place %" PRIu64 " msgs/s, chained %" PRIu64
+               " msgs/s\n",
+               static_cast<unsigned>(payloadSize), contiguous, inPlace, chained);
+    }
+
+    Platform::MemoryShutdown();
+
+    return result;
+}
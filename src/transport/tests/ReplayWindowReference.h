@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a reference replay window and a source of message
+ *      counters, shared by the PeerMessageCounter tests and benchmark.
+ *
+ */
+
+#pragma once
+
+#include <bitset>
+#include <random>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Test {
+
+/**
+ * Replay window shifting a std::bitset, as PeerMessageCounter used to do. Used as a reference for MessageCounterWindow.
+ */
+template <size_t kWindowSize>
+class BitsetWindow
+{
+public:
+    void Reset(uint32_t maxCounter)
+    {
+        mMaxCounter = maxCounter;
+        mWindow.reset();
+    }
+
+    bool IsValid(uint32_t counter) const
+    {
+        if (counter <= mMaxCounter)
+        {
+            uint32_t offset = mMaxCounter - counter;
+            return offset < kWindowSize && !mWindow.test(offset);
+        }
+        return true;
+    }
+
+    void Mark(uint32_t counter)
+    {
+        if (counter <= mMaxCounter)
+        {
+            mWindow.set(mMaxCounter - counter);
+        }
+        else
+        {
+            uint32_t offset = counter - mMaxCounter;
+            mMaxCounter     = counter;
+            if (offset < kWindowSize)
+            {
+                mWindow <<= offset;
+            }
+            else
+            {
+                mWindow.reset();
+            }
+            mWindow.set(0);
+        }
+    }
+
+private:
+    uint32_t mMaxCounter = 0;
+    std::bitset<kWindowSize> mWindow;
+};
+
+/**
+ * Counters as received on a lossy network that reorders and duplicates messages: mostly in order, sometimes from a bit
+ * behind or ahead, and sometimes far ahead after a burst of losses.
+ */
+class CounterSource
+{
+public:
+    CounterSource(uint32_t start, uint32_t spread) : mNext(start), mSpread(spread) {}
+
+    uint32_t Next()
+    {
+        uint32_t roll = Random(100);
+
+        if (roll < 60)
+        {
+            return mNext++;
+        }
+        if (roll < 85)
+        {
+            uint32_t back = Random(mSpread + 1);
+            return (back < mNext) ? mNext - back : 0;
+        }
+        if (roll < 97)
+        {
+            mNext += Random(mSpread + 1);
+            return mNext;
+        }
+
+        mNext += Random(4 * mSpread + 1);
+        return mNext;
+    }
+
+private:
+    uint32_t Random(uint32_t bound) { return static_cast<uint32_t>(mRandom() % bound); }
+
+    std::minstd_rand mRandom;
+    uint32_t mNext;
+    uint32_t mSpread;
+};
+
+} // namespace Test
+} // namespace chip
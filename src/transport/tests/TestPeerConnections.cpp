@@ -284,6 +284,97 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3Addr, nullptr));
 }
 
+void TestIndexFollowsStateChanges(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    PeerConnectionState * statePtr;
+    PeerConnections<3, Time::Source::kTest> connections;
+
+    err = connections.CreateNewPeerConnectionState(Optional<NodeId>::Missing(), 1, 2, &statePtr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Fields modified in place on a pooled state must be visible to lookups
+    statePtr->SetPeerAddress(kPeer1Addr);
+    statePtr->SetPeerNodeId(kPeer1NodeId);
+    statePtr->SetPeerKeyID(5);
+    statePtr->SetLocalKeyID(6);
+
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1Addr, nullptr) == statePtr);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1NodeId, nullptr) == statePtr);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(Optional<NodeId>::Value(kPeer1NodeId), 5, nullptr) == statePtr);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(static_cast<uint16_t>(6), nullptr) == statePtr);
+    NL_TEST_ASSERT(inSuite,
+                   connections.FindPeerConnectionStateByLocalKey(Optional<NodeId>::Value(kPeer1NodeId), 6, nullptr) == statePtr);
+
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(Optional<NodeId>::Missing(), 1, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(static_cast<uint16_t>(2), nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer2Addr, nullptr));
+
+    // Changes to a copy of a pooled state do not affect the pool
+    PeerConnectionState copy = *statePtr;
+    copy.SetPeerAddress(kPeer2Addr);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1Addr, nullptr) == statePtr);
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer2Addr, nullptr));
+
+    connections.MarkConnectionExpired(statePtr, [](const PeerConnectionState & state) {});
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer1Addr, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer1NodeId, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(static_cast<uint16_t>(6), nullptr));
+}
+
+void TestLargePool(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint16_t kCount     = 64;
+    constexpr NodeId kFirstNodeId = 1000;
+
+    CHIP_ERROR err;
+    int callCount = 0;
+    PeerConnectionState * statePtr;
+    PeerConnections<kCount, Time::Source::kTest> connections;
+
+    for (uint16_t i = 0; i < kCount; i++)
+    {
+        connections.GetTimeSource().SetCurrentMonotonicTimeMs(100u + i);
+        err = connections.CreateNewPeerConnectionState(Optional<NodeId>::Value(kFirstNodeId + i), i,
+                                                       static_cast<uint16_t>(kCount + i), &statePtr);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        statePtr->SetPeerAddress(PeerAddress::UDP(kPeer1Addr.GetIPAddress(), static_cast<uint16_t>(5000 + i)));
+    }
+
+    for (uint16_t i = 0; i < kCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, statePtr = connections.FindPeerConnectionState(static_cast<uint16_t>(kCount + i), nullptr));
+        NL_TEST_ASSERT(inSuite, statePtr->GetPeerKeyID() == i);
+        NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kFirstNodeId + i, nullptr) == statePtr);
+        NL_TEST_ASSERT(inSuite,
+                       connections.FindPeerConnectionState(Optional<NodeId>::Value(kFirstNodeId + i), i, nullptr) == statePtr);
+        NL_TEST_ASSERT(inSuite,
+                       connections.FindPeerConnectionState(
+                           PeerAddress::UDP(kPeer1Addr.GetIPAddress(), static_cast<uint16_t>(5000 + i)), nullptr) == statePtr);
+    }
+
+    // Keep the oldest connection alive; everything else created before time 140 expires
+    NL_TEST_ASSERT(inSuite, statePtr = connections.FindPeerConnectionState(kFirstNodeId, nullptr));
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(200);
+    connections.MarkConnectionActive(statePtr);
+
+    connections.ExpireInactiveConnections(60, [&callCount](const PeerConnectionState & state) { callCount++; });
+    NL_TEST_ASSERT(inSuite, callCount == 39);
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kFirstNodeId, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kFirstNodeId + 1, nullptr));
+    NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kFirstNodeId + 39, nullptr));
+    NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kFirstNodeId + 40, nullptr));
+
+    // Freed slots can be allocated again
+    for (uint16_t i = 0; i < 39; i++)
+    {
+        err = connections.CreateNewPeerConnectionState(kPeer2Addr, nullptr);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    err = connections.CreateNewPeerConnectionState(kPeer2Addr, nullptr);
+    NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+}
+
 } // namespace
 
 // clang-format off
@@ -294,6 +385,8 @@ static const nlTest sTests[] =
     NL_TEST_DEF("FindByNodeId", TestFindByNodeId),
     NL_TEST_DEF("FindByKeyId", TestFindByKeyId),
     NL_TEST_DEF("ExpireConnections", TestExpireConnections),
+    NL_TEST_DEF("IndexFollowsStateChanges", TestIndexFollowsStateChanges),
+    NL_TEST_DEF("LargePool", TestLargePool),
     NL_TEST_SENTINEL()
 };
 // clang-format on
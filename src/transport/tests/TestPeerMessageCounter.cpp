@@ -0,0 +1,183 @@
+/*
+ *
+ *    Copyright (c) 2021 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the replay window of
+ *      PeerMessageCounter within the transport layer
+ *
+ */
+#include "ReplayWindowReference.h"
+
+#include <support/CodeUtils.h>
+#include <support/UnitTestRegistration.h>
+#include <transport/PeerMessageCounter.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+using chip::Test::BitsetWindow;
+using chip::Test::CounterSource;
+
+template <size_t kWindowSize>
+void CheckAgainstBitset(nlTestSuite * inSuite, uint32_t start, uint32_t spread)
+{
+    constexpr size_t kIterations = 20000;
+
+    MessageCounterWindow<kWindowSize> window;
+    BitsetWindow<kWindowSize> reference;
+    CounterSource source(start, spread);
+    size_t mismatches = 0;
+
+    window.Reset(start);
+    reference.Reset(start);
+
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        uint32_t counter = source.Next();
+        bool valid       = reference.IsValid(counter);
+
+        if (window.IsValid(counter) != valid)
+        {
+            mismatches++;
+        }
+        if (valid)
+        {
+            window.Mark(counter);
+            reference.Mark(counter);
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, mismatches == 0);
+}
+
+void TestWindowBasics(nlTestSuite * inSuite, void * inContext)
+{
+    MessageCounterWindow<32> window;
+
+    window.Reset(100);
+    NL_TEST_ASSERT(inSuite, window.GetMaxCounter() == 100);
+
+    // Everything in the window is accepted after a reset, including the max counter itself
+    NL_TEST_ASSERT(inSuite, window.IsValid(100));
+    NL_TEST_ASSERT(inSuite, window.IsValid(69));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(68));
+    NL_TEST_ASSERT(inSuite, window.IsValid(101));
+
+    window.Mark(100);
+    NL_TEST_ASSERT(inSuite, !window.IsValid(100));
+    window.Mark(90);
+    NL_TEST_ASSERT(inSuite, !window.IsValid(90));
+    NL_TEST_ASSERT(inSuite, window.IsValid(91));
+
+    // Moving ahead by less than the window keeps the received counters
+    window.Mark(110);
+    NL_TEST_ASSERT(inSuite, window.GetMaxCounter() == 110);
+    NL_TEST_ASSERT(inSuite, !window.IsValid(110));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(100));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(90));
+    NL_TEST_ASSERT(inSuite, window.IsValid(105));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(78));
+
+    // Counters too old to be tracked are ignored
+    window.Mark(50);
+    NL_TEST_ASSERT(inSuite, window.GetMaxCounter() == 110);
+
+    // Moving far ahead forgets everything but the new counter
+    window.Mark(1000);
+    NL_TEST_ASSERT(inSuite, !window.IsValid(1000));
+    NL_TEST_ASSERT(inSuite, window.IsValid(999));
+    NL_TEST_ASSERT(inSuite, window.IsValid(969));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(968));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(110));
+}
+
+void TestLargeWindow(nlTestSuite * inSuite, void * inContext)
+{
+    MessageCounterWindow<1024> window;
+
+    window.Reset(0);
+    for (uint32_t counter = 2000; counter > 0; counter -= 2)
+    {
+        if (window.IsValid(counter))
+        {
+            window.Mark(counter);
+        }
+    }
+
+    // Even counters ahead of 2000 - 1024 were received, the odd ones are still expected
+    NL_TEST_ASSERT(inSuite, window.GetMaxCounter() == 2000);
+    NL_TEST_ASSERT(inSuite, !window.IsValid(2000));
+    NL_TEST_ASSERT(inSuite, window.IsValid(1999));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(978));
+    NL_TEST_ASSERT(inSuite, window.IsValid(977));
+    NL_TEST_ASSERT(inSuite, !window.IsValid(976));
+}
+
+void TestWindowMatchesBitset(nlTestSuite * inSuite, void * inContext)
+{
+    CheckAgainstBitset<1>(inSuite, 0, 4);
+    CheckAgainstBitset<32>(inSuite, 0, 32);
+    CheckAgainstBitset<64>(inSuite, 1000, 64);
+    CheckAgainstBitset<100>(inSuite, 12345, 150);
+    CheckAgainstBitset<1024>(inSuite, 0, 1024);
+    CheckAgainstBitset<4096>(inSuite, 7, 3000);
+}
+
+void TestPeerMessageCounterWindow(nlTestSuite * inSuite, void * inContext)
+{
+    PeerMessageCounter counter;
+
+    NL_TEST_ASSERT(inSuite, counter.Verify(1) == CHIP_ERROR_INCORRECT_STATE);
+
+    counter.SetCounter(50);
+    NL_TEST_ASSERT(inSuite, counter.IsSynchronized());
+    NL_TEST_ASSERT(inSuite, counter.Verify(50) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.Verify(51) == CHIP_NO_ERROR);
+
+    counter.Commit(51);
+    NL_TEST_ASSERT(inSuite, counter.GetCounter() == 51);
+    NL_TEST_ASSERT(inSuite, counter.Verify(51) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, counter.Verify(50) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.Verify(51 - CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE) == CHIP_ERROR_INVALID_ARGUMENT);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("WindowBasics", TestWindowBasics),
+    NL_TEST_DEF("LargeWindow", TestLargeWindow),
+    NL_TEST_DEF("WindowMatchesBitset", TestWindowMatchesBitset),
+    NL_TEST_DEF("PeerMessageCounterWindow", TestPeerMessageCounterWindow),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestPeerMessageCounterFn(void)
+{
+    nlTestSuite theSuite = { "Transport-PeerMessageCounter", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPeerMessageCounterFn)
@@ -28,11 +28,13 @@
 #include <transport/SecureSession.h>
 
 #include <stdarg.h>
+#include <support/CHIPMem.h>
 #include <support/CodeUtils.h>
 #include <support/UnitTestRegistration.h>
 
 using namespace chip;
 using namespace Crypto;
+using System::PacketBufferHandle;
 
 void SecureChannelInitTest(nlTestSuite * inSuite, void * inContext)
 {
@@ -151,6 +153,117 @@ void SecureChannelDecryptTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, sizeof(plain_text)) == 0);
 }
 
+static void InitChannelPair(nlTestSuite * inSuite, SecureSession & initiator, SecureSession & responder)
+{
+    const char * salt = "Test Salt";
+
+    P256Keypair keypair;
+    NL_TEST_ASSERT(inSuite, keypair.Initialize() == CHIP_NO_ERROR);
+
+    P256Keypair keypair2;
+    NL_TEST_ASSERT(inSuite, keypair2.Initialize() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite,
+                   initiator.Init(keypair, keypair2.Pubkey(), ByteSpan((const uint8_t *) salt, sizeof(salt)),
+                                  SecureSession::SessionInfoType::kSessionEstablishment,
+                                  SecureSession::SessionRole::kInitiator) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   responder.Init(keypair2, keypair.Pubkey(), ByteSpan((const uint8_t *) salt, sizeof(salt)),
+                                  SecureSession::SessionInfoType::kSessionEstablishment,
+                                  SecureSession::SessionRole::kResponder) == CHIP_NO_ERROR);
+}
+
+void SecureChannelChainedEncryptDecryptTest(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSession channel;
+    SecureSession channel2;
+    PacketHeader packetHeader;
+    MessageAuthenticationCode mac;
+    uint8_t plain_text[150];
+    uint8_t encrypted[sizeof(plain_text)];
+    uint8_t output[sizeof(plain_text)];
+
+    for (size_t i = 0; i < sizeof(plain_text); i++)
+    {
+        plain_text[i] = static_cast<uint8_t>(i);
+    }
+
+    // Uninitialized channel
+    PacketBufferHandle msg = PacketBufferHandle::NewWithData(plain_text, sizeof(plain_text));
+    NL_TEST_ASSERT(inSuite, !msg.IsNull());
+    NL_TEST_ASSERT(inSuite, channel.Encrypt(msg, packetHeader, mac) == CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+    InitChannelPair(inSuite, channel, channel2);
+
+    PacketBufferHandle empty;
+    NL_TEST_ASSERT(inSuite, channel.Encrypt(empty, packetHeader, mac) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Split the message over a chain of three buffers whose boundaries fall inside AES blocks.
+    msg = PacketBufferHandle::NewWithData(plain_text, 7);
+    NL_TEST_ASSERT(inSuite, !msg.IsNull());
+    msg->AddToEnd(PacketBufferHandle::NewWithData(&plain_text[7], 33));
+    msg->AddToEnd(PacketBufferHandle::NewWithData(&plain_text[40], sizeof(plain_text) - 40));
+    NL_TEST_ASSERT(inSuite, msg->TotalLength() == sizeof(plain_text));
+
+    NL_TEST_ASSERT(inSuite, channel.Encrypt(msg, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, msg->TotalLength() == sizeof(plain_text));
+    NL_TEST_ASSERT(inSuite, msg->Read(encrypted) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, encrypted, sizeof(plain_text)) != 0);
+
+    // The result matches the contiguous API
+    NL_TEST_ASSERT(inSuite, channel2.Decrypt(encrypted, sizeof(encrypted), output, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, sizeof(plain_text)) == 0);
+
+    NL_TEST_ASSERT(inSuite, channel2.Decrypt(msg, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, msg->Read(output) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, sizeof(plain_text)) == 0);
+
+    // A modified message fails to decrypt
+    msg = PacketBufferHandle::NewWithData(encrypted, sizeof(encrypted));
+    NL_TEST_ASSERT(inSuite, !msg.IsNull());
+    msg->Start()[sizeof(encrypted) - 1] ^= 1;
+    NL_TEST_ASSERT(inSuite, channel2.Decrypt(msg, packetHeader, mac) != CHIP_NO_ERROR);
+}
+
+void SecureChannelCopyAndResetTest(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSession channel;
+    SecureSession channel2;
+    PacketHeader packetHeader;
+    MessageAuthenticationCode mac;
+    const char * plain_text = "Test data";
+    uint8_t encrypted[64];
+    uint8_t output[64];
+    const size_t length = strlen(plain_text);
+
+    InitChannelPair(inSuite, channel, channel2);
+
+    // Use the ciphers so that their keys are set up before the sessions are copied.
+    NL_TEST_ASSERT(inSuite, channel.Encrypt((const uint8_t *) plain_text, length, encrypted, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, channel2.Decrypt(encrypted, length, output, packetHeader, mac) == CHIP_NO_ERROR);
+
+    SecureSession copy(channel);
+    SecureSession copy2;
+    copy2 = channel2;
+
+    packetHeader.SetMessageId(1);
+    NL_TEST_ASSERT(inSuite, copy.Encrypt((const uint8_t *) plain_text, length, encrypted, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, channel2.Decrypt(encrypted, length, output, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, length) == 0);
+
+    packetHeader.SetMessageId(2);
+    NL_TEST_ASSERT(inSuite, channel.Encrypt((const uint8_t *) plain_text, length, encrypted, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, copy2.Decrypt(encrypted, length, output, packetHeader, mac) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, length) == 0);
+
+    // A reset session drops its cached keys along with the session keys.
+    channel.Reset();
+    NL_TEST_ASSERT(inSuite,
+                   channel.Encrypt((const uint8_t *) plain_text, length, encrypted, packetHeader, mac) ==
+                       CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    NL_TEST_ASSERT(inSuite, copy.Encrypt((const uint8_t *) plain_text, length, encrypted, packetHeader, mac) == CHIP_NO_ERROR);
+}
+
 // Test Suite
 
 /**
@@ -162,18 +275,40 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Init",    SecureChannelInitTest),
     NL_TEST_DEF("Encrypt", SecureChannelEncryptTest),
     NL_TEST_DEF("Decrypt", SecureChannelDecryptTest),
+    NL_TEST_DEF("Chained Encrypt/Decrypt", SecureChannelChainedEncryptDecryptTest),
+    NL_TEST_DEF("Copy and Reset", SecureChannelCopyAndResetTest),
 
     NL_TEST_SENTINEL()
 };
 // clang-format on
 
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+    if (error != CHIP_NO_ERROR)
+        return FAILURE;
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
 // clang-format off
 static nlTestSuite sSuite =
 {
     "Test-CHIP-SecureChannel",
     &sTests[0],
-    nullptr,
-    nullptr
+    TestSetup,
+    TestTeardown
 };
 // clang-format on
 
@@ -101,16 +101,20 @@ public:
         NL_TEST_ASSERT(mSuite, header.GetDestinationNodeId() == Optional<NodeId>::Value(kDestinationNodeId));
         NL_TEST_ASSERT(mSuite, session == mRemoteToLocalSession); // Packet received by remote peer
 
-        size_t data_len = msgBuf->DataLength();
+        // The message may arrive as a chain of buffers.
+        uint8_t data[sizeof(LARGE_PAYLOAD)];
+        size_t data_len = msgBuf->TotalLength();
+        NL_TEST_ASSERT(mSuite, data_len <= sizeof(data));
+        NL_TEST_ASSERT(mSuite, msgBuf->Read(data, data_len) == CHIP_NO_ERROR);
 
         if (LargeMessageSent)
         {
-            int compare = memcmp(msgBuf->Start(), LARGE_PAYLOAD, data_len);
+            int compare = memcmp(data, LARGE_PAYLOAD, data_len);
             NL_TEST_ASSERT(mSuite, compare == 0);
         }
         else
         {
-            int compare = memcmp(msgBuf->Start(), PAYLOAD, data_len);
+            int compare = memcmp(data, PAYLOAD, data_len);
             NL_TEST_ASSERT(mSuite, compare == 0);
         }
 
@@ -236,6 +240,16 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext)
 
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 2);
 
+    // A message in a chain of buffers is encrypted and decrypted without being compacted
+    chip::System::PacketBufferHandle chained_buffer = chip::MessagePacketBuffer::NewWithData(LARGE_PAYLOAD, 300);
+    NL_TEST_ASSERT(inSuite, !chained_buffer.IsNull());
+    chained_buffer->AddToEnd(chip::System::PacketBufferHandle::NewWithData(&LARGE_PAYLOAD[300], 500));
+
+    err = secureSessionMgr.SendMessage(localToRemoteSession, payloadHeader, std::move(chained_buffer));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 3);
+
     uint16_t large_payload_len = sizeof(LARGE_PAYLOAD);
 
     // Let's send bigger message than supported and make sure it fails to send